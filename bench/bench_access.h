@@ -0,0 +1,35 @@
+#pragma once
+// UnLeaf Benchmarks - friend access to private hot paths
+// (EngineCore queue, logger formatting, config parser). Same pattern as the
+// test fixtures (EngineCoreTest / ConfigParserTest).
+
+#include "service/engine_core.h"
+#include "common/config.h"
+#include "common/logger.h"
+
+class UnLeafBenchAccess {
+public:
+    // EngineCore
+    static void Enqueue(unleaf::EngineCore& e, const unleaf::EnforcementRequest& req) {
+        e.EnqueueRequest(req);
+    }
+    static void ProcessQueue(unleaf::EngineCore& e) { e.ProcessEnforcementQueue(); }
+    static void ThreadStart(unleaf::EngineCore& e, DWORD tid, DWORD pid) {
+        e.OnThreadStart(tid, pid);
+    }
+
+    // LightweightLogger
+    static std::wstring Timestamp() {
+        return unleaf::LightweightLogger::Instance().GetTimestamp();
+    }
+    static std::string ToUtf8(const std::wstring& s) {
+        return unleaf::LightweightLogger::Instance().WideToUtf8(s);
+    }
+
+    // UnLeafConfig
+    static bool ParseIni(const std::string& content) {
+        auto& cfg = unleaf::UnLeafConfig::Instance();
+        cfg.targets_.clear();
+        return cfg.ParseIni(content);
+    }
+};
@@ -0,0 +1,32 @@
+// UnLeaf Benchmarks - INI parsing (UnLeafConfig::ParseIni)
+
+#include <benchmark/benchmark.h>
+#include "bench_access.h"
+
+#include <string>
+
+namespace {
+
+std::string MakeIni(int targets) {
+    std::string ini = "[Logging]\nLogLevel=INFO\nLogEnabled=1\nCrashDump=0\n\n[Targets]\n";
+    for (int i = 0; i < targets; ++i) {
+        if (i % 4 == 3) {
+            ini += "C:\\Program Files\\Vendor" + std::to_string(i) + "\\app" +
+                   std::to_string(i) + ".exe=1\n";
+        } else {
+            ini += "app" + std::to_string(i) + ".exe=" + (i % 5 == 0 ? "0" : "1") + "\n";
+        }
+    }
+    return ini;
+}
+
+void BM_ParseIni(benchmark::State& state) {
+    const std::string ini = MakeIni(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(UnLeafBenchAccess::ParseIni(ini));
+    }
+    state.SetBytesProcessed(state.iterations() * ini.size());
+}
+BENCHMARK(BM_ParseIni)->Arg(4)->Arg(32)->Arg(256);
+
+} // namespace
@@ -0,0 +1,139 @@
+// UnLeaf Benchmarks - trackedCs_ contention
+// Measures OnThreadStart (ETW callback) latency while another thread runs
+// enforcement bursts. Fake kernel calls spin for Arg(0) μs to model slow
+// NtQueryInformationProcess / SetProcessInformation / thread walks: callback
+// latency must not track that cost (§9.21 dispatch runs I/O outside trackedCs_).
+
+#include <benchmark/benchmark.h>
+#include "bench_access.h"
+#include "platform/fake/fake_platform.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace unleaf;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr DWORD kFirstPid = 2000;
+constexpr int   kPidCount = 16;
+
+using Clock = std::chrono::steady_clock;
+
+void SpinFor(std::chrono::microseconds d) {
+    const auto until = Clock::now() + d;
+    while (Clock::now() < until) {}
+}
+
+class ContentionEngine {
+public:
+    explicit ContentionEngine(int64_t kernelCallUs) {
+        dir_ = fs::temp_directory_path() / "unleaf_bench_contention";
+        fs::remove_all(dir_);
+        fs::create_directories(dir_);
+        std::ofstream(dir_ / "UnLeaf.ini") << "[Logging]\nLogLevel=ERROR\nLogEnabled=0\n\n"
+                                              "[Targets]\nnotepad.exe=1\n";
+        for (int i = 0; i < kPidCount; ++i) {
+            fake_.SpawnProcess(Pid(i), 4, L"notepad.exe");
+        }
+        if (kernelCallUs > 0) {
+            const std::chrono::microseconds cost(kernelCallUs);
+            fake_.SetProcessCallHook([cost] { SpinFor(cost); });
+        }
+        engine_ = std::make_unique<EngineCore>(fake_.AsPlatform());
+        engine_->Initialize(dir_.wstring());
+        engine_->Start(ControlLoopMode::CALLER_PUMPED);
+        for (int i = 0; i < 16; ++i) engine_->RunControlLoopOnce(0);
+
+        // Escalate every process to PERSISTENT (violations during AGGRESSIVE verification)
+        // so bursts and thread events both reach the kernel-call path.
+        for (uint32_t v = 0; v < EngineCore::DefaultPolicy().violationThreshold; ++v) {
+            for (int i = 0; i < kPidCount; ++i) {
+                fake_.SetEcoQoS(Pid(i), true);
+                UnLeafBenchAccess::Enqueue(*engine_,
+                    EnforcementRequest(Pid(i), EnforcementRequestType::DEFERRED_VERIFICATION, 1));
+            }
+            UnLeafBenchAccess::ProcessQueue(*engine_);
+        }
+    }
+
+    ~ContentionEngine() {
+        engine_->Stop();
+        engine_.reset();
+        std::error_code ec;
+        fs::remove_all(dir_, ec);
+    }
+
+    static DWORD Pid(int i) { return kFirstPid + static_cast<DWORD>(i) * 4; }
+
+    // One burst: every tracked process has EcoQoS re-applied and is re-enforced
+    void EnforcementBurst() {
+        for (int i = 0; i < kPidCount; ++i) {
+            fake_.SetEcoQoS(Pid(i), true);
+            UnLeafBenchAccess::Enqueue(*engine_,
+                EnforcementRequest(Pid(i), EnforcementRequestType::PERSISTENT_ENFORCE));
+        }
+        UnLeafBenchAccess::ProcessQueue(*engine_);
+    }
+
+    EngineCore& engine() { return *engine_; }
+
+private:
+    platform::FakePlatform fake_;
+    std::unique_ptr<EngineCore> engine_;
+    fs::path dir_;
+};
+
+void BM_ThreadStartDuringEnforcement(benchmark::State& state) {
+    ContentionEngine bench(state.range(0));
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> bursts{0};
+    std::thread enforcer([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            bench.EnforcementBurst();
+            bursts.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    std::vector<double> samplesUs;
+    samplesUs.reserve(1 << 20);
+    DWORD tid = 1;
+    int pidIndex = 0;
+    for (auto _ : state) {
+        const auto t0 = Clock::now();
+        UnLeafBenchAccess::ThreadStart(bench.engine(), tid++, ContentionEngine::Pid(pidIndex));
+        const auto t1 = Clock::now();
+        pidIndex = (pidIndex + 1) % kPidCount;
+        samplesUs.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+    }
+
+    stop.store(true);
+    enforcer.join();
+
+    if (!samplesUs.empty()) {
+        std::sort(samplesUs.begin(), samplesUs.end());
+        auto pct = [&](double p) {
+            return samplesUs[static_cast<size_t>(p * static_cast<double>(samplesUs.size() - 1))];
+        };
+        state.counters["p50_us"] = pct(0.50);
+        state.counters["p99_us"] = pct(0.99);
+        state.counters["p999_us"] = pct(0.999);
+        state.counters["max_us"] = samplesUs.back();
+        // Callbacks that waited on trackedCs_ behind an enforcement (or were preempted)
+        state.counters["over_100us"] = static_cast<double>(
+            samplesUs.end() - std::upper_bound(samplesUs.begin(), samplesUs.end(), 100.0));
+    }
+    state.counters["bursts"] = static_cast<double>(bursts.load());
+}
+// Arg: simulated kernel-call cost (μs) on the enforcement thread
+BENCHMARK(BM_ThreadStartDuringEnforcement)->Arg(0)->Arg(20)->Arg(200)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,117 @@
+// UnLeaf Benchmarks - enforcement queue: lock-free rings vs. legacy deques
+// Multi-producer EnqueueRequest throughput (ETW consumer + threadpool timers)
+// with a single draining consumer. LegacyDequeQueue is the pre-§9.22
+// implementation (CriticalSection + 2 std::deque) kept here as the baseline.
+
+#include <benchmark/benchmark.h>
+#include "service/enforcement_queue.h"
+#include "common/scoped_handle.h"
+
+#include <deque>
+#include <vector>
+
+using namespace unleaf;
+
+namespace {
+
+constexpr size_t kSoft  = 4096;
+constexpr size_t kHard  = 8192;
+constexpr size_t kTotal = 8192;
+constexpr int    kBatch = 64;
+
+class LegacyDequeQueue {
+public:
+    bool Push(const EnforcementRequest& req) {
+        const bool isCritical = (req.type != EnforcementRequestType::ETW_THREAD_START);
+        CSLockGuard lock(cs_);
+        const size_t total = critical_.size() + nonCritical_.size();
+        if (!isCritical) {
+            if (nonCritical_.size() >= kSoft || total >= kTotal) return false;
+            nonCritical_.push_back(req);
+            return true;
+        }
+        if (critical_.size() >= kHard) return false;
+        if (total >= kTotal) {
+            if (!nonCritical_.empty()) nonCritical_.pop_front();
+            else if (!critical_.empty()) critical_.pop_front();
+            else return false;
+        }
+        critical_.push_back(req);
+        return true;
+    }
+
+    size_t Drain() {
+        std::deque<EnforcementRequest> critical, nonCritical;
+        {
+            CSLockGuard lock(cs_);
+            const size_t n = std::min<size_t>(critical_.size(), 512);
+            for (size_t i = 0; i < n; ++i) {
+                critical.push_back(std::move(critical_.front()));
+                critical_.pop_front();
+            }
+            std::swap(nonCritical, nonCritical_);
+        }
+        return critical.size() + nonCritical.size();
+    }
+
+private:
+    CriticalSection cs_;
+    std::deque<EnforcementRequest> critical_;
+    std::deque<EnforcementRequest> nonCritical_;
+};
+
+EnforcementRequest RequestFor(int i, DWORD base) {
+    // 1/8 CRITICAL (timer callbacks), rest ETW_THREAD_START
+    return (i & 7) == 0
+        ? EnforcementRequest(base + i, EnforcementRequestType::PERSISTENT_ENFORCE)
+        : EnforcementRequest(base + i, EnforcementRequestType::ETW_THREAD_START);
+}
+
+EnforcementQueue* g_ring = nullptr;
+LegacyDequeQueue* g_legacy = nullptr;
+
+void BM_EnforcementQueue_Ring(benchmark::State& state) {
+    if (state.thread_index() == 0) g_ring = new EnforcementQueue(kSoft, kHard, kTotal);
+    // Thread 0 is also the single consumer; producer threads never pop
+    std::vector<EnforcementRequest> drained;
+    drained.reserve(kTotal);
+    const DWORD base = static_cast<DWORD>(state.thread_index()) << 20;
+    for (auto _ : state) {
+        for (int i = 0; i < kBatch; ++i) {
+            bool wasEmpty = false;
+            benchmark::DoNotOptimize(g_ring->Push(RequestFor(i, base), wasEmpty));
+        }
+        if (state.thread_index() == 0) {
+            drained.clear();
+            g_ring->PopCritical(drained, 512);
+            g_ring->PopNonCritical(drained);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kBatch);
+    if (state.thread_index() == 0) {
+        delete g_ring;
+        g_ring = nullptr;
+    }
+}
+BENCHMARK(BM_EnforcementQueue_Ring)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
+
+void BM_EnforcementQueue_LegacyDeque(benchmark::State& state) {
+    if (state.thread_index() == 0) g_legacy = new LegacyDequeQueue();
+    const DWORD base = static_cast<DWORD>(state.thread_index()) << 20;
+    for (auto _ : state) {
+        for (int i = 0; i < kBatch; ++i) {
+            benchmark::DoNotOptimize(g_legacy->Push(RequestFor(i, base)));
+        }
+        if (state.thread_index() == 0) {
+            benchmark::DoNotOptimize(g_legacy->Drain());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kBatch);
+    if (state.thread_index() == 0) {
+        delete g_legacy;
+        g_legacy = nullptr;
+    }
+}
+BENCHMARK(BM_EnforcementQueue_LegacyDeque)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
+
+} // namespace
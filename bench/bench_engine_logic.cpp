@@ -0,0 +1,99 @@
+// UnLeaf Benchmarks - engine_logic target matching
+// std::set<std::wstring> (legacy API) vs. compiled TargetMatcher on the same lists.
+
+#include <benchmark/benchmark.h>
+#include "engine/engine_logic.h"
+#include "common/types.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::wstring> MakeNames(int count) {
+    std::vector<std::wstring> names;
+    for (int i = 0; i < count; ++i) {
+        names.push_back(L"targetapp" + std::to_wstring(i) + L".exe");
+    }
+    return names;
+}
+
+// Mixed-case ETW image names; 1 in 8 is a hit
+std::vector<std::wstring> MakeProbes(int targetCount) {
+    std::vector<std::wstring> probes;
+    for (int i = 0; i < 64; ++i) {
+        probes.push_back((i % 8 == 0)
+            ? L"TargetApp" + std::to_wstring(i % targetCount) + L".EXE"
+            : L"SomeOtherProcess" + std::to_wstring(i) + L".exe");
+    }
+    return probes;
+}
+
+void BM_IsTargetProcess_StdSet(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    auto names = MakeNames(n);
+    std::set<std::wstring> set(names.begin(), names.end());
+    auto probes = MakeProbes(n);
+    size_t i = 0;
+    for (auto _ : state) {
+        // Legacy call site: ToLower copy + rb-tree lookup
+        bool hit = engine_logic::IsTargetProcess(unleaf::ToLower(probes[i++ & 63]), set);
+        benchmark::DoNotOptimize(hit);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IsTargetProcess_StdSet)->Arg(8)->Arg(64)->Arg(512);
+
+void BM_IsTargetProcess_Matcher(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    engine_logic::TargetMatcher matcher(MakeNames(n));
+    auto probes = MakeProbes(n);
+    size_t i = 0;
+    for (auto _ : state) {
+        bool hit = matcher.Contains(probes[i++ & 63]);
+        benchmark::DoNotOptimize(hit);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IsTargetProcess_Matcher)->Arg(8)->Arg(64)->Arg(512);
+
+void BM_IsCriticalProcess(benchmark::State& state) {
+    const std::wstring name = L"Chrome.exe";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(unleaf::IsCriticalProcess(name));
+    }
+}
+BENCHMARK(BM_IsCriticalProcess);
+
+void BM_IsTargetByPath_StdSet(benchmark::State& state) {
+    std::set<std::wstring> paths = {L"c:\\program files\\google\\chrome\\application\\chrome.exe"};
+    std::set<std::wstring> names = {L"notepad.exe", L"code.exe"};
+    const std::wstring probe = L"c:\\program files\\microsoft vs code\\code.exe";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine_logic::IsTargetByPath(probe, paths, names));
+    }
+}
+BENCHMARK(BM_IsTargetByPath_StdSet);
+
+void BM_IsTargetByPath_Matcher(benchmark::State& state) {
+    engine_logic::TargetMatcher paths({L"c:\\program files\\google\\chrome\\application\\chrome.exe"});
+    engine_logic::TargetMatcher names({L"notepad.exe", L"code.exe"});
+    const std::wstring probe = L"c:\\program files\\microsoft vs code\\code.exe";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine_logic::IsTargetByPath(
+            std::wstring_view(probe), paths, names));
+    }
+}
+BENCHMARK(BM_IsTargetByPath_Matcher);
+
+void BM_NextPhaseOnViolation(benchmark::State& state) {
+    engine_logic::EnginePolicy policy;
+    uint32_t v = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine_logic::NextPhaseOnViolation(v++ & 7, policy));
+    }
+}
+BENCHMARK(BM_NextPhaseOnViolation);
+
+} // namespace
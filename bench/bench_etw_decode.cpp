@@ -0,0 +1,137 @@
+// UnLeaf Benchmarks - ETW ProcessStart decode (§9.26)
+// Kernel-Process ProcessStart v3 payload. Legacy replays the per-event work of the
+// TDH path that is visible off Windows: materialize the property schema, size and
+// copy every top-level property into a scratch buffer, case-insensitive name compare.
+// The TdhGetEventInformation x2 / TdhGetPropertySize / TdhGetProperty calls themselves
+// are not included, so the measured ratio is a lower bound.
+
+#include <benchmark/benchmark.h>
+#include "engine/etw_event_layout.h"
+
+#include <cwctype>
+#include <string>
+#include <vector>
+
+using namespace engine_logic;
+
+namespace {
+
+std::vector<EtwFieldSchema> SchemaV3() {
+    return {
+        {L"ProcessID",                   EtwFieldKind::FIXED, 4},
+        {L"ProcessSequenceNumber",       EtwFieldKind::FIXED, 8},
+        {L"CreateTime",                  EtwFieldKind::FIXED, 8},
+        {L"ParentProcessID",             EtwFieldKind::FIXED, 4},
+        {L"ParentProcessSequenceNumber", EtwFieldKind::FIXED, 8},
+        {L"SessionID",                   EtwFieldKind::FIXED, 4},
+        {L"Flags",                       EtwFieldKind::FIXED, 4},
+        {L"ProcessTokenElevationType",   EtwFieldKind::FIXED, 4},
+        {L"ProcessTokenIsElevated",      EtwFieldKind::FIXED, 4},
+        {L"MandatoryLabel",              EtwFieldKind::SID},
+        {L"ImageName",                   EtwFieldKind::UTF16_STRING},
+        {L"ImageChecksum",               EtwFieldKind::FIXED, 4},
+        {L"TimeDateStamp",               EtwFieldKind::FIXED, 4},
+        {L"PackageFullName",             EtwFieldKind::UTF16_STRING},
+        {L"PackageRelativeAppId",        EtwFieldKind::UTF16_STRING},
+    };
+}
+
+void PutU32(std::vector<uint8_t>& b, uint32_t v) { for (int i = 0; i < 4; ++i) b.push_back(uint8_t(v >> (8 * i))); }
+void PutU64(std::vector<uint8_t>& b, uint64_t v) { for (int i = 0; i < 8; ++i) b.push_back(uint8_t(v >> (8 * i))); }
+void PutUtf16(std::vector<uint8_t>& b, const std::u16string& s) {
+    for (char16_t c : s) { b.push_back(uint8_t(c)); b.push_back(uint8_t(c >> 8)); }
+    b.push_back(0); b.push_back(0);
+}
+
+std::vector<uint8_t> PayloadV3() {
+    std::vector<uint8_t> b;
+    PutU32(b, 6952); PutU64(b, 77); PutU64(b, 0x01DA1234ABCD0000ull); PutU32(b, 4120);
+    PutU64(b, 42); PutU32(b, 1); PutU32(b, 0); PutU32(b, 3); PutU32(b, 0);
+    b.insert(b.end(), {1, 1, 0, 0, 0, 0, 0, 16}); PutU32(b, 8192);   // S-1-16-8192
+    PutUtf16(b, u"\\Device\\HarddiskVolume3\\Program Files\\Microsoft Visual Studio\\VC\\bin\\cl.exe");
+    PutU32(b, 0x1C2D3); PutU32(b, 0x5F000000);
+    PutUtf16(b, u""); PutUtf16(b, u"");
+    return b;
+}
+
+bool NameIs(const std::wstring& a, const wchar_t* b) {
+    size_t i = 0;
+    for (; i < a.size() && b[i]; ++i) {
+        if (towlower(a[i]) != towlower(b[i])) return false;
+    }
+    return i == a.size() && !b[i];
+}
+
+size_t PropertySize(const EtwFieldSchema& f, const uint8_t* p, size_t remain) {
+    switch (f.kind) {
+        case EtwFieldKind::FIXED: return f.size;
+        case EtwFieldKind::SID:   return remain >= 8 ? 8 + 4 * size_t{p[1]} : remain;
+        default: {
+            size_t n = 0;
+            while (n + 1 < remain && (p[n] | p[n + 1])) n += 2;
+            return n + 2;
+        }
+    }
+}
+
+void BM_ProcessStartDecode_Legacy(benchmark::State& state) {
+    const auto schema = SchemaV3();
+    const auto payload = PayloadV3();
+    std::vector<uint8_t> scratch;
+    for (auto _ : state) {
+        std::vector<EtwFieldSchema> info(schema);   // TRACE_EVENT_INFO per event
+        uint32_t pid = 0, parentPid = 0;
+        std::wstring imageName;
+        size_t pos = 0;
+        for (const auto& prop : info) {
+            if (pos >= payload.size()) break;
+            const size_t size = PropertySize(prop, payload.data() + pos, payload.size() - pos);
+            scratch.assign(payload.begin() + pos, payload.begin() + pos + size);
+            pos += size;
+            if (NameIs(prop.name, L"ProcessID")) {
+                pid = scratch[0] | (scratch[1] << 8) | (scratch[2] << 16) | (uint32_t(scratch[3]) << 24);
+            } else if (NameIs(prop.name, L"ParentProcessID")) {
+                parentPid = scratch[0] | (scratch[1] << 8) | (scratch[2] << 16) | (uint32_t(scratch[3]) << 24);
+            } else if (NameIs(prop.name, L"ImageName") || NameIs(prop.name, L"ImageFileName")) {
+                imageName = Utf16LeToWide(scratch.data(), scratch.size() - 2);
+            }
+        }
+        std::wstring imagePath;
+        SplitImagePath(imageName, imagePath);
+        benchmark::DoNotOptimize(pid + parentPid);
+        benchmark::DoNotOptimize(imageName.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ProcessStartDecode_Legacy);
+
+void BM_ProcessStartDecode_Layout(benchmark::State& state) {
+    const auto layout = ProcessStartLayout::Compile(SchemaV3());
+    const auto payload = PayloadV3();
+    for (auto _ : state) {
+        ProcessStartFields f;
+        layout.Decode(payload.data(), payload.size(), f);
+        std::wstring imageName = Utf16LeToWide(f.image, f.imageBytes);
+        std::wstring imagePath;
+        SplitImagePath(imageName, imagePath);
+        benchmark::DoNotOptimize(f.pid + f.parentPid);
+        benchmark::DoNotOptimize(imageName.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ProcessStartDecode_Layout);
+
+// Layout only (no string materialization): the part that replaced the TDH walk
+void BM_ProcessStartDecode_LayoutFieldsOnly(benchmark::State& state) {
+    const auto layout = ProcessStartLayout::Compile(SchemaV3());
+    const auto payload = PayloadV3();
+    for (auto _ : state) {
+        ProcessStartFields f;
+        layout.Decode(payload.data(), payload.size(), f);
+        benchmark::DoNotOptimize(f);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ProcessStartDecode_LayoutFieldsOnly);
+
+} // namespace
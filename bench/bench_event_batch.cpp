@@ -0,0 +1,55 @@
+// UnLeaf Benchmarks - ProcessStart POD batch decode (§9.29)
+// Per-event cost on the ETW consumer thread of turning the ProcessStart
+// ImageFileName payload into something the engine can classify:
+//   Wstring : Utf16LeToWide + SplitImagePath (two heap strings per event, pre-§9.29)
+//   Batch   : ProcessStartBatch::AppendUtf16Le (decoded into the inline record)
+
+#include <benchmark/benchmark.h>
+#include "engine/event_batch.h"
+#include "engine/etw_event_layout.h"
+
+#include <string>
+#include <vector>
+
+using namespace engine_logic;
+
+namespace {
+
+std::vector<uint8_t> ImagePayload() {
+    const std::wstring image =
+        L"\\Device\\HarddiskVolume3\\Program Files\\Microsoft Visual Studio\\VC\\bin\\cl.exe";
+    std::vector<uint8_t> bytes;
+    for (wchar_t c : image) {
+        bytes.push_back(static_cast<uint8_t>(c));
+        bytes.push_back(static_cast<uint8_t>(static_cast<uint32_t>(c) >> 8));
+    }
+    return bytes;
+}
+
+void BM_ProcessStartImage_Wstring(benchmark::State& state) {
+    const std::vector<uint8_t> bytes = ImagePayload();
+    for (auto _ : state) {
+        std::wstring name = Utf16LeToWide(bytes.data(), bytes.size());
+        std::wstring path;
+        SplitImagePath(name, path);
+        benchmark::DoNotOptimize(name);
+        benchmark::DoNotOptimize(path);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ProcessStartImage_Wstring);
+
+void BM_ProcessStartImage_Batch(benchmark::State& state) {
+    const std::vector<uint8_t> bytes = ImagePayload();
+    ProcessStartBatch batch;
+    uint32_t pid = 10000;
+    for (auto _ : state) {
+        if (batch.Full()) batch.Clear();
+        batch.AppendUtf16Le(pid += 4, 9000, bytes.data(), bytes.size());
+        benchmark::DoNotOptimize(batch.ImageName(batch.Size() - 1));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ProcessStartImage_Batch);
+
+} // namespace
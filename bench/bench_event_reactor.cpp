@@ -0,0 +1,107 @@
+// UnLeaf Benchmarks - Linux control loop reactor (§9.33)
+// Cost of one control loop wakeup on the epoll reactor with the engine's 5-handle list
+// (stop, config watch, SafetyNet timer, enforcement request, process exit):
+//   WaitAnySignaled : SetEvent + WaitAny on one thread (syscall cost per wakeup)
+//   SignalToWake    : SetEvent on a producer thread → WaitAny return on the waiter
+
+#ifdef __linux__
+
+#include <benchmark/benchmark.h>
+#include "platform/linux/linux_event_service.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using unleaf::platform::LinuxEventService;
+using unleaf::platform::NativeHandle;
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// Mirrors EngineCore::WAIT_* order
+struct EngineHandles {
+    explicit EngineHandles(LinuxEventService& events)
+        : events_(events),
+          dir_(fs::temp_directory_path() / ("unleaf_bench_reactor_" + std::to_string(::getpid()))) {
+        fs::create_directories(dir_);
+        handles[0] = events.CreateEventObject(true);
+        handles[1] = events.WatchDirectory(dir_.wstring(), L"UnLeaf.ini");
+        handles[2] = events.CreatePeriodicTimer();
+        handles[3] = events.CreateEventObject(false);
+        handles[4] = events.CreateEventObject(false);
+        events.ArmPeriodicTimer(handles[2], 10000, 10000);
+    }
+    ~EngineHandles() {
+        events_.CloseHandle(handles[0]);
+        events_.CloseDirectoryWatch(handles[1]);
+        for (int i = 2; i < 5; ++i) events_.CloseHandle(handles[i]);
+        std::error_code ec;
+        fs::remove_all(dir_, ec);
+    }
+
+    NativeHandle handles[5] = {};
+
+private:
+    LinuxEventService& events_;
+    fs::path dir_;
+};
+
+void BM_LinuxEvents_WaitAnySignaled(benchmark::State& state) {
+    LinuxEventService events;
+    EngineHandles h(events);
+    for (auto _ : state) {
+        events.SetEvent(h.handles[3]);
+        benchmark::DoNotOptimize(events.WaitAny(h.handles, 5, 0));
+    }
+    state.counters["rebuilds"] = static_cast<double>(events.GetStats().rebuilds);
+}
+BENCHMARK(BM_LinuxEvents_WaitAnySignaled);
+
+void BM_LinuxEvents_SignalToWake(benchmark::State& state) {
+    LinuxEventService events;
+    EngineHandles h(events);
+    std::atomic<bool> done{false};
+    std::atomic<int64_t> signalNs{0};
+
+    using Clock = std::chrono::steady_clock;
+    auto nowNs = [] {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    };
+
+    // Producer signals only after the previous wakeup was observed (one in flight)
+    std::atomic<bool> armed{false};
+    std::thread producer([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            if (armed.exchange(false, std::memory_order_acq_rel)) {
+                signalNs.store(nowNs(), std::memory_order_release);
+                events.SetEvent(h.handles[3]);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (auto _ : state) {
+        armed.store(true, std::memory_order_release);
+        const DWORD r = events.WaitAny(h.handles, 5, 1000);
+        const int64_t t1 = nowNs();
+        if (r != WAIT_OBJECT_0 + 3) {
+            state.SkipWithError("unexpected wait result");
+            break;
+        }
+        state.SetIterationTime(static_cast<double>(t1 - signalNs.load(std::memory_order_acquire)) / 1e9);
+    }
+    done.store(true, std::memory_order_release);
+    producer.join();
+}
+BENCHMARK(BM_LinuxEvents_SignalToWake)->UseManualTime()->Unit(benchmark::kMicrosecond);
+
+} // namespace
+
+#endif // __linux__
@@ -0,0 +1,78 @@
+// UnLeaf Benchmarks - Event trace capture / replay decode (§9.27)
+// Append* is the per-event cost added to the ETW consumer thread while
+// [Logging] EventTrace=1 (block writes amortized, FLUSH_THRESHOLD = 64 KB).
+// Read is the decode side of UnLeaf_Replay, excluding the engine.
+
+#include <benchmark/benchmark.h>
+#include "engine/event_trace.h"
+
+#include <filesystem>
+#include <string>
+
+using namespace engine_logic;
+
+namespace {
+
+std::filesystem::path BenchTracePath() {
+    return std::filesystem::temp_directory_path() / "unleaf_bench_trace.ultrace";
+}
+
+void BM_TraceAppend_ThreadStart(benchmark::State& state) {
+    EventTraceWriter w;
+    w.Open(BenchTracePath());
+    uint64_t ts = 133000000000000000ull;
+    uint32_t tid = 4;
+    for (auto _ : state) {
+        w.AppendThreadStart(ts += 37, 5000, tid += 4);
+    }
+    state.SetItemsProcessed(state.iterations());
+    w.Close();
+    state.counters["bytes/event"] = static_cast<double>(w.BytesWritten()) /
+                                    static_cast<double>(w.RecordCount() ? w.RecordCount() : 1);
+    std::filesystem::remove(BenchTracePath());
+}
+BENCHMARK(BM_TraceAppend_ThreadStart);
+
+void BM_TraceAppend_ProcessStart(benchmark::State& state) {
+    EventTraceWriter w;
+    w.Open(BenchTracePath());
+    const std::wstring name = L"cl.exe";
+    const std::wstring path =
+        L"\\Device\\HarddiskVolume3\\Program Files\\Microsoft Visual Studio\\VC\\bin\\cl.exe";
+    uint64_t ts = 133000000000000000ull;
+    uint32_t pid = 10000;
+    for (auto _ : state) {
+        w.AppendProcessStart(ts += 900, pid += 4, 9000, name, path);
+    }
+    state.SetItemsProcessed(state.iterations());
+    w.Close();
+    std::filesystem::remove(BenchTracePath());
+}
+BENCHMARK(BM_TraceAppend_ProcessStart);
+
+// 1 process start : 20 thread starts (build-agent mix)
+void BM_TraceRead_Mixed(benchmark::State& state) {
+    {
+        EventTraceWriter w;
+        w.Open(BenchTracePath());
+        uint64_t ts = 133000000000000000ull;
+        for (uint32_t p = 0; p < 5000; ++p) {
+            w.AppendProcessStart(ts += 500, 10000 + 4 * p, 9000, L"cl.exe", L"C:\\vs\\bin\\cl.exe");
+            for (uint32_t t = 0; t < 20; ++t) w.AppendThreadStart(ts += 25, 10000 + 4 * p, 4 * t);
+        }
+    }
+    EventTraceReader r;
+    r.Open(BenchTracePath());
+    TraceEvent ev;
+    uint64_t events = 0;
+    for (auto _ : state) {
+        r.Rewind();
+        while (r.Next(ev)) ++events;
+        benchmark::DoNotOptimize(ev);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(events));
+    std::filesystem::remove(BenchTracePath());
+}
+BENCHMARK(BM_TraceRead_Mixed);
+
+} // namespace
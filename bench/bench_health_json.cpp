@@ -0,0 +1,36 @@
+// UnLeaf Benchmarks - CMD_HEALTH_CHECK JSON serialization
+
+#include <benchmark/benchmark.h>
+#include "service/health_json.h"
+
+namespace {
+
+unleaf::HealthInfo MakeHealth(int processes) {
+    unleaf::HealthInfo h = {};
+    h.engineRunning = true;
+    h.mode = unleaf::OperationMode::NORMAL;
+    h.etwHealthy = true;
+    h.uptimeMs = 3600000;
+    h.totalEnforcements = 12345;
+    for (int i = 0; i < processes; ++i) {
+        unleaf::ActiveProcessDetail d;
+        d.pid = 1000 + i * 4;
+        d.name = L"app" + std::to_wstring(i) + L".exe";
+        d.phase = (i % 3 == 0) ? "PERSISTENT" : "STABLE";
+        d.violations = static_cast<uint32_t>(i % 5);
+        d.isChild = (i % 2) != 0;
+        h.activeProcessDetails.push_back(std::move(d));
+    }
+    h.activeProcesses = h.activeProcessDetails.size();
+    return h;
+}
+
+void BM_SerializeHealthJson(benchmark::State& state) {
+    const unleaf::HealthInfo health = MakeHealth(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(unleaf::SerializeHealthJson(health));
+    }
+}
+BENCHMARK(BM_SerializeHealthJson)->Arg(0)->Arg(16)->Arg(256);
+
+} // namespace
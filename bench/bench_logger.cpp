@@ -0,0 +1,35 @@
+// UnLeaf Benchmarks - logger formatting (timestamp + UTF-8 conversion)
+
+#include <benchmark/benchmark.h>
+#include "bench_access.h"
+
+namespace {
+
+void BM_LoggerTimestamp(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(UnLeafBenchAccess::Timestamp());
+    }
+}
+BENCHMARK(BM_LoggerTimestamp);
+
+void BM_LoggerWideToUtf8(benchmark::State& state) {
+    const std::wstring msg = L"[TRACK] [TARGET] notepad.exe (PID: 12345) Child=0 "
+                             L"path=c:\\windows\\system32\\notepad.exe";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(UnLeafBenchAccess::ToUtf8(msg));
+    }
+    state.SetBytesProcessed(state.iterations() * msg.size() * sizeof(wchar_t));
+}
+BENCHMARK(BM_LoggerWideToUtf8);
+
+// Full line as WriteMessage builds it: "[ts] [LEVEL] msg\r\n" -> UTF-8
+void BM_LoggerFormatLine(benchmark::State& state) {
+    const std::wstring msg = L"[QUEUE] CRITICAL HARD drop=256";
+    for (auto _ : state) {
+        std::wstring line = L"[" + UnLeafBenchAccess::Timestamp() + L"] [INFO] " + msg + L"\r\n";
+        benchmark::DoNotOptimize(UnLeafBenchAccess::ToUtf8(line));
+    }
+}
+BENCHMARK(BM_LoggerFormatLine);
+
+} // namespace
@@ -0,0 +1,133 @@
+// UnLeaf Benchmarks - End-to-end process detection latency on Linux (§9.32)
+// fork() → ProcessStart callback on the netlink proc connector thread, and
+// child exit → ProcessExit callback. Measures what the engine would see: kernel
+// notification + /proc image lookup + batch delivery. Requires CAP_NET_ADMIN.
+
+#ifdef __linux__
+
+#include <benchmark/benchmark.h>
+#include "platform/linux/netlink_process_monitor.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using unleaf::platform::NetlinkProcessMonitor;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Probe {
+    std::atomic<DWORD> watchPid{0};   // ForkToStart: parent PID (the child's PID is not known yet)
+    std::atomic<int64_t> seenNs{0};   // Clock ns when the watched event was delivered
+};
+
+int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// Spins until the probe fires (bounded); false = event not delivered
+bool AwaitProbe(Probe& probe) {
+    for (int i = 0; i < 2000000 && probe.seenNs.load(std::memory_order_acquire) == 0; ++i) {
+        std::this_thread::yield();
+    }
+    return probe.seenNs.load(std::memory_order_acquire) != 0;
+}
+
+void BM_NetlinkDetect_ForkToStart(benchmark::State& state) {
+    NetlinkProcessMonitor monitor;
+    Probe probe;
+    const bool started = monitor.Start([&probe](const engine_logic::ProcessStartBatch& batch) {
+        // Forks of this (single-threaded) benchmark loop: one per iteration
+        const DWORD parent = probe.watchPid.load(std::memory_order_acquire);
+        for (size_t i = 0; i < batch.Size(); ++i) {
+            if (batch[i].parentPid == parent) probe.seenNs.store(NowNs(), std::memory_order_release);
+        }
+    });
+    if (!started) {
+        state.SkipWithError("proc connector unavailable (CAP_NET_ADMIN)");
+        return;
+    }
+    probe.watchPid.store(static_cast<DWORD>(::getpid()), std::memory_order_release);
+
+    for (auto _ : state) {
+        probe.seenNs.store(0, std::memory_order_relaxed);
+        int pipeFd[2];
+        if (::pipe(pipeFd) != 0) {
+            state.SkipWithError("pipe failed");
+            break;
+        }
+        const int64_t t0 = NowNs();
+        const pid_t child = ::fork();
+        if (child == 0) {
+            char c;
+            (void)!::read(pipeFd[0], &c, 1);   // held alive until the start is observed
+            ::_exit(0);
+        }
+        const bool seen = AwaitProbe(probe);
+        const int64_t t1 = probe.seenNs.load(std::memory_order_acquire);
+        (void)!::write(pipeFd[1], "x", 1);
+        ::close(pipeFd[0]);
+        ::close(pipeFd[1]);
+        ::waitpid(child, nullptr, 0);
+        if (!seen) {
+            state.SkipWithError("ProcessStart not delivered");
+            break;
+        }
+        state.SetIterationTime(static_cast<double>(t1 - t0) / 1e9);
+    }
+    monitor.Stop();
+}
+BENCHMARK(BM_NetlinkDetect_ForkToStart)->UseManualTime()->Unit(benchmark::kMicrosecond);
+
+void BM_NetlinkDetect_ExitToCallback(benchmark::State& state) {
+    NetlinkProcessMonitor monitor;
+    Probe probe;
+    monitor.SetProcessExitCallback([&probe](DWORD pid) {
+        if (pid == probe.watchPid.load(std::memory_order_acquire)) {
+            probe.seenNs.store(NowNs(), std::memory_order_release);
+        }
+    });
+    if (!monitor.Start([](const engine_logic::ProcessStartBatch&) {})) {
+        state.SkipWithError("proc connector unavailable (CAP_NET_ADMIN)");
+        return;
+    }
+
+    for (auto _ : state) {
+        probe.seenNs.store(0, std::memory_order_relaxed);
+        int pipeFd[2];
+        if (::pipe(pipeFd) != 0) {
+            state.SkipWithError("pipe failed");
+            break;
+        }
+        const pid_t child = ::fork();
+        if (child == 0) {
+            char c;
+            (void)!::read(pipeFd[0], &c, 1);
+            ::_exit(0);
+        }
+        probe.watchPid.store(static_cast<DWORD>(child), std::memory_order_release);
+        const int64_t t0 = NowNs();
+        (void)!::write(pipeFd[1], "x", 1);   // child exits now
+        const bool seen = AwaitProbe(probe);
+        const int64_t t1 = probe.seenNs.load(std::memory_order_acquire);
+        ::close(pipeFd[0]);
+        ::close(pipeFd[1]);
+        ::waitpid(child, nullptr, 0);
+        if (!seen) {
+            state.SkipWithError("ProcessExit not delivered");
+            break;
+        }
+        state.SetIterationTime(static_cast<double>(t1 - t0) / 1e9);
+    }
+    monitor.Stop();
+    monitor.SetProcessExitCallback(nullptr);
+}
+BENCHMARK(BM_NetlinkDetect_ExitToCallback)->UseManualTime()->Unit(benchmark::kMicrosecond);
+
+} // namespace
+
+#endif // __linux__
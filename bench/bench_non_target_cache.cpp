@@ -0,0 +1,101 @@
+// UnLeaf Benchmarks - SafetyNet missed-target scan: per-PID classification vs. negative cache (§9.40)
+// A synthetic snapshot of Arg(0) processes with 8 targets. One iteration = one full pass.
+// Classify is the pre-§9.40 shape: every row takes trackedCs_ for the tracked-set lookup, then
+// goes through the critical-name matcher and takes targetCs_ for the name / path-file-name matchers.
+// Cached is the steady state: every non-target is already in the cache, so a row costs one
+// name hash and one PidTable probe.
+
+#include <benchmark/benchmark.h>
+#include "engine/non_target_cache.h"
+#include "engine/system_snapshot.h"
+#include "engine/target_matcher.h"
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+using engine_logic::NonTargetCache;
+using engine_logic::SystemSnapshot;
+using engine_logic::TargetMatcher;
+
+namespace {
+
+constexpr size_t kTargets = 8;
+
+void MakeSnapshot(SystemSnapshot& snap, size_t n) {
+    snap.Clear();
+    for (size_t i = 0; i < n; ++i) {
+        const uint32_t pid = static_cast<uint32_t>(i) * 4 + 4;
+        const std::wstring name = (i < kTargets) ? L"target_" + std::to_wstring(i) + L".exe"
+                                                 : L"process_" + std::to_wstring(i) + L".exe";
+        snap.AddProcess(pid, 4, name, 1000 + i);
+    }
+    snap.Finish();
+}
+
+std::vector<std::wstring> TargetNames() {
+    std::vector<std::wstring> names;
+    for (size_t i = 0; i < kTargets; ++i) names.push_back(L"target_" + std::to_wstring(i) + L".exe");
+    return names;
+}
+
+const TargetMatcher& Critical() {
+    static const TargetMatcher matcher(std::vector<std::wstring>{
+        L"system", L"smss.exe", L"csrss.exe", L"wininit.exe", L"services.exe", L"lsass.exe",
+        L"winlogon.exe", L"svchost.exe", L"dwm.exe", L"explorer.exe"});
+    return matcher;
+}
+
+} // namespace
+
+static void BM_SafetyScan_Classify(benchmark::State& state) {
+    SystemSnapshot snap;
+    MakeSnapshot(snap, static_cast<size_t>(state.range(0)));
+    const TargetMatcher names(TargetNames());
+    const TargetMatcher pathFileNames(std::vector<std::wstring>{L"tool.exe"});
+    std::mutex trackedCs;
+    std::mutex targetCs;
+    std::unordered_set<uint32_t> tracked;
+    for (size_t i = 0; i < kTargets; ++i) tracked.insert(static_cast<uint32_t>(i) * 4 + 4);
+
+    for (auto _ : state) {
+        size_t candidates = 0;
+        for (const auto& p : snap) {
+            bool alreadyTracked;
+            { std::lock_guard<std::mutex> lk(trackedCs); alreadyTracked = tracked.count(p.pid) > 0; }
+            if (alreadyTracked) continue;
+            const std::wstring_view name = snap.Name(p);
+            if (Critical().Contains(name)) continue;
+            std::lock_guard<std::mutex> lk(targetCs);
+            candidates += (names.Contains(name) || pathFileNames.Contains(name)) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(candidates);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SafetyScan_Classify)->Arg(300)->Arg(2000);
+
+static void BM_SafetyScan_Cached(benchmark::State& state) {
+    SystemSnapshot snap;
+    MakeSnapshot(snap, static_cast<size_t>(state.range(0)));
+    NonTargetCache cache;
+    cache.SetGeneration(1);
+    for (size_t i = kTargets; i < snap.Size(); ++i) {
+        const auto& p = snap[i];
+        cache.Insert(p.pid, p.createTime, std::hash<std::wstring_view>{}(snap.Name(p)));
+    }
+
+    for (auto _ : state) {
+        size_t misses = 0;
+        for (const auto& p : snap) {
+            const uint64_t nameHash = std::hash<std::wstring_view>{}(snap.Name(p));
+            misses += cache.Contains(p.pid, p.createTime, nameHash) ? 0 : 1;
+        }
+        benchmark::DoNotOptimize(misses);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SafetyScan_Cached)->Arg(300)->Arg(2000);
@@ -0,0 +1,43 @@
+// UnLeaf Benchmarks - path normalization (types.h)
+
+#include <benchmark/benchmark.h>
+#include "common/types.h"
+
+#include <string>
+
+namespace {
+
+const std::wstring kPaths[] = {
+    L"\\\\?\\C:\\Program Files\\Google\\Chrome\\Application\\chrome.exe",
+    L"C:/Users/Someone/AppData/Local/Programs/Microsoft VS Code/Code.exe",
+    L"\\\\?\\UNC\\server\\share\\tools\\..\\bin\\tool.exe",
+    L"C:\\Windows\\System32\\notepad.exe",
+};
+
+void BM_NormalizePath(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(unleaf::NormalizePath(kPaths[i++ & 3]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_NormalizePath);
+
+void BM_CanonicalizePath(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(unleaf::CanonicalizePath(kPaths[i++ & 3]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CanonicalizePath);
+
+void BM_ExtractFileName(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(unleaf::ExtractFileName(kPaths[i++ & 3]));
+    }
+}
+BENCHMARK(BM_ExtractFileName);
+
+} // namespace
@@ -0,0 +1,85 @@
+// UnLeaf Benchmarks - thread-start prefilter (§9.28)
+// Per-event cost on the ETW consumer thread for a system-wide thread-start stream
+// where 1% of owner PIDs are tracked:
+//   Bitmap    : PidBitmap::Test inline, std::function only for hits
+//   Callback  : pre-§9.28 path — std::function for every event, then the
+//               engine's RcuCell read + PidSignalSet probe
+
+#include <benchmark/benchmark.h>
+#include "engine/pid_bitmap.h"
+#include "engine/rcu_snapshot.h"
+
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace engine_logic;
+
+namespace {
+
+constexpr uint32_t kTracked = 64;
+constexpr uint32_t kStream = 1u << 14;
+
+struct Workload {
+    std::vector<uint32_t> tracked;
+    std::vector<uint32_t> stream;   // owner PIDs, ~1% tracked
+};
+
+const Workload& GetWorkload() {
+    static const Workload w = [] {
+        Workload out;
+        std::mt19937 rng(28);
+        std::uniform_int_distribution<uint32_t> pid(1, 1u << 18);
+        for (uint32_t i = 0; i < kTracked; ++i) out.tracked.push_back(pid(rng) * 4);
+        std::uniform_int_distribution<uint32_t> pick(0, 99);
+        for (uint32_t i = 0; i < kStream; ++i) {
+            out.stream.push_back(pick(rng) == 0 ? out.tracked[i % kTracked] : pid(rng) * 4 + 2);
+        }
+        return out;
+    }();
+    return w;
+}
+
+void BM_ThreadFilter_Bitmap(benchmark::State& state) {
+    const Workload& w = GetWorkload();
+    PidBitmap bits;
+    for (uint32_t pid : w.tracked) bits.Set(pid);
+    PerSecondCounter filtered, forwarded;
+    uint64_t hits = 0;
+    std::function<void(uint32_t, uint32_t)> callback = [&hits](uint32_t, uint32_t) { ++hits; };
+    uint32_t i = 0;
+    for (auto _ : state) {
+        const uint32_t owner = w.stream[i++ & (kStream - 1)];
+        if (!bits.Test(owner)) {
+            filtered.Add(1000);
+            continue;
+        }
+        forwarded.Add(1000);
+        callback(i, owner);
+    }
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ThreadFilter_Bitmap);
+
+void BM_ThreadFilter_Callback(benchmark::State& state) {
+    const Workload& w = GetWorkload();
+    RcuCell<PidSignalSet> targets;
+    targets.Publish(std::make_unique<PidSignalSet>(w.tracked));
+    uint64_t hits = 0;
+    std::function<void(uint32_t, uint32_t)> callback = [&](uint32_t, uint32_t owner) {
+        auto snap = targets.Read();
+        if (snap && snap->Find(owner)) ++hits;
+    };
+    uint32_t i = 0;
+    for (auto _ : state) {
+        callback(i, w.stream[i & (kStream - 1)]);
+        ++i;
+    }
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ThreadFilter_Callback);
+
+} // namespace
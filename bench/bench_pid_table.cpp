@@ -0,0 +1,157 @@
+// UnLeaf Benchmarks - tracked-process table: flat PID table vs. legacy std::map
+// Lookup (OnThreadStart / IsTracked filter, hit + miss mix) and full sweep
+// (SafetyNet phase filter) at the old cap (2,000) and the §9.24 cap (32,768).
+// LegacyMap is the pre-§9.24 layout: std::map node -> shared_ptr -> TrackedProcess
+// with the hot fields embedded next to names, paths and handles.
+
+#include <benchmark/benchmark.h>
+#include "service/engine_core.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace unleaf;
+
+namespace {
+
+struct LegacyTrackedProcess {
+    TrackedProcess cold;
+    TrackedHot hot;
+};
+using LegacyMap = std::map<DWORD, std::shared_ptr<LegacyTrackedProcess>>;
+
+// Windows-style PIDs (multiples of 4), scattered like a long-running system
+std::vector<DWORD> MakePids(size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<DWORD> dist(1, 1u << 20);
+    std::vector<DWORD> pids;
+    pids.reserve(n);
+    std::vector<bool> used(1u << 21, false);
+    while (pids.size() < n) {
+        const DWORD p = dist(rng) * 4;
+        if (used[p >> 2]) continue;
+        used[p >> 2] = true;
+        pids.push_back(p);
+    }
+    return pids;
+}
+
+ProcessPhase PhaseFor(size_t i) {
+    // Steady state: mostly STABLE, a few AGGRESSIVE / PERSISTENT
+    switch (i % 16) {
+        case 0:  return ProcessPhase::AGGRESSIVE;
+        case 1:  return ProcessPhase::PERSISTENT;
+        default: return ProcessPhase::STABLE;
+    }
+}
+
+std::wstring NameFor(size_t i) {
+    return L"process_with_a_realistic_name_" + std::to_wstring(i) + L".exe";
+}
+
+void FillLegacy(LegacyMap& map, const std::vector<DWORD>& pids) {
+    for (size_t i = 0; i < pids.size(); ++i) {
+        auto tp = std::make_shared<LegacyTrackedProcess>();
+        tp->cold.pid = pids[i];
+        tp->cold.name = NameFor(i);
+        tp->cold.fullPath = L"c:\\program files\\vendor\\" + tp->cold.name.str();
+        tp->hot.phase = PhaseFor(i);
+        map[pids[i]] = std::move(tp);
+    }
+}
+
+void FillTable(TrackedTable& table, const std::vector<DWORD>& pids) {
+    for (size_t i = 0; i < pids.size(); ++i) {
+        auto tp = std::make_shared<TrackedProcess>();
+        tp->pid = pids[i];
+        tp->name = NameFor(i);
+        tp->fullPath = L"c:\\program files\\vendor\\" + tp->name.str();
+        TrackedHot hot;
+        hot.phase = PhaseFor(i);
+        table.insert_or_assign(pids[i], hot, std::move(tp));
+    }
+}
+
+// Thread events: half from tracked PIDs, half from untracked ones (shuffled)
+std::vector<DWORD> MakeProbes(const std::vector<DWORD>& tracked) {
+    std::vector<DWORD> probes;
+    const auto untracked = MakePids(tracked.size(), 0xBEEF);
+    for (size_t i = 0; i < tracked.size(); ++i) {
+        probes.push_back(tracked[i]);
+        probes.push_back(untracked[i] + 2);   // +2: never collides with a tracked multiple of 4
+    }
+    std::shuffle(probes.begin(), probes.end(), std::mt19937(7));
+    return probes;
+}
+
+void BM_TrackedLookup_LegacyMap(benchmark::State& state) {
+    const auto pids = MakePids(static_cast<size_t>(state.range(0)), 1);
+    LegacyMap map;
+    FillLegacy(map, pids);
+    const auto probes = MakeProbes(pids);
+    size_t i = 0;
+    for (auto _ : state) {
+        auto it = map.find(probes[i]);
+        const bool enqueue = it != map.end() && it->second->hot.phase != ProcessPhase::AGGRESSIVE;
+        benchmark::DoNotOptimize(enqueue);
+        if (++i == probes.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TrackedLookup_LegacyMap)->Arg(2000)->Arg(32768);
+
+void BM_TrackedLookup_PidTable(benchmark::State& state) {
+    const auto pids = MakePids(static_cast<size_t>(state.range(0)), 1);
+    TrackedTable table;
+    FillTable(table, pids);
+    const auto probes = MakeProbes(pids);
+    size_t i = 0;
+    for (auto _ : state) {
+        auto it = table.find(probes[i]);
+        const bool enqueue = it != table.end() && it.hot().phase != ProcessPhase::AGGRESSIVE;
+        benchmark::DoNotOptimize(enqueue);
+        if (++i == probes.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["max_probe"] = table.MaxProbeLength();
+}
+BENCHMARK(BM_TrackedLookup_PidTable)->Arg(2000)->Arg(32768);
+
+void BM_TrackedSweep_LegacyMap(benchmark::State& state) {
+    const auto pids = MakePids(static_cast<size_t>(state.range(0)), 1);
+    LegacyMap map;
+    FillLegacy(map, pids);
+    std::vector<DWORD> out;
+    out.reserve(pids.size());
+    for (auto _ : state) {
+        out.clear();
+        for (const auto& [pid, tp] : map) {
+            if (tp->hot.phase == ProcessPhase::STABLE) out.push_back(pid);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pids.size()));
+}
+BENCHMARK(BM_TrackedSweep_LegacyMap)->Arg(2000)->Arg(32768);
+
+void BM_TrackedSweep_PidTable(benchmark::State& state) {
+    const auto pids = MakePids(static_cast<size_t>(state.range(0)), 1);
+    TrackedTable table;
+    FillTable(table, pids);
+    std::vector<DWORD> out;
+    out.reserve(pids.size());
+    for (auto _ : state) {
+        out.clear();
+        for (const auto& [pid, hot, tp] : table) {
+            if (hot.phase == ProcessPhase::STABLE) out.push_back(pid);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pids.size()));
+}
+BENCHMARK(BM_TrackedSweep_PidTable)->Arg(2000)->Arg(32768);
+
+} // namespace
@@ -0,0 +1,152 @@
+// UnLeaf Benchmarks - descendant collection: legacy InitialScan map vs. persistent process tree
+// A synthetic system of N processes with 8 target roots owning 64-process subtrees
+// (browser-like). LegacyCollect is the pre-§9.37 InitialScan: std::map<pid, info> rebuilt
+// from the snapshot and a recursive lambda that scans the whole map per visited node.
+// The tree is seeded once; each query walks only the target's subtree.
+// Churn measures the per-event cost (start + exit) the tree adds to the monitor callbacks.
+
+#include <benchmark/benchmark.h>
+#include "engine/process_tree.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using engine_logic::ProcessTree;
+
+namespace {
+
+constexpr size_t kTargets = 8;
+constexpr size_t kSubtree = 64;
+
+struct SnapshotEntry {
+    uint32_t pid;
+    uint32_t parentPid;
+    std::wstring name;
+};
+
+// Windows-style PIDs. The first kTargets * kSubtree entries form the target subtrees,
+// the rest hang off random earlier processes (services, shells, tools).
+std::vector<SnapshotEntry> MakeSystem(size_t n) {
+    std::mt19937 rng(7);
+    std::vector<SnapshotEntry> procs;
+    procs.reserve(n);
+    procs.push_back({4, 0, L"System"});
+    for (size_t t = 0; t < kTargets; ++t) {
+        const uint32_t root = static_cast<uint32_t>(procs.size()) * 4 + 4;
+        procs.push_back({root, 4, L"target.exe"});
+        for (size_t i = 1; i < kSubtree; ++i) {
+            std::uniform_int_distribution<uint32_t> up(0, static_cast<uint32_t>(i - 1));
+            const uint32_t parent = root + up(rng) * 4;
+            procs.push_back({static_cast<uint32_t>(procs.size()) * 4 + 4, parent, L"target_child.exe"});
+        }
+    }
+    while (procs.size() < n) {
+        std::uniform_int_distribution<size_t> up(0, procs.size() - 1);
+        procs.push_back({static_cast<uint32_t>(procs.size()) * 4 + 4, procs[up(rng)].pid,
+                         L"process_" + std::to_wstring(procs.size()) + L".exe"});
+    }
+    // Toolhelp order is not parent-first
+    std::shuffle(procs.begin() + 1, procs.end(), rng);
+    return procs;
+}
+
+std::vector<ProcessTree::LiveEntry> LiveOf(const std::vector<SnapshotEntry>& procs) {
+    std::vector<ProcessTree::LiveEntry> live;
+    live.reserve(procs.size());
+    for (const auto& p : procs) live.push_back({p.pid, p.parentPid, p.name});
+    return live;
+}
+
+size_t LegacyCollect(const std::vector<SnapshotEntry>& procs) {
+    struct ProcessInfo {
+        std::wstring name;
+        uint32_t parentPid;
+    };
+    std::map<uint32_t, ProcessInfo> processMap;
+    for (const auto& p : procs) processMap[p.pid] = {p.name, p.parentPid};
+
+    std::function<void(uint32_t, std::vector<std::pair<uint32_t, std::wstring>>&)> collect;
+    collect = [&](uint32_t parentPid, std::vector<std::pair<uint32_t, std::wstring>>& out) {
+        for (const auto& [pid, info] : processMap) {
+            if (info.parentPid == parentPid) {
+                out.emplace_back(pid, info.name);
+                collect(pid, out);
+            }
+        }
+    };
+
+    size_t found = 0;
+    for (const auto& [pid, info] : processMap) {
+        if (info.name != L"target.exe") continue;
+        std::vector<std::pair<uint32_t, std::wstring>> descendants;
+        collect(pid, descendants);
+        found += descendants.size();
+    }
+    return found;
+}
+
+} // namespace
+
+static void BM_Descendants_LegacyMap(benchmark::State& state) {
+    const auto procs = MakeSystem(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(LegacyCollect(procs));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kTargets));
+}
+BENCHMARK(BM_Descendants_LegacyMap)->Arg(500)->Arg(2000)->Unit(benchmark::kMicrosecond);
+
+static void BM_Descendants_Tree(benchmark::State& state) {
+    const auto procs = MakeSystem(static_cast<size_t>(state.range(0)));
+    ProcessTree tree;
+    tree.Seed(LiveOf(procs), 0);
+    std::vector<uint32_t> roots;
+    for (const auto& p : procs) {
+        if (p.name == L"target.exe") roots.push_back(p.pid);
+    }
+    for (auto _ : state) {
+        size_t found = 0;
+        for (uint32_t root : roots) {
+            tree.ForEachDescendant(root, [&](uint32_t, const ProcessTree::Node&) {
+                ++found;
+                return true;
+            });
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kTargets));
+}
+BENCHMARK(BM_Descendants_Tree)->Arg(500)->Arg(2000)->Unit(benchmark::kMicrosecond);
+
+// Startup seed (once per engine start, replaces the map build)
+static void BM_Tree_Seed(benchmark::State& state) {
+    const auto procs = MakeSystem(static_cast<size_t>(state.range(0)));
+    const auto live = LiveOf(procs);
+    ProcessTree tree;
+    for (auto _ : state) {
+        tree.Seed(live, 0);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(live.size()));
+}
+BENCHMARK(BM_Tree_Seed)->Arg(500)->Arg(2000)->Unit(benchmark::kMicrosecond);
+
+// One short-lived child start + exit under a busy parent
+static void BM_Tree_StartExitChurn(benchmark::State& state) {
+    const auto procs = MakeSystem(2000);
+    ProcessTree tree;
+    tree.Seed(LiveOf(procs), 0);
+    const uint32_t parent = procs[1].pid;
+    uint32_t pid = 1u << 20;
+    uint64_t now = 1;
+    for (auto _ : state) {
+        tree.Insert(pid, parent, now++, L"cmd.exe");
+        tree.Remove(pid);
+        pid += 4;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Tree_StartExitChurn);
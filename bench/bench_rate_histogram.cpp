@@ -0,0 +1,35 @@
+// UnLeaf Benchmarks - per-second rate histogram (§9.35)
+// Per-event cost of RateHistogram::Add on the admission path (EngineCore::AdmitRequest runs
+// on the ETW thread, timer callbacks and the control loop at once):
+//   Add/threads:N : N writers on one histogram, clock advancing 1 s every 4096 events per writer
+//   Read          : CMD_GET_STATS snapshot cost per histogram
+
+#include <benchmark/benchmark.h>
+#include "engine/rate_histogram.h"
+
+using engine_logic::RateHistogram;
+
+namespace {
+
+RateHistogram g_shared;
+
+void BM_RateHistogram_Add(benchmark::State& state) {
+    uint64_t i = 0;
+    for (auto _ : state) {
+        g_shared.Add((i++ >> 12) * 1000);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RateHistogram_Add)->Threads(1)->Threads(4);
+
+void BM_RateHistogram_Read(benchmark::State& state) {
+    RateHistogram h;
+    h.Reset(0);
+    for (uint64_t sec = 0; sec < 60; ++sec) h.Add(sec * 1000, static_cast<uint32_t>(sec * 37));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(h.Read(61000));
+    }
+}
+BENCHMARK(BM_RateHistogram_Read);
+
+} // namespace
@@ -0,0 +1,54 @@
+// UnLeaf Benchmarks - Interned image strings (§9.30)
+// Per admitted ETW_PROCESS_START, what the request costs to carry its image:
+//   Wstring : name + path copied into owned std::wstring (pre-§9.30 EnforcementRequest)
+//   Intern  : Intern (hit: same image already live) + Release, 4-byte ID in the request
+// View is the lock-free read used by dispatch and logging.
+
+#include <benchmark/benchmark.h>
+#include "engine/string_intern.h"
+
+#include <string>
+
+using engine_logic::StringInternTable;
+
+namespace {
+
+const std::wstring kImage =
+    L"\\Device\\HarddiskVolume3\\Program Files\\Google\\Chrome\\Application\\chrome.exe";
+
+void BM_ImageCarry_Wstring(benchmark::State& state) {
+    for (auto _ : state) {
+        std::wstring path(kImage);
+        std::wstring name(path.substr(path.find_last_of(L'\\') + 1));
+        benchmark::DoNotOptimize(path.data());
+        benchmark::DoNotOptimize(name.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ImageCarry_Wstring);
+
+void BM_ImageCarry_InternHit(benchmark::State& state) {
+    StringInternTable table;
+    const StringInternTable::Id resident = table.Intern(kImage);   // tracked sibling keeps it live
+    for (auto _ : state) {
+        const StringInternTable::Id id = table.Intern(kImage);
+        benchmark::DoNotOptimize(id);
+        table.Release(id);
+    }
+    table.Release(resident);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ImageCarry_InternHit);
+
+void BM_InternView(benchmark::State& state) {
+    StringInternTable table;
+    const StringInternTable::Id id = table.Intern(kImage);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.View(id).size());
+    }
+    table.Release(id);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InternView);
+
+} // namespace
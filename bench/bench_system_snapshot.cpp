@@ -0,0 +1,89 @@
+// UnLeaf Benchmarks - per-tick process / thread snapshot (§9.38)
+// One control-loop tick with 3 snapshot consumers (SafetyNet, ETW health, loss rescan) and
+// Arg(0) throttle-release pulses on this process.
+// PerCaller is the pre-§9.38 shape: every consumer captures into a fresh std::vector of
+// (pid, ppid, std::wstring) and every pulse lists /proc/<pid>/task on its own.
+// Shared captures once into a reused arena; pulses read the thread ids from it.
+// Capture alone shows the /proc walk cost on this machine.
+
+#include <benchmark/benchmark.h>
+#include "platform/linux/linux_system_snapshot.h"
+
+#include <dirent.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using engine_logic::SystemSnapshot;
+using unleaf::platform::LinuxSystemSnapshot;
+
+namespace {
+
+constexpr int kConsumers = 3;
+
+struct LegacyEntry {
+    uint32_t pid;
+    uint32_t parentPid;
+    std::wstring name;
+};
+
+std::vector<LegacyEntry> LegacyCapture(LinuxSystemSnapshot& source, SystemSnapshot& scratch) {
+    source.Capture(scratch);
+    std::vector<LegacyEntry> out;
+    for (const auto& p : scratch) out.push_back({p.pid, p.parentPid, std::wstring(scratch.Name(p))});
+    return out;
+}
+
+size_t ListTasks(pid_t pid) {
+    const std::string path = "/proc/" + std::to_string(pid) + "/task";
+    DIR* dir = ::opendir(path.c_str());
+    if (!dir) return 0;
+    size_t n = 0;
+    while (const dirent* e = ::readdir(dir)) {
+        if (e->d_name[0] != '.') ++n;
+    }
+    ::closedir(dir);
+    return n;
+}
+
+} // namespace
+
+static void BM_Snapshot_Capture(benchmark::State& state) {
+    LinuxSystemSnapshot source;
+    SystemSnapshot snap;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(source.Capture(snap));
+    }
+    state.counters["processes"] = static_cast<double>(snap.Size());
+    state.counters["threads"] = static_cast<double>(snap.ThreadTotal());
+}
+BENCHMARK(BM_Snapshot_Capture)->Unit(benchmark::kMicrosecond);
+
+static void BM_Tick_PerCaller(benchmark::State& state) {
+    LinuxSystemSnapshot source;
+    SystemSnapshot scratch;
+    const pid_t self = ::getpid();
+    for (auto _ : state) {
+        size_t rows = 0;
+        for (int c = 0; c < kConsumers; ++c) rows += LegacyCapture(source, scratch).size();
+        for (int64_t i = 0; i < state.range(0); ++i) rows += ListTasks(self);
+        benchmark::DoNotOptimize(rows);
+    }
+}
+BENCHMARK(BM_Tick_PerCaller)->Arg(1)->Arg(16)->Unit(benchmark::kMicrosecond);
+
+static void BM_Tick_Shared(benchmark::State& state) {
+    LinuxSystemSnapshot source;
+    SystemSnapshot snap;
+    const uint32_t self = static_cast<uint32_t>(::getpid());
+    for (auto _ : state) {
+        source.Capture(snap);
+        size_t rows = 0;
+        for (int c = 0; c < kConsumers; ++c) rows += snap.Size();
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            if (const SystemSnapshot::Process* p = snap.Find(self)) rows += p->threadCount;
+        }
+        benchmark::DoNotOptimize(rows);
+    }
+}
+BENCHMARK(BM_Tick_Shared)->Arg(1)->Arg(16)->Unit(benchmark::kMicrosecond);
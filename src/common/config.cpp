@@ -21,6 +21,16 @@ void StripUtf8Bom(std::string& content) {
         content.erase(0, 3);
     }
 }
+
+// FNV-1a 64 over the raw file bytes (change detection only)
+uint64_t HashContent(const std::string& content) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : content) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
 } // anonymous namespace
 
 namespace unleaf {
@@ -34,13 +44,15 @@ UnLeafConfig::UnLeafConfig()
     : logLevel_(LogLevel::LOG_INFO)
     , logEnabled_(true)
     , crashDumpEnabled_(false)
-    , lastModTime_(0) {
+    , eventTraceEnabled_(false)
+    , lastModTime_(0)
+    , lastContentHash_(0) {
 }
 
 bool UnLeafConfig::Initialize(const std::wstring& baseDir) {
     CSLockGuard lock(cs_);
 
-    configPath_ = baseDir + L"\\" + CONFIG_FILENAME;
+    configPath_ = baseDir + PATH_SEPARATOR + CONFIG_FILENAME;
 
     // Check for INI file first
     if (fs::exists(configPath_)) {
@@ -58,7 +70,7 @@ bool UnLeafConfig::Initialize(const std::wstring& baseDir) {
 }
 
 bool UnLeafConfig::MigrateFromJson(const std::wstring& baseDir) {
-    std::wstring oldPath = baseDir + L"\\" + CONFIG_FILENAME_OLD;
+    std::wstring oldPath = baseDir + PATH_SEPARATOR + CONFIG_FILENAME_OLD;
 
     if (!fs::exists(oldPath)) {
         return false;
@@ -66,7 +78,7 @@ bool UnLeafConfig::MigrateFromJson(const std::wstring& baseDir) {
 
     try {
         // Read old JSON file
-        std::ifstream file(oldPath, std::ios::binary);
+        std::ifstream file(fs::path(oldPath), std::ios::binary);
         if (!file.is_open()) {
             return false;
         }
@@ -108,30 +120,14 @@ bool UnLeafConfig::Reload() {
     CSLockGuard lock(cs_);
 
     try {
-        if (!fs::exists(configPath_)) {
-            return false;
-        }
-
-        // File size guard (max 1MB)
-        auto fsize = fs::file_size(configPath_);
-        if (fsize > 1048576) {
-            LOG_ERROR(L"Config: File too large (" + std::to_wstring(fsize) + L" bytes), max 1MB");
-            return false;
-        }
-
-        // Read file content
-        std::ifstream file(configPath_, std::ios::binary);
-        if (!file.is_open()) {
+        std::string content;
+        if (!ReadConfigFile(content)) {
             return false;
         }
 
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        std::string content = buffer.str();
-        file.close();
-
         // Update modification time
         lastModTime_ = GetFileModTime();
+        lastContentHash_ = HashContent(content);
 
         // Parse INI
         if (!ParseIni(content)) {
@@ -157,7 +153,7 @@ bool UnLeafConfig::Save() {
     try {
         std::string iniContent = SerializeIni();
 
-        std::ofstream file(configPath_, std::ios::binary | std::ios::trunc);
+        std::ofstream file(fs::path(configPath_), std::ios::binary | std::ios::trunc);
         if (!file.is_open()) {
             return false;
         }
@@ -166,6 +162,7 @@ bool UnLeafConfig::Save() {
         file.close();
 
         lastModTime_ = GetFileModTime();
+        lastContentHash_ = HashContent(iniContent);
         return true;
     }
     catch (const std::exception& e) {
@@ -190,6 +187,7 @@ bool UnLeafConfig::ParseIni(const std::string& contentIn) {
         logLevel_ = LogLevel::LOG_INFO;
         logEnabled_ = true;
         crashDumpEnabled_ = false;
+        eventTraceEnabled_ = false;
         managerWindowState_ = ManagerWindowState{};
         logColumnOrder_     = LogColumnOrder{};
 
@@ -244,11 +242,7 @@ bool UnLeafConfig::ParseIni(const std::string& contentIn) {
                 bool enabled = (value == "1" || value == "true");
 
                 // Convert to wide string
-                int size = MultiByteToWideChar(CP_UTF8, 0, key.c_str(),
-                                               static_cast<int>(key.size()), nullptr, 0);
-                std::wstring wideName(size, L'\0');
-                MultiByteToWideChar(CP_UTF8, 0, key.c_str(),
-                                   static_cast<int>(key.size()), &wideName[0], size);
+                std::wstring wideName = Utf8ToWide(key.c_str());
 
                 // Validate entry (name or absolute path)
                 if (!IsValidTargetEntry(wideName)) {
@@ -300,6 +294,12 @@ bool UnLeafConfig::ParseIni(const std::string& contentIn) {
                                   [](unsigned char c) { return static_cast<char>(::tolower(c)); });
                     crashDumpEnabled_ = (lowerValue == "1" || lowerValue == "true" || lowerValue == "yes" || lowerValue == "on");
                 }
+                else if (lowerKey == "eventtrace") {
+                    std::string lowerValue = value;
+                    std::transform(lowerValue.begin(), lowerValue.end(), lowerValue.begin(),
+                                  [](unsigned char c) { return static_cast<char>(::tolower(c)); });
+                    eventTraceEnabled_ = (lowerValue == "1" || lowerValue == "true" || lowerValue == "yes" || lowerValue == "on");
+                }
                 else {
                     // Warn on unknown keys in [Logging]
                     std::wstring wideKey(key.begin(), key.end());
@@ -360,6 +360,11 @@ std::string UnLeafConfig::SerializeIni() const {
     oss << "; Crash dump (MiniDump) on unhandled exception: 1=enabled, 0=disabled\n";
     oss << "; Dumps are written to <install dir>\\crash\\UnLeaf_Service_<timestamp>.dmp\n";
     oss << "CrashDump=" << (crashDumpEnabled_ ? "1" : "0") << "\n";
+    if (eventTraceEnabled_) {
+        // Diagnostic only: written back while enabled, omitted from the default file
+        oss << "; Record ETW process/thread start events to <install dir>\\UnLeaf_events.ultrace\n";
+        oss << "EventTrace=1\n";
+    }
     oss << "\n";
 
     // Manager section (window state + column order)
@@ -385,16 +390,7 @@ std::string UnLeafConfig::SerializeIni() const {
     oss << "[Targets]\n";
     for (const auto& target : targets_) {
         // Convert wide string to UTF-8
-        std::string name;
-        int size = WideCharToMultiByte(CP_UTF8, 0, target.name.c_str(),
-                                       static_cast<int>(target.name.size()),
-                                       nullptr, 0, nullptr, nullptr);
-        if (size > 0) {
-            name.resize(size);
-            WideCharToMultiByte(CP_UTF8, 0, target.name.c_str(),
-                               static_cast<int>(target.name.size()),
-                               &name[0], size, nullptr, nullptr);
-        }
+        std::string name = WideToUtf8(target.name.c_str());
 
         oss << name << "=" << (target.enabled ? "1" : "0") << "\n";
     }
@@ -430,11 +426,7 @@ bool UnLeafConfig::ParseJson(const std::string& contentIn) {
                 }
 
                 // Convert to wide string
-                int size = MultiByteToWideChar(CP_UTF8, 0, name.c_str(),
-                                               static_cast<int>(name.size()), nullptr, 0);
-                std::wstring wideName(size, L'\0');
-                MultiByteToWideChar(CP_UTF8, 0, name.c_str(),
-                                   static_cast<int>(name.size()), &wideName[0], size);
+                std::wstring wideName = Utf8ToWide(name.c_str());
 
                 targets_.emplace_back(wideName, enabled);
             }
@@ -519,6 +511,53 @@ bool UnLeafConfig::HasFileChanged() const {
     return GetFileModTime() != lastModTime_;
 }
 
+bool UnLeafConfig::HasContentChanged() {
+    CSLockGuard lock(cs_);
+
+    const uint64_t modTime = GetFileModTime();
+    if (modTime == lastModTime_) {
+        return false;
+    }
+    std::string content;
+    if (!ReadConfigFile(content)) {
+        return true;   // Unreadable mid-save: let Reload() report it
+    }
+    if (HashContent(content) != lastContentHash_) {
+        return true;
+    }
+    lastModTime_ = modTime;   // Same bytes: later checks stop at the time stamp
+    return false;
+}
+
+bool UnLeafConfig::ReadConfigFile(std::string& content) const {
+    try {
+        if (!fs::exists(configPath_)) {
+            return false;
+        }
+
+        // File size guard (max 1MB)
+        auto fsize = fs::file_size(configPath_);
+        if (fsize > 1048576) {
+            LOG_ERROR(L"Config: File too large (" + std::to_wstring(fsize) + L" bytes), max 1MB");
+            return false;
+        }
+
+        std::ifstream file(fs::path(configPath_), std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        content = buffer.str();
+        return true;
+    }
+    catch (const std::exception& e) {
+        LOG_DEBUG(std::string("Config: Read error - ") + e.what());
+        return false;
+    }
+}
+
 uint64_t UnLeafConfig::GetFileModTime() const {
     try {
         if (fs::exists(configPath_)) {
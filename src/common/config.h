@@ -10,6 +10,7 @@
 #include <atomic>
 
 class ConfigParserTest;
+class UnLeafBenchAccess;
 
 namespace unleaf {
 
@@ -54,6 +55,7 @@ public:
     LogLevel GetLogLevel() const { return logLevel_; }
     bool IsLogEnabled() const { return logEnabled_; }
     bool IsCrashDumpEnabled() const { return crashDumpEnabled_; }
+    bool IsEventTraceEnabled() const { return eventTraceEnabled_; }
 
     // Target management
     bool AddTarget(const std::wstring& name);
@@ -66,12 +68,17 @@ public:
     // Check if file has been modified since last load
     bool HasFileChanged() const;
 
+    // §9.34: HasFileChanged, then a content hash against the last load / save.
+    // A touch or an identical save adopts the new time stamp and returns false.
+    bool HasContentChanged();
+
     // Callback for configuration changes
     using ConfigChangeCallback = std::function<void()>;
     void SetChangeCallback(ConfigChangeCallback callback);
 
 private:
     friend class ::ConfigParserTest;
+    friend class ::UnLeafBenchAccess;
 
     UnLeafConfig();
     ~UnLeafConfig() = default;
@@ -93,16 +100,21 @@ private:
     // Get file modification time
     uint64_t GetFileModTime() const;
 
+    // Read the INI file (1MB guard); false when missing / too large / unreadable
+    bool ReadConfigFile(std::string& content) const;
+
     std::wstring configPath_;
     std::vector<TargetProcess> targets_;
     LogLevel logLevel_;
     bool logEnabled_;
     bool crashDumpEnabled_;    // [Logging] CrashDump=0/1 — default disabled
+    bool eventTraceEnabled_;   // [Logging] EventTrace=0/1 — default disabled (§9.27)
     ManagerWindowState managerWindowState_;
     LogColumnOrder     logColumnOrder_;
 
     mutable CriticalSection cs_;
     uint64_t lastModTime_;
+    uint64_t lastContentHash_;   // §9.34: FNV-1a of the bytes last loaded / saved
     ConfigChangeCallback changeCallback_;
 };
 
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <vector>
 
+#ifdef _WIN32
 // POSIX rename constants — available since Windows 10 1607 (Build 14393).
 // UnLeaf minimum requirement: Windows 1709 (Build 16299). Safe to use unconditionally.
 #ifndef FILE_RENAME_FLAG_REPLACE_IF_EXISTS
@@ -18,9 +19,11 @@
 #ifndef FileRenameInfoEx
 #   define FileRenameInfoEx ((FILE_INFO_BY_HANDLE_CLASS)22)
 #endif
+#endif
 
 namespace unleaf {
 
+#ifdef _WIN32
 // RAII guard for the inter-process rotation mutex.
 // Acquires on construction (INFINITE wait); releases on destruction if acquired.
 // Eliminates manual ReleaseMutex on every return path in CheckRotation().
@@ -54,6 +57,8 @@ private:
     DWORD  error_;
 };
 
+#endif // _WIN32
+
 LightweightLogger& LightweightLogger::Instance() {
     static LightweightLogger instance;
     return instance;
@@ -76,6 +81,7 @@ LightweightLogger::~LightweightLogger() {
     Shutdown();
 }
 
+#ifdef _WIN32
 bool LightweightLogger::Initialize(const std::wstring& baseDir) {
     CSLockGuard lock(cs_);
 
@@ -83,8 +89,8 @@ bool LightweightLogger::Initialize(const std::wstring& baseDir) {
         return true;
     }
 
-    logPath_ = baseDir + L"\\" + LOG_FILENAME;
-    backupPath_ = baseDir + L"\\" + LOG_BACKUP_FILENAME;
+    logPath_ = baseDir + PATH_SEPARATOR + LOG_FILENAME;
+    backupPath_ = baseDir + PATH_SEPARATOR + LOG_BACKUP_FILENAME;
 
     // Open file for append.
     // FILE_SHARE_DELETE is required so that the POSIX rename (SetFileInformationByHandle)
@@ -166,6 +172,8 @@ void LightweightLogger::SetConsoleOutput(bool enabled) {
     }
 }
 
+#endif // _WIN32 (POSIX: logger_posix.cpp)
+
 void LightweightLogger::SetLogLevel(LogLevel level) {
     CSLockGuard lock(cs_);
     currentLevel_ = level;
@@ -231,6 +239,7 @@ void LightweightLogger::Manager(const std::wstring& message) {
     Log(LogLevel::LOG_INFO, L"M", message);
 }
 
+#ifdef _WIN32
 void LightweightLogger::WriteMessage(const std::wstring& formattedMessage) {
     CSLockGuard lock(cs_);
 
@@ -682,6 +691,8 @@ void LightweightLogger::CheckStaleHandle() {
     }
 }
 
+#endif // _WIN32 (POSIX: logger_posix.cpp)
+
 void LightweightLogger::SetRotationEnabled(bool enabled) {
     CSLockGuard lock(cs_);
     rotationEnabled_ = enabled;
@@ -694,16 +705,21 @@ std::wstring LightweightLogger::GetTimestamp() const {
     auto time = std::chrono::system_clock::to_time_t(now);
 
     std::tm tm_buf;
+#ifdef _WIN32
     localtime_s(&tm_buf, &time);
+#else
+    localtime_r(&time, &tm_buf);
+#endif
 
     wchar_t buffer[32];
     wcsftime(buffer, 32, L"%Y-%m-%d %H:%M:%S", &tm_buf);
 
     wchar_t full[40];
-    swprintf_s(full, L"%s.%03d", buffer, static_cast<int>(ms.count()));
+    swprintf_s(full, L"%ls.%03d", buffer, static_cast<int>(ms.count()));
     return std::wstring(full);
 }
 
+#ifdef _WIN32
 std::wstring LightweightLogger::Utf8ToWide(const std::string& str) const {
     if (str.empty()) return L"";
 
@@ -732,6 +748,8 @@ std::string LightweightLogger::WideToUtf8(const std::wstring& str) const {
     return result;
 }
 
+#endif // _WIN32 (POSIX: logger_posix.cpp)
+
 void LightweightLogger::SetEnabled(bool enabled) {
     enabled_.store(enabled, std::memory_order_release);
 }
@@ -11,6 +11,9 @@
 #include <chrono>
 #include <functional>
 #include <vector>
+#include <cstdio>
+
+class UnLeafBenchAccess;
 
 namespace unleaf {
 
@@ -54,6 +57,8 @@ public:
     const std::wstring& GetLogPath() const { return logPath_; }
 
 private:
+    friend class ::UnLeafBenchAccess;
+
     LightweightLogger();
     ~LightweightLogger();
     LightweightLogger(const LightweightLogger&) = delete;
@@ -111,6 +116,10 @@ private:
     HANDLE   hRotationEvent_;    // inter-process rotation signal (Global\UnLeafLogRotated)
     uint32_t staleCheckCounter_; // periodic stale handle detection counter (Manager)
 
+#ifndef _WIN32
+    std::FILE* logFile_ = nullptr;  // POSIX sink (logger_posix.cpp); Win32 handles stay unused
+#endif
+
     void Log(LogLevel level, const wchar_t* levelStr, const std::wstring& message);
 };
 
@@ -0,0 +1,155 @@
+// UnLeaf - Lightweight Logger (POSIX backend)
+// Win32 版 (logger.cpp) と同じ契約: 100KB で UnLeaf.log.1 へローテーション、
+// rotation 診断は SafeInternalLog 経由のみ。プロセス間 mutex/event は持たない
+// (POSIX ビルドは単一プロセス: テスト / シミュレータ / Linux バックエンド)。
+
+#ifndef _WIN32
+
+#include "logger.h"
+#include "win_string_utils.h"
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+
+namespace unleaf {
+
+bool LightweightLogger::Initialize(const std::wstring& baseDir) {
+    CSLockGuard lock(cs_);
+
+    if (initialized_) {
+        return true;
+    }
+
+    logPath_ = baseDir + PATH_SEPARATOR + LOG_FILENAME;
+    backupPath_ = baseDir + PATH_SEPARATOR + LOG_BACKUP_FILENAME;
+
+    logFile_ = std::fopen(unleaf::WideToUtf8(logPath_.c_str()).c_str(), "ab");
+    if (!logFile_) {
+        return false;
+    }
+
+    initialized_ = true;
+    return true;
+}
+
+void LightweightLogger::Shutdown() {
+    CSLockGuard lock(cs_);
+
+    if (logFile_) {
+        std::fclose(logFile_);
+        logFile_ = nullptr;
+    }
+
+    initialized_ = false;
+}
+
+void LightweightLogger::SetConsoleOutput(bool enabled) {
+    CSLockGuard lock(cs_);
+    consoleOutput_ = enabled;
+}
+
+void LightweightLogger::WriteMessage(const std::wstring& formattedMessage) {
+    CSLockGuard lock(cs_);
+
+    if (!initialized_) return;
+
+    if (!logFile_) {
+        logFile_ = std::fopen(unleaf::WideToUtf8(logPath_.c_str()).c_str(), "ab");
+    }
+    if (!logFile_) return;
+
+    RotationResult rotResult = CheckRotation();
+
+    // After rotation, logFile_ is closed for rename; reopen before write.
+    if (!logFile_) {
+        logFile_ = std::fopen(unleaf::WideToUtf8(logPath_.c_str()).c_str(), "ab");
+        if (!logFile_) return;
+    }
+
+    std::string utf8Msg = WideToUtf8(formattedMessage);
+    utf8Msg += "\r\n";
+    if (std::fwrite(utf8Msg.data(), 1, utf8Msg.size(), logFile_) != utf8Msg.size() ||
+        std::fflush(logFile_) != 0) {
+        // FAIL-SAFE: disable further logging to prevent I/O error loops.
+        enabled_.store(false, std::memory_order_release);
+    }
+
+    if (rotResult.triggered) {
+        const std::wstring ts = GetTimestamp();
+        if (!rotResult.success) {
+            SafeInternalLog(ts + L" A [LOGGER] Rotation FAILED (err=" +
+                            std::to_wstring(rotResult.error) +
+                            L") - original log preserved; will retry on next write");
+        } else {
+            SafeInternalLog(ts + L" I [LOGGER] Log rotated successfully");
+        }
+    }
+
+    if (consoleOutput_) {
+        std::wcout << formattedMessage << std::endl;
+    }
+}
+
+LightweightLogger::RotationResult LightweightLogger::CheckRotation() {
+    RotationResult result;
+    if (!rotationEnabled_ || !logFile_) return result;
+
+    long size = std::ftell(logFile_);
+    if (size < 0 || static_cast<size_t>(size) < MAX_LOG_SIZE) return result;
+
+    result.triggered = true;
+    std::fclose(logFile_);
+    logFile_ = nullptr;
+
+    const std::string from = unleaf::WideToUtf8(logPath_.c_str());
+    const std::string to   = unleaf::WideToUtf8(backupPath_.c_str());
+    if (std::rename(from.c_str(), to.c_str()) == 0) {
+        result.success = true;
+    } else {
+        result.error = static_cast<DWORD>(errno);
+    }
+    return result;
+}
+
+void LightweightLogger::SafeInternalLog(const std::wstring& msg) {
+    // STRICTLY for rotation internal diagnostics (see logger.cpp).
+    CSLockGuard lock(cs_);
+
+    std::FILE* local = logFile_;
+    bool tempOpened = false;
+    if (!local) {
+        local = std::fopen(unleaf::WideToUtf8(logPath_.c_str()).c_str(), "ab");
+        if (!local) return;
+        tempOpened = true;
+    }
+
+    std::string utf8 = WideToUtf8(msg);
+    utf8 += "\r\n";
+    (void)std::fwrite(utf8.data(), 1, utf8.size(), local);
+
+    if (tempOpened) {
+        std::fclose(local);
+    } else {
+        std::fflush(local);
+    }
+}
+
+void LightweightLogger::CheckStaleHandle() {
+    // Manager-side stale handle convergence is Windows-only (no cross-process writer on POSIX).
+}
+
+std::wstring LightweightLogger::Utf8ToWide(const std::string& str) const {
+    if (str.empty()) return L"";
+    std::wstring result = unleaf::Utf8ToWide(str.c_str());
+    return result == L"(conv_error)" ? std::wstring() : result;
+}
+
+std::string LightweightLogger::WideToUtf8(const std::wstring& str) const {
+    if (str.empty()) return "";
+    std::string result = unleaf::WideToUtf8(str.c_str());
+    return result == "(conv_error)" ? std::string() : result;
+}
+
+} // namespace unleaf
+
+#endif // !_WIN32
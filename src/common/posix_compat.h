@@ -0,0 +1,97 @@
+#pragma once
+// UnLeaf - POSIX build shim for the Win32 scalar vocabulary
+// Lets the portable core (engine_logic / EngineCore / common helpers) compile on
+// Linux with GCC/Clang. Types, constants and CRT helpers only — no Win32 API emulation.
+// Every OS call goes through src/platform/platform.h instead.
+
+#ifndef _WIN32
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdarg>
+#include <cwchar>
+#include <cwctype>
+
+// Win32 scalar types (LLP64 widths: DWORD/ULONG/LONG are 32-bit on Windows)
+using DWORD     = uint32_t;
+using ULONG     = uint32_t;
+using LONG      = int32_t;
+using ULONGLONG = uint64_t;
+using LONGLONG  = int64_t;
+using BOOL      = int;
+using BOOLEAN   = unsigned char;
+using BYTE      = uint8_t;
+using ULONG_PTR = uintptr_t;
+using PVOID     = void*;
+using HANDLE    = void*;
+
+#ifndef TRUE
+#define TRUE  1
+#endif
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+// Calling convention decorations are meaningless off Windows
+#define CALLBACK
+#define WINAPI
+#define NTAPI
+
+#define MAX_PATH             260
+#define INFINITE             0xFFFFFFFFu
+#define INVALID_HANDLE_VALUE (reinterpret_cast<HANDLE>(static_cast<intptr_t>(-1)))
+#define STILL_ACTIVE         259u
+
+// WaitForMultipleObjects-compatible result codes (IEventService::WaitAny)
+#define WAIT_OBJECT_0 0u
+#define WAIT_TIMEOUT  258u
+#define WAIT_FAILED   0xFFFFFFFFu
+
+// Priority classes (SetPriorityClass vocabulary, see IProcessControl)
+#define IDLE_PRIORITY_CLASS         0x00000040u
+#define BELOW_NORMAL_PRIORITY_CLASS 0x00004000u
+#define NORMAL_PRIORITY_CLASS       0x00000020u
+#define ABOVE_NORMAL_PRIORITY_CLASS 0x00008000u
+#define HIGH_PRIORITY_CLASS         0x00000080u
+
+// Win32 error codes surfaced through IProcessControl::LastError() and friends
+#define ERROR_SUCCESS           0u
+#define ERROR_ACCESS_DENIED     5u
+#define ERROR_INVALID_HANDLE    6u
+#define ERROR_NOT_ENOUGH_MEMORY 8u
+#define ERROR_GEN_FAILURE       31u
+#define ERROR_NOT_SUPPORTED     50u
+#define ERROR_INVALID_PARAMETER 87u
+#define ERROR_IO_PENDING        997u
+
+// swprintf_s: array-deducing and explicit-size forms (MSVC secure CRT signatures).
+// Wide format strings must use %ls for wchar_t* arguments (portable to MSVC).
+template <size_t N>
+inline int swprintf_s(wchar_t (&buffer)[N], const wchar_t* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int written = std::vswprintf(buffer, N, format, args);
+    va_end(args);
+    if (written < 0) buffer[0] = L'\0';
+    return written;
+}
+
+inline int swprintf_s(wchar_t* buffer, size_t count, const wchar_t* format, ...) {
+    if (!buffer || count == 0) return -1;
+    va_list args;
+    va_start(args, format);
+    int written = std::vswprintf(buffer, count, format, args);
+    va_end(args);
+    if (written < 0) buffer[0] = L'\0';
+    return written;
+}
+
+template <size_t N>
+inline int wcscpy_s(wchar_t (&dest)[N], const wchar_t* src) {
+    size_t i = 0;
+    for (; i + 1 < N && src[i] != L'\0'; ++i) dest[i] = src[i];
+    dest[i] = L'\0';
+    return 0;
+}
+
+#endif // !_WIN32
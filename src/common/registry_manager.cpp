@@ -146,7 +146,7 @@ void RegistryPolicyManager::SaveManifestAtomic() {
         ptCopy.reserve(policyMap_.size());
         for (const auto& [key, entry] : policyMap_) {
             if (entry.state == PolicyState::COMMITTED) {
-                ptCopy.emplace_back(entry.registryPath, entry.lowerExeName);
+                ptCopy.emplace_back(entry.registryPath.str(), entry.lowerExeName.str());
             }
         }
         snapshotVersion = stateVersion_.load(std::memory_order_acquire);
@@ -614,7 +614,7 @@ void RegistryPolicyManager::ReconcileWithConfig(
             ifeoRefCount_.clear();
             for (const auto& [path, entry] : policyMap_) {
                 if (entry.state == PolicyState::COMMITTED || entry.state == PolicyState::APPLYING)
-                    ifeoRefCount_[entry.lowerExeName]++;
+                    ifeoRefCount_[entry.lowerExeName.str()]++;
             }
 
             // Stale IFEO: in ifeoAppliedSet_ but not in desiredNames,
@@ -623,7 +623,7 @@ void RegistryPolicyManager::ReconcileWithConfig(
                 if (desiredNames.count(name) > 0) continue;
                 bool referencedByPath = false;
                 for (const auto& [path, entry] : policyMap_) {
-                    if (entry.lowerExeName == name && desiredPaths.count(path) > 0) {
+                    if (entry.lowerExeName.view() == name && desiredPaths.count(path) > 0) {
                         referencedByPath = true;
                         break;
                     }
@@ -637,9 +637,9 @@ void RegistryPolicyManager::ReconcileWithConfig(
             // and exe name not in desiredNames (name target still protects via IFEO)
             for (const auto& [path, entry] : policyMap_) {
                 if (desiredPaths.count(path) > 0) continue;
-                if (desiredNames.count(entry.lowerExeName) > 0) continue;
+                if (desiredNames.count(entry.lowerExeName.str()) > 0) continue;
                 if (entry.state == PolicyState::COMMITTED) {
-                    stalePT.emplace_back(entry.registryPath, entry.lowerExeName);
+                    stalePT.emplace_back(entry.registryPath.str(), entry.lowerExeName.str());
                 }
             }
         }
@@ -727,7 +727,7 @@ void RegistryPolicyManager::RemoveSinglePolicyInternal(
             deferred = true;
         } else {
             // COMMITTED — proceed with removal
-            registryPath = it->second.registryPath;
+            registryPath = it->second.registryPath.str();
             policyMap_.erase(it);
 
             auto rc = ifeoRefCount_.find(lowerName);
@@ -823,7 +823,7 @@ void RegistryPolicyManager::CleanupAllPolicies() {
         } else {
             ifeoCopy = ifeoAppliedSet_;
             for (const auto& [key, entry] : policyMap_) {
-                ptCopy.emplace_back(entry.lowerExeName, entry.registryPath);
+                ptCopy.emplace_back(entry.lowerExeName.str(), entry.registryPath.str());
             }
 
             ifeoAppliedSet_.clear();
@@ -872,7 +872,7 @@ void RegistryPolicyManager::RemoveAllPolicies() {
         } else {
             ifeoCopy = ifeoAppliedSet_;
             for (const auto& [key, entry] : policyMap_) {
-                ptCopy.emplace_back(entry.lowerExeName, entry.registryPath);
+                ptCopy.emplace_back(entry.lowerExeName.str(), entry.registryPath.str());
             }
             ifeoAppliedSet_.clear();
             policyMap_.clear();
@@ -919,7 +919,7 @@ void RegistryPolicyManager::VerifyAndRepair() {
         ifeoCopy = ifeoAppliedSet_;
         for (const auto& [key, entry] : policyMap_) {
             if (entry.state == PolicyState::COMMITTED) {
-                ptCopy.emplace_back(key, entry.registryPath);
+                ptCopy.emplace_back(key, entry.registryPath.str());
             }
         }
     }
@@ -958,8 +958,8 @@ bool RegistryPolicyManager::IsPolicyValid(const std::wstring& canonPath) const {
         auto it = policyMap_.find(normalized);
         if (it == policyMap_.end() || it->second.state != PolicyState::COMMITTED)
             return false;
-        lowerName = it->second.lowerExeName;
-        regPath = it->second.registryPath;
+        lowerName = it->second.lowerExeName.str();
+        regPath = it->second.registryPath.str();
     }
     return IFEOKeyExists(lowerName) && PowerThrottleValueExists(regPath);
 }
@@ -15,6 +15,7 @@
 
 #include "../common/types.h"
 #include "../common/logger.h"
+#include "../engine/string_intern.h"
 #include <string>
 #include <set>
 #include <map>
@@ -44,10 +45,11 @@ enum class PolicyState : uint8_t {
     COMMITTED    // Registry verified, memory consistent
 };
 
+// §9.30: names / paths interned (shared with TrackedProcess entries for the same image)
 struct PolicyEntry {
     PolicyState state;
-    std::wstring lowerExeName;
-    std::wstring registryPath;   // original path for registry value name
+    engine_logic::InternedString lowerExeName;
+    engine_logic::InternedString registryPath;   // original path for registry value name
 };
 
 // Lock-free pending removal node (Treiber stack)
@@ -1,7 +1,9 @@
 #pragma once
 // UnLeaf - RAII Handle Management
 // Zero-overhead abstraction for Windows HANDLEs
+// (POSIX build: only CriticalSection / CSLockGuard are available)
 
+#ifdef _WIN32
 // Prevent Windows macro conflicts
 #ifndef NOMINMAX
 #define NOMINMAX
@@ -12,11 +14,16 @@
 
 #include <windows.h>
 #include <winsvc.h>
+#else
+#include <mutex>
+#endif
 #include <memory>
 #include <type_traits>
 
 namespace unleaf {
 
+#ifdef _WIN32
+
 // Custom deleter for Windows HANDLEs
 struct HandleDeleter {
     using pointer = HANDLE;
@@ -144,6 +151,22 @@ public:
 private:
     CRITICAL_SECTION cs_;
 };
+#else
+// POSIX: recursive like CRITICAL_SECTION (EngineCore relies on re-entry)
+class CriticalSection {
+public:
+    CriticalSection() = default;
+    CriticalSection(const CriticalSection&) = delete;
+    CriticalSection& operator=(const CriticalSection&) = delete;
+
+    void lock() noexcept { mutex_.lock(); }
+    void unlock() noexcept { mutex_.unlock(); }
+    bool try_lock() noexcept { return mutex_.try_lock(); }
+
+private:
+    std::recursive_mutex mutex_;
+};
+#endif // _WIN32
 
 // RAII lock guard for CriticalSection
 class CSLockGuard {
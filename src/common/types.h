@@ -1,7 +1,8 @@
 #pragma once
 // UnLeaf - Common Type Definitions
-// Windows Native C++ Implementation
+// Windows Native C++ Implementation (portable core also builds on POSIX via posix_compat.h)
 
+#ifdef _WIN32
 // Prevent Windows macro conflicts
 #ifndef NOMINMAX
 #define NOMINMAX
@@ -28,7 +29,11 @@
 #ifdef max
 #undef max
 #endif
+#else
+#include "posix_compat.h"
+#endif
 
+#include <cassert>
 #include <string>
 #include <vector>
 #include <map>
@@ -62,6 +67,14 @@ constexpr const wchar_t* CONFIG_FILENAME = L"UnLeaf.ini";
 constexpr const wchar_t* CONFIG_FILENAME_OLD = L"UnLeaf.json";  // For migration
 constexpr const wchar_t* LOG_FILENAME = L"UnLeaf.log";
 constexpr const wchar_t* LOG_BACKUP_FILENAME = L"UnLeaf.log.1";
+constexpr const wchar_t* EVENT_TRACE_FILENAME = L"UnLeaf_events.ultrace";  // §9.27 ([Logging] EventTrace=1)
+
+// Directory separator used when joining baseDir with the file names above
+#ifdef _WIN32
+constexpr const wchar_t* PATH_SEPARATOR = L"\\";
+#else
+constexpr const wchar_t* PATH_SEPARATOR = L"/";
+#endif
 
 // Default Values
 constexpr size_t MAX_LOG_SIZE = 102400;    // 100KB
@@ -134,8 +147,10 @@ struct UnleafThrottleState {
 };
 
 // Pre-allocated check entry (cache-line aligned for performance)
+#ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable: 4324)  // structure padded due to alignment specifier
+#endif
 struct alignas(64) CheckInfoEntry {
     HANDLE handle;
     DWORD pid;
@@ -145,41 +160,11 @@ struct alignas(64) CheckInfoEntry {
     uint16_t flags;           // 0x01=isChild, 0x02=inJob
     ULONGLONG lastEnforceTime;
 };
+#ifdef _MSC_VER
 #pragma warning(pop)
+#endif
 
-// Job Object tracking (uses raw HANDLE, managed by EngineCore)
-struct JobObjectInfo {
-    HANDLE jobHandle;
-    DWORD rootPid;
-    bool isOwnJob;            // true if we created it
-
-    JobObjectInfo() : jobHandle(nullptr), rootPid(0), isOwnJob(false) {}
-    ~JobObjectInfo() {
-        if (jobHandle && jobHandle != INVALID_HANDLE_VALUE) {
-            CloseHandle(jobHandle);
-        }
-    }
-    // Non-copyable
-    JobObjectInfo(const JobObjectInfo&) = delete;
-    JobObjectInfo& operator=(const JobObjectInfo&) = delete;
-    // Movable
-    JobObjectInfo(JobObjectInfo&& other) noexcept
-        : jobHandle(other.jobHandle), rootPid(other.rootPid), isOwnJob(other.isOwnJob) {
-        other.jobHandle = nullptr;
-    }
-    JobObjectInfo& operator=(JobObjectInfo&& other) noexcept {
-        if (this != &other) {
-            if (jobHandle && jobHandle != INVALID_HANDLE_VALUE) {
-                CloseHandle(jobHandle);
-            }
-            jobHandle = other.jobHandle;
-            rootPid = other.rootPid;
-            isOwnJob = other.isOwnJob;
-            other.jobHandle = nullptr;
-        }
-        return *this;
-    }
-};
+// JobObjectInfo lives in engine_core.h (job handle owned via the platform layer)
 
 // Target Process Configuration
 struct TargetProcess {
@@ -227,6 +212,45 @@ struct LogResponseHeader {
     uint64_t newOffset;   // New offset after this data
     uint32_t dataLength;  // Length of log data following this header
 };
+
+// §9.35: CMD_GET_STATS telemetry. A request without StatsRequest gets the legacy reply
+// (uint32_t tracked-process count only); with it: uint32_t count + StatsTelemetry.
+constexpr uint32_t STATS_TELEMETRY_VERSION = 1;
+constexpr uint32_t STATS_RATE_BINS = 16;
+constexpr uint32_t STATS_REQUEST_TYPES = 5;   // EnforcementRequestType values
+
+struct StatsRequest {
+    uint32_t version;     // STATS_TELEMETRY_VERSION the client understands
+};
+
+// Per-second rate distribution: seconds[0] = idle seconds, seconds[k] = seconds with
+// [2^(k-1), 2^k) events, last bin open-ended
+struct StatsRateHistogram {
+    uint64_t total;
+    uint32_t lastSecond;
+    uint32_t peakPerSecond;
+    uint32_t seconds[STATS_RATE_BINS];
+};
+
+struct StatsQueueDepth {
+    uint32_t current;
+    uint32_t highWater;   // since service start
+    uint32_t limit;       // SOFT_LIMIT (NON-CRITICAL) / HARD_LIMIT (CRITICAL)
+};
+
+struct StatsTelemetry {
+    uint32_t version;         // STATS_TELEMETRY_VERSION
+    uint32_t size;            // sizeof(StatsTelemetry); later versions only append
+    uint64_t uptimeMs;
+    StatsRateHistogram processStarts;                    // records delivered by the monitor
+    StatsRateHistogram threadStarts;                     // events past the §9.28 prefilter
+    StatsRateHistogram enqueued[STATS_REQUEST_TYPES];    // accepted, by EnforcementRequestType
+    StatsRateHistogram dropped;                          // rejected (NON-CRITICAL + CRITICAL)
+    StatsRateHistogram evicted;                          // accepted by evicting an older entry
+    StatsQueueDepth criticalQueue;
+    StatsQueueDepth nonCriticalQueue;
+    uint32_t totalLimit;      // ENFORCEMENT_QUEUE_TOTAL_LIMIT
+};
 #pragma pack(pop)
 
 // System Critical Processes (Protection List)
@@ -343,9 +367,47 @@ inline std::wstring NormalizePath(const std::wstring& path) {
 // NormalizePath() MUST NOT be used for key generation or lookup.
 // Reason: NormalizePath does not resolve ".." or relative paths,
 // leading to key mismatches and orphaned entries.
+#ifndef _WIN32
+// POSIX build: no GetFullPathNameW. Resolve "." / ".." lexically on the
+// already-normalized (backslash, lowercase, prefix-free) form.
+inline std::wstring ResolveDotSegments(const std::wstring& normalized) {
+    size_t rootLen = 0;
+    if (normalized.size() >= 2 && normalized[0] == L'\\' && normalized[1] == L'\\') {
+        rootLen = 2;                                   // UNC root
+    } else if (normalized.size() >= 3 && normalized[1] == L':' && normalized[2] == L'\\') {
+        rootLen = 3;                                   // drive root
+    }
+
+    std::vector<std::wstring> segments;
+    size_t pos = rootLen;
+    while (pos <= normalized.size()) {
+        size_t next = normalized.find(L'\\', pos);
+        if (next == std::wstring::npos) next = normalized.size();
+        std::wstring seg = normalized.substr(pos, next - pos);
+        if (seg == L"..") {
+            if (!segments.empty()) segments.pop_back();
+        } else if (!seg.empty() && seg != L".") {
+            segments.push_back(std::move(seg));
+        }
+        pos = next + 1;
+    }
+
+    std::wstring result = normalized.substr(0, rootLen);
+    for (size_t i = 0; i < segments.size(); ++i) {
+        if (i > 0) result += L'\\';
+        result += segments[i];
+    }
+    return result;
+}
+#endif
+
 inline std::wstring CanonicalizePath(const std::wstring& rawPath) {
     if (rawPath.empty()) return L"";
 
+#ifndef _WIN32
+    return ResolveDotSegments(NormalizePath(rawPath));
+#else
+
     // GetFullPathNameW resolves relative paths and .. components (no file handle needed)
     // Two-phase call: first get required length, then allocate dynamically (long path safe)
     DWORD len = GetFullPathNameW(rawPath.c_str(), 0, nullptr, nullptr);
@@ -398,6 +460,7 @@ inline std::wstring CanonicalizePath(const std::wstring& rawPath) {
     for (auto& ch : result) ch = towlower(ch);
 
     return result;
+#endif
 }
 
 /// CanonicalizePath() / ResolveProcessPath() が返す canonical 形式かを厳密チェック。
@@ -442,7 +505,6 @@ inline bool IsCanonicalPathImpl(const std::wstring& path) {
 #ifdef NDEBUG
 #define UNLEAF_ASSERT_CANONICAL(path) ((void)0)
 #else
-#include <cassert>
 #define UNLEAF_ASSERT_CANONICAL(path) \
     do { if (!unleaf::IsCanonicalPathImpl(path)) { \
         assert(false && "Non-canonical path passed to registry policy"); \
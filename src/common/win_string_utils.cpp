@@ -1,7 +1,9 @@
 #include "win_string_utils.h"
+#include <cstdint>
 
 namespace unleaf {
 
+#ifdef _WIN32
 // UTF-8 → UTF-16 変換
 //
 // 設計メモ:
@@ -46,5 +48,62 @@ std::string WideToUtf8(const wchar_t* s)
     utf8.resize(static_cast<size_t>(len - 1));
     return utf8;
 }
+#else
+// POSIX: wchar_t は UTF-32。MultiByteToWideChar と同じ契約で手書き変換する。
+//   不正シーケンス（途中切断・overlong・サロゲート・U+10FFFF 超）は "(conv_error)"。
+std::wstring Utf8ToWide(const char* s)
+{
+    if (!s) return L"(null)";
+    std::wstring w;
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(s);
+    while (*p) {
+        uint32_t cp;
+        int extra;
+        if (*p < 0x80)                { cp = *p;        extra = 0; }
+        else if ((*p & 0xE0) == 0xC0) { cp = *p & 0x1F; extra = 1; }
+        else if ((*p & 0xF0) == 0xE0) { cp = *p & 0x0F; extra = 2; }
+        else if ((*p & 0xF8) == 0xF0) { cp = *p & 0x07; extra = 3; }
+        else return L"(conv_error)";
+        ++p;
+        for (int i = 0; i < extra; ++i, ++p) {
+            if ((*p & 0xC0) != 0x80) return L"(conv_error)";   // 途中切断 / 不正継続
+            cp = (cp << 6) | (*p & 0x3F);
+        }
+        static const uint32_t kMinForLength[] = { 0, 0x80, 0x800, 0x10000 };
+        if (cp < kMinForLength[extra] || cp > 0x10FFFF ||
+            (cp >= 0xD800 && cp <= 0xDFFF)) {
+            return L"(conv_error)";
+        }
+        w.push_back(static_cast<wchar_t>(cp));
+    }
+    return w;
+}
+
+std::string WideToUtf8(const wchar_t* s)
+{
+    if (!s) return "(null)";
+    std::string utf8;
+    for (; *s; ++s) {
+        uint32_t cp = static_cast<uint32_t>(*s);
+        if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return "(conv_error)";
+        if (cp < 0x80) {
+            utf8.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            utf8.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            utf8.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            utf8.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            utf8.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            utf8.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            utf8.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            utf8.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            utf8.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            utf8.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+    return utf8;
+}
+#endif
 
 } // namespace unleaf
@@ -1,6 +1,8 @@
 #pragma once
 #include <string>
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 namespace unleaf {
     std::wstring Utf8ToWide(const char* s);
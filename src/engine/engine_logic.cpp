@@ -28,6 +28,18 @@ bool IsTargetByPath(const std::wstring& fullPathLower,
     return false;
 }
 
+std::wstring_view FileNameOf(std::wstring_view fullPath) noexcept {
+    size_t pos = fullPath.find_last_of(L"\\/");
+    return (pos != std::wstring_view::npos) ? fullPath.substr(pos + 1) : fullPath;
+}
+
+bool IsTargetByPath(std::wstring_view fullPath,
+                    const TargetMatcher& targetPaths,
+                    const TargetMatcher& targetNames) noexcept {
+    if (targetPaths.Contains(fullPath)) return true;
+    return !targetNames.empty() && targetNames.Contains(FileNameOf(fullPath));
+}
+
 bool IsCacheValid(bool cached, uint64_t now,
                   uint64_t cacheTime, uint64_t cacheDuration) {
     return cached && (now - cacheTime < cacheDuration);
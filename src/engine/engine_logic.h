@@ -3,9 +3,11 @@
 // NO Windows headers. NO Win32 APIs. NO OS-specific types.
 
 #include <string>
+#include <string_view>
 #include <set>
 #include <cstdint>
 #include "engine_policy.h"
+#include "target_matcher.h"
 
 namespace engine_logic {
 
@@ -30,6 +32,15 @@ bool IsTargetByPath(const std::wstring& fullPathLower,
                     const std::set<std::wstring>& targetPaths,
                     const std::set<std::wstring>& targetNames);
 
+// File name portion of a path (after the last \\ or /). View into fullPath, no copy.
+std::wstring_view FileNameOf(std::wstring_view fullPath) noexcept;
+
+// TargetMatcher variant of IsTargetByPath (ETW hot path: case-folding, allocation-free).
+// Same priority: 1) exact path in targetPaths, 2) file name in targetNames
+bool IsTargetByPath(std::wstring_view fullPath,
+                    const TargetMatcher& targetPaths,
+                    const TargetMatcher& targetNames) noexcept;
+
 // EcoQoS cache validity check.
 // Returns true if the cached value is still valid (cache hit).
 bool IsCacheValid(bool cached, uint64_t now,
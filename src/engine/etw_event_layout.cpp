@@ -0,0 +1,212 @@
+// etw_event_layout.cpp — Schema-compiled ETW payload decoding
+// NO Windows headers. NO Win32 APIs.
+
+#include "etw_event_layout.h"
+#include <cstring>
+
+namespace engine_logic {
+
+namespace {
+
+bool EqualsAsciiNoCase(const std::wstring& a, const wchar_t* b) {
+    size_t i = 0;
+    for (; i < a.size() && b[i] != L'\0'; ++i) {
+        wchar_t x = a[i], y = b[i];
+        if (x >= L'A' && x <= L'Z') x = static_cast<wchar_t>(x + (L'a' - L'A'));
+        if (y >= L'A' && y <= L'Z') y = static_cast<wchar_t>(y + (L'a' - L'A'));
+        if (x != y) return false;
+    }
+    return i == a.size() && b[i] == L'\0';
+}
+
+uint32_t ReadU32Le(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+} // namespace
+
+// ============================================================
+// ProcessStartLayout
+// ============================================================
+
+ProcessStartLayout ProcessStartLayout::Compile(const std::vector<EtwFieldSchema>& fields) {
+    ProcessStartLayout layout;
+    std::vector<Step> steps;
+    size_t lastTargeted = 0;
+    bool anyTarget = false;
+    bool blocked = false;   // an UNSUPPORTED field was seen: later offsets are unknown
+
+    for (const auto& f : fields) {
+        Target target = Target::NONE;
+        if (EqualsAsciiNoCase(f.name, L"ProcessID")) {
+            target = Target::PID;
+        } else if (EqualsAsciiNoCase(f.name, L"ParentProcessID")) {
+            target = Target::PARENT_PID;
+        } else if (EqualsAsciiNoCase(f.name, L"ImageName") ||
+                   EqualsAsciiNoCase(f.name, L"ImageFileName")) {
+            target = Target::IMAGE;
+        }
+
+        if (blocked || f.kind == EtwFieldKind::UNSUPPORTED) {
+            // Nothing from here on can be located. Fine only if every target precedes it.
+            if (target != Target::NONE) return layout;
+            blocked = true;
+            continue;
+        }
+        // Integer targets must be at least a DWORD (TdhGetProperty path: propSize >= sizeof(DWORD))
+        if ((target == Target::PID || target == Target::PARENT_PID) &&
+            (f.kind != EtwFieldKind::FIXED || f.size < sizeof(uint32_t))) {
+            target = Target::NONE;
+        }
+        // The encoding of a fixed-length string only matters when it is the image
+        const EtwFieldKind kind = (f.kind == EtwFieldKind::FIXED_ANSI && target != Target::IMAGE)
+                                      ? EtwFieldKind::FIXED : f.kind;
+
+        // Merge runs of untargeted fixed fields into a single skip
+        if (target == Target::NONE && kind == EtwFieldKind::FIXED && !steps.empty() &&
+            steps.back().kind == EtwFieldKind::FIXED && steps.back().target == Target::NONE &&
+            steps.back().size + f.size <= 0xFFFF) {
+            steps.back().size = static_cast<uint16_t>(steps.back().size + f.size);
+            continue;
+        }
+        steps.push_back({kind, target, f.size});
+        if (target != Target::NONE) {
+            lastTargeted = steps.size();
+            anyTarget = true;
+        }
+    }
+
+    if (!anyTarget) return layout;
+    steps.resize(lastTargeted);
+    layout.steps_ = std::move(steps);
+    layout.valid_ = true;
+    return layout;
+}
+
+bool ProcessStartLayout::Decode(const uint8_t* data, size_t length,
+                                ProcessStartFields& out) const noexcept {
+    if (!valid_) return false;
+    size_t pos = 0;
+    for (const Step& s : steps_) {
+        if (pos >= length) break;
+        const size_t remain = length - pos;
+
+        if (s.kind == EtwFieldKind::FIXED || s.kind == EtwFieldKind::FIXED_ANSI) {
+            if (s.target == Target::PID || s.target == Target::PARENT_PID) {
+                if (remain < sizeof(uint32_t)) break;
+                const uint32_t v = ReadU32Le(data + pos);
+                if (s.target == Target::PID) { out.pid = v; out.hasPid = true; }
+                else { out.parentPid = v; out.hasParentPid = true; }
+            } else if (s.target == Target::IMAGE) {
+                // Fixed-length string in its declared encoding, bounded by the declared size
+                out.image = data + pos;
+                out.imageBytes = 0;
+                const size_t bound = s.size < remain ? s.size : remain;
+                if (s.kind == EtwFieldKind::FIXED_ANSI) {
+                    while (out.imageBytes < bound && data[pos + out.imageBytes] != 0) ++out.imageBytes;
+                } else {
+                    const size_t limit = bound & ~size_t{1};
+                    while (out.imageBytes < limit &&
+                           (data[pos + out.imageBytes] | data[pos + out.imageBytes + 1]) != 0) {
+                        out.imageBytes += 2;
+                    }
+                }
+                out.imageIsAnsi = (s.kind == EtwFieldKind::FIXED_ANSI);
+                out.hasImage = true;
+            }
+            pos += s.size;
+            continue;
+        }
+
+        if (s.kind == EtwFieldKind::SID) {
+            // Revision, SubAuthorityCount, IdentifierAuthority[6], SubAuthority[count]
+            if (remain < 8) break;
+            pos += 8 + 4 * static_cast<size_t>(data[pos + 1]);
+            continue;
+        }
+
+        // NUL-terminated string: bounded by the payload (truncated events stop at the end)
+        const uint8_t* begin = data + pos;
+        size_t bytes = 0;
+        size_t consumed = 0;
+        if (s.kind == EtwFieldKind::UTF16_STRING) {
+            const size_t limit = remain & ~size_t{1};
+            while (bytes < limit && (begin[bytes] | begin[bytes + 1]) != 0) bytes += 2;
+            consumed = (bytes < limit) ? bytes + 2 : remain;
+        } else {
+            while (bytes < remain && begin[bytes] != 0) ++bytes;
+            consumed = (bytes < remain) ? bytes + 1 : remain;
+        }
+        if (s.target == Target::IMAGE) {
+            out.image = begin;
+            out.imageBytes = bytes;
+            out.imageIsAnsi = (s.kind == EtwFieldKind::ANSI_STRING);
+            out.hasImage = true;
+        }
+        pos += consumed;
+    }
+    return true;
+}
+
+// ============================================================
+// EtwLayoutCache
+// ============================================================
+
+const ProcessStartLayout* EtwLayoutCache::Find(const Key& key) const noexcept {
+    for (const auto& e : entries_) {
+        if (e.key.eventId == key.eventId && e.key.version == key.version &&
+            std::memcmp(e.key.provider, key.provider, sizeof(key.provider)) == 0) {
+            return &e.layout;
+        }
+    }
+    return nullptr;
+}
+
+const ProcessStartLayout& EtwLayoutCache::Insert(const Key& key, ProcessStartLayout layout) {
+    entries_.push_back({key, std::move(layout)});
+    return entries_.back().layout;
+}
+
+// ============================================================
+// String helpers
+// ============================================================
+
+std::wstring Utf16LeToWide(const uint8_t* data, size_t bytes) {
+    std::wstring out(bytes / 2, L'\0');
+    if (!out.empty()) out.resize(Utf16LeToWide(data, bytes, &out[0]));
+    return out;
+}
+
+size_t Utf16LeToWide(const uint8_t* data, size_t bytes, wchar_t* out) {
+    const size_t units = bytes / 2;
+    if (sizeof(wchar_t) == 2) {
+        // Windows: same encoding, payload may be unaligned
+        if (units > 0) std::memcpy(out, data, units * 2);
+        return units;
+    }
+    size_t n = 0;
+    for (size_t i = 0; i < units; ++i) {
+        uint32_t cu = static_cast<uint32_t>(data[2 * i]) | (static_cast<uint32_t>(data[2 * i + 1]) << 8);
+        if (sizeof(wchar_t) == 4 && cu >= 0xD800 && cu <= 0xDBFF && i + 1 < units) {
+            const uint32_t lo = static_cast<uint32_t>(data[2 * i + 2]) |
+                                (static_cast<uint32_t>(data[2 * i + 3]) << 8);
+            if (lo >= 0xDC00 && lo <= 0xDFFF) {
+                cu = 0x10000 + ((cu - 0xD800) << 10) + (lo - 0xDC00);
+                ++i;
+            }
+        }
+        out[n++] = static_cast<wchar_t>(cu);
+    }
+    return n;
+}
+
+void SplitImagePath(std::wstring& name, std::wstring& path) {
+    const size_t lastSlash = name.find_last_of(L"\\/");
+    if (lastSlash != std::wstring::npos) {
+        path = name;   // full path hint (may be 8.3/device format)
+        name.erase(0, lastSlash + 1);
+    }
+}
+
+} // namespace engine_logic
@@ -0,0 +1,121 @@
+#pragma once
+// etw_event_layout.h — Schema-compiled ETW payload decoding (Kernel-Process ProcessStart / ThreadStart)
+// NO Windows headers. NO Win32 APIs. NO OS-specific types.
+//
+// TDH でのスキーマ取得は (provider, event id, version) ごとに 1 回だけ行い、
+// トップレベルプロパティ列を EtwFieldSchema に変換して ProcessStartLayout へコンパイルする。
+// 以降のイベントは UserData を直接走査する:
+//   - 固定長フィールドはオフセット加算のみ
+//   - 可変長フィールド (NUL 終端文字列・SID) は対象フィールドより前にある場合のみ走査
+//   - 固定長文字列は宣言どおりの符号化 (UTF-16 / 8-bit) で、宣言サイズ内の NUL までを読む
+//   - プロパティ名比較はコンパイル時のみ (イベントごとの _wcsicmp なし)
+// 対象フィールドより前に解釈できないプロパティ (構造体・配列・長さ参照) がある
+// スキーマは IsValid() == false となり、呼び出し側は TDH の逐次パースへフォールバックする。
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace engine_logic {
+
+enum class EtwFieldKind : uint8_t {
+    FIXED,          // size bytes (integers, FILETIME, GUID, pointers, fixed-length UTF-16 strings)
+    FIXED_ANSI,     // size bytes, fixed-length 8-bit string
+    UTF16_STRING,   // NUL-terminated UTF-16LE
+    ANSI_STRING,    // NUL-terminated 8-bit
+    SID,            // SID: 8 + 4 * SubAuthorityCount bytes (Kernel-Process v3 MandatoryLabel)
+    UNSUPPORTED     // size depends on another property (struct, array, counted string, ...)
+};
+
+// One top-level property of the event schema (from TRACE_EVENT_INFO, in payload order)
+struct EtwFieldSchema {
+    std::wstring name;
+    EtwFieldKind kind;
+    uint16_t size;      // FIXED / FIXED_ANSI only
+
+    EtwFieldSchema(std::wstring n, EtwFieldKind k, uint16_t s = 0)
+        : name(std::move(n)), kind(k), size(s) {}
+};
+
+// Decoded ProcessStart fields. image points into the event payload (valid for the callback only).
+struct ProcessStartFields {
+    uint32_t pid = 0;
+    uint32_t parentPid = 0;
+    const uint8_t* image = nullptr;  // ImageName / ImageFileName payload, terminator excluded
+    size_t imageBytes = 0;
+    bool hasPid = false;
+    bool hasParentPid = false;
+    bool hasImage = false;
+    bool imageIsAnsi = false;        // false = UTF-16LE
+};
+
+class ProcessStartLayout {
+public:
+    ProcessStartLayout() = default;
+
+    // Property names match case-insensitively: ProcessID, ParentProcessID, ImageName / ImageFileName
+    static ProcessStartLayout Compile(const std::vector<EtwFieldSchema>& fields);
+
+    bool IsValid() const noexcept { return valid_; }
+
+    // Bounds-checked. Fields past the end of a truncated payload are reported absent.
+    bool Decode(const uint8_t* data, size_t length, ProcessStartFields& out) const noexcept;
+
+private:
+    enum class Target : uint8_t { NONE, PID, PARENT_PID, IMAGE };
+    struct Step {
+        EtwFieldKind kind;   // FIXED / FIXED_ANSI (targeted image only) / UTF16_STRING / ANSI_STRING / SID
+        Target target;
+        uint16_t size;       // FIXED: bytes to consume (consecutive untargeted fields merged)
+    };
+
+    std::vector<Step> steps_;   // up to and including the last targeted field
+    bool valid_ = false;
+};
+
+// (provider, event id, version) -> compiled layout. Single-threaded (ETW consumer thread).
+class EtwLayoutCache {
+public:
+    struct Key {
+        uint8_t provider[16];
+        uint16_t eventId;
+        uint8_t version;
+    };
+
+    // nullptr on miss. An invalid (fallback-only) layout is a hit as well.
+    const ProcessStartLayout* Find(const Key& key) const noexcept;
+    const ProcessStartLayout& Insert(const Key& key, ProcessStartLayout layout);
+
+    size_t size() const noexcept { return entries_.size(); }
+
+private:
+    struct Entry {
+        Key key;
+        ProcessStartLayout layout;
+    };
+    std::vector<Entry> entries_;   // a handful of versions at most: linear scan
+};
+
+// §9.39: Kernel-Process ThreadStart (event 3) begins with ProcessID, ThreadID (UInt32 each) in
+// every version. EventHeader.ThreadId is the *creating* thread; the new thread is here.
+// false when the payload is too short (the caller then has no TID).
+inline bool DecodeThreadStartIds(const uint8_t* data, size_t length,
+                                 uint32_t& ownerPid, uint32_t& threadId) noexcept {
+    if (!data || length < 8) return false;
+    ownerPid = uint32_t(data[0]) | uint32_t(data[1]) << 8 | uint32_t(data[2]) << 16 | uint32_t(data[3]) << 24;
+    threadId = uint32_t(data[4]) | uint32_t(data[5]) << 8 | uint32_t(data[6]) << 16 | uint32_t(data[7]) << 24;
+    return true;
+}
+
+// UTF-16LE payload bytes -> std::wstring (wchar_t is UTF-16 on Windows, UTF-32 elsewhere)
+std::wstring Utf16LeToWide(const uint8_t* data, size_t bytes);
+// Same conversion into caller storage of at least bytes / 2 units; returns the units written
+size_t Utf16LeToWide(const uint8_t* data, size_t bytes, wchar_t* out);
+
+// "\Device\...\dir\app.exe" -> name = "app.exe", path = full string.
+// Without a separator, name is kept and path stays empty (filename-only event).
+void SplitImagePath(std::wstring& name, std::wstring& path);
+
+} // namespace engine_logic
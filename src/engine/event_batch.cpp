@@ -0,0 +1,50 @@
+// event_batch.cpp — ProcessStartBatch (§9.29)
+// NO Windows headers. NO Win32 APIs. NO OS-specific types.
+
+#include "event_batch.h"
+#include "etw_event_layout.h"   // Utf16LeToWide
+#include <algorithm>
+
+namespace engine_logic {
+
+ProcessStartRecord& ProcessStartBatch::Next(uint32_t pid, uint32_t parentPid) {
+    ProcessStartRecord& r = records_[size_++];
+    r.pid = pid;
+    r.parentPid = parentPid;
+    r.textLength = 0;
+    r.nameOffset = 0;
+    r.spill = ProcessStartRecord::NO_SPILL;
+    return r;
+}
+
+void ProcessStartBatch::SetNameOffset(ProcessStartRecord& r, std::wstring_view image) {
+    const size_t lastSlash = image.find_last_of(L"\\/");
+    r.nameOffset = (lastSlash == std::wstring_view::npos) ? 0 : static_cast<uint16_t>(lastSlash + 1);
+}
+
+void ProcessStartBatch::Append(uint32_t pid, uint32_t parentPid, std::wstring_view image) {
+    // UNICODE_STRING caps ETW image names at 32767 units: offsets always fit in 16 bits
+    image = image.substr(0, 0x7FFF);
+    ProcessStartRecord& r = Next(pid, parentPid);
+    if (image.size() <= ProcessStartRecord::TEXT_CAPACITY) {
+        std::copy(image.begin(), image.end(), r.text);
+        r.textLength = static_cast<uint16_t>(image.size());
+    } else {
+        r.spill = static_cast<uint16_t>(spill_.size());
+        spill_.emplace_back(image);
+    }
+    SetNameOffset(r, image);
+}
+
+void ProcessStartBatch::AppendUtf16Le(uint32_t pid, uint32_t parentPid,
+                                      const uint8_t* data, size_t bytes) {
+    if (bytes / 2 > ProcessStartRecord::TEXT_CAPACITY) {
+        Append(pid, parentPid, Utf16LeToWide(data, bytes));
+        return;
+    }
+    ProcessStartRecord& r = Next(pid, parentPid);
+    r.textLength = static_cast<uint16_t>(Utf16LeToWide(data, bytes, r.text));
+    SetNameOffset(r, std::wstring_view(r.text, r.textLength));
+}
+
+} // namespace engine_logic
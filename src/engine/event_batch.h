@@ -0,0 +1,77 @@
+#pragma once
+// event_batch.h — Fixed-size POD process-start records, delivered in batches (§9.29)
+// NO Windows headers. NO Win32 APIs. NO OS-specific types.
+//
+// ETW コンシューマスレッドは ProcessStart を std::wstring を作らずに
+// ProcessStartRecord (イメージ文字列をインライン保持する固定長 POD) へデコードし、
+// ProcessStartBatch に溜める。ETW バッファ 1 つ分 (BufferCallback) または CAPACITY 件で
+// 1 回だけコールバックへ渡す。エンジン側の分類・ロック・シグナルはバッチ単位になる。
+//   - レコード配列は構築時に 1 回だけ確保 (以降 Append / Clear は割り当てなし)
+//   - TEXT_CAPACITY を超えるイメージ文字列のみ spill (std::wstring) に退避する
+//   - 名前 / パスの分割は SplitImagePath と同一 (name = 最後の区切り以降、区切りなし = パスなし)
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace engine_logic {
+
+struct ProcessStartRecord {
+    static constexpr uint16_t TEXT_CAPACITY = 260;   // MAX_PATH
+    static constexpr uint16_t NO_SPILL = 0xFFFF;
+
+    uint32_t pid;
+    uint32_t parentPid;
+    uint16_t textLength;     // inline units (0 when spilled)
+    uint16_t nameOffset;     // name = image[nameOffset..]; 0 = no separator (no path)
+    uint16_t spill;          // ProcessStartBatch spill index, or NO_SPILL
+    wchar_t text[TEXT_CAPACITY];
+};
+static_assert(std::is_trivially_copyable<ProcessStartRecord>::value,
+              "ProcessStartRecord must stay POD");
+
+class ProcessStartBatch {
+public:
+    static constexpr size_t CAPACITY = 128;
+
+    ProcessStartBatch() : records_(CAPACITY) {}
+
+    // Precondition: !Full() (the producer delivers and clears a full batch first).
+    // image: full ETW image string (device path, or a bare file name)
+    void Append(uint32_t pid, uint32_t parentPid, std::wstring_view image);
+    // Same, decoding the UTF-16LE payload straight into the record
+    void AppendUtf16Le(uint32_t pid, uint32_t parentPid, const uint8_t* data, size_t bytes);
+
+    size_t Size() const noexcept { return size_; }
+    bool Empty() const noexcept { return size_ == 0; }
+    bool Full() const noexcept { return size_ == CAPACITY; }
+    void Clear() noexcept {
+        size_ = 0;
+        spill_.clear();
+    }
+
+    const ProcessStartRecord& operator[](size_t i) const noexcept { return records_[i]; }
+    // Views stay valid until the next Clear()
+    std::wstring_view Image(size_t i) const noexcept {
+        const ProcessStartRecord& r = records_[i];
+        if (r.spill != ProcessStartRecord::NO_SPILL) return spill_[r.spill];
+        return std::wstring_view(r.text, r.textLength);
+    }
+    std::wstring_view ImageName(size_t i) const noexcept { return Image(i).substr(records_[i].nameOffset); }
+    std::wstring_view ImagePath(size_t i) const noexcept {
+        return records_[i].nameOffset ? Image(i) : std::wstring_view();
+    }
+
+private:
+    ProcessStartRecord& Next(uint32_t pid, uint32_t parentPid);
+    static void SetNameOffset(ProcessStartRecord& r, std::wstring_view image);
+
+    std::vector<ProcessStartRecord> records_;
+    size_t size_ = 0;
+    std::vector<std::wstring> spill_;
+};
+
+} // namespace engine_logic
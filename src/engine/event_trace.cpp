@@ -0,0 +1,261 @@
+// event_trace.cpp — Compact binary capture of decoded process/thread start events (§9.27)
+// NO Windows headers. NO Win32 APIs.
+
+#include "event_trace.h"
+#include "etw_event_layout.h"   // Utf16LeToWide
+#include <cstring>
+#include <iterator>
+
+namespace engine_logic {
+
+namespace {
+
+constexpr char TRACE_MAGIC[4] = {'U', 'L', 'T', 'R'};
+constexpr uint16_t TRACE_VERSION = 1;
+constexpr size_t TRACE_HEADER_SIZE = 8;
+
+constexpr uint8_t TAG_TYPE_MASK = 0x0F;
+constexpr uint8_t TAG_NAME_FROM_PATH = 0x10;
+
+void PutVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+uint64_t ZigZag(int64_t v) {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+int64_t UnZigZag(uint64_t v) {
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+// wchar_t (UTF-16 on Windows, UTF-32 elsewhere) -> UTF-16LE code units
+void PutString(std::vector<uint8_t>& out, std::wstring_view s) {
+    size_t units = s.size();
+    if (sizeof(wchar_t) == 4) {
+        for (wchar_t c : s) {
+            if (static_cast<uint32_t>(c) > 0xFFFF) ++units;
+        }
+    }
+    PutVarint(out, units);
+    size_t pos = out.size();
+    out.resize(pos + units * 2);
+    uint8_t* dst = out.data();
+    auto putUnit = [dst, &pos](uint32_t cu) {
+        dst[pos++] = static_cast<uint8_t>(cu);
+        dst[pos++] = static_cast<uint8_t>(cu >> 8);
+    };
+    for (wchar_t c : s) {
+        const uint32_t cp = static_cast<uint32_t>(c);
+        if (sizeof(wchar_t) == 4 && cp > 0xFFFF) {
+            putUnit(0xD800 + ((cp - 0x10000) >> 10));
+            putUnit(0xDC00 + ((cp - 0x10000) & 0x3FF));
+        } else {
+            putUnit(cp);
+        }
+    }
+}
+
+// Trailing file-name component of a path (both separators; matches SplitImagePath)
+bool IsTailOf(std::wstring_view name, std::wstring_view path) {
+    if (name.empty() || path.size() <= name.size()) return false;
+    const size_t lastSlash = path.find_last_of(L"\\/");
+    if (lastSlash == std::wstring_view::npos) return false;
+    return path.compare(lastSlash + 1, std::wstring::npos, name) == 0;
+}
+
+} // namespace
+
+// ============================================================
+// EventTraceWriter
+// ============================================================
+
+bool EventTraceWriter::Open(const std::filesystem::path& path) {
+    Close();
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_) return false;
+
+    buffer_.clear();
+    buffer_.reserve(FLUSH_THRESHOLD + 1024);
+    buffer_.insert(buffer_.end(), std::begin(TRACE_MAGIC), std::end(TRACE_MAGIC));
+    buffer_.push_back(static_cast<uint8_t>(TRACE_VERSION));
+    buffer_.push_back(static_cast<uint8_t>(TRACE_VERSION >> 8));
+    buffer_.push_back(0);
+    buffer_.push_back(0);
+    lastTimestampUs_ = 0;
+    records_ = 0;
+    bytes_ = 0;
+    failed_ = false;
+    open_ = true;
+    return true;
+}
+
+void EventTraceWriter::Close() {
+    if (!open_) return;
+    Flush();
+    file_.close();
+    open_ = false;
+}
+
+void EventTraceWriter::Flush() {
+    if (!open_ || buffer_.empty()) return;
+    if (!failed_) {
+        file_.write(reinterpret_cast<const char*>(buffer_.data()),
+                    static_cast<std::streamsize>(buffer_.size()));
+        file_.flush();
+        if (file_) {
+            bytes_ += buffer_.size();
+        } else {
+            failed_ = true;
+        }
+    }
+    buffer_.clear();
+}
+
+void EventTraceWriter::BeginRecord(TraceEventType type, uint8_t flags,
+                                   uint64_t timestampUs, uint32_t pid) {
+    buffer_.push_back(static_cast<uint8_t>(static_cast<uint8_t>(type) | flags));
+    PutVarint(buffer_, ZigZag(static_cast<int64_t>(timestampUs - lastTimestampUs_)));
+    lastTimestampUs_ = timestampUs;
+    PutVarint(buffer_, pid);
+}
+
+void EventTraceWriter::EndRecord() {
+    ++records_;
+    if (buffer_.size() >= FLUSH_THRESHOLD) Flush();
+}
+
+void EventTraceWriter::AppendProcessStart(uint64_t timestampUs, uint32_t pid, uint32_t parentPid,
+                                          std::wstring_view imageName,
+                                          std::wstring_view imagePath) {
+    if (!open_ || failed_) return;
+    // ETW ProcessStart: imageName is always the tail of imagePath when a path is present
+    const bool nameFromPath = IsTailOf(imageName, imagePath);
+    BeginRecord(TraceEventType::PROCESS_START, nameFromPath ? TAG_NAME_FROM_PATH : 0,
+                timestampUs, pid);
+    PutVarint(buffer_, parentPid);
+    PutString(buffer_, imagePath);
+    if (!nameFromPath) PutString(buffer_, imageName);
+    EndRecord();
+}
+
+void EventTraceWriter::AppendThreadStart(uint64_t timestampUs, uint32_t pid, uint32_t tid) {
+    if (!open_ || failed_) return;
+    BeginRecord(TraceEventType::THREAD_START, 0, timestampUs, pid);
+    PutVarint(buffer_, tid);
+    EndRecord();
+}
+
+// ============================================================
+// EventTraceReader
+// ============================================================
+
+bool EventTraceReader::Open(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        data_.clear();
+        status_ = Status::BAD_FORMAT;
+        return false;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)),
+                               std::istreambuf_iterator<char>());
+    return Attach(std::move(bytes));
+}
+
+bool EventTraceReader::Attach(std::vector<uint8_t> bytes) {
+    data_ = std::move(bytes);
+    Rewind();
+    return status_ == Status::OK;
+}
+
+void EventTraceReader::Rewind() {
+    pos_ = TRACE_HEADER_SIZE;
+    lastTimestampUs_ = 0;
+    const bool valid = data_.size() >= TRACE_HEADER_SIZE &&
+                       std::memcmp(data_.data(), TRACE_MAGIC, sizeof(TRACE_MAGIC)) == 0 &&
+                       (data_[4] | (data_[5] << 8)) == TRACE_VERSION;
+    status_ = valid ? Status::OK : Status::BAD_FORMAT;
+}
+
+bool EventTraceReader::Next(TraceEvent& out) {
+    if (status_ != Status::OK) return false;
+    if (pos_ == data_.size()) {
+        status_ = Status::END;
+        return false;
+    }
+
+    // Parse on a cursor; pos_ only advances past complete records.
+    // Running out of bytes = TRUNCATED, anything else = BAD_FORMAT (malformed).
+    size_t p = pos_;
+    bool malformed = false;
+    auto getVarint = [&](uint64_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p >= data_.size()) return false;
+            const uint8_t b = data_[p++];
+            v |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0) return true;
+        }
+        malformed = true;
+        return false;
+    };
+    auto getU32 = [&](uint32_t& v) {
+        uint64_t wide = 0;
+        if (!getVarint(wide)) return false;
+        if (wide > 0xFFFFFFFFull) { malformed = true; return false; }
+        v = static_cast<uint32_t>(wide);
+        return true;
+    };
+    auto getString = [&](std::wstring& s) {
+        uint64_t units = 0;
+        if (!getVarint(units)) return false;
+        if (units > (data_.size() - p) / 2) return false;
+        s = Utf16LeToWide(data_.data() + p, static_cast<size_t>(units) * 2);
+        p += static_cast<size_t>(units) * 2;
+        return true;
+    };
+
+    const uint8_t tag = data_[p++];
+    const auto type = static_cast<TraceEventType>(tag & TAG_TYPE_MASK);
+    uint64_t delta = 0;
+    TraceEvent ev;
+    ev.type = type;
+    bool ok = getVarint(delta) && getU32(ev.pid);
+    if (ok) {
+        switch (type) {
+            case TraceEventType::PROCESS_START:
+                ok = getU32(ev.parentPid) && getString(ev.imagePath);
+                if (ok) {
+                    if (tag & TAG_NAME_FROM_PATH) {
+                        ev.imageName = ev.imagePath.substr(ev.imagePath.find_last_of(L"\\/") + 1);
+                    } else {
+                        ok = getString(ev.imageName);
+                    }
+                }
+                break;
+            case TraceEventType::THREAD_START:
+                ok = getU32(ev.tid);
+                break;
+            default:
+                malformed = true;
+                ok = false;
+                break;
+        }
+    }
+    if (!ok) {
+        status_ = malformed ? Status::BAD_FORMAT : Status::TRUNCATED;
+        return false;
+    }
+
+    lastTimestampUs_ += static_cast<uint64_t>(UnZigZag(delta));
+    ev.timestampUs = lastTimestampUs_;
+    pos_ = p;
+    out = std::move(ev);
+    return true;
+}
+
+} // namespace engine_logic
@@ -0,0 +1,106 @@
+#pragma once
+// event_trace.h — Compact binary capture of decoded process/thread start events (§9.27)
+// NO Windows headers. NO Win32 APIs. NO OS-specific types.
+//
+// 本番ビルドエージェントのイベントストームを記録し、Linux 上で EngineCore に
+// 再投入 (UnLeaf_Replay) してキュー飽和・ドロップを決定的に再現するためのフォーマット。
+//
+// File layout (little-endian):
+//   header : "ULTR" | u16 version | u16 reserved
+//   record : u8 tag | varint zigzag(Δtimestamp µs) | varint pid | body
+//     tag & 0x0F = TraceEventType, tag & NAME_FROM_PATH = imageName は imagePath の末尾
+//     PROCESS_START body: varint parentPid | str imagePath | [str imageName]
+//     THREAD_START  body: varint tid
+//   str    : varint UTF-16 code unit count | UTF-16LE code units
+// タイムスタンプは直前レコードとの差分 (先頭レコードは絶対値)。ETW はリアルタイム
+// セッションでも CPU 間でわずかに前後し得るため符号付き差分で保持する。
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine_logic {
+
+enum class TraceEventType : uint8_t {
+    PROCESS_START = 1,
+    THREAD_START = 2
+};
+
+struct TraceEvent {
+    TraceEventType type = TraceEventType::PROCESS_START;
+    uint64_t timestampUs = 0;   // source clock (ETW: FILETIME / 10, FakePlatform: virtual ms * 1000)
+    uint32_t pid = 0;           // PROCESS_START: new process, THREAD_START: owner process
+    uint32_t parentPid = 0;     // PROCESS_START only
+    uint32_t tid = 0;           // THREAD_START only
+    std::wstring imageName;     // PROCESS_START only
+    std::wstring imagePath;     // PROCESS_START only (may be empty)
+};
+
+// Single writer (ETW consumer thread). Records are buffered and written in blocks.
+class EventTraceWriter {
+public:
+    static constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+
+    EventTraceWriter() = default;
+    ~EventTraceWriter() { Close(); }
+    EventTraceWriter(const EventTraceWriter&) = delete;
+    EventTraceWriter& operator=(const EventTraceWriter&) = delete;
+
+    // Truncates an existing file. false = cannot open (recording stays off).
+    bool Open(const std::filesystem::path& path);
+    void Close();
+    bool IsOpen() const noexcept { return open_; }
+
+    void AppendProcessStart(uint64_t timestampUs, uint32_t pid, uint32_t parentPid,
+                            std::wstring_view imageName, std::wstring_view imagePath);
+    void AppendThreadStart(uint64_t timestampUs, uint32_t pid, uint32_t tid);
+    void Flush();
+
+    uint64_t RecordCount() const noexcept { return records_; }
+    uint64_t BytesWritten() const noexcept { return bytes_; }
+    bool HasFailed() const noexcept { return failed_; }   // write error: later records discarded
+
+private:
+    void BeginRecord(TraceEventType type, uint8_t flags, uint64_t timestampUs, uint32_t pid);
+    void EndRecord();
+
+    std::ofstream file_;
+    std::vector<uint8_t> buffer_;
+    uint64_t lastTimestampUs_ = 0;
+    uint64_t records_ = 0;
+    uint64_t bytes_ = 0;
+    bool open_ = false;
+    bool failed_ = false;
+};
+
+// Whole-file reader (replay is offline; a 10M-event storm is ~100 MB)
+class EventTraceReader {
+public:
+    enum class Status : uint8_t {
+        OK,           // Next() may return more records
+        END,          // clean end of trace
+        TRUNCATED,    // partial last record (capture interrupted): earlier records are valid
+        BAD_FORMAT    // missing / wrong header, unknown record type
+    };
+
+    bool Open(const std::filesystem::path& path);
+    // In-memory trace (tests, benchmarks)
+    bool Attach(std::vector<uint8_t> bytes);
+
+    // false at END / TRUNCATED / BAD_FORMAT (see GetStatus)
+    bool Next(TraceEvent& out);
+    Status GetStatus() const noexcept { return status_; }
+    void Rewind();
+
+private:
+    std::vector<uint8_t> data_;
+    size_t pos_ = 0;
+    uint64_t lastTimestampUs_ = 0;
+    Status status_ = Status::BAD_FORMAT;
+};
+
+} // namespace engine_logic
@@ -0,0 +1,85 @@
+#pragma once
+// mpsc_ring.h — Bounded lock-free multi-producer / single-consumer ring
+// NO Windows headers. NO Win32 APIs. NO OS-specific types.
+//
+// Vyukov 型のシーケンス付きスロット配列。容量は構築時に 2 のべき乗へ切り上げ、
+// 以降の Push / Pop は割り当てゼロ・ロックなし。
+//   - Push: 任意スレッド (ETW コンシューマ、スレッドプールタイマー)
+//   - Pop : 単一スレッド (EngineControlLoop) のみ
+// T は trivially copyable (POD スロット) に限る。
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace engine_logic {
+
+template <typename T>
+class MpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "MpscRing slots must be POD");
+
+public:
+    explicit MpscRing(size_t minCapacity) {
+        size_t cap = 2;
+        while (cap < minCapacity) cap <<= 1;
+        mask_ = static_cast<uint32_t>(cap - 1);
+        slots_.reset(new Slot[cap]);
+        for (uint32_t i = 0; i <= mask_; ++i) {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    // Multi-producer. false = ring full (value not stored).
+    bool TryPush(const T& value) noexcept {
+        uint32_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots_[pos & mask_];
+            const uint32_t seq = slot->seq.load(std::memory_order_acquire);
+            const int32_t diff = static_cast<int32_t>(seq - pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->value = value;
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Single consumer. false = empty, or the next slot is claimed but not yet published.
+    bool TryPop(T& out) noexcept {
+        Slot& slot = slots_[dequeuePos_ & mask_];
+        const uint32_t seq = slot.seq.load(std::memory_order_acquire);
+        if (static_cast<int32_t>(seq - (dequeuePos_ + 1)) < 0) return false;
+        out = slot.value;
+        slot.seq.store(dequeuePos_ + mask_ + 1, std::memory_order_release);
+        ++dequeuePos_;
+        return true;
+    }
+
+    size_t capacity() const noexcept { return static_cast<size_t>(mask_) + 1; }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> seq{0};
+        T value{};
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    uint32_t mask_ = 0;
+    alignas(64) std::atomic<uint32_t> enqueuePos_{0};
+    alignas(64) uint32_t dequeuePos_ = 0;   // consumer-owned
+};
+
+} // namespace engine_logic
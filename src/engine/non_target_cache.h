@@ -0,0 +1,67 @@
+#pragma once
+// non_target_cache.h — Negative classification cache for the SafetyNet missed-target scan (§9.40)
+// NO Windows headers. NO Win32 APIs. NO OS-specific types.
+//
+// PID -> {作成時刻, イメージ名ハッシュ}。「現在の設定世代ではターゲットでない」と判定済みの
+// プロセスを覚え、SafetyNet の走査 (§9.14-E) で同じ PID を毎回判定し直さない。
+//   - 作成時刻が違う = PID 再利用、名前ハッシュが違う = exec (Linux は PID と開始時刻を保つ) → ミス
+//   - 世代 (TargetTables::generation) が変わったら SetGeneration() が全エントリを捨てる
+//   - 終了したプロセスは Prune() で落とす (Windows は未追跡プロセスの終了を通知しない)
+// 判定は名前と設定だけで決まるものに限る (クリティカル / 名前・パスファイル名に非該当)。
+// パス照合や ApplyOptimization の失敗 (アクセス拒否など一時的なもの) は入れない。
+// スレッド安全性なし: 制御スレッド専用。
+
+#include "pid_table.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine_logic {
+
+class NonTargetCache {
+public:
+    // Drops every entry when the configuration generation changes
+    void SetGeneration(uint32_t generation) {
+        if (generation == generation_) return;
+        generation_ = generation;
+        table_.clear();
+    }
+    uint32_t Generation() const noexcept { return generation_; }
+
+    bool Contains(uint32_t pid, uint64_t createTime, uint64_t nameHash) const {
+        auto it = table_.find(pid);
+        return it != table_.end() && it.hot().createTime == createTime && it.hot().nameHash == nameHash;
+    }
+    // Replaces any entry of a previous process with the same PID
+    void Insert(uint32_t pid, uint64_t createTime, uint64_t nameHash) {
+        table_.insert_or_assign(pid, Entry{createTime, nameHash}, Unused{});
+    }
+    bool Erase(uint32_t pid) { return table_.erase(pid) != 0; }
+    void Clear() { table_.clear(); }
+    size_t Size() const noexcept { return table_.size(); }
+
+    // Removes PIDs for which alive(pid) is false. Returns the number removed.
+    template <typename Alive>
+    size_t Prune(Alive&& alive) {
+        scratch_.clear();
+        for (const auto& [pid, entry, unused] : table_) {
+            if (!alive(pid)) scratch_.push_back(pid);
+        }
+        for (uint32_t pid : scratch_) table_.erase(pid);
+        return scratch_.size();
+    }
+
+private:
+    struct Entry {
+        uint64_t createTime = 0;
+        uint64_t nameHash = 0;
+    };
+    struct Unused {};
+
+    PidTable<Entry, Unused> table_;
+    std::vector<uint32_t> scratch_;   // Prune
+    uint32_t generation_ = 0;
+};
+
+} // namespace engine_logic
@@ -0,0 +1,103 @@
+#pragma once
+// pid_bitmap.h — PID-space atomic bitmap + per-second event counter
+// NO Windows headers. NO Win32 APIs. NO OS-specific types.
+//
+// PidBitmap: PID 空間 (4M = 2^22、Windows の PID 上限相当) を 1 PID 1 ビットで表す。
+// ETW コンシューマスレッドがスレッド開始イベントごとに Test し、対象外 PID を
+// std::function 呼び出し前に捨てる (§9.28)。ビット配列は 512 KB をヒープに確保。
+//   - Test      : 任意スレッド。relaxed load 1 回、分岐 1 回
+//   - Set/Clear : 任意スレッド。ワード単位の atomic RMW (fetch_or / fetch_and) なので、同じワードの
+//                 別ビットを複数スレッドが同時に更新しても失われない (pendingStartFilter_ は
+//                 モニタスレッドが Set、制御スレッドが Clear)。同じ PID の Set と Clear の順序は呼び出し側が決める
+//   - Reset     : 他の Set/Clear と並行しないこと (通常の store)
+// 範囲外の PID は Test が true を返す (判定はエンジン側スナップショットに委ねる)。
+//
+// PerSecondCounter: 単一ライター / 任意リーダーの 1 秒バケットカウンタ。
+// 直前に完了した 1 秒のイベント数を返す。バケットは (秒, 件数) を 64bit に詰めて
+// 1 回の store で公開するため、リーダーが秒と件数の組み合わせを取り違えることはない。
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace engine_logic {
+
+class PidBitmap {
+public:
+    static constexpr uint32_t PID_SPACE = 1u << 22;
+    static constexpr uint32_t WORD_COUNT = PID_SPACE / 64;
+
+    PidBitmap() : words_(new std::atomic<uint64_t>[WORD_COUNT]) { Reset(); }
+
+    PidBitmap(const PidBitmap&) = delete;
+    PidBitmap& operator=(const PidBitmap&) = delete;
+
+    bool Test(uint32_t pid) const noexcept {
+        if (pid >= PID_SPACE) return true;
+        return (words_[pid >> 6].load(std::memory_order_relaxed) >> (pid & 63)) & 1u;
+    }
+
+    void Set(uint32_t pid) noexcept {
+        if (pid < PID_SPACE) words_[pid >> 6].fetch_or(Bit(pid), std::memory_order_relaxed);
+    }
+
+    void Clear(uint32_t pid) noexcept {
+        if (pid < PID_SPACE) words_[pid >> 6].fetch_and(~Bit(pid), std::memory_order_relaxed);
+    }
+
+    void Reset() noexcept {
+        for (uint32_t w = 0; w < WORD_COUNT; ++w) words_[w].store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static uint64_t Bit(uint32_t pid) noexcept { return uint64_t{1} << (pid & 63); }
+
+    std::unique_ptr<std::atomic<uint64_t>[]> words_;
+};
+
+class PerSecondCounter {
+public:
+    // Writer thread only. nowMs: any monotonic millisecond clock (GetTickCount64 / virtual)
+    void Add(uint64_t nowMs, uint32_t n = 1) noexcept {
+        const uint32_t sec = static_cast<uint32_t>(nowMs / 1000);
+        uint64_t cur = current_.load(std::memory_order_relaxed);
+        if (Sec(cur) != sec) {
+            previous_.store(cur, std::memory_order_relaxed);
+            cur = Pack(sec, 0);
+        }
+        current_.store(Pack(sec, Count(cur) + n), std::memory_order_relaxed);
+        total_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    // Any thread: events counted during the second before nowMs's second (0 if idle)
+    uint32_t LastSecond(uint64_t nowMs) const noexcept {
+        const uint32_t sec = static_cast<uint32_t>(nowMs / 1000);
+        const uint64_t cur = current_.load(std::memory_order_relaxed);
+        if (Sec(cur) + 1 == sec) return Count(cur);
+        if (Sec(cur) == sec) {
+            const uint64_t prev = previous_.load(std::memory_order_relaxed);
+            if (Sec(prev) + 1 == sec) return Count(prev);
+        }
+        return 0;
+    }
+
+    uint64_t Total() const noexcept { return total_.load(std::memory_order_relaxed); }
+
+    // Writer side, while no Add() can run concurrently
+    void Reset() noexcept {
+        current_.store(0, std::memory_order_relaxed);
+        previous_.store(0, std::memory_order_relaxed);
+        total_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static uint64_t Pack(uint32_t sec, uint32_t count) noexcept { return (uint64_t{sec} << 32) | count; }
+    static uint32_t Sec(uint64_t v) noexcept { return static_cast<uint32_t>(v >> 32); }
+    static uint32_t Count(uint64_t v) noexcept { return static_cast<uint32_t>(v); }
+
+    std::atomic<uint64_t> current_{0};
+    std::atomic<uint64_t> previous_{0};
+    std::atomic<uint64_t> total_{0};
+};
+
+} // namespace engine_logic
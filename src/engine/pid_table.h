@@ -0,0 +1,204 @@
+#pragma once
+// pid_table.h — Flat open-addressing PID table with struct-of-arrays storage
+// NO Windows headers. NO Win32 APIs. NO OS-specific types.
+//
+// キー (PID)・ホットデータ・コールドデータを別配列に保持する。
+//   keys_ : uint32_t の連続配列。探索はこの配列だけを走査する (1 キャッシュライン = 16 PID)
+//   hot_  : 走査・判定で毎回読むフィールド (フェーズ、タイムスタンプ、キャッシュビット)
+//   cold_ : 名前・パス・ハンドル等 (std::shared_ptr 越し、ルックアップ経路では触らない)
+// 線形探査 + backward-shift 削除 (tombstone なし)。負荷率 50% で 2 倍に拡張。
+// スレッド安全性なし: 呼び出し側のロック (trackedCs_) で保護すること。
+// insert / erase / reserve は全イテレータと参照を無効化する。
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace engine_logic {
+
+template <typename Hot, typename Cold>
+class PidTable {
+public:
+    using Key = uint32_t;
+    // Windows PIDs are multiples of 4 and Linux PIDs are < 2^22: all-ones is never a PID
+    static constexpr Key EMPTY_KEY = 0xFFFFFFFFu;
+
+    // Range-for element: for (const auto& [pid, hot, cold] : table)
+    template <bool IsConst>
+    struct EntryRef {
+        Key pid;
+        std::conditional_t<IsConst, const Hot&, Hot&> hot;
+        std::conditional_t<IsConst, const Cold&, Cold&> cold;
+    };
+
+    template <bool IsConst>
+    class Iter {
+        using Table = std::conditional_t<IsConst, const PidTable, PidTable>;
+    public:
+        Iter() = default;
+        Iter(Table* t, uint32_t slot) : t_(t), slot_(slot) { SkipEmpty(); }
+
+        Key key() const { return t_->keys_[slot_]; }
+        auto& hot() const { return t_->hot_[slot_]; }
+        auto& cold() const { return t_->cold_[slot_]; }
+        EntryRef<IsConst> operator*() const { return {key(), hot(), cold()}; }
+
+        Iter& operator++() { ++slot_; SkipEmpty(); return *this; }
+        bool operator==(const Iter& o) const { return slot_ == o.slot_; }
+        bool operator!=(const Iter& o) const { return slot_ != o.slot_; }
+
+    private:
+        friend class PidTable;
+        void SkipEmpty() {
+            const uint32_t cap = static_cast<uint32_t>(t_->keys_.size());
+            while (slot_ < cap && t_->keys_[slot_] == EMPTY_KEY) ++slot_;
+        }
+        Table* t_ = nullptr;
+        uint32_t slot_ = 0;
+    };
+
+    using iterator = Iter<false>;
+    using const_iterator = Iter<true>;
+
+    explicit PidTable(size_t minCapacity = 16) { Rehash(CapacityFor(minCapacity)); }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, Capacity()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, Capacity()); }
+
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    uint32_t Capacity() const noexcept { return mask_ + 1; }
+
+    iterator find(Key key) {
+        const uint32_t slot = FindSlot(key);
+        return slot == NOT_FOUND ? end() : iterator(this, slot);
+    }
+    const_iterator find(Key key) const {
+        const uint32_t slot = FindSlot(key);
+        return slot == NOT_FOUND ? end() : const_iterator(this, slot);
+    }
+    bool contains(Key key) const { return FindSlot(key) != NOT_FOUND; }
+    size_t count(Key key) const { return contains(key) ? 1 : 0; }
+
+    // Inserts or overwrites both hot and cold data for key
+    iterator insert_or_assign(Key key, Hot hot, Cold cold) {
+        assert(key != EMPTY_KEY);
+        if ((size_ + 1) * 2 > Capacity()) Rehash(Capacity() * 2);
+        uint32_t slot = Home(key);
+        while (keys_[slot] != EMPTY_KEY && keys_[slot] != key) slot = (slot + 1) & mask_;
+        if (keys_[slot] == EMPTY_KEY) {
+            keys_[slot] = key;
+            ++size_;
+        }
+        hot_[slot] = std::move(hot);
+        cold_[slot] = std::move(cold);
+        return iterator(this, slot);
+    }
+
+    // Backward-shift deletion: later members of the probe chain move up, no tombstones
+    void erase(iterator it) {
+        uint32_t hole = it.slot_;
+        assert(hole < Capacity() && keys_[hole] != EMPTY_KEY);
+        uint32_t next = (hole + 1) & mask_;
+        while (keys_[next] != EMPTY_KEY) {
+            const uint32_t home = Home(keys_[next]);
+            // Move next into hole unless its home lies cyclically in (hole, next]
+            if (((next - home) & mask_) >= ((next - hole) & mask_)) {
+                keys_[hole] = keys_[next];
+                hot_[hole] = std::move(hot_[next]);
+                cold_[hole] = std::move(cold_[next]);
+                hole = next;
+            }
+            next = (next + 1) & mask_;
+        }
+        keys_[hole] = EMPTY_KEY;
+        hot_[hole] = Hot{};
+        cold_[hole] = Cold{};
+        --size_;
+    }
+    size_t erase(Key key) {
+        auto it = find(key);
+        if (it == end()) return 0;
+        erase(it);
+        return 1;
+    }
+
+    void clear() {
+        keys_.assign(keys_.size(), EMPTY_KEY);
+        hot_.assign(hot_.size(), Hot{});
+        cold_.assign(cold_.size(), Cold{});
+        size_ = 0;
+    }
+
+    void reserve(size_t count) {
+        const uint32_t cap = CapacityFor(count);
+        if (cap > Capacity()) Rehash(cap);
+    }
+
+    // Longest displacement from home slot (diagnostics / benchmarks)
+    uint32_t MaxProbeLength() const {
+        uint32_t maxProbe = 0;
+        for (uint32_t s = 0; s < Capacity(); ++s) {
+            if (keys_[s] == EMPTY_KEY) continue;
+            const uint32_t probe = (s - Home(keys_[s])) & mask_;
+            if (probe > maxProbe) maxProbe = probe;
+        }
+        return maxProbe;
+    }
+
+private:
+    static constexpr uint32_t NOT_FOUND = 0xFFFFFFFFu;
+
+    static uint32_t CapacityFor(size_t count) {
+        uint32_t cap = 16;
+        while (cap < count * 2) cap <<= 1;
+        return cap;
+    }
+
+    // Fibonacci hashing: spreads the multiple-of-4 Windows PID sequence across the table
+    uint32_t Home(Key key) const noexcept {
+        return static_cast<uint32_t>((uint64_t{key} * 0x9E3779B97F4A7C15ull) >> 32) & mask_;
+    }
+
+    uint32_t FindSlot(Key key) const noexcept {
+        if (key == EMPTY_KEY) return NOT_FOUND;
+        uint32_t slot = Home(key);
+        for (;;) {
+            const Key k = keys_[slot];
+            if (k == key) return slot;
+            if (k == EMPTY_KEY) return NOT_FOUND;
+            slot = (slot + 1) & mask_;
+        }
+    }
+
+    void Rehash(uint32_t newCapacity) {
+        std::vector<Key> oldKeys(newCapacity, EMPTY_KEY);
+        std::vector<Hot> oldHot(newCapacity);
+        std::vector<Cold> oldCold(newCapacity);
+        oldKeys.swap(keys_);
+        oldHot.swap(hot_);
+        oldCold.swap(cold_);
+        mask_ = newCapacity - 1;
+        for (size_t s = 0; s < oldKeys.size(); ++s) {
+            if (oldKeys[s] == EMPTY_KEY) continue;
+            uint32_t slot = Home(oldKeys[s]);
+            while (keys_[slot] != EMPTY_KEY) slot = (slot + 1) & mask_;
+            keys_[slot] = oldKeys[s];
+            hot_[slot] = std::move(oldHot[s]);
+            cold_[slot] = std::move(oldCold[s]);
+        }
+    }
+
+    std::vector<Key> keys_;
+    std::vector<Hot> hot_;
+    std::vector<Cold> cold_;
+    uint32_t mask_ = 0;
+    size_t size_ = 0;
+};
+
+} // namespace engine_logic
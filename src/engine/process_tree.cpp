@@ -0,0 +1,182 @@
+// process_tree.cpp — Persistent process tree (§9.37)
+// NO Windows headers. NO Win32 APIs. NO OS-specific types.
+
+#include "process_tree.h"
+#include "target_matcher.h"
+
+#include <algorithm>
+
+namespace engine_logic {
+
+uint32_t ProcessTree::NameHash(std::wstring_view name) noexcept {
+    return TargetMatcher::Hash(name, 0);
+}
+
+void ProcessTree::Insert(uint32_t pid, uint32_t parentPid, uint64_t startMs, std::wstring_view name,
+                         bool critical) {
+    if (pid == NO_PID) return;
+    Remove(pid);
+    Node node;
+    node.parentPid = parentPid;
+    node.startMs = startMs;
+    node.nameHash = NameHash(name);
+    node.critical = critical;
+    nodes_.insert_or_assign(pid, Links{}, node);
+    Link(pid);
+}
+
+bool ProcessTree::Remove(uint32_t pid) {
+    auto it = nodes_.find(pid);
+    if (it == nodes_.end()) return false;
+    Unlink(it);
+
+    // Children become roots (they keep parentPid: a later node with this PID is newer)
+    uint32_t child = it.hot().firstChild;
+    while (child != NO_PID) {
+        auto c = nodes_.find(child);
+        child = c.hot().nextSibling;
+        c.hot().nextSibling = NO_PID;
+        c.hot().prevSibling = NO_PID;
+        c.cold().linked = false;
+    }
+
+    StringInternTable::Instance().Release(it.cold().imageId);
+    nodes_.erase(it);
+    return true;
+}
+
+void ProcessTree::Clear() {
+    for (auto entry : nodes_) StringInternTable::Instance().Release(entry.cold.imageId);
+    nodes_.clear();
+}
+
+void ProcessTree::Seed(const std::vector<LiveEntry>& live, uint64_t nowMs) {
+    Clear();
+    nodes_.reserve(live.size());
+    Reconcile(live, nowMs);
+}
+
+size_t ProcessTree::Reconcile(const std::vector<LiveEntry>& live, uint64_t nowMs) {
+    size_t changes = 0;
+    StringInternTable& strings = StringInternTable::Instance();
+
+    // 1. Gone: nodes absent from the snapshot
+    scratch_.clear();
+    scratch_.reserve(live.size());
+    for (const auto& e : live) scratch_.push_back(e.pid);
+    std::sort(scratch_.begin(), scratch_.end());
+    std::vector<uint32_t> gone;
+    for (auto entry : nodes_) {
+        if (entry.cold.startMs >= nowMs) continue;   // recorded after the snapshot
+        if (!std::binary_search(scratch_.begin(), scratch_.end(), entry.pid)) gone.push_back(entry.pid);
+    }
+    for (uint32_t pid : gone) changes += Remove(pid) ? 1 : 0;
+
+    // 2. New or replaced (PID reused since the node was recorded). Linked in step 3 so
+    //    parents later in the snapshot are found.
+    for (const auto& e : live) {
+        if (e.pid == NO_PID) continue;
+        auto it = nodes_.find(e.pid);
+        const Node* node = it == nodes_.end() ? nullptr : &it.cold();
+        if (node && node->startMs >= nowMs) continue;
+        if (node && node->parentPid == e.parentPid && SameImage(*node, e.name)) {
+            // Event-inserted node: the snapshot supplies its name
+            if (node->imageId == StringInternTable::EMPTY) it.cold().imageId = strings.Intern(e.name);
+            continue;
+        }
+        if (node) {
+            Remove(e.pid);
+            ++changes;
+        }
+        Node fresh;
+        fresh.parentPid = e.parentPid;
+        fresh.startMs = nowMs;
+        fresh.imageId = strings.Intern(e.name);
+        fresh.nameHash = NameHash(e.name);
+        fresh.critical = e.critical;
+        nodes_.insert_or_assign(e.pid, Links{}, fresh);
+        ++changes;
+    }
+
+    // 3. Link every root whose parent is now known (includes children orphaned above
+    //    and event-inserted children whose parent start was missed)
+    if (changes != 0) {
+        scratch_.clear();
+        for (auto entry : nodes_) {
+            if (!entry.cold.linked) scratch_.push_back(entry.pid);
+        }
+        for (uint32_t pid : scratch_) Link(pid);
+    }
+    return changes;
+}
+
+size_t ProcessTree::Ancestors(uint32_t pid, uint32_t* out, size_t max) const {
+    size_t n = 0;
+    if (max > MAX_DEPTH) max = MAX_DEPTH;
+    const Node* node = Find(pid);
+    while (node && node->linked && n < max) {
+        out[n++] = node->parentPid;
+        node = Find(node->parentPid);
+    }
+    return n;
+}
+
+std::vector<uint32_t> ProcessTree::Children(uint32_t pid) const {
+    std::vector<uint32_t> out;
+    auto it = nodes_.find(pid);
+    if (it == nodes_.end()) return out;
+    for (uint32_t c = it.hot().firstChild; c != NO_PID; c = nodes_.find(c).hot().nextSibling) {
+        out.push_back(c);
+    }
+    return out;
+}
+
+void ProcessTree::Link(uint32_t pid) {
+    auto it = nodes_.find(pid);
+    if (it == nodes_.end() || it.cold().linked) return;
+    const uint32_t parentPid = it.cold().parentPid;
+    if (parentPid == pid) return;                       // PID 0 (Idle) reports itself
+    auto parent = nodes_.find(parentPid);
+    if (parent == nodes_.end()) return;
+    if (parent.cold().startMs > it.cold().startMs) return;   // parent PID reused since
+
+    // Cycle guard: pid must not be an ancestor of its new parent
+    uint32_t depth = 0;
+    for (const Node* up = &parent.cold(); up->linked; up = Find(up->parentPid)) {
+        if (up->parentPid == pid || ++depth >= MAX_DEPTH) return;
+    }
+
+    const uint32_t head = parent.hot().firstChild;
+    if (head != NO_PID) nodes_.find(head).hot().prevSibling = pid;
+    it.hot().nextSibling = head;
+    it.hot().prevSibling = NO_PID;
+    parent.hot().firstChild = pid;
+    it.cold().linked = true;
+}
+
+void ProcessTree::Unlink(Table::iterator it) {
+    if (!it.cold().linked) return;
+    const uint32_t prev = it.hot().prevSibling;
+    const uint32_t next = it.hot().nextSibling;
+    if (prev != NO_PID) {
+        nodes_.find(prev).hot().nextSibling = next;
+    } else {
+        nodes_.find(it.cold().parentPid).hot().firstChild = next;
+    }
+    if (next != NO_PID) nodes_.find(next).hot().prevSibling = prev;
+    it.hot().nextSibling = NO_PID;
+    it.hot().prevSibling = NO_PID;
+    it.cold().linked = false;
+}
+
+bool ProcessTree::SameImage(const Node& node, std::wstring_view name) noexcept {
+    if (node.imageId == StringInternTable::EMPTY) return node.nameHash == NameHash(name);
+    const std::wstring_view image = StringInternTable::Instance().View(node.imageId);
+    if (image.size() != name.size()) return false;
+    for (size_t i = 0; i < name.size(); ++i) {
+        if (TargetMatcher::Fold(image[i]) != TargetMatcher::Fold(name[i])) return false;
+    }
+    return true;
+}
+
+} // namespace engine_logic
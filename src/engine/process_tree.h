@@ -0,0 +1,131 @@
+#pragma once
+// process_tree.h — Persistent process tree (pid -> parent / children / start time / image) (§9.37)
+// NO Windows headers. NO Win32 APIs. NO OS-specific types.
+//
+// 起動時のスナップショットで種をまき (InitialScan)、以降はプロセス開始 / 終了イベントで更新する。
+// 子リストは PID で張った侵入型の双方向リスト (firstChild / nextSibling / prevSibling) で、
+//   - 子孫の列挙 (ForEachDescendant) は O(部分木)。InitialScan の「ノードごとに全マップ走査」を置き換える
+//   - 祖先の列挙 (Ancestors) は O(深さ)。直接の親が未追跡でも追跡済みの祖先を見つけられる
+// 親へのリンクは「親ノードの開始時刻 <= 子の開始時刻」の場合のみ張る (PID 再利用された
+// 新しいプロセスを、古い子の親と取り違えない)。リンクが閉路になる場合も張らない (常に森)。
+// 開始時刻はエンジン時計でノードを初めて見た時刻 (Seed / Reconcile 時はその時刻)。
+// イベント由来の Insert は名前を intern しない (ETW コールバックで intern テーブルの mutex を
+// 取らない)。ノードは大文字小文字を畳んだ名前ハッシュとクリティカル判定だけを持ち、
+// イメージ名 (imageId) は次の Reconcile がスナップショットの名前で埋める。
+// Reconcile はスナップショットを取る経路 (ロス駆動再走査・SafetyNet) で、取りこぼした
+// 開始 / 終了 (Windows は未追跡プロセスの終了イベントを受け取らない) を補正する。
+// スレッド安全性なし: 呼び出し側のロック (EngineCore::treeCs_) で保護すること。
+
+#include "pid_table.h"
+#include "string_intern.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace engine_logic {
+
+class ProcessTree {
+public:
+    using Id = StringInternTable::Id;
+    static constexpr uint32_t NO_PID = 0xFFFFFFFFu;
+    static constexpr uint32_t MAX_DEPTH = 64;      // link refused beyond this (cycle guard)
+
+    struct Node {
+        uint32_t parentPid = NO_PID;   // as reported, linked or not
+        uint64_t startMs = 0;          // engine clock, first seen
+        Id imageId = StringInternTable::EMPTY;   // image file name (one reference per node);
+                                                 // EMPTY until a snapshot has named the node
+        uint32_t nameHash = 0;         // NameHash(image file name)
+        bool critical = false;         // critical image: ancestor / descendant walks stop here
+        bool linked = false;           // listed under parentPid's node
+    };
+
+    // Snapshot entry for Seed / Reconcile
+    struct LiveEntry {
+        uint32_t pid;
+        uint32_t parentPid;
+        std::wstring_view name;
+        bool critical = false;
+    };
+
+    // Case-insensitive image name hash (TargetMatcher folding)
+    static uint32_t NameHash(std::wstring_view name) noexcept;
+
+    ProcessTree() = default;
+    ~ProcessTree() { Clear(); }
+    ProcessTree(const ProcessTree&) = delete;
+    ProcessTree& operator=(const ProcessTree&) = delete;
+
+    // Process start (no interning: imageId stays EMPTY until the next Reconcile). An existing
+    // node with the same PID is a reused PID: it is removed first (its children become roots).
+    void Insert(uint32_t pid, uint32_t parentPid, uint64_t startMs, std::wstring_view name,
+                bool critical = false);
+    // Process exit. Children stay in the tree as roots. false = unknown PID.
+    bool Remove(uint32_t pid);
+    void Clear();
+
+    // Replaces the contents with a snapshot.
+    void Seed(const std::vector<LiveEntry>& live, uint64_t nowMs);
+    // Makes the tree match a snapshot taken anyway. nowMs: capture time. Nodes whose parent
+    // and image are unchanged keep their start time and links (and take the snapshot's name
+    // if they have none yet); others are replaced, missing ones removed. Nodes recorded at or after nowMs (events racing the capture) are newer
+    // than the snapshot and left alone. Returns inserted + removed nodes.
+    size_t Reconcile(const std::vector<LiveEntry>& live, uint64_t nowMs);
+
+    const Node* Find(uint32_t pid) const {
+        auto it = nodes_.find(pid);
+        return it == nodes_.end() ? nullptr : &it.cold();
+    }
+    bool Contains(uint32_t pid) const { return nodes_.contains(pid); }
+    size_t Size() const noexcept { return nodes_.size(); }
+
+    // Linked ancestors, parent first, up to max (no more than MAX_DEPTH). Returns the count.
+    size_t Ancestors(uint32_t pid, uint32_t* out, size_t max) const;
+
+    // Pre-order walk of pid's descendants (pid itself excluded), O(subtree).
+    // fn(uint32_t pid, const Node&) -> bool: false skips that node's children.
+    // fn must not modify the tree.
+    template <typename Fn>
+    void ForEachDescendant(uint32_t pid, Fn&& fn) const {
+        auto root = nodes_.find(pid);
+        if (root == nodes_.end()) return;
+        uint32_t cur = root.hot().firstChild;
+        while (cur != NO_PID) {
+            auto it = nodes_.find(cur);
+            if (fn(cur, it.cold()) && it.hot().firstChild != NO_PID) {
+                cur = it.hot().firstChild;
+                continue;
+            }
+            // Next sibling, or the sibling of the nearest ancestor below pid that has one
+            while (it.hot().nextSibling == NO_PID) {
+                const uint32_t up = it.cold().parentPid;
+                if (up == pid) return;
+                it = nodes_.find(up);
+            }
+            cur = it.hot().nextSibling;
+        }
+    }
+
+    // Direct children (diagnostics / tests)
+    std::vector<uint32_t> Children(uint32_t pid) const;
+
+private:
+    struct Links {
+        uint32_t firstChild = NO_PID;
+        uint32_t nextSibling = NO_PID;
+        uint32_t prevSibling = NO_PID;
+    };
+    using Table = PidTable<Links, Node>;
+
+    // Lists pid under its reported parent when the rules above allow it
+    void Link(uint32_t pid);
+    void Unlink(Table::iterator it);
+    static bool SameImage(const Node& node, std::wstring_view name) noexcept;
+
+    Table nodes_;
+    std::vector<uint32_t> scratch_;   // Reconcile: PIDs to remove / relink
+};
+
+} // namespace engine_logic
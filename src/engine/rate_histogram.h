@@ -0,0 +1,117 @@
+#pragma once
+// UnLeaf - per-second rate histogram (§9.35)
+// イベント数を 1 秒バケットで数え、完了した 1 秒ごとに「その秒の件数」を log2 ビンへ加算する。
+// ビン k は「件数がその範囲だった秒数」: バースト頻度とピーク秒間レートをキュー上限の
+// サイジング (ENFORCEMENT_QUEUE_SOFT_LIMIT 等) に使うためのもの。
+//   bin 0      : 0 件 (アイドル秒)
+//   bin k      : [2^(k-1), 2^k) 件
+//   bin BINS-1 : 2^(BINS-2) 件以上
+// 複数ライター / 任意リーダー。現在の秒は (秒, 件数) を 64bit に詰めた 1 つの atomic で、
+// 秒の切り替えに CAS で勝ったライターだけが前の秒をビンへ閉じる (PerSecondCounter と同じ詰め方)。
+// リーダーは経過済みで未クローズの秒 (イベントが来ないまま過ぎた秒) を Read 内で仮想的に閉じる。
+// すべて relaxed: 切り替え直後の Read は閉じかけの 1 秒分だけ遅れて見えることがある (テレメトリ用途)。
+
+#include <atomic>
+#include <cstdint>
+
+namespace engine_logic {
+
+class RateHistogram {
+public:
+    static constexpr uint32_t BINS = 16;
+
+    struct Snapshot {
+        uint64_t total;              // events since Reset
+        uint32_t lastSecond;         // events in the last completed second
+        uint32_t peakPerSecond;      // busiest completed second since Reset
+        uint32_t seconds[BINS];      // completed seconds per rate bin
+    };
+
+    static uint32_t BinOf(uint32_t count) noexcept {
+        uint32_t bin = 0;
+        while (count != 0 && bin < BINS - 1) {
+            count >>= 1;
+            ++bin;
+        }
+        return bin;
+    }
+
+    // Any thread. nowMs: monotonic milliseconds (GetTickCount64 / virtual clock).
+    // A writer whose clock read lags the current second adds to the current second.
+    void Add(uint64_t nowMs, uint32_t n = 1) noexcept {
+        const uint32_t sec = static_cast<uint32_t>(nowMs / 1000);
+        uint64_t cur = current_.load(std::memory_order_relaxed);
+        for (;;) {
+            if (Sec(cur) >= sec || !Started(cur)) {
+                const uint64_t next = Started(cur) ? cur + n : Pack(sec, n);
+                if (current_.compare_exchange_weak(cur, next, std::memory_order_relaxed)) break;
+                continue;
+            }
+            if (current_.compare_exchange_weak(cur, Pack(sec, n), std::memory_order_relaxed)) {
+                // cur's second is final: later adds for it land in the new second
+                Close(Count(cur), sec - Sec(cur) - 1);
+                break;
+            }
+        }
+        total_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    // Any thread. Seconds that elapsed since the last Add are reported as closed
+    // (the open second itself is not part of the histogram yet).
+    Snapshot Read(uint64_t nowMs) const noexcept {
+        const uint32_t sec = static_cast<uint32_t>(nowMs / 1000);
+        const uint64_t cur = current_.load(std::memory_order_relaxed);
+        Snapshot s = {};
+        s.total = total_.load(std::memory_order_relaxed);
+        s.lastSecond = lastSecond_.load(std::memory_order_relaxed);
+        s.peakPerSecond = peak_.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < BINS; ++i) s.seconds[i] = seconds_[i].load(std::memory_order_relaxed);
+        if (!Started(cur) || Sec(cur) >= sec) return s;   // lastSecond_ = the second before Sec(cur)
+        const uint32_t count = Count(cur);
+        const uint32_t idle = sec - Sec(cur) - 1;
+        s.seconds[BinOf(count)] += 1;
+        s.seconds[0] += idle;
+        if (count > s.peakPerSecond) s.peakPerSecond = count;
+        s.lastSecond = (idle == 0) ? count : 0;
+        return s;
+    }
+
+    uint64_t Total() const noexcept { return total_.load(std::memory_order_relaxed); }
+
+    // Starts the histogram at nowMs's second (seconds before it are not counted).
+    // While no Add() can run concurrently.
+    void Reset(uint64_t nowMs) noexcept {
+        current_.store(Pack(static_cast<uint32_t>(nowMs / 1000), 0), std::memory_order_relaxed);
+        lastSecond_.store(0, std::memory_order_relaxed);
+        peak_.store(0, std::memory_order_relaxed);
+        total_.store(0, std::memory_order_relaxed);
+        for (auto& bin : seconds_) bin.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    // Bit 63 marks "started" so second 0 (virtual clocks) is a real second
+    static constexpr uint64_t STARTED = uint64_t{1} << 63;
+    static uint64_t Pack(uint32_t sec, uint32_t count) noexcept {
+        return STARTED | (uint64_t{sec & 0x7FFFFFFF} << 32) | count;
+    }
+    static bool Started(uint64_t v) noexcept { return (v & STARTED) != 0; }
+    static uint32_t Sec(uint64_t v) noexcept { return static_cast<uint32_t>(v >> 32) & 0x7FFFFFFF; }
+    static uint32_t Count(uint64_t v) noexcept { return static_cast<uint32_t>(v); }
+
+    // Rollover winner only: count = the closed second, idle = empty seconds after it
+    void Close(uint32_t count, uint32_t idle) noexcept {
+        seconds_[BinOf(count)].fetch_add(1, std::memory_order_relaxed);
+        if (idle != 0) seconds_[0].fetch_add(idle, std::memory_order_relaxed);
+        uint32_t peak = peak_.load(std::memory_order_relaxed);
+        while (count > peak && !peak_.compare_exchange_weak(peak, count, std::memory_order_relaxed)) {}
+        lastSecond_.store(idle == 0 ? count : 0, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> current_{0};
+    std::atomic<uint32_t> lastSecond_{0};
+    std::atomic<uint32_t> peak_{0};
+    std::atomic<uint64_t> total_{0};
+    std::atomic<uint32_t> seconds_[BINS] = {};
+};
+
+} // namespace engine_logic
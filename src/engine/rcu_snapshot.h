@@ -0,0 +1,160 @@
+#pragma once
+// rcu_snapshot.h — Read-mostly snapshot publication (RCU style) + lock-free PID signal set
+// NO Windows headers. NO Win32 APIs. NO OS-specific types.
+//
+// RcuCell<T>: 単一ライターが不変スナップショットを差し替え、任意スレッドのリーダーが
+// ロックなしで参照する。回収は 2 カウンタのエポック方式 (userspace RCU の
+// synchronize_rcu と同型): Publish はエポックを 2 回反転し、各反転前のエポックで
+// 読み取り中のリーダーが抜けるのを待ってから旧スナップショットを解放する。
+//   - Read   : 任意スレッド。atomic RMW 2 回、待ちなし
+//   - Publish: 単一スレッド (呼び出し側で直列化)。リーダーの退出を待つ (数 μs)
+// リーダーはガード保持中にブロックしないこと (ライターが待つため)。
+//
+// PidSignalSet: 構築後キー不変の PID 集合。各 PID に atomic フラグ 1 バイトを持ち、
+// リーダーが exchange で「保留中」を立てる (§9.23 エンキュー時集約)。
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace engine_logic {
+
+template <typename T>
+class RcuCell {
+public:
+    // Read-side critical section: the snapshot stays alive until the guard is destroyed
+    class ReadGuard {
+    public:
+        ReadGuard(ReadGuard&& o) noexcept
+            : readers_(std::exchange(o.readers_, nullptr)), ptr_(o.ptr_) {}
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ReadGuard& operator=(ReadGuard&&) = delete;
+        ~ReadGuard() {
+            if (readers_) readers_->fetch_sub(1, std::memory_order_release);
+        }
+
+        const T* get() const noexcept { return ptr_; }
+        const T* operator->() const noexcept { return ptr_; }
+        explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    private:
+        friend class RcuCell;
+        ReadGuard(std::atomic<uint32_t>* readers, const T* ptr) : readers_(readers), ptr_(ptr) {}
+        std::atomic<uint32_t>* readers_;
+        const T* ptr_;
+    };
+
+    RcuCell() = default;
+    ~RcuCell() { delete current_.load(std::memory_order_relaxed); }
+
+    RcuCell(const RcuCell&) = delete;
+    RcuCell& operator=(const RcuCell&) = delete;
+
+    // Any thread. get() is nullptr until the first Publish.
+    ReadGuard Read() const noexcept {
+        // seq_cst: the counter increment must be ordered before the pointer load
+        // (pairs with the epoch flip + counter check in Synchronize)
+        const uint32_t e = epoch_.load(std::memory_order_seq_cst) & 1;
+        readers_[e].count.fetch_add(1, std::memory_order_seq_cst);
+        return ReadGuard(&readers_[e].count, current_.load(std::memory_order_seq_cst));
+    }
+
+    // Single writer. Returns once no reader can still hold the previous snapshot,
+    // which is destroyed before returning.
+    void Publish(std::unique_ptr<T> next) {
+        std::unique_ptr<T> old(current_.exchange(next.release(), std::memory_order_seq_cst));
+        if (old) Synchronize();
+        publishCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Writer thread only: the current snapshot without a guard (only the writer frees it)
+    const T* WriterPeek() const noexcept { return current_.load(std::memory_order_relaxed); }
+
+    uint64_t PublishCount() const noexcept { return publishCount_.load(std::memory_order_relaxed); }
+    // Writer yields spent waiting for readers (contention diagnostic)
+    uint64_t GraceWaits() const noexcept { return graceWaits_.load(std::memory_order_relaxed); }
+
+private:
+    // Two flips: a reader may have sampled the epoch before the previous flip and
+    // registered on the other counter while still loading the old pointer.
+    void Synchronize() {
+        for (int flip = 0; flip < 2; ++flip) {
+            const uint32_t e = epoch_.load(std::memory_order_relaxed);
+            epoch_.store(e + 1, std::memory_order_seq_cst);
+            while (readers_[e & 1].count.load(std::memory_order_seq_cst) != 0) {
+                graceWaits_.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    struct alignas(64) ReaderCount {
+        std::atomic<uint32_t> count{0};
+    };
+
+    mutable ReaderCount readers_[2];
+    alignas(64) std::atomic<uint32_t> epoch_{0};
+    std::atomic<T*> current_{nullptr};
+    std::atomic<uint64_t> publishCount_{0};
+    std::atomic<uint64_t> graceWaits_{0};
+};
+
+// Immutable PID set with one mutable atomic flag per member
+class PidSignalSet {
+public:
+    using Key = uint32_t;
+    static constexpr Key EMPTY_KEY = 0xFFFFFFFFu;
+
+    explicit PidSignalSet(const std::vector<Key>& pids) {
+        uint32_t cap = 16;
+        while (cap < pids.size() * 2) cap <<= 1;
+        mask_ = cap - 1;
+        keys_.assign(cap, EMPTY_KEY);
+        flags_.reset(new std::atomic<uint8_t>[cap]);
+        for (uint32_t s = 0; s < cap; ++s) flags_[s].store(0, std::memory_order_relaxed);
+        for (Key pid : pids) {
+            if (pid == EMPTY_KEY) continue;
+            uint32_t slot = Home(pid);
+            while (keys_[slot] != EMPTY_KEY && keys_[slot] != pid) slot = (slot + 1) & mask_;
+            if (keys_[slot] == EMPTY_KEY) {
+                keys_[slot] = pid;
+                ++size_;
+            }
+        }
+    }
+
+    PidSignalSet(const PidSignalSet&) = delete;
+    PidSignalSet& operator=(const PidSignalSet&) = delete;
+
+    // nullptr if pid is not a member
+    std::atomic<uint8_t>* Find(Key pid) const noexcept {
+        if (pid == EMPTY_KEY) return nullptr;
+        uint32_t slot = Home(pid);
+        for (;;) {
+            const Key k = keys_[slot];
+            if (k == pid) return &flags_[slot];
+            if (k == EMPTY_KEY) return nullptr;
+            slot = (slot + 1) & mask_;
+        }
+    }
+    bool Contains(Key pid) const noexcept { return Find(pid) != nullptr; }
+    size_t size() const noexcept { return size_; }
+
+private:
+    // Fibonacci hashing (same spread as PidTable)
+    uint32_t Home(Key key) const noexcept {
+        return static_cast<uint32_t>((uint64_t{key} * 0x9E3779B97F4A7C15ull) >> 32) & mask_;
+    }
+
+    std::vector<Key> keys_;
+    std::unique_ptr<std::atomic<uint8_t>[]> flags_;   // mutable through const Find (readers set them)
+    uint32_t mask_ = 0;
+    size_t size_ = 0;
+};
+
+} // namespace engine_logic
@@ -0,0 +1,88 @@
+// string_intern.cpp — StringInternTable (§9.30)
+// NO Windows headers. NO Win32 APIs. NO OS-specific types.
+
+#include "string_intern.h"
+
+namespace engine_logic {
+
+StringInternTable& StringInternTable::Instance() {
+    static StringInternTable* instance = new StringInternTable();
+    return *instance;
+}
+
+StringInternTable::StringInternTable() {
+    for (auto& c : chunks_) c.store(nullptr, std::memory_order_relaxed);
+}
+
+StringInternTable::~StringInternTable() {
+    for (auto& c : chunks_) delete[] c.load(std::memory_order_relaxed);
+}
+
+StringInternTable::Id StringInternTable::Intern(std::wstring_view s) {
+    if (s.empty()) return EMPTY;
+
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = index_.find(s);
+    if (it != index_.end()) {
+        // refs may be 0 here: a Release is about to take mu_ and will see the revived count
+        At(it->second).refs.fetch_add(1, std::memory_order_relaxed);
+        return it->second;
+    }
+
+    Id id;
+    if (!freeIds_.empty()) {
+        id = freeIds_.back();
+        freeIds_.pop_back();
+    } else {
+        if (nextId_ >> CHUNK_SHIFT >= MAX_CHUNKS) return EMPTY;
+        id = nextId_++;
+        std::atomic<Entry*>& chunk = chunks_[id >> CHUNK_SHIFT];
+        if (!chunk.load(std::memory_order_relaxed)) {
+            chunk.store(new Entry[CHUNK_SIZE], std::memory_order_release);
+        }
+    }
+
+    Entry& e = At(id);
+    e.text.assign(s);
+    e.live = true;
+    e.refs.store(1, std::memory_order_relaxed);
+    index_.emplace(std::wstring_view(e.text), id);
+    liveBytes_ += e.text.size() * sizeof(wchar_t);
+    return id;
+}
+
+void StringInternTable::AddRef(Id id) noexcept {
+    if (id == EMPTY) return;
+    At(id).refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StringInternTable::Release(Id id) noexcept {
+    if (id == EMPTY) return;
+    if (At(id).refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        ReleaseSlow(id);
+    }
+}
+
+void StringInternTable::ReleaseSlow(Id id) {
+    std::lock_guard<std::mutex> lock(mu_);
+    Entry& e = At(id);
+    // Revived by Intern, or already freed by a racing releaser that also saw 1 -> 0
+    if (!e.live || e.refs.load(std::memory_order_acquire) != 0) return;
+    index_.erase(std::wstring_view(e.text));
+    liveBytes_ -= e.text.size() * sizeof(wchar_t);
+    e.live = false;
+    std::wstring().swap(e.text);
+    freeIds_.push_back(id);
+}
+
+size_t StringInternTable::LiveCount() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return index_.size();
+}
+
+size_t StringInternTable::LiveBytes() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return liveBytes_;
+}
+
+} // namespace engine_logic
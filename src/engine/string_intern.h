@@ -0,0 +1,116 @@
+#pragma once
+// string_intern.h — Process-wide refcounted string interning table (§9.30)
+// NO Windows headers. NO Win32 APIs. NO OS-specific types.
+//
+// イメージ名 / パスを uint32 ID に置き換え、同一イメージの子プロセス (数百の chrome.exe 等)
+// が文字列 1 本を共有する。EnforcementRequest / TrackedProcess / ポリシーキャッシュは
+// ID (または InternedString) のみを持つ。
+//   - ID 0 (EMPTY) = 空文字列。参照カウントなし
+//   - Intern    : 任意スレッド。既存文字列は参照 +1、新規は登録 (mutex)
+//   - AddRef    : 任意スレッド。呼び出し側が参照を保持していること。ロックなし
+//   - Release   : 任意スレッド。0 になった場合のみ mutex を取り、エントリを解放・ID を再利用
+//   - View/CStr : 任意スレッド。ロックなし (チャンクは解放されず、参照保持中の文字列は不変)
+// ID は参照が残る限り同じ文字列を指す (安定)。参照 0 で解放された ID は再利用される。
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace engine_logic {
+
+class StringInternTable {
+public:
+    using Id = uint32_t;
+    static constexpr Id EMPTY = 0;
+    static constexpr uint32_t CHUNK_SHIFT = 10;                 // 1024 entries per chunk
+    static constexpr uint32_t CHUNK_SIZE = 1u << CHUNK_SHIFT;
+    static constexpr uint32_t MAX_CHUNKS = 4096;                // 4M live strings
+
+    // Process-wide table (never destroyed: static owners may release during exit)
+    static StringInternTable& Instance();
+
+    StringInternTable();
+    ~StringInternTable();
+    StringInternTable(const StringInternTable&) = delete;
+    StringInternTable& operator=(const StringInternTable&) = delete;
+
+    // Returns an ID holding one new reference (EMPTY for an empty string).
+    // Table full: returns EMPTY (callers treat it as an unknown name).
+    Id Intern(std::wstring_view s);
+    void AddRef(Id id) noexcept;
+    void Release(Id id) noexcept;
+
+    // Lock-free. Valid while the caller holds a reference on id.
+    std::wstring_view View(Id id) const noexcept {
+        return id == EMPTY ? std::wstring_view() : std::wstring_view(At(id).text);
+    }
+    const wchar_t* CStr(Id id) const noexcept { return id == EMPTY ? L"" : At(id).text.c_str(); }
+
+    // Statistics (mutex)
+    size_t LiveCount() const;
+    size_t LiveBytes() const;        // character storage of live strings
+    uint32_t RefCount(Id id) const noexcept {
+        return id == EMPTY ? 0 : At(id).refs.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Entry {
+        std::atomic<uint32_t> refs{0};
+        bool live = false;           // mu_
+        std::wstring text;           // immutable while refs > 0
+    };
+
+    Entry& At(Id id) const noexcept {
+        return chunks_[id >> CHUNK_SHIFT].load(std::memory_order_acquire)[id & (CHUNK_SIZE - 1)];
+    }
+    void ReleaseSlow(Id id);
+
+    std::atomic<Entry*> chunks_[MAX_CHUNKS];
+    mutable std::mutex mu_;
+    std::unordered_map<std::wstring_view, Id> index_;   // keys view Entry::text
+    std::vector<Id> freeIds_;
+    Id nextId_ = 1;                                      // ID 0 is EMPTY
+    size_t liveBytes_ = 0;
+};
+
+// RAII handle: one reference on an interned string (4 bytes)
+class InternedString {
+public:
+    InternedString() noexcept = default;
+    InternedString(std::wstring_view s) : id_(StringInternTable::Instance().Intern(s)) {}
+    InternedString(const std::wstring& s) : InternedString(std::wstring_view(s)) {}
+    InternedString(const wchar_t* s) : InternedString(std::wstring_view(s)) {}
+    InternedString(const InternedString& o) noexcept : id_(o.id_) {
+        StringInternTable::Instance().AddRef(id_);
+    }
+    InternedString(InternedString&& o) noexcept : id_(o.id_) { o.id_ = StringInternTable::EMPTY; }
+    InternedString& operator=(InternedString o) noexcept {
+        std::swap(id_, o.id_);
+        return *this;
+    }
+    ~InternedString() { StringInternTable::Instance().Release(id_); }
+
+    // Takes ownership of a reference obtained from StringInternTable::Intern
+    static InternedString Adopt(StringInternTable::Id id) noexcept {
+        InternedString s;
+        s.id_ = id;
+        return s;
+    }
+
+    StringInternTable::Id id() const noexcept { return id_; }
+    bool empty() const noexcept { return id_ == StringInternTable::EMPTY; }
+    std::wstring_view view() const noexcept { return StringInternTable::Instance().View(id_); }
+    const wchar_t* c_str() const noexcept { return StringInternTable::Instance().CStr(id_); }
+    std::wstring str() const { return std::wstring(view()); }
+    operator std::wstring_view() const noexcept { return view(); }
+
+private:
+    StringInternTable::Id id_ = StringInternTable::EMPTY;
+};
+
+} // namespace engine_logic
@@ -0,0 +1,46 @@
+// system_snapshot.cpp — Process + thread snapshot arena (§9.38)
+// NO Windows headers. NO Win32 APIs. NO OS-specific types.
+
+#include "system_snapshot.h"
+
+#include <algorithm>
+
+namespace engine_logic {
+
+void SystemSnapshot::Reserve(size_t processes, size_t threads, size_t nameChars) {
+    processes_.reserve(processes);
+    index_.reserve(processes);
+    threads_.reserve(threads);
+    names_.reserve(nameChars + processes);
+}
+
+void SystemSnapshot::AddProcess(uint32_t pid, uint32_t parentPid, std::wstring_view name,
+                                uint64_t createTime) {
+    Process p;
+    p.pid = pid;
+    p.parentPid = parentPid;
+    p.nameOffset = static_cast<uint32_t>(names_.size());
+    p.nameLength = static_cast<uint32_t>(name.size());
+    p.firstThread = static_cast<uint32_t>(threads_.size());
+    p.threadCount = 0;
+    p.createTime = createTime;
+    processes_.push_back(p);
+    names_.insert(names_.end(), name.begin(), name.end());
+    names_.push_back(L'\0');
+}
+
+void SystemSnapshot::Finish() {
+    index_.clear();
+    for (uint32_t i = 0; i < processes_.size(); ++i) index_.push_back({processes_[i].pid, i});
+    std::sort(index_.begin(), index_.end(),
+              [](const IndexEntry& a, const IndexEntry& b) { return a.pid < b.pid; });
+}
+
+const SystemSnapshot::Process* SystemSnapshot::Find(uint32_t pid) const noexcept {
+    auto it = std::lower_bound(index_.begin(), index_.end(), pid,
+                               [](const IndexEntry& e, uint32_t key) { return e.pid < key; });
+    if (it == index_.end() || it->pid != pid) return nullptr;
+    return &processes_[it->row];
+}
+
+} // namespace engine_logic
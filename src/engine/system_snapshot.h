@@ -0,0 +1,97 @@
+#pragma once
+// system_snapshot.h — Process + thread snapshot in a reusable arena (§9.38)
+// NO Windows headers. NO Win32 APIs. NO OS-specific types.
+//
+// ISystemSnapshot::Capture が 1 回の走査 (Windows: NtQuerySystemInformation(
+// SystemProcessInformation)、Linux: /proc) でプロセスとスレッドをまとめて書き込む入れ物。
+//   - プロセス行 (固定長 POD) / スレッド ID 配列 / イメージ名プール (NUL 区切り) の 3 本の
+//     フラット配列。Clear() は容量を残すので、定常状態のキャプチャは割り当てなし
+//   - 行は OS の列挙順 (SafetyNet の round-robin はこの順序に依存する)
+//   - Find() は Finish() で作る PID 昇順インデックスを二分探索
+// EngineCore は制御ループ 1 tick につき 1 回だけキャプチャし、その tick の利用者
+// (InitialScan / SafetyNet / ETW 停止判定 / 再走査 / スレッドスロットル解除) で共有する。
+// スレッド安全性なし: 書き込み (キャプチャ) と読み出しは同じスレッドで行うこと。
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace engine_logic {
+
+class SystemSnapshot {
+public:
+    struct Process {
+        uint32_t pid;
+        uint32_t parentPid;
+        uint32_t nameOffset;    // names_ index (NUL-terminated)
+        uint32_t nameLength;
+        uint32_t firstThread;   // threads_ index
+        uint32_t threadCount;
+        uint64_t createTime;    // §9.40: OS start time, opaque (Windows: FILETIME, Linux: ticks since boot). 0 = unknown
+    };
+
+    // Thread ids of one process
+    struct ThreadSpan {
+        const uint32_t* ids;
+        size_t count;
+        const uint32_t* begin() const noexcept { return ids; }
+        const uint32_t* end() const noexcept { return ids + count; }
+        bool empty() const noexcept { return count == 0; }
+    };
+
+    // Keeps capacity (arena reuse)
+    void Clear() noexcept {
+        processes_.clear();
+        threads_.clear();
+        names_.clear();
+        index_.clear();
+    }
+    void Reserve(size_t processes, size_t threads, size_t nameChars);
+
+    // === Capture side ===
+    // AddThread belongs to the process added last. Finish() once all rows are in.
+    void AddProcess(uint32_t pid, uint32_t parentPid, std::wstring_view name, uint64_t createTime = 0);
+    void AddThread(uint32_t tid) {
+        threads_.push_back(tid);
+        ++processes_.back().threadCount;
+    }
+    void Finish();
+
+    // === Read side (views valid until the next Clear) ===
+    size_t Size() const noexcept { return processes_.size(); }
+    bool Empty() const noexcept { return processes_.empty(); }
+    size_t ThreadTotal() const noexcept { return threads_.size(); }
+    const Process& operator[](size_t i) const noexcept { return processes_[i]; }
+    const Process* begin() const noexcept { return processes_.data(); }
+    const Process* end() const noexcept { return processes_.data() + processes_.size(); }
+
+    // Image file name as reported by the OS (not lowercased). data() is NUL-terminated.
+    std::wstring_view Name(const Process& p) const noexcept {
+        return std::wstring_view(names_.data() + p.nameOffset, p.nameLength);
+    }
+    ThreadSpan Threads(const Process& p) const noexcept {
+        return ThreadSpan{threads_.data() + p.firstThread, p.threadCount};
+    }
+    // nullptr when pid is not in the snapshot
+    const Process* Find(uint32_t pid) const noexcept;
+
+    // Bytes held by the arena (diagnostics)
+    size_t CapacityBytes() const noexcept {
+        return processes_.capacity() * sizeof(Process) + threads_.capacity() * sizeof(uint32_t) +
+               names_.capacity() * sizeof(wchar_t) + index_.capacity() * sizeof(IndexEntry);
+    }
+
+private:
+    struct IndexEntry {
+        uint32_t pid;
+        uint32_t row;
+    };
+
+    std::vector<Process> processes_;
+    std::vector<uint32_t> threads_;
+    std::vector<wchar_t> names_;
+    std::vector<IndexEntry> index_;   // sorted by pid (Finish)
+};
+
+} // namespace engine_logic
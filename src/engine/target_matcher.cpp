@@ -0,0 +1,143 @@
+// target_matcher.cpp — Immutable case-folding string set for the ETW hot path
+// NO Windows headers. NO Win32 APIs.
+
+#include "target_matcher.h"
+#include <algorithm>
+#include <cwctype>
+
+namespace engine_logic {
+
+namespace {
+
+// Seeds tried before falling back to linear probing. Target lists are small
+// (tens of entries) and the table is kept at <= 50% load, so a collision-free
+// seed is normally found within a handful of attempts.
+constexpr uint32_t PERFECT_SEED_ATTEMPTS = 64;
+
+uint32_t TableSizeFor(size_t count) {
+    uint32_t size = 8;
+    while (size < count * 2) size <<= 1;
+    return size;
+}
+
+} // namespace
+
+wchar_t TargetMatcher::Fold(wchar_t c) noexcept {
+    if (c < 0x80) {
+        return (c >= L'A' && c <= L'Z') ? static_cast<wchar_t>(c + (L'a' - L'A')) : c;
+    }
+    return static_cast<wchar_t>(towlower(c));
+}
+
+// FNV-1a over folded UTF-16 code units, seed mixed into the offset basis
+uint32_t TargetMatcher::Hash(std::wstring_view key, uint32_t seed) noexcept {
+    uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+    for (wchar_t c : key) {
+        h ^= static_cast<uint32_t>(Fold(c)) & 0xFFFFu;
+        h *= 16777619u;
+    }
+    h ^= h >> 15;
+    return h;
+}
+
+TargetMatcher::TargetMatcher(const std::vector<std::wstring>& keys) {
+    // Fold + dedupe into the pool
+    std::vector<std::wstring> folded;
+    folded.reserve(keys.size());
+    size_t total = 0;
+    for (const auto& k : keys) {
+        std::wstring f(k.size(), L'\0');
+        for (size_t i = 0; i < k.size(); ++i) f[i] = Fold(k[i]);
+        bool dup = false;
+        for (const auto& existing : folded) {
+            if (existing == f) { dup = true; break; }
+        }
+        if (dup) continue;
+        total += f.size();
+        folded.push_back(std::move(f));
+    }
+    if (folded.empty()) return;
+
+    pool_.reserve(total);
+    entries_.reserve(folded.size());
+    minLength_ = UINT32_MAX;
+    for (const auto& f : folded) {
+        minLength_ = std::min(minLength_, static_cast<uint32_t>(f.size()));
+        maxLength_ = std::max(maxLength_, static_cast<uint32_t>(f.size()));
+        entries_.push_back(Entry{static_cast<uint32_t>(pool_.size()),
+                                 static_cast<uint32_t>(f.size()), 0});
+        pool_ += f;
+    }
+
+    const uint32_t tableSize = TableSizeFor(entries_.size());
+    mask_ = tableSize - 1;
+    slots_.assign(tableSize, 0);
+
+    auto keyOf = [this](const Entry& e) {
+        return std::wstring_view(pool_.data() + e.offset, e.length);
+    };
+
+    // Perfect hash search: every key lands in a distinct home slot
+    for (uint32_t seed = 0; seed < PERFECT_SEED_ATTEMPTS; ++seed) {
+        std::fill(slots_.begin(), slots_.end(), 0u);
+        bool collision = false;
+        for (uint32_t i = 0; i < entries_.size(); ++i) {
+            const uint32_t h = Hash(keyOf(entries_[i]), seed);
+            uint32_t& slot = slots_[h & mask_];
+            if (slot != 0) { collision = true; break; }
+            slot = i + 1;
+            entries_[i].hash = h;
+        }
+        if (!collision) {
+            seed_ = seed;
+            maxProbe_ = 0;
+            return;
+        }
+    }
+
+    // Fallback: seed 0 + linear probing (still allocation-free lookup)
+    seed_ = 0;
+    maxProbe_ = 0;
+    std::fill(slots_.begin(), slots_.end(), 0u);
+    for (uint32_t i = 0; i < entries_.size(); ++i) {
+        const uint32_t h = Hash(keyOf(entries_[i]), seed_);
+        entries_[i].hash = h;
+        uint32_t probe = 0;
+        while (slots_[(h + probe) & mask_] != 0) ++probe;
+        slots_[(h + probe) & mask_] = i + 1;
+        if (probe > maxProbe_) maxProbe_ = probe;
+    }
+}
+
+bool TargetMatcher::Matches(const Entry& e, std::wstring_view key) const noexcept {
+    if (e.length != key.size()) return false;
+    const wchar_t* stored = pool_.data() + e.offset;
+    for (size_t i = 0; i < key.size(); ++i) {
+        if (stored[i] != Fold(key[i])) return false;
+    }
+    return true;
+}
+
+bool TargetMatcher::Contains(std::wstring_view key) const noexcept {
+    if (entries_.empty()) return false;
+    if (key.size() < minLength_ || key.size() > maxLength_) return false;
+    const uint32_t h = Hash(key, seed_);
+    for (uint32_t probe = 0; probe <= maxProbe_; ++probe) {
+        const uint32_t slot = slots_[(h + probe) & mask_];
+        if (slot == 0) return false;
+        const Entry& e = entries_[slot - 1];
+        if (e.hash == h && Matches(e, key)) return true;
+    }
+    return false;
+}
+
+std::vector<std::wstring> TargetMatcher::Keys() const {
+    std::vector<std::wstring> out;
+    out.reserve(entries_.size());
+    for (const auto& e : entries_) {
+        out.emplace_back(pool_.data() + e.offset, e.length);
+    }
+    return out;
+}
+
+} // namespace engine_logic
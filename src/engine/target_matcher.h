@@ -0,0 +1,59 @@
+#pragma once
+// target_matcher.h — Immutable case-folding string set for the ETW hot path
+// NO Windows headers. NO Win32 APIs. NO OS-specific types.
+//
+// RefreshTargetSet() で一度だけ構築し、以降は読み取り専用。
+// Contains() は std::wstring_view を受け取り、ToLower コピー・substr を行わない
+// (割り当てゼロ)。構築時に衝突のないシードを探索し (perfect hash)、見つからない
+// 場合のみ線形探査にフォールバックする。
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine_logic {
+
+class TargetMatcher {
+public:
+    TargetMatcher() = default;
+    // keys: any case; duplicates (after folding) are collapsed
+    explicit TargetMatcher(const std::vector<std::wstring>& keys);
+
+    // Case-insensitive membership test. Allocation-free.
+    bool Contains(std::wstring_view key) const noexcept;
+
+    size_t size() const noexcept { return entries_.size(); }
+    bool empty() const noexcept { return entries_.empty(); }
+
+    // Build diagnostics: true when every key owns a distinct slot (single probe)
+    bool IsPerfect() const noexcept { return maxProbe_ == 0; }
+    uint32_t Seed() const noexcept { return seed_; }
+
+    // Folded keys in insertion order (logging / diagnostics)
+    std::vector<std::wstring> Keys() const;
+
+    // ToLower-compatible single character fold (ASCII fast path, towlower otherwise)
+    static wchar_t Fold(wchar_t c) noexcept;
+    static uint32_t Hash(std::wstring_view key, uint32_t seed) noexcept;
+
+private:
+    struct Entry {
+        uint32_t offset;    // into pool_
+        uint32_t length;
+        uint32_t hash;      // Hash(key, seed_) — cheap pre-compare
+    };
+
+    bool Matches(const Entry& e, std::wstring_view key) const noexcept;
+
+    std::wstring pool_;              // folded keys, concatenated (one allocation)
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> slots_;    // entry index + 1; 0 = empty
+    uint32_t mask_ = 0;
+    uint32_t seed_ = 0;
+    uint32_t maxProbe_ = 0;          // longest displacement from home slot
+    uint32_t minLength_ = 0;         // length range of stored keys: rejects most
+    uint32_t maxLength_ = 0;         // misses (full paths) before hashing
+};
+
+} // namespace engine_logic
@@ -0,0 +1,1043 @@
+// UnLeaf - In-memory fake of the OS abstraction layer
+
+#include "fake_platform.h"
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <utility>
+
+namespace unleaf {
+namespace platform {
+
+namespace {
+
+inline uintptr_t Key(NativeHandle h) {
+    return reinterpret_cast<uintptr_t>(h);
+}
+
+} // anonymous namespace
+
+FakePlatform::FakePlatform()
+    : platform_{ *this, *this, *this, *this, *this, *this, *this } {
+}
+
+// ============================================================================
+// Object table
+// ============================================================================
+
+NativeHandle FakePlatform::NewObject(const Object& obj) {
+    uintptr_t id = nextHandle_;
+    nextHandle_ += 4;
+    objects_[id] = obj;
+    return reinterpret_cast<NativeHandle>(id);
+}
+
+FakePlatform::Object* FakePlatform::Find(NativeHandle h) {
+    auto it = objects_.find(Key(h));
+    return (it != objects_.end()) ? &it->second : nullptr;
+}
+
+const FakePlatform::Object* FakePlatform::Find(NativeHandle h) const {
+    auto it = objects_.find(Key(h));
+    return (it != objects_.end()) ? &it->second : nullptr;
+}
+
+FakeProcess* FakePlatform::ProcessFor(NativeHandle h) {
+    Object* obj = Find(h);
+    if (!obj || obj->kind != Kind::PROCESS) return nullptr;
+    auto it = processes_.find(obj->pid);
+    return (it != processes_.end()) ? &it->second : nullptr;
+}
+
+// ============================================================================
+// Scenario control
+// ============================================================================
+
+void FakePlatform::SpawnProcess(DWORD pid, DWORD parentPid, const std::wstring& name,
+                                const std::wstring& imagePath) {
+    Lock lock(mu_);
+    FakeProcess p;
+    p.pid = pid;
+    p.parentPid = parentPid;
+    p.name = name;
+    p.imagePath = imagePath.empty() ? (L"c:\\apps\\" + name) : imagePath;
+    p.createTime = nextCreateTime_++;
+
+    // Children of a process inside one of our jobs join that job (default job inheritance)
+    auto parent = processes_.find(parentPid);
+    if (parentPid != 0 && parent != processes_.end() && parent->second.alive) {
+        p.job = parent->second.job;
+    }
+    processes_[pid] = std::move(p);
+}
+
+void FakePlatform::TerminateProcess(DWORD pid, DWORD exitCode) {
+    Lock lock(mu_);
+    auto it = processes_.find(pid);
+    if (it == processes_.end() || !it->second.alive) return;
+    it->second.alive = false;
+    it->second.exitCode = exitCode;
+    FireExitWaits(lock, pid);
+
+    // §9.32: exit event from the monitor (after the waits, like an independent provider)
+    if (monitorRunning_ && exitCallback_) {
+        eventCount_++;
+        lastEventTime_ = nowMs_;
+        ProcessExitCallback cb = exitCallback_;
+        lock.unlock();
+        cb(pid);
+        lock.lock();
+    }
+}
+
+void FakePlatform::FireExitWaits(Lock& lock, DWORD pid) {
+    // WT_EXECUTEONLYONCE: each wait fires once; callbacks run without the fake's lock
+    std::vector<std::pair<WaitCallback, PVOID>> toFire;
+    for (auto& [id, obj] : objects_) {
+        if (obj.kind == Kind::WAIT && obj.pid == pid && obj.waitCallback) {
+            toFire.emplace_back(obj.waitCallback, obj.context);
+            obj.waitCallback = nullptr;
+        }
+    }
+    lock.unlock();
+    for (auto& [cb, ctx] : toFire) {
+        cb(ctx, FALSE);
+    }
+    lock.lock();
+    cv_.notify_all();
+}
+
+void FakePlatform::SetEcoQoS(DWORD pid, bool enabled) {
+    Lock lock(mu_);
+    auto it = processes_.find(pid);
+    if (it != processes_.end()) it->second.ecoQoS = enabled;
+}
+
+void FakePlatform::SetAccessDenied(DWORD pid, bool denied) {
+    Lock lock(mu_);
+    auto it = processes_.find(pid);
+    if (it != processes_.end()) it->second.accessDenied = denied;
+}
+
+void FakePlatform::SetEcoLocked(DWORD pid, bool locked) {
+    Lock lock(mu_);
+    auto it = processes_.find(pid);
+    if (it != processes_.end()) it->second.ecoLocked = locked;
+}
+
+void FakePlatform::SetForeignJob(DWORD pid, bool inJob) {
+    Lock lock(mu_);
+    auto it = processes_.find(pid);
+    if (it != processes_.end()) it->second.foreignJob = inJob;
+}
+
+void FakePlatform::SetThreadCount(DWORD pid, int threads) {
+    Lock lock(mu_);
+    auto it = processes_.find(pid);
+    if (it != processes_.end()) it->second.threadCount = threads;
+}
+
+bool FakePlatform::GetProcess(DWORD pid, FakeProcess& out) const {
+    Lock lock(mu_);
+    auto it = processes_.find(pid);
+    if (it == processes_.end()) return false;
+    out = it->second;
+    return true;
+}
+
+void FakePlatform::AddFile(const std::wstring& canonPath) {
+    Lock lock(mu_);
+    files_.insert(canonPath);
+}
+
+void FakePlatform::TouchFile(const std::wstring& dir, const std::wstring& fileName) {
+    Lock lock(mu_);
+    for (auto& [id, obj] : objects_) {
+        if (obj.kind == Kind::DIR_WATCH && obj.directory == dir &&
+            ToLower(obj.fileName) == ToLower(fileName)) {
+            obj.signaled = true;
+        }
+    }
+    cv_.notify_all();
+}
+
+void FakePlatform::EmitProcessStart(DWORD pid, DWORD parentPid,
+                                    const std::wstring& imageName,
+                                    const std::wstring& imagePath) {
+    Lock lock(mu_);
+    if (!monitorRunning_) return;
+    eventCount_++;
+    lastEventTime_ = nowMs_;
+    traceWriter_.AppendProcessStart(nowMs_ * 1000, pid, parentPid, imageName, imagePath);
+    if (pendingStarts_.Full()) FlushProcessStarts(lock);
+    pendingStarts_.Append(pid, parentPid, imagePath.empty() ? imageName : imagePath);
+    if (!batchOpen_) FlushProcessStarts(lock);
+}
+
+void FakePlatform::BeginEventBatch() {
+    Lock lock(mu_);
+    batchOpen_ = true;
+}
+
+void FakePlatform::EndEventBatch() {
+    Lock lock(mu_);
+    batchOpen_ = false;
+    FlushProcessStarts(lock);
+}
+
+void FakePlatform::FlushProcessStarts(Lock& lock) {
+    if (pendingStarts_.Empty()) return;
+    ProcessStartCallback cb = processCallback_;
+    if (!cb || !monitorRunning_) {
+        pendingStarts_.Clear();
+        return;
+    }
+    // Another thread still inside the callback owns deliverStarts_: use a private batch
+    std::unique_ptr<engine_logic::ProcessStartBatch> overlap;
+    engine_logic::ProcessStartBatch* out = &deliverStarts_;
+    if (delivering_) {
+        overlap = std::make_unique<engine_logic::ProcessStartBatch>();
+        out = overlap.get();
+    }
+    delivering_ = true;
+    std::swap(pendingStarts_, *out);
+    lock.unlock();
+    cb(*out);
+    lock.lock();
+    out->Clear();
+    if (!overlap) delivering_ = false;
+}
+
+void FakePlatform::EmitThreadStart(DWORD threadId, DWORD ownerPid) {
+    ThreadStartCallback cb;
+    {
+        Lock lock(mu_);
+        if (!monitorRunning_) return;
+        eventCount_++;
+        lastEventTime_ = nowMs_;
+        traceWriter_.AppendThreadStart(nowMs_ * 1000, ownerPid, threadId);
+        if (!threadCallback_) return;
+        if (threadFilter_ && !threadFilter_->Test(ownerPid)) {
+            threadFiltered_.Add(nowMs_);
+            return;
+        }
+        threadForwarded_.Add(nowMs_);
+        cb = threadCallback_;
+    }
+    if (cb) cb(threadId, ownerPid);
+}
+
+void FakePlatform::LaunchProcess(DWORD pid, DWORD parentPid, const std::wstring& name,
+                                 const std::wstring& imagePath) {
+    SpawnProcess(pid, parentPid, name, imagePath);
+    FakeProcess p;
+    GetProcess(pid, p);
+    EmitProcessStart(pid, parentPid, name, p.imagePath);
+}
+
+void FakePlatform::AddLostEvents(uint32_t count) {
+    Lock lock(mu_);
+    lostEventCount_ += count;
+}
+
+void FakePlatform::SetMonitorHealthy(bool healthy) {
+    Lock lock(mu_);
+    monitorHealthy_ = healthy;
+}
+
+void FakePlatform::SetMonitorStartResult(bool ok) {
+    Lock lock(mu_);
+    monitorStartResult_ = ok;
+}
+
+void FakePlatform::SetMonitorReportsExits(bool reports) {
+    Lock lock(mu_);
+    monitorReportsExits_ = reports;
+}
+
+bool FakePlatform::IsMonitorRunning() const {
+    Lock lock(mu_);
+    return monitorRunning_;
+}
+
+void FakePlatform::SetSupportsFullEcoQoS(bool supported) {
+    Lock lock(mu_);
+    supportsFullEcoQoS_ = supported;
+}
+
+void FakePlatform::SetSnapshotFails(bool fails) {
+    Lock lock(mu_);
+    snapshotFails_ = fails;
+}
+
+void FakePlatform::SetCreateTimerFails(bool fails) {
+    Lock lock(mu_);
+    createTimerFails_ = fails;
+}
+
+void FakePlatform::SetPendingOverflowFlag() {
+    Lock lock(mu_);
+    pendingOverflow_ = true;
+}
+
+void FakePlatform::SetProcessCallHook(std::function<void()> hook) {
+    processCallHook_ = std::move(hook);
+}
+
+// ============================================================================
+// Virtual time
+// ============================================================================
+
+void FakePlatform::AdvanceTime(ULONGLONG ms) {
+    ULONGLONG target;
+    {
+        Lock lock(mu_);
+        target = nowMs_ + ms;
+    }
+    AdvanceTimeTo(target);
+}
+
+void FakePlatform::AdvanceTimeTo(ULONGLONG targetMs) {
+    Lock lock(mu_);
+    if (targetMs < nowMs_) return;
+    while (FireNextTimer(lock, targetMs)) {}
+    nowMs_ = targetMs;
+    ArmWaitableTimers();
+    cv_.notify_all();
+}
+
+bool FakePlatform::FireNextTimer(Lock& lock, ULONGLONG targetMs) {
+    // Waitable timers due before the next callback timer must signal first
+    uintptr_t bestId = 0;
+    ULONGLONG bestDue = 0;
+    for (const auto& [id, obj] : objects_) {
+        if (obj.kind != Kind::TIMER || obj.dueMs == 0 || !obj.timerCallback) continue;
+        if (obj.dueMs > targetMs) continue;
+        if (bestId == 0 || obj.dueMs < bestDue) {
+            bestId = id;
+            bestDue = obj.dueMs;
+        }
+    }
+    if (bestId == 0) return false;
+
+    if (bestDue > nowMs_) nowMs_ = bestDue;
+    ArmWaitableTimers();
+
+    Object& timer = objects_[bestId];
+    TimerCallback cb = timer.timerCallback;
+    PVOID ctx = timer.context;
+    if (timer.periodMs > 0) {
+        timer.dueMs += timer.periodMs;
+    } else {
+        timer.dueMs = 0;   // one-shot: handle stays valid until DeleteTimer
+    }
+    counters_.timerFired++;
+
+    lock.unlock();
+    cb(ctx, TRUE);
+    lock.lock();
+    return true;
+}
+
+void FakePlatform::ArmWaitableTimers() {
+    for (auto& [id, obj] : objects_) {
+        if (obj.kind != Kind::WAITABLE_TIMER || obj.dueMs == 0) continue;
+        if (obj.dueMs > nowMs_) continue;
+        obj.signaled = true;   // coalesces missed periods like a real waitable timer
+        if (obj.periodMs > 0) {
+            while (obj.dueMs <= nowMs_) obj.dueMs += obj.periodMs;
+        } else {
+            obj.dueMs = 0;
+        }
+    }
+}
+
+ULONGLONG FakePlatform::NextDueTime() const {
+    Lock lock(mu_);
+    ULONGLONG next = 0;
+    for (const auto& [id, obj] : objects_) {
+        bool scheduled = (obj.kind == Kind::TIMER && obj.timerCallback && obj.dueMs != 0) ||
+                         (obj.kind == Kind::WAITABLE_TIMER && obj.dueMs != 0);
+        if (scheduled && (next == 0 || obj.dueMs < next)) next = obj.dueMs;
+    }
+    return next;
+}
+
+// ============================================================================
+// Introspection
+// ============================================================================
+
+FakeCallCounters FakePlatform::Counters() const {
+    Lock lock(mu_);
+    return counters_;
+}
+
+void FakePlatform::ResetCounters() {
+    Lock lock(mu_);
+    counters_ = FakeCallCounters{};
+}
+
+size_t FakePlatform::OpenProcessHandleCount() const {
+    Lock lock(mu_);
+    return static_cast<size_t>(std::count_if(objects_.begin(), objects_.end(),
+        [](const auto& kv) { return kv.second.kind == Kind::PROCESS; }));
+}
+
+size_t FakePlatform::ActiveTimerCount() const {
+    Lock lock(mu_);
+    return static_cast<size_t>(std::count_if(objects_.begin(), objects_.end(),
+        [](const auto& kv) { return kv.second.kind == Kind::TIMER; }));
+}
+
+size_t FakePlatform::ActiveWaitCount() const {
+    Lock lock(mu_);
+    return static_cast<size_t>(std::count_if(objects_.begin(), objects_.end(),
+        [](const auto& kv) { return kv.second.kind == Kind::WAIT; }));
+}
+
+size_t FakePlatform::JobCount() const {
+    Lock lock(mu_);
+    return static_cast<size_t>(std::count_if(objects_.begin(), objects_.end(),
+        [](const auto& kv) { return kv.second.kind == Kind::JOB; }));
+}
+
+std::set<std::wstring> FakePlatform::AppliedPolicyPaths() const {
+    Lock lock(mu_);
+    std::set<std::wstring> out;
+    for (const auto& [path, name] : appliedPolicies_) out.insert(path);
+    return out;
+}
+
+std::set<std::wstring> FakePlatform::IfeoNames() const {
+    Lock lock(mu_);
+    return ifeoNames_;
+}
+
+// ============================================================================
+// IProcessControl
+// ============================================================================
+
+NativeHandle FakePlatform::OpenProcessHandle(DWORD pid, bool checkAccess) {
+    Lock lock(mu_);
+    counters_.openProcess++;
+    auto it = processes_.find(pid);
+    if (it == processes_.end() || !it->second.alive) {
+        counters_.openProcessFailed++;
+        SetError(ERROR_INVALID_PARAMETER);
+        return nullptr;
+    }
+    if (checkAccess && it->second.accessDenied) {
+        counters_.openProcessFailed++;
+        SetError(ERROR_ACCESS_DENIED);
+        return nullptr;
+    }
+    Object obj;
+    obj.kind = Kind::PROCESS;
+    obj.pid = pid;
+    return NewObject(obj);
+}
+
+NativeHandle FakePlatform::OpenControl(DWORD pid) {
+    return OpenProcessHandle(pid, true);
+}
+
+NativeHandle FakePlatform::OpenQuery(DWORD pid) {
+    return OpenProcessHandle(pid, true);
+}
+
+NativeHandle FakePlatform::OpenSynchronize(DWORD pid) {
+    return OpenProcessHandle(pid, false);
+}
+
+void FakePlatform::CloseHandle(NativeHandle h) {
+    Lock lock(mu_);
+    counters_.closeHandle++;
+    objects_.erase(Key(h));
+}
+
+DWORD FakePlatform::LastError() {
+    Lock lock(mu_);
+    return lastError_;
+}
+
+bool FakePlatform::QueryExitCode(NativeHandle process, DWORD& exitCode) {
+    Lock lock(mu_);
+    counters_.queryExitCode++;
+    FakeProcess* p = ProcessFor(process);
+    if (!p) {
+        SetError(ERROR_INVALID_HANDLE);
+        return false;
+    }
+    exitCode = p->alive ? STILL_ACTIVE : p->exitCode;
+    return true;
+}
+
+std::wstring FakePlatform::QueryImageName(NativeHandle process) {
+    Lock lock(mu_);
+    counters_.queryImage++;
+    FakeProcess* p = ProcessFor(process);
+    if (!p || !p->alive) {
+        SetError(ERROR_GEN_FAILURE);
+        return L"";
+    }
+    return p->imagePath;
+}
+
+std::wstring FakePlatform::ResolveImagePath(NativeHandle process) {
+    std::wstring raw = QueryImageName(process);
+    return raw.empty() ? raw : unleaf::CanonicalizePath(raw);
+}
+
+bool FakePlatform::FileExists(const std::wstring& path) {
+    Lock lock(mu_);
+    return files_.count(path) > 0;
+}
+
+bool FakePlatform::SetPriorityClass(NativeHandle process, DWORD priorityClass) {
+    RunProcessCallHook();
+    Lock lock(mu_);
+    counters_.setPriority++;
+    FakeProcess* p = ProcessFor(process);
+    if (!p || !p->alive) {
+        SetError(ERROR_INVALID_PARAMETER);
+        return false;
+    }
+    if (priorityClass != PROCESS_MODE_BACKGROUND_END &&
+        priorityClass != PROCESS_MODE_BACKGROUND_BEGIN) {
+        p->priorityClass = priorityClass;
+    }
+    return true;
+}
+
+bool FakePlatform::SupportsFullEcoQoS() const {
+    Lock lock(mu_);
+    return supportsFullEcoQoS_;
+}
+
+EcoQoSResult FakePlatform::SetEcoQoSOff(NativeHandle process, ULONG controlMask,
+                                        bool preferNtApi) {
+    (void)controlMask;
+    RunProcessCallHook();
+    Lock lock(mu_);
+    counters_.setEcoQoS++;
+    EcoQoSResult result;
+    result.usedNtApi = preferNtApi;
+    FakeProcess* p = ProcessFor(process);
+    if (!p || !p->alive) {
+        result.ntFallback = preferNtApi;
+        result.error = ERROR_INVALID_PARAMETER;
+        SetError(result.error);
+        return result;
+    }
+    if (p->ecoLocked) {
+        result.ntFallback = preferNtApi;
+        result.error = ERROR_ACCESS_DENIED;
+        SetError(result.error);
+        return result;
+    }
+    p->ecoQoS = false;
+    result.success = true;
+    return result;
+}
+
+bool FakePlatform::IsEcoQoSEnabled(NativeHandle process) {
+    RunProcessCallHook();
+    Lock lock(mu_);
+    counters_.queryEcoQoS++;
+    FakeProcess* p = ProcessFor(process);
+    return p && p->alive && p->ecoQoS;
+}
+
+int FakePlatform::DisableThreadThrottling(DWORD pid, bool aggressive) {
+    (void)aggressive;
+    RunProcessCallHook();
+    Lock lock(mu_);
+    if (pid == 0) return 0;
+    counters_.threadWalks++;
+    auto it = processes_.find(pid);
+    if (it == processes_.end() || !it->second.alive) return 0;
+    counters_.threadsTouched += static_cast<uint64_t>(it->second.threadCount);
+    return it->second.threadCount;
+}
+
+int FakePlatform::DisableThreadThrottling(DWORD pid, const uint32_t* threadIds, size_t count,
+                                          bool aggressive) {
+    (void)aggressive;
+    RunProcessCallHook();
+    Lock lock(mu_);
+    if (pid == 0) return 0;
+    auto it = processes_.find(pid);
+    if (it == processes_.end() || !it->second.alive) return 0;
+    // No walk: only the listed threads that still exist
+    int touched = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t index = threadIds[i] - (pid << 8) - 1;
+        if (index < static_cast<uint32_t>(it->second.threadCount)) ++touched;
+    }
+    counters_.threadsTouched += static_cast<uint64_t>(touched);
+    return touched;
+}
+
+bool FakePlatform::RegisterExitWait(NativeHandle* outWait, NativeHandle process,
+                                    WaitCallback callback, PVOID context) {
+    Lock lock(mu_);
+    *outWait = nullptr;
+    counters_.registerWait++;
+    Object* procObj = Find(process);
+    if (!procObj || procObj->kind != Kind::PROCESS) {
+        SetError(ERROR_INVALID_HANDLE);
+        return false;
+    }
+    DWORD pid = procObj->pid;
+
+    Object obj;
+    obj.kind = Kind::WAIT;
+    obj.pid = pid;
+    obj.waitCallback = callback;
+    obj.context = context;
+    *outWait = NewObject(obj);
+
+    // Already-signaled process handle: the threadpool fires immediately
+    auto it = processes_.find(pid);
+    if (it == processes_.end() || !it->second.alive) {
+        FireExitWaits(lock, pid);
+    }
+    return true;
+}
+
+bool FakePlatform::UnregisterExitWait(NativeHandle wait) {
+    Lock lock(mu_);
+    counters_.unregisterWait++;
+    auto it = objects_.find(Key(wait));
+    if (it == objects_.end() || it->second.kind != Kind::WAIT) {
+        SetError(ERROR_INVALID_HANDLE);
+        return false;
+    }
+    objects_.erase(it);
+    return true;
+}
+
+JobAssignResult FakePlatform::AssignToNewJob(NativeHandle process, NativeHandle* outJob) {
+    Lock lock(mu_);
+    *outJob = nullptr;
+    counters_.jobAssign++;
+    FakeProcess* p = ProcessFor(process);
+    if (!p || !p->alive) {
+        SetError(ERROR_INVALID_PARAMETER);
+        return JobAssignResult::ASSIGN_FAILED;
+    }
+    if (p->foreignJob || p->job != 0) {
+        return JobAssignResult::ALREADY_IN_JOB;
+    }
+    Object obj;
+    obj.kind = Kind::JOB;
+    NativeHandle job = NewObject(obj);
+    p->job = Key(job);
+    *outJob = job;
+    return JobAssignResult::ASSIGNED;
+}
+
+bool FakePlatform::QueryJobProcessIds(NativeHandle job, DWORD* pids, DWORD capacity,
+                                      DWORD* count) {
+    Lock lock(mu_);
+    counters_.jobQuery++;
+    *count = 0;
+    const Object* obj = Find(job);
+    if (!obj || obj->kind != Kind::JOB) {
+        SetError(ERROR_INVALID_HANDLE);
+        return false;
+    }
+    for (const auto& [pid, p] : processes_) {
+        if (*count >= capacity) break;
+        if (p.alive && p.job == Key(job)) {
+            pids[(*count)++] = pid;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// ISystemSnapshot
+// ============================================================================
+
+bool FakePlatform::Capture(engine_logic::SystemSnapshot& out) {
+    Lock lock(mu_);
+    counters_.snapshots++;
+    out.Clear();
+    if (snapshotFails_) return false;
+    for (const auto& [pid, p] : processes_) {
+        if (!p.alive) continue;
+        out.AddProcess(pid, p.parentPid, p.name, p.createTime);
+        for (int i = 0; i < p.threadCount; ++i) out.AddThread(ThreadIdOf(pid, i));
+    }
+    out.Finish();
+    return true;
+}
+
+void FakePlatform::QuerySelfUsage(SelfUsage& out) {
+    Lock lock(mu_);
+    out = SelfUsage{};
+    out.pid = 1;
+    out.handleCount = static_cast<DWORD>(objects_.size());
+}
+
+// ============================================================================
+// ITimerService
+// ============================================================================
+
+NativeHandle FakePlatform::CreateQueue() {
+    Lock lock(mu_);
+    Object obj;
+    obj.kind = Kind::TIMER_QUEUE;
+    return NewObject(obj);
+}
+
+bool FakePlatform::DeleteQueue(NativeHandle queue, bool waitForCallbacks) {
+    (void)waitForCallbacks;
+    Lock lock(mu_);
+    auto it = objects_.find(Key(queue));
+    if (it == objects_.end() || it->second.kind != Kind::TIMER_QUEUE) {
+        SetError(ERROR_INVALID_HANDLE);
+        return false;
+    }
+    for (auto t = objects_.begin(); t != objects_.end(); ) {
+        if (t->second.kind == Kind::TIMER && t->second.queue == Key(queue)) {
+            t = objects_.erase(t);
+        } else {
+            ++t;
+        }
+    }
+    objects_.erase(Key(queue));
+    return true;
+}
+
+bool FakePlatform::CreateTimer(NativeHandle* outTimer, NativeHandle queue,
+                               TimerCallback callback, PVOID context,
+                               DWORD dueTimeMs, DWORD periodMs) {
+    Lock lock(mu_);
+    *outTimer = nullptr;
+    counters_.createTimer++;
+    const Object* q = Find(queue);
+    if (!q || q->kind != Kind::TIMER_QUEUE) {
+        SetError(ERROR_INVALID_HANDLE);
+        return false;
+    }
+    if (createTimerFails_) {
+        SetError(ERROR_NOT_ENOUGH_MEMORY);
+        return false;
+    }
+    Object obj;
+    obj.kind = Kind::TIMER;
+    obj.queue = Key(queue);
+    obj.timerCallback = callback;
+    obj.context = context;
+    obj.dueMs = nowMs_ + dueTimeMs;
+    obj.periodMs = periodMs;
+    *outTimer = NewObject(obj);
+    return true;
+}
+
+bool FakePlatform::DeleteTimer(NativeHandle queue, NativeHandle timer, bool waitForCallbacks) {
+    (void)queue;
+    (void)waitForCallbacks;
+    Lock lock(mu_);
+    counters_.deleteTimer++;
+    auto it = objects_.find(Key(timer));
+    if (it == objects_.end() || it->second.kind != Kind::TIMER) {
+        SetError(ERROR_INVALID_HANDLE);
+        return false;
+    }
+    objects_.erase(it);
+    return true;
+}
+
+// ============================================================================
+// IClock
+// ============================================================================
+
+ULONGLONG FakePlatform::NowMs() {
+    Lock lock(mu_);
+    return nowMs_;
+}
+
+ULONGLONG FakePlatform::NowUs() {
+    Lock lock(mu_);
+    return nowMs_ * 1000ULL;
+}
+
+void FakePlatform::SleepMs(DWORD ms) {
+    AdvanceTime(ms);
+}
+
+// ============================================================================
+// IEventService
+// ============================================================================
+
+NativeHandle FakePlatform::CreateEventObject(bool manualReset) {
+    Lock lock(mu_);
+    Object obj;
+    obj.kind = Kind::EVENT;
+    obj.manualReset = manualReset;
+    return NewObject(obj);
+}
+
+bool FakePlatform::SetEvent(NativeHandle event) {
+    Lock lock(mu_);
+    counters_.setEvent++;
+    Object* obj = Find(event);
+    if (!obj || obj->kind != Kind::EVENT) {
+        SetError(ERROR_INVALID_HANDLE);
+        return false;
+    }
+    obj->signaled = true;
+    cv_.notify_all();
+    return true;
+}
+
+bool FakePlatform::ResetEvent(NativeHandle event) {
+    Lock lock(mu_);
+    Object* obj = Find(event);
+    if (!obj || obj->kind != Kind::EVENT) {
+        SetError(ERROR_INVALID_HANDLE);
+        return false;
+    }
+    obj->signaled = false;
+    return true;
+}
+
+NativeHandle FakePlatform::CreatePeriodicTimer() {
+    Lock lock(mu_);
+    Object obj;
+    obj.kind = Kind::WAITABLE_TIMER;
+    return NewObject(obj);
+}
+
+bool FakePlatform::ArmPeriodicTimer(NativeHandle timer, DWORD dueMs, DWORD periodMs) {
+    Lock lock(mu_);
+    Object* obj = Find(timer);
+    if (!obj || obj->kind != Kind::WAITABLE_TIMER) {
+        SetError(ERROR_INVALID_HANDLE);
+        return false;
+    }
+    obj->signaled = false;
+    obj->dueMs = nowMs_ + dueMs;
+    obj->periodMs = periodMs;
+    return true;
+}
+
+NativeHandle FakePlatform::WatchDirectory(const std::wstring& directory, const std::wstring& fileName) {
+    Lock lock(mu_);
+    Object obj;
+    obj.kind = Kind::DIR_WATCH;
+    obj.directory = directory;
+    obj.fileName = fileName;
+    return NewObject(obj);
+}
+
+bool FakePlatform::RearmDirectoryWatch(NativeHandle watch) {
+    Lock lock(mu_);
+    Object* obj = Find(watch);
+    if (!obj || obj->kind != Kind::DIR_WATCH) {
+        SetError(ERROR_INVALID_HANDLE);
+        return false;
+    }
+    obj->signaled = false;
+    return true;
+}
+
+void FakePlatform::CloseDirectoryWatch(NativeHandle watch) {
+    Lock lock(mu_);
+    objects_.erase(Key(watch));
+}
+
+DWORD FakePlatform::WaitAny(const NativeHandle* handles, DWORD count, DWORD timeoutMs) {
+    Lock lock(mu_);
+    counters_.waitAny++;
+    const ULONGLONG deadline = nowMs_ + timeoutMs;
+
+    for (;;) {
+        for (DWORD i = 0; i < count; ++i) {
+            Object* obj = Find(handles[i]);
+            if (!obj) {
+                SetError(ERROR_INVALID_HANDLE);
+                return WAIT_FAILED;
+            }
+            if (!obj->signaled) continue;
+            // Auto-reset objects are consumed by the satisfied wait
+            if ((obj->kind == Kind::EVENT && !obj->manualReset) ||
+                obj->kind == Kind::WAITABLE_TIMER) {
+                obj->signaled = false;
+            }
+            counters_.wakeups++;
+            return WAIT_OBJECT_0 + i;
+        }
+
+        if (timeoutMs == 0) return WAIT_TIMEOUT;
+
+        if (timeoutMs == INFINITE) {
+            cv_.wait(lock);
+            continue;
+        }
+
+        ULONGLONG next = 0;
+        for (const auto& [id, obj] : objects_) {
+            bool scheduled = (obj.kind == Kind::TIMER && obj.timerCallback && obj.dueMs != 0) ||
+                             (obj.kind == Kind::WAITABLE_TIMER && obj.dueMs != 0);
+            if (scheduled && (next == 0 || obj.dueMs < next)) next = obj.dueMs;
+        }
+        if (next != 0 && next <= deadline) {
+            if (!FireNextTimer(lock, next)) {
+                nowMs_ = std::max(nowMs_, next);
+                ArmWaitableTimers();
+            }
+            continue;
+        }
+
+        nowMs_ = std::max(nowMs_, deadline);
+        ArmWaitableTimers();
+        return WAIT_TIMEOUT;
+    }
+}
+
+// ============================================================================
+// IProcessEventSource
+// ============================================================================
+
+bool FakePlatform::Start(ProcessStartCallback processCallback,
+                         ThreadStartCallback threadCallback) {
+    Lock lock(mu_);
+    if (!monitorStartResult_) {
+        monitorRunning_ = false;
+        return false;
+    }
+    processCallback_ = std::move(processCallback);
+    threadCallback_ = std::move(threadCallback);
+    monitorRunning_ = true;
+    eventCount_ = 0;        // ProcessMonitor::Start resets its counters
+    lastEventTime_ = 0;
+    threadFiltered_.Reset();
+    threadForwarded_.Reset();
+    return true;
+}
+
+void FakePlatform::Stop() {
+    ProcessStartCallback oldProcess;
+    ThreadStartCallback oldThread;
+    {
+        Lock lock(mu_);
+        monitorRunning_ = false;
+        pendingStarts_.Clear();   // undelivered batch is dropped, like ETW's teardown drain
+        batchOpen_ = false;
+        oldProcess = std::move(processCallback_);
+        oldThread = std::move(threadCallback_);
+        processCallback_ = nullptr;
+        threadCallback_ = nullptr;
+    }
+}
+
+bool FakePlatform::IsHealthy() const {
+    Lock lock(mu_);
+    return monitorRunning_ && monitorHealthy_;
+}
+
+uint32_t FakePlatform::GetEventCount() const {
+    Lock lock(mu_);
+    return eventCount_;
+}
+
+uint32_t FakePlatform::GetLostEventCount() const {
+    Lock lock(mu_);
+    return lostEventCount_;
+}
+
+ULONGLONG FakePlatform::GetLastEventTime() const {
+    Lock lock(mu_);
+    return lastEventTime_;
+}
+
+bool FakePlatform::SetEventTraceFile(const std::wstring& path) {
+    Lock lock(mu_);
+    traceWriter_.Close();
+    if (path.empty()) return true;
+    return traceWriter_.Open(std::filesystem::path(path));
+}
+
+void FakePlatform::SetThreadEventFilter(const engine_logic::PidBitmap* filter) {
+    Lock lock(mu_);
+    threadFilter_ = filter;
+}
+
+bool FakePlatform::SetProcessExitCallback(ProcessExitCallback callback) {
+    Lock lock(mu_);
+    if (!monitorReportsExits_) return false;
+    exitCallback_ = std::move(callback);
+    return true;
+}
+
+ThreadEventFilterStats FakePlatform::GetThreadEventFilterStats() const {
+    Lock lock(mu_);
+    ThreadEventFilterStats stats;
+    stats.filtered = threadFiltered_.Total();
+    stats.forwarded = threadForwarded_.Total();
+    stats.filteredPerSec = threadFiltered_.LastSecond(nowMs_);
+    stats.forwardedPerSec = threadForwarded_.LastSecond(nowMs_);
+    return stats;
+}
+
+// ============================================================================
+// IPolicyStore
+// ============================================================================
+
+bool FakePlatform::Initialize(const std::wstring& baseDir) {
+    (void)baseDir;
+    return true;
+}
+
+bool FakePlatform::ApplyPolicy(const std::wstring& exeName, const std::wstring& fullPath) {
+    Lock lock(mu_);
+    counters_.policyApply++;
+    ifeoNames_.insert(exeName);
+    if (!fullPath.empty()) appliedPolicies_[fullPath] = exeName;
+    return true;
+}
+
+bool FakePlatform::ApplyIFEOOnly(const std::wstring& exeName) {
+    Lock lock(mu_);
+    ifeoNames_.insert(exeName);
+    return true;
+}
+
+void FakePlatform::ReconcileWithConfig(const std::set<std::wstring>& targetNames,
+                                       const std::set<std::wstring>& targetPaths) {
+    Lock lock(mu_);
+    for (auto it = ifeoNames_.begin(); it != ifeoNames_.end(); ) {
+        it = targetNames.count(*it) ? std::next(it) : ifeoNames_.erase(it);
+    }
+    for (auto it = appliedPolicies_.begin(); it != appliedPolicies_.end(); ) {
+        bool keep = targetPaths.count(it->first) > 0 || targetNames.count(it->second) > 0;
+        it = keep ? std::next(it) : appliedPolicies_.erase(it);
+    }
+}
+
+void FakePlatform::CleanupAllPolicies() {
+    Lock lock(mu_);
+    appliedPolicies_.clear();
+    ifeoNames_.clear();
+}
+
+bool FakePlatform::IsPolicyValid(const std::wstring& canonPath) const {
+    return HasPolicy(canonPath);
+}
+
+bool FakePlatform::HasPolicy(const std::wstring& canonPath) const {
+    Lock lock(mu_);
+    return appliedPolicies_.count(canonPath) > 0;
+}
+
+bool FakePlatform::ConsumePendingOverflowFlag() {
+    Lock lock(mu_);
+    return std::exchange(pendingOverflow_, false);
+}
+
+} // namespace platform
+} // namespace unleaf
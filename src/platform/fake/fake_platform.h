@@ -0,0 +1,323 @@
+#pragma once
+// UnLeaf - In-memory fake of the OS abstraction layer
+// 全インターフェースを 1 クラスで実装する決定的なテスト用バックエンド。
+//   - 仮想時計: AdvanceTime() / WaitAny() でのみ進む (実時間に依存しない)
+//   - プロセス表: SpawnProcess() / TerminateProcess() で状態遷移を注入
+//   - カーネル呼び出しカウンタ: FakeCallCounters (テスト・シミュレータで参照)
+// Linux / Windows どちらでもビルドされる (OS API 呼び出しなし)。
+
+#include "../platform.h"
+#include "../../engine/event_trace.h"
+#include "../../engine/pid_bitmap.h"
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace unleaf {
+namespace platform {
+
+// Kernel-call counters (one field per IProcessControl / ITimerService / IEventService entry)
+struct FakeCallCounters {
+    uint64_t openProcess = 0;
+    uint64_t openProcessFailed = 0;
+    uint64_t closeHandle = 0;
+    uint64_t queryExitCode = 0;
+    uint64_t queryImage = 0;
+    uint64_t setPriority = 0;
+    uint64_t setEcoQoS = 0;
+    uint64_t queryEcoQoS = 0;
+    uint64_t threadWalks = 0;        // per-process thread walks (Toolhelp TH32CS_SNAPTHREAD on Windows)
+    uint64_t threadsTouched = 0;
+    uint64_t registerWait = 0;
+    uint64_t unregisterWait = 0;
+    uint64_t jobAssign = 0;
+    uint64_t jobQuery = 0;
+    uint64_t createTimer = 0;
+    uint64_t deleteTimer = 0;
+    uint64_t timerFired = 0;
+    uint64_t snapshots = 0;
+    uint64_t setEvent = 0;
+    uint64_t waitAny = 0;
+    uint64_t wakeups = 0;       // WaitAny calls that returned WAIT_OBJECT_0+i
+    uint64_t policyApply = 0;
+
+    // Calls that cross into the kernel on Windows (used for per-scenario budgets)
+    uint64_t KernelCalls() const {
+        return openProcess + closeHandle + queryExitCode + queryImage + setPriority +
+               setEcoQoS + queryEcoQoS + threadWalks + registerWait + unregisterWait +
+               jobAssign + jobQuery + createTimer + deleteTimer + snapshots + setEvent;
+    }
+};
+
+// Simulated process row
+struct FakeProcess {
+    DWORD pid = 0;
+    DWORD parentPid = 0;
+    std::wstring name;           // exe file name as the OS reports it
+    std::wstring imagePath;      // raw image path (QueryImageName)
+    bool  alive = true;
+    DWORD exitCode = STILL_ACTIVE;
+    DWORD priorityClass = NORMAL_PRIORITY_CLASS;
+    bool  ecoQoS = false;        // current EcoQoS (power throttling) state
+    bool  accessDenied = false;  // OpenControl fails with ERROR_ACCESS_DENIED
+    bool  ecoLocked = false;     // SetEcoQoSOff fails with ERROR_ACCESS_DENIED
+    bool  foreignJob = false;    // already inside a job we did not create
+    int   threadCount = 1;           // thread ids: FakePlatform::ThreadIdOf(pid, 0..threadCount-1)
+    uint64_t createTime = 0;     // distinct per SpawnProcess (a reused PID gets a new value)
+    uintptr_t job = 0;           // owning job object id (0 = none)
+};
+
+class FakePlatform final
+    : public IProcessControl
+    , public ISystemSnapshot
+    , public ITimerService
+    , public IClock
+    , public IEventService
+    , public IProcessEventSource
+    , public IPolicyStore {
+public:
+    static constexpr ULONGLONG INITIAL_TIME_MS = 1000000;
+
+    FakePlatform();
+    ~FakePlatform() override = default;
+    FakePlatform(const FakePlatform&) = delete;
+    FakePlatform& operator=(const FakePlatform&) = delete;
+
+    Platform& AsPlatform() { return platform_; }
+
+    // === Scenario control ===
+    void SpawnProcess(DWORD pid, DWORD parentPid, const std::wstring& name,
+                      const std::wstring& imagePath = L"");
+    // Marks the process exited and fires registered exit waits (outside the lock)
+    void TerminateProcess(DWORD pid, DWORD exitCode = 0);
+    void SetEcoQoS(DWORD pid, bool enabled);
+    void SetAccessDenied(DWORD pid, bool denied);
+    void SetEcoLocked(DWORD pid, bool locked);
+    void SetForeignJob(DWORD pid, bool inJob);
+    void SetThreadCount(DWORD pid, int threads);
+    // Thread ids the fake reports in snapshots (§9.38)
+    static uint32_t ThreadIdOf(DWORD pid, int index) { return (pid << 8) + static_cast<uint32_t>(index) + 1; }
+    bool GetProcess(DWORD pid, FakeProcess& out) const;
+    void AddFile(const std::wstring& canonPath);
+
+    // Write to dir\fileName: signals the watches on dir scoped to that file (§9.34)
+    void TouchFile(const std::wstring& dir, const std::wstring& fileName);
+
+    // Monitor event injection (delivered only while Start()ed)
+    // ProcessStart carries one image string like ETW: imagePath when given (imageName is
+    // expected to be its tail), otherwise imageName.
+    void EmitProcessStart(DWORD pid, DWORD parentPid,
+                          const std::wstring& imageName, const std::wstring& imagePath = L"");
+    // §9.29: ProcessStarts emitted between Begin/End reach the callback as one batch
+    // (one ETW buffer). Outside a batch every ProcessStart is delivered on its own.
+    void BeginEventBatch();
+    void EndEventBatch();
+    void EmitThreadStart(DWORD threadId, DWORD ownerPid);
+    // Spawn + EmitProcessStart
+    void LaunchProcess(DWORD pid, DWORD parentPid, const std::wstring& name,
+                       const std::wstring& imagePath = L"");
+    void AddLostEvents(uint32_t count);
+    void SetMonitorHealthy(bool healthy);
+    void SetMonitorStartResult(bool ok);
+    // §9.32: monitor delivers process exits (TerminateProcess emits one while Start()ed)
+    void SetMonitorReportsExits(bool reports);
+    bool IsMonitorRunning() const;
+
+    void SetSupportsFullEcoQoS(bool supported);
+    void SetSnapshotFails(bool fails);
+    void SetCreateTimerFails(bool fails);
+    void SetPendingOverflowFlag();
+
+    // Invoked (outside the fake's own lock) on entry to every EcoQoS / priority /
+    // thread-walk call: lets tests observe caller lock state and benchmarks model
+    // slow kernel I/O. Set before the engine starts; not synchronized.
+    void SetProcessCallHook(std::function<void()> hook);
+
+    // Advance the virtual clock, firing due timers / arming waitable timers in order
+    void AdvanceTime(ULONGLONG ms);
+    void AdvanceTimeTo(ULONGLONG targetMs);
+    // Earliest pending timer/waitable-timer due time (0 = nothing scheduled)
+    ULONGLONG NextDueTime() const;
+
+    FakeCallCounters Counters() const;
+    void ResetCounters();
+    size_t OpenProcessHandleCount() const;
+    size_t ActiveTimerCount() const;
+    size_t ActiveWaitCount() const;
+    size_t JobCount() const;
+    std::set<std::wstring> AppliedPolicyPaths() const;
+    std::set<std::wstring> IfeoNames() const;
+
+    // === IProcessControl ===
+    void Initialize() override {}
+    NativeHandle OpenControl(DWORD pid) override;
+    NativeHandle OpenQuery(DWORD pid) override;
+    NativeHandle OpenSynchronize(DWORD pid) override;
+    void CloseHandle(NativeHandle h) override;          // also IEventService::CloseHandle
+    DWORD LastError() override;                         // shared by all interfaces
+    bool QueryExitCode(NativeHandle process, DWORD& exitCode) override;
+    std::wstring QueryImageName(NativeHandle process) override;
+    std::wstring ResolveImagePath(NativeHandle process) override;
+    bool FileExists(const std::wstring& path) override;
+    bool SetPriorityClass(NativeHandle process, DWORD priorityClass) override;
+    bool SupportsFullEcoQoS() const override;
+    EcoQoSResult SetEcoQoSOff(NativeHandle process, ULONG controlMask, bool preferNtApi) override;
+    bool IsEcoQoSEnabled(NativeHandle process) override;
+    int DisableThreadThrottling(DWORD pid, bool aggressive) override;
+    int DisableThreadThrottling(DWORD pid, const uint32_t* threadIds, size_t count,
+                                bool aggressive) override;
+    bool RegisterExitWait(NativeHandle* outWait, NativeHandle process,
+                          WaitCallback callback, PVOID context) override;
+    bool UnregisterExitWait(NativeHandle wait) override;
+    JobAssignResult AssignToNewJob(NativeHandle process, NativeHandle* outJob) override;
+    bool QueryJobProcessIds(NativeHandle job, DWORD* pids, DWORD capacity,
+                            DWORD* count) override;
+    void OptimizeSelfHeap() override {}
+
+    // === ISystemSnapshot ===
+    bool Capture(engine_logic::SystemSnapshot& out) override;
+    void QuerySelfUsage(SelfUsage& out) override;
+
+    // === ITimerService ===
+    NativeHandle CreateQueue() override;
+    bool DeleteQueue(NativeHandle queue, bool waitForCallbacks) override;
+    bool CreateTimer(NativeHandle* outTimer, NativeHandle queue,
+                     TimerCallback callback, PVOID context,
+                     DWORD dueTimeMs, DWORD periodMs) override;
+    bool DeleteTimer(NativeHandle queue, NativeHandle timer, bool waitForCallbacks) override;
+
+    // === IClock ===
+    ULONGLONG NowMs() override;
+    ULONGLONG NowUs() override;
+    void SleepMs(DWORD ms) override;
+
+    // === IEventService ===
+    NativeHandle CreateEventObject(bool manualReset) override;
+    bool SetEvent(NativeHandle event) override;
+    bool ResetEvent(NativeHandle event) override;
+    NativeHandle CreatePeriodicTimer() override;
+    bool ArmPeriodicTimer(NativeHandle timer, DWORD dueMs, DWORD periodMs) override;
+    NativeHandle WatchDirectory(const std::wstring& directory, const std::wstring& fileName) override;
+    bool RearmDirectoryWatch(NativeHandle watch) override;
+    void CloseDirectoryWatch(NativeHandle watch) override;
+    // Finite timeout: virtual time auto-advances to the next due timer (or the deadline).
+    // INFINITE: blocks (real time) until another thread signals or advances time.
+    DWORD WaitAny(const NativeHandle* handles, DWORD count, DWORD timeoutMs) override;
+
+    // === IProcessEventSource ===
+    bool Start(ProcessStartCallback processCallback,
+               ThreadStartCallback threadCallback = nullptr) override;
+    void Stop() override;
+    bool IsHealthy() const override;
+    uint32_t GetEventCount() const override;
+    uint32_t GetLostEventCount() const override;
+    ULONGLONG GetLastEventTime() const override;
+    // Records with the virtual clock (NowMs * 1000) as the timestamp
+    bool SetEventTraceFile(const std::wstring& path) override;
+    // Per-second rates use the virtual clock
+    void SetThreadEventFilter(const engine_logic::PidBitmap* filter) override;
+    ThreadEventFilterStats GetThreadEventFilterStats() const override;
+    // false unless SetMonitorReportsExits(true)
+    bool SetProcessExitCallback(ProcessExitCallback callback) override;
+
+    // === IPolicyStore ===
+    bool Initialize(const std::wstring& baseDir) override;
+    bool ApplyPolicy(const std::wstring& exeName, const std::wstring& fullPath) override;
+    bool ApplyIFEOOnly(const std::wstring& exeName) override;
+    void ReconcileWithConfig(const std::set<std::wstring>& targetNames,
+                             const std::set<std::wstring>& targetPaths) override;
+    void CleanupAllPolicies() override;
+    void VerifyAndRepair() override {}
+    bool IsPolicyValid(const std::wstring& canonPath) const override;
+    bool HasPolicy(const std::wstring& canonPath) const override;
+    int32_t GetPendingQueueSize() const override { return 0; }
+    bool ConsumePendingOverflowFlag() override;
+
+private:
+    enum class Kind : uint8_t {
+        PROCESS, EVENT, WAITABLE_TIMER, DIR_WATCH, TIMER_QUEUE, TIMER, WAIT, JOB
+    };
+
+    struct Object {
+        Kind kind = Kind::EVENT;
+        DWORD pid = 0;               // PROCESS / WAIT
+        bool signaled = false;       // EVENT / WAITABLE_TIMER / DIR_WATCH
+        bool manualReset = false;    // EVENT
+        ULONGLONG dueMs = 0;         // TIMER / WAITABLE_TIMER (0 = disarmed)
+        DWORD periodMs = 0;          // TIMER / WAITABLE_TIMER
+        uintptr_t queue = 0;         // TIMER
+        TimerCallback timerCallback = nullptr;  // TIMER
+        WaitCallback waitCallback = nullptr;    // WAIT
+        PVOID context = nullptr;     // TIMER / WAIT
+        std::wstring directory;      // DIR_WATCH
+        std::wstring fileName;       // DIR_WATCH
+    };
+
+    using Lock = std::unique_lock<std::recursive_mutex>;
+
+    NativeHandle NewObject(const Object& obj);
+    Object* Find(NativeHandle h);
+    const Object* Find(NativeHandle h) const;
+    FakeProcess* ProcessFor(NativeHandle h);
+    NativeHandle OpenProcessHandle(DWORD pid, bool checkAccess);
+    // Fires the earliest due TIMER (<= targetMs); returns false when none is due
+    bool FireNextTimer(Lock& lock, ULONGLONG targetMs);
+    void ArmWaitableTimers();
+    void FireExitWaits(Lock& lock, DWORD pid);
+    void SetError(DWORD err) { lastError_ = err; }
+    void RunProcessCallHook() { if (processCallHook_) processCallHook_(); }
+    // Delivers pendingStarts_ (drops mu_ around the callback)
+    void FlushProcessStarts(Lock& lock);
+
+    mutable std::recursive_mutex mu_;
+    std::condition_variable_any cv_;
+
+    Platform platform_;
+
+    ULONGLONG nowMs_ = INITIAL_TIME_MS;
+    uintptr_t nextHandle_ = 0x100;
+    DWORD lastError_ = ERROR_SUCCESS;
+
+    std::map<uintptr_t, Object> objects_;
+    std::map<DWORD, FakeProcess> processes_;
+    std::set<std::wstring> files_;
+    FakeCallCounters counters_;
+
+    // Monitor
+    ProcessStartCallback processCallback_;
+    ThreadStartCallback threadCallback_;
+    bool monitorRunning_ = false;
+    bool monitorHealthy_ = true;
+    bool monitorStartResult_ = true;
+    uint32_t eventCount_ = 0;
+    uint32_t lostEventCount_ = 0;
+    ULONGLONG lastEventTime_ = 0;
+    engine_logic::EventTraceWriter traceWriter_;   // §9.27 (guarded by mu_)
+    engine_logic::ProcessStartBatch pendingStarts_;   // §9.29
+    engine_logic::ProcessStartBatch deliverStarts_;   // handed to the callback outside mu_
+    bool batchOpen_ = false;
+    bool delivering_ = false;                         // deliverStarts_ is in use
+    const engine_logic::PidBitmap* threadFilter_ = nullptr;   // §9.28
+    ProcessExitCallback exitCallback_;                         // §9.32
+    bool monitorReportsExits_ = false;
+    engine_logic::PerSecondCounter threadFiltered_;
+    engine_logic::PerSecondCounter threadForwarded_;
+
+    // Policy store
+    std::map<std::wstring, std::wstring> appliedPolicies_;   // canonPath -> exeName
+    std::set<std::wstring> ifeoNames_;
+    bool pendingOverflow_ = false;
+
+    bool supportsFullEcoQoS_ = true;
+    bool snapshotFails_ = false;
+    uint64_t nextCreateTime_ = 1;
+    bool createTimerFails_ = false;
+    std::function<void()> processCallHook_;
+};
+
+} // namespace platform
+} // namespace unleaf
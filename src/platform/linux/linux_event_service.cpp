@@ -0,0 +1,364 @@
+// UnLeaf - Linux implementation of IEventService (epoll / eventfd / timerfd / inotify)
+
+#ifdef __linux__
+
+#include "linux_event_service.h"
+#include "linux_process_control.h"
+#include "../../common/win_string_utils.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#include <poll.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace unleaf {
+namespace platform {
+
+namespace {
+
+thread_local DWORD t_lastError = ERROR_SUCCESS;
+
+void SetLastErrorFromErrno(int err) {
+    t_lastError = LinuxErrorToWin32(err);
+}
+
+ULONGLONG MonotonicMs() {
+    timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<ULONGLONG>(ts.tv_sec) * 1000ULL + static_cast<ULONGLONG>(ts.tv_nsec) / 1000000ULL;
+}
+
+// §9.34: a finished write (close) or an atomic replace (write temp + rename onto the file).
+// No IN_MODIFY: appends to a file held open (UnLeaf.log) queue nothing and wake no one.
+constexpr uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_ONLYDIR;
+
+} // namespace
+
+struct LinuxEventService::Waitable {
+    enum class Kind : uint8_t { EVENT, TIMER, WATCH };
+    Kind kind;
+    bool manualReset;
+    int fd;
+    std::string fileName = {};   // WATCH: the one file that signals
+    bool pending = false;   // WATCH: matching change seen, not yet re-armed (waiter thread)
+    bool gone = false;      // WATCH: IN_IGNORED seen (directory removed / unmounted)
+};
+
+LinuxEventService::LinuxEventService()
+    : epollFd_(::epoll_create1(EPOLL_CLOEXEC)) {}
+
+LinuxEventService::~LinuxEventService() {
+    if (epollFd_ >= 0) ::close(epollFd_);
+}
+
+// ---------------------------------------------------------------------------
+// Events (eventfd)
+// ---------------------------------------------------------------------------
+
+NativeHandle LinuxEventService::CreateEventObject(bool manualReset) {
+    int fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) {
+        SetLastErrorFromErrno(errno);
+        return nullptr;
+    }
+    return new Waitable{Waitable::Kind::EVENT, manualReset, fd};
+}
+
+bool LinuxEventService::SetEvent(NativeHandle event) {
+    auto* w = static_cast<Waitable*>(event);
+    if (!w || event == INVALID_HANDLE_VALUE || w->kind != Waitable::Kind::EVENT) {
+        t_lastError = ERROR_INVALID_HANDLE;
+        return false;
+    }
+    const uint64_t one = 1;
+    // EAGAIN = counter saturated: already signaled
+    if (::write(w->fd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        SetLastErrorFromErrno(errno);
+        return false;
+    }
+    return true;
+}
+
+bool LinuxEventService::ResetEvent(NativeHandle event) {
+    auto* w = static_cast<Waitable*>(event);
+    if (!w || event == INVALID_HANDLE_VALUE || w->kind != Waitable::Kind::EVENT) {
+        t_lastError = ERROR_INVALID_HANDLE;
+        return false;
+    }
+    uint64_t value;
+    if (::read(w->fd, &value, sizeof(value)) < 0 && errno != EAGAIN) {
+        SetLastErrorFromErrno(errno);
+        return false;
+    }
+    return true;
+}
+
+void LinuxEventService::CloseHandle(NativeHandle h) {
+    if (!h || h == INVALID_HANDLE_VALUE) return;
+    Release(static_cast<Waitable*>(h));
+}
+
+void LinuxEventService::Release(Waitable* w) {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (std::find(registered_.begin(), registered_.end(), w) != registered_.end()) {
+            // Next WaitAny sees a different list and rebuilds the interest set
+            ::epoll_ctl(epollFd_, EPOLL_CTL_DEL, w->fd, nullptr);
+            registered_.erase(std::remove(registered_.begin(), registered_.end(), w), registered_.end());
+        }
+    }
+    ::close(w->fd);
+    delete w;
+}
+
+// ---------------------------------------------------------------------------
+// Periodic timer (timerfd)
+// ---------------------------------------------------------------------------
+
+NativeHandle LinuxEventService::CreatePeriodicTimer() {
+    int fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0) {
+        SetLastErrorFromErrno(errno);
+        return nullptr;
+    }
+    return new Waitable{Waitable::Kind::TIMER, false, fd};
+}
+
+bool LinuxEventService::ArmPeriodicTimer(NativeHandle timer, DWORD dueMs, DWORD periodMs) {
+    auto* w = static_cast<Waitable*>(timer);
+    if (!w || timer == INVALID_HANDLE_VALUE || w->kind != Waitable::Kind::TIMER) {
+        t_lastError = ERROR_INVALID_HANDLE;
+        return false;
+    }
+    itimerspec spec{};
+    spec.it_value.tv_sec = dueMs / 1000;
+    spec.it_value.tv_nsec = static_cast<long>(dueMs % 1000) * 1000000L;
+    if (dueMs == 0) spec.it_value.tv_nsec = 1;   // zero would disarm: due now
+    spec.it_interval.tv_sec = periodMs / 1000;
+    spec.it_interval.tv_nsec = static_cast<long>(periodMs % 1000) * 1000000L;
+    // Re-arming clears pending expirations (SetWaitableTimer resets the signaled state)
+    if (::timerfd_settime(w->fd, 0, &spec, nullptr) != 0) {
+        SetLastErrorFromErrno(errno);
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Directory watch (inotify)
+// ---------------------------------------------------------------------------
+
+NativeHandle LinuxEventService::WatchDirectory(const std::wstring& directory, const std::wstring& fileName) {
+    std::wstring native = directory;
+    std::replace(native.begin(), native.end(), L'\\', L'/');
+    const std::string utf8 = WideToUtf8(native.c_str());
+
+    int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        SetLastErrorFromErrno(errno);
+        return INVALID_HANDLE_VALUE;
+    }
+    if (::inotify_add_watch(fd, utf8.c_str(), WATCH_MASK) < 0) {
+        SetLastErrorFromErrno(errno);
+        ::close(fd);
+        return INVALID_HANDLE_VALUE;
+    }
+    return new Waitable{Waitable::Kind::WATCH, true, fd, WideToUtf8(fileName.c_str())};
+}
+
+bool LinuxEventService::RearmDirectoryWatch(NativeHandle watch) {
+    auto* w = static_cast<Waitable*>(watch);
+    if (!w || watch == INVALID_HANDLE_VALUE || w->kind != Waitable::Kind::WATCH) {
+        t_lastError = ERROR_INVALID_HANDLE;
+        return false;
+    }
+    // Drop queued notifications; stays unsignaled until the next change
+    w->pending = false;
+    bool matched = false;
+    if (!DrainWatch(w, matched)) {
+        SetLastErrorFromErrno(errno);
+        return false;
+    }
+    if (w->gone) {
+        // Directory removed / unmounted: the watch is gone
+        t_lastError = ERROR_GEN_FAILURE;
+        return false;
+    }
+    return true;
+}
+
+void LinuxEventService::CloseDirectoryWatch(NativeHandle watch) {
+    if (!watch || watch == INVALID_HANDLE_VALUE) return;
+    Release(static_cast<Waitable*>(watch));
+}
+
+// ---------------------------------------------------------------------------
+// WaitAny (epoll)
+// ---------------------------------------------------------------------------
+
+bool LinuxEventService::SyncInterest(Waitable* const* waitables, DWORD count) {
+    if (registered_.size() == count && std::equal(registered_.begin(), registered_.end(), waitables)) {
+        return true;
+    }
+    for (Waitable* w : registered_) {
+        ::epoll_ctl(epollFd_, EPOLL_CTL_DEL, w->fd, nullptr);   // ENOENT for duplicates: harmless
+    }
+    registered_.clear();
+    rebuilds_.fetch_add(1, std::memory_order_relaxed);
+
+    for (DWORD i = 0; i < count; ++i) {
+        Waitable* w = waitables[i];
+        // Duplicates (e.g. stopEvent_ standing in for a closed watch) are registered once
+        if (std::find(registered_.begin(), registered_.end(), w) == registered_.end()) {
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.ptr = w;
+            if (::epoll_ctl(epollFd_, EPOLL_CTL_ADD, w->fd, &ev) != 0) {
+                SetLastErrorFromErrno(errno);
+                for (Waitable* added : registered_) {
+                    ::epoll_ctl(epollFd_, EPOLL_CTL_DEL, added->fd, nullptr);
+                }
+                registered_.clear();
+                return false;
+            }
+        }
+        registered_.push_back(w);
+    }
+    return true;
+}
+
+bool LinuxEventService::DrainWatch(Waitable* w, bool& matched) {
+    alignas(inotify_event) char buf[4096];
+    for (;;) {
+        const ssize_t n = ::read(w->fd, buf, sizeof(buf));
+        if (n < 0) {
+            if (errno == EAGAIN) return true;
+            if (errno == EINTR) continue;
+            return false;
+        }
+        for (ssize_t off = 0; off < n; ) {
+            const auto* ev = reinterpret_cast<const inotify_event*>(buf + off);
+            if (ev->mask & IN_IGNORED) w->gone = true;
+            // Queue overflow: the file may have been among the dropped events
+            if ((ev->mask & IN_Q_OVERFLOW) ||
+                (ev->len > 0 && ::strcasecmp(ev->name, w->fileName.c_str()) == 0)) {
+                matched = true;
+            }
+            off += static_cast<ssize_t>(sizeof(inotify_event) + ev->len);
+        }
+    }
+}
+
+bool LinuxEventService::TryConsume(Waitable* w, bool ready) {
+    switch (w->kind) {
+        case Waitable::Kind::EVENT:
+            if (w->manualReset) {
+                // Stays signaled until ResetEvent: confirm it was not reset since epoll_wait
+                pollfd p{w->fd, POLLIN, 0};
+                return ::poll(&p, 1, 0) == 1;
+            }
+            [[fallthrough]];
+        case Waitable::Kind::TIMER: {
+            // Auto-reset: one read clears every SetEvent / expiration since the last wakeup
+            uint64_t value;
+            return ::read(w->fd, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value));
+        }
+        case Waitable::Kind::WATCH:
+            if (ready) {
+                bool matched = false;
+                // Read errors and a vanished directory surface through RearmDirectoryWatch
+                if (!DrainWatch(w, matched) || matched || w->gone) w->pending = true;
+            }
+            return w->pending;   // cleared by RearmDirectoryWatch
+    }
+    return false;
+}
+
+DWORD LinuxEventService::WaitAny(const NativeHandle* handles, DWORD count, DWORD timeoutMs) {
+    waits_.fetch_add(1, std::memory_order_relaxed);
+    if (epollFd_ < 0) {
+        t_lastError = ERROR_INVALID_HANDLE;
+        return WAIT_FAILED;
+    }
+    if (!handles || count == 0 || count > MAX_WAIT_HANDLES) {
+        t_lastError = ERROR_INVALID_PARAMETER;
+        return WAIT_FAILED;
+    }
+    Waitable* waitables[MAX_WAIT_HANDLES];
+    for (DWORD i = 0; i < count; ++i) {
+        if (!handles[i] || handles[i] == INVALID_HANDLE_VALUE) {
+            t_lastError = ERROR_INVALID_HANDLE;
+            return WAIT_FAILED;
+        }
+        waitables[i] = static_cast<Waitable*>(handles[i]);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (!SyncInterest(waitables, count)) return WAIT_FAILED;
+    }
+
+    const bool infinite = (timeoutMs == INFINITE);
+    const ULONGLONG deadline = infinite ? 0 : MonotonicMs() + timeoutMs;
+    int waitMs = infinite ? -1 : static_cast<int>(std::min<DWORD>(timeoutMs, INT_MAX));
+    epoll_event ready[MAX_WAIT_HANDLES];
+
+    for (;;) {
+        // A watch already signaled (drained, not re-armed) has no readable fd: poll only
+        bool anyPending = false;
+        for (DWORD i = 0; i < count; ++i) anyPending |= waitables[i]->pending;
+
+        const int n = ::epoll_wait(epollFd_, ready, static_cast<int>(MAX_WAIT_HANDLES),
+                                   anyPending ? 0 : waitMs);
+        if (n < 0 && errno != EINTR) {
+            SetLastErrorFromErrno(errno);
+            return WAIT_FAILED;
+        }
+
+        // WaitForMultipleObjects: the lowest signaled index wins
+        for (DWORD i = 0; i < count && (n > 0 || anyPending); ++i) {
+            bool isReady = false;
+            for (int r = 0; r < n && !isReady; ++r) {
+                isReady = (ready[r].data.ptr == waitables[i]);
+            }
+            if ((isReady || waitables[i]->pending) && TryConsume(waitables[i], isReady)) {
+                signaled_.fetch_add(1, std::memory_order_relaxed);
+                return WAIT_OBJECT_0 + i;
+            }
+        }
+        if (n > 0) spurious_.fetch_add(1, std::memory_order_relaxed);
+
+        if (!infinite) {
+            const ULONGLONG now = MonotonicMs();
+            if (now >= deadline) {
+                timeouts_.fetch_add(1, std::memory_order_relaxed);
+                return WAIT_TIMEOUT;
+            }
+            waitMs = static_cast<int>(deadline - now);
+        }
+    }
+}
+
+DWORD LinuxEventService::LastError() {
+    return t_lastError;
+}
+
+LinuxEventStats LinuxEventService::GetStats() const {
+    LinuxEventStats stats;
+    stats.waits = waits_.load(std::memory_order_relaxed);
+    stats.signaled = signaled_.load(std::memory_order_relaxed);
+    stats.timeouts = timeouts_.load(std::memory_order_relaxed);
+    stats.spurious = spurious_.load(std::memory_order_relaxed);
+    stats.rebuilds = rebuilds_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace platform
+} // namespace unleaf
+
+#endif // __linux__
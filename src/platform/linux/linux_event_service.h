@@ -0,0 +1,92 @@
+#pragma once
+// UnLeaf - Linux implementation of IEventService (control loop reactor, §9.33)
+// EngineControlLoop の WaitForMultipleObjects を epoll で置き換える。ハンドルは fd を持つ小さな
+// 参照オブジェクトへのポインタで、Win32 の待機オブジェクトの意味論をそのまま写す。
+//
+//   Event (manual / auto-reset) : eventfd。auto-reset は WaitAny が返す時に read で消費
+//   Periodic timer              : timerfd (CLOCK_MONOTONIC)。溜まった満了回数は 1 回の wakeup
+//   Directory watch             : inotify (IN_CLOSE_WRITE | IN_MOVED_TO、サブツリーなし) をファイル名で
+//                                 絞り込む (§9.34)。開きっぱなしのログへの追記はイベント自体が出ない。
+//                                 FindNextChangeNotification と同じく Rearm まで signaled のまま
+//   WaitAny                     : epoll。signaled のうち最小インデックスを返す (WAIT_OBJECT_0+i)
+//
+// epoll の登録は前回の WaitAny と同じハンドル列なら再利用する (制御ループの定常状態では
+// epoll_wait + read の 2 syscall / wakeup)。WaitAny を同時に呼べるのは 1 スレッドのみ。
+// wakeup の理由はエンジン側の wakeup* カウンタがそのまま数える (Win32 と同じ値で比較できる)。
+
+#ifdef __linux__
+
+#include "../platform.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace unleaf {
+namespace platform {
+
+// WaitAny outcome counters (cumulative)
+struct LinuxEventStats {
+    uint64_t waits = 0;          // WaitAny calls
+    uint64_t signaled = 0;       // returned WAIT_OBJECT_0+i
+    uint64_t timeouts = 0;       // returned WAIT_TIMEOUT
+    uint64_t spurious = 0;       // epoll_wait returned but nothing was consumed (lost race /
+                                 // watch event for another file)
+    uint64_t rebuilds = 0;       // epoll interest set rebuilt (handle list changed)
+};
+
+class LinuxEventService : public IEventService {
+public:
+    LinuxEventService();
+    ~LinuxEventService() override;
+
+    LinuxEventService(const LinuxEventService&) = delete;
+    LinuxEventService& operator=(const LinuxEventService&) = delete;
+
+    NativeHandle CreateEventObject(bool manualReset) override;
+    bool SetEvent(NativeHandle event) override;
+    bool ResetEvent(NativeHandle event) override;
+    void CloseHandle(NativeHandle h) override;
+
+    NativeHandle CreatePeriodicTimer() override;
+    bool ArmPeriodicTimer(NativeHandle timer, DWORD dueMs, DWORD periodMs) override;
+
+    NativeHandle WatchDirectory(const std::wstring& directory, const std::wstring& fileName) override;
+    bool RearmDirectoryWatch(NativeHandle watch) override;
+    void CloseDirectoryWatch(NativeHandle watch) override;
+
+    DWORD WaitAny(const NativeHandle* handles, DWORD count, DWORD timeoutMs) override;
+    DWORD LastError() override;
+
+    LinuxEventStats GetStats() const;
+
+    static constexpr DWORD MAX_WAIT_HANDLES = 64;   // MAXIMUM_WAIT_OBJECTS
+
+private:
+    struct Waitable;
+
+    // epoll interest set = handles (deduplicated); reused when unchanged. Caller holds mu_.
+    bool SyncInterest(Waitable* const* waitables, DWORD count);
+    // Consumes the signal per object type; false = no longer signaled (another waiter took it,
+    // or only other files changed). ready = epoll reported the fd readable.
+    static bool TryConsume(Waitable* w, bool ready);
+    // Reads every queued inotify event; matched = one names the watched file (or overflow).
+    // IN_IGNORED marks the watch gone. false + errno on read failure.
+    static bool DrainWatch(Waitable* w, bool& matched);
+    void Release(Waitable* w);
+
+    int epollFd_ = -1;
+    std::mutex mu_;                       // registered_ (WaitAny setup / CloseHandle)
+    std::vector<Waitable*> registered_;   // handle list of the last WaitAny, in order
+
+    std::atomic<uint64_t> waits_{0};
+    std::atomic<uint64_t> signaled_{0};
+    std::atomic<uint64_t> timeouts_{0};
+    std::atomic<uint64_t> spurious_{0};
+    std::atomic<uint64_t> rebuilds_{0};
+};
+
+} // namespace platform
+} // namespace unleaf
+
+#endif // __linux__
@@ -0,0 +1,306 @@
+// UnLeaf - Linux timer queue / clock / policy store + NativePlatform()
+
+#ifdef __linux__
+
+#include "linux_platform.h"
+#include "linux_event_service.h"
+#include "linux_process_control.h"
+#include "linux_system_snapshot.h"
+#include "netlink_process_monitor.h"
+#include <cerrno>
+#include <ctime>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace unleaf {
+namespace platform {
+
+namespace {
+
+thread_local DWORD t_lastError = ERROR_SUCCESS;
+
+ULONGLONG MonotonicUs() {
+    timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<ULONGLONG>(ts.tv_sec) * 1000000ULL + static_cast<ULONGLONG>(ts.tv_nsec) / 1000ULL;
+}
+
+// Absolute CLOCK_MONOTONIC deadline; 0 = disarm
+void ArmAbsolute(int timerFd, ULONGLONG dueUs) {
+    itimerspec spec{};
+    if (dueUs != 0) {
+        spec.it_value.tv_sec = static_cast<time_t>(dueUs / 1000000ULL);
+        spec.it_value.tv_nsec = static_cast<long>((dueUs % 1000000ULL) * 1000ULL);
+    }
+    ::timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
+
+} // namespace
+
+// ============================================================================
+// LinuxTimerService
+// ============================================================================
+
+struct LinuxTimerService::Timer {
+    TimerCallback callback = nullptr;
+    PVOID context = nullptr;
+    DWORD periodMs = 0;
+    bool armed = false;                  // in Queue::schedule (slot valid)
+    bool deleted = false;                // DeleteTimer while its callback ran
+    bool waited = false;                 // ... and the deleting thread frees it
+    std::multimap<ULONGLONG, Timer*>::iterator slot;
+};
+
+struct LinuxTimerService::Queue {
+    int timerFd = -1;
+    int wakeFd = -1;
+    std::mutex mu;
+    std::condition_variable idle;              // running changed
+    std::multimap<ULONGLONG, Timer*> schedule;   // due (µs, CLOCK_MONOTONIC) -> timer
+    std::unordered_set<Timer*> timers;         // every live timer (armed or spent one-shot)
+    Timer* running = nullptr;
+    bool stopping = false;
+    bool selfDestroy = false;                  // DeleteQueue(false): the worker frees the queue
+    std::thread worker;
+};
+
+NativeHandle LinuxTimerService::CreateQueue() {
+    auto* q = new Queue();
+    q->timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    q->wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (q->timerFd < 0 || q->wakeFd < 0) {
+        t_lastError = LinuxErrorToWin32(errno);
+        Destroy(q);
+        return nullptr;
+    }
+    q->worker = std::thread(Run, q);
+    return q;
+}
+
+bool LinuxTimerService::DeleteQueue(NativeHandle queue, bool waitForCallbacks) {
+    auto* q = static_cast<Queue*>(queue);
+    if (!q) {
+        t_lastError = ERROR_INVALID_HANDLE;
+        return false;
+    }
+    // A callback deleting its own queue cannot join itself
+    bool join = waitForCallbacks && q->worker.get_id() != std::this_thread::get_id();
+    if (!join) q->worker.detach();
+    {
+        // Woken under the lock: a detached worker frees q as soon as it sees stopping
+        std::lock_guard<std::mutex> lock(q->mu);
+        q->stopping = true;
+        q->selfDestroy = !join;
+        Wake(q);
+    }
+    if (join) {
+        q->worker.join();
+        Destroy(q);
+    }
+    return true;
+}
+
+bool LinuxTimerService::CreateTimer(NativeHandle* outTimer, NativeHandle queue,
+                                    TimerCallback callback, PVOID context,
+                                    DWORD dueTimeMs, DWORD periodMs) {
+    auto* q = static_cast<Queue*>(queue);
+    if (!outTimer || !q || !callback) {
+        t_lastError = ERROR_INVALID_PARAMETER;
+        return false;
+    }
+    auto* t = new Timer();
+    t->callback = callback;
+    t->context = context;
+    t->periodMs = periodMs;
+    {
+        // Handle published under the lock: a callback that reads it (to delete itself) runs
+        // only after the worker re-takes mu
+        std::lock_guard<std::mutex> lock(q->mu);
+        *outTimer = t;
+        q->timers.insert(t);
+        t->slot = q->schedule.emplace(MonotonicUs() + dueTimeMs * 1000ULL, t);
+        t->armed = true;
+    }
+    Wake(q);
+    return true;
+}
+
+bool LinuxTimerService::DeleteTimer(NativeHandle queue, NativeHandle timer, bool waitForCallbacks) {
+    auto* q = static_cast<Queue*>(queue);
+    auto* t = static_cast<Timer*>(timer);
+    if (!q || !t) {
+        t_lastError = ERROR_INVALID_HANDLE;
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(q->mu);
+    if (!q->timers.erase(t)) {
+        t_lastError = ERROR_INVALID_HANDLE;
+        return false;
+    }
+    if (t->armed) {
+        q->schedule.erase(t->slot);
+        t->armed = false;
+    }
+    if (q->running != t) {
+        delete t;
+        return true;
+    }
+    // Callback in flight: never re-armed from here on
+    t->deleted = true;
+    if (waitForCallbacks && q->worker.get_id() != std::this_thread::get_id()) {
+        t->waited = true;
+        q->idle.wait(lock, [&] { return q->running != t; });
+        delete t;
+    }
+    // else the worker frees it when the callback returns
+    return true;
+}
+
+DWORD LinuxTimerService::LastError() {
+    return t_lastError;
+}
+
+void LinuxTimerService::Run(Queue* q) {
+    std::unique_lock<std::mutex> lock(q->mu);
+    while (!q->stopping) {
+        ULONGLONG now = MonotonicUs();
+        auto first = q->schedule.begin();
+        if (first != q->schedule.end() && first->first <= now) {
+            Timer* t = first->second;
+            q->schedule.erase(first);
+            t->armed = false;
+            q->running = t;
+            lock.unlock();
+            t->callback(t->context, TRUE);
+            lock.lock();
+            q->running = nullptr;
+            if (t->deleted) {
+                if (!t->waited) delete t;
+            } else if (t->periodMs != 0) {
+                // Fixed period from now: a late tick does not fire a catch-up burst
+                t->slot = q->schedule.emplace(MonotonicUs() + t->periodMs * 1000ULL, t);
+                t->armed = true;
+            }
+            q->idle.notify_all();
+            continue;
+        }
+
+        ArmAbsolute(q->timerFd, first == q->schedule.end() ? 0 : first->first);
+        lock.unlock();
+        pollfd fds[2] = { { q->timerFd, POLLIN, 0 }, { q->wakeFd, POLLIN, 0 } };
+        if (::poll(fds, 2, -1) > 0) {
+            uint64_t drained;
+            if (fds[0].revents & POLLIN) (void)!::read(q->timerFd, &drained, sizeof(drained));
+            if (fds[1].revents & POLLIN) (void)!::read(q->wakeFd, &drained, sizeof(drained));
+        }
+        lock.lock();
+    }
+    bool destroy = q->selfDestroy;
+    lock.unlock();
+    if (destroy) Destroy(q);
+}
+
+void LinuxTimerService::Wake(const Queue* q) {
+    const uint64_t one = 1;
+    (void)!::write(q->wakeFd, &one, sizeof(one));
+}
+
+void LinuxTimerService::Destroy(Queue* q) {
+    for (Timer* t : q->timers) delete t;
+    if (q->timerFd >= 0) ::close(q->timerFd);
+    if (q->wakeFd >= 0) ::close(q->wakeFd);
+    delete q;
+}
+
+// ============================================================================
+// LinuxClock
+// ============================================================================
+
+ULONGLONG LinuxClock::NowMs() {
+    return MonotonicUs() / 1000ULL;
+}
+
+ULONGLONG LinuxClock::NowUs() {
+    return MonotonicUs();
+}
+
+void LinuxClock::SleepMs(DWORD ms) {
+    timespec remaining{ static_cast<time_t>(ms / 1000), static_cast<long>(ms % 1000) * 1000000L };
+    while (::nanosleep(&remaining, &remaining) != 0 && errno == EINTR) {}
+}
+
+// ============================================================================
+// LinuxPolicyStore
+// ============================================================================
+
+bool LinuxPolicyStore::Initialize(const std::wstring& /*baseDir*/) {
+    return true;
+}
+
+bool LinuxPolicyStore::ApplyPolicy(const std::wstring& exeName, const std::wstring& fullPath) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (!fullPath.empty()) policies_[fullPath] = exeName;
+    return true;
+}
+
+bool LinuxPolicyStore::ApplyIFEOOnly(const std::wstring& /*exeName*/) {
+    return true;
+}
+
+void LinuxPolicyStore::ReconcileWithConfig(const std::set<std::wstring>& targetNames,
+                                           const std::set<std::wstring>& targetPaths) {
+    std::lock_guard<std::mutex> lock(mu_);
+    for (auto it = policies_.begin(); it != policies_.end(); ) {
+        bool keep = targetPaths.count(it->first) > 0 || targetNames.count(it->second) > 0;
+        it = keep ? std::next(it) : policies_.erase(it);
+    }
+}
+
+void LinuxPolicyStore::CleanupAllPolicies() {
+    std::lock_guard<std::mutex> lock(mu_);
+    policies_.clear();
+}
+
+void LinuxPolicyStore::VerifyAndRepair() {
+    // Nothing persistent to drift: there is no registry counterpart
+}
+
+bool LinuxPolicyStore::IsPolicyValid(const std::wstring& canonPath) const {
+    return HasPolicy(canonPath);
+}
+
+bool LinuxPolicyStore::HasPolicy(const std::wstring& canonPath) const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return policies_.count(canonPath) > 0;
+}
+
+int32_t LinuxPolicyStore::GetPendingQueueSize() const {
+    return 0;
+}
+
+bool LinuxPolicyStore::ConsumePendingOverflowFlag() {
+    return false;
+}
+
+// ============================================================================
+// NativePlatform
+// ============================================================================
+
+Platform& NativePlatform() {
+    static LinuxProcessControl   process;
+    static LinuxSystemSnapshot   snapshot;
+    static LinuxTimerService     timers;
+    static LinuxClock            clock;
+    static LinuxEventService     events;
+    static NetlinkProcessMonitor monitor;
+    static LinuxPolicyStore      policy;
+    static Platform platform{ process, snapshot, timers, clock, events, monitor, policy };
+    return platform;
+}
+
+} // namespace platform
+} // namespace unleaf
+
+#endif // __linux__
@@ -0,0 +1,81 @@
+#pragma once
+// UnLeaf - Linux implementation of the remaining OS abstraction parts + NativePlatform()
+// プロセス制御 / イベントソース / 制御ループ / スナップショットは個別ファイル。ここは残りの
+// ITimerService / IClock / IPolicyStore と、それらを束ねる NativePlatform() の Linux 版。
+//
+//   Timer queue  : キューごとに監視スレッド 1 本。最早の期限で timerfd (CLOCK_MONOTONIC,
+//                  TFD_TIMER_ABSTIME) を張り直し、eventfd で追加・削除・停止を通知する (poll)。
+//                  コールバックはそのスレッドで直列に実行 (EngineCore のコールバックは
+//                  EnqueueRequest のみ)。周期タイマーは期限 + period で再登録、遅れた分は詰めない
+//   DeleteTimer  : waitForCallbacks=true なら実行中のコールバック完了まで待つ
+//                  (INVALID_HANDLE_VALUE 相当)。監視スレッド自身からの呼び出しは待たない
+//   DeleteQueue  : 残ったタイマーもまとめて解放 (DeleteTimerQueueEx と同じ)。false なら
+//                  スレッドを切り離し、最後の処理はスレッド自身が片付ける
+//   Clock        : clock_gettime(CLOCK_MONOTONIC)。SleepMs は EINTR を跨いで残り時間を眠る
+//   Policy store : IFEO / PowerThrottling に当たる起動時ポリシーが Linux には無い。適用は実行時の
+//                  uclamp / cgroup (LinuxProcessControl) だけなので、適用済みパスを記録するだけ
+//                  (HasPolicy / IsPolicyValid が true を返し、SafetyNet の再適用ループを起こさない)
+
+#ifdef __linux__
+
+#include "../platform.h"
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+namespace unleaf {
+namespace platform {
+
+class LinuxTimerService : public ITimerService {
+public:
+    NativeHandle CreateQueue() override;
+    bool DeleteQueue(NativeHandle queue, bool waitForCallbacks) override;
+    bool CreateTimer(NativeHandle* outTimer, NativeHandle queue,
+                     TimerCallback callback, PVOID context,
+                     DWORD dueTimeMs, DWORD periodMs) override;
+    bool DeleteTimer(NativeHandle queue, NativeHandle timer, bool waitForCallbacks) override;
+    DWORD LastError() override;
+
+private:
+    struct Timer;
+    struct Queue;
+
+    static void Run(Queue* q);
+    static void Wake(const Queue* q);
+    static void Destroy(Queue* q);
+};
+
+class LinuxClock : public IClock {
+public:
+    ULONGLONG NowMs() override;
+    ULONGLONG NowUs() override;
+    void SleepMs(DWORD ms) override;
+};
+
+class LinuxPolicyStore : public IPolicyStore {
+public:
+    bool Initialize(const std::wstring& baseDir) override;
+    bool ApplyPolicy(const std::wstring& exeName, const std::wstring& fullPath) override;
+    bool ApplyIFEOOnly(const std::wstring& exeName) override;
+    void ReconcileWithConfig(const std::set<std::wstring>& targetNames,
+                             const std::set<std::wstring>& targetPaths) override;
+    void CleanupAllPolicies() override;
+    void VerifyAndRepair() override;
+    bool IsPolicyValid(const std::wstring& canonPath) const override;
+    bool HasPolicy(const std::wstring& canonPath) const override;
+    int32_t GetPendingQueueSize() const override;
+    bool ConsumePendingOverflowFlag() override;
+
+private:
+    mutable std::mutex mu_;
+    std::map<std::wstring, std::wstring> policies_;   // canonical path -> exe name (ApplyPolicy)
+};
+
+} // namespace platform
+} // namespace unleaf
+
+#endif // __linux__
@@ -0,0 +1,728 @@
+// UnLeaf - Linux implementation of IProcessControl
+
+#ifdef __linux__
+
+#include "linux_process_control.h"
+#include "../../common/logger.h"
+#include "../../common/types.h"
+#include "../../common/win_string_utils.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <malloc.h>
+#include <poll.h>
+#include <sched.h>
+#include <strings.h>
+#include <signal.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+
+namespace unleaf {
+namespace platform {
+
+namespace {
+
+// struct sched_attr (SCHED_ATTR_SIZE_VER1, include/uapi/linux/sched/types.h)
+struct SchedAttr {
+    uint32_t size;
+    uint32_t sched_policy;
+    uint64_t sched_flags;
+    int32_t  sched_nice;
+    uint32_t sched_priority;
+    uint64_t sched_runtime;
+    uint64_t sched_deadline;
+    uint64_t sched_period;
+    uint32_t sched_util_min;
+    uint32_t sched_util_max;
+};
+static_assert(sizeof(SchedAttr) == 56, "SCHED_ATTR_SIZE_VER1");
+
+constexpr uint64_t SCHED_FLAG_KEEP_POLICY    = 0x08;
+constexpr uint64_t SCHED_FLAG_KEEP_PARAMS    = 0x10;
+constexpr uint64_t SCHED_FLAG_UTIL_CLAMP_MIN = 0x20;
+
+int SchedSetattr(int tid, SchedAttr& attr) {
+    attr.size = sizeof(attr);
+    return static_cast<int>(::syscall(SYS_sched_setattr, tid, &attr, 0));
+}
+
+int SchedGetattr(int tid, SchedAttr& attr) {
+    std::memset(&attr, 0, sizeof(attr));
+    return static_cast<int>(::syscall(SYS_sched_getattr, tid, &attr, sizeof(attr), 0));
+}
+
+int PidfdOpen(int pid) {
+    return static_cast<int>(::syscall(SYS_pidfd_open, pid, 0));
+}
+
+thread_local DWORD t_lastError = ERROR_SUCCESS;
+
+void SetLastErrorFromErrno(int err) {
+    t_lastError = LinuxErrorToWin32(err);
+}
+
+bool WriteSmallFile(const std::string& path, const std::string& value) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    const ssize_t n = ::write(fd, value.data(), value.size());
+    const int err = errno;
+    ::close(fd);
+    errno = err;
+    return n == static_cast<ssize_t>(value.size());
+}
+
+bool ReadSmallFile(const std::string& path, std::string& out) {
+    out.clear();
+    FILE* f = std::fopen(path.c_str(), "re");
+    if (!f) return false;
+    char buf[4096];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+    std::fclose(f);
+    return true;
+}
+
+// Leader-thread scheduling state counts as "background" (the EcoQoS analog without uclamp)
+bool IsBackgroundPolicy(uint32_t policy) {
+    return policy == SCHED_IDLE || policy == SCHED_BATCH;
+}
+
+// SCHED_IDLE / SCHED_BATCH -> SCHED_OTHER, nice and clamps preserved
+bool LeaveBackgroundPolicy(int tid) {
+    SchedAttr attr;
+    if (SchedGetattr(tid, attr) != 0) return false;
+    if (!IsBackgroundPolicy(attr.sched_policy)) return true;
+    const int32_t nice = (attr.sched_policy == SCHED_IDLE) ? 0 : attr.sched_nice;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.sched_policy = SCHED_OTHER;
+    attr.sched_nice = nice;
+    return SchedSetattr(tid, attr) == 0;
+}
+
+// Handles returned to EngineCore point at one of these
+enum class HandleKind : uint8_t { PROCESS, JOB, WAIT };
+
+struct HandleBase {
+    explicit HandleBase(HandleKind k) : kind(k) {}
+    HandleKind kind;
+};
+
+} // namespace
+
+struct LinuxProcessControl::ProcessRef : HandleBase {
+    ProcessRef(int p, int fd) : HandleBase(HandleKind::PROCESS), pid(p), pidfd(fd) {}
+    int pid;
+    int pidfd;               // -1 when pidfd_open is unavailable (PID-based fallback)
+    std::string jobCgroup;   // set by AssignToNewJob
+};
+
+struct LinuxProcessControl::JobRef : HandleBase {
+    explicit JobRef(std::string d) : HandleBase(HandleKind::JOB), dir(std::move(d)) {}
+    std::string dir;
+};
+
+struct LinuxProcessControl::WaitRef : HandleBase {
+    WaitRef() : HandleBase(HandleKind::WAIT) {}
+    int fd = -1;             // dup of the process pidfd
+    WaitCallback callback = nullptr;
+    PVOID context = nullptr;
+    uint64_t serial = 0;     // guards against address reuse between poll and dispatch
+    bool fired = false;      // waitMu_
+};
+
+DWORD LinuxErrorToWin32(int err) {
+    switch (err) {
+        case 0:          return ERROR_SUCCESS;
+        case EPERM:
+        case EACCES:     return ERROR_ACCESS_DENIED;
+        case ESRCH:
+        case EINVAL:     return ERROR_INVALID_PARAMETER;
+        case EBADF:      return ERROR_INVALID_HANDLE;
+        case ENOMEM:     return ERROR_NOT_ENOUGH_MEMORY;
+        case ENOSYS:
+        case EOPNOTSUPP: return ERROR_NOT_SUPPORTED;
+        default:         return ERROR_GEN_FAILURE;
+    }
+}
+
+bool PriorityClassToNice(DWORD priorityClass, int& nice) {
+    switch (priorityClass) {
+        case IDLE_PRIORITY_CLASS:         nice = 19;  return true;
+        case BELOW_NORMAL_PRIORITY_CLASS: nice = 10;  return true;
+        case NORMAL_PRIORITY_CLASS:       nice = 0;   return true;
+        case ABOVE_NORMAL_PRIORITY_CLASS: nice = -5;  return true;
+        case HIGH_PRIORITY_CLASS:         nice = -10; return true;
+        default:                          return false;
+    }
+}
+
+// ============================================================================
+// LinuxProcessControl
+// ============================================================================
+
+LinuxProcessControl::LinuxProcessControl(LinuxEnforcementOptions options)
+    : options_(std::move(options)) {}
+
+LinuxProcessControl::~LinuxProcessControl() {
+    if (watchThread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(waitMu_);
+            stopWatch_ = true;
+        }
+        const uint64_t one = 1;
+        (void)!::write(wakeFd_, &one, sizeof(one));
+        watchThread_.join();
+    }
+    if (wakeFd_ >= 0) ::close(wakeFd_);
+    for (WaitRef* w : waits_) {
+        ::close(w->fd);
+        delete w;
+    }
+}
+
+void LinuxProcessControl::Initialize() {
+    // pidfd (Linux 5.3+): exit waits and PID-reuse-safe handles
+    int fd = PidfdOpen(::getpid());
+    pidfdSupported_ = (fd >= 0);
+    if (fd >= 0) ::close(fd);
+
+    // uclamp (CONFIG_UCLAMP_TASK): re-apply our own util_min to see whether the flag is accepted
+    SchedAttr self;
+    uclampSupported_ = SchedGetattr(0, self) == 0 && self.size >= sizeof(SchedAttr) &&
+                       SetThreadUtilMin(0, self.sched_util_min);
+
+    // Job cgroups: parent group + cpu controller for its children (best effort)
+    bool jobCgroups = false;
+    if (!options_.cgroupParent.empty()) {
+        const std::string parent = options_.cgroupMount + "/" + options_.cgroupParent;
+        jobCgroups = (::mkdir(parent.c_str(), 0755) == 0 || errno == EEXIST);
+        if (jobCgroups) WriteSmallFile(parent + "/cgroup.subtree_control", "+cpu");
+    }
+
+    wchar_t buf[192];
+    swprintf_s(buf, L"Engine: Linux enforcement - uclamp %ls, pidfd %ls, job cgroups %ls",
+               uclampSupported_ ? L"ON" : L"OFF (nice / policy only)",
+               pidfdSupported_ ? L"ON" : L"OFF (no exit waits)",
+               jobCgroups ? L"ON" : L"OFF");
+    LOG_INFO(buf);
+}
+
+NativeHandle LinuxProcessControl::OpenControl(DWORD pid) {
+    if (pid == 0) {
+        t_lastError = ERROR_INVALID_PARAMETER;
+        return nullptr;
+    }
+    int fd = -1;
+    if (pidfdSupported_) {
+        fd = PidfdOpen(static_cast<int>(pid));
+        if (fd < 0) {
+            SetLastErrorFromErrno(errno);
+            return nullptr;
+        }
+    } else if (::kill(static_cast<pid_t>(pid), 0) != 0 && errno != EPERM) {
+        SetLastErrorFromErrno(errno);
+        return nullptr;
+    }
+    return new ProcessRef(static_cast<int>(pid), fd);
+}
+
+// Linux has no per-handle access rights: all three opens are the same reference
+NativeHandle LinuxProcessControl::OpenQuery(DWORD pid) {
+    return OpenControl(pid);
+}
+
+NativeHandle LinuxProcessControl::OpenSynchronize(DWORD pid) {
+    return OpenControl(pid);
+}
+
+void LinuxProcessControl::CloseHandle(NativeHandle h) {
+    if (!h || h == INVALID_HANDLE_VALUE) return;
+    auto* base = static_cast<HandleBase*>(h);
+    switch (base->kind) {
+        case HandleKind::PROCESS: {
+            auto* p = static_cast<ProcessRef*>(base);
+            if (p->pidfd >= 0) ::close(p->pidfd);
+            delete p;
+            break;
+        }
+        case HandleKind::JOB: {
+            // Like closing a job handle: members keep running. Empty groups are removed.
+            auto* j = static_cast<JobRef*>(base);
+            ::rmdir(j->dir.c_str());
+            delete j;
+            break;
+        }
+        case HandleKind::WAIT:
+            break;   // owned by UnregisterExitWait
+    }
+}
+
+DWORD LinuxProcessControl::LastError() {
+    return t_lastError;
+}
+
+bool LinuxProcessControl::QueryExitCode(NativeHandle process, DWORD& exitCode) {
+    auto* p = static_cast<ProcessRef*>(process);
+    if (!p || p->kind != HandleKind::PROCESS) {
+        t_lastError = ERROR_INVALID_HANDLE;
+        return false;
+    }
+    bool exited;
+    if (p->pidfd >= 0) {
+        pollfd pfd{p->pidfd, POLLIN, 0};
+        exited = ::poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN);
+    } else {
+        exited = ::kill(p->pid, 0) != 0 && errno == ESRCH;
+    }
+    // Exit status belongs to the parent (waitpid); report 0 like an unknown clean exit
+    exitCode = exited ? 0 : STILL_ACTIVE;
+    return true;
+}
+
+std::wstring LinuxProcessControl::QueryImageName(NativeHandle process) {
+    auto* p = static_cast<ProcessRef*>(process);
+    if (!p || p->kind != HandleKind::PROCESS) {
+        t_lastError = ERROR_INVALID_HANDLE;
+        return L"";
+    }
+    char link[64];
+    std::snprintf(link, sizeof(link), "/proc/%d/exe", p->pid);
+    char target[4096];
+    const ssize_t n = ::readlink(link, target, sizeof(target) - 1);
+    if (n <= 0) {
+        SetLastErrorFromErrno(errno);
+        return L"";
+    }
+    std::string path(target, static_cast<size_t>(n));
+    static const char kDeleted[] = " (deleted)";
+    if (path.size() > sizeof(kDeleted) - 1 &&
+        path.compare(path.size() - (sizeof(kDeleted) - 1), std::string::npos, kDeleted) == 0) {
+        path.resize(path.size() - (sizeof(kDeleted) - 1));
+    }
+    return Utf8ToWide(path.c_str());
+}
+
+std::wstring LinuxProcessControl::ResolveImagePath(NativeHandle process) {
+    // /proc/<pid>/exe is already the final (symlink-resolved) path
+    return CanonicalizePath(QueryImageName(process));
+}
+
+bool LinuxProcessControl::FileExists(const std::wstring& path) {
+    // Engine paths use the portable canonical form (backslash separators, lowercase)
+    std::wstring posix = path;
+    std::replace(posix.begin(), posix.end(), L'\\', L'/');
+    // ResolveDotSegments drops the POSIX root: engine paths are always absolute
+    if (!posix.empty() && posix[0] != L'/') posix.insert(posix.begin(), L'/');
+    const std::string utf8 = WideToUtf8(posix.c_str());
+    struct stat st;
+    if (::stat(utf8.c_str(), &st) == 0) return true;
+    if (utf8.empty()) return false;
+
+    // Case-folded by CanonicalizePath: match each component case-insensitively
+    std::string resolved;
+    size_t pos = 1;
+    while (pos <= utf8.size()) {
+        size_t end = utf8.find('/', pos);
+        if (end == std::string::npos) end = utf8.size();
+        const std::string part = utf8.substr(pos, end - pos);
+        pos = end + 1;
+        if (part.empty()) continue;
+
+        const std::string exact = resolved + "/" + part;
+        if (::stat(exact.c_str(), &st) == 0) {
+            resolved = exact;
+            continue;
+        }
+        DIR* dir = ::opendir(resolved.empty() ? "/" : resolved.c_str());
+        if (!dir) return false;
+        bool found = false;
+        while (dirent* e = ::readdir(dir)) {
+            if (::strcasecmp(e->d_name, part.c_str()) == 0) {
+                resolved += "/";
+                resolved += e->d_name;
+                found = true;
+                break;
+            }
+        }
+        ::closedir(dir);
+        if (!found) return false;
+    }
+    return true;
+}
+
+std::vector<int> LinuxProcessControl::ListThreads(int pid) {
+    std::vector<int> tids;
+    char dirPath[64];
+    std::snprintf(dirPath, sizeof(dirPath), "/proc/%d/task", pid);
+    DIR* dir = ::opendir(dirPath);
+    if (!dir) return tids;
+    while (dirent* e = ::readdir(dir)) {
+        if (e->d_name[0] < '0' || e->d_name[0] > '9') continue;
+        tids.push_back(std::atoi(e->d_name));
+    }
+    ::closedir(dir);
+    return tids;
+}
+
+bool LinuxProcessControl::SetThreadUtilMin(int tid, uint32_t utilMin) {
+    SchedAttr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.sched_flags = SCHED_FLAG_KEEP_POLICY | SCHED_FLAG_KEEP_PARAMS | SCHED_FLAG_UTIL_CLAMP_MIN;
+    attr.sched_util_min = utilMin;
+    return SchedSetattr(tid, attr) == 0;
+}
+
+bool LinuxProcessControl::SetPriorityClass(NativeHandle process, DWORD priorityClass) {
+    auto* p = static_cast<ProcessRef*>(process);
+    if (!p || p->kind != HandleKind::PROCESS) {
+        t_lastError = ERROR_INVALID_HANDLE;
+        return false;
+    }
+
+    // Exit background mode: every thread off SCHED_IDLE / SCHED_BATCH
+    if (priorityClass == PROCESS_MODE_BACKGROUND_END) {
+        bool leaderOk = true;
+        for (int tid : ListThreads(p->pid)) {
+            if (!LeaveBackgroundPolicy(tid) && tid == p->pid) {
+                leaderOk = false;
+                SetLastErrorFromErrno(errno);
+            }
+        }
+        return leaderOk;
+    }
+
+    int nice = 0;
+    if (!PriorityClassToNice(priorityClass, nice)) {
+        t_lastError = ERROR_INVALID_PARAMETER;
+        return false;
+    }
+    // nice is per thread on Linux: apply to every thread, the leader decides the result
+    bool leaderOk = false;
+    for (int tid : ListThreads(p->pid)) {
+        const bool ok = ::setpriority(PRIO_PROCESS, static_cast<id_t>(tid), nice) == 0;
+        if (tid == p->pid) {
+            leaderOk = ok;
+            if (!ok) SetLastErrorFromErrno(errno);
+        }
+    }
+    if (!leaderOk && t_lastError == ERROR_SUCCESS) t_lastError = ERROR_INVALID_PARAMETER;
+    return leaderOk;
+}
+
+bool LinuxProcessControl::ApplyCgroupKnobs(const std::string& cgroupDir) {
+    const bool weightOk = WriteSmallFile(cgroupDir + "/cpu.weight", std::to_string(options_.cgroupWeight));
+    const int weightErr = errno;
+    const bool uclampOk = WriteSmallFile(cgroupDir + "/cpu.uclamp.min", options_.cgroupUclampMin);
+    if (!weightOk) errno = weightErr;
+    return weightOk && uclampOk;
+}
+
+std::string LinuxProcessControl::ManagedCgroupOf(int pid) const {
+    if (options_.cgroupParent.empty()) return std::string();
+    char path[64];
+    std::snprintf(path, sizeof(path), "/proc/%d/cgroup", pid);
+    std::string content;
+    if (!ReadSmallFile(path, content)) return std::string();
+    // cgroup v2 unified hierarchy line: "0::/<path>"
+    const size_t pos = content.find("0::");
+    if (pos == std::string::npos) return std::string();
+    const size_t end = content.find('\n', pos);
+    const std::string rel = content.substr(pos + 3, end == std::string::npos ? std::string::npos : end - pos - 3);
+    const std::string prefix = "/" + options_.cgroupParent + "/";
+    if (rel.compare(0, prefix.size(), prefix) != 0) return std::string();
+    return options_.cgroupMount + rel;
+}
+
+EcoQoSResult LinuxProcessControl::SetEcoQoSOff(NativeHandle process, ULONG controlMask,
+                                               bool preferNtApi) {
+    (void)controlMask;   // EXECUTION_SPEED / IGNORE_TIMER both map to the util_min floor
+    EcoQoSResult result;
+    auto* p = static_cast<ProcessRef*>(process);
+    if (!p || p->kind != HandleKind::PROCESS) {
+        result.error = ERROR_INVALID_HANDLE;
+        return result;
+    }
+
+    // Group layer (usedNtApi / ntFallback slots): cpu.weight + cpu.uclamp.min of a job cgroup
+    if (preferNtApi) {
+        const std::string group = p->jobCgroup.empty() ? ManagedCgroupOf(p->pid) : p->jobCgroup;
+        if (!group.empty()) {
+            result.usedNtApi = true;
+            if (!ApplyCgroupKnobs(group)) {
+                result.ntFallback = true;
+                result.ntStatus = errno;
+            }
+        }
+    }
+
+    // Thread layer: leader util_min (threads created later inherit it from their creator).
+    // Without uclamp: leave SCHED_IDLE / SCHED_BATCH and drop positive nice.
+    bool ok;
+    if (uclampSupported_) {
+        ok = SetThreadUtilMin(p->pid, options_.utilMin);
+    } else {
+        ok = LeaveBackgroundPolicy(p->pid);
+        if (ok) {
+            errno = 0;
+            const int nice = ::getpriority(PRIO_PROCESS, static_cast<id_t>(p->pid));
+            ok = (errno == 0) && (nice <= 0 || ::setpriority(PRIO_PROCESS, static_cast<id_t>(p->pid), 0) == 0);
+        }
+    }
+    result.success = ok;
+    if (!ok) result.error = LinuxErrorToWin32(errno);
+    return result;
+}
+
+bool LinuxProcessControl::IsEcoQoSEnabled(NativeHandle process) {
+    auto* p = static_cast<ProcessRef*>(process);
+    if (!p || p->kind != HandleKind::PROCESS) return false;
+
+    SchedAttr attr;
+    if (SchedGetattr(p->pid, attr) != 0) {
+        return false;  // Unable to determine, assume not enabled
+    }
+    if (attr.sched_policy == SCHED_IDLE) return true;
+    if (uclampSupported_) return attr.sched_util_min < options_.utilMin;
+    return attr.sched_nice > 0 || attr.sched_policy == SCHED_BATCH;
+}
+
+int LinuxProcessControl::DisableThreadThrottling(DWORD pid, bool aggressive) {
+    if (pid == 0) return 0;
+
+    int threadCount = 0;
+    for (int tid : ListThreads(static_cast<int>(pid))) {
+        if (BoostThread(tid, aggressive)) threadCount++;
+    }
+    return threadCount;
+}
+
+int LinuxProcessControl::DisableThreadThrottling(DWORD pid, const uint32_t* threadIds, size_t count,
+                                                 bool aggressive) {
+    if (pid == 0) return 0;
+
+    int threadCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const int tid = static_cast<int>(threadIds[i]);
+        // Still a thread of pid (TIDs are reused once a thread exits)
+        if (::syscall(SYS_tgkill, static_cast<int>(pid), tid, 0) != 0 && errno != EPERM) continue;
+        if (BoostThread(tid, aggressive)) threadCount++;
+    }
+    return threadCount;
+}
+
+bool LinuxProcessControl::BoostThread(int tid, bool aggressive) {
+    errno = 0;
+    const int nice = ::getpriority(PRIO_PROCESS, static_cast<id_t>(tid));
+    if (errno != 0) return false;   // thread exited
+
+    if (uclampSupported_) {
+        SetThreadUtilMin(tid, options_.utilMin);
+    }
+
+    // Priority boost logic (same thresholds as THREAD_PRIORITY_* on Windows)
+    if (aggressive) {
+        // Boost any thread below ABOVE_NORMAL
+        if (nice > options_.boostNice) {
+            ::setpriority(PRIO_PROCESS, static_cast<id_t>(tid), options_.boostNice);
+        }
+    } else {
+        // Conservative: only boost low priority threads (IDLE / LOWEST / BELOW_NORMAL)
+        if (nice > 0) {
+            ::setpriority(PRIO_PROCESS, static_cast<id_t>(tid), options_.boostNice);
+        }
+    }
+    return true;
+}
+
+bool LinuxProcessControl::RegisterExitWait(NativeHandle* outWait, NativeHandle process,
+                                           WaitCallback callback, PVOID context) {
+    *outWait = nullptr;
+    auto* p = static_cast<ProcessRef*>(process);
+    if (!p || p->kind != HandleKind::PROCESS || p->pidfd < 0) {
+        t_lastError = (p && p->kind == HandleKind::PROCESS) ? ERROR_NOT_SUPPORTED : ERROR_INVALID_HANDLE;
+        return false;
+    }
+    const int fd = ::fcntl(p->pidfd, F_DUPFD_CLOEXEC, 0);
+    if (fd < 0) {
+        SetLastErrorFromErrno(errno);
+        return false;
+    }
+
+    static uint64_t nextSerial = 0;
+    auto* w = new WaitRef();
+    w->fd = fd;
+    w->callback = callback;
+    w->context = context;
+
+    std::lock_guard<std::mutex> lock(waitMu_);
+    if (!watchThread_.joinable()) {
+        wakeFd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (wakeFd_ < 0) {
+            SetLastErrorFromErrno(errno);
+            ::close(fd);
+            delete w;
+            return false;
+        }
+        watchThread_ = std::thread([this] { WatchLoop(); });
+    }
+    w->serial = ++nextSerial;
+    waits_.push_back(w);
+    const uint64_t one = 1;
+    (void)!::write(wakeFd_, &one, sizeof(one));
+    *outWait = w;
+    return true;
+}
+
+bool LinuxProcessControl::UnregisterExitWait(NativeHandle wait) {
+    auto* w = static_cast<WaitRef*>(wait);
+    if (!w || w->kind != HandleKind::WAIT) {
+        t_lastError = ERROR_INVALID_HANDLE;
+        return false;
+    }
+    {
+        std::unique_lock<std::mutex> lock(waitMu_);
+        waits_.erase(std::remove(waits_.begin(), waits_.end(), w), waits_.end());
+        // Blocks until any in-flight callback completes (UnregisterWaitEx(INVALID_HANDLE_VALUE)).
+        // From inside the callback itself there is nothing to wait for.
+        if (std::this_thread::get_id() != watchThread_.get_id()) {
+            waitCv_.wait(lock, [&] { return inFlight_ != w; });
+        }
+    }
+    ::close(w->fd);
+    delete w;
+    return true;
+}
+
+void LinuxProcessControl::WatchLoop() {
+    std::vector<pollfd> fds;
+    std::vector<std::pair<WaitRef*, uint64_t>> refs;
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(waitMu_);
+            if (stopWatch_) return;
+            fds.assign(1, pollfd{wakeFd_, POLLIN, 0});
+            refs.clear();
+            for (WaitRef* w : waits_) {
+                if (w->fired) continue;
+                fds.push_back(pollfd{w->fd, POLLIN, 0});
+                refs.emplace_back(w, w->serial);
+            }
+        }
+
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            LOG_ERROR(L"Engine: exit wait poll failed (errno=" + std::to_wstring(errno) + L")");
+            return;
+        }
+        if (fds[0].revents & POLLIN) {
+            uint64_t drained;
+            (void)!::read(wakeFd_, &drained, sizeof(drained));
+        }
+
+        for (size_t i = 1; i < fds.size(); ++i) {
+            if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            WaitRef* w = refs[i - 1].first;
+            std::unique_lock<std::mutex> lock(waitMu_);
+            // Unregistered (and possibly freed / reallocated) since the poll set was built
+            auto it = std::find(waits_.begin(), waits_.end(), w);
+            if (it == waits_.end() || w->serial != refs[i - 1].second || w->fired) continue;
+            w->fired = true;
+            inFlight_ = w;
+            lock.unlock();
+
+            w->callback(w->context, FALSE);   // WT_EXECUTEONLYONCE: signaled, not timed out
+
+            lock.lock();
+            inFlight_ = nullptr;
+            waitCv_.notify_all();
+        }
+    }
+}
+
+JobAssignResult LinuxProcessControl::AssignToNewJob(NativeHandle process, NativeHandle* outJob) {
+    *outJob = nullptr;
+    auto* p = static_cast<ProcessRef*>(process);
+    if (!p || p->kind != HandleKind::PROCESS) {
+        t_lastError = ERROR_INVALID_HANDLE;
+        return JobAssignResult::CREATE_FAILED;
+    }
+    if (options_.cgroupParent.empty()) {
+        t_lastError = ERROR_NOT_SUPPORTED;
+        return JobAssignResult::CREATE_FAILED;
+    }
+
+    // Already in one of our groups (e.g. inherited from a target parent across fork)
+    if (!p->jobCgroup.empty() || !ManagedCgroupOf(p->pid).empty()) {
+        return JobAssignResult::ALREADY_IN_JOB;
+    }
+
+    const std::string dir = options_.cgroupMount + "/" + options_.cgroupParent +
+                            "/job-" + std::to_string(p->pid);
+    if (::mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+        SetLastErrorFromErrno(errno);
+        return JobAssignResult::CREATE_FAILED;
+    }
+
+    // Knobs first so the process never runs in the group with default weight (best effort:
+    // the cpu controller may not be delegated; SetEcoQoSOff retries on every enforcement)
+    ApplyCgroupKnobs(dir);
+
+    if (!WriteSmallFile(dir + "/cgroup.procs", std::to_string(p->pid))) {
+        const int err = errno;
+        ::rmdir(dir.c_str());
+        SetLastErrorFromErrno(err);
+        return JobAssignResult::ASSIGN_FAILED;
+    }
+
+    p->jobCgroup = dir;
+    *outJob = new JobRef(dir);
+    return JobAssignResult::ASSIGNED;
+}
+
+bool LinuxProcessControl::QueryJobProcessIds(NativeHandle job, DWORD* pids, DWORD capacity,
+                                             DWORD* count) {
+    *count = 0;
+    auto* j = static_cast<JobRef*>(job);
+    if (!j || j->kind != HandleKind::JOB) {
+        t_lastError = ERROR_INVALID_HANDLE;
+        return false;
+    }
+    std::string content;
+    if (!ReadSmallFile(j->dir + "/cgroup.procs", content)) {
+        SetLastErrorFromErrno(errno);
+        return false;
+    }
+    DWORD n = 0;
+    size_t pos = 0;
+    while (pos < content.size() && n < capacity) {
+        const size_t end = content.find('\n', pos);
+        const std::string line = content.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+        if (!line.empty()) pids[n++] = static_cast<DWORD>(std::strtoul(line.c_str(), nullptr, 10));
+        if (end == std::string::npos) break;
+        pos = end + 1;
+    }
+    *count = n;
+    return true;
+}
+
+void LinuxProcessControl::OptimizeSelfHeap() {
+    // Return free heap pages to the OS (glibc). Best-effort, like HeapOptimizeResources.
+#ifdef __GLIBC__
+    ::malloc_trim(0);
+#endif
+}
+
+} // namespace platform
+} // namespace unleaf
+
+#endif // __linux__
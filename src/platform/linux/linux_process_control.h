@@ -0,0 +1,119 @@
+#pragma once
+// UnLeaf - Linux implementation of IProcessControl (enforcement contract)
+// PulseEnforceV6 / DisableThreadThrottling / Job 管理の Linux 版。EngineCore 側の
+// 3 段階検証 (AGGRESSIVE / STABLE / PERSISTENT) はそのまま再利用する。
+//
+//   EcoQoS OFF           : リーダースレッドの sched_util_min を引き上げ (sched_setattr)
+//                          + プロセスが UnLeaf の cgroup 配下なら cpu.uclamp.min / cpu.weight
+//   IsEcoQoSEnabled      : リーダーの util_min が下限未満 (uclamp 非対応カーネルでは nice > 0 /
+//                          SCHED_IDLE) なら「スロットル中」
+//   DisableThreadThrottling : /proc/<pid>/task の全スレッドに util_min + nice ブースト
+//                          (§9.38: スナップショットのスレッド ID 版は tgkill(pid, tid, 0) で所属確認のみ)
+//   SetPriorityClass     : 優先度クラス → nice を全スレッドへ (Linux の nice はスレッド単位)
+//   Job Object           : cgroup v2 の子グループ (<mount>/<parent>/job-<pid>)
+//   Exit wait            : pidfd + 監視スレッド 1 本 (poll)
+//
+// ハンドルは Linux 側の小さな参照オブジェクトへのポインタ (プロセス / Job / Wait)。
+// エラーは errno を Win32 エラーコードへ写す (EPERM/EACCES → 5、ESRCH/EINVAL → 87)。
+
+#ifdef __linux__
+
+#include "../platform.h"
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace unleaf {
+namespace platform {
+
+struct LinuxEnforcementOptions {
+    uint32_t utilMin = 512;               // sched_util_min floor (0..1024)
+    int      boostNice = -5;              // THREAD_PRIORITY_ABOVE_NORMAL analog
+    uint32_t cgroupWeight = 1000;         // cpu.weight (1..10000, default 100)
+    std::string cgroupUclampMin = "50.00";  // cpu.uclamp.min (percent)
+    std::string cgroupMount = "/sys/fs/cgroup";
+    std::string cgroupParent;             // relative to cgroupMount; empty = no job cgroups
+};
+
+// errno -> Win32 error code (LastError vocabulary used by EngineCore)
+DWORD LinuxErrorToWin32(int err);
+
+// Priority class -> nice (IDLE 19, BELOW_NORMAL 10, NORMAL 0, ABOVE_NORMAL -5, HIGH -10)
+bool PriorityClassToNice(DWORD priorityClass, int& nice);
+
+class LinuxProcessControl : public IProcessControl {
+public:
+    explicit LinuxProcessControl(LinuxEnforcementOptions options = LinuxEnforcementOptions());
+    ~LinuxProcessControl() override;
+
+    void Initialize() override;
+
+    NativeHandle OpenControl(DWORD pid) override;
+    NativeHandle OpenQuery(DWORD pid) override;
+    NativeHandle OpenSynchronize(DWORD pid) override;
+    void CloseHandle(NativeHandle h) override;
+    DWORD LastError() override;
+
+    bool QueryExitCode(NativeHandle process, DWORD& exitCode) override;
+    std::wstring QueryImageName(NativeHandle process) override;
+    std::wstring ResolveImagePath(NativeHandle process) override;
+    bool FileExists(const std::wstring& path) override;
+
+    bool SetPriorityClass(NativeHandle process, DWORD priorityClass) override;
+    // true when the kernel accepts SCHED_FLAG_UTIL_CLAMP_MIN (CONFIG_UCLAMP_TASK)
+    bool SupportsFullEcoQoS() const override { return uclampSupported_; }
+    EcoQoSResult SetEcoQoSOff(NativeHandle process, ULONG controlMask, bool preferNtApi) override;
+    bool IsEcoQoSEnabled(NativeHandle process) override;
+    int DisableThreadThrottling(DWORD pid, bool aggressive) override;
+    int DisableThreadThrottling(DWORD pid, const uint32_t* threadIds, size_t count,
+                                bool aggressive) override;
+
+    bool RegisterExitWait(NativeHandle* outWait, NativeHandle process,
+                          WaitCallback callback, PVOID context) override;
+    bool UnregisterExitWait(NativeHandle wait) override;
+
+    JobAssignResult AssignToNewJob(NativeHandle process, NativeHandle* outJob) override;
+    bool QueryJobProcessIds(NativeHandle job, DWORD* pids, DWORD capacity,
+                            DWORD* count) override;
+
+    void OptimizeSelfHeap() override;
+
+    const LinuxEnforcementOptions& Options() const { return options_; }
+
+private:
+    struct ProcessRef;
+    struct JobRef;
+    struct WaitRef;
+
+    // Thread IDs of pid (/proc/<pid>/task); empty when the process is gone
+    static std::vector<int> ListThreads(int pid);
+    // util_min for one thread (keeps policy, nice and util_max)
+    bool SetThreadUtilMin(int tid, uint32_t utilMin);
+    // util_min + nice boost for one thread; false when the thread is gone
+    bool BoostThread(int tid, bool aggressive);
+    // Group-level knobs when the process lives under cgroupParent; false + errno on failure
+    bool ApplyCgroupKnobs(const std::string& cgroupDir);
+    // <mount>/<path> from /proc/<pid>/cgroup when under cgroupParent, else empty
+    std::string ManagedCgroupOf(int pid) const;
+    void WatchLoop();
+
+    const LinuxEnforcementOptions options_;
+    bool uclampSupported_ = false;
+    bool pidfdSupported_ = false;
+
+    // Exit waits (one poll thread for every registered pidfd)
+    std::mutex waitMu_;
+    std::condition_variable waitCv_;
+    std::vector<WaitRef*> waits_;
+    WaitRef* inFlight_ = nullptr;
+    int wakeFd_ = -1;
+    bool stopWatch_ = false;
+    std::thread watchThread_;
+};
+
+} // namespace platform
+} // namespace unleaf
+
+#endif // __linux__
@@ -0,0 +1,155 @@
+// UnLeaf - Linux implementation of ISystemSnapshot (/proc, §9.38)
+
+#ifdef __linux__
+
+#include "linux_system_snapshot.h"
+#include "linux_utf8.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace unleaf {
+namespace platform {
+
+namespace {
+
+bool IsNumeric(const char* s) {
+    if (*s < '0' || *s > '9') return false;
+    for (; *s; ++s) {
+        if (*s < '0' || *s > '9') return false;
+    }
+    return true;
+}
+
+// Whole small file (stat / statm); -1 on failure
+ssize_t ReadSmall(int dirFd, const char* path, char* buf, size_t size) {
+    const int fd = ::openat(dirFd, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    const ssize_t n = ::read(fd, buf, size - 1);
+    ::close(fd);
+    if (n >= 0) buf[n] = '\0';
+    return n;
+}
+
+} // namespace
+
+bool LinuxSystemSnapshot::Capture(engine_logic::SystemSnapshot& out) {
+    out.Clear();
+    DIR* proc = ::opendir("/proc");
+    if (!proc) return false;
+    const int procFd = ::dirfd(proc);
+
+    char comm[64];
+    while (dirent* e = ::readdir(proc)) {
+        if (!IsNumeric(e->d_name)) continue;
+        uint32_t ppid = 0;
+        uint64_t startTime = 0;
+        size_t commLen = 0;
+        if (!ReadStat(procFd, e->d_name, ppid, startTime, comm, commLen)) continue;   // exited meanwhile
+        if (!ReadExeName(procFd, e->d_name)) DecodeUtf8(comm, commLen, nameScratch_);
+
+        out.AddProcess(static_cast<uint32_t>(std::strtoul(e->d_name, nullptr, 10)), ppid, nameScratch_,
+                       startTime);
+        AddThreads(procFd, e->d_name, out);
+    }
+    ::closedir(proc);
+    out.Finish();
+    return true;
+}
+
+bool LinuxSystemSnapshot::ReadStat(int procFd, const char* pidDir, uint32_t& ppid, uint64_t& startTime,
+                                   char* comm, size_t& commLen) {
+    char path[32];
+    std::snprintf(path, sizeof(path), "%s/stat", pidDir);
+    char buf[1024];
+    if (ReadSmall(procFd, path, buf, sizeof(buf)) <= 0) return false;
+
+    // "pid (comm) state ppid ...": comm may contain spaces and ')' — use the last ')'
+    const char* lparen = std::strchr(buf, '(');
+    const char* rparen = std::strrchr(buf, ')');
+    if (!lparen || !rparen || rparen < lparen) return false;
+    // state ppid ... starttime (field 22)
+    char state = 0;
+    unsigned parent = 0;
+    unsigned long long start = 0;
+    const int fields = std::sscanf(rparen + 1, " %c %u %*d %*d %*d %*d %*u %*u %*u %*u %*u %*u %*u %*d %*d %*d %*d %*d %*d %llu",
+                                   &state, &parent, &start);
+    if (fields < 2) return false;
+    ppid = parent;
+    startTime = (fields == 3) ? start : 0;
+    commLen = static_cast<size_t>(rparen - lparen - 1);
+    if (commLen > 63) commLen = 63;
+    std::memcpy(comm, lparen + 1, commLen);
+    return true;
+}
+
+bool LinuxSystemSnapshot::ReadExeName(int procFd, const char* pidDir) {
+    char path[32];
+    std::snprintf(path, sizeof(path), "%s/exe", pidDir);
+    char target[4096];
+    ssize_t n = ::readlinkat(procFd, path, target, sizeof(target));
+    if (n <= 0 || n >= static_cast<ssize_t>(sizeof(target))) return false;
+    static const char kDeleted[] = " (deleted)";
+    constexpr size_t kDeletedLen = sizeof(kDeleted) - 1;
+    if (static_cast<size_t>(n) > kDeletedLen &&
+        std::memcmp(target + n - kDeletedLen, kDeleted, kDeletedLen) == 0) {
+        n -= static_cast<ssize_t>(kDeletedLen);
+    }
+    size_t start = static_cast<size_t>(n);
+    while (start > 0 && target[start - 1] != '/') --start;
+    if (start == static_cast<size_t>(n)) return false;
+    DecodeUtf8(target + start, static_cast<size_t>(n) - start, nameScratch_);
+    return true;
+}
+
+void LinuxSystemSnapshot::AddThreads(int procFd, const char* pidDir, engine_logic::SystemSnapshot& out) {
+    char path[32];
+    std::snprintf(path, sizeof(path), "%s/task", pidDir);
+    const int fd = ::openat(procFd, path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return;
+    DIR* task = ::fdopendir(fd);
+    if (!task) {
+        ::close(fd);
+        return;
+    }
+    while (dirent* e = ::readdir(task)) {
+        if (!IsNumeric(e->d_name)) continue;
+        out.AddThread(static_cast<uint32_t>(std::strtoul(e->d_name, nullptr, 10)));
+    }
+    ::closedir(task);   // closes fd
+}
+
+void LinuxSystemSnapshot::QuerySelfUsage(SelfUsage& out) {
+    out = SelfUsage{};
+    out.pid = static_cast<DWORD>(::getpid());
+
+    if (DIR* fds = ::opendir("/proc/self/fd")) {
+        DWORD count = 0;
+        while (dirent* e = ::readdir(fds)) {
+            if (IsNumeric(e->d_name)) ++count;
+        }
+        ::closedir(fds);
+        out.handleCount = count - 1;   // the directory stream's own fd
+    }
+
+    // statm: size resident shared text lib data dt (pages)
+    char buf[256];
+    if (ReadSmall(AT_FDCWD, "/proc/self/statm", buf, sizeof(buf)) > 0) {
+        unsigned long size = 0, resident = 0, shared = 0, text = 0, lib = 0, data = 0;
+        if (std::sscanf(buf, "%lu %lu %lu %lu %lu %lu", &size, &resident, &shared, &text, &lib, &data) == 6) {
+            const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            out.memoryValid = true;
+            out.privateBytes = (resident - shared) * page;   // anonymous resident (RssAnon)
+            out.workingSetBytes = resident * page;
+            out.pagefileBytes = data * page;                  // data + stack (commit analog)
+        }
+    }
+}
+
+} // namespace platform
+} // namespace unleaf
+
+#endif // __linux__
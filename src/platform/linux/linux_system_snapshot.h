@@ -0,0 +1,44 @@
+#pragma once
+// UnLeaf - Linux implementation of ISystemSnapshot (/proc, §9.38)
+// Toolhelp32 / NtQuerySystemInformation の Linux 版。/proc を 1 回走査して、プロセスと
+// スレッドを engine_logic::SystemSnapshot のアリーナへ書き込む。
+//
+//   プロセス   : /proc 直下の数字ディレクトリ (スレッドグループ = プロセス)
+//   親 PID     : /proc/<pid>/stat の ppid (comm は空白 / ')' を含み得るので最後の ')' 以降を読む)
+//   イメージ名 : /proc/<pid>/exe のファイル名部分 (netlink の ImageName と同じ)。
+//                読めない場合 (カーネルスレッド / 他ユーザーで ptrace 不可) は stat の comm (最大 15 バイト)
+//   スレッド   : /proc/<pid>/task の数字エントリ
+//   QuerySelfUsage : /proc/self/statm (ページ数) と /proc/self/fd のエントリ数
+//
+// 走査中に終了したプロセスは読めた範囲で省く (Toolhelp と同じくスナップショットは厳密な
+// 一時点ではない)。パス組み立ては /proc の dirfd からの openat で、文字列の割り当てなし。
+
+#ifdef __linux__
+
+#include "../platform.h"
+#include <string>
+
+namespace unleaf {
+namespace platform {
+
+class LinuxSystemSnapshot : public ISystemSnapshot {
+public:
+    bool Capture(engine_logic::SystemSnapshot& out) override;
+    void QuerySelfUsage(SelfUsage& out) override;
+
+private:
+    // ppid + start time (clock ticks since boot) + comm from <pid>/stat (relative to procFd);
+    // false when the process is gone
+    static bool ReadStat(int procFd, const char* pidDir, uint32_t& ppid, uint64_t& startTime,
+                         char* comm, size_t& commLen);
+    // File name part of <pid>/exe into nameScratch_; false when unreadable
+    bool ReadExeName(int procFd, const char* pidDir);
+    static void AddThreads(int procFd, const char* pidDir, engine_logic::SystemSnapshot& out);
+
+    std::wstring nameScratch_;   // reused decode buffer (Capture is single-threaded)
+};
+
+} // namespace platform
+} // namespace unleaf
+
+#endif // __linux__
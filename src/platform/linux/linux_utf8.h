@@ -0,0 +1,49 @@
+#pragma once
+// UnLeaf - UTF-8 decoding for /proc strings (exe links, comm)
+// netlink_process_monitor (§9.32) / linux_system_snapshot (§9.38) で共有。
+
+#ifdef __linux__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace unleaf {
+namespace platform {
+
+// Decodes UTF-8 into out (reused, no allocation once grown). Invalid bytes become U+FFFD.
+inline void DecodeUtf8(const char* s, size_t n, std::wstring& out) {
+    out.clear();
+    for (size_t i = 0; i < n;) {
+        const unsigned char c = static_cast<unsigned char>(s[i]);
+        uint32_t cp;
+        size_t len;
+        if (c < 0x80)                { cp = c;        len = 1; }
+        else if ((c & 0xE0) == 0xC0) { cp = c & 0x1F; len = 2; }
+        else if ((c & 0xF0) == 0xE0) { cp = c & 0x0F; len = 3; }
+        else if ((c & 0xF8) == 0xF0) { cp = c & 0x07; len = 4; }
+        else                         { out.push_back(0xFFFD); ++i; continue; }
+        if (i + len > n) {
+            out.push_back(0xFFFD);
+            break;
+        }
+        bool valid = true;
+        for (size_t k = 1; k < len; ++k) {
+            const unsigned char cc = static_cast<unsigned char>(s[i + k]);
+            if ((cc & 0xC0) != 0x80) { valid = false; break; }
+            cp = (cp << 6) | (cc & 0x3F);
+        }
+        if (!valid) {
+            out.push_back(0xFFFD);
+            ++i;
+            continue;
+        }
+        out.push_back(static_cast<wchar_t>(cp));
+        i += len;
+    }
+}
+
+} // namespace platform
+} // namespace unleaf
+
+#endif // __linux__
@@ -0,0 +1,411 @@
+// UnLeaf - Linux process event source (netlink proc connector, §9.32)
+
+#ifdef __linux__
+
+#include "netlink_process_monitor.h"
+#include "linux_utf8.h"
+#include "../../common/logger.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+
+namespace unleaf {
+namespace platform {
+
+NetlinkProcessMonitor::NetlinkProcessMonitor(size_t maxPendingForks)
+    : pendingForks_(maxPendingForks > 0 ? maxPendingForks : 1) {
+}
+
+NetlinkProcessMonitor::~NetlinkProcessMonitor() {
+    Stop();
+}
+
+ULONGLONG NetlinkProcessMonitor::NowMs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<ULONGLONG>(ts.tv_sec) * 1000 + static_cast<ULONGLONG>(ts.tv_nsec) / 1000000;
+}
+
+bool NetlinkProcessMonitor::Subscribe(bool listen) {
+    // nlmsghdr | cn_msg | PROC_CN_MCAST_* (cn_msg ends in a flexible array: build in bytes)
+    constexpr size_t kPayload = sizeof(cn_msg) + sizeof(uint32_t);
+    alignas(nlmsghdr) char buf[NLMSG_SPACE(kPayload)];
+    std::memset(buf, 0, sizeof(buf));
+    auto* nl = reinterpret_cast<nlmsghdr*>(buf);
+    nl->nlmsg_len = NLMSG_LENGTH(kPayload);
+    nl->nlmsg_type = NLMSG_DONE;
+    nl->nlmsg_pid = static_cast<uint32_t>(::getpid());
+    auto* cn = static_cast<cn_msg*>(NLMSG_DATA(nl));
+    cn->id.idx = CN_IDX_PROC;
+    cn->id.val = CN_VAL_PROC;
+    cn->len = sizeof(uint32_t);
+    const uint32_t op = listen ? PROC_CN_MCAST_LISTEN : PROC_CN_MCAST_IGNORE;
+    std::memcpy(cn->data, &op, sizeof(op));
+    return ::send(sock_, nl, nl->nlmsg_len, 0) == static_cast<ssize_t>(nl->nlmsg_len);
+}
+
+bool NetlinkProcessMonitor::Start(ProcessStartCallback processCallback,
+                                  ThreadStartCallback threadCallback) {
+    std::lock_guard<std::mutex> lock(stopMtx_);
+    if (running_.load()) return true;
+
+    sock_ = ::socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+    if (sock_ < 0) {
+        LOG_ERROR(L"[NETLINK] socket(NETLINK_CONNECTOR) failed (errno=" + std::to_wstring(errno) + L")");
+        return false;
+    }
+
+    sockaddr_nl addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = CN_IDX_PROC;
+    if (::bind(sock_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        LOG_ERROR(L"[NETLINK] bind(CN_IDX_PROC) failed (errno=" + std::to_wstring(errno) +
+                  L", CAP_NET_ADMIN required)");
+        ::close(sock_);
+        sock_ = -1;
+        return false;
+    }
+
+    // Large receive buffer: SO_RCVBUFFORCE ignores rmem_max when privileged
+    int rcvbuf = RCVBUF_BYTES;
+    if (::setsockopt(sock_, SOL_SOCKET, SO_RCVBUFFORCE, &rcvbuf, sizeof(rcvbuf)) != 0) {
+        ::setsockopt(sock_, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    }
+
+    if (!Subscribe(true)) {
+        LOG_ERROR(L"[NETLINK] PROC_CN_MCAST_LISTEN failed (errno=" + std::to_wstring(errno) + L")");
+        ::close(sock_);
+        sock_ = -1;
+        return false;
+    }
+
+    stopFd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (stopFd_ < 0) {
+        LOG_ERROR(L"[NETLINK] eventfd failed (errno=" + std::to_wstring(errno) + L")");
+        Subscribe(false);
+        ::close(sock_);
+        sock_ = -1;
+        return false;
+    }
+
+    processCallback_ = std::move(processCallback);
+    threadCallback_ = std::move(threadCallback);
+    eventCount_ = 0;
+    lostEventCount_ = 0;
+    lastCheckedLost_ = 0;
+    lastEventTime_ = 0;
+    threadFiltered_.Reset();
+    threadForwarded_.Reset();
+    stopRequested_ = false;
+    sessionHealthy_ = true;
+    running_ = true;
+
+    readerThread_ = std::thread(&NetlinkProcessMonitor::ReaderThread, this);
+    LOG_INFO(L"[NETLINK] Process connector subscribed (fork/exec/exit)");
+    return true;
+}
+
+void NetlinkProcessMonitor::Stop() {
+    std::lock_guard<std::mutex> lock(stopMtx_);
+    if (!running_.load() && !readerThread_.joinable()) return;
+
+    stopRequested_ = true;
+    const uint64_t one = 1;
+    (void)!::write(stopFd_, &one, sizeof(one));
+    if (readerThread_.joinable()) readerThread_.join();
+
+    Subscribe(false);
+    ::close(sock_);
+    ::close(stopFd_);
+    sock_ = -1;
+    stopFd_ = -1;
+    processCallback_ = nullptr;
+    threadCallback_ = nullptr;
+    running_ = false;
+    sessionHealthy_ = false;
+    traceWriter_.Flush();
+}
+
+bool NetlinkProcessMonitor::IsHealthy() const {
+    std::lock_guard<std::mutex> lock(stopMtx_);
+    if (!running_.load() || !sessionHealthy_.load()) return false;
+    // Sustained receive-buffer overflow since the last check
+    const uint32_t lost = lostEventCount_.load();
+    const bool healthy = (lost - lastCheckedLost_) <= LOST_EVENT_THRESHOLD;
+    lastCheckedLost_ = lost;
+    return healthy;
+}
+
+// §9.27: ProcessMonitor と同じく停止中にのみ切り替える。Start() 再実行後も同じファイルへ追記。
+bool NetlinkProcessMonitor::SetEventTraceFile(const std::wstring& path) {
+    std::lock_guard<std::mutex> lock(stopMtx_);
+    if (running_.load()) {
+        LOG_ERROR(L"[NETLINK] Event trace can only be changed while the monitor is stopped");
+        return false;
+    }
+    if (traceWriter_.IsOpen()) {
+        traceWriter_.Close();
+        wchar_t buf[128];
+        swprintf_s(buf, L"[NETLINK] Event trace closed: %llu records, %llu bytes%ls",
+                   static_cast<unsigned long long>(traceWriter_.RecordCount()),
+                   static_cast<unsigned long long>(traceWriter_.BytesWritten()),
+                   traceWriter_.HasFailed() ? L" (write error)" : L"");
+        LOG_INFO(buf);
+    }
+    if (path.empty()) return true;
+    if (!traceWriter_.Open(std::filesystem::path(path))) {
+        LOG_ERROR(L"[NETLINK] Cannot open event trace: " + path);
+        return false;
+    }
+    LOG_INFO(L"[NETLINK] Recording process/thread events to " + path);
+    return true;
+}
+
+void NetlinkProcessMonitor::SetThreadEventFilter(const engine_logic::PidBitmap* filter) {
+    std::lock_guard<std::mutex> lock(stopMtx_);
+    if (running_.load()) {
+        LOG_ERROR(L"[NETLINK] Thread event filter can only be changed while the monitor is stopped");
+        return;
+    }
+    threadFilter_ = filter;
+}
+
+ThreadEventFilterStats NetlinkProcessMonitor::GetThreadEventFilterStats() const {
+    const ULONGLONG now = NowMs();
+    ThreadEventFilterStats stats;
+    stats.filtered = threadFiltered_.Total();
+    stats.forwarded = threadForwarded_.Total();
+    stats.filteredPerSec = threadFiltered_.LastSecond(now);
+    stats.forwardedPerSec = threadForwarded_.LastSecond(now);
+    return stats;
+}
+
+bool NetlinkProcessMonitor::SetProcessExitCallback(ProcessExitCallback callback) {
+    std::lock_guard<std::mutex> lock(stopMtx_);
+    if (running_.load()) {
+        LOG_ERROR(L"[NETLINK] Exit callback can only be changed while the monitor is stopped");
+        return false;
+    }
+    exitCallback_ = std::move(callback);
+    return true;
+}
+
+void NetlinkProcessMonitor::ReaderThread() {
+    // NLMSG_GOODSIZE-aligned receive buffer: one recv returns one datagram (one event)
+    alignas(nlmsghdr) char buf[8192];
+
+    pollfd fds[2] = {{sock_, POLLIN, 0}, {stopFd_, POLLIN, 0}};
+    while (!stopRequested_.load(std::memory_order_acquire)) {
+        // Pending forks: wake up to emit the ones that never exec
+        if (::poll(fds, 2, HasPendingForks() ? FORK_EXEC_GRACE_MS : -1) < 0) {
+            if (errno == EINTR) continue;
+            LOG_ERROR(L"[NETLINK] poll failed (errno=" + std::to_wstring(errno) + L")");
+            sessionHealthy_ = false;
+            break;
+        }
+        if (fds[1].revents & POLLIN) break;
+
+        // Drain everything queued: one delivered batch per wakeup
+        for (;;) {
+            const ssize_t n = ::recv(sock_, buf, sizeof(buf), MSG_DONTWAIT);
+            if (n < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                if (errno == EINTR) continue;
+                if (errno == ENOBUFS) {
+                    // Kernel dropped datagrams (count unknown): one lost event per overflow
+                    lostEventCount_.fetch_add(1, std::memory_order_relaxed);
+                    const ULONGLONG now = NowMs();
+                    if (now - lastLostLogTime_ >= LOST_LOG_INTERVAL_MS) {
+                        lastLostLogTime_ = now;
+                        LOG_DEBUG(L"[NETLINK] Receive buffer overflow (ENOBUFS)");
+                    }
+                    continue;
+                }
+                LOG_ERROR(L"[NETLINK] recv failed (errno=" + std::to_wstring(errno) + L")");
+                sessionHealthy_ = false;
+                break;
+            }
+
+            int remaining = static_cast<int>(n);
+            for (auto* nl = reinterpret_cast<nlmsghdr*>(buf); NLMSG_OK(nl, remaining);
+                 nl = NLMSG_NEXT(nl, remaining)) {
+                if (nl->nlmsg_type == NLMSG_NOOP || nl->nlmsg_type == NLMSG_ERROR) continue;
+                const auto* cn = static_cast<const cn_msg*>(NLMSG_DATA(nl));
+                if (cn->id.idx != CN_IDX_PROC || cn->id.val != CN_VAL_PROC) continue;
+                if (cn->len < sizeof(proc_event)) continue;
+                HandleEvent(*reinterpret_cast<const proc_event*>(cn->data));
+            }
+        }
+        if (!sessionHealthy_.load(std::memory_order_relaxed)) break;
+        ExpirePendingForks(NowMs(), false);
+        FlushProcessStarts();
+    }
+    ExpirePendingForks(NowMs(), true);
+    FlushProcessStarts();
+}
+
+void NetlinkProcessMonitor::HandleEvent(const proc_event& ev) {
+    const ULONGLONG now = NowMs();
+    const uint64_t timestampUs = ev.timestamp_ns / 1000;
+
+    switch (ev.what) {
+        case proc_event::PROC_EVENT_FORK: {
+            const auto& f = ev.event_data.fork;
+            eventCount_.fetch_add(1, std::memory_order_relaxed);
+            lastEventTime_.store(now, std::memory_order_relaxed);
+            if (f.child_pid != f.child_tgid) {
+                // New thread in an existing process
+                const DWORD ownerPid = static_cast<DWORD>(f.child_tgid);
+                const DWORD threadId = static_cast<DWORD>(f.child_pid);
+                if (traceWriter_.IsOpen()) traceWriter_.AppendThreadStart(timestampUs, ownerPid, threadId);
+                if (!threadCallback_) return;
+                // §9.28: untracked owners stop here
+                if (threadFilter_ && !threadFilter_->Test(ownerPid)) {
+                    threadFiltered_.Add(now);
+                    return;
+                }
+                threadForwarded_.Add(now);
+                threadCallback_(threadId, ownerPid);
+                return;
+            }
+            // Image is still the parent's: wait for the exec (ExpirePendingForks)
+            if (pendingForkCount_ == pendingForks_.size()) {
+                // Ring full: its exec (if any) still arrives with the /proc parent
+                pendingForkDrops_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            pendingForks_[(pendingForkHead_ + pendingForkCount_) % pendingForks_.size()] =
+                {static_cast<uint32_t>(f.child_tgid), static_cast<uint32_t>(f.parent_tgid), timestampUs, now};
+            ++pendingForkCount_;
+            return;
+        }
+        case proc_event::PROC_EVENT_EXEC: {
+            const auto& e = ev.event_data.exec;
+            eventCount_.fetch_add(1, std::memory_order_relaxed);
+            lastEventTime_.store(now, std::memory_order_relaxed);
+            const uint32_t pid = static_cast<uint32_t>(e.process_tgid);
+            uint32_t parentPid = 0;
+            if (!TakePendingFork(pid, &parentPid)) parentPid = ReadParentPid(pid);
+            AppendProcessStart(pid, parentPid, timestampUs);
+            return;
+        }
+        case proc_event::PROC_EVENT_EXIT: {
+            const auto& x = ev.event_data.exit;
+            if (x.process_pid != x.process_tgid) return;   // thread exit
+            eventCount_.fetch_add(1, std::memory_order_relaxed);
+            lastEventTime_.store(now, std::memory_order_relaxed);
+            TakePendingFork(static_cast<uint32_t>(x.process_tgid), nullptr);   // never exec'd: nothing to enforce
+            if (!exitCallback_) return;
+            // Starts staged before this exit reach the engine first (Start -> Exit order per PID)
+            FlushProcessStarts();
+            exitCallback_(static_cast<DWORD>(x.process_tgid));
+            return;
+        }
+        default:
+            return;
+    }
+}
+
+void NetlinkProcessMonitor::AppendProcessStart(uint32_t pid, uint32_t parentPid, uint64_t timestampUs) {
+    if (!ReadImage(pid)) return;   // exited before we could look: nothing to enforce
+    if (pendingStarts_.Full()) FlushProcessStarts();
+    pendingStarts_.Append(pid, parentPid, imageScratch_);
+    if (traceWriter_.IsOpen()) {
+        const size_t last = pendingStarts_.Size() - 1;
+        traceWriter_.AppendProcessStart(timestampUs, pid, parentPid,
+                                        pendingStarts_.ImageName(last), pendingStarts_.ImagePath(last));
+    }
+}
+
+bool NetlinkProcessMonitor::TakePendingFork(uint32_t pid, uint32_t* parentPid) {
+    // exec follows its fork closely: search from the newest
+    for (size_t i = pendingForkCount_; i > 0; --i) {
+        PendingFork& f = pendingForks_[(pendingForkHead_ + i - 1) % pendingForks_.size()];
+        if (f.pid != pid) continue;
+        if (parentPid) *parentPid = f.parentPid;
+        f.pid = 0;
+        return true;
+    }
+    return false;
+}
+
+void NetlinkProcessMonitor::ExpirePendingForks(ULONGLONG now, bool force) {
+    while (pendingForkCount_ > 0) {
+        const PendingFork& f = pendingForks_[pendingForkHead_];
+        if (f.pid != 0) {
+            if (!force && now - f.seenMs < static_cast<ULONGLONG>(FORK_EXEC_GRACE_MS)) break;
+            AppendProcessStart(f.pid, f.parentPid, f.timestampUs);
+        }
+        pendingForkHead_ = (pendingForkHead_ + 1) % pendingForks_.size();
+        --pendingForkCount_;
+    }
+}
+
+void NetlinkProcessMonitor::FlushProcessStarts() {
+    if (pendingStarts_.Empty()) return;
+    if (processCallback_) processCallback_(pendingStarts_);
+    pendingStarts_.Clear();
+}
+
+bool NetlinkProcessMonitor::ReadImage(uint32_t pid) {
+    char path[64];
+    char target[4096];
+    std::snprintf(path, sizeof(path), "/proc/%u/exe", pid);
+    ssize_t n = ::readlink(path, target, sizeof(target));
+    if (n > 0 && n < static_cast<ssize_t>(sizeof(target))) {
+        static const char kDeleted[] = " (deleted)";
+        constexpr size_t kDeletedLen = sizeof(kDeleted) - 1;
+        if (static_cast<size_t>(n) > kDeletedLen &&
+            std::memcmp(target + n - kDeletedLen, kDeleted, kDeletedLen) == 0) {
+            n -= static_cast<ssize_t>(kDeletedLen);
+        }
+        DecodeUtf8(target, static_cast<size_t>(n), imageScratch_);
+        return true;
+    }
+
+    // Kernel threads / no ptrace access: bare name (no path) from comm
+    std::snprintf(path, sizeof(path), "/proc/%u/comm", pid);
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    n = ::read(fd, target, 64);
+    ::close(fd);
+    if (n <= 0) return false;
+    if (target[n - 1] == '\n') --n;
+    DecodeUtf8(target, static_cast<size_t>(n), imageScratch_);
+    return !imageScratch_.empty();
+}
+
+uint32_t NetlinkProcessMonitor::ReadParentPid(uint32_t pid) {
+    char path[64];
+    std::snprintf(path, sizeof(path), "/proc/%u/stat", pid);
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+    char buf[512];
+    const ssize_t n = ::read(fd, buf, sizeof(buf) - 1);
+    ::close(fd);
+    if (n <= 0) return 0;
+    buf[n] = '\0';
+    // "pid (comm) state ppid ...": comm may contain spaces and ')' — use the last ')'
+    const char* rparen = std::strrchr(buf, ')');
+    if (!rparen) return 0;
+    char state = 0;
+    unsigned ppid = 0;
+    if (std::sscanf(rparen + 1, " %c %u", &state, &ppid) != 2) return 0;
+    return ppid;
+}
+
+} // namespace platform
+} // namespace unleaf
+
+#endif // __linux__
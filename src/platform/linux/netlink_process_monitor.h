@@ -0,0 +1,131 @@
+#pragma once
+// UnLeaf - Linux process event source (netlink proc connector, §9.32)
+// ETW ProcessMonitor の Linux 版。NETLINK_CONNECTOR / CN_IDX_PROC を購読し、
+// PROC_EVENT_FORK / EXEC / EXIT を IProcessEventSource の契約に写す。/proc のポーリングはしない。
+//
+//   FORK (child_pid == child_tgid) : 保留 (FORK_EXEC_GRACE_MS 以内に EXEC が来なければ ProcessStart、
+//                                    image = 子の /proc/<pid>/exe = 親と同じ)
+//   FORK (child_pid != child_tgid) : ThreadStart (tid = child_pid, owner = child_tgid)
+//   EXEC                           : ProcessStart (同じ PID の新しいイメージ、親は保留中の FORK、
+//                                    なければ /proc/<pid>/stat)。保留中の FORK は捨てる
+//   EXIT (process_pid == tgid)     : ProcessExit (スレッドグループリーダー = プロセス終了)。
+//                                    保留中の FORK (exec せず終了) は捨てる
+//
+// fork + exec は 1 PID につき ProcessStart 1 件 (exec 後のイメージ)。fork 時点のイメージ
+// (親のバイナリ) で子をターゲットと誤分類しない。exec しない fork は猶予後に親のイメージで届く。
+// 保留は固定長リング (maxPendingForks)。満杯時の新しい FORK は保留せず捨てて数える
+// (exec すれば EXEC が /proc の親で届く。exec しない子は SafetyNet 走査が拾う)。
+// 1 回の poll で読めた分を 1 バッチとして processCallback_ に渡す (§9.29 の ETW バッファ相当)。
+// Exit を渡す前に溜めた ProcessStart を先に flush し、同一 PID の Start → Exit の順序を保つ。
+// 購読には CAP_NET_ADMIN が必要。ソケット受信バッファ溢れ (ENOBUFS) は lost event として数える。
+
+#ifdef __linux__
+
+#include "../platform.h"
+#include "../../engine/event_batch.h"
+#include "../../engine/event_trace.h"
+#include "../../engine/pid_bitmap.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct proc_event;
+
+namespace unleaf {
+namespace platform {
+
+class NetlinkProcessMonitor : public IProcessEventSource {
+public:
+    static constexpr size_t MAX_PENDING_FORKS = 1024;   // fork storms beyond this drop the grace wait
+
+    explicit NetlinkProcessMonitor(size_t maxPendingForks = MAX_PENDING_FORKS);
+    ~NetlinkProcessMonitor() override;
+
+    bool Start(ProcessStartCallback processCallback,
+               ThreadStartCallback threadCallback = nullptr) override;
+    void Stop() override;
+    bool IsRunning() const { return running_.load(); }
+    bool IsHealthy() const override;
+    uint32_t GetEventCount() const override { return eventCount_.load(); }
+    uint32_t GetLostEventCount() const override { return lostEventCount_.load(); }
+    ULONGLONG GetLastEventTime() const override { return lastEventTime_.load(); }
+    // Forks not held for their exec because the pending ring was full
+    uint32_t GetPendingForkDropCount() const { return pendingForkDrops_.load(); }
+
+    bool SetEventTraceFile(const std::wstring& path) override;
+    void SetThreadEventFilter(const engine_logic::PidBitmap* filter) override;
+    ThreadEventFilterStats GetThreadEventFilterStats() const override;
+    // Exits come from PROC_EVENT_EXIT: always supported
+    bool SetProcessExitCallback(ProcessExitCallback callback) override;
+
+    // CLOCK_MONOTONIC milliseconds (GetLastEventTime / per-second rates)
+    static ULONGLONG NowMs();
+
+private:
+    void ReaderThread();
+    // One proc connector event (ReaderThread)
+    void HandleEvent(const proc_event& ev);
+    void AppendProcessStart(uint32_t pid, uint32_t parentPid, uint64_t timestampUs);
+    void FlushProcessStarts();
+    // Pending fork of pid resolved by its exec / exit. false = none pending.
+    bool TakePendingFork(uint32_t pid, uint32_t* parentPid);
+    // Forks older than FORK_EXEC_GRACE_MS (all when force) become process starts
+    void ExpirePendingForks(ULONGLONG now, bool force);
+    bool HasPendingForks() const { return pendingForkCount_ > 0; }
+    bool Subscribe(bool listen);
+
+    // /proc/<pid>/exe into imageScratch_ (falls back to /proc/<pid>/comm); false = process gone
+    bool ReadImage(uint32_t pid);
+    static uint32_t ReadParentPid(uint32_t pid);
+
+    int sock_ = -1;
+    int stopFd_ = -1;   // eventfd: wakes ReaderThread from poll on Stop()
+
+    mutable std::mutex stopMtx_;   // Start / Stop / Set* (ReaderThread never takes it)
+    std::thread readerThread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stopRequested_{false};
+    std::atomic<bool> sessionHealthy_{false};
+
+    std::atomic<ULONGLONG> lastEventTime_{0};
+    std::atomic<uint32_t> eventCount_{0};
+    std::atomic<uint32_t> lostEventCount_{0};
+    std::atomic<uint32_t> pendingForkDrops_{0};
+    ULONGLONG lastLostLogTime_ = 0;              // ReaderThread only
+    mutable uint32_t lastCheckedLost_ = 0;       // stopMtx_
+
+    // Set only while stopped (published to the ReaderThread by its creation)
+    ProcessStartCallback processCallback_;
+    ThreadStartCallback threadCallback_;
+    ProcessExitCallback exitCallback_;
+    const engine_logic::PidBitmap* threadFilter_ = nullptr;
+    engine_logic::EventTraceWriter traceWriter_;
+
+    // ReaderThread only
+    engine_logic::ProcessStartBatch pendingStarts_;
+    std::wstring imageScratch_;
+    struct PendingFork {
+        uint32_t pid;         // 0 = resolved (exec / exit)
+        uint32_t parentPid;
+        uint64_t timestampUs;
+        ULONGLONG seenMs;
+    };
+    // Ring in arrival order: pendingForkCount_ entries from pendingForkHead_ (fixed capacity)
+    std::vector<PendingFork> pendingForks_;
+    size_t pendingForkHead_ = 0;
+    size_t pendingForkCount_ = 0;
+    engine_logic::PerSecondCounter threadFiltered_;
+    engine_logic::PerSecondCounter threadForwarded_;
+
+    static constexpr int RCVBUF_BYTES = 4 * 1024 * 1024;   // absorbs fork storms between polls
+    static constexpr uint32_t LOST_EVENT_THRESHOLD = 10;    // lost (delta) above this = unhealthy
+    static constexpr ULONGLONG LOST_LOG_INTERVAL_MS = 10000;
+    static constexpr int FORK_EXEC_GRACE_MS = 20;   // fork -> exec window (start of fork-only children)
+};
+
+} // namespace platform
+} // namespace unleaf
+
+#endif // __linux__
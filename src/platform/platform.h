@@ -0,0 +1,344 @@
+#pragma once
+// UnLeaf - OS Abstraction Layer
+// EngineCore の制御ループ (Dispatch / HandleSafetyNetCheck / ApplyOptimizationWithHandle)
+// が直接触っていた Win32 API を、用途ごとの小さなインターフェースに切り出したもの。
+//
+//   IProcessControl     : OpenProcess / SetPriorityClass / EcoQoS / Job / exit wait
+//   ISystemSnapshot     : process + thread snapshot in one pass (§9.38), self memory counters
+//   ITimerService       : CreateTimerQueueTimer (one-shot / periodic callbacks)
+//   IClock              : GetTickCount64 / QueryPerformanceCounter / Sleep
+//   IEventService       : events, waitable timer, directory watch, WaitForMultipleObjects
+//   IProcessEventSource : ETW process/thread start notifications (ProcessMonitor)
+//                         Linux: netlink proc connector, incl. exits (NetlinkProcessMonitor)
+//   IPolicyStore        : IFEO / PowerThrottling registry policies (RegistryPolicyManager)
+//
+// Win32 実装: src/platform/win32/win32_platform.{h,cpp}
+// テスト用インメモリ実装: src/platform/fake/fake_platform.{h,cpp}
+// Linux 実装: src/platform/linux/linux_process_control.{h,cpp} (IProcessControl、§9.31)
+//             src/platform/linux/netlink_process_monitor.{h,cpp} (IProcessEventSource、§9.32)
+//             src/platform/linux/linux_event_service.{h,cpp} (IEventService、epoll、§9.33)
+//             src/platform/linux/linux_system_snapshot.{h,cpp} (ISystemSnapshot、/proc、§9.38)
+//
+// 契約は Win32 API の意味論をそのまま写す (戻り値 WAIT_OBJECT_0+i / WAIT_TIMEOUT、
+// 失敗時 nullptr + LastError())。EngineCore 側のエラー処理・ログ文言を変えないため。
+
+#include "../common/types.h"
+#include "../engine/event_batch.h"
+#include "../engine/system_snapshot.h"
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace engine_logic {
+class PidBitmap;
+}
+
+namespace unleaf {
+
+// Callback type for process start events (§9.29: one call per delivered batch)
+// batch.ImageName(i): filename only (e.g. "chrome.exe")
+// batch.ImagePath(i): full image path from ETW, hint only — may be empty, 8.3, or device-format
+// The batch is reused by the event source: views are valid for the duration of the call.
+using ProcessStartCallback = std::function<void(const engine_logic::ProcessStartBatch& batch)>;
+
+// Callback type for thread start events (used to detect EcoQoS re-enablement triggers)
+// threadId: the new thread (not the creator), 0 when the source cannot tell (§9.39)
+using ThreadStartCallback = std::function<void(DWORD threadId, DWORD ownerPid)>;
+
+// Callback type for process exit events (§9.32: sources whose event stream carries exits)
+// Called for every exiting process (unfiltered); the engine drops untracked PIDs itself.
+using ProcessExitCallback = std::function<void(DWORD pid)>;
+
+namespace platform {
+
+// Opaque OS handle (HANDLE on Windows, implementation-defined token elsewhere)
+using NativeHandle = HANDLE;
+
+// Threadpool callback signatures (WAITORTIMERCALLBACK-compatible)
+using TimerCallback = void (CALLBACK*)(PVOID context, BOOLEAN timerOrWaitFired);
+using WaitCallback  = void (CALLBACK*)(PVOID context, BOOLEAN timerOrWaitFired);
+
+class IProcessControl;
+
+// Move-only owner of a process/job handle obtained from IProcessControl.
+// Closes through the owning IProcessControl (CloseHandle on Win32).
+class OwnedHandle {
+public:
+    OwnedHandle() noexcept = default;
+    OwnedHandle(IProcessControl& owner, NativeHandle h) noexcept
+        : owner_(&owner), handle_((h && h != INVALID_HANDLE_VALUE) ? h : nullptr) {}
+    ~OwnedHandle() { reset(); }
+
+    OwnedHandle(OwnedHandle&& other) noexcept
+        : owner_(other.owner_), handle_(other.handle_) {
+        other.handle_ = nullptr;
+    }
+    OwnedHandle& operator=(OwnedHandle&& other) noexcept {
+        if (this != &other) {
+            reset();
+            owner_ = other.owner_;
+            handle_ = other.handle_;
+            other.handle_ = nullptr;
+        }
+        return *this;
+    }
+    OwnedHandle(const OwnedHandle&) = delete;
+    OwnedHandle& operator=(const OwnedHandle&) = delete;
+
+    NativeHandle get() const noexcept { return handle_; }
+    explicit operator bool() const noexcept { return handle_ != nullptr; }
+
+    NativeHandle release() noexcept {
+        NativeHandle h = handle_;
+        handle_ = nullptr;
+        return h;
+    }
+
+    inline void reset() noexcept;
+
+private:
+    IProcessControl* owner_ = nullptr;
+    NativeHandle handle_ = nullptr;
+};
+
+// Self resource counters (GetProcessMemoryInfo / GetProcessHandleCount)
+struct SelfUsage {
+    DWORD  pid = 0;
+    DWORD  handleCount = 0;
+    bool   memoryValid = false;
+    size_t privateBytes = 0;
+    size_t workingSetBytes = 0;
+    size_t pagefileBytes = 0;
+};
+
+// Outcome of the EcoQoS OFF step of PulseEnforceV6
+struct EcoQoSResult {
+    bool  success = false;       // EcoQoS is now OFF for the process
+    bool  usedNtApi = false;     // NtSetInformationProcess path was attempted
+    bool  ntFallback = false;    // NT API failed and the Win32 path was used instead
+    LONG  ntStatus = 0;          // NTSTATUS of the NT attempt (when usedNtApi)
+    DWORD error = 0;             // Win32 error code when !success
+};
+
+enum class JobAssignResult : uint8_t {
+    ASSIGNED,        // new job created and process assigned (outJob owned by caller)
+    ALREADY_IN_JOB,  // process already belongs to a (foreign) job
+    CREATE_FAILED,   // CreateJobObject failed
+    ASSIGN_FAILED    // AssignProcessToJobObject failed
+};
+
+// ----------------------------------------------------------------------------
+// IProcessControl
+// ----------------------------------------------------------------------------
+class IProcessControl {
+public:
+    virtual ~IProcessControl() = default;
+
+    // One-time setup (NT API resolution, OS version detection + logging)
+    virtual void Initialize() = 0;
+
+    // PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_SET_INFORMATION
+    virtual NativeHandle OpenControl(DWORD pid) = 0;
+    // PROCESS_QUERY_LIMITED_INFORMATION
+    virtual NativeHandle OpenQuery(DWORD pid) = 0;
+    // SYNCHRONIZE (exit wait registration)
+    virtual NativeHandle OpenSynchronize(DWORD pid) = 0;
+    virtual void CloseHandle(NativeHandle h) = 0;
+    // Error code of the last failed call on this thread (GetLastError semantics)
+    virtual DWORD LastError() = 0;
+
+    virtual bool QueryExitCode(NativeHandle process, DWORD& exitCode) = 0;
+    // Raw image path (QueryFullProcessImageNameW); empty on failure
+    virtual std::wstring QueryImageName(NativeHandle process) = 0;
+    // Canonical image path (QueryFullProcessImageNameW + GetFinalPathNameByHandleW,
+    // lowercase, no \\?\ prefix); empty on failure
+    virtual std::wstring ResolveImagePath(NativeHandle process) = 0;
+    virtual bool FileExists(const std::wstring& path) = 0;
+
+    virtual bool SetPriorityClass(NativeHandle process, DWORD priorityClass) = 0;
+    // true when the full EcoQoS control mask (incl. IGNORE_TIMER) is supported (Win11+)
+    virtual bool SupportsFullEcoQoS() const = 0;
+    virtual EcoQoSResult SetEcoQoSOff(NativeHandle process, ULONG controlMask, bool preferNtApi) = 0;
+    virtual bool IsEcoQoSEnabled(NativeHandle process) = 0;
+    // Disable thread-level throttling for every thread of pid; returns threads touched
+    virtual int DisableThreadThrottling(DWORD pid, bool aggressive) = 0;
+    // §9.38: same for the listed threads of pid (from an ISystemSnapshot capture) — no
+    // thread walk of its own. Threads that exited since the capture are skipped.
+    virtual int DisableThreadThrottling(DWORD pid, const uint32_t* threadIds, size_t count,
+                                        bool aggressive) = 0;
+
+    // RegisterWaitForSingleObject(WT_EXECUTEONLYONCE) / UnregisterWaitEx(INVALID_HANDLE_VALUE)
+    virtual bool RegisterExitWait(NativeHandle* outWait, NativeHandle process,
+                                  WaitCallback callback, PVOID context) = 0;
+    virtual bool UnregisterExitWait(NativeHandle wait) = 0;
+
+    virtual JobAssignResult AssignToNewJob(NativeHandle process, NativeHandle* outJob) = 0;
+    // Fills up to capacity PIDs; false on query failure
+    virtual bool QueryJobProcessIds(NativeHandle job, DWORD* pids, DWORD capacity,
+                                    DWORD* count) = 0;
+
+    // Low-fragmentation heap for the service process (best effort)
+    virtual void OptimizeSelfHeap() = 0;
+};
+
+inline void OwnedHandle::reset() noexcept {
+    if (handle_ && owner_) {
+        owner_->CloseHandle(handle_);
+    }
+    handle_ = nullptr;
+}
+
+// ----------------------------------------------------------------------------
+// ISystemSnapshot
+// ----------------------------------------------------------------------------
+class ISystemSnapshot {
+public:
+    virtual ~ISystemSnapshot() = default;
+
+    // §9.38: every process with its threads in one pass (out is cleared first, its capacity
+    // reused; Finish()ed on success). false when the snapshot could not be taken.
+    virtual bool Capture(engine_logic::SystemSnapshot& out) = 0;
+    virtual void QuerySelfUsage(SelfUsage& out) = 0;
+};
+
+// ----------------------------------------------------------------------------
+// ITimerService
+// ----------------------------------------------------------------------------
+class ITimerService {
+public:
+    virtual ~ITimerService() = default;
+
+    virtual NativeHandle CreateQueue() = 0;
+    // waitForCallbacks=true: block until in-flight callbacks complete
+    virtual bool DeleteQueue(NativeHandle queue, bool waitForCallbacks) = 0;
+    // periodMs == 0: one-shot (WT_EXECUTEONLYONCE)
+    virtual bool CreateTimer(NativeHandle* outTimer, NativeHandle queue,
+                             TimerCallback callback, PVOID context,
+                             DWORD dueTimeMs, DWORD periodMs) = 0;
+    virtual bool DeleteTimer(NativeHandle queue, NativeHandle timer, bool waitForCallbacks) = 0;
+    virtual DWORD LastError() = 0;
+};
+
+// ----------------------------------------------------------------------------
+// IClock
+// ----------------------------------------------------------------------------
+class IClock {
+public:
+    virtual ~IClock() = default;
+
+    virtual ULONGLONG NowMs() = 0;   // monotonic ms (GetTickCount64)
+    virtual ULONGLONG NowUs() = 0;   // monotonic µs (QueryPerformanceCounter)
+    virtual void SleepMs(DWORD ms) = 0;
+};
+
+// ----------------------------------------------------------------------------
+// IEventService
+// ----------------------------------------------------------------------------
+class IEventService {
+public:
+    virtual ~IEventService() = default;
+
+    virtual NativeHandle CreateEventObject(bool manualReset) = 0;
+    virtual bool SetEvent(NativeHandle event) = 0;
+    virtual bool ResetEvent(NativeHandle event) = 0;
+    virtual void CloseHandle(NativeHandle h) = 0;
+
+    // Waitable timer (auto-reset, signals every periodMs after dueMs)
+    virtual NativeHandle CreatePeriodicTimer() = 0;
+    virtual bool ArmPeriodicTimer(NativeHandle timer, DWORD dueMs, DWORD periodMs) = 0;
+
+    // §9.34: change notification for one file in a directory (no subtree): signaled when
+    // fileName is written or replaced (rename onto it). Writes to other files in the
+    // directory (UnLeaf.log) never signal it. Stays signaled until RearmDirectoryWatch.
+    // Returns INVALID_HANDLE_VALUE on failure.
+    virtual NativeHandle WatchDirectory(const std::wstring& directory, const std::wstring& fileName) = 0;
+    virtual bool RearmDirectoryWatch(NativeHandle watch) = 0;
+    virtual void CloseDirectoryWatch(NativeHandle watch) = 0;
+
+    // WaitForMultipleObjects(bWaitAll=FALSE): WAIT_OBJECT_0+i / WAIT_TIMEOUT / WAIT_FAILED
+    virtual DWORD WaitAny(const NativeHandle* handles, DWORD count, DWORD timeoutMs) = 0;
+    virtual DWORD LastError() = 0;
+};
+
+// ----------------------------------------------------------------------------
+// IProcessEventSource
+// ----------------------------------------------------------------------------
+
+// §9.28: thread-start prefilter outcome (cumulative + last completed second)
+struct ThreadEventFilterStats {
+    uint64_t filtered = 0;           // rejected by the PID bitmap
+    uint64_t forwarded = 0;          // handed to the thread callback
+    uint32_t filteredPerSec = 0;
+    uint32_t forwardedPerSec = 0;
+};
+
+class IProcessEventSource {
+public:
+    virtual ~IProcessEventSource() = default;
+
+    virtual bool Start(ProcessStartCallback processCallback,
+                       ThreadStartCallback threadCallback = nullptr) = 0;
+    virtual void Stop() = 0;
+    virtual bool IsHealthy() const = 0;
+    virtual uint32_t GetEventCount() const = 0;
+    virtual uint32_t GetLostEventCount() const = 0;
+    virtual ULONGLONG GetLastEventTime() const = 0;
+
+    // §9.27: record every delivered process/thread start to a binary trace
+    // (engine_logic::EventTraceWriter). Empty path = stop recording (flush + close).
+    // Call while stopped; the file stays open across Stop()/Start() (ETW restarts).
+    virtual bool SetEventTraceFile(const std::wstring& path) = 0;
+
+    // §9.28: PID prefilter for thread-start events (owned by the caller, outlives Start/Stop).
+    // Events whose owner PID bit is clear are counted and dropped before the thread callback.
+    // nullptr = forward everything. Call while stopped.
+    virtual void SetThreadEventFilter(const engine_logic::PidBitmap* filter) = 0;
+    virtual ThreadEventFilterStats GetThreadEventFilterStats() const = 0;
+
+    // §9.32: process exits from the event stream itself (netlink PROC_EVENT_EXIT).
+    // false = this source cannot report exits (ETW): EngineCore keeps per-process exit waits.
+    // Call while stopped; the callback survives Stop()/Start() like the trace file.
+    virtual bool SetProcessExitCallback(ProcessExitCallback callback) = 0;
+};
+
+// ----------------------------------------------------------------------------
+// IPolicyStore
+// ----------------------------------------------------------------------------
+class IPolicyStore {
+public:
+    virtual ~IPolicyStore() = default;
+
+    virtual bool Initialize(const std::wstring& baseDir) = 0;
+    virtual bool ApplyPolicy(const std::wstring& exeName, const std::wstring& fullPath) = 0;
+    virtual bool ApplyIFEOOnly(const std::wstring& exeName) = 0;
+    virtual void ReconcileWithConfig(const std::set<std::wstring>& targetNames,
+                                     const std::set<std::wstring>& targetPaths) = 0;
+    virtual void CleanupAllPolicies() = 0;
+    virtual void VerifyAndRepair() = 0;
+    virtual bool IsPolicyValid(const std::wstring& canonPath) const = 0;
+    virtual bool HasPolicy(const std::wstring& canonPath) const = 0;
+    virtual int32_t GetPendingQueueSize() const = 0;
+    virtual bool ConsumePendingOverflowFlag() = 0;
+};
+
+// Aggregate handed to EngineCore
+struct Platform {
+    IProcessControl&     process;
+    ISystemSnapshot&     snapshot;
+    ITimerService&       timers;
+    IClock&              clock;
+    IEventService&       events;
+    IProcessEventSource& monitor;
+    IPolicyStore&        policy;
+};
+
+#if defined(_WIN32) || defined(__linux__)
+// Process-wide native implementation (win32_platform.cpp / linux/linux_platform.cpp)
+Platform& NativePlatform();
+#endif
+
+} // namespace platform
+} // namespace unleaf
@@ -0,0 +1,851 @@
+// UnLeaf - Win32 implementation of the OS abstraction layer
+
+#ifdef _WIN32
+
+#include "win32_platform.h"
+#include "../../common/logger.h"
+#include "../../common/registry_manager.h"
+#include "../../service/process_monitor.h"
+#include <algorithm>
+#include <tlhelp32.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+
+namespace unleaf {
+namespace platform {
+
+// ============================================================================
+// Win32ProcessControl
+// ============================================================================
+
+void Win32ProcessControl::Initialize() {
+    // Load NT API functions from ntdll.dll
+    ntdllHandle_ = GetModuleHandleW(L"ntdll.dll");
+    if (ntdllHandle_) {
+        pfnNtSetInformationProcess_ = reinterpret_cast<PFN_NtSetInformationProcess>(
+            GetProcAddress(ntdllHandle_, "NtSetInformationProcess"));
+        pfnNtQueryInformationProcess_ = reinterpret_cast<PFN_NtQueryInformationProcess>(
+            GetProcAddress(ntdllHandle_, "NtQueryInformationProcess"));
+
+        ntApiAvailable_ = (pfnNtSetInformationProcess_ != nullptr);
+        if (ntApiAvailable_) {
+            LOG_DEBUG(L"Engine: NtSetInformationProcess available");
+        } else {
+            LOG_ALERT(L"Engine: NtSetInformationProcess not found");
+        }
+    } else {
+        LOG_ALERT(L"Engine: ntdll.dll not loaded");
+    }
+
+    // Detect Windows version for compatibility
+    typedef NTSTATUS(WINAPI* RtlGetVersionPtr)(PRTL_OSVERSIONINFOW);
+    RtlGetVersionPtr RtlGetVersion = nullptr;
+    if (ntdllHandle_) {
+        RtlGetVersion = reinterpret_cast<RtlGetVersionPtr>(
+            GetProcAddress(ntdllHandle_, "RtlGetVersion"));
+    }
+
+    if (RtlGetVersion) {
+        RTL_OSVERSIONINFOW osvi = {};
+        osvi.dwOSVersionInfoSize = sizeof(osvi);
+        if (RtlGetVersion(&osvi) == 0) {
+            winVersion_.major = osvi.dwMajorVersion;
+            winVersion_.minor = osvi.dwMinorVersion;
+            winVersion_.build = osvi.dwBuildNumber;
+            winVersion_.isWindows11OrLater = (osvi.dwBuildNumber >= WINDOWS_11_BUILD_THRESHOLD);
+        }
+    }
+
+    // Log detected version
+    wchar_t osName[16];
+    if (winVersion_.major >= 11) {
+        // Windows 12 以降で major が繰り上がった場合は major.minor をそのまま表示
+        swprintf_s(osName, L"%lu.%lu", winVersion_.major, winVersion_.minor);
+    } else if (winVersion_.isWindows11OrLater) {
+        // major=10 だが build >= 22000 → Windows 11
+        wcscpy_s(osName, L"11");
+    } else {
+        // build < 22000 → Windows 10
+        wcscpy_s(osName, L"10");
+    }
+
+    wchar_t verBuf[128];
+    swprintf_s(verBuf, L"Engine: Windows %s (Build %lu) - %s",
+               osName, winVersion_.build,
+               winVersion_.isWindows11OrLater ? L"Full EcoQoS support" : L"Limited EcoQoS (Win10 compatibility mode)");
+    LOG_INFO(verBuf);
+}
+
+NativeHandle Win32ProcessControl::OpenControl(DWORD pid) {
+    return ::OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_SET_INFORMATION, FALSE, pid);
+}
+
+NativeHandle Win32ProcessControl::OpenQuery(DWORD pid) {
+    return ::OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+}
+
+NativeHandle Win32ProcessControl::OpenSynchronize(DWORD pid) {
+    return ::OpenProcess(SYNCHRONIZE, FALSE, pid);
+}
+
+void Win32ProcessControl::CloseHandle(NativeHandle h) {
+    if (h && h != INVALID_HANDLE_VALUE) {
+        ::CloseHandle(h);
+    }
+}
+
+DWORD Win32ProcessControl::LastError() {
+    return ::GetLastError();
+}
+
+bool Win32ProcessControl::QueryExitCode(NativeHandle process, DWORD& exitCode) {
+    return ::GetExitCodeProcess(process, &exitCode) != FALSE;
+}
+
+std::wstring Win32ProcessControl::QueryImageName(NativeHandle process) {
+    wchar_t nameBuffer[MAX_PATH];
+    DWORD nameSize = MAX_PATH;
+    if (!::QueryFullProcessImageNameW(process, 0, nameBuffer, &nameSize)) {
+        return L"";
+    }
+    return std::wstring(nameBuffer, nameSize);
+}
+
+std::wstring Win32ProcessControl::ResolveImagePath(NativeHandle process) {
+    wchar_t rawBuf[MAX_PATH + 1] = {};
+    DWORD rawSize = MAX_PATH;
+    if (!::QueryFullProcessImageNameW(process, 0, rawBuf, &rawSize)) {
+        DWORD err = ::GetLastError();
+        // error=31 (ERROR_GEN_FAILURE): 毎 SafetyNet tick で発生する定常ノイズ — 抑制
+        // error=87 (ERROR_INVALID_PARAMETER): PID 無効化済み (プロセス終了) — 期待値
+        if (err != ERROR_GEN_FAILURE && err != ERROR_INVALID_PARAMETER) {
+            LOG_DEBUG(L"[DIAG] ResolveProcessPath: QueryFullProcessImageNameW failed, error="
+                      + std::to_wstring(err));
+        }
+        return L"";
+    }
+
+    std::wstring rawPath(rawBuf, rawSize);
+
+    // For running processes, use GetFinalPathNameByHandleW for symlink resolution
+    HANDLE hFile = ::CreateFileW(
+        rawPath.c_str(), 0,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr, OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+
+    if (hFile == INVALID_HANDLE_VALUE) {
+        // Process file inaccessible — fall back to CanonicalizePath
+        return unleaf::CanonicalizePath(rawPath);
+    }
+
+    wchar_t buf[MAX_PATH + 4] = {};
+    DWORD len = ::GetFinalPathNameByHandleW(
+        hFile, buf, MAX_PATH + 4,
+        FILE_NAME_NORMALIZED | VOLUME_NAME_DOS);
+    ::CloseHandle(hFile);
+
+    if (len == 0 || len > MAX_PATH) {
+        return unleaf::CanonicalizePath(rawPath);
+    }
+
+    std::wstring result(buf, len);
+
+    // \\?\UNC\server\share -> \\server\share
+    if (result.size() >= 8 &&
+        result[0] == L'\\' && result[1] == L'\\' &&
+        result[2] == L'?'  && result[3] == L'\\' &&
+        (result[4] == L'U' || result[4] == L'u') &&
+        (result[5] == L'N' || result[5] == L'n') &&
+        (result[6] == L'C' || result[6] == L'c') &&
+        result[7] == L'\\') {
+        result = L"\\\\" + result.substr(8);
+    }
+    // \\?\ -> remove prefix
+    else if (result.size() >= 4 &&
+             result[0] == L'\\' && result[1] == L'\\' &&
+             result[2] == L'?'  && result[3] == L'\\') {
+        result = result.substr(4);
+    }
+
+    // Lowercase
+    for (auto& ch : result) ch = towlower(ch);
+
+    return result;
+}
+
+bool Win32ProcessControl::FileExists(const std::wstring& path) {
+    DWORD attrs = ::GetFileAttributesW(path.c_str());
+    return (attrs != INVALID_FILE_ATTRIBUTES);
+}
+
+bool Win32ProcessControl::SetPriorityClass(NativeHandle process, DWORD priorityClass) {
+    return ::SetPriorityClass(process, priorityClass) != FALSE;
+}
+
+EcoQoSResult Win32ProcessControl::SetEcoQoSOff(NativeHandle process, ULONG controlMask,
+                                               bool preferNtApi) {
+    EcoQoSResult result;
+
+    UnleafThrottleState state;
+    state.Version = UNLEAF_THROTTLE_VERSION;
+    state.ControlMask = controlMask;
+    state.StateMask = 0;  // Force OFF
+
+    // NtSetInformationProcess first (low-level, more resistant to OS override)
+    if (preferNtApi && ntApiAvailable_ && pfnNtSetInformationProcess_) {
+        result.usedNtApi = true;
+        result.ntStatus = pfnNtSetInformationProcess_(
+            process,
+            NT_PROCESS_POWER_THROTTLING_STATE,
+            &state,
+            sizeof(state)
+        );
+        if (result.ntStatus == STATUS_SUCCESS) {
+            result.success = true;
+            return result;
+        }
+        result.ntFallback = true;
+    }
+
+    // SetProcessInformation (primary path for Win10, fallback for Win11)
+    BOOL ok = ::SetProcessInformation(process,
+        static_cast<PROCESS_INFORMATION_CLASS>(UNLEAF_PROCESS_POWER_THROTTLING),
+        &state, sizeof(state));
+    result.success = (ok != FALSE);
+    if (!result.success) {
+        result.error = ::GetLastError();
+    }
+    return result;
+}
+
+bool Win32ProcessControl::IsEcoQoSEnabled(NativeHandle process) {
+    UnleafThrottleState state = {};
+    state.Version = UNLEAF_THROTTLE_VERSION;
+
+    // Try NtQueryInformationProcess first (if available)
+    if (ntApiAvailable_ && pfnNtQueryInformationProcess_) {
+        ULONG returnLength = 0;
+        NTSTATUS status = pfnNtQueryInformationProcess_(
+            process,
+            NT_PROCESS_POWER_THROTTLING_STATE,
+            &state,
+            sizeof(state),
+            &returnLength
+        );
+        if (status == STATUS_SUCCESS) {
+            return (state.StateMask & UNLEAF_THROTTLE_EXECUTION_SPEED) != 0;
+        }
+    }
+
+    // Fallback to GetProcessInformation
+    BOOL result = ::GetProcessInformation(
+        process,
+        static_cast<PROCESS_INFORMATION_CLASS>(UNLEAF_PROCESS_POWER_THROTTLING),
+        &state,
+        sizeof(state)
+    );
+    if (result) {
+        return (state.StateMask & UNLEAF_THROTTLE_EXECUTION_SPEED) != 0;
+    }
+
+    return false;  // Unable to determine, assume not enabled
+}
+
+namespace {
+
+// Thread power throttling off + priority boost for one opened thread
+void BoostThread(HANDLE hThread, bool aggressive) {
+    // Stack-allocated throttle state (no dynamic allocation)
+    UnleafThreadThrottleState threadState;
+    threadState.Version = UNLEAF_THREAD_THROTTLE_VERSION;
+    threadState.ControlMask = UNLEAF_THREAD_THROTTLE_EXECUTION_SPEED;
+    threadState.StateMask = 0;  // Disable throttling
+
+    // Disable thread-level power throttling
+    ::SetThreadInformation(hThread,
+        static_cast<THREAD_INFORMATION_CLASS>(UNLEAF_THREAD_POWER_THROTTLING),
+        &threadState, sizeof(threadState));
+
+    // Priority boost logic
+    int currentPriority = ::GetThreadPriority(hThread);
+    if (currentPriority != THREAD_PRIORITY_ERROR_RETURN) {
+        if (aggressive) {
+            // Boost any thread below ABOVE_NORMAL
+            if (currentPriority < THREAD_PRIORITY_ABOVE_NORMAL) {
+                ::SetThreadPriority(hThread, THREAD_PRIORITY_ABOVE_NORMAL);
+            }
+        } else {
+            // Conservative: only boost very low priority threads
+            if (currentPriority == THREAD_PRIORITY_IDLE ||
+                currentPriority == THREAD_PRIORITY_LOWEST ||
+                currentPriority == THREAD_PRIORITY_BELOW_NORMAL) {
+                ::SetThreadPriority(hThread, THREAD_PRIORITY_ABOVE_NORMAL);
+            }
+        }
+    }
+}
+
+} // namespace
+
+int Win32ProcessControl::DisableThreadThrottling(DWORD pid, bool aggressive) {
+    if (pid == 0) return 0;
+
+    HANDLE snapshot = ::CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+    if (snapshot == INVALID_HANDLE_VALUE) return 0;
+
+    int threadCount = 0;
+    THREADENTRY32 te32;
+    te32.dwSize = sizeof(THREADENTRY32);
+
+    if (::Thread32First(snapshot, &te32)) {
+        do {
+            if (te32.th32OwnerProcessID == pid) {
+                HANDLE hThread = ::OpenThread(
+                    THREAD_SET_INFORMATION | THREAD_QUERY_INFORMATION,
+                    FALSE, te32.th32ThreadID);
+
+                if (hThread) {
+                    BoostThread(hThread, aggressive);
+                    ::CloseHandle(hThread);
+                    threadCount++;
+                }
+            }
+        } while (::Thread32Next(snapshot, &te32));
+    }
+
+    ::CloseHandle(snapshot);
+    return threadCount;
+}
+
+// §9.38: thread ids from the tick snapshot — no system-wide TH32CS_SNAPTHREAD walk
+int Win32ProcessControl::DisableThreadThrottling(DWORD pid, const uint32_t* threadIds, size_t count,
+                                                 bool aggressive) {
+    if (pid == 0) return 0;
+
+    int threadCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        HANDLE hThread = ::OpenThread(
+            THREAD_SET_INFORMATION | THREAD_QUERY_INFORMATION,
+            FALSE, threadIds[i]);
+        if (!hThread) continue;   // exited since the capture
+
+        // Thread ids are reused: act only while it still belongs to pid
+        if (::GetProcessIdOfThread(hThread) == pid) {
+            BoostThread(hThread, aggressive);
+            threadCount++;
+        }
+        ::CloseHandle(hThread);
+    }
+    return threadCount;
+}
+
+bool Win32ProcessControl::RegisterExitWait(NativeHandle* outWait, NativeHandle process,
+                                           WaitCallback callback, PVOID context) {
+    return ::RegisterWaitForSingleObject(
+        outWait, process, callback, context, INFINITE, WT_EXECUTEONLYONCE) != FALSE;
+}
+
+bool Win32ProcessControl::UnregisterExitWait(NativeHandle wait) {
+    // Blocks until any in-flight callback completes
+    return ::UnregisterWaitEx(wait, INVALID_HANDLE_VALUE) != FALSE;
+}
+
+JobAssignResult Win32ProcessControl::AssignToNewJob(NativeHandle process, NativeHandle* outJob) {
+    *outJob = nullptr;
+
+    // Check if already in a Job (Chrome sandbox case)
+    BOOL inJob = FALSE;
+    ::IsProcessInJob(process, nullptr, &inJob);
+    if (inJob) {
+        return JobAssignResult::ALREADY_IN_JOB;
+    }
+
+    HANDLE hJob = ::CreateJobObjectW(nullptr, nullptr);
+    if (!hJob) {
+        return JobAssignResult::CREATE_FAILED;
+    }
+
+    // Configure: allow breakaway for nested processes
+    JOBOBJECT_EXTENDED_LIMIT_INFORMATION jobInfo = {};
+    jobInfo.BasicLimitInformation.LimitFlags =
+        JOB_OBJECT_LIMIT_BREAKAWAY_OK | JOB_OBJECT_LIMIT_SILENT_BREAKAWAY_OK;
+    ::SetInformationJobObject(hJob, JobObjectExtendedLimitInformation,
+        &jobInfo, sizeof(jobInfo));
+
+    if (!::AssignProcessToJobObject(hJob, process)) {
+        DWORD error = ::GetLastError();
+        ::CloseHandle(hJob);
+        ::SetLastError(error);
+        return JobAssignResult::ASSIGN_FAILED;
+    }
+
+    *outJob = hJob;
+    return JobAssignResult::ASSIGNED;
+}
+
+bool Win32ProcessControl::QueryJobProcessIds(NativeHandle job, DWORD* pids, DWORD capacity,
+                                             DWORD* count) {
+    *count = 0;
+
+    // Fixed-size stack buffer for PID list (no dynamic allocation)
+    BYTE buffer[sizeof(JOBOBJECT_BASIC_PROCESS_ID_LIST) +
+                (MAX_JOB_PIDS - 1) * sizeof(ULONG_PTR)];
+    auto* pidList = reinterpret_cast<JOBOBJECT_BASIC_PROCESS_ID_LIST*>(buffer);
+    pidList->NumberOfAssignedProcesses = MAX_JOB_PIDS;
+    pidList->NumberOfProcessIdsInList = 0;
+
+    if (!::QueryInformationJobObject(job,
+            JobObjectBasicProcessIdList, pidList, sizeof(buffer), nullptr)) {
+        return false;
+    }
+
+    DWORD n = (std::min)(static_cast<DWORD>(pidList->NumberOfProcessIdsInList), capacity);
+    for (DWORD i = 0; i < n; i++) {
+        pids[i] = static_cast<DWORD>(pidList->ProcessIdList[i]);
+    }
+    *count = n;
+    return true;
+}
+
+void Win32ProcessControl::OptimizeSelfHeap() {
+    // Encourage the process heap to decommit idle pages more aggressively (Windows 8.1+).
+    // Reduces Private Working Set growth from heap fragmentation over long runs.
+    // Best-effort: failure is harmless and silently ignored.
+    HEAP_OPTIMIZE_RESOURCES_INFORMATION heapOpt = {};
+    heapOpt.Version = HEAP_OPTIMIZE_RESOURCES_CURRENT_VERSION;
+    heapOpt.Flags = 0;
+    ::HeapSetInformation(::GetProcessHeap(), HeapOptimizeResources,
+                         &heapOpt, sizeof(heapOpt));
+}
+
+// ============================================================================
+// Win32SystemSnapshot
+// ============================================================================
+
+namespace {
+
+// SystemProcessInformation record layouts (ntddk / phnt; winternl.h only exposes part of them)
+struct UnleafUnicodeString {
+    USHORT Length;             // bytes
+    USHORT MaximumLength;
+    PWSTR  Buffer;
+};
+
+struct UnleafSystemThreadInformation {
+    LARGE_INTEGER KernelTime;
+    LARGE_INTEGER UserTime;
+    LARGE_INTEGER CreateTime;
+    ULONG WaitTime;
+    PVOID StartAddress;
+    HANDLE UniqueProcess;      // CLIENT_ID
+    HANDLE UniqueThread;
+    LONG Priority;
+    LONG BasePriority;
+    ULONG ContextSwitches;
+    ULONG ThreadState;
+    ULONG WaitReason;
+};
+
+struct UnleafSystemProcessInformation {
+    ULONG NextEntryOffset;
+    ULONG NumberOfThreads;
+    LARGE_INTEGER WorkingSetPrivateSize;
+    ULONG HardFaultCount;
+    ULONG NumberOfThreadsHighWatermark;
+    ULONGLONG CycleTime;
+    LARGE_INTEGER CreateTime;
+    LARGE_INTEGER UserTime;
+    LARGE_INTEGER KernelTime;
+    UnleafUnicodeString ImageName;
+    LONG BasePriority;
+    HANDLE UniqueProcessId;
+    HANDLE InheritedFromUniqueProcessId;
+    ULONG HandleCount;
+    ULONG SessionId;
+    ULONG_PTR UniqueProcessKey;
+    SIZE_T PeakVirtualSize;
+    SIZE_T VirtualSize;
+    ULONG PageFaultCount;
+    SIZE_T PeakWorkingSetSize;
+    SIZE_T WorkingSetSize;
+    SIZE_T QuotaPeakPagedPoolUsage;
+    SIZE_T QuotaPagedPoolUsage;
+    SIZE_T QuotaPeakNonPagedPoolUsage;
+    SIZE_T QuotaNonPagedPoolUsage;
+    SIZE_T PagefileUsage;
+    SIZE_T PeakPagefileUsage;
+    SIZE_T PrivatePageCount;
+    LARGE_INTEGER ReadOperationCount;
+    LARGE_INTEGER WriteOperationCount;
+    LARGE_INTEGER OtherOperationCount;
+    LARGE_INTEGER ReadTransferCount;
+    LARGE_INTEGER WriteTransferCount;
+    LARGE_INTEGER OtherTransferCount;
+    // UnleafSystemThreadInformation Threads[NumberOfThreads] follows
+};
+#ifdef _WIN64
+static_assert(sizeof(UnleafSystemProcessInformation) == 0x100, "SYSTEM_PROCESS_INFORMATION (x64)");
+static_assert(sizeof(UnleafSystemThreadInformation) == 0x50, "SYSTEM_THREAD_INFORMATION (x64)");
+#endif
+
+constexpr ULONG UNLEAF_SYSTEM_PROCESS_INFORMATION = 5;          // SystemProcessInformation
+constexpr NTSTATUS UNLEAF_STATUS_INFO_LENGTH_MISMATCH = static_cast<NTSTATUS>(0xC0000004L);
+constexpr size_t SNAPSHOT_BUFFER_INITIAL = 512 * 1024;
+constexpr size_t SNAPSHOT_BUFFER_SLACK = 64 * 1024;               // processes started meanwhile
+
+} // namespace
+
+Win32SystemSnapshot::Win32SystemSnapshot() {
+    if (HMODULE ntdll = ::GetModuleHandleW(L"ntdll.dll")) {
+        pfnNtQuerySystemInformation_ = reinterpret_cast<PFN_NtQuerySystemInformation>(
+            ::GetProcAddress(ntdll, "NtQuerySystemInformation"));
+    }
+}
+
+// §9.38: processes and their threads in one NtQuerySystemInformation(SystemProcessInformation)
+// pass. buffer_ is kept between captures (grows to the largest system seen, never shrinks).
+bool Win32SystemSnapshot::Capture(engine_logic::SystemSnapshot& out) {
+    out.Clear();
+    if (!pfnNtQuerySystemInformation_) return false;
+
+    if (buffer_.empty()) buffer_.resize(SNAPSHOT_BUFFER_INITIAL);
+    NTSTATUS status;
+    for (;;) {
+        ULONG needed = 0;
+        status = pfnNtQuerySystemInformation_(UNLEAF_SYSTEM_PROCESS_INFORMATION, buffer_.data(),
+                                              static_cast<ULONG>(buffer_.size()), &needed);
+        if (status != UNLEAF_STATUS_INFO_LENGTH_MISMATCH) break;
+        buffer_.resize((std::max)(static_cast<size_t>(needed), buffer_.size()) + SNAPSHOT_BUFFER_SLACK);
+    }
+    if (status < 0) return false;
+
+    const BYTE* cursor = buffer_.data();
+    for (;;) {
+        const auto* proc = reinterpret_cast<const UnleafSystemProcessInformation*>(cursor);
+        const DWORD pid = static_cast<DWORD>(reinterpret_cast<ULONG_PTR>(proc->UniqueProcessId));
+        std::wstring_view name(proc->ImageName.Buffer, proc->ImageName.Length / sizeof(wchar_t));
+        if (name.empty() && pid == 0) name = L"[System Process]";   // Toolhelp naming
+        out.AddProcess(pid, static_cast<DWORD>(reinterpret_cast<ULONG_PTR>(proc->InheritedFromUniqueProcessId)),
+                       name, static_cast<uint64_t>(proc->CreateTime.QuadPart));
+
+        const auto* threads = reinterpret_cast<const UnleafSystemThreadInformation*>(proc + 1);
+        for (ULONG t = 0; t < proc->NumberOfThreads; ++t) {
+            out.AddThread(static_cast<uint32_t>(reinterpret_cast<ULONG_PTR>(threads[t].UniqueThread)));
+        }
+
+        if (proc->NextEntryOffset == 0) break;
+        cursor += proc->NextEntryOffset;
+    }
+    out.Finish();
+    return true;
+}
+
+void Win32SystemSnapshot::QuerySelfUsage(SelfUsage& out) {
+    out = SelfUsage{};
+    out.pid = ::GetCurrentProcessId();
+
+    DWORD handleCount = 0;
+    if (::GetProcessHandleCount(::GetCurrentProcess(), &handleCount)) {
+        out.handleCount = handleCount;
+    }
+
+    PROCESS_MEMORY_COUNTERS_EX pmc = {};
+    pmc.cb = sizeof(pmc);
+    if (::GetProcessMemoryInfo(::GetCurrentProcess(),
+            reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&pmc), sizeof(pmc))) {
+        out.memoryValid = true;
+        out.privateBytes = pmc.PrivateUsage;
+        out.workingSetBytes = pmc.WorkingSetSize;
+        out.pagefileBytes = pmc.PagefileUsage;
+    }
+}
+
+// ============================================================================
+// Win32TimerService
+// ============================================================================
+
+NativeHandle Win32TimerService::CreateQueue() {
+    return ::CreateTimerQueue();
+}
+
+bool Win32TimerService::DeleteQueue(NativeHandle queue, bool waitForCallbacks) {
+    return ::DeleteTimerQueueEx(queue, waitForCallbacks ? INVALID_HANDLE_VALUE : nullptr) != FALSE;
+}
+
+bool Win32TimerService::CreateTimer(NativeHandle* outTimer, NativeHandle queue,
+                                    TimerCallback callback, PVOID context,
+                                    DWORD dueTimeMs, DWORD periodMs) {
+    return ::CreateTimerQueueTimer(
+        outTimer, queue, callback, context, dueTimeMs, periodMs,
+        periodMs == 0 ? WT_EXECUTEONLYONCE : WT_EXECUTEDEFAULT) != FALSE;
+}
+
+bool Win32TimerService::DeleteTimer(NativeHandle queue, NativeHandle timer, bool waitForCallbacks) {
+    return ::DeleteTimerQueueTimer(queue, timer,
+        waitForCallbacks ? INVALID_HANDLE_VALUE : nullptr) != FALSE;
+}
+
+DWORD Win32TimerService::LastError() {
+    return ::GetLastError();
+}
+
+// ============================================================================
+// Win32Clock
+// ============================================================================
+
+Win32Clock::Win32Clock() {
+    ::QueryPerformanceFrequency(&qpcFreq_);
+}
+
+ULONGLONG Win32Clock::NowMs() {
+    return ::GetTickCount64();
+}
+
+ULONGLONG Win32Clock::NowUs() {
+    LARGE_INTEGER qpc;
+    ::QueryPerformanceCounter(&qpc);
+    if (qpcFreq_.QuadPart <= 0) return 0;
+    return static_cast<ULONGLONG>(qpc.QuadPart) * 1000000ULL /
+           static_cast<ULONGLONG>(qpcFreq_.QuadPart);
+}
+
+void Win32Clock::SleepMs(DWORD ms) {
+    ::Sleep(ms);
+}
+
+// ============================================================================
+// Win32EventService
+// ============================================================================
+
+NativeHandle Win32EventService::CreateEventObject(bool manualReset) {
+    return ::CreateEventW(nullptr, manualReset ? TRUE : FALSE, FALSE, nullptr);
+}
+
+bool Win32EventService::SetEvent(NativeHandle event) {
+    return ::SetEvent(event) != FALSE;
+}
+
+bool Win32EventService::ResetEvent(NativeHandle event) {
+    return ::ResetEvent(event) != FALSE;
+}
+
+void Win32EventService::CloseHandle(NativeHandle h) {
+    if (h && h != INVALID_HANDLE_VALUE) {
+        ::CloseHandle(h);
+    }
+}
+
+NativeHandle Win32EventService::CreatePeriodicTimer() {
+    return ::CreateWaitableTimerW(nullptr, FALSE, nullptr);
+}
+
+bool Win32EventService::ArmPeriodicTimer(NativeHandle timer, DWORD dueMs, DWORD periodMs) {
+    LARGE_INTEGER dueTime;
+    dueTime.QuadPart = -static_cast<LONGLONG>(dueMs) * 10000LL;  // Relative time in 100ns units
+    return ::SetWaitableTimer(timer, &dueTime, static_cast<LONG>(periodMs),
+                              nullptr, nullptr, FALSE) != FALSE;
+}
+
+// §9.34: FindFirstChangeNotification signaled for every write in the base directory,
+// including each UnLeaf.log append. ReadDirectoryChangesW completes on a threadpool wait
+// instead; only a record naming fileName sets the event the control loop waits on.
+struct Win32EventService::FileWatch {
+    HANDLE directory = INVALID_HANDLE_VALUE;
+    HANDLE ioEvent = nullptr;      // OVERLAPPED completion (auto-reset)
+    HANDLE signal = nullptr;       // WaitAny handle (manual-reset, cleared by Rearm)
+    HANDLE poolWait = nullptr;     // RegisterWaitForSingleObject(ioEvent)
+    OVERLAPPED overlapped = {};
+    std::wstring fileName;
+    std::atomic<bool> failed{false};   // read could not be re-issued
+    alignas(DWORD) BYTE buffer[4096];
+};
+
+bool Win32EventService::IssueDirectoryRead(FileWatch* watch) {
+    ZeroMemory(&watch->overlapped, sizeof(watch->overlapped));
+    watch->overlapped.hEvent = watch->ioEvent;
+    return ::ReadDirectoryChangesW(
+        watch->directory, watch->buffer, sizeof(watch->buffer),
+        FALSE,  // Do not watch subtree
+        FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME,  // write + atomic replace
+        nullptr, &watch->overlapped, nullptr) != FALSE;
+}
+
+void CALLBACK Win32EventService::OnDirectoryChange(PVOID context, BOOLEAN /*timerOrWaitFired*/) {
+    auto* watch = static_cast<FileWatch*>(context);
+    DWORD bytes = 0;
+    if (!::GetOverlappedResult(watch->directory, &watch->overlapped, &bytes, FALSE)) {
+        if (::GetLastError() != ERROR_OPERATION_ABORTED) {   // aborted = CloseDirectoryWatch
+            watch->failed = true;
+            ::SetEvent(watch->signal);
+        }
+        return;
+    }
+
+    bool matched = (bytes == 0);   // buffer overflow: records were dropped, assume ours
+    for (DWORD offset = 0; !matched && offset < bytes; ) {
+        const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(watch->buffer + offset);
+        matched = ::CompareStringOrdinal(info->FileName,
+                                         static_cast<int>(info->FileNameLength / sizeof(wchar_t)),
+                                         watch->fileName.c_str(),
+                                         static_cast<int>(watch->fileName.size()),
+                                         TRUE) == CSTR_EQUAL;
+        if (info->NextEntryOffset == 0) break;
+        offset += info->NextEntryOffset;
+    }
+
+    if (!IssueDirectoryRead(watch)) {
+        watch->failed = true;   // surfaced by RearmDirectoryWatch (engine disables the watch)
+        matched = true;
+    }
+    if (matched) {
+        ::SetEvent(watch->signal);
+    }
+}
+
+void Win32EventService::DestroyFileWatch(FileWatch* watch) {
+    if (watch->poolWait) {
+        ::UnregisterWaitEx(watch->poolWait, INVALID_HANDLE_VALUE);  // waits for OnDirectoryChange
+    }
+    if (watch->directory != INVALID_HANDLE_VALUE) {
+        DWORD bytes = 0;
+        if (::CancelIoEx(watch->directory, &watch->overlapped) || ::GetLastError() != ERROR_NOT_FOUND) {
+            ::GetOverlappedResult(watch->directory, &watch->overlapped, &bytes, TRUE);
+        }
+        ::CloseHandle(watch->directory);
+    }
+    if (watch->ioEvent) ::CloseHandle(watch->ioEvent);
+    if (watch->signal) ::CloseHandle(watch->signal);
+    delete watch;
+}
+
+NativeHandle Win32EventService::WatchDirectory(const std::wstring& directory, const std::wstring& fileName) {
+    auto* watch = new FileWatch();
+    watch->fileName = fileName;
+    watch->directory = ::CreateFileW(
+        directory.c_str(), FILE_LIST_DIRECTORY,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr, OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    watch->ioEvent = ::CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    watch->signal = ::CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+    bool ok = watch->directory != INVALID_HANDLE_VALUE && watch->ioEvent && watch->signal &&
+              IssueDirectoryRead(watch);
+    if (ok) {
+        ok = ::RegisterWaitForSingleObject(&watch->poolWait, watch->ioEvent, OnDirectoryChange,
+                                           watch, INFINITE, WT_EXECUTEDEFAULT) != FALSE;
+        if (!ok) watch->poolWait = nullptr;
+    }
+    if (!ok) {
+        const DWORD error = ::GetLastError();
+        DestroyFileWatch(watch);
+        ::SetLastError(error);
+        return INVALID_HANDLE_VALUE;
+    }
+
+    std::lock_guard<std::mutex> lock(watchMu_);
+    watches_[watch->signal] = watch;
+    return watch->signal;
+}
+
+bool Win32EventService::RearmDirectoryWatch(NativeHandle watch) {
+    std::lock_guard<std::mutex> lock(watchMu_);
+    auto it = watches_.find(watch);
+    if (it == watches_.end()) {
+        ::SetLastError(ERROR_INVALID_HANDLE);
+        return false;
+    }
+    ::ResetEvent(it->second->signal);
+    if (it->second->failed.load()) {
+        ::SetLastError(ERROR_GEN_FAILURE);
+        return false;
+    }
+    return true;
+}
+
+void Win32EventService::CloseDirectoryWatch(NativeHandle watch) {
+    FileWatch* target = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(watchMu_);
+        auto it = watches_.find(watch);
+        if (it == watches_.end()) return;
+        target = it->second;
+        watches_.erase(it);
+    }
+    DestroyFileWatch(target);
+}
+
+DWORD Win32EventService::WaitAny(const NativeHandle* handles, DWORD count, DWORD timeoutMs) {
+    return ::WaitForMultipleObjects(count, handles, FALSE, timeoutMs);
+}
+
+DWORD Win32EventService::LastError() {
+    return ::GetLastError();
+}
+
+// ============================================================================
+// Win32PolicyStore
+// ============================================================================
+
+bool Win32PolicyStore::Initialize(const std::wstring& baseDir) {
+    return RegistryPolicyManager::Instance().Initialize(baseDir);
+}
+
+bool Win32PolicyStore::ApplyPolicy(const std::wstring& exeName, const std::wstring& fullPath) {
+    return RegistryPolicyManager::Instance().ApplyPolicy(exeName, fullPath);
+}
+
+bool Win32PolicyStore::ApplyIFEOOnly(const std::wstring& exeName) {
+    return RegistryPolicyManager::Instance().ApplyIFEOOnly(exeName);
+}
+
+void Win32PolicyStore::ReconcileWithConfig(const std::set<std::wstring>& targetNames,
+                                           const std::set<std::wstring>& targetPaths) {
+    RegistryPolicyManager::Instance().ReconcileWithConfig(targetNames, targetPaths);
+}
+
+void Win32PolicyStore::CleanupAllPolicies() {
+    RegistryPolicyManager::Instance().CleanupAllPolicies();
+}
+
+void Win32PolicyStore::VerifyAndRepair() {
+    RegistryPolicyManager::Instance().VerifyAndRepair();
+}
+
+bool Win32PolicyStore::IsPolicyValid(const std::wstring& canonPath) const {
+    return RegistryPolicyManager::Instance().IsPolicyValid(canonPath);
+}
+
+bool Win32PolicyStore::HasPolicy(const std::wstring& canonPath) const {
+    return RegistryPolicyManager::Instance().HasPolicy(canonPath);
+}
+
+int32_t Win32PolicyStore::GetPendingQueueSize() const {
+    return RegistryPolicyManager::Instance().GetPendingQueueSize();
+}
+
+bool Win32PolicyStore::ConsumePendingOverflowFlag() {
+    return RegistryPolicyManager::Instance().ConsumePendingOverflowFlag();
+}
+
+// ============================================================================
+// NativePlatform
+// ============================================================================
+
+Platform& NativePlatform() {
+    static Win32ProcessControl process;
+    static Win32SystemSnapshot snapshot;
+    static Win32TimerService   timers;
+    static Win32Clock          clock;
+    static Win32EventService   events;
+    static ProcessMonitor      monitor;
+    static Win32PolicyStore    policy;
+    static Platform platform{ process, snapshot, timers, clock, events, monitor, policy };
+    return platform;
+}
+
+} // namespace platform
+} // namespace unleaf
+
+#endif // _WIN32
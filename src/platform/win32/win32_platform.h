@@ -0,0 +1,168 @@
+#pragma once
+// UnLeaf - Win32 implementation of the OS abstraction layer
+// EngineCore から移設した Win32 / NT API 呼び出しの実体。
+// 挙動 (アクセス権・フラグ・フォールバック順) は移設前と同一。
+
+#ifdef _WIN32
+
+#include "../platform.h"
+#include <mutex>
+#include <unordered_map>
+
+namespace unleaf {
+namespace platform {
+
+// Windows version info for compatibility checks
+struct WindowsVersionInfo {
+    DWORD major = 0;
+    DWORD minor = 0;
+    DWORD build = 0;
+    bool isWindows11OrLater = false;
+};
+
+// NT API function pointer types
+typedef NTSTATUS(NTAPI* PFN_NtSetInformationProcess)(
+    HANDLE ProcessHandle,
+    ULONG ProcessInformationClass,
+    PVOID ProcessInformation,
+    ULONG ProcessInformationLength
+);
+
+typedef NTSTATUS(NTAPI* PFN_NtQueryInformationProcess)(
+    HANDLE ProcessHandle,
+    ULONG ProcessInformationClass,
+    PVOID ProcessInformation,
+    ULONG ProcessInformationLength,
+    PULONG ReturnLength
+);
+
+typedef NTSTATUS(NTAPI* PFN_NtQuerySystemInformation)(
+    ULONG SystemInformationClass,
+    PVOID SystemInformation,
+    ULONG SystemInformationLength,
+    PULONG ReturnLength
+);
+
+class Win32ProcessControl : public IProcessControl {
+public:
+    void Initialize() override;
+
+    NativeHandle OpenControl(DWORD pid) override;
+    NativeHandle OpenQuery(DWORD pid) override;
+    NativeHandle OpenSynchronize(DWORD pid) override;
+    void CloseHandle(NativeHandle h) override;
+    DWORD LastError() override;
+
+    bool QueryExitCode(NativeHandle process, DWORD& exitCode) override;
+    std::wstring QueryImageName(NativeHandle process) override;
+    std::wstring ResolveImagePath(NativeHandle process) override;
+    bool FileExists(const std::wstring& path) override;
+
+    bool SetPriorityClass(NativeHandle process, DWORD priorityClass) override;
+    bool SupportsFullEcoQoS() const override { return winVersion_.isWindows11OrLater; }
+    EcoQoSResult SetEcoQoSOff(NativeHandle process, ULONG controlMask, bool preferNtApi) override;
+    bool IsEcoQoSEnabled(NativeHandle process) override;
+    int DisableThreadThrottling(DWORD pid, bool aggressive) override;
+    int DisableThreadThrottling(DWORD pid, const uint32_t* threadIds, size_t count,
+                                bool aggressive) override;
+
+    bool RegisterExitWait(NativeHandle* outWait, NativeHandle process,
+                          WaitCallback callback, PVOID context) override;
+    bool UnregisterExitWait(NativeHandle wait) override;
+
+    JobAssignResult AssignToNewJob(NativeHandle process, NativeHandle* outJob) override;
+    bool QueryJobProcessIds(NativeHandle job, DWORD* pids, DWORD capacity,
+                            DWORD* count) override;
+
+    void OptimizeSelfHeap() override;
+
+private:
+    HMODULE ntdllHandle_ = nullptr;
+    PFN_NtSetInformationProcess pfnNtSetInformationProcess_ = nullptr;
+    PFN_NtQueryInformationProcess pfnNtQueryInformationProcess_ = nullptr;
+    bool ntApiAvailable_ = false;
+    WindowsVersionInfo winVersion_;
+};
+
+class Win32SystemSnapshot : public ISystemSnapshot {
+public:
+    Win32SystemSnapshot();
+    bool Capture(engine_logic::SystemSnapshot& out) override;
+    void QuerySelfUsage(SelfUsage& out) override;
+
+private:
+    PFN_NtQuerySystemInformation pfnNtQuerySystemInformation_ = nullptr;
+    std::vector<BYTE> buffer_;   // SystemProcessInformation records (reused, §9.38)
+};
+
+class Win32TimerService : public ITimerService {
+public:
+    NativeHandle CreateQueue() override;
+    bool DeleteQueue(NativeHandle queue, bool waitForCallbacks) override;
+    bool CreateTimer(NativeHandle* outTimer, NativeHandle queue,
+                     TimerCallback callback, PVOID context,
+                     DWORD dueTimeMs, DWORD periodMs) override;
+    bool DeleteTimer(NativeHandle queue, NativeHandle timer, bool waitForCallbacks) override;
+    DWORD LastError() override;
+};
+
+class Win32Clock : public IClock {
+public:
+    Win32Clock();
+    ULONGLONG NowMs() override;
+    ULONGLONG NowUs() override;
+    void SleepMs(DWORD ms) override;
+
+private:
+    LARGE_INTEGER qpcFreq_;
+};
+
+class Win32EventService : public IEventService {
+public:
+    NativeHandle CreateEventObject(bool manualReset) override;
+    bool SetEvent(NativeHandle event) override;
+    bool ResetEvent(NativeHandle event) override;
+    void CloseHandle(NativeHandle h) override;
+
+    NativeHandle CreatePeriodicTimer() override;
+    bool ArmPeriodicTimer(NativeHandle timer, DWORD dueMs, DWORD periodMs) override;
+
+    // §9.34: ReadDirectoryChangesW filtered by file name on a threadpool wait; the returned
+    // handle is a manual-reset event set only for fileName
+    NativeHandle WatchDirectory(const std::wstring& directory, const std::wstring& fileName) override;
+    bool RearmDirectoryWatch(NativeHandle watch) override;
+    void CloseDirectoryWatch(NativeHandle watch) override;
+
+    DWORD WaitAny(const NativeHandle* handles, DWORD count, DWORD timeoutMs) override;
+    DWORD LastError() override;
+
+private:
+    struct FileWatch;
+    static bool IssueDirectoryRead(FileWatch* watch);
+    static void CALLBACK OnDirectoryChange(PVOID context, BOOLEAN timerOrWaitFired);
+    static void DestroyFileWatch(FileWatch* watch);
+
+    std::mutex watchMu_;
+    std::unordered_map<NativeHandle, FileWatch*> watches_;   // key: FileWatch::signal
+};
+
+// Thin forwarder to RegistryPolicyManager::Instance()
+class Win32PolicyStore : public IPolicyStore {
+public:
+    bool Initialize(const std::wstring& baseDir) override;
+    bool ApplyPolicy(const std::wstring& exeName, const std::wstring& fullPath) override;
+    bool ApplyIFEOOnly(const std::wstring& exeName) override;
+    void ReconcileWithConfig(const std::set<std::wstring>& targetNames,
+                             const std::set<std::wstring>& targetPaths) override;
+    void CleanupAllPolicies() override;
+    void VerifyAndRepair() override;
+    bool IsPolicyValid(const std::wstring& canonPath) const override;
+    bool HasPolicy(const std::wstring& canonPath) const override;
+    int32_t GetPendingQueueSize() const override;
+    bool ConsumePendingOverflowFlag() override;
+};
+
+} // namespace platform
+} // namespace unleaf
+
+#endif // _WIN32
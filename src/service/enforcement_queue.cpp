@@ -0,0 +1,164 @@
+// UnLeaf - Enforcement request queue (§9.22)
+// Lock-free admission (single CAS on packed counters) + MPSC rings.
+
+#include "enforcement_queue.h"
+#include <cassert>
+
+namespace unleaf {
+
+EnforcementQueue::EnforcementQueue(size_t softLimit, size_t hardLimit, size_t totalLimit)
+    : softLimit_(static_cast<uint32_t>(softLimit))
+    , hardLimit_(static_cast<uint32_t>(hardLimit))
+    , totalLimit_(static_cast<uint32_t>(totalLimit))
+    , critical_(hardLimit)
+    // NON-CRITICAL physical occupancy = SOFT + entries evicted by CRITICAL (<= HARD per drain)
+    , nonCritical_(softLimit + hardLimit) {
+    assert(softLimit + hardLimit < 0x8000 && totalLimit < 0x8000);
+}
+
+EnforcementQueue::~EnforcementQueue() {
+    CriticalSlot slot;
+    while (critical_.TryPop(slot)) {
+        engine_logic::StringInternTable::Instance().Release(slot.imageId);
+    }
+}
+
+EnforcementQueue::PushResult EnforcementQueue::Push(const EnforcementRequest& req, bool& wasEmpty) {
+    wasEmpty = false;
+    uint64_t s = state_.load(std::memory_order_relaxed);
+
+    if (req.type == EnforcementRequestType::ETW_THREAD_START) {
+        // NON-CRITICAL: 個別 OR 合計上限でドロップ
+        for (;;) {
+            const uint32_t nc = Field(s, NC_SHIFT);
+            const uint32_t crit = Field(s, CRIT_SHIFT);
+            if (nc >= softLimit_ || nc + crit >= totalLimit_ ||
+                nc + Field(s, NC_DEBT_SHIFT) >= nonCritical_.capacity()) {
+                return PushResult::DROPPED_NONCRITICAL;
+            }
+            if (state_.compare_exchange_weak(s, s + One(NC_SHIFT),
+                                             std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                wasEmpty = (nc + crit == 0);
+                RaiseHighWater(ncHighWater_, nc + 1);
+                break;
+            }
+        }
+        // Admission reserved the physical slot; failure here means a broken invariant
+        if (!nonCritical_.TryPush(NonCriticalSlot{req.pid, req.threadId})) {
+            state_.fetch_sub(One(NC_SHIFT), std::memory_order_acq_rel);
+            wasEmpty = false;
+            return PushResult::DROPPED_NONCRITICAL;
+        }
+        return PushResult::ACCEPTED;
+    }
+
+    // CRITICAL: HARD 上限 → ドロップ、TOTAL 上限 → NON-CRITICAL 優先で最古を evict
+    PushResult result = PushResult::ACCEPTED;
+    uint64_t next = 0;
+    for (;;) {
+        const uint32_t nc = Field(s, NC_SHIFT);
+        const uint32_t crit = Field(s, CRIT_SHIFT);
+        if (crit >= hardLimit_ || crit + Field(s, CRIT_DEBT_SHIFT) >= critical_.capacity()) {
+            engine_logic::StringInternTable::Instance().Release(req.imageId);
+            return PushResult::DROPPED_CRITICAL;
+        }
+        next = s + One(CRIT_SHIFT);
+        result = PushResult::ACCEPTED;
+        if (nc + crit >= totalLimit_) {
+            if (nc > 0) {
+                next = next - One(NC_SHIFT) + One(NC_DEBT_SHIFT);
+                result = PushResult::ACCEPTED_EVICTED_NONCRITICAL;
+            } else if (crit > 0) {
+                next = next - One(CRIT_SHIFT) + One(CRIT_DEBT_SHIFT);
+                result = PushResult::ACCEPTED_EVICTED_CRITICAL;
+            } else {
+                // TOTAL_LIMIT=0 など異常構成 → 受け入れ不能
+                engine_logic::StringInternTable::Instance().Release(req.imageId);
+                return PushResult::DROPPED_CRITICAL;
+            }
+        }
+        if (state_.compare_exchange_weak(s, next,
+                                         std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            wasEmpty = (nc + crit == 0);
+            RaiseHighWater(critHighWater_, Field(next, CRIT_SHIFT));
+            break;
+        }
+    }
+
+    if (!critical_.TryPush(req)) {
+        engine_logic::StringInternTable::Instance().Release(req.imageId);
+        state_.fetch_sub(next - s, std::memory_order_acq_rel);   // modular: exact rollback
+        wasEmpty = false;
+        return PushResult::DROPPED_CRITICAL;
+    }
+    return result;
+}
+
+void EnforcementQueue::RaiseHighWater(std::atomic<uint32_t>& mark, uint32_t length) {
+    uint32_t seen = mark.load(std::memory_order_relaxed);
+    while (length > seen && !mark.compare_exchange_weak(seen, length, std::memory_order_relaxed)) {}
+}
+
+void EnforcementQueue::ResetHighWater() {
+    const uint64_t s = state_.load(std::memory_order_relaxed);
+    critHighWater_.store(Field(s, CRIT_SHIFT), std::memory_order_relaxed);
+    ncHighWater_.store(Field(s, NC_SHIFT), std::memory_order_relaxed);
+}
+
+bool EnforcementQueue::RetireOne(int countShift, int debtShift) {
+    uint64_t s = state_.load(std::memory_order_relaxed);
+    for (;;) {
+        const bool evicted = Field(s, debtShift) > 0;
+        const uint64_t next = s - One(evicted ? debtShift : countShift);
+        if (state_.compare_exchange_weak(s, next,
+                                         std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return !evicted;
+        }
+    }
+}
+
+size_t EnforcementQueue::PopCritical(std::vector<EnforcementRequest>& out, size_t maxCount,
+                                     std::vector<DWORD>* evictedStartPids) {
+    size_t delivered = 0;
+    CriticalSlot slot;
+    while (delivered < maxCount && critical_.TryPop(slot)) {
+        if (!RetireOne(CRIT_SHIFT, CRIT_DEBT_SHIFT)) {
+            engine_logic::StringInternTable::Instance().Release(slot.imageId);   // evicted at TOTAL_LIMIT
+            if (evictedStartPids && slot.type == EnforcementRequestType::ETW_PROCESS_START)
+                evictedStartPids->push_back(slot.pid);
+            continue;
+        }
+        out.push_back(slot);
+        ++delivered;
+    }
+    return delivered;
+}
+
+size_t EnforcementQueue::PopNonCritical(std::vector<EnforcementRequest>& out, std::vector<DWORD>* evictedPids) {
+    // Bound by what was queued at entry: producers keep running concurrently
+    const uint64_t s = state_.load(std::memory_order_acquire);
+    size_t budget = Field(s, NC_SHIFT) + Field(s, NC_DEBT_SHIFT);
+    size_t delivered = 0;
+    NonCriticalSlot slot;
+    while (budget > 0 && nonCritical_.TryPop(slot)) {
+        --budget;
+        if (!RetireOne(NC_SHIFT, NC_DEBT_SHIFT)) {   // evicted by CRITICAL
+            if (evictedPids) evictedPids->push_back(slot.pid);
+            continue;
+        }
+        out.emplace_back(slot.pid, EnforcementRequestType::ETW_THREAD_START);
+        out.back().threadId = slot.threadId;
+        ++delivered;
+    }
+    return delivered;
+}
+
+size_t EnforcementQueue::CriticalSize() const {
+    return Field(state_.load(std::memory_order_relaxed), CRIT_SHIFT);
+}
+
+size_t EnforcementQueue::NonCriticalSize() const {
+    return Field(state_.load(std::memory_order_relaxed), NC_SHIFT);
+}
+
+} // namespace unleaf
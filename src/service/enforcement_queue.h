@@ -0,0 +1,133 @@
+#pragma once
+// UnLeaf - Enforcement request queue (§9.22)
+// 2 クラス (CRITICAL / NON-CRITICAL) の有界ロックフリー MPSC キュー。
+//   生産者: ETW コールバック、スレッドプールタイマー (任意スレッド・ロックなし)
+//   消費者: EngineControlLoop (ProcessEnforcementQueue) のみ
+// SOFT / HARD / TOTAL 上限と eviction の意味論は旧 deque 実装 (§9.14-A) と同一。
+// 論理件数 + eviction 負債を 1 つの 64bit atomic に詰め、受け入れ判定を CAS 1 回で確定する。
+
+#include "../common/types.h"
+#include "../engine/mpsc_ring.h"
+#include "../engine/string_intern.h"
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace unleaf {
+
+// Enforcement request type (queued from ETW callbacks and timers)
+enum class EnforcementRequestType : uint8_t {
+    ETW_PROCESS_START,       // New target process detected via ETW
+    ETW_THREAD_START,        // Thread created in tracked process (EcoQoS trigger)
+    DEFERRED_VERIFICATION,   // Timer-based verification during AGGRESSIVE phase
+    PERSISTENT_ENFORCE,      // Periodic enforcement for PERSISTENT phase
+    SAFETY_NET               // Insurance consistency check (not monitoring)
+};
+
+// Enforcement request structure (queued for processing by EngineControlLoop)
+// §9.30: 16-byte POD. ETW_PROCESS_START carries the ETW image string as an interned ID
+// (full path, or a bare file name; name = FileNameOf(image)). The request owns one
+// reference on imageId: producer -> EnforcementQueue::Push (always consumes it) ->
+// consumer (releases after dispatch).
+// §9.39: ETW_THREAD_START carries the new thread's ID in the parentPid slot (0 = unknown).
+struct EnforcementRequest {
+    DWORD pid;
+    union {
+        DWORD parentPid;     // ETW_PROCESS_START: parent PID (0 if none)
+        DWORD threadId;      // ETW_THREAD_START: new thread (0 = unknown)
+    };
+    uint32_t imageId;        // ETW_PROCESS_START: StringInternTable ID (EMPTY otherwise)
+    EnforcementRequestType type;
+    uint8_t verifyStep;      // For DEFERRED_VERIFICATION: 1=200ms, 2=1s, 3=3s
+
+    EnforcementRequest() : pid(0), parentPid(0), imageId(engine_logic::StringInternTable::EMPTY),
+                           type(EnforcementRequestType::ETW_PROCESS_START), verifyStep(0) {}
+    EnforcementRequest(DWORD p, EnforcementRequestType t, uint8_t step = 0)
+        : pid(p), parentPid(0), imageId(engine_logic::StringInternTable::EMPTY), type(t), verifyStep(step) {}
+    // ETW_PROCESS_START: takes ownership of the reference held on image
+    EnforcementRequest(DWORD p, DWORD parent, uint32_t image)
+        : pid(p), parentPid(parent), imageId(image),
+          type(EnforcementRequestType::ETW_PROCESS_START), verifyStep(0) {}
+};
+static_assert(sizeof(EnforcementRequest) == 16, "EnforcementRequest must stay a 16-byte POD");
+static_assert(std::is_trivially_copyable<EnforcementRequest>::value, "EnforcementRequest must stay POD");
+
+class EnforcementQueue {
+public:
+    enum class PushResult : uint8_t {
+        ACCEPTED,
+        ACCEPTED_EVICTED_NONCRITICAL,   // CRITICAL accepted at TOTAL; oldest NON-CRITICAL discarded
+        ACCEPTED_EVICTED_CRITICAL,      // CRITICAL accepted at TOTAL; oldest CRITICAL discarded
+        DROPPED_NONCRITICAL,            // SOFT or TOTAL limit
+        DROPPED_CRITICAL                // HARD limit (or TOTAL with nothing to evict)
+    };
+
+    // Limits must each be < 65536 (16-bit packed counters)
+    EnforcementQueue(size_t softLimit, size_t hardLimit, size_t totalLimit);
+    ~EnforcementQueue();
+
+    EnforcementQueue(const EnforcementQueue&) = delete;
+    EnforcementQueue& operator=(const EnforcementQueue&) = delete;
+
+    // Any thread. ETW_THREAD_START is NON-CRITICAL, everything else CRITICAL.
+    // wasEmpty: both classes were empty before this push (caller signals the consumer).
+    // Consumes req.imageId's reference in every outcome (released here when dropped).
+    PushResult Push(const EnforcementRequest& req, bool& wasEmpty);
+
+    // Consumer thread only. Appends up to maxCount CRITICAL requests (oldest first).
+    // Delivered imageId references pass to the caller; evicted ones are released here.
+    // evictedStartPids (optional): PIDs of ETW_PROCESS_START entries discarded by TOTAL_LIMIT eviction.
+    size_t PopCritical(std::vector<EnforcementRequest>& out, size_t maxCount,
+                       std::vector<DWORD>* evictedStartPids = nullptr);
+    // Consumer thread only. Appends every NON-CRITICAL request queued at call time.
+    // evictedPids (optional): PIDs of entries discarded by CRITICAL eviction during this drain.
+    size_t PopNonCritical(std::vector<EnforcementRequest>& out, std::vector<DWORD>* evictedPids = nullptr);
+
+    size_t CriticalSize() const;
+    size_t NonCriticalSize() const;
+    size_t Size() const { return CriticalSize() + NonCriticalSize(); }
+    bool Empty() const { return Size() == 0; }
+
+    // §9.35: largest logical length reached since construction / ResetHighWater (any thread)
+    size_t CriticalHighWater() const { return critHighWater_.load(std::memory_order_relaxed); }
+    size_t NonCriticalHighWater() const { return ncHighWater_.load(std::memory_order_relaxed); }
+    void ResetHighWater();
+
+private:
+    // §9.30: the request itself is the slot (strings travel as interned IDs)
+    using CriticalSlot = EnforcementRequest;
+
+    struct NonCriticalSlot {
+        DWORD pid;
+        DWORD threadId;   // §9.39
+    };
+
+    // state_ layout: [critDebt:16][ncDebt:16][crit:16][nc:16]
+    //   nc / crit : logical queue lengths (limit checks)
+    //   *Debt     : evicted entries still physically in the ring (consumer discards oldest)
+    static constexpr int NC_SHIFT = 0;
+    static constexpr int CRIT_SHIFT = 16;
+    static constexpr int NC_DEBT_SHIFT = 32;
+    static constexpr int CRIT_DEBT_SHIFT = 48;
+    static uint32_t Field(uint64_t s, int shift) { return static_cast<uint32_t>((s >> shift) & 0xFFFF); }
+    static uint64_t One(int shift) { return uint64_t{1} << shift; }
+
+    static void RaiseHighWater(std::atomic<uint32_t>& mark, uint32_t length);
+
+    // Consumer: logical (or debt) decrement for one popped entry. true = deliver, false = evicted.
+    bool RetireOne(int countShift, int debtShift);
+
+    const uint32_t softLimit_;
+    const uint32_t hardLimit_;
+    const uint32_t totalLimit_;
+
+    engine_logic::MpscRing<CriticalSlot> critical_;
+    engine_logic::MpscRing<NonCriticalSlot> nonCritical_;
+    alignas(64) std::atomic<uint64_t> state_{0};
+    // Written only when a push exceeds the mark (rare after warm-up): off state_'s line
+    alignas(64) std::atomic<uint32_t> critHighWater_{0};
+    std::atomic<uint32_t> ncHighWater_{0};
+};
+
+} // namespace unleaf
@@ -6,10 +6,9 @@
 #include <chrono>
 #include <cstdio>
 #include <cassert>
+#include <iterator>
 #include <memory_resource>
 #include <unordered_set>
-#include <psapi.h>
-#pragma comment(lib, "psapi.lib")
 
 namespace unleaf {
 
@@ -22,6 +21,18 @@ struct WaitCallbackContext {
 
 namespace {
 
+// Critical-process list (types.h) compiled once into a TargetMatcher:
+// ETW hot path avoids the ToLower copy + std::set walk of IsCriticalProcess().
+const engine_logic::TargetMatcher& CriticalProcessMatcher() {
+    static const engine_logic::TargetMatcher matcher(std::vector<std::wstring>(
+        GetCriticalProcesses().begin(), GetCriticalProcesses().end()));
+    return matcher;
+}
+
+inline bool IsCriticalImage(std::wstring_view name) {
+    return CriticalProcessMatcher().Contains(name);
+}
+
 // §9.05: CountingResource — single definition to avoid ODR issues.
 // Used in ProcessEnforcementQueue() and HandleSafetyNetCheck() PMR arenas.
 class CountingResource : public std::pmr::memory_resource {
@@ -43,7 +54,7 @@ private:
     size_t count_ = 0;
 };
 
-#ifdef _DEBUG
+#if defined(_DEBUG) && defined(_WIN32)
 // §9.07 修正②: DEBUG-only helper to verify trackedCs_ ownership.
 // CriticalSection wraps CRITICAL_SECTION as its sole member — reinterpret_cast is safe on MSVC.
 // CRITICAL_SECTION::OwningThread stores the owning TID cast to HANDLE.
@@ -55,9 +66,11 @@ static bool IsCSHeldByCurrent(const CriticalSection& cs) noexcept {
 
 // §9.07 修正③ + §9.09 修正②③: Multi-candidate eviction — selects up to `count` distinct PIDs.
 // Same priority order as SelectEvictionCandidate(): zombies first, then oldest phaseStartTime.
+// §9.24: aged candidates are kept in a bounded max-heap (O(N log K), O(K) memory) so the arena
+// no longer scales with MAX_TRACKED_PROCESSES; phaseStartTime is read from the hot array.
 // PRECONDITION: trackedCs_ must be held by caller.
 static std::vector<DWORD> SelectEvictionCandidates(
-    const std::map<DWORD, std::shared_ptr<TrackedProcess>>& processes,
+    const TrackedTable& processes,
     size_t count)
 {
     // §9.09 修正③: safety cap — prevent requesting more than exists
@@ -65,10 +78,9 @@ static std::vector<DWORD> SelectEvictionCandidates(
     if (count == 0) return {};
 
     // §9.09 修正②: PMR arena for internal temporaries (picked, aged).
-    // 16KB handles ~2000-entry aged vector (12 bytes/entry) without fallback under typical load.
     // result uses std::vector (standard allocator) — std::pmr::vector → std::vector 暗黙変換不可.
     CountingResource pmrCountingRes(std::pmr::get_default_resource());
-    std::byte buf[16384];
+    std::byte buf[4096];
     std::pmr::monotonic_buffer_resource arena(buf, sizeof(buf), &pmrCountingRes);
 
     std::vector<DWORD> result;
@@ -78,7 +90,7 @@ static std::vector<DWORD> SelectEvictionCandidates(
     std::pmr::vector<DWORD> picked(&arena);
 
     // Priority 1: zombies (invalid handle)
-    for (const auto& [p, tp] : processes) {
+    for (const auto& [p, hot, tp] : processes) {
         if (result.size() >= count) break;
         if (!tp->processHandle.get()) {
             result.push_back(p);
@@ -88,25 +100,27 @@ static std::vector<DWORD> SelectEvictionCandidates(
 
     // Priority 2: oldest phaseStartTime among non-picked
     if (result.size() < count) {
+        const size_t remain = count - result.size();
+        // Max-heap on phaseStartTime: top is the youngest of the `remain` oldest seen so far
+        auto younger = [](const std::pair<DWORD, ULONGLONG>& a, const std::pair<DWORD, ULONGLONG>& b) {
+            return a.second < b.second;
+        };
         std::pmr::vector<std::pair<DWORD, ULONGLONG>> aged(&arena);
-        aged.reserve(processes.size());  // §9.08 修正③
-        for (const auto& [p, tp] : processes) {
+        aged.reserve(remain + 1);  // §9.08 修正③
+        for (const auto& [p, hot, tp] : processes) {
             bool inPicked = false;
             for (DWORD pk : picked) { if (pk == p) { inPicked = true; break; } }
-            if (!inPicked) aged.push_back({p, tp->phaseStartTime});
-        }
-        // §9.08 修正②: partial_sort when we need fewer than all entries (O(N log K) vs O(N log N))
-        size_t remain = count - result.size();
-        if (aged.size() > remain) {
-            std::partial_sort(
-                aged.begin(),
-                aged.begin() + static_cast<ptrdiff_t>(remain),
-                aged.end(),
-                [](const auto& a, const auto& b) { return a.second < b.second; });
-        } else {
-            std::sort(aged.begin(), aged.end(),
-                [](const auto& a, const auto& b) { return a.second < b.second; });
+            if (inPicked) continue;
+            if (aged.size() < remain) {
+                aged.push_back({p, hot.phaseStartTime});
+                std::push_heap(aged.begin(), aged.end(), younger);
+            } else if (hot.phaseStartTime < aged.front().second) {
+                std::pop_heap(aged.begin(), aged.end(), younger);
+                aged.back() = {p, hot.phaseStartTime};
+                std::push_heap(aged.begin(), aged.end(), younger);
+            }
         }
+        std::sort_heap(aged.begin(), aged.end(), younger);
         for (const auto& [p, _] : aged) {
             if (result.size() >= count) break;
             result.push_back(p);
@@ -131,20 +145,26 @@ static std::vector<DWORD> SelectEvictionCandidates(
 
 } // anonymous namespace
 
+#ifdef _WIN32
 EngineCore& EngineCore::Instance() {
-    static EngineCore instance;
+    static EngineCore instance(platform::NativePlatform());
     return instance;
 }
+#endif
 
-EngineCore::EngineCore()
-    : running_(false)
+EngineCore::EngineCore(platform::Platform& os)
+    : os_(os)
+    , running_(false)
     , stopRequested_(false)
+    , processMonitor_(os.monitor)
     , stopEvent_(nullptr)
     , timerQueue_(nullptr)
     , configChangeHandle_(INVALID_HANDLE_VALUE)
     , safetyNetTimer_(nullptr)
     , enforcementRequestEvent_(nullptr)
     , hWakeupEvent_(nullptr)
+    , targetTables_(std::make_shared<const TargetTables>())
+    , hasPathTargets_(false)
     , totalViolations_(0)
     , lastStatsLogTime_(0)
     , totalRetries_(0)
@@ -154,20 +174,15 @@ EngineCore::EngineCore()
     , lastProcessLivenessCheck_(0)
     , lastSuppressionCleanup_(0)
     , lastMemLogTime_(0)
-    , ntdllHandle_(nullptr)
-    , pfnNtSetInformationProcess_(nullptr)
-    , pfnNtQueryInformationProcess_(nullptr)
-    , ntApiAvailable_(false)
-    , ntApiSuccessCount_(0)
-    , ntApiFailCount_(0)
-    , policyApplyCount_(0)
+    , lastConfigCheckTime_(0)
+    , configChangePending_(false)
     , operationMode_(OperationMode::NORMAL)
     , lastEtwHealthCheck_(0)
     , lastDegradedScanTime_(0)
     , startTime_(0)
-    , lastConfigCheckTime_(0)
-    , configChangePending_(false)
-    , hasPathTargets_(false) {
+    , ntApiSuccessCount_(0)
+    , ntApiFailCount_(0)
+    , policyApplyCount_(0) {
 }
 
 EngineCore::~EngineCore() {
@@ -178,7 +193,7 @@ bool EngineCore::Initialize(const std::wstring& baseDir) {
     baseDir_ = baseDir;
 
     // Create stop event
-    stopEvent_ = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    stopEvent_ = os_.events.CreateEventObject(true);
     if (!stopEvent_) {
         LOG_ERROR(L"Engine: Failed to create stop event");
         return false;
@@ -206,7 +221,7 @@ bool EngineCore::Initialize(const std::wstring& baseDir) {
     RefreshTargetSet();
 
     // Create Timer Queue for deferred verification and persistent enforcement timers
-    timerQueue_ = CreateTimerQueue();
+    timerQueue_ = os_.timers.CreateQueue();
     if (!timerQueue_) {
         LOG_ERROR(L"Engine: Failed to create Timer Queue");
         CleanupHandles();
@@ -214,19 +229,15 @@ bool EngineCore::Initialize(const std::wstring& baseDir) {
     }
 
     // Create config change notification (event-driven)
-    std::wstring configDir = baseDir_;
-    configChangeHandle_ = FindFirstChangeNotificationW(
-        configDir.c_str(),
-        FALSE,  // Do not watch subtree
-        FILE_NOTIFY_CHANGE_LAST_WRITE
-    );
+    // §9.34: scoped to UnLeaf.ini — log writes in the same directory never wake the loop
+    configChangeHandle_ = os_.events.WatchDirectory(baseDir_, CONFIG_FILENAME);
     if (configChangeHandle_ == INVALID_HANDLE_VALUE) {
-        LOG_ALERT(L"Engine: FindFirstChangeNotification failed - config changes require restart");
+        LOG_ALERT(L"Engine: Config file watch failed - config changes require restart");
     }
 
     // Create Safety Net waitable timer (10s periodic)
     // SAFETY NET: This is an insurance consistency check, NOT monitoring
-    safetyNetTimer_ = CreateWaitableTimerW(nullptr, FALSE, nullptr);
+    safetyNetTimer_ = os_.events.CreatePeriodicTimer();
     if (!safetyNetTimer_) {
         LOG_ERROR(L"Engine: Failed to create Safety Net timer");
         CleanupHandles();
@@ -234,7 +245,7 @@ bool EngineCore::Initialize(const std::wstring& baseDir) {
     }
 
     // Create enforcement request event (auto-reset)
-    enforcementRequestEvent_ = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    enforcementRequestEvent_ = os_.events.CreateEventObject(false);
     if (!enforcementRequestEvent_) {
         LOG_ERROR(L"Engine: Failed to create enforcement request event");
         CleanupHandles();
@@ -242,98 +253,39 @@ bool EngineCore::Initialize(const std::wstring& baseDir) {
     }
 
     // Create wakeup event for process exit notifications (auto-reset)
-    hWakeupEvent_ = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    hWakeupEvent_ = os_.events.CreateEventObject(false);
     if (!hWakeupEvent_) {
         LOG_ERROR(L"Engine: Failed to create wakeup event");
         CleanupHandles();
         return false;
     }
 
-    // Load NT API functions from ntdll.dll
-    ntdllHandle_ = GetModuleHandleW(L"ntdll.dll");
-    if (ntdllHandle_) {
-        pfnNtSetInformationProcess_ = reinterpret_cast<PFN_NtSetInformationProcess>(
-            GetProcAddress(ntdllHandle_, "NtSetInformationProcess"));
-        pfnNtQueryInformationProcess_ = reinterpret_cast<PFN_NtQueryInformationProcess>(
-            GetProcAddress(ntdllHandle_, "NtQueryInformationProcess"));
-
-        ntApiAvailable_ = (pfnNtSetInformationProcess_ != nullptr);
-        if (ntApiAvailable_) {
-            LOG_DEBUG(L"Engine: NtSetInformationProcess available");
-        } else {
-            LOG_ALERT(L"Engine: NtSetInformationProcess not found");
-        }
-    } else {
-        LOG_ALERT(L"Engine: ntdll.dll not loaded");
-    }
-
-    // Detect Windows version for compatibility
-    {
-        typedef NTSTATUS(WINAPI* RtlGetVersionPtr)(PRTL_OSVERSIONINFOW);
-        RtlGetVersionPtr RtlGetVersion = nullptr;
-        if (ntdllHandle_) {
-            RtlGetVersion = reinterpret_cast<RtlGetVersionPtr>(
-                GetProcAddress(ntdllHandle_, "RtlGetVersion"));
-        }
-
-        if (RtlGetVersion) {
-            RTL_OSVERSIONINFOW osvi = {};
-            osvi.dwOSVersionInfoSize = sizeof(osvi);
-            if (RtlGetVersion(&osvi) == 0) {
-                winVersion_.major = osvi.dwMajorVersion;
-                winVersion_.minor = osvi.dwMinorVersion;
-                winVersion_.build = osvi.dwBuildNumber;
-                winVersion_.isWindows11OrLater = (osvi.dwBuildNumber >= WINDOWS_11_BUILD_THRESHOLD);
-            }
-        }
-
-        // Log detected version
-        wchar_t osName[16];
-        if (winVersion_.major >= 11) {
-            // Windows 12 以降で major が繰り上がった場合は major.minor をそのまま表示
-            swprintf_s(osName, L"%lu.%lu", winVersion_.major, winVersion_.minor);
-        } else if (winVersion_.isWindows11OrLater) {
-            // major=10 だが build >= 22000 → Windows 11
-            wcscpy_s(osName, L"11");
-        } else {
-            // build < 22000 → Windows 10
-            wcscpy_s(osName, L"10");
-        }
-
-        wchar_t verBuf[128];
-        swprintf_s(verBuf, L"Engine: Windows %s (Build %lu) - %s",
-                   osName, winVersion_.build,
-                   winVersion_.isWindows11OrLater ? L"Full EcoQoS support" : L"Limited EcoQoS (Win10 compatibility mode)");
-        LOG_INFO(verBuf);
-    }
+    // NT API resolution + Windows version detection (logged by the platform layer)
+    os_.process.Initialize();
 
     // Initialize registry policy manager (centralized)
-    RegistryPolicyManager::Instance().Initialize(baseDir);
+    os_.policy.Initialize(baseDir);
 
     LOG_INFO(L"Engine: Initialized (Event-Driven Architecture)");
     return true;
 }
 
-void EngineCore::Start() {
+void EngineCore::Start(ControlLoopMode mode) {
     if (running_.load()) return;
 
     // Encourage the process heap to decommit idle pages more aggressively (Windows 8.1+).
     // Reduces Private Working Set growth from heap fragmentation over long runs.
     // Best-effort: failure is harmless and silently ignored.
-    HEAP_OPTIMIZE_RESOURCES_INFORMATION heapOpt = {};
-    heapOpt.Version = HEAP_OPTIMIZE_RESOURCES_CURRENT_VERSION;
-    heapOpt.Flags = 0;
-    HeapSetInformation(GetProcessHeap(), HeapOptimizeResources,
-                       &heapOpt, sizeof(heapOpt));
+    os_.process.OptimizeSelfHeap();
 
     running_ = true;
     stopRequested_ = false;
+    loopMode_ = mode;
     totalViolations_ = 0;
-    ULONGLONG now = GetTickCount64();
+    ULONGLONG now = os_.clock.NowMs();
     lastStatsLogTime_ = now;
     lastDiagLogTime_ = now;
     lastDiagLostCount_ = 0;
-    QueryPerformanceFrequency(&qpcFreq_);
     lastEtwHealthCheck_ = now;
     lastJobQueryTime_ = now;
     lastSafetyNetTime_ = now;
@@ -341,18 +293,40 @@ void EngineCore::Start() {
     lastDegradedScanTime_ = now;
     lastMemLogTime_ = now;
     startTime_ = now;
-    ResetEvent(stopEvent_);
+    os_.events.ResetEvent(stopEvent_);
+
+    // §9.35: rate histograms count seconds from this start
+    processStartRate_.Reset(now);
+    threadStartRate_.Reset(now);
+    for (auto& rate : enqueueRate_) rate.Reset(now);
+    dropRate_.Reset(now);
+    evictRate_.Reset(now);
+    requestQueue_.ResetHighWater();
+    pendingStartFilter_.Reset();
+    {
+        CSLockGuard lock(treeCs_);   // §9.37: seeded again by InitialScan below
+        processTree_.Clear();
+    }
+    tickSnapshotState_ = TickSnapshotState::STALE;   // §9.38: InitialScan captures afresh
+
+    // §9.27: optional event capture for offline replay (UnLeaf_Replay).
+    // Read once per Start: toggling EventTrace takes effect on the next service start.
+    if (UnLeafConfig::Instance().IsEventTraceEnabled()) {
+        processMonitor_.SetEventTraceFile(baseDir_ + PATH_SEPARATOR + EVENT_TRACE_FILENAME);
+    }
+
+    // §9.28: untracked thread starts are rejected inside the monitor (empty until first publish)
+    processMonitor_.SetThreadEventFilter(&threadEventFilter_);
+
+    // §9.32: sources that carry exits replace per-process exit waits
+    monitorReportsExits_ = processMonitor_.SetProcessExitCallback(
+        [this](DWORD pid) { this->OnMonitorProcessExit(pid); });
+    if (monitorReportsExits_) {
+        LOG_INFO(L"Engine: Process exits delivered by the event source (per-process exit waits off)");
+    }
 
     // Start ETW with both process and thread callbacks
-    bool etwStarted = processMonitor_.Start(
-        [this](DWORD pid, DWORD parentPid, const std::wstring& imageName,
-               const std::wstring& imagePath) {
-            this->OnProcessStart(pid, parentPid, imageName, imagePath);
-        },
-        [this](DWORD threadId, DWORD ownerPid) {
-            this->OnThreadStart(threadId, ownerPid);
-        }
-    );
+    bool etwStarted = StartProcessMonitor();
 
     // Set operation mode based on ETW status
     if (etwStarted) {
@@ -366,21 +340,24 @@ void EngineCore::Start() {
     ApplyProactivePolicies();
 
     InitialScan();
+    PublishThreadEventTargets(true);   // §9.25: OnThreadStart has a snapshot from here on
 
     // Set up Safety Net waitable timer (10s periodic)
     // SAFETY NET: Insurance consistency check - NOT monitoring
-    LARGE_INTEGER dueTime;
-    dueTime.QuadPart = -static_cast<LONGLONG>(SAFETY_NET_INTERVAL) * 10000LL;  // Relative time in 100ns units
-    if (!SetWaitableTimer(safetyNetTimer_, &dueTime, static_cast<LONG>(SAFETY_NET_INTERVAL), nullptr, nullptr, FALSE)) {
+    if (!os_.events.ArmPeriodicTimer(safetyNetTimer_,
+                                     static_cast<DWORD>(SAFETY_NET_INTERVAL),
+                                     static_cast<DWORD>(SAFETY_NET_INTERVAL))) {
         LOG_ERROR(L"Engine: Failed to set Safety Net timer");
     }
 
-    // Start single EngineControlThread
-    engineControlThread_ = std::thread(&EngineCore::EngineControlLoop, this);
+    // Start single EngineControlThread (CALLER_PUMPED: caller drives RunControlLoopOnce)
+    if (mode == ControlLoopMode::OWN_THREAD) {
+        engineControlThread_ = std::thread(&EngineCore::EngineControlLoop, this);
+    }
 
     wchar_t startBuf[128];
-    swprintf_s(startBuf, L"EngineCore started: %zu name + %zu path targets, %s mode, Event-Driven, SafetyNet=10s",
-               targetNameSet_.size(), targetPathSet_.size(),
+    swprintf_s(startBuf, L"EngineCore started: %zu name + %zu path targets, %ls mode, Event-Driven, SafetyNet=10s",
+               targetTables_->names.size(), targetTables_->paths.size(),
                (operationMode_ == OperationMode::NORMAL ? L"NORMAL" : L"DEGRADED_ETW"));
     LOG_DEBUG(startBuf);
 }
@@ -393,13 +370,13 @@ void EngineCore::Stop() {
     // Step-elapsed diagnostic: every [STOP] step logs cumulative ms since
     // Stop() entry. When WER/MiniDumpWriteDump fires during shutdown the
     // last logged step identifies the phase that took too long or died.
-    const ULONGLONG stopT0 = GetTickCount64();
-    auto elapsed = [stopT0]() -> unsigned long long {
-        return GetTickCount64() - stopT0;
+    const ULONGLONG stopT0 = os_.clock.NowMs();
+    auto elapsed = [this, stopT0]() -> unsigned long long {
+        return os_.clock.NowMs() - stopT0;
     };
 
     stopRequested_ = true;
-    SetEvent(stopEvent_);
+    os_.events.SetEvent(stopEvent_);
     {
         wchar_t b[96];
         swprintf_s(b, L"[STOP] Step 1: Stop signal sent (+%llums)", elapsed());
@@ -408,6 +385,10 @@ void EngineCore::Stop() {
 
     // Stop ETW monitor
     processMonitor_.Stop();
+    monitorExitEvents_.store(false, std::memory_order_relaxed);
+    processMonitor_.SetEventTraceFile(L"");   // §9.27: flush + close the capture (no-op when off)
+    processMonitor_.SetThreadEventFilter(nullptr);
+    processMonitor_.SetProcessExitCallback(nullptr);
     {
         wchar_t b[96];
         swprintf_s(b, L"[STOP] Step 2: ETW monitor stopped (+%llums)", elapsed());
@@ -417,6 +398,8 @@ void EngineCore::Stop() {
     // Wait for single control thread
     if (engineControlThread_.joinable()) {
         engineControlThread_.join();
+    } else if (loopMode_ == ControlLoopMode::CALLER_PUMPED) {
+        DrainPendingRemovalsFinal();
     }
     {
         wchar_t b[96];
@@ -429,7 +412,7 @@ void EngineCore::Stop() {
     size_t deferredCount = 0, persistentCount = 0;
     {
         CSLockGuard lock(trackedCs_);
-        for (auto& [pid, tp] : trackedProcesses_) {
+        for (const auto& [pid, hot, tp] : trackedProcesses_) {
             if (tp->persistentTimerContext) {
                 timerContextsToDelete.push_back(tp->persistentTimerContext);
                 tp->persistentTimerContext = nullptr;
@@ -453,9 +436,9 @@ void EngineCore::Stop() {
 
     // Delete Timer Queue (waits for all timer callbacks to complete)
     if (timerQueue_) {
-        if (!DeleteTimerQueueEx(timerQueue_, INVALID_HANDLE_VALUE)) {
+        if (!os_.timers.DeleteQueue(timerQueue_, true)) {
             wchar_t alertBuf[96];
-            swprintf_s(alertBuf, L"[STOP] DeleteTimerQueueEx failed (error=%lu)", GetLastError());
+            swprintf_s(alertBuf, L"[STOP] DeleteTimerQueueEx failed (error=%u)", os_.timers.LastError());
             LOG_ALERT(alertBuf);
             shutdownWarnings_.fetch_add(1);
         }
@@ -474,15 +457,15 @@ void EngineCore::Stop() {
 
     // Cleanup tracked processes with safe wait handle unregistration
     {
-        std::vector<HANDLE> waitHandles;
+        std::vector<platform::NativeHandle> waitHandles;
         std::vector<WaitCallbackContext*> contextsToDelete;
 
         {
             CSLockGuard lock(trackedCs_);
-            for (auto& pair : trackedProcesses_) {
-                if (pair.second->waitHandle) {
-                    waitHandles.push_back(pair.second->waitHandle);
-                    pair.second->waitHandle = nullptr;
+            for (const auto& [pid, hot, tp] : trackedProcesses_) {
+                if (tp->waitHandle) {
+                    waitHandles.push_back(tp->waitHandle);
+                    tp->waitHandle = nullptr;
                 }
             }
             for (auto& [pid, ctx] : waitContexts_) {
@@ -490,10 +473,12 @@ void EngineCore::Stop() {
             }
             waitContexts_.clear();
             trackedProcesses_.clear();
+            trackedPidFilter_.Reset();
         }
+        PublishThreadEventTargets(true);
 
-        for (HANDLE h : waitHandles) {
-            if (!UnregisterWaitEx(h, INVALID_HANDLE_VALUE)) {
+        for (platform::NativeHandle h : waitHandles) {
+            if (!os_.process.UnregisterExitWait(h)) {
                 shutdownWarnings_.fetch_add(1);
                 waitUnregisterFailures_.fetch_add(1, std::memory_order_relaxed);
             } else {
@@ -522,7 +507,7 @@ void EngineCore::Stop() {
     }
 
     // Cleanup all registry policies (both PowerThrottling + IFEO)
-    RegistryPolicyManager::Instance().CleanupAllPolicies();
+    os_.policy.CleanupAllPolicies();
     {
         CSLockGuard lock(policySetCs_);
         policyCacheLru_.clear();
@@ -559,169 +544,281 @@ void EngineCore::Stop() {
 
 void EngineCore::CleanupHandles() {
     if (stopEvent_) {
-        CloseHandle(stopEvent_);
+        os_.events.CloseHandle(stopEvent_);
         stopEvent_ = nullptr;
     }
     if (timerQueue_) {
-        DeleteTimerQueueEx(timerQueue_, nullptr);
+        os_.timers.DeleteQueue(timerQueue_, false);
         timerQueue_ = nullptr;
     }
     if (configChangeHandle_ != INVALID_HANDLE_VALUE) {
-        FindCloseChangeNotification(configChangeHandle_);
+        os_.events.CloseDirectoryWatch(configChangeHandle_);
         configChangeHandle_ = INVALID_HANDLE_VALUE;
     }
     if (safetyNetTimer_) {
-        CloseHandle(safetyNetTimer_);
+        os_.events.CloseHandle(safetyNetTimer_);
         safetyNetTimer_ = nullptr;
     }
     if (enforcementRequestEvent_) {
-        CloseHandle(enforcementRequestEvent_);
+        os_.events.CloseHandle(enforcementRequestEvent_);
         enforcementRequestEvent_ = nullptr;
     }
     if (hWakeupEvent_) {
-        CloseHandle(hWakeupEvent_);
+        os_.events.CloseHandle(hWakeupEvent_);
         hWakeupEvent_ = nullptr;
     }
 }
 
 // === ETW Callbacks ===
 
-void EngineCore::OnProcessStart(DWORD pid, DWORD parentPid,
-                                 const std::wstring& imageName, const std::wstring& imagePath) {
+// §9.29: One call per delivered batch (ETW buffer). Classification, locking and signaling
+// are amortized: one target-table snapshot, one treeCs_ acquisition (§9.37: tree inserts +
+// ancestor chains), one SetEvent for everything admitted. Parent / ancestor lookups probe
+// trackedPidFilter_ (no trackedCs_); only admitted starts intern their image (§9.30).
+void EngineCore::OnProcessStartBatch(const engine_logic::ProcessStartBatch& batch) {
     if (stopRequested_.load()) return;
-    if (IsCriticalProcess(imageName)) return;
+    processStartBatches_.fetch_add(1, std::memory_order_relaxed);
+    const ULONGLONG now = os_.clock.NowMs();
+    processStartRate_.Add(now, static_cast<uint32_t>(batch.Size()));
 
     // ETW callback thread: no blocking OS calls allowed.
-    // IsTargetName/IsTrackedParent/HasPathTargets are atomic/read-only (μs).
     // Heavy work (OpenProcess, job objects, etc.) is deferred to EngineControlLoop.
-    bool isTarget = IsTargetName(imageName) || IsTrackedParent(parentPid) || HasPathTargets();
-    if (isTarget) {
-        EnqueueRequest(EnforcementRequest(pid, parentPid, imageName, imagePath));
+    enum : uint8_t { SKIP, ADMIT, CHECK_PARENT };
+    uint8_t verdict[engine_logic::ProcessStartBatch::CAPACITY];
+    bool critical[engine_logic::ProcessStartBatch::CAPACITY];
+    {
+        const std::shared_ptr<const TargetTables> targets = SnapshotTargets();
+        // §9.41: a path target can only match an image with one of its file names
+        // (TryApplyByPath filename fallback uses the same table). Other starts are not
+        // enqueued just because some path target exists.
+        const bool pathTargetsActive = !targets->paths.empty();
+        for (size_t i = 0; i < batch.Size(); ++i) {
+            const std::wstring_view name = batch.ImageName(i);
+            critical[i] = IsCriticalImage(name);
+            if (critical[i]) {
+                verdict[i] = SKIP;
+            } else if (targets->names.Contains(name) ||
+                       (pathTargetsActive && targets->pathFileNames.Contains(name)) ||
+                       pendingStartFilter_.Test(batch[i].parentPid)) {
+                verdict[i] = ADMIT;
+                pendingStartFilter_.Set(batch[i].pid);   // before the tracked check of its children
+            } else {
+                verdict[i] = CHECK_PARENT;
+            }
+        }
+    }
+
+    // §9.37: every start enters the process tree (PID reuse replaces the old node) by name
+    // hash only — the next snapshot names it. Records no name matched take their ancestor
+    // chain while it is intact: a launcher between them and a tracked process may exit
+    // before the request is dispatched.
+    DWORD ancestors[engine_logic::ProcessStartBatch::CAPACITY][PROCESS_TREE_ANCESTOR_DEPTH];
+    uint8_t ancestorCount[engine_logic::ProcessStartBatch::CAPACITY];
+    {
+        CSLockGuard lock(treeCs_);
+        for (size_t i = 0; i < batch.Size(); ++i) {
+            processTree_.Insert(batch[i].pid, batch[i].parentPid, now, batch.ImageName(i), critical[i]);
+            ancestorCount[i] = (verdict[i] == CHECK_PARENT)
+                ? static_cast<uint8_t>(CollectAncestorsLocked(batch[i].pid, ancestors[i])) : 0;
+        }
+    }
+
+    // Set on insert under trackedCs_, cleared on erase: same answer as the map, lock-free
+    auto isTracked = [this](DWORD pid) {
+        return pid < engine_logic::PidBitmap::PID_SPACE && trackedPidFilter_.Test(pid);
+    };
+    DWORD admitParent[engine_logic::ProcessStartBatch::CAPACITY];
+    for (size_t i = 0; i < batch.Size(); ++i) {
+        admitParent[i] = batch[i].parentPid;
+        if (verdict[i] != CHECK_PARENT) continue;
+        if (isTracked(batch[i].parentPid)) {
+            verdict[i] = ADMIT;
+            continue;
+        }
+        verdict[i] = SKIP;
+        for (size_t k = 0; k < ancestorCount[i]; ++k) {
+            if (isTracked(ancestors[i][k])) {
+                verdict[i] = ADMIT;
+                admitParent[i] = ancestors[i][k];   // tracked as its child (RefreshJobObjectPids 同様)
+                ancestorAdmitCount_.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+        }
+    }
+
+    engine_logic::StringInternTable& strings = engine_logic::StringInternTable::Instance();
+
+    bool signal = false;
+    for (size_t i = 0; i < batch.Size(); ++i) {
+        if (verdict[i] != ADMIT) continue;
+        pendingStartFilter_.Set(batch[i].pid);
+        bool wasEmpty = false;
+        // §9.30: one interned ID per request; the queue takes over the reference
+        if (!AdmitRequest(EnforcementRequest(batch[i].pid, admitParent[i], strings.Intern(batch.Image(i))),
+                          wasEmpty)) {
+            pendingStartFilter_.Clear(batch[i].pid);
+        }
+        signal |= wasEmpty;
+    }
+    if (signal) {
+        os_.events.SetEvent(enforcementRequestEvent_);
     }
 }
 
 // ETW callback for thread creation events
 // Thread creation is a trigger point where OS may re-apply EcoQoS
+// §9.39: threadId is the new thread (0 = unknown). It travels with the request so the
+// enforcement touches that thread only instead of every thread of the owner.
 void EngineCore::OnThreadStart(DWORD threadId, DWORD ownerPid) {
-    (void)threadId;  // Not used, we only care about the owner PID
-
     if (stopRequested_.load()) return;
+    threadStartRate_.Add(os_.clock.NowMs());
 
-    // Quick filter: only process tracked PIDs (O(1) lookup)
-    bool isTracked = false;
-    ProcessPhase currentPhase = ProcessPhase::STABLE;
-    {
-        CSLockGuard lock(trackedCs_);
-        auto it = trackedProcesses_.find(ownerPid);
-        if (it != trackedProcesses_.end()) {
-            isTracked = true;
-            currentPhase = it->second->phase;
+    // Quick filter: only STABLE and PERSISTENT tracked PIDs (O(1) lookup)
+    // AGGRESSIVE already has active deferred verification
+    // PERSISTENT has 5s timer but ETW boost provides instant response on tab switch
+    // §9.25: lock-free — published snapshot, never trackedCs_ (the control thread may hold it)
+    auto targets = threadEventTargets_.Read();
+    if (!targets) return;
+    std::atomic<uint8_t>* pending = targets->Find(ownerPid);
+    if (!pending) return;
+
+    // §9.23: Enqueue-time coalescing — at most one ETW_THREAD_START per PID until drained.
+    // Thread storms collapse into a single request; queue occupancy is O(tracked processes).
+    // §9.39: a thread coalesced behind the queued one marks the slot COALESCED, so the
+    // dispatch sweeps the whole process instead of boosting the first thread only.
+    uint8_t state = pending->load(std::memory_order_acquire);
+    for (;;) {
+        if (state == THREAD_EVENT_COALESCED) {
+            etwThreadDeduped_.fetch_add(1, std::memory_order_relaxed);
+            return;
         }
+        const uint8_t next = (state == THREAD_EVENT_IDLE) ? THREAD_EVENT_QUEUED : THREAD_EVENT_COALESCED;
+        // Fails when the control thread drained the slot (or another thread won): re-decide
+        if (pending->compare_exchange_weak(state, next, std::memory_order_acq_rel)) break;
+    }
+    if (state != THREAD_EVENT_IDLE) {
+        etwThreadDeduped_.fetch_add(1, std::memory_order_relaxed);
+        return;
     }
 
-    if (!isTracked) return;
-
-    // Queue check for STABLE and PERSISTENT phase processes
-    // AGGRESSIVE already has active deferred verification
-    // PERSISTENT has 5s timer but ETW boost provides instant response on tab switch
-    if (currentPhase == ProcessPhase::STABLE || currentPhase == ProcessPhase::PERSISTENT) {
-        EnqueueRequest(EnforcementRequest(ownerPid, EnforcementRequestType::ETW_THREAD_START));
+    EnforcementRequest req(ownerPid, EnforcementRequestType::ETW_THREAD_START);
+    req.threadId = threadId;
+    if (!EnqueueRequest(req)) {
+        // Not queued: release the slot so the next thread event can retry
+        pending->store(THREAD_EVENT_IDLE, std::memory_order_release);
     }
 }
 
 // === Event-Driven Engine Control Loop ===
 
 void EngineCore::EngineControlLoop() {
-#ifdef _DEBUG
+#if defined(_DEBUG) && defined(_WIN32)
     engineControlThreadId_.store(GetCurrentThreadId(), std::memory_order_relaxed);
 #endif
     LOG_INFO(L"Engine: Event-driven control loop started (SafetyNet=10s, Event-triggered)");
 
-    // Build wait handle array
-    HANDLE waitHandles[WAIT_COUNT];
+    while (RunControlLoopOnce(INFINITE)) {}
+
+    DrainPendingRemovalsFinal();
+
+    LOG_INFO(L"Engine: Event-driven control loop ended");
+#if defined(_DEBUG) && defined(_WIN32)
+    engineControlThreadId_.store(0, std::memory_order_relaxed);  // Prevent stale ID after loop exit / restart
+#endif
+}
+
+bool EngineCore::RunControlLoopOnce(DWORD timeoutMs) {
+    if (stopRequested_.load()) return false;
+
+    // Build wait handle array (rebuilt per wait: configChangeHandle_ may be closed on failure)
+    platform::NativeHandle waitHandles[WAIT_COUNT];
     waitHandles[WAIT_STOP] = stopEvent_;
     waitHandles[WAIT_CONFIG_CHANGE] = (configChangeHandle_ != INVALID_HANDLE_VALUE) ? configChangeHandle_ : stopEvent_;
     waitHandles[WAIT_SAFETY_NET] = safetyNetTimer_;
     waitHandles[WAIT_ENFORCEMENT_REQUEST] = enforcementRequestEvent_;
     waitHandles[WAIT_PROCESS_EXIT] = hWakeupEvent_;
 
-    // Spin detection: last line of defense against event misfire or future bugs
-    static thread_local uint32_t spinCount = 0;
+    DWORD waitResult = os_.events.WaitAny(waitHandles, WAIT_COUNT, timeoutMs);
 
-    while (!stopRequested_.load()) {
-        DWORD waitResult = WaitForMultipleObjects(WAIT_COUNT, waitHandles, FALSE, INFINITE);
+    if (waitResult == WAIT_OBJECT_0 + WAIT_STOP)
+        return false;
 
-        if (waitResult == WAIT_OBJECT_0 + WAIT_STOP)
-            break;
+    if (waitResult == WAIT_FAILED) {
+        wchar_t errBuf[96];
+        swprintf_s(errBuf, L"Engine: WaitForMultipleObjects failed (error=%u)", os_.events.LastError());
+        LOG_ERROR(errBuf);
+        return false;
+    }
 
-        if (waitResult == WAIT_FAILED) {
-            wchar_t errBuf[96];
-            swprintf_s(errBuf, L"Engine: WaitForMultipleObjects failed (error=%lu)", GetLastError());
-            LOG_ERROR(errBuf);
-            break;
-        }
+    ULONGLONG now = os_.clock.NowMs();
 
-        ULONGLONG now = GetTickCount64();
+    // §9.38: a new tick — the first snapshot consumer below captures, the rest share it
+    tickSnapshotState_ = TickSnapshotState::STALE;
 
-        // Spin detection on hWakeupEvent_ consecutive fires
-        if (waitResult == WAIT_OBJECT_0 + WAIT_PROCESS_EXIT) {
-            if (++spinCount > 10000) {
-                LOG_ALERT(L"[SPIN DETECTED] excessive wakeups");
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                spinCount = 0;
-            }
-        } else {
-            spinCount = 0;
-        }
-
-        switch (waitResult) {
-            case WAIT_OBJECT_0 + WAIT_CONFIG_CHANGE:
-                wakeupConfigChange_.fetch_add(1);
-                configChangeDetected_.fetch_add(1);
-                // Debounce: notification fires for ALL file changes in directory
-                // (including log writes). Defer actual check to reduce unnecessary file stats.
-                configChangePending_ = true;
-                if (configChangeHandle_ != INVALID_HANDLE_VALUE) {
-                    if (!FindNextChangeNotification(configChangeHandle_)) {
-                        LOG_ALERT(L"[CONFIG] FindNextChangeNotification failed - "
-                                  L"config change detection disabled");
-                        FindCloseChangeNotification(configChangeHandle_);
-                        configChangeHandle_ = INVALID_HANDLE_VALUE;
-                    }
+    // Spin detection on hWakeupEvent_ consecutive fires
+    // (last line of defense against event misfire or future bugs)
+    if (waitResult == WAIT_OBJECT_0 + WAIT_PROCESS_EXIT) {
+        if (++spinCount_ > 10000) {
+            LOG_ALERT(L"[SPIN DETECTED] excessive wakeups");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            spinCount_ = 0;
+        }
+    } else {
+        spinCount_ = 0;
+    }
+
+    switch (waitResult) {
+        case WAIT_OBJECT_0 + WAIT_CONFIG_CHANGE:
+            configChangeDetected_.fetch_add(1);
+            // Debounce: one editor save can arrive as several writes or a rename.
+            // Defer the content check so the burst costs one read.
+            configChangePending_ = true;
+            if (configChangeHandle_ != INVALID_HANDLE_VALUE) {
+                if (!os_.events.RearmDirectoryWatch(configChangeHandle_)) {
+                    LOG_ALERT(L"[CONFIG] Config file watch re-arm failed - "
+                              L"config change detection disabled");
+                    os_.events.CloseDirectoryWatch(configChangeHandle_);
+                    configChangeHandle_ = INVALID_HANDLE_VALUE;
                 }
-                break;
-
-            case WAIT_OBJECT_0 + WAIT_SAFETY_NET:
-                wakeupSafetyNet_.fetch_add(1);
-                HandleSafetyNetCheck();
-                lastSafetyNetTime_ = now;
-                break;
+            }
+            break;
 
-            case WAIT_OBJECT_0 + WAIT_ENFORCEMENT_REQUEST:
-                wakeupEnforcementRequest_.fetch_add(1);
-                ProcessEnforcementQueue();
-                break;
+        case WAIT_OBJECT_0 + WAIT_SAFETY_NET:
+            wakeupSafetyNet_.fetch_add(1);
+            HandleSafetyNetCheck();
+            lastSafetyNetTime_ = now;
+            break;
 
-            case WAIT_OBJECT_0 + WAIT_PROCESS_EXIT:
-                wakeupProcessExit_.fetch_add(1);
-                ProcessPendingRemovals();
-                break;
+        case WAIT_OBJECT_0 + WAIT_ENFORCEMENT_REQUEST:
+            wakeupEnforcementRequest_.fetch_add(1);
+            ProcessEnforcementQueue();
+            break;
 
-            default:
-                break;
-        }
+        case WAIT_OBJECT_0 + WAIT_PROCESS_EXIT:
+            wakeupProcessExit_.fetch_add(1);
+            ProcessPendingRemovals();
+            break;
 
-        // Process debounced config change
-        if (configChangePending_ && now - lastConfigCheckTime_ >= CONFIG_DEBOUNCE_MS) {
-            HandleConfigChange();
-            lastConfigCheckTime_ = now;
-            configChangePending_ = false;
-        }
+        default:
+            break;
+    }
 
-        PerformPeriodicMaintenance(now);
+    // Process debounced config change
+    if (configChangePending_ && now - lastConfigCheckTime_ >= CONFIG_DEBOUNCE_MS) {
+        HandleConfigChange();
+        lastConfigCheckTime_ = now;
+        configChangePending_ = false;
     }
 
-    // Final drain: process ALL remaining before loop exit (no cap — service stopping)
+    PerformPeriodicMaintenance(now);
+
+    // §9.25: removals / phase changes from this iteration become visible to OnThreadStart
+    PublishThreadEventTargets();
+    return !stopRequested_.load();
+}
+
+// Final drain: process ALL remaining before loop exit (no cap — service stopping)
+void EngineCore::DrainPendingRemovalsFinal() {
     for (;;) {
         std::queue<DWORD> pending;
         {
@@ -734,355 +831,415 @@ void EngineCore::EngineControlLoop() {
             pending.pop();
         }
     }
-
-    LOG_INFO(L"Engine: Event-driven control loop ended");
-#ifdef _DEBUG
-    engineControlThreadId_.store(0, std::memory_order_relaxed);  // Prevent stale ID after loop exit / restart
-#endif
 }
 
 // Enqueue enforcement request (called from ETW callbacks and timer callbacks)
 // §9.14-A: 2-queue CRITICAL/NON-CRITICAL split with TOTAL_LIMIT absolute guarantee.
 // ETW_THREAD_START = NON-CRITICAL (droppable at SOFT_LIMIT).
 // All other types = CRITICAL (eviction from nonCritical first, then oldest-CRITICAL rotation).
-void EngineCore::EnqueueRequest(const EnforcementRequest& req) {
-    const bool isCritical = (req.type != EnforcementRequestType::ETW_THREAD_START);
-    bool wasEmpty;
-    {
-        CSLockGuard lock(queueCs_);
-        wasEmpty = criticalQueue_.empty() && nonCriticalQueue_.empty();
-
-        const size_t total = criticalQueue_.size() + nonCriticalQueue_.size();
-
-        if (!isCritical) {
-            // NON-CRITICAL: 個別 OR 合計上限でドロップ（高頻度のためログなし）
-            if (nonCriticalQueue_.size() >= ENFORCEMENT_QUEUE_SOFT_LIMIT ||
-                total >= ENFORCEMENT_QUEUE_TOTAL_LIMIT) {
-                enforcementDropCount_.fetch_add(1, std::memory_order_relaxed);
-                return;
-            }
-            nonCriticalQueue_.push_back(req);
-        } else {
-            // CRITICAL: 個別上限チェック
-            if (criticalQueue_.size() >= ENFORCEMENT_QUEUE_HARD_LIMIT) {
-                uint32_t cnt = criticalDropCount_.fetch_add(1, std::memory_order_relaxed);
-                if ((cnt & 0xFF) == 0)
-                    LOG_ALERT(L"[QUEUE] CRITICAL HARD drop=" + std::to_wstring(cnt + 1));
-                return;
-            }
+bool EngineCore::EnqueueRequest(const EnforcementRequest& req) {
+    bool wasEmpty = false;
+    if (!AdmitRequest(req, wasEmpty)) return false;
+    if (wasEmpty) {
+        os_.events.SetEvent(enforcementRequestEvent_);
+    }
+    return true;
+}
 
-            // CRITICAL: 合計上限超過時の処理（TOTAL_LIMIT 絶対保証）
-            if (total >= ENFORCEMENT_QUEUE_TOTAL_LIMIT) {
-                if (!nonCriticalQueue_.empty()) {
-                    // NON-CRITICAL を追い出して空きを確保 (O(1))
-                    nonCriticalQueue_.pop_front();
-                    enforcementDropCount_.fetch_add(1, std::memory_order_relaxed);
-                } else if (!criticalQueue_.empty()) {
-                    // nonCritical 空 + TOTAL_LIMIT 到達 → 最古 CRITICAL を evict して新規を受け入れる
-                    // TOTAL_LIMIT は pop_front 1 + push_back 1 で維持（O(1)）
-                    // 完全喪失より最古イベントの破棄を優先する設計
-                    uint32_t cnt = criticalEvictCount_.fetch_add(1, std::memory_order_relaxed);
-                    if ((cnt & 0xFF) == 0)
-                        LOG_ALERT(L"[QUEUE] TOTAL-LIMIT evict oldest CRITICAL evict=" + std::to_wstring(cnt + 1));
-                    criticalQueue_.pop_front();
-                } else {
-                    // criticalQueue_ も空 = TOTAL_LIMIT=0 設定など異常構成 → 受け入れ不能
-                    criticalDropCount_.fetch_add(1, std::memory_order_relaxed);
-                    return;
-                }
-            }
-            criticalQueue_.push_back(req);
+bool EngineCore::AdmitRequest(const EnforcementRequest& req, bool& wasEmpty) {
+    // §9.22: lock-free admission — SOFT/HARD/TOTAL 判定と eviction は EnforcementQueue 内の CAS 1 回
+    const ULONGLONG now = os_.clock.NowMs();
+    switch (requestQueue_.Push(req, wasEmpty)) {
+        case EnforcementQueue::PushResult::ACCEPTED:
+            break;
+        case EnforcementQueue::PushResult::ACCEPTED_EVICTED_NONCRITICAL:
+            // NON-CRITICAL を追い出して空きを確保
+            enforcementDropCount_.fetch_add(1, std::memory_order_relaxed);
+            evictRate_.Add(now);
+            break;
+        case EnforcementQueue::PushResult::ACCEPTED_EVICTED_CRITICAL: {
+            // nonCritical 空 + TOTAL_LIMIT 到達 → 最古 CRITICAL を evict して新規を受け入れる
+            // 完全喪失より最古イベントの破棄を優先する設計
+            uint32_t cnt = criticalEvictCount_.fetch_add(1, std::memory_order_relaxed);
+            if ((cnt & 0xFF) == 0)
+                LOG_ALERT(L"[QUEUE] TOTAL-LIMIT evict oldest CRITICAL evict=" + std::to_wstring(cnt + 1));
+            evictRate_.Add(now);
+            break;
+        }
+        case EnforcementQueue::PushResult::DROPPED_NONCRITICAL:
+            // 高頻度のためログなし
+            enforcementDropCount_.fetch_add(1, std::memory_order_relaxed);
+            dropRate_.Add(now);
+            return false;
+        case EnforcementQueue::PushResult::DROPPED_CRITICAL: {
+            uint32_t cnt = criticalDropCount_.fetch_add(1, std::memory_order_relaxed);
+            if ((cnt & 0xFF) == 0)
+                LOG_ALERT(L"[QUEUE] CRITICAL HARD drop=" + std::to_wstring(cnt + 1));
+            dropRate_.Add(now);
+            return false;
         }
     }
-    if (wasEmpty) {
-        SetEvent(enforcementRequestEvent_);
-    }
+    enqueueRate_[static_cast<size_t>(req.type)].Add(now);
+    return true;
 }
 
 // Process all queued enforcement requests
-// §9.14-A: CRITICAL を先に処理（バースト制限付き）、NON-CRITICAL は PMR dedup 適用。
+// §9.14-A: CRITICAL を先に処理（バースト制限付き）、NON-CRITICAL は PID ごとに 1 件 (§9.23)。
 void EngineCore::ProcessEnforcementQueue() {
-    std::deque<EnforcementRequest> critical, nonCritical;
-    {
-        CSLockGuard lock(queueCs_);
-        // CRITICAL: バースト制限あり（CPU 安定化のため）
-        // 残件は criticalQueue_ に留まり次回呼び出しで処理される（re-enqueue 不要）
-        const int toDrain = std::min(static_cast<int>(criticalQueue_.size()), ENFORCEMENT_CRITICAL_PER_TICK);
-        for (int i = 0; i < toDrain; i++) {
-            critical.push_back(std::move(criticalQueue_.front()));
-            criticalQueue_.pop_front();
-        }
-        // NON-CRITICAL: 全量スワップ
-        std::swap(nonCritical, nonCriticalQueue_);
+    std::vector<EnforcementRequest> critical, nonCritical;
+    std::vector<DWORD> evictedStartPids, evictedThreadPids;
+    // CRITICAL: バースト制限あり（CPU 安定化のため）
+    // 残件はリングに留まり、末尾の再シグナルで次回呼び出しが処理する
+    requestQueue_.PopCritical(critical, ENFORCEMENT_CRITICAL_PER_TICK, &evictedStartPids);
+    // NON-CRITICAL: 呼び出し時点の全量
+    requestQueue_.PopNonCritical(nonCritical, &evictedThreadPids);
+
+    // §9.36: evicted ETW_PROCESS_START never reaches Dispatch — drop its pending-start bit here
+    for (DWORD pid : evictedStartPids) {
+        pendingStartFilter_.Clear(pid);
+    }
+    // §9.23: evicted ETW_THREAD_START never reaches PlanDispatch — release its coalescing slot
+    for (DWORD pid : evictedThreadPids) {
+        ClearThreadEventPending(pid);
     }
 
     // CRITICAL を先に処理（フェーズ遷移・プロセス検出を優先）
     for (const auto& req : critical) {
-        if (stopRequested_.load()) return;
+        if (stopRequested_.load()) break;
         DispatchEnforcementRequest(req);
     }
-
-    // NON-CRITICAL: 既存の PMR arena デデュプ処理を適用
-    // Deduplicate: merge same-PID ETW_THREAD_START requests to prevent
-    // O(N^2) CreateToolhelp32Snapshot storms during thread burst
-    //
-    // §9.00: Local PMR arena — temporary containers allocated from stack buffer.
-    // §9.05: CountingResource defined in anonymous namespace; fallback visible in Debug and Release.
-    CountingResource counting(std::pmr::get_default_resource());
-    std::byte arenaBuf[8 * 1024];
-    std::pmr::monotonic_buffer_resource arena(arenaBuf, sizeof(arenaBuf), &counting);
-
-    std::pmr::vector<EnforcementRequest> deduped(&arena);
-    std::pmr::set<DWORD> seenEtwPids(&arena);
-    for (auto& req : nonCritical) {
-        // All items in nonCritical are ETW_THREAD_START; dedup by PID
-        if (seenEtwPids.count(req.pid)) {
-            etwThreadDeduped_.fetch_add(1, std::memory_order_relaxed);
-            continue;
-        }
-        seenEtwPids.insert(req.pid);
-        deduped.push_back(std::move(req));
+    // §9.30: delivered ETW_PROCESS_START requests own one reference on imageId
+    for (const auto& req : critical) {
+        engine_logic::StringInternTable::Instance().Release(req.imageId);
     }
+    if (stopRequested_.load()) return;
 
-    for (const auto& req : deduped) {
+    // NON-CRITICAL: already one request per PID (§9.23 enqueue-time coalescing)
+    for (const auto& req : nonCritical) {
         if (stopRequested_.load()) break;
         DispatchEnforcementRequest(req);
     }
 
-    if (counting.count() > 0) {
-#ifdef _DEBUG
-        wchar_t dbgBuf[128];
-        swprintf_s(dbgBuf, L"[PMR] ProcessEnforcementQueue arena fallback count=%zu", counting.count());
-        LOG_DEBUG(dbgBuf);
-#else
-        static std::atomic<int> pmrWarnCount{0};
-        if (pmrWarnCount.fetch_add(1, std::memory_order_relaxed) < 10) {
-            LOG_INFO(L"[PMR] ProcessEnforcementQueue fallback detected");
-        }
-#endif
+    // §9.22: CRITICAL burst remainder / slots claimed but not yet published during the drain.
+    // Producers only signal on the empty->non-empty edge, so the consumer re-arms itself.
+    if (!requestQueue_.Empty()) {
+        os_.events.SetEvent(enforcementRequestEvent_);
     }
+
+    // §9.25: phase transitions committed above become visible to OnThreadStart
+    PublishThreadEventTargets();
 }
 
 // Dispatch a single enforcement request
+// §9.21: Plan / Execute / Commit.
+//   Plan    (trackedCs_):  判定のみ。ハンドル・フェーズ・stateVersion を取得、キャッシュ参照。
+//   Execute (ロックなし):  IsEcoQoSEnabled / PulseEnforceV6 等のカーネル呼び出し。
+//   Commit  (trackedCs_):  stateVersion 一致時のみフェーズ遷移・カウンタを反映。
+//   Effects (ロックなし):  タイマー作成/削除、ログ出力。
+// trackedCs_ を保持したままカーネル I/O を行わないため、ETW コールバック
+// (OnThreadStart / OnProcessStop) がエンフォースメント中にブロックされない。
 void EngineCore::DispatchEnforcementRequest(const EnforcementRequest& req) {
     // ETW_PROCESS_START: new process detected — not yet in trackedProcesses_.
     // ApplyOptimization acquires trackedCs_ internally; call outside any lock.
     if (req.type == EnforcementRequestType::ETW_PROCESS_START) {
         if (stopRequested_.load()) return;
-        if (IsTrackedParent(req.parentPid)) {
-            ApplyOptimization(req.pid, req.imageName, true, req.parentPid, req.imagePath);
-        } else if (IsTargetName(req.imageName)) {
-            ApplyOptimization(req.pid, req.imageName, false, 0, req.imagePath);
+        // §9.30: ETW image string (path, or bare name) from the intern table; name = tail
+        const std::wstring_view image = engine_logic::StringInternTable::Instance().View(req.imageId);
+        const std::wstring imageName(engine_logic::FileNameOf(image));
+        const std::wstring imagePath(imageName.size() < image.size() ? image : std::wstring_view());
+        const DWORD trackedAncestor = FindTrackedAncestor(req.pid, req.parentPid);   // §9.37
+        if (trackedAncestor != 0) {
+            ApplyOptimization(req.pid, imageName, true, trackedAncestor, imagePath);
+        } else if (IsTargetName(imageName)) {
+            ApplyOptimization(req.pid, imageName, false, 0, imagePath);
         } else if (HasPathTargets()) {
-            TryApplyByPath(req.pid, req.imageName);
+            TryApplyByPath(req.pid, imageName);
         }
+        pendingStartFilter_.Clear(req.pid);   // §9.36: after tracking, so children see one or the other
         return;
     }
 
-    // Accumulators for timer cleanup: filled inside lock, deleted outside lock
-    // (DeleteTimerQueueTimer(INVALID_HANDLE_VALUE) must not be called while holding trackedCs_)
-    std::vector<HANDLE>               timersToDelete;
-    std::vector<DeferredVerifyContext*> ctxToDelete;
+    const ULONGLONG now = os_.clock.NowMs();
 
-    {
+    DispatchPlan plan;
+    if (!PlanDispatch(req, now, plan)) {
+        delete plan.firedContext;
+        return;
+    }
+
+    ExecuteDispatch(req, plan);
+
+    DispatchEffects fx;
+    CommitDispatch(req, now, plan, fx);
+    delete plan.firedContext;
+    ApplyDispatchEffects(req.pid, fx);
+}
+
+// Plan: decide under trackedCs_ which kernel calls are needed. No I/O here.
+bool EngineCore::PlanDispatch(const EnforcementRequest& req, ULONGLONG now, DispatchPlan& plan) {
     CSLockGuard lock(trackedCs_);
     auto it = trackedProcesses_.find(req.pid);
-    if (it == trackedProcesses_.end()) return;
-    auto& tp = *it->second;
+    if (it == trackedProcesses_.end()) return false;
+    TrackedProcess& tp = *it.cold();
+    TrackedHot& hot = it.hot();
 
-    if (!tp.processHandle.get()) return;
-
-    ULONGLONG now = GetTickCount64();
+    // §9.23: drained — thread events from here on enqueue a fresh request
+    // §9.39: single thread seen -> act on it alone; coalesced storm / unknown TID -> sweep
+    if (req.type == EnforcementRequestType::ETW_THREAD_START) {
+        if (ClearThreadEventPending(req.pid) != THREAD_EVENT_COALESCED) plan.threadId = req.threadId;
+    }
+    if (!tp.processHandle.get()) return false;
 
     switch (req.type) {
         case EnforcementRequestType::ETW_THREAD_START:
-            // Thread created in tracked process - check for EcoQoS violation
-            if (tp.phase == ProcessPhase::STABLE) {
+            if (hot.phase == ProcessPhase::STABLE) {
                 // Rate limit to prevent CPU burst during thread storms
-                if (now - tp.lastEtwEnforceTime < ETW_STABLE_RATE_LIMIT) {
-                    break;
-                }
-                bool ecoQoSOn = IsEcoQoSEnabledCached(tp, now);
+                if (now - hot.lastEtwEnforceTime < ETW_STABLE_RATE_LIMIT) return false;
+            } else if (hot.phase == ProcessPhase::PERSISTENT) {
+                // ETW boost: rate-limited instant response for PERSISTENT phase
+                if (now - hot.lastEtwEnforceTime < ETW_BOOST_RATE_LIMIT) return false;
+            } else {
+                return false;
+            }
+            // Micro-cache: a valid entry avoids the NtQueryInformationProcess entirely
+            plan.useCache = true;
+            if (engine_logic::IsCacheValid(hot.ecoQosCached,
+                    static_cast<uint64_t>(now),
+                    static_cast<uint64_t>(hot.ecoQosCacheTime),
+                    policy_.cacheDurationMs)) {
+                plan.ecoQoSOn = hot.ecoQosCachedValue;
+            } else {
+                plan.needsQuery = true;
+            }
+            plan.enforceIfOn = true;
+            break;
+
+        case EnforcementRequestType::DEFERRED_VERIFICATION:
+            if (hot.phase != ProcessPhase::AGGRESSIVE) return false;
+            // Fired one-shot timer: detach its context now, free it outside the lock
+            plan.firedContext = std::exchange(tp.deferredTimerContext, nullptr);
+            tp.deferredTimer = nullptr;
+            plan.needsQuery = true;
+            plan.enforceIfOn = true;
+            break;
+
+        case EnforcementRequestType::PERSISTENT_ENFORCE:
+            if (hot.phase != ProcessPhase::PERSISTENT) return false;
+            plan.needsQuery = true;
+            plan.enforceIfOn = true;
+            break;
+
+        case EnforcementRequestType::SAFETY_NET:
+            // Only STABLE processes act on the result; others just record the check time
+            plan.needsQuery = (hot.phase == ProcessPhase::STABLE);
+            plan.enforceIfOn = plan.needsQuery;
+            break;
+
+        default:
+            return false;
+    }
+
+    // shared_ptr keeps processHandle open while the lock is released
+    plan.process = it.cold();
+    plan.hProcess = tp.processHandle.get();
+    plan.version = hot.stateVersion;
+    return true;
+}
+
+// Execute: kernel I/O without trackedCs_
+void EngineCore::ExecuteDispatch(const EnforcementRequest& req, DispatchPlan& plan) {
+    if (plan.needsQuery) {
+        plan.ecoQoSOn = IsEcoQoSEnabled(plan.hProcess);
+    }
+    if (plan.ecoQoSOn && plan.enforceIfOn) {
+        PulseEnforceV6(plan.hProcess, req.pid, true, plan.threadId);
+        plan.enforced = true;
+    }
+}
+
+// Commit: apply state transitions if nothing changed since Plan
+void EngineCore::CommitDispatch(const EnforcementRequest& req, ULONGLONG now,
+                                const DispatchPlan& plan, DispatchEffects& fx) {
+    CSLockGuard lock(trackedCs_);
+    auto it = trackedProcesses_.find(req.pid);
+    if (it == trackedProcesses_.end() || it.cold() != plan.process ||
+        it.hot().stateVersion != plan.version) {
+        // Removed, replaced (PID reuse) or re-phased while unlocked: the kernel
+        // side effect stands, the stale decision is dropped.
+        dispatchCommitConflicts_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    TrackedProcess& tp = *it.cold();
+    TrackedHot& hot = it.hot();
+    const bool ecoQoSOn = plan.ecoQoSOn;
+    const bool acceptedThreadEvents = AcceptsThreadEvents(hot.phase);
+
+    // Violation from STABLE (thread event / safety net): escalate or restart AGGRESSIVE
+    auto escalateFromStable = [&]() {
+        hot.violationCount++;
+        totalViolations_.fetch_add(1);
+        hot.lastViolationTime = now;
+        hot.phase = engine_logic::NextPhaseOnViolation(hot.violationCount, policy_);
+        if (hot.phase == ProcessPhase::PERSISTENT) {
+            fx.startPersistentTimer = true;
+        } else {
+            hot.phaseStartTime = now;
+            fx.verifyStep = 1;
+        }
+    };
+
+    if (plan.useCache && plan.needsQuery) {
+        hot.ecoQosCached = true;
+        hot.ecoQosCachedValue = ecoQoSOn;
+        hot.ecoQosCacheTime = now;
+    }
+
+    switch (req.type) {
+        case EnforcementRequestType::ETW_THREAD_START:
+            if (hot.phase == ProcessPhase::STABLE) {
                 if (ecoQoSOn) {
                     // Violation detected via event
-                    PulseEnforceV6(tp.processHandle.get(), req.pid, true);
-                    tp.ecoQosCached = false;  // Invalidate cache after enforcement
-                    tp.violationCount++;
-                    totalViolations_.fetch_add(1);
-                    tp.lastViolationTime = now;
-
-                    tp.phase = engine_logic::NextPhaseOnViolation(tp.violationCount, policy_);
-                    if (tp.phase == ProcessPhase::PERSISTENT) {
-                        StartPersistentTimer(req.pid);
-                        wchar_t logBuf[256];
-                        swprintf_s(logBuf, L"[PERSISTENT] %s (PID:%lu) via thread event (violations=%u)",
-                                   tp.name.c_str(), req.pid, tp.violationCount);
-                        LOG_DEBUG(logBuf);
+                    hot.ecoQosCached = false;  // Invalidate cache after enforcement
+                    escalateFromStable();
+                    if (hot.phase == ProcessPhase::PERSISTENT) {
+                        swprintf_s(fx.logBuf, L"[PERSISTENT] %ls (PID:%u) via thread event (violations=%u)",
+                                   tp.name.c_str(), req.pid, hot.violationCount);
                     } else {
-                        tp.phaseStartTime = now;
-                        ScheduleDeferredVerification(req.pid, 1);
-                        wchar_t logBuf[256];
-                        swprintf_s(logBuf, L"[VIOLATION] %s (PID:%lu) via thread event -> AGGRESSIVE",
+                        swprintf_s(fx.logBuf, L"[VIOLATION] %ls (PID:%u) via thread event -> AGGRESSIVE",
                                    tp.name.c_str(), req.pid);
-                        LOG_DEBUG(logBuf);
                     }
+                    fx.hasLog = true;
                 }
-                tp.lastCheckTime = now;
-                tp.lastEtwEnforceTime = now;
-            } else if (tp.phase == ProcessPhase::PERSISTENT) {
-                // ETW boost: rate-limited instant response for PERSISTENT phase
-                // Provides immediate EcoQoS correction on tab switch without waiting for 5s timer
-                if (now - tp.lastEtwEnforceTime >= ETW_BOOST_RATE_LIMIT) {
-                    bool ecoQoSOn = IsEcoQoSEnabledCached(tp, now);
-                    {
-                        wchar_t logBuf[256];
-                        swprintf_s(logBuf, L"[ETW_BOOST] %s (PID:%lu) EcoQoS=%s",
-                                   tp.name.c_str(), req.pid, ecoQoSOn ? L"ON->enforce" : L"OFF->skip");
-                        LOG_DEBUG(logBuf);
-                    }
-                    if (ecoQoSOn) {
-                        PulseEnforceV6(tp.processHandle.get(), req.pid, true);
-                        tp.ecoQosCached = false;  // Invalidate cache after enforcement
-                        tp.lastViolationTime = now;
-                    }
-                    tp.lastEtwEnforceTime = now;
-                    tp.lastCheckTime = now;
+            } else {
+                swprintf_s(fx.logBuf, L"[ETW_BOOST] %ls (PID:%u) EcoQoS=%ls",
+                           tp.name.c_str(), req.pid, ecoQoSOn ? L"ON->enforce" : L"OFF->skip");
+                fx.hasLog = true;
+                if (ecoQoSOn) {
+                    hot.ecoQosCached = false;  // Invalidate cache after enforcement
+                    hot.lastViolationTime = now;
                 }
             }
+            hot.lastCheckTime = now;
+            hot.lastEtwEnforceTime = now;
             break;
 
         case EnforcementRequestType::DEFERRED_VERIFICATION:
-            // Timer-based verification during AGGRESSIVE phase
-            if (tp.phase == ProcessPhase::AGGRESSIVE) {
-                // Clean up fired timer's context
-                delete tp.deferredTimerContext;
-                tp.deferredTimerContext = nullptr;
-                tp.deferredTimer = nullptr;
-
-                bool ecoQoSOn = IsEcoQoSEnabled(tp.processHandle.get());
-
-                if (!ecoQoSOn) {
-                    // Clean - check if this is final verification
-                    if (req.verifyStep >= 3) {
-                        // Final verification passed -> transition to STABLE
-                        tp.phase = ProcessPhase::STABLE;
-                        tp.phaseStartTime = now;
-                        CancelProcessTimers(tp, timersToDelete, ctxToDelete);
-                        wchar_t logBuf[256];
-                        swprintf_s(logBuf, L"[PHASE] %s (PID:%lu) -> STABLE", tp.name.c_str(), req.pid);
-                        LOG_DEBUG(logBuf);
-                    } else {
-                        // Schedule next verification
-                        ScheduleDeferredVerification(req.pid, req.verifyStep + 1);
-                    }
+            if (!ecoQoSOn) {
+                // Clean - check if this is final verification
+                if (req.verifyStep >= 3) {
+                    // Final verification passed -> transition to STABLE
+                    hot.phase = ProcessPhase::STABLE;
+                    hot.phaseStartTime = now;
+                    CancelProcessTimers(tp, fx.timersToDelete, fx.ctxToDelete);
+                    swprintf_s(fx.logBuf, L"[PHASE] %ls (PID:%u) -> STABLE", tp.name.c_str(), req.pid);
+                    fx.hasLog = true;
                 } else {
-                    // Violation detected
-                    tp.violationCount++;
-                    totalViolations_.fetch_add(1);
-                    PulseEnforceV6(tp.processHandle.get(), req.pid, true);
-
-                    tp.phase = engine_logic::NextPhaseOnViolation(tp.violationCount, policy_);
-                    if (tp.phase == ProcessPhase::PERSISTENT) {
-                        CancelProcessTimers(tp, timersToDelete, ctxToDelete);
-                        StartPersistentTimer(req.pid);
-                        wchar_t logBuf[256];
-                        swprintf_s(logBuf, L"[PERSISTENT] %s (PID:%lu) violations=%u",
-                                   tp.name.c_str(), req.pid, tp.violationCount);
-                        LOG_DEBUG(logBuf);
-                    } else {
-                        // Restart AGGRESSIVE with fresh verification sequence
-                        tp.phaseStartTime = now;
-                        CancelProcessTimers(tp, timersToDelete, ctxToDelete);
-                        ScheduleDeferredVerification(req.pid, 1);
-                    }
+                    // Schedule next verification
+                    fx.verifyStep = static_cast<uint8_t>(req.verifyStep + 1);
+                }
+            } else {
+                // Violation detected
+                hot.violationCount++;
+                totalViolations_.fetch_add(1);
+                hot.phase = engine_logic::NextPhaseOnViolation(hot.violationCount, policy_);
+                CancelProcessTimers(tp, fx.timersToDelete, fx.ctxToDelete);
+                if (hot.phase == ProcessPhase::PERSISTENT) {
+                    fx.startPersistentTimer = true;
+                    swprintf_s(fx.logBuf, L"[PERSISTENT] %ls (PID:%u) violations=%u",
+                               tp.name.c_str(), req.pid, hot.violationCount);
+                    fx.hasLog = true;
+                } else {
+                    // Restart AGGRESSIVE with fresh verification sequence
+                    hot.phaseStartTime = now;
+                    fx.verifyStep = 1;
                 }
-                tp.lastCheckTime = now;
             }
+            hot.lastCheckTime = now;
             break;
 
         case EnforcementRequestType::PERSISTENT_ENFORCE:
-            // Periodic enforcement for PERSISTENT phase (5s interval)
-            if (tp.phase == ProcessPhase::PERSISTENT) {
-                bool ecoQoSOn = IsEcoQoSEnabled(tp.processHandle.get());
-                if (ecoQoSOn) {
-                    // EcoQoS re-enabled -> enforce and mark violation
-                    PulseEnforceV6(tp.processHandle.get(), req.pid, true);
-                    tp.lastViolationTime = now;
-                    persistentEnforceApplied_.fetch_add(1);
-                } else {
-                    persistentEnforceSkipped_.fetch_add(1);
-                }
-                tp.lastCheckTime = now;
-
-                // Check if process has been clean long enough to exit PERSISTENT
-                // (60 seconds without violation)
-                if (!ecoQoSOn) {
-                    ULONGLONG timeSinceLastViolation = (tp.lastViolationTime > 0) ?
-                        (now - tp.lastViolationTime) : (now - tp.phaseStartTime);
-                    if (engine_logic::ShouldExitPersistent(
-                            static_cast<uint64_t>(timeSinceLastViolation),
-                            static_cast<uint64_t>(PERSISTENT_CLEAN_THRESHOLD))) {
-                        tp.phase = ProcessPhase::STABLE;
-                        tp.phaseStartTime = now;
-                        CancelProcessTimers(tp, timersToDelete, ctxToDelete);
-                        wchar_t logBuf[256];
-                        swprintf_s(logBuf, L"[PHASE] %s (PID:%lu) PERSISTENT -> STABLE (clean 60s)",
-                                   tp.name.c_str(), req.pid);
-                        LOG_DEBUG(logBuf);
-                    }
+            if (ecoQoSOn) {
+                // EcoQoS re-enabled -> enforced, mark violation
+                hot.lastViolationTime = now;
+                persistentEnforceApplied_.fetch_add(1);
+            } else {
+                persistentEnforceSkipped_.fetch_add(1);
+            }
+            hot.lastCheckTime = now;
+
+            // Check if process has been clean long enough to exit PERSISTENT
+            // (60 seconds without violation)
+            if (!ecoQoSOn) {
+                ULONGLONG timeSinceLastViolation = (hot.lastViolationTime > 0) ?
+                    (now - hot.lastViolationTime) : (now - hot.phaseStartTime);
+                if (engine_logic::ShouldExitPersistent(
+                        static_cast<uint64_t>(timeSinceLastViolation),
+                        static_cast<uint64_t>(PERSISTENT_CLEAN_THRESHOLD))) {
+                    hot.phase = ProcessPhase::STABLE;
+                    hot.phaseStartTime = now;
+                    CancelProcessTimers(tp, fx.timersToDelete, fx.ctxToDelete);
+                    swprintf_s(fx.logBuf, L"[PHASE] %ls (PID:%u) PERSISTENT -> STABLE (clean 60s)",
+                               tp.name.c_str(), req.pid);
+                    fx.hasLog = true;
                 }
             }
             break;
 
         case EnforcementRequestType::SAFETY_NET:
             // SAFETY NET: Insurance consistency check for this specific process
-            if (tp.processHandle.get()) {
-                bool ecoQoSOn = IsEcoQoSEnabled(tp.processHandle.get());
-                if (ecoQoSOn && tp.phase == ProcessPhase::STABLE) {
-                    // Violation detected via safety net
-                    PulseEnforceV6(tp.processHandle.get(), req.pid, true);
-                    tp.violationCount++;
-                    totalViolations_.fetch_add(1);
-                    tp.lastViolationTime = now;
-
-                    tp.phase = engine_logic::NextPhaseOnViolation(tp.violationCount, policy_);
-                    if (tp.phase == ProcessPhase::PERSISTENT) {
-                        StartPersistentTimer(req.pid);
-                    } else {
-                        tp.phaseStartTime = now;
-                        ScheduleDeferredVerification(req.pid, 1);
-                    }
-                    wchar_t logBuf[256];
-                    swprintf_s(logBuf, L"[SAFETY_NET] %s (PID:%lu) violation detected",
-                               tp.name.c_str(), req.pid);
-                    LOG_DEBUG(logBuf);
-                }
-                tp.lastCheckTime = now;
+            if (ecoQoSOn && hot.phase == ProcessPhase::STABLE) {
+                // Violation detected via safety net
+                escalateFromStable();
+                swprintf_s(fx.logBuf, L"[SAFETY_NET] %ls (PID:%u) violation detected",
+                           tp.name.c_str(), req.pid);
+                fx.hasLog = true;
             }
+            hot.lastCheckTime = now;
             break;
 
         default:
             break;
     }
-    }  // end CSLockGuard scope
 
+    hot.stateVersion++;
+    if (AcceptsThreadEvents(hot.phase) != acceptedThreadEvents) {
+        threadEventTargetsDirty_.store(true, std::memory_order_relaxed);
+    }
+}
+
+// Effects: timer churn and logging after trackedCs_ is released
+void EngineCore::ApplyDispatchEffects(DWORD pid, DispatchEffects& fx) {
     // Delete accumulated timers outside lock: INVALID_HANDLE_VALUE blocks until
     // any in-flight callback completes, then we free the context.
-    for (size_t i = 0; i < timersToDelete.size(); ++i) {
-        if (!DeleteTimerQueueTimer(timerQueue_, timersToDelete[i], INVALID_HANDLE_VALUE)) {
-            DWORD err = GetLastError();
+    for (size_t i = 0; i < fx.timersToDelete.size(); ++i) {
+        if (!os_.timers.DeleteTimer(timerQueue_, fx.timersToDelete[i], true)) {
+            DWORD err = os_.timers.LastError();
             if (err != ERROR_IO_PENDING) { shutdownWarnings_.fetch_add(1); }
         }
-        delete ctxToDelete[i];
+        delete fx.ctxToDelete[i];
+    }
+
+    if (fx.startPersistentTimer) {
+        StartPersistentTimer(pid);
+    }
+    if (fx.verifyStep != 0) {
+        ScheduleDeferredVerification(pid, fx.verifyStep);
+    }
+    if (fx.hasLog) {
+        LOG_DEBUG(fx.logBuf);
     }
 }
 
 // Handle config file change notification
 void EngineCore::HandleConfigChange() {
-    // Confirm INI file specifically changed (notification is for any file in directory)
-    if (!UnLeafConfig::Instance().HasFileChanged()) {
-        return;  // False positive - not our file
+    // §9.34: touch / no-op save / our own Save() (IPC target edit): same bytes, no reload
+    if (!UnLeafConfig::Instance().HasContentChanged()) {
+        configReloadSkipped_.fetch_add(1, std::memory_order_relaxed);
+        LOG_DEBUG(L"[CONFIG] Change notification ignored (content unchanged)");
+        return;
     }
+    // Only real edits count as config wakeups (debounced bursts / no-op saves do not)
+    wakeupConfigChange_.fetch_add(1);
 
     LOG_INFO(L"Config: Reloading (event-driven notification)");
 
@@ -1105,8 +1262,9 @@ void EngineCore::HandleConfigChange() {
     ApplyProactivePolicies();
 
     wchar_t cfgBuf[96];
+    std::shared_ptr<const TargetTables> reloaded = SnapshotTargets();
     swprintf_s(cfgBuf, L"[CONFIG] Reloaded: %zu name + %zu path targets",
-               targetNameSet_.size(), targetPathSet_.size());
+               reloaded->names.size(), reloaded->paths.size());
     LOG_DEBUG(cfgBuf);
 
     // Remove tracked processes that are no longer targets
@@ -1134,8 +1292,9 @@ void EngineCore::HandleSafetyNetCheck() {
     std::pmr::vector<DWORD> pidsToCheck(&arena);
     {
         CSLockGuard lock(trackedCs_);
-        for (const auto& [pid, tp] : trackedProcesses_) {
-            if (tp->processHandle.get() && tp->phase == ProcessPhase::STABLE) {
+        // §9.24: filter on the hot array first; the cold handle is read only for STABLE entries
+        for (const auto& [pid, hot, tp] : trackedProcesses_) {
+            if (hot.phase == ProcessPhase::STABLE && tp->processHandle.get()) {
                 pidsToCheck.push_back(pid);
             }
         }
@@ -1144,16 +1303,16 @@ void EngineCore::HandleSafetyNetCheck() {
     // §9.14: Policy recovery — retry path resolution for tracked processes with empty fullPath
     struct PolicyRetryInfo {
         DWORD pid;
-        HANDLE hProcess;     // borrowed (owned by TrackedProcess::processHandle)
+        platform::NativeHandle hProcess;     // borrowed (owned by TrackedProcess::processHandle)
         std::wstring name;
     };
     std::pmr::vector<PolicyRetryInfo> policyRetries(&arena);
 
     {
         CSLockGuard lock(trackedCs_);
-        for (const auto& [pid, tp] : trackedProcesses_) {
-            if (tp->needsPolicyRetry && tp->processHandle.get()) {
-                policyRetries.push_back({pid, tp->processHandle.get(), tp->name});
+        for (const auto& [pid, hot, tp] : trackedProcesses_) {
+            if (hot.needsPolicyRetry && tp->processHandle.get()) {
+                policyRetries.push_back({pid, tp->processHandle.get(), tp->name.str()});
             }
         }
     }
@@ -1167,9 +1326,9 @@ void EngineCore::HandleSafetyNetCheck() {
         }
         if (resolved.empty()) continue;  // retry on next SafetyNet cycle (10s)
 
-        if (!RegistryPolicyManager::Instance().HasPolicy(resolved)) {
+        if (!os_.policy.HasPolicy(resolved)) {
             std::wstring lowerName = ToLower(info.name);
-            RegistryPolicyManager::Instance().ApplyPolicy(lowerName, resolved);
+            os_.policy.ApplyPolicy(lowerName, resolved);
             LOG_INFO(L"[REGISTRY] SafetyNet policy recovery: " + lowerName + L" path=" + resolved);
         }
 
@@ -1177,8 +1336,8 @@ void EngineCore::HandleSafetyNetCheck() {
             CSLockGuard lock(trackedCs_);
             auto it = trackedProcesses_.find(info.pid);
             if (it != trackedProcesses_.end()) {
-                it->second->fullPath = resolved;
-                it->second->needsPolicyRetry = false;
+                it.cold()->fullPath = resolved;
+                it.hot().needsPolicyRetry = false;
             }
         }
     }
@@ -1209,12 +1368,12 @@ void EngineCore::HandleSafetyNetCheck() {
 
     // §9.14-B: PendingRemoval overflow → immediate VerifyAndRepair
     // overflow flag は EnqueuePendingRemoval がセット → SafetyNet 10秒以内に即発火
-    if (RegistryPolicyManager::Instance().ConsumePendingOverflowFlag()) {
+    if (os_.policy.ConsumePendingOverflowFlag()) {
         if (verifyRunning_.exchange(1, std::memory_order_acquire) == 0) {
-            ULONGLONG now = GetTickCount64();
+            ULONGLONG now = os_.clock.NowMs();
             lastPolicyVerifyTime_ = now;
             LOG_INFO(L"[SAFETY] PendingRemoval overflow — VerifyAndRepair immediate");
-            RegistryPolicyManager::Instance().VerifyAndRepair();
+            os_.policy.VerifyAndRepair();
             verifyRunning_.store(0, std::memory_order_release);
         }
     }
@@ -1222,11 +1381,11 @@ void EngineCore::HandleSafetyNetCheck() {
     // Registry policy integrity verification (30min periodic)
     {
         constexpr ULONGLONG POLICY_VERIFY_INTERVAL_MS = 30ULL * 60 * 1000;
-        ULONGLONG now = GetTickCount64();
+        ULONGLONG now = os_.clock.NowMs();
         if (now - lastPolicyVerifyTime_ >= POLICY_VERIFY_INTERVAL_MS) {
             if (verifyRunning_.exchange(1, std::memory_order_acquire) == 0) {
                 lastPolicyVerifyTime_ = now;
-                RegistryPolicyManager::Instance().VerifyAndRepair();
+                os_.policy.VerifyAndRepair();
                 verifyRunning_.store(0, std::memory_order_release);
             }
         }
@@ -1236,7 +1395,7 @@ void EngineCore::HandleSafetyNetCheck() {
     // トリガ1: CRITICAL ドロップ差分検出
     // トリガ2: 30 秒バックストップ（ETW silent drop 対策）
     {
-        ULONGLONG now = GetTickCount64();
+        ULONGLONG now = os_.clock.NowMs();
         const uint32_t currentDrops = criticalDropCount_.load(std::memory_order_relaxed);
         const bool hasCriticalDrop = (currentDrops != lastCheckedDropCount_);
 
@@ -1257,24 +1416,52 @@ void EngineCore::HandleSafetyNetCheck() {
 // §9.14-E: SafetyNet 2-pass round-robin scan for missed target processes.
 // Triggered by CRITICAL drop detection or 30s backstop. Budget = scan count (not apply count).
 // lastScannedPid_ is monotonically increasing (std::max) to prevent permanent starvation.
+// §9.40: tracked processes and processes already classified as non-targets (same PID, creation
+// time and image under the current target generation) are skipped without consuming budget —
+// steady-state passes only examine processes that are new since the previous one.
 void EngineCore::ScanRunningProcessesForMissedTargets(int maxScan) {
-    HANDLE snap = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-    if (snap == INVALID_HANDLE_VALUE) return;
-    ScopedSnapshot scoped = MakeScopedSnapshot(snap);
-
-    PROCESSENTRY32W pe = {};
-    pe.dwSize = sizeof(pe);
-    if (!Process32FirstW(snap, &pe)) return;
+    ULONGLONG capturedAt = 0;
+    const engine_logic::SystemSnapshot* tick = AcquireTickSnapshot(&capturedAt);
+    if (!tick || tick->Empty()) return;
+    const engine_logic::SystemSnapshot& snapshot = *tick;
+    // §9.37: the full snapshot also repairs the process tree (exits Windows never reports)
+    processTreeRepairs_.fetch_add(static_cast<uint32_t>(ReconcileProcessTree(snapshot, capturedAt)),
+                                  std::memory_order_relaxed);
+
+    // One target-table reference for the whole pass (no targetCs_ per PID)
+    const std::shared_ptr<const TargetTables> targets = SnapshotTargets();
+    nonTargetCache_.SetGeneration(targets->generation);
+    uint32_t cacheHits = 0;
+
+    // false = tracked / cached non-target (no budget consumed)
+    auto examine = [&](const engine_logic::SystemSnapshot::Process& pe) -> bool {
+        // Tracked PIDs: lock-free bitmap probe. ApplyOptimization re-checks under trackedCs_
+        if (pe.pid < engine_logic::PidBitmap::PID_SPACE && trackedPidFilter_.Test(pe.pid)) return false;
+        const std::wstring_view name = snapshot.Name(pe);
+        const uint64_t nameHash = std::hash<std::wstring_view>{}(name);
+        if (nonTargetCache_.Contains(pe.pid, pe.createTime, nameHash)) {
+            ++cacheHits;
+            return false;
+        }
+        if (!IsMissedTargetCandidate(*targets, name)) {
+            nonTargetCache_.Insert(pe.pid, pe.createTime, nameHash);
+            return true;
+        }
+        if (TryApplyIfMissedTarget(pe.pid, name.data()))
+            safetyRecoveredCount_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    };
 
     int scanned = 0;
+    size_t idx = 0;
     // lastScannedPid_ = 0 の場合は先頭からスキャン（初回 or pass2 折り返し後）
     // PID wrap（UINT32_MAX 到達）は実用上発生しないが、仮に起きても
     // 全エントリが <= lastScannedPid_ となり passedOffset 未到達 → pass2 発火で全件カバーされる
     bool passedOffset = (lastScannedPid_ == 0);
 
     // パス1: lastScannedPid_ 以降のエントリを処理
-    do {
-        DWORD pid = pe.th32ProcessID;
+    for (; idx < snapshot.Size() && scanned < maxScan; ++idx) {
+        const DWORD pid = snapshot[idx].pid;
         if (!passedOffset) {
             if (pid > lastScannedPid_) passedOffset = true;
             else continue;
@@ -1282,106 +1469,83 @@ void EngineCore::ScanRunningProcessesForMissedTargets(int maxScan) {
         // std::max で単調増加を保証。snapshot が降順（高 PID 優先）の場合、
         // lastScannedPid_ = pid だと後退してループが永続するバグを防ぐ
         lastScannedPid_ = std::max(lastScannedPid_, pid);
-        bool alreadyTracked;
-        { CSLockGuard lk(trackedCs_); alreadyTracked = trackedProcesses_.count(pid) > 0; }
-        if (!alreadyTracked && TryApplyIfMissedTarget(pid, pe.szExeFile))
-            safetyRecoveredCount_.fetch_add(1, std::memory_order_relaxed);
-        scanned++;  // budget はスキャン数で消費（追跡済みを含む全エントリ）
-    } while (scanned < maxScan && Process32NextW(snap, &pe));
+        if (examine(snapshot[idx])) scanned++;  // budget はスキャン数で消費（追跡済み・キャッシュ済み非ターゲットを除く）
+    }
 
     // パス2: パス1で offset 未到達 かつ budget 残あり → 先頭から折り返し
     if (!passedOffset && scanned < maxScan) {
         lastScannedPid_ = 0;
-        pe.dwSize = sizeof(pe);
-        if (Process32FirstW(snap, &pe)) {
-            do {
-                DWORD pid = pe.th32ProcessID;
-                lastScannedPid_ = pid;
-                bool alreadyTracked;
-                { CSLockGuard lk(trackedCs_); alreadyTracked = trackedProcesses_.count(pid) > 0; }
-                if (!alreadyTracked && TryApplyIfMissedTarget(pid, pe.szExeFile))
-                    safetyRecoveredCount_.fetch_add(1, std::memory_order_relaxed);
-                scanned++;
-            } while (scanned < maxScan && Process32NextW(snap, &pe));
+        for (idx = 0; idx < snapshot.Size() && scanned < maxScan; ++idx) {
+            const DWORD pid = snapshot[idx].pid;
+            lastScannedPid_ = pid;
+            if (examine(snapshot[idx])) scanned++;
         }
     }
 
     // §9.18 #1: 全走査完了時は lastScannedPid_=0 にリセット
-    // scanned < maxScan で抜けた = Process32NextW(snap,&pe) が false を返した
+    // scanned < maxScan で抜けた = snapshot 末尾まで走査した
     // = snapshot 末尾に到達 = 次 tick は先頭から再開すべき。
     // 既存の単調増加 round-robin (lastScannedPid_ = std::max(...)) では、
     // 高 PID の短命プロセスが現れると低 PID の chrome が永続的に scan 対象外となるため、
     // 全走査完了を契機に強制リセットする。
     if (scanned < maxScan) {
         lastScannedPid_ = 0;
+        // §9.40: exited processes leave the cache once a pass has covered the whole snapshot
+        nonTargetCache_.Prune([&](uint32_t pid) { return snapshot.Find(pid) != nullptr; });
     }
+    nonTargetCacheHits_.fetch_add(cacheHits, std::memory_order_relaxed);
+    nonTargetCacheEntries_.store(static_cast<uint32_t>(nonTargetCache_.Size()), std::memory_order_relaxed);
 }
 
-// §9.18 #4: Lightweight Toolhelp32 probe for ETW stall detection.
-// Returns true if any running process matches targetNameSet_ or pathTargetFileNames_.
+// §9.18 #4: Lightweight snapshot probe for ETW stall detection.
+// Returns true if any running process matches the name or path-file-name target tables.
 // No descendant collection, no policy work, no handle opening. Bails out at first hit.
-bool EngineCore::HasAnyTargetRunning() const {
-    // Fast path: 追跡済みプロセスが存在すれば即 true（Toolhelp32 スキャン不要）
+// §9.38: reads the tick snapshot (shared with the SafetyNet scan / rescan of the same tick).
+bool EngineCore::HasAnyTargetRunning() {
+    // Fast path: 追跡済みプロセスが存在すれば即 true（スナップショット不要）
     {
         CSLockGuard lock(trackedCs_);
         if (!trackedProcesses_.empty()) return true;
     }
 
-    std::set<std::wstring> localNames;
-    std::set<std::wstring> localPathFileNames;
-    {
-        CSLockGuard lock(targetCs_);
-        if (targetNameSet_.empty() && pathTargetFileNames_.empty()) {
-            return false;
-        }
-        localNames         = targetNameSet_;
-        localPathFileNames = pathTargetFileNames_;
+    std::shared_ptr<const TargetTables> targets = SnapshotTargets();
+    if (targets->names.empty() && targets->pathFileNames.empty()) {
+        return false;
     }
 
-    HANDLE snap = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-    if (snap == INVALID_HANDLE_VALUE) return false;
-    ScopedSnapshot scoped = MakeScopedSnapshot(snap);
-
-    PROCESSENTRY32W pe = {};
-    pe.dwSize = sizeof(pe);
-    if (!Process32FirstW(snap, &pe)) return false;
+    const engine_logic::SystemSnapshot* snapshot = AcquireTickSnapshot();
+    if (!snapshot) return false;
 
-    do {
-        if (IsCriticalProcess(pe.szExeFile)) continue;
-        std::wstring lowerName = ToLower(pe.szExeFile);
-        if (localNames.count(lowerName) > 0 ||
-            localPathFileNames.count(lowerName) > 0) {
+    for (const auto& pe : *snapshot) {
+        const std::wstring_view name = snapshot->Name(pe);
+        if (IsCriticalImage(name)) continue;
+        if (targets->names.Contains(name) ||
+            targets->pathFileNames.Contains(name)) {
             return true;
         }
-    } while (Process32NextW(snap, &pe));
+    }
 
     return false;
 }
 
-// §9.14-E: Check if a process is a missed target; apply optimization if so.
+// §9.40: Name-only classification (critical image / name target / path-target file name).
+// Depends on nothing but the name and the tables, so a false result is cacheable.
+bool EngineCore::IsMissedTargetCandidate(const TargetTables& targets, std::wstring_view exeName) {
+    if (exeName.empty() || IsCriticalImage(exeName)) return false;
+    return targets.names.Contains(exeName) ||
+           (!targets.paths.empty() && targets.pathFileNames.Contains(exeName));
+}
+
+// §9.14-E: Apply optimization to a missed target candidate (IsMissedTargetCandidate).
 bool EngineCore::TryApplyIfMissedTarget(DWORD pid, const wchar_t* exeName) {
     if (!exeName || !*exeName) return false;
-    if (IsCriticalProcess(exeName)) return false;
-
-    std::wstring lowerName = ToLower(exeName);
-    bool isNameTarget   = false;
-    bool maybePathTarget = false;
-    {
-        CSLockGuard lock(targetCs_);
-        isNameTarget    = (targetNameSet_.count(lowerName) > 0);
-        maybePathTarget = hasPathTargets_.load(std::memory_order_relaxed) &&
-                          (pathTargetFileNames_.count(lowerName) > 0);
-    }
-
-    if (!isNameTarget && !maybePathTarget) return false;
-
     // Delegate to existing ApplyOptimization — handles IsTracked check + path resolution
     return ApplyOptimization(pid, exeName, false, 0);
 }
 
 // Drain pending process removal queue (called from EngineControlLoop thread only)
 void EngineCore::ProcessPendingRemovals() {
-#ifdef _DEBUG
+#if defined(_DEBUG) && defined(_WIN32)
     {
         DWORD tid = engineControlThreadId_.load(std::memory_order_relaxed);
         assert(tid != 0 &&
@@ -1423,7 +1587,7 @@ void EngineCore::ProcessPendingRemovals() {
     // Signal OUTSIDE lock — minimizes lock hold time for push-side contention.
     // This guarantees: while items remain, the next drain is always scheduled.
     if (hasRemaining) {
-        SetEvent(hWakeupEvent_);
+        os_.events.SetEvent(hWakeupEvent_);
     }
 
     while (!pending.empty()) {
@@ -1436,46 +1600,61 @@ void EngineCore::ProcessPendingRemovals() {
 // §9.14-C: std::exchange pattern ensures old timer/context are cancelled outside lock.
 // Previous implementation overwrote deferredTimer/deferredTimerContext without cancellation,
 // leaking the old handle and context when the same PID was re-scheduled.
+// §9.21: CreateTimer も trackedCs_ の外で行い、ロック内ではハンドルの差し替えのみ。
 void EngineCore::ScheduleDeferredVerification(DWORD pid, uint8_t step) {
     if (!timerQueue_) return;
 
     DWORD delayMs = static_cast<DWORD>(engine_logic::DeferredVerifyDelayMs(step, policy_));
     if (delayMs == 0) return;
 
-    HANDLE oldTimer = nullptr;
-    DeferredVerifyContext* oldCtx = nullptr;
-
+    std::shared_ptr<TrackedProcess> process;
     {
         CSLockGuard lock(trackedCs_);
         auto it = trackedProcesses_.find(pid);
         if (it == trackedProcesses_.end()) return;
+        process = it.cold();
+    }
 
-        // Exchange: atomically swap out old timer/context, insert new ones
-        // Old handles are deleted outside the lock (DeleteTimerQueueTimer may block)
-        oldTimer = std::exchange(it->second->deferredTimer, nullptr);
-        oldCtx   = std::exchange(it->second->deferredTimerContext, nullptr);
-
-        auto* context = new DeferredVerifyContext{this, pid, step, it->second};
-        HANDLE timer = nullptr;
-        if (CreateTimerQueueTimer(&timer, timerQueue_, DeferredVerifyTimerCallback,
-                                  context, delayMs, 0, WT_EXECUTEONLYONCE)) {
-            it->second->deferredTimer        = timer;
-            it->second->deferredTimerContext = context;
-        } else {
-            delete context;
+    auto* context = new DeferredVerifyContext{this, pid, step, process};
+    platform::NativeHandle timer = nullptr;
+    if (!os_.timers.CreateTimer(&timer, timerQueue_, DeferredVerifyTimerCallback,
+                                context, delayMs, 0)) {
+        delete context;
+        return;
+    }
+
+    platform::NativeHandle oldTimer = nullptr;
+    DeferredVerifyContext* oldCtx = nullptr;
+    bool installed = false;
+
+    {
+        CSLockGuard lock(trackedCs_);
+        auto it = trackedProcesses_.find(pid);
+        if (it != trackedProcesses_.end() && it.cold() == process) {
+            // Exchange: atomically swap out old timer/context, insert new ones
+            // Old handles are deleted outside the lock (DeleteTimerQueueTimer may block)
+            oldTimer = std::exchange(it.cold()->deferredTimer, timer);
+            oldCtx   = std::exchange(it.cold()->deferredTimerContext, context);
+            installed = true;
         }
     }
 
+    // Process removed while the timer was being created: discard the new timer
+    if (!installed) {
+        oldTimer = timer;
+        oldCtx   = context;
+    }
+
     // Cancel old timer outside lock — INVALID_HANDLE_VALUE waits for in-flight callbacks
     // DeferredVerifyTimerCallback only calls EnqueueRequest (lock-free), so μs completion
-    if (oldTimer) DeleteTimerQueueTimer(timerQueue_, oldTimer, INVALID_HANDLE_VALUE);
+    if (oldTimer) os_.timers.DeleteTimer(timerQueue_, oldTimer, true);
     if (oldCtx)   delete oldCtx;
 }
 
 // Cancel all timers for a process
 // Extracts handles into caller-supplied vectors; caller deletes outside any lock.
 void EngineCore::CancelProcessTimers(TrackedProcess& tp,
-                                     std::vector<HANDLE>& timersToDelete,
+                                     std::vector<platform::NativeHandle>& timersToDelete,
                                      std::vector<DeferredVerifyContext*>& ctxToDelete) {
     if (tp.deferredTimer && timerQueue_) {
         timersToDelete.push_back(tp.deferredTimer);
@@ -1492,48 +1671,53 @@ void EngineCore::CancelProcessTimers(TrackedProcess& tp,
 }
 
 // Start persistent enforcement timer (5s recurring)
+// §9.21: CreateTimer outside trackedCs_; the lock only swaps handles.
 void EngineCore::StartPersistentTimer(DWORD pid) {
     if (!timerQueue_) return;
 
-    HANDLE               oldTimerToDelete = nullptr;
-    DeferredVerifyContext* oldCtxToDelete = nullptr;
-
+    std::shared_ptr<TrackedProcess> process;
     {
         CSLockGuard lock(trackedCs_);
         auto it = trackedProcesses_.find(pid);
         if (it == trackedProcesses_.end()) {
             return;
         }
+        process = it.cold();
+    }
 
-        // Cancel existing persistent timer if any (extract handle; delete outside lock)
-        if (it->second->persistentTimer) {
-            oldTimerToDelete = it->second->persistentTimer;
-            oldCtxToDelete   = it->second->persistentTimerContext;
-            it->second->persistentTimer        = nullptr;
-            it->second->persistentTimerContext = nullptr;
-        }
+    auto* context = new DeferredVerifyContext{this, pid, 0, process};
+    platform::NativeHandle timer = nullptr;
+    if (!os_.timers.CreateTimer(
+            &timer,
+            timerQueue_,
+            PersistentEnforceTimerCallback,
+            context,
+            static_cast<DWORD>(PERSISTENT_ENFORCE_INTERVAL),    // Initial delay
+            static_cast<DWORD>(PERSISTENT_ENFORCE_INTERVAL))) { // Period (recurring)
+        delete context;
+        return;
+    }
 
-        auto* context = new DeferredVerifyContext{this, pid, 0, it->second};
+    platform::NativeHandle oldTimerToDelete = nullptr;
+    DeferredVerifyContext* oldCtxToDelete = nullptr;
 
-        HANDLE timer = nullptr;
-        if (CreateTimerQueueTimer(
-                &timer,
-                timerQueue_,
-                PersistentEnforceTimerCallback,
-                context,
-                static_cast<DWORD>(PERSISTENT_ENFORCE_INTERVAL),  // Initial delay
-                static_cast<DWORD>(PERSISTENT_ENFORCE_INTERVAL),  // Period (recurring)
-                WT_EXECUTEDEFAULT)) {
-            it->second->persistentTimer = timer;
-            it->second->persistentTimerContext = context;
+    {
+        CSLockGuard lock(trackedCs_);
+        auto it = trackedProcesses_.find(pid);
+        if (it != trackedProcesses_.end() && it.cold() == process) {
+            // Replace existing persistent timer if any (old handle deleted outside lock)
+            oldTimerToDelete = std::exchange(it.cold()->persistentTimer, timer);
+            oldCtxToDelete   = std::exchange(it.cold()->persistentTimerContext, context);
         } else {
-            delete context;
+            // Process removed while the timer was being created: discard the new timer
+            oldTimerToDelete = timer;
+            oldCtxToDelete   = context;
         }
     }
 
     // INVALID_HANDLE_VALUE: block until callback completes before freeing context
     if (oldTimerToDelete) {
-        DeleteTimerQueueTimer(timerQueue_, oldTimerToDelete, INVALID_HANDLE_VALUE);
+        os_.timers.DeleteTimer(timerQueue_, oldTimerToDelete, true);
         delete oldCtxToDelete;
     }
 }
@@ -1560,23 +1744,30 @@ void CALLBACK EngineCore::PersistentEnforceTimerCallback(PVOID lpParameter, BOOL
     // Note: Do NOT delete context for recurring timer - it's reused
 }
 
-// §9.18: ETW restart helper — Stop / Sleep(50ms) / Start / state update.
-// ★ etwState_ と operationMode_ は常に同時更新する。
-bool EngineCore::RestartETW() {
-    processMonitor_.Stop();
-    Sleep(50);  // ETW セッション teardown race 対策（30s ループ内で無視可能）
-
+// §9.32: 3 箇所 (Start / RestartETW / ヘルスチェック) 共通の Start。
+// 停止中に失われた exit は liveness check (waitHandle なしのエントリ) が拾う。
+bool EngineCore::StartProcessMonitor() {
     bool ok = processMonitor_.Start(
-        [this](DWORD pid, DWORD parentPid, const std::wstring& imageName,
-               const std::wstring& imagePath) {
-            this->OnProcessStart(pid, parentPid, imageName, imagePath);
+        [this](const engine_logic::ProcessStartBatch& batch) {
+            this->OnProcessStartBatch(batch);
         },
         [this](DWORD threadId, DWORD ownerPid) {
             this->OnThreadStart(threadId, ownerPid);
         }
     );
+    monitorExitEvents_.store(ok && monitorReportsExits_, std::memory_order_relaxed);
+    return ok;
+}
+
+// §9.18: ETW restart helper — Stop / Sleep(50ms) / Start / state update.
+// ★ etwState_ と operationMode_ は常に同時更新する。
+bool EngineCore::RestartETW() {
+    processMonitor_.Stop();
+    os_.clock.SleepMs(50);  // ETW セッション teardown race 対策（30s ループ内で無視可能）
 
-    lastEtwRestartTime_ = GetTickCount64();  // ★ unsigned 差分は wrap-safe
+    bool ok = StartProcessMonitor();
+
+    lastEtwRestartTime_ = os_.clock.NowMs();  // ★ unsigned 差分は wrap-safe
 
     if (ok) {
         // ★ Start() はカウンタをリセットするため、直後の GetEventCount() を
@@ -1604,15 +1795,7 @@ void EngineCore::PerformPeriodicMaintenance(ULONGLONG now) {
             LOG_ALERT(L"ETW: Session unhealthy - attempting restart");
             processMonitor_.Stop();
 
-            bool restarted = processMonitor_.Start(
-                [this](DWORD pid, DWORD parentPid, const std::wstring& imageName,
-                       const std::wstring& imagePath) {
-                    this->OnProcessStart(pid, parentPid, imageName, imagePath);
-                },
-                [this](DWORD threadId, DWORD ownerPid) {
-                    this->OnThreadStart(threadId, ownerPid);
-                }
-            );
+            bool restarted = StartProcessMonitor();
 
             if (restarted) {
                 LOG_INFO(L"ETW: Session restarted successfully");
@@ -1700,13 +1883,13 @@ void EngineCore::PerformPeriodicMaintenance(ULONGLONG now) {
         lastEtwEventCount_     = currentEvents;
     }
 
-    // §9.18 #2: 周期 InitialScan（NORMAL モードで 20 秒毎に発火）
-    // ETW silent drop / cold-dead 中の新規 Chrome プロセス取りこぼしを補正。
-    // EcoQoS 検知遅延上限を ETW 状態によらず 20s に抑制する。
+    // §9.18 #2 / §9.36: ロス駆動の再走査（NORMAL モードで 20 秒毎に証拠を確認）
+    // lost-event / CRITICAL drop・evict の差分、ETW 再起動があった時だけ、前回走査に無かった
+    // プロセスを対象に取りこぼしを補正する。健全な間はスナップショットを取らない。
     // DEGRADED_ETW モードは InitialScanForDegradedMode (20s 周期) があるため対象外。
     if (operationMode_ == OperationMode::NORMAL &&
         now - lastFullScanTime_ >= PERIODIC_FULL_SCAN_INTERVAL) {
-        InitialScan();
+        RescanOnEventLoss();
         lastFullScanTime_ = now;
     }
 
@@ -1738,16 +1921,16 @@ void EngineCore::PerformPeriodicMaintenance(ULONGLONG now) {
         std::vector<DWORD> zombiePids;
         {
             CSLockGuard lock(trackedCs_);
-            for (const auto& [pid, tp] : trackedProcesses_) {
+            for (const auto& [pid, hot, tp] : trackedProcesses_) {
                 // Only check entries without a wait handle (no exit notification registered)
                 if (tp->waitHandle != nullptr) continue;
 
                 // Check if process is still alive
-                HANDLE hProbe = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+                platform::NativeHandle hProbe = os_.process.OpenQuery(pid);
                 if (hProbe) {
                     DWORD exitCode = 0;
-                    bool exited = GetExitCodeProcess(hProbe, &exitCode) && exitCode != STILL_ACTIVE;
-                    CloseHandle(hProbe);
+                    bool exited = os_.process.QueryExitCode(hProbe, exitCode) && exitCode != STILL_ACTIVE;
+                    os_.process.CloseHandle(hProbe);
                     if (exited) {
                         zombiePids.push_back(pid);
                     }
@@ -1769,7 +1952,7 @@ void EngineCore::PerformPeriodicMaintenance(ULONGLONG now) {
                 }
             }
             if (wasEmpty) {
-                SetEvent(hWakeupEvent_);
+                os_.events.SetEvent(hWakeupEvent_);
             }
 
             wchar_t logBuf[128];
@@ -1810,8 +1993,8 @@ void EngineCore::PerformPeriodicMaintenance(ULONGLONG now) {
         size_t aggressiveCount = 0, stableCount = 0, persistentCount = 0;
         {
             CSLockGuard lock(trackedCs_);
-            for (const auto& [pid, tp] : trackedProcesses_) {
-                switch (tp->phase) {
+            for (const auto& [pid, hot, tp] : trackedProcesses_) {
+                switch (hot.phase) {
                     case ProcessPhase::AGGRESSIVE: aggressiveCount++; break;
                     case ProcessPhase::STABLE: stableCount++; break;
                     case ProcessPhase::PERSISTENT: persistentCount++; break;
@@ -1849,12 +2032,12 @@ void EngineCore::PerformPeriodicMaintenance(ULONGLONG now) {
                 wchar_t pBuf[512];
                 int pos = swprintf_s(pBuf, L"PERSISTENT: ");
                 bool first = true;
-                for (const auto& [p, t] : trackedProcesses_) {
-                    if (t->phase == ProcessPhase::PERSISTENT) {
+                for (const auto& [p, h, t] : trackedProcesses_) {
+                    if (h.phase == ProcessPhase::PERSISTENT) {
                         int remaining = 512 - pos;
                         if (remaining <= 0) break;
                         int written = swprintf_s(pBuf + pos, remaining,
-                                                 first ? L"%s(%lu)" : L", %s(%lu)",
+                                                 first ? L"%ls(%u)" : L", %ls(%u)",
                                                  t->name.c_str(), p);
                         if (written > 0) pos += written;
                         first = false;
@@ -1876,16 +2059,15 @@ void EngineCore::PerformPeriodicMaintenance(ULONGLONG now) {
             CSLockGuard lock(trackedCs_);
             trackedSz  = trackedProcesses_.size();
             watchMapSz = waitContexts_.size();
-            for (const auto& [pid, tp] : trackedProcesses_) {
+            for (const auto& [pid, hot, tp] : trackedProcesses_) {
                 if (tp->deferredTimerContext != nullptr) ++deferCtxCnt;
             }
             errSupSz = errorLogSuppression_.size();
         }
 
-        DWORD handleCount = 0;
-        if (!GetProcessHandleCount(GetCurrentProcess(), &handleCount)) {
-            handleCount = 0;
-        }
+        platform::SelfUsage self;
+        os_.snapshot.QuerySelfUsage(self);
+        DWORD handleCount = self.handleCount;
 
         uint64_t regCnt    = waitRegisterCount_.load(std::memory_order_relaxed);
         uint64_t unregCnt  = waitUnregisterCount_.load(std::memory_order_relaxed);
@@ -1917,10 +2099,11 @@ void EngineCore::PerformPeriodicMaintenance(ULONGLONG now) {
 
         wchar_t diagBuf[416];
         swprintf_s(diagBuf,
-            L"[DIAG] wait(reg:%llu unreg:%llu fail:%llu delta:%lld) "
+            L"[DIAG] wait(reg:%llu unreg:%llu fail:%llu delta:%lld monExit:%llu) "
             L"tracked=%zu watchMap=%zu deferCtx=%zu errSup=%zu handles=%u "
-            L"etwEvents=%u etwLost=%u etwAge=%s mode=%s",
+            L"etwEvents=%u etwLost=%u etwAge=%ls mode=%ls",
             regCnt, unregCnt, unregFail, waitDelta,
+            static_cast<unsigned long long>(monitorExitCount_.load(std::memory_order_relaxed)),
             trackedSz, watchMapSz, deferCtxCnt, errSupSz, handleCount,
             etwEvents, etwLostDelta, etwAgeBuf, modeStr);
         LOG_DEBUG(diagBuf);
@@ -1936,17 +2119,13 @@ void EngineCore::PerformPeriodicMaintenance(ULONGLONG now) {
         static ULONGLONG lastQueueDiagTime = 0;
         if (now - lastQueueDiagTime >= 60000) {
             lastQueueDiagTime = now;
-            size_t critSz = 0, nonCritSz = 0;
-            {
-                CSLockGuard lock(queueCs_);
-                critSz    = criticalQueue_.size();
-                nonCritSz = nonCriticalQueue_.size();
-            }
+            const size_t critSz    = requestQueue_.CriticalSize();
+            const size_t nonCritSz = requestQueue_.NonCriticalSize();
             wchar_t qBuf[320];
             swprintf_s(qBuf,
                 L"[DIAG] crit=%zu nc=%zu pending=%d drop=%u critDrop=%u critEvict=%u recovered=%u tracked=%zu",
                 critSz, nonCritSz,
-                RegistryPolicyManager::Instance().GetPendingQueueSize(),
+                os_.policy.GetPendingQueueSize(),
                 enforcementDropCount_.load(std::memory_order_relaxed),
                 criticalDropCount_.load(std::memory_order_relaxed),
                 criticalEvictCount_.load(std::memory_order_relaxed),
@@ -1962,13 +2141,8 @@ void EngineCore::PerformPeriodicMaintenance(ULONGLONG now) {
             ? MEM_LOG_INTERVAL_SHORT : MEM_LOG_INTERVAL_LONG;
 
         if (now - lastMemLogTime_ >= memInterval) {
-            PROCESS_MEMORY_COUNTERS_EX pmc = {};
-            pmc.cb = sizeof(pmc);
-            DWORD handleCount = 0;
-            bool pmcOk = GetProcessMemoryInfo(GetCurrentProcess(),
-                reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&pmc), sizeof(pmc)) != FALSE;
-            bool hcOk = GetProcessHandleCount(GetCurrentProcess(), &handleCount) != FALSE;
-            (void)pmcOk; (void)hcOk;
+            platform::SelfUsage self;
+            os_.snapshot.QuerySelfUsage(self);
 
             // コンテナサイズ（短時間ロック）
             size_t policySz = 0;
@@ -1985,11 +2159,11 @@ void EngineCore::PerformPeriodicMaintenance(ULONGLONG now) {
             wchar_t memBuf[256];
             swprintf_s(memBuf,
                 L"[MEM] pid=%u priv=%zu rss=%zu commit=%zu handles=%u policy=%zu errSup=%zu",
-                GetCurrentProcessId(),
-                pmc.PrivateUsage,
-                pmc.WorkingSetSize,
-                pmc.PagefileUsage,
-                handleCount,
+                self.pid,
+                self.privateBytes,
+                self.workingSetBytes,
+                self.pagefileBytes,
+                self.handleCount,
                 policySz,
                 errSupSz);
             LOG_DEBUG(memBuf);
@@ -2000,7 +2174,7 @@ void EngineCore::PerformPeriodicMaintenance(ULONGLONG now) {
 
 // === v6.0 Enhanced Pulse Enforcement with NtSetInformationProcess ===
 
-bool EngineCore::PulseEnforceV6(HANDLE hProcess, DWORD pid, bool isIntensive) {
+bool EngineCore::PulseEnforceV6(platform::NativeHandle hProcess, DWORD pid, bool isIntensive, DWORD threadId) {
     // Multi-layer defense strategy:
     // Layer 1: Registry policy (applied once per executable - handled in ApplyOptimization)
     // Layer 2: NtSetInformationProcess (low-level, more resistant to OS override) - Win11 only
@@ -2009,75 +2183,54 @@ bool EngineCore::PulseEnforceV6(HANDLE hProcess, DWORD pid, bool isIntensive) {
     // Layer 5: Thread-level throttling (INTENSIVE mode only)
 
     // Enforcement telemetry: start timing
-    LARGE_INTEGER qpcStart, qpcEnd, qpcFreq;
-    QueryPerformanceCounter(&qpcStart);
-    QueryPerformanceFrequency(&qpcFreq);
+    const ULONGLONG usStart = os_.clock.NowUs();
 
     // Step 1: Exit background mode (unconditional)
-    SetPriorityClass(hProcess, PROCESS_MODE_BACKGROUND_END);
-
-    bool ecoQoSSuccess = false;
+    os_.process.SetPriorityClass(hProcess, PROCESS_MODE_BACKGROUND_END);
 
     // Determine control mask based on Windows version
     // IGNORE_TIMER (0x4) is Windows 11 specific - causes errors on Windows 10
+    const bool fullEcoQoS = os_.process.SupportsFullEcoQoS();
     ULONG controlMask = UNLEAF_THROTTLE_EXECUTION_SPEED;
-    if (winVersion_.isWindows11OrLater) {
+    if (fullEcoQoS) {
         controlMask |= UNLEAF_THROTTLE_IGNORE_TIMER;
     }
 
-    // Step 2: Try NtSetInformationProcess first (Windows 11+ only)
-    if (winVersion_.isWindows11OrLater && ntApiAvailable_ && pfnNtSetInformationProcess_) {
-        UnleafThrottleState state;
-        state.Version = UNLEAF_THROTTLE_VERSION;
-        state.ControlMask = controlMask;
-        state.StateMask = 0;  // Force OFF
-
-        NTSTATUS status = pfnNtSetInformationProcess_(
-            hProcess,
-            NT_PROCESS_POWER_THROTTLING_STATE,
-            &state,
-            sizeof(state)
-        );
-
-        if (status == STATUS_SUCCESS) {
-            ntApiSuccessCount_.fetch_add(1, std::memory_order_relaxed);
-            ecoQoSSuccess = true;
-        } else {
+    // Step 2+3: NtSetInformationProcess first (Windows 11+ only),
+    //           SetProcessInformation as primary path for Win10 / fallback for Win11
+    platform::EcoQoSResult eco = os_.process.SetEcoQoSOff(hProcess, controlMask, fullEcoQoS);
+    if (eco.usedNtApi) {
+        if (eco.ntFallback) {
             ntApiFailCount_.fetch_add(1, std::memory_order_relaxed);
-            // Fall through to SetProcessInformation
+        } else {
+            ntApiSuccessCount_.fetch_add(1, std::memory_order_relaxed);
         }
     }
-
-    // Step 3: SetProcessInformation (primary path for Win10, fallback for Win11)
-    if (!ecoQoSSuccess) {
-        UnleafThrottleState state;
-        state.Version = UNLEAF_THROTTLE_VERSION;
-        state.ControlMask = controlMask;
-        state.StateMask = 0;  // Force OFF
-
-        BOOL result = SetProcessInformation(hProcess,
-            static_cast<PROCESS_INFORMATION_CLASS>(UNLEAF_PROCESS_POWER_THROTTLING),
-            &state, sizeof(state));
-
-        ecoQoSSuccess = (result != FALSE);
-    }
+    const bool ecoQoSSuccess = eco.success;
 
     // Step 4: Set HIGH priority (unconditional - critical for OS resistance)
     // Even if EcoQoS control failed, priority helps prevent OS auto-EcoQoS
-    SetPriorityClass(hProcess, UNLEAF_TARGET_PRIORITY);
+    os_.process.SetPriorityClass(hProcess, UNLEAF_TARGET_PRIORITY);
 
     // Step 5: Thread throttling (INTENSIVE phase only)
+    // §9.39: a thread event names the one thread that needs it — O(1) instead of a
+    // walk over every thread of the process. Phase-driven enforcement keeps the sweep.
+    // A thread that is gone or not owned by pid (0 touched) falls back to the sweep.
     if (isIntensive) {
-        DisableThreadThrottling(pid, true);
+        const uint32_t tid = threadId;
+        if (threadId != 0 && os_.process.DisableThreadThrottling(pid, &tid, 1, true) > 0) {
+            etwThreadScoped_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            DisableThreadThrottling(pid, true);
+        }
     }
 
     // Error handling
     if (!ecoQoSSuccess) {
-        HandleEnforceError(hProcess, pid, GetLastError());
+        HandleEnforceError(hProcess, pid, eco.error);
 
         // Enforcement telemetry: record latency and failure
-        QueryPerformanceCounter(&qpcEnd);
-        uint64_t elapsedUs = ((qpcEnd.QuadPart - qpcStart.QuadPart) * 1000000ULL) / qpcFreq.QuadPart;
+        uint64_t elapsedUs = os_.clock.NowUs() - usStart;
         enforceLatencySumUs_.fetch_add(elapsedUs, std::memory_order_relaxed);
         enforceCount_.fetch_add(1, std::memory_order_relaxed);
         uint32_t elapsed32 = static_cast<uint32_t>((std::min)(elapsedUs, static_cast<uint64_t>(UINT32_MAX)));
@@ -2090,8 +2243,7 @@ bool EngineCore::PulseEnforceV6(HANDLE hProcess, DWORD pid, bool isIntensive) {
     }
 
     // Enforcement telemetry: record latency and success
-    QueryPerformanceCounter(&qpcEnd);
-    uint64_t elapsedUs = ((qpcEnd.QuadPart - qpcStart.QuadPart) * 1000000ULL) / qpcFreq.QuadPart;
+    uint64_t elapsedUs = os_.clock.NowUs() - usStart;
     enforceLatencySumUs_.fetch_add(elapsedUs, std::memory_order_relaxed);
     enforceCount_.fetch_add(1, std::memory_order_relaxed);
     uint32_t elapsed32 = static_cast<uint32_t>((std::min)(elapsedUs, static_cast<uint64_t>(UINT32_MAX)));
@@ -2112,52 +2264,10 @@ bool EngineCore::PulseEnforceV6(HANDLE hProcess, DWORD pid, bool isIntensive) {
 
 // === v7.0 EcoQoS State Check ===
 
-bool EngineCore::IsEcoQoSEnabled(HANDLE hProcess) const {
-    UnleafThrottleState state = {};
-    state.Version = UNLEAF_THROTTLE_VERSION;
-
-    // Try NtQueryInformationProcess first (if available)
-    if (ntApiAvailable_ && pfnNtQueryInformationProcess_) {
-        ULONG returnLength = 0;
-        NTSTATUS status = pfnNtQueryInformationProcess_(
-            hProcess,
-            NT_PROCESS_POWER_THROTTLING_STATE,
-            &state,
-            sizeof(state),
-            &returnLength
-        );
-        if (status == STATUS_SUCCESS) {
-            return (state.StateMask & UNLEAF_THROTTLE_EXECUTION_SPEED) != 0;
-        }
-    }
-
-    // Fallback to GetProcessInformation
-    BOOL result = GetProcessInformation(
-        hProcess,
-        static_cast<PROCESS_INFORMATION_CLASS>(UNLEAF_PROCESS_POWER_THROTTLING),
-        &state,
-        sizeof(state)
-    );
-    if (result) {
-        return (state.StateMask & UNLEAF_THROTTLE_EXECUTION_SPEED) != 0;
-    }
-
-    return false;  // Unable to determine, assume not enabled
-}
-
-// Cached version: avoids repeated NtQueryInformationProcess during thread burst
-bool EngineCore::IsEcoQoSEnabledCached(TrackedProcess& tp, ULONGLONG now) {
-    if (engine_logic::IsCacheValid(tp.ecoQosCached,
-            static_cast<uint64_t>(now),
-            static_cast<uint64_t>(tp.ecoQosCacheTime),
-            static_cast<uint64_t>(ECOQOS_CACHE_DURATION))) {
-        return tp.ecoQosCachedValue;
-    }
-    bool result = IsEcoQoSEnabled(tp.processHandle.get());
-    tp.ecoQosCached = true;
-    tp.ecoQosCachedValue = result;
-    tp.ecoQosCacheTime = now;
-    return result;
+bool EngineCore::IsEcoQoSEnabled(platform::NativeHandle hProcess) const {
+    // NtQueryInformationProcess first, GetProcessInformation fallback.
+    // Unable to determine -> assume not enabled
+    return os_.process.IsEcoQoSEnabled(hProcess);
 }
 
 // === Registry Policy Application ===
@@ -2170,7 +2280,7 @@ bool EngineCore::ApplyRegistryPolicy(const std::wstring& exePath, const std::wst
         CSLockGuard lock(policySetCs_);
         auto it = policyCacheMap_.find(exePath);
         if (it != policyCacheMap_.end()) {
-            if (RegistryPolicyManager::Instance().IsPolicyValid(exePath)) {
+            if (os_.policy.IsPolicyValid(exePath)) {
                 policyCacheLru_.splice(policyCacheLru_.begin(), policyCacheLru_, it->second);
                 return true;
             } else {
@@ -2181,7 +2291,7 @@ bool EngineCore::ApplyRegistryPolicy(const std::wstring& exePath, const std::wst
         }
     }
 
-    bool success = RegistryPolicyManager::Instance().ApplyPolicy(exeName, exePath);
+    bool success = os_.policy.ApplyPolicy(exeName, exePath);
 
     if (success) {
         CSLockGuard lock(policySetCs_);
@@ -2196,7 +2306,7 @@ bool EngineCore::ApplyRegistryPolicy(const std::wstring& exePath, const std::wst
         policyApplyCount_.fetch_add(1, std::memory_order_relaxed);
 
         wchar_t logBuf[256];
-        swprintf_s(logBuf, L"[REGISTRY] Policy applied for: %s", exeName.c_str());
+        swprintf_s(logBuf, L"[REGISTRY] Policy applied for: %ls", exeName.c_str());
         LOG_DEBUG(logBuf);
     }
 
@@ -2205,26 +2315,20 @@ bool EngineCore::ApplyRegistryPolicy(const std::wstring& exePath, const std::wst
 
 // === Stateless Pulse Enforcement (fallback) ===
 
-bool EngineCore::PulseEnforce(HANDLE hProcess, DWORD pid, bool isIntensive) {
+bool EngineCore::PulseEnforce(platform::NativeHandle hProcess, DWORD pid, bool isIntensive) {
     // Zero-Trust: Never check current state - always force desired state
 
     // Step 1: Exit background mode (unconditional)
-    SetPriorityClass(hProcess, PROCESS_MODE_BACKGROUND_END);
+    os_.process.SetPriorityClass(hProcess, PROCESS_MODE_BACKGROUND_END);
 
     // Step 2: Force EcoQoS OFF (no Get, only Set)
-    UnleafThrottleState state;
-    state.Version = UNLEAF_THROTTLE_VERSION;
-    state.ControlMask = UNLEAF_THROTTLE_EXECUTION_SPEED | UNLEAF_THROTTLE_IGNORE_TIMER;
-    state.StateMask = 0;  // Force OFF
-
-    BOOL ecoResult = SetProcessInformation(hProcess,
-        static_cast<PROCESS_INFORMATION_CLASS>(UNLEAF_PROCESS_POWER_THROTTLING),
-        &state, sizeof(state));
+    platform::EcoQoSResult eco = os_.process.SetEcoQoSOff(
+        hProcess, UNLEAF_THROTTLE_EXECUTION_SPEED | UNLEAF_THROTTLE_IGNORE_TIMER, false);
 
     // Step 3: Set HIGH priority (unconditional - critical for OS resistance)
     // Even if SetProcessInformation fails (e.g. Chrome sandbox),
     // setting HIGH_PRIORITY_CLASS prevents OS from reapplying EcoQoS
-    SetPriorityClass(hProcess, UNLEAF_TARGET_PRIORITY);
+    os_.process.SetPriorityClass(hProcess, UNLEAF_TARGET_PRIORITY);
 
     // Step 4: Thread throttling (INTENSIVE phase only - more expensive operation)
     if (isIntensive) {
@@ -2232,71 +2336,41 @@ bool EngineCore::PulseEnforce(HANDLE hProcess, DWORD pid, bool isIntensive) {
     }
 
     // Handle errors after priority has been set
-    if (!ecoResult) {
-        HandleEnforceError(hProcess, pid, GetLastError());
+    if (!eco.success) {
+        HandleEnforceError(hProcess, pid, eco.error);
         return false;
     }
 
     return true;
 }
 
-// Consolidated thread throttling
+// Consolidated thread throttling (thread walk lives in the platform layer)
+// §9.38: the thread list comes from the tick snapshot — a burst of enforcements in one tick
+// pays for one capture instead of one system-wide thread walk each. A process missing from
+// the snapshot (started after the capture) keeps the per-process walk.
 int EngineCore::DisableThreadThrottling(DWORD pid, bool aggressive) {
     if (pid == 0) return 0;
+    const engine_logic::SystemSnapshot* snapshot = AcquireTickSnapshot();
+    const engine_logic::SystemSnapshot::Process* proc = snapshot ? snapshot->Find(pid) : nullptr;
+    if (!proc || proc->threadCount == 0) {
+        threadWalkFallbacks_.fetch_add(1, std::memory_order_relaxed);
+        return os_.process.DisableThreadThrottling(pid, aggressive);
+    }
+    const engine_logic::SystemSnapshot::ThreadSpan threads = snapshot->Threads(*proc);
+    return os_.process.DisableThreadThrottling(pid, threads.ids, threads.count, aggressive);
+}
 
-    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
-    if (snapshot == INVALID_HANDLE_VALUE) return 0;
-
-    int threadCount = 0;
-    THREADENTRY32 te32;
-    te32.dwSize = sizeof(THREADENTRY32);
-
-    // Stack-allocated throttle state (no dynamic allocation)
-    UnleafThreadThrottleState threadState;
-    threadState.Version = UNLEAF_THREAD_THROTTLE_VERSION;
-    threadState.ControlMask = UNLEAF_THREAD_THROTTLE_EXECUTION_SPEED;
-    threadState.StateMask = 0;  // Disable throttling
-
-    if (Thread32First(snapshot, &te32)) {
-        do {
-            if (te32.th32OwnerProcessID == pid) {
-                HANDLE hThread = OpenThread(
-                    THREAD_SET_INFORMATION | THREAD_QUERY_INFORMATION,
-                    FALSE, te32.th32ThreadID);
-
-                if (hThread) {
-                    // Disable thread-level power throttling
-                    SetThreadInformation(hThread,
-                        static_cast<THREAD_INFORMATION_CLASS>(UNLEAF_THREAD_POWER_THROTTLING),
-                        &threadState, sizeof(threadState));
-
-                    // Priority boost logic
-                    int currentPriority = GetThreadPriority(hThread);
-                    if (currentPriority != THREAD_PRIORITY_ERROR_RETURN) {
-                        if (aggressive) {
-                            // Boost any thread below ABOVE_NORMAL
-                            if (currentPriority < THREAD_PRIORITY_ABOVE_NORMAL) {
-                                SetThreadPriority(hThread, THREAD_PRIORITY_ABOVE_NORMAL);
-                            }
-                        } else {
-                            // Conservative: only boost very low priority threads
-                            if (currentPriority == THREAD_PRIORITY_IDLE ||
-                                currentPriority == THREAD_PRIORITY_LOWEST ||
-                                currentPriority == THREAD_PRIORITY_BELOW_NORMAL) {
-                                SetThreadPriority(hThread, THREAD_PRIORITY_ABOVE_NORMAL);
-                            }
-                        }
-                    }
-
-                    CloseHandle(hThread);
-                    threadCount++;
-                }
-            }
-        } while (Thread32Next(snapshot, &te32));
+const engine_logic::SystemSnapshot* EngineCore::AcquireTickSnapshot(ULONGLONG* capturedAt) {
+    if (tickSnapshotState_ == TickSnapshotState::STALE) {
+        tickSnapshotAt_ = os_.clock.NowMs();
+        tickSnapshotState_ = os_.snapshot.Capture(tickSnapshot_)
+            ? TickSnapshotState::READY : TickSnapshotState::FAILED;
+        snapshotCaptures_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        snapshotReuses_.fetch_add(1, std::memory_order_relaxed);
     }
-
-    CloseHandle(snapshot);
-    return threadCount;
+    if (capturedAt) *capturedAt = tickSnapshotAt_;
+    return tickSnapshotState_ == TickSnapshotState::READY ? &tickSnapshot_ : nullptr;
 }
 
 void EngineCore::UpdateEnforceState(DWORD pid, ULONGLONG now, bool success) {
@@ -2304,9 +2378,9 @@ void EngineCore::UpdateEnforceState(DWORD pid, ULONGLONG now, bool success) {
     auto it = trackedProcesses_.find(pid);
     if (it == trackedProcesses_.end()) return;
 
-    auto& tp = it->second;
-    tp->lastCheckTime = now;
+    it.hot().lastCheckTime = now;
 
+    auto& tp = it.cold();
     if (success) {
         tp->consecutiveFailures = 0;
         tp->nextRetryTime = 0;
@@ -2314,17 +2388,76 @@ void EngineCore::UpdateEnforceState(DWORD pid, ULONGLONG now, bool success) {
 }
 
 void EngineCore::SetProcessPhase(DWORD pid, ProcessPhase phase) {
-    CSLockGuard lock(trackedCs_);
-    auto it = trackedProcesses_.find(pid);
-    if (it != trackedProcesses_.end()) {
-        it->second->phase = phase;
-        it->second->phaseStartTime = GetTickCount64();
+    {
+        CSLockGuard lock(trackedCs_);
+        auto it = trackedProcesses_.find(pid);
+        if (it != trackedProcesses_.end()) {
+            TrackedHot& hot = it.hot();
+            if (AcceptsThreadEvents(hot.phase) != AcceptsThreadEvents(phase)) {
+                threadEventTargetsDirty_.store(true, std::memory_order_relaxed);
+            }
+            hot.phase = phase;
+            hot.phaseStartTime = os_.clock.NowMs();
+            hot.stateVersion++;
+        }
+    }
+    PublishThreadEventTargets();
+}
+
+// §9.25: Rebuild the thread-event target snapshot from trackedProcesses_ and publish it.
+// Single writer: the control thread (Start / Stop run before / after it).
+// Pending flags carry over so a request still in the queue keeps coalescing; a reader
+// racing the copy can cost at most one extra ETW_THREAD_START for that PID.
+void EngineCore::PublishThreadEventTargets(bool force) {
+    if (!threadEventTargetsDirty_.exchange(false, std::memory_order_relaxed) && !force) return;
+
+    std::vector<uint32_t> pids;
+    {
+        CSLockGuard lock(trackedCs_);
+        pids.reserve(trackedProcesses_.size());
+        for (const auto& [pid, hot, tp] : trackedProcesses_) {
+            if (AcceptsThreadEvents(hot.phase)) pids.push_back(pid);
+        }
+    }
+
+    // §9.28: new members become visible to the monitor first
+    std::sort(pids.begin(), pids.end());
+    for (uint32_t pid : pids) threadEventFilter_.Set(pid);
+
+    auto next = std::make_unique<engine_logic::PidSignalSet>(pids);
+    if (const auto* prev = threadEventTargets_.WriterPeek()) {
+        for (uint32_t pid : pids) {
+            const auto* was = prev->Find(pid);
+            if (was) {
+                if (const uint8_t slot = was->load(std::memory_order_acquire)) {
+                    next->Find(pid)->store(slot, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+    // Returns after every OnThreadStart still reading the previous snapshot has left it
+    threadEventTargets_.Publish(std::move(next));
+
+    // ...and departed members are filtered only once the snapshot no longer accepts them
+    std::vector<uint32_t> removed;
+    std::set_difference(threadEventFilterPids_.begin(), threadEventFilterPids_.end(),
+                        pids.begin(), pids.end(), std::back_inserter(removed));
+    for (uint32_t pid : removed) threadEventFilter_.Clear(pid);
+    threadEventFilterPids_ = std::move(pids);
+}
+
+uint8_t EngineCore::ClearThreadEventPending(DWORD pid) {
+    auto targets = threadEventTargets_.Read();
+    if (!targets) return THREAD_EVENT_IDLE;
+    if (auto* pending = targets->Find(pid)) {
+        return pending->exchange(THREAD_EVENT_IDLE, std::memory_order_acq_rel);
     }
+    return THREAD_EVENT_IDLE;
 }
 
 // === Self-Healing Error Handling ===
 
-void EngineCore::HandleEnforceError(HANDLE hProcess, DWORD pid, DWORD error) {
+void EngineCore::HandleEnforceError(platform::NativeHandle hProcess, DWORD pid, DWORD error) {
     totalRetries_.fetch_add(1, std::memory_order_relaxed);
 
     // Error-code-specific counters (always increment, independent of log suppression)
@@ -2333,20 +2466,20 @@ void EngineCore::HandleEnforceError(HANDLE hProcess, DWORD pid, DWORD error) {
 
     // Check if process is still alive before retrying
     DWORD exitCode = 0;
-    bool processAlive = (hProcess && GetExitCodeProcess(hProcess, &exitCode) && exitCode == STILL_ACTIVE);
+    bool processAlive = (hProcess && os_.process.QueryExitCode(hProcess, exitCode) && exitCode == STILL_ACTIVE);
 
     CSLockGuard lock(trackedCs_);
     auto it = trackedProcesses_.find(pid);
     if (it == trackedProcesses_.end()) return;
 
-    auto& tp = it->second;
+    auto& tp = it.cold();
     tp->consecutiveFailures++;
     tp->lastErrorCode = error;
 
     // Error log suppression (same PID × error code within 60s window)
     auto suppressKey = std::make_pair(pid, error);
     bool shouldLog = true;
-    ULONGLONG now = GetTickCount64();
+    ULONGLONG now = os_.clock.NowMs();
     auto suppIt = errorLogSuppression_.find(suppressKey);
     if (suppIt != errorLogSuppression_.end() && now - suppIt->second < ERROR_LOG_SUPPRESS_MS) {
         shouldLog = false;
@@ -2363,7 +2496,7 @@ void EngineCore::HandleEnforceError(HANDLE hProcess, DWORD pid, DWORD error) {
     if (!processAlive) {
         if (shouldLog) {
             wchar_t logBuf[256];
-            swprintf_s(logBuf, L"[CLEANUP] %s (PID:%lu) process exited (exitCode=%lu)",
+            swprintf_s(logBuf, L"[CLEANUP] %ls (PID:%u) process exited (exitCode=%u)",
                        tp->name.c_str(), pid, exitCode);
             LOG_DEBUG(logBuf);
         }
@@ -2374,10 +2507,10 @@ void EngineCore::HandleEnforceError(HANDLE hProcess, DWORD pid, DWORD error) {
     switch (error) {
         case ERROR_ACCESS_DENIED:
             if (tp->consecutiveFailures <= 2) {
-                tp->nextRetryTime = GetTickCount64() + RETRY_BACKOFF_BASE_MS;
+                tp->nextRetryTime = os_.clock.NowMs() + RETRY_BACKOFF_BASE_MS;
             } else if (shouldLog) {
                 wchar_t logBuf[256];
-                swprintf_s(logBuf, L"[GIVE_UP] %s (PID:%lu) access denied - giving up after 2 retries",
+                swprintf_s(logBuf, L"[GIVE_UP] %ls (PID:%u) access denied - giving up after 2 retries",
                            tp->name.c_str(), pid);
                 LOG_DEBUG(logBuf);
             }
@@ -2395,10 +2528,10 @@ void EngineCore::HandleEnforceError(HANDLE hProcess, DWORD pid, DWORD error) {
         default:
             if (tp->consecutiveFailures <= MAX_RETRY_COUNT) {
                 DWORD backoff = RETRY_BACKOFF_BASE_MS * (1 << (tp->consecutiveFailures - 1));
-                tp->nextRetryTime = GetTickCount64() + backoff;
+                tp->nextRetryTime = os_.clock.NowMs() + backoff;
             } else if (shouldLog) {
                 wchar_t logBuf[256];
-                swprintf_s(logBuf, L"[GIVE_UP] %s (PID:%lu) error=%lu - max retries reached",
+                swprintf_s(logBuf, L"[GIVE_UP] %ls (PID:%u) error=%u - max retries reached",
                            tp->name.c_str(), pid, error);
                 LOG_DEBUG(logBuf);
             }
@@ -2409,24 +2542,22 @@ void EngineCore::HandleEnforceError(HANDLE hProcess, DWORD pid, DWORD error) {
 bool EngineCore::ReopenProcessHandle(DWORD pid) {
     totalHandleReopen_.fetch_add(1, std::memory_order_relaxed);
 
-    HANDLE hProcess = OpenProcess(
-        PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_SET_INFORMATION,
-        FALSE, pid);
+    platform::NativeHandle hProcess = os_.process.OpenControl(pid);
 
     if (!hProcess) return false;
 
-    HANDLE oldWaitHandle = nullptr;
+    platform::NativeHandle oldWaitHandle = nullptr;
     WaitCallbackContext* oldContext = nullptr;
 
     {
         CSLockGuard lock(trackedCs_);
         auto it = trackedProcesses_.find(pid);
         if (it == trackedProcesses_.end()) {
-            CloseHandle(hProcess);
+            os_.process.CloseHandle(hProcess);
             return false;
         }
 
-        auto& tp = it->second;
+        auto& tp = it.cold();
 
         // Collect old wait handle for out-of-lock cleanup
         if (tp->waitHandle) {
@@ -2443,37 +2574,32 @@ bool EngineCore::ReopenProcessHandle(DWORD pid) {
         }
 
         // Replace handle
-        tp->processHandle = MakeScopedHandle(hProcess);
+        tp->processHandle = platform::OwnedHandle(os_.process, hProcess);
         tp->consecutiveFailures = 0;
         tp->nextRetryTime = 0;
 
-        // Re-register wait callback with separate SYNCHRONIZE handle
-        HANDLE hWaitProcess = OpenProcess(SYNCHRONIZE, FALSE, pid);
+        // Re-register wait callback with separate SYNCHRONIZE handle (§9.32: unless exits come from the monitor)
+        platform::NativeHandle hWaitProcess = monitorExitEvents_.load(std::memory_order_relaxed)
+            ? nullptr : os_.process.OpenSynchronize(pid);
         if (hWaitProcess) {
-            auto context = new WaitCallbackContext{this, pid, it->second};
-            HANDLE waitHandle = nullptr;
-
-            if (RegisterWaitForSingleObject(
-                    &waitHandle,
-                    hWaitProcess,
-                    OnProcessExit,
-                    context,
-                    INFINITE,
-                    WT_EXECUTEONLYONCE)) {
+            auto context = new WaitCallbackContext{this, pid, it.cold()};
+            platform::NativeHandle waitHandle = nullptr;
+
+            if (os_.process.RegisterExitWait(&waitHandle, hWaitProcess, OnProcessExit, context)) {
                 tp->waitHandle = waitHandle;
-                tp->waitProcessHandle = MakeScopedHandle(hWaitProcess);
+                tp->waitProcessHandle = platform::OwnedHandle(os_.process, hWaitProcess);
                 waitContexts_[pid] = context;
                 waitRegisterCount_.fetch_add(1, std::memory_order_relaxed);
             } else {
                 delete context;
-                CloseHandle(hWaitProcess);
+                os_.process.CloseHandle(hWaitProcess);
             }
         }
     }
 
     // Unregister old wait outside lock (blocks until callback completes)
     if (oldWaitHandle) {
-        if (!UnregisterWaitEx(oldWaitHandle, INVALID_HANDLE_VALUE)) {
+        if (!os_.process.UnregisterExitWait(oldWaitHandle)) {
             shutdownWarnings_.fetch_add(1);
             waitUnregisterFailures_.fetch_add(1, std::memory_order_relaxed);
         } else {
@@ -2483,53 +2609,44 @@ bool EngineCore::ReopenProcessHandle(DWORD pid) {
     delete oldContext;
 
     wchar_t logBuf[64];
-    swprintf_s(logBuf, L"Engine: Reopened handle for PID %lu", pid);
+    swprintf_s(logBuf, L"Engine: Reopened handle for PID %u", pid);
     LOG_DEBUG(logBuf);
     return true;
 }
 
 // === Job Object Management ===
 
-bool EngineCore::CreateAndAssignJobObject(DWORD rootPid, HANDLE hProcess) {
-    // Check if already in a Job (Chrome sandbox case)
-    BOOL inJob = FALSE;
-    IsProcessInJob(hProcess, nullptr, &inJob);
-    if (inJob) {
-        wchar_t logBuf[96];
-        swprintf_s(logBuf, L"Job: PID %lu already in Job - pulse-only mode", rootPid);
-        LOG_DEBUG(logBuf);
-        return false;  // TrackedProcess still created to continue PulseEnforce
-    }
-
-    // Create Job Object
-    HANDLE hJob = CreateJobObjectW(nullptr, nullptr);
-    if (!hJob) {
-        wchar_t logBuf[96];
-        swprintf_s(logBuf, L"[JOB] Failed to create Job Object (error=%lu)", GetLastError());
-        LOG_DEBUG(logBuf);
-        return false;
-    }
-
-    // Configure: allow breakaway for nested processes
-    JOBOBJECT_EXTENDED_LIMIT_INFORMATION jobInfo = {};
-    jobInfo.BasicLimitInformation.LimitFlags =
-        JOB_OBJECT_LIMIT_BREAKAWAY_OK | JOB_OBJECT_LIMIT_SILENT_BREAKAWAY_OK;
-    SetInformationJobObject(hJob, JobObjectExtendedLimitInformation,
-        &jobInfo, sizeof(jobInfo));
-
-    // Assign process to Job
-    if (!AssignProcessToJobObject(hJob, hProcess)) {
-        DWORD error = GetLastError();
-        CloseHandle(hJob);
-        wchar_t logBuf[128];
-        swprintf_s(logBuf, L"[JOB] Failed to assign PID %lu to Job (error=%lu)", rootPid, error);
-        LOG_DEBUG(logBuf);
-        return false;
+bool EngineCore::CreateAndAssignJobObject(DWORD rootPid, platform::NativeHandle hProcess) {
+    // Check if already in a Job (Chrome sandbox case), then create Job Object with
+    // breakaway allowed for nested processes and assign the process to it
+    platform::NativeHandle hJob = nullptr;
+    switch (os_.process.AssignToNewJob(hProcess, &hJob)) {
+        case platform::JobAssignResult::ASSIGNED:
+            break;
+        case platform::JobAssignResult::ALREADY_IN_JOB: {
+            wchar_t logBuf[96];
+            swprintf_s(logBuf, L"Job: PID %u already in Job - pulse-only mode", rootPid);
+            LOG_DEBUG(logBuf);
+            return false;  // TrackedProcess still created to continue PulseEnforce
+        }
+        case platform::JobAssignResult::CREATE_FAILED: {
+            wchar_t logBuf[96];
+            swprintf_s(logBuf, L"[JOB] Failed to create Job Object (error=%u)", os_.process.LastError());
+            LOG_DEBUG(logBuf);
+            return false;
+        }
+        case platform::JobAssignResult::ASSIGN_FAILED: {
+            wchar_t logBuf[128];
+            swprintf_s(logBuf, L"[JOB] Failed to assign PID %u to Job (error=%u)",
+                       rootPid, os_.process.LastError());
+            LOG_DEBUG(logBuf);
+            return false;
+        }
     }
 
     // Store Job Object
     auto info = std::make_unique<JobObjectInfo>();
-    info->jobHandle = hJob;
+    info->jobHandle = platform::OwnedHandle(os_.process, hJob);
     info->rootPid = rootPid;
     info->isOwnJob = true;
 
@@ -2540,7 +2657,7 @@ bool EngineCore::CreateAndAssignJobObject(DWORD rootPid, HANDLE hProcess) {
 
     {
         wchar_t logBuf[96];
-        swprintf_s(logBuf, L"Job: Created Job Object for root PID %lu", rootPid);
+        swprintf_s(logBuf, L"Job: Created Job Object for root PID %u", rootPid);
         LOG_DEBUG(logBuf);
     }
     return true;
@@ -2548,7 +2665,7 @@ bool EngineCore::CreateAndAssignJobObject(DWORD rootPid, HANDLE hProcess) {
 
 // Optimized 2-pass approach to minimize lock contention
 void EngineCore::RefreshJobObjectPids() {
-#ifdef _DEBUG
+#if defined(_DEBUG) && defined(_WIN32)
     {
         DWORD tid = engineControlThreadId_.load(std::memory_order_relaxed);
         assert(tid != 0 &&
@@ -2571,14 +2688,10 @@ void EngineCore::RefreshJobObjectPids() {
             if (!jobInfo->isOwnJob || !jobInfo->jobHandle) continue;
 
             // Fixed-size stack buffer for PID list (no dynamic allocation)
-            BYTE buffer[sizeof(JOBOBJECT_BASIC_PROCESS_ID_LIST) +
-                        (MAX_JOB_PIDS - 1) * sizeof(ULONG_PTR)];
-            auto* pidList = reinterpret_cast<JOBOBJECT_BASIC_PROCESS_ID_LIST*>(buffer);
-            pidList->NumberOfAssignedProcesses = MAX_JOB_PIDS;
-            pidList->NumberOfProcessIdsInList = 0;
-
-            if (!QueryInformationJobObject(jobInfo->jobHandle,
-                    JobObjectBasicProcessIdList, pidList, sizeof(buffer), nullptr)) {
+            DWORD pids[MAX_JOB_PIDS];
+            DWORD pidCount = 0;
+            if (!os_.process.QueryJobProcessIds(jobInfo->jobHandle.get(),
+                    pids, MAX_JOB_PIDS, &pidCount)) {
                 continue;
             }
 
@@ -2586,8 +2699,8 @@ void EngineCore::RefreshJobObjectPids() {
             result.rootPid = rootPid;
 
             // Collect only new (untracked) PIDs
-            for (DWORD i = 0; i < pidList->NumberOfProcessIdsInList; i++) {
-                DWORD pid = static_cast<DWORD>(pidList->ProcessIdList[i]);
+            for (DWORD i = 0; i < pidCount; i++) {
+                DWORD pid = pids[i];
                 if (trackedProcesses_.find(pid) == trackedProcesses_.end()) {
                     result.newPids.push_back(pid);
                 }
@@ -2606,25 +2719,22 @@ void EngineCore::RefreshJobObjectPids() {
             if (IsTracked(pid)) continue;
 
             // Get process name (no lock needed)
-            HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+            platform::NativeHandle hProcess = os_.process.OpenQuery(pid);
             if (!hProcess) continue;
 
-            wchar_t nameBuffer[MAX_PATH];
-            DWORD nameSize = MAX_PATH;
             std::wstring name;
-
-            if (QueryFullProcessImageNameW(hProcess, 0, nameBuffer, &nameSize)) {
+            std::wstring fullPath = os_.process.QueryImageName(hProcess);
+            if (!fullPath.empty()) {
                 // Extract filename from path
-                std::wstring fullPath(nameBuffer);
                 size_t pos = fullPath.find_last_of(L"\\/");
                 name = (pos != std::wstring::npos) ? fullPath.substr(pos + 1) : fullPath;
             }
-            CloseHandle(hProcess);
+            os_.process.CloseHandle(hProcess);
 
             if (name.empty()) continue;
 
             // Skip critical processes
-            if (!IsCriticalProcess(name)) {
+            if (!IsCriticalImage(name)) {
                 ApplyOptimization(pid, name, true, result.rootPid);
             }
         }
@@ -2642,8 +2752,7 @@ void EngineCore::UpdatePhase(DWORD pid, ULONGLONG now) {
     auto it = trackedProcesses_.find(pid);
     if (it == trackedProcesses_.end()) return;
 
-    auto& tp = it->second;
-    tp->lastCheckTime = now;
+    it.hot().lastCheckTime = now;
 }
 
 // === Process Management ===
@@ -2653,124 +2762,73 @@ void EngineCore::UpdatePhase(DWORD pid, ULONGLONG now) {
 void EngineCore::InitialScanForDegradedMode() {
     // DEGRADED_ETW mode fallback: scan all processes
     // This is only called when ETW is unavailable
-    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-    if (snapshot == INVALID_HANDLE_VALUE) return;
-
-    ScopedSnapshot scopedSnapshot = MakeScopedSnapshot(snapshot);
-
-    std::set<std::wstring> localNameTargets;
-    std::set<std::wstring> localPathTargets;
-    std::set<std::wstring> localPathFileNames;
-    bool pathTargetsActive = false;
-    {
-        CSLockGuard lock(targetCs_);
-        localNameTargets   = targetNameSet_;
-        localPathTargets   = targetPathSet_;
-        localPathFileNames = pathTargetFileNames_;
-        pathTargetsActive  = !localPathTargets.empty();
-    }
+    ULONGLONG capturedAt = 0;
+    const engine_logic::SystemSnapshot* snapshot = AcquireTickSnapshot(&capturedAt);
+    if (!snapshot) return;
+    // §9.37: no start events in this mode — the tree is only as fresh as this snapshot
+    ReconcileProcessTree(*snapshot, capturedAt);
 
-    PROCESSENTRY32W pe32;
-    pe32.dwSize = sizeof(PROCESSENTRY32W);
+    std::shared_ptr<const TargetTables> targets = SnapshotTargets();
+    const bool pathTargetsActive = !targets->paths.empty();
 
-    if (Process32FirstW(scopedSnapshot.get(), &pe32)) {
-        do {
-            DWORD pid = pe32.th32ProcessID;
-            const std::wstring name(pe32.szExeFile);
-            DWORD parentPid = pe32.th32ParentProcessID;
+    for (const auto& pe : *snapshot) {
+        DWORD pid = pe.pid;
+        const std::wstring_view name = snapshot->Name(pe);
+        DWORD parentPid = pe.parentPid;
 
-            if (IsTracked(pid)) continue;
-            if (IsCriticalProcess(name)) continue;
+        if (IsTracked(pid)) continue;
+        if (IsCriticalImage(name)) continue;
 
-            std::wstring lowerName = ToLower(name);
-            bool isNameTarget = (localNameTargets.count(lowerName) > 0);
-            bool isChild = IsTrackedParent(parentPid);
+        bool isNameTarget = targets->names.Contains(name);
+        const DWORD trackedAncestor = FindTrackedAncestor(pid, parentPid);
+        bool isChild = trackedAncestor != 0;
 
-            if (isNameTarget || isChild) {
-                ApplyOptimization(pid, name, isChild, parentPid);
-                continue;
-            }
+        if (isNameTarget || isChild) {
+            ApplyOptimization(pid, std::wstring(name), isChild, isChild ? trackedAncestor : parentPid);
+            continue;
+        }
 
-            // Path-based check
-            if (pathTargetsActive && localPathFileNames.count(lowerName) > 0) {
-                DWORD access = PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_SET_INFORMATION;
-                HANDLE hProc = OpenProcess(access, FALSE, pid);
-                if (hProc) {
-                    ScopedHandle scoped = MakeScopedHandle(hProc);
-                    std::wstring fullPath = ResolveProcessPath(scoped.get());
-                    if (!fullPath.empty() && localPathTargets.count(fullPath) > 0) {
-                        ApplyOptimizationWithHandle(pid, name, false, 0,
-                                                     std::move(scoped), fullPath);
-                    }
+        // Path-based check
+        if (pathTargetsActive && targets->pathFileNames.Contains(name)) {
+            platform::OwnedHandle scoped(os_.process, os_.process.OpenControl(pid));
+            if (scoped) {
+                std::wstring fullPath = ResolveProcessPath(scoped.get());
+                if (!fullPath.empty() && targets->paths.Contains(fullPath)) {
+                    ApplyOptimizationWithHandle(pid, std::wstring(name), false, 0,
+                                                 std::move(scoped), fullPath);
                 }
             }
-        } while (Process32NextW(scopedSnapshot.get(), &pe32));
+        }
     }
 }
 
 void EngineCore::InitialScan() {
     // Scan for existing target processes at startup
-    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-    if (snapshot == INVALID_HANDLE_VALUE) return;
-
-    ScopedSnapshot scopedSnapshot = MakeScopedSnapshot(snapshot);
-
-    // Build process map
-    struct ProcessInfo {
-        std::wstring name;
-        DWORD parentPid;
-    };
-    std::map<DWORD, ProcessInfo> processMap;
-
-    PROCESSENTRY32W pe32;
-    pe32.dwSize = sizeof(PROCESSENTRY32W);
-
-    if (Process32FirstW(scopedSnapshot.get(), &pe32)) {
-        do {
-            processMap[pe32.th32ProcessID] = { pe32.szExeFile, pe32.th32ParentProcessID };
-        } while (Process32NextW(scopedSnapshot.get(), &pe32));
-    }
-
-    // Collect descendants recursively
-    std::function<void(DWORD, std::vector<std::pair<DWORD, std::wstring>>&)> collectDescendants;
-    collectDescendants = [&](DWORD parentPid, std::vector<std::pair<DWORD, std::wstring>>& out) {
-        for (const auto& [pid, info] : processMap) {
-            if (info.parentPid == parentPid && !IsCriticalProcess(info.name)) {
-                out.emplace_back(pid, info.name);
-                collectDescendants(pid, out);
-            }
-        }
-    };
+    ULONGLONG capturedAt = 0;
+    const engine_logic::SystemSnapshot* tick = AcquireTickSnapshot(&capturedAt);
+    if (!tick) return;
+    const engine_logic::SystemSnapshot& snapshot = *tick;
+    RecordScanBaseline(snapshot);
+    // §9.37: seeds the process tree (Start) / repairs it (config reload). Descendants come
+    // from the tree: O(subtree) per target instead of a full map pass per visited node.
+    ReconcileProcessTree(snapshot, capturedAt);
 
     // Find and optimize target processes
-    std::set<std::wstring> localNameTargets;
-    std::set<std::wstring> localPathTargets;
-    std::set<std::wstring> localPathFileNames;
-    bool pathTargetsActive = false;
-    {
-        CSLockGuard lock(targetCs_);
-        localNameTargets   = targetNameSet_;
-        localPathTargets   = targetPathSet_;
-        localPathFileNames = pathTargetFileNames_;
-        pathTargetsActive  = !localPathTargets.empty();
-    }
+    std::shared_ptr<const TargetTables> targets = SnapshotTargets();
+    const bool pathTargetsActive = !targets->paths.empty();
 
     // Phase A: name-based scan (unchanged behavior)
-    for (const auto& [pid, info] : processMap) {
-        std::wstring lowerName = ToLower(info.name);
-
-        if (localNameTargets.find(lowerName) != localNameTargets.end()) {
-            if (!IsCriticalProcess(info.name) && !IsTracked(pid)) {
-                ApplyOptimization(pid, info.name, false, 0);
+    for (const auto& pe : snapshot) {
+        const std::wstring_view name = snapshot.Name(pe);
+        if (targets->names.Contains(name)) {
+            if (!IsCriticalImage(name) && !IsTracked(pe.pid)) {
+                ApplyOptimization(pe.pid, std::wstring(name), false, 0);
             }
 
             // Collect and optimize descendants
-            std::vector<std::pair<DWORD, std::wstring>> descendants;
-            collectDescendants(pid, descendants);
-
-            for (const auto& [childPid, childName] : descendants) {
+            for (const auto& [childPid, childName] : CollectDescendants(pe.pid)) {
                 if (!IsTracked(childPid)) {
-                    ApplyOptimization(childPid, childName, true, pid);
+                    ApplyOptimization(childPid, childName, true, pe.pid);
                 }
             }
         }
@@ -2778,34 +2836,31 @@ void EngineCore::InitialScan() {
 
     // Phase B: path-based scan (only when path targets configured)
     if (pathTargetsActive) {
-        for (const auto& [pid, info] : processMap) {
-            if (IsTracked(pid)) continue;
-            if (IsCriticalProcess(info.name)) continue;
+        for (const auto& pe : snapshot) {
+            const std::wstring_view name = snapshot.Name(pe);
+            if (IsTracked(pe.pid)) continue;
+            if (IsCriticalImage(name)) continue;
             // Skip processes already matched by name
-            if (localNameTargets.count(ToLower(info.name))) continue;
+            if (targets->names.Contains(name)) continue;
             // Pre-filter: skip if exe name not in any path target
-            if (localPathFileNames.count(ToLower(info.name)) == 0) continue;
+            if (!targets->pathFileNames.Contains(name)) continue;
 
             // Open with full permissions needed for optimization
-            DWORD access = PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_SET_INFORMATION;
-            HANDLE hProc = OpenProcess(access, FALSE, pid);
-            if (!hProc) continue;
-            ScopedHandle scoped = MakeScopedHandle(hProc);
+            platform::OwnedHandle scoped(os_.process, os_.process.OpenControl(pe.pid));
+            if (!scoped) continue;
 
             std::wstring fullPath = ResolveProcessPath(scoped.get());
             if (fullPath.empty()) continue;
 
-            if (localPathTargets.count(fullPath) > 0) {
+            if (targets->paths.Contains(fullPath)) {
                 // Hand off handle — no second OpenProcess
-                ApplyOptimizationWithHandle(pid, info.name, false, 0,
+                ApplyOptimizationWithHandle(pe.pid, std::wstring(name), false, 0,
                                              std::move(scoped), fullPath);
 
                 // Collect and optimize descendants
-                std::vector<std::pair<DWORD, std::wstring>> descendants;
-                collectDescendants(pid, descendants);
-                for (const auto& [childPid, childName] : descendants) {
+                for (const auto& [childPid, childName] : CollectDescendants(pe.pid)) {
                     if (!IsTracked(childPid)) {
-                        ApplyOptimization(childPid, childName, true, pid);
+                        ApplyOptimization(childPid, childName, true, pe.pid);
                     }
                 }
             }
@@ -2813,6 +2868,119 @@ void EngineCore::InitialScan() {
     }
 }
 
+// §9.37: pid's descendants from the process tree, parents first. A critical image and its
+// subtree are left out (same boundary as the map walk InitialScan used before).
+std::vector<std::pair<DWORD, std::wstring>> EngineCore::CollectDescendants(DWORD pid) const {
+    std::vector<std::pair<DWORD, std::wstring>> out;
+    const engine_logic::StringInternTable& strings = engine_logic::StringInternTable::Instance();
+    CSLockGuard lock(treeCs_);
+    processTree_.ForEachDescendant(pid, [&](uint32_t child, const engine_logic::ProcessTree::Node& node) {
+        if (node.critical) return false;
+        // Unnamed = started after the snapshot that just reconciled the tree: its own start
+        // event classifies it. Its children are still walked.
+        if (node.imageId == engine_logic::StringInternTable::EMPTY) return true;
+        out.emplace_back(child, std::wstring(strings.View(node.imageId)));
+        return true;
+    });
+    return out;
+}
+
+size_t EngineCore::ReconcileProcessTree(const engine_logic::SystemSnapshot& snapshot,
+                                        ULONGLONG capturedAt) {
+    std::vector<engine_logic::ProcessTree::LiveEntry> live;
+    live.reserve(snapshot.Size());
+    for (const auto& pe : snapshot) {
+        const std::wstring_view name = snapshot.Name(pe);
+        live.push_back({pe.pid, pe.parentPid, name, IsCriticalImage(name)});
+    }
+    CSLockGuard lock(treeCs_);
+    return processTree_.Reconcile(live, capturedAt);
+}
+
+void EngineCore::RecordScanBaseline(const engine_logic::SystemSnapshot& snapshot) {
+    const std::hash<std::wstring_view> hashName;
+    scanBaseline_.clear();
+    scanBaseline_.reserve(snapshot.Size());
+    for (const auto& pe : snapshot) {
+        scanBaseline_.push_back({pe.pid, pe.parentPid, hashName(snapshot.Name(pe))});
+    }
+    std::sort(scanBaseline_.begin(), scanBaseline_.end(),
+              [](const ScanBaselineEntry& a, const ScanBaselineEntry& b) { return a.pid < b.pid; });
+    // Evidence up to here is covered by this snapshot
+    rescanLostBase_ = processMonitor_.GetLostEventCount();
+    rescanDropBase_ = criticalDropCount_.load(std::memory_order_relaxed) +
+                      criticalEvictCount_.load(std::memory_order_relaxed);
+    rescanRestartBase_ = lastEtwRestartTime_;
+}
+
+// §9.36: Rescan only when process starts may have been lost, and only the processes that
+// appeared since the last scan. Anything that existed at the baseline was either seen by the
+// monitor or handled by that scan; a missed target's children are new as well, so the
+// descendant walk of InitialScan is not needed — new entries are retried until no parent
+// becomes tracked (parents before children, bounded by tree depth).
+void EngineCore::RescanOnEventLoss() {
+    const uint32_t lost = processMonitor_.GetLostEventCount();
+    const uint32_t drops = criticalDropCount_.load(std::memory_order_relaxed) +
+                           criticalEvictCount_.load(std::memory_order_relaxed);
+    const bool restarted = (lastEtwRestartTime_ != rescanRestartBase_);
+    if (lost == rescanLostBase_ && drops == rescanDropBase_ && !restarted) return;
+
+    ULONGLONG capturedAt = 0;
+    const engine_logic::SystemSnapshot* tick = AcquireTickSnapshot(&capturedAt);
+    if (!tick) return;   // evidence kept: retried next check
+    const engine_logic::SystemSnapshot& snapshot = *tick;
+    // §9.37: the lost starts enter the process tree first, so their children find them below
+    processTreeRepairs_.fetch_add(static_cast<uint32_t>(ReconcileProcessTree(snapshot, capturedAt)),
+                                  std::memory_order_relaxed);
+
+    const std::hash<std::wstring_view> hashName;
+    std::vector<const engine_logic::SystemSnapshot::Process*> fresh;
+    for (const auto& pe : snapshot) {
+        auto it = std::lower_bound(scanBaseline_.begin(), scanBaseline_.end(), pe.pid,
+                                   [](const ScanBaselineEntry& e, DWORD pid) { return e.pid < pid; });
+        const std::wstring_view name = snapshot.Name(pe);
+        const bool known = it != scanBaseline_.end() && it->pid == pe.pid &&
+                           it->parentPid == pe.parentPid && it->nameHash == hashName(name);
+        if (!known && !IsCriticalImage(name)) fresh.push_back(&pe);
+    }
+
+    wchar_t logBuf[192];
+    swprintf_s(logBuf, L"[RESCAN] Event loss evidence (lost=+%u drops=+%u restart=%d) - %zu new of %zu processes",
+               lost - rescanLostBase_, drops - rescanDropBase_, restarted ? 1 : 0,
+               fresh.size(), snapshot.Size());
+    LOG_INFO(logBuf);
+    lossRescanCount_.fetch_add(1, std::memory_order_relaxed);
+    lossRescanEntries_.fetch_add(static_cast<uint32_t>(fresh.size()), std::memory_order_relaxed);
+
+    std::shared_ptr<const TargetTables> targets = SnapshotTargets();
+    const bool pathTargetsActive = !targets->paths.empty();
+    std::vector<bool> settled(fresh.size(), false);
+    for (bool progress = true; progress;) {
+        progress = false;
+        for (size_t i = 0; i < fresh.size(); ++i) {
+            if (settled[i]) continue;
+            const engine_logic::SystemSnapshot::Process& pe = *fresh[i];
+            const std::wstring_view name = snapshot.Name(pe);
+            if (IsTracked(pe.pid)) {
+                settled[i] = true;
+            } else if (targets->names.Contains(name)) {
+                settled[i] = true;
+                progress |= ApplyOptimization(pe.pid, std::wstring(name), false, 0);
+            } else if (const DWORD ancestor = FindTrackedAncestor(pe.pid, pe.parentPid)) {
+                settled[i] = true;
+                progress |= ApplyOptimization(pe.pid, std::wstring(name), true, ancestor);
+            } else if (pathTargetsActive && targets->pathFileNames.Contains(name)) {
+                settled[i] = true;
+                TryApplyByPath(pe.pid, std::wstring(name));
+                progress |= IsTracked(pe.pid);
+            }
+            // else: may still become the child of a parent tracked later in this pass
+        }
+    }
+
+    RecordScanBaseline(snapshot);
+}
+
 bool EngineCore::ApplyOptimization(DWORD pid, const std::wstring& name, bool isChild,
                                     DWORD parentPid, const std::wstring& preResolvedPath) {
     // Skip if already tracked
@@ -2821,22 +2989,21 @@ bool EngineCore::ApplyOptimization(DWORD pid, const std::wstring& name, bool isC
     }
 
     // Skip critical processes
-    if (IsCriticalProcess(name)) {
+    if (IsCriticalImage(name)) {
         return false;
     }
 
     // Use minimal permissions (0x1200) for Chrome sandbox process compatibility
-    DWORD access = PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_SET_INFORMATION;
-    HANDLE hProcess = OpenProcess(access, FALSE, pid);
+    platform::NativeHandle hProcess = os_.process.OpenControl(pid);
     if (!hProcess) {
         wchar_t logBuf[256];
-        swprintf_s(logBuf, L"[SKIP] %s (PID:%lu) OpenProcess failed (error=%lu)",
-                   name.c_str(), pid, GetLastError());
+        swprintf_s(logBuf, L"[SKIP] %ls (PID:%u) OpenProcess failed (error=%u)",
+                   name.c_str(), pid, os_.process.LastError());
         LOG_DEBUG(logBuf);
         return false;
     }
 
-    ScopedHandle scopedHandle = MakeScopedHandle(hProcess);
+    platform::OwnedHandle scopedHandle(os_.process, hProcess);
 
     // Resolve full path: detect NT device paths from ETW and route appropriately
     auto isNtDevicePath = [](const std::wstring& p) {
@@ -2860,7 +3027,7 @@ bool EngineCore::ApplyOptimization(DWORD pid, const std::wstring& name, bool isC
         if (resolvedPath.empty()) {
             wchar_t diagBuf[512];
             swprintf_s(diagBuf,
-                L"[DIAG] ApplyOptimization: path resolution failed for %s (PID:%lu) hint=%s",
+                L"[DIAG] ApplyOptimization: path resolution failed for %ls (PID:%u) hint=%ls",
                 name.c_str(), pid,
                 preResolvedPath.empty() ? L"(empty)" : L"(NT device path)");
             LOG_DEBUG(diagBuf);
@@ -2873,13 +3040,13 @@ bool EngineCore::ApplyOptimization(DWORD pid, const std::wstring& name, bool isC
 
 bool EngineCore::ApplyOptimizationWithHandle(DWORD pid, const std::wstring& name,
                                               bool isChild, DWORD parentPid,
-                                              ScopedHandle&& scopedHandle,
+                                              platform::OwnedHandle&& scopedHandle,
                                               const std::wstring& resolvedPath) {
     // Guard: skip if already tracked or critical (may be called directly from TryApplyByPath)
     if (IsTracked(pid)) return false;
-    if (IsCriticalProcess(name)) return false;
+    if (IsCriticalImage(name)) return false;
 
-    ULONGLONG now = GetTickCount64();
+    ULONGLONG now = os_.clock.NowMs();
 
     // DESIGN CONTRACT:
     // EngineCore guarantees canonicalized paths via CanonicalizePath().
@@ -2899,23 +3066,23 @@ bool EngineCore::ApplyOptimizationWithHandle(DWORD pid, const std::wstring& name
         bool isNameOnlyTarget = false;
         {
             CSLockGuard lock(targetCs_);
-            isNameOnlyTarget = (targetNameSet_.count(lowerName) > 0);
+            isNameOnlyTarget = targetTables_->names.Contains(lowerName);
         }
 
         if (!resolvedPath.empty()) {
             if (isNameOnlyTarget) {
                 // name-only: proactive had no path, apply full policy now (IFEO idempotent + PT new)
-                RegistryPolicyManager::Instance().ApplyPolicy(lowerName, resolvedPath);
+                os_.policy.ApplyPolicy(lowerName, resolvedPath);
                 LOG_DEBUG(L"[REGISTRY] Name-only policy applied: " + lowerName);
-            } else if (!RegistryPolicyManager::Instance().HasPolicy(resolvedPath)) {
+            } else if (!os_.policy.HasPolicy(resolvedPath)) {
                 // path-based fallback: file didn't exist at startup, apply now
-                RegistryPolicyManager::Instance().ApplyPolicy(lowerName, resolvedPath);
+                os_.policy.ApplyPolicy(lowerName, resolvedPath);
                 LOG_DEBUG(L"[REGISTRY] Path-based fallback policy applied: " + lowerName);
             }
         } else {
             wchar_t diagBuf[256];
             swprintf_s(diagBuf,
-                L"[DIAG] ApplyOptimizationWithHandle: empty path, policy deferred for %s (PID:%lu)",
+                L"[DIAG] ApplyOptimizationWithHandle: empty path, policy deferred for %ls (PID:%u)",
                 name.c_str(), pid);
             LOG_DEBUG(diagBuf);
         }
@@ -2925,7 +3092,7 @@ bool EngineCore::ApplyOptimizationWithHandle(DWORD pid, const std::wstring& name
 
     // Log the optimization with path
     wchar_t optBuf[512];
-    swprintf_s(optBuf, L"[TRACK] %s %s (PID: %lu) Child=%d path=%s",
+    swprintf_s(optBuf, L"[TRACK] %ls %ls (PID: %u) Child=%d path=%ls",
                isChild ? L"[CHILD]" : L"[TARGET]", name.c_str(), pid, isChild ? 1 : 0,
                resolvedPath.empty() ? L"(unresolved)" : resolvedPath.c_str());
     LOG_DEBUG(optBuf);
@@ -2957,16 +3124,18 @@ bool EngineCore::ApplyOptimizationWithHandle(DWORD pid, const std::wstring& name
     tracked->parentPid = parentPid;
     tracked->name = name;
     tracked->fullPath = resolvedPath;  // cached path (empty if unresolved)
-    tracked->needsPolicyRetry = resolvedPath.empty();
     tracked->processHandle = std::move(scopedHandle);
     tracked->isChild = isChild;
-    tracked->phase = ProcessPhase::AGGRESSIVE;
-    tracked->phaseStartTime = now;
-    tracked->lastCheckTime = now;
-    tracked->lastPriorityCheck = now;
-    tracked->violationCount = 0;
     tracked->waitHandle = nullptr;
 
+    TrackedHot hot;
+    hot.needsPolicyRetry = resolvedPath.empty();
+    hot.phase = ProcessPhase::AGGRESSIVE;
+    hot.phaseStartTime = now;
+    hot.lastCheckTime = now;
+    hot.lastPriorityCheck = now;
+    hot.violationCount = 0;
+
     tracked->consecutiveFailures = 0;
     tracked->lastErrorCode = 0;
     tracked->nextRetryTime = 0;
@@ -2977,26 +3146,22 @@ bool EngineCore::ApplyOptimizationWithHandle(DWORD pid, const std::wstring& name
 
     // Register wait for process exit using separate SYNCHRONIZE handle
     // Main handle (0x1200) doesn't have SYNCHRONIZE, so we open another handle
-    HANDLE hWaitProcess = OpenProcess(SYNCHRONIZE, FALSE, pid);
+    // §9.32: skipped when the event source reports exits (OnMonitorProcessExit)
+    platform::NativeHandle hWaitProcess = monitorExitEvents_.load(std::memory_order_relaxed)
+        ? nullptr : os_.process.OpenSynchronize(pid);
     WaitCallbackContext* context = nullptr;
     if (hWaitProcess) {
         context = new WaitCallbackContext{this, pid, tracked};
-        HANDLE waitHandle = nullptr;
-
-        if (RegisterWaitForSingleObject(
-                &waitHandle,
-                hWaitProcess,
-                OnProcessExit,
-                context,
-                INFINITE,
-                WT_EXECUTEONLYONCE)) {
+        platform::NativeHandle waitHandle = nullptr;
+
+        if (os_.process.RegisterExitWait(&waitHandle, hWaitProcess, OnProcessExit, context)) {
             tracked->waitHandle = waitHandle;
-            tracked->waitProcessHandle = MakeScopedHandle(hWaitProcess);
+            tracked->waitProcessHandle = platform::OwnedHandle(os_.process, hWaitProcess);
             waitRegisterCount_.fetch_add(1, std::memory_order_relaxed);
         } else {
             delete context;
             context = nullptr;
-            CloseHandle(hWaitProcess);
+            os_.process.CloseHandle(hWaitProcess);
         }
     }
     // If SYNCHRONIZE fails, process exit will be detected by handle invalidation
@@ -3018,7 +3183,13 @@ bool EngineCore::ApplyOptimizationWithHandle(DWORD pid, const std::wstring& name
             evictList = SelectEvictionCandidates(trackedProcesses_, toEvict);
         }
 
-        trackedProcesses_[pid] = std::move(tracked);
+        // §9.25: PID reuse replacing a STABLE / PERSISTENT entry leaves the snapshot stale
+        auto prev = trackedProcesses_.find(pid);
+        if (prev != trackedProcesses_.end() && AcceptsThreadEvents(prev.hot().phase)) {
+            threadEventTargetsDirty_.store(true, std::memory_order_relaxed);
+        }
+        trackedProcesses_.insert_or_assign(pid, hot, std::move(tracked));
+        trackedPidFilter_.Set(pid);
         if (context) {
             waitContexts_[pid] = context;
         }
@@ -3031,7 +3202,7 @@ bool EngineCore::ApplyOptimizationWithHandle(DWORD pid, const std::wstring& name
         for (DWORD evictPid : evictList) {
             if (evictLogCount.fetch_add(1, std::memory_order_relaxed) < 50) {
                 wchar_t logBuf[128];
-                swprintf_s(logBuf, L"[EVICT] cap reached, evicting PID:%lu", evictPid);
+                swprintf_s(logBuf, L"[EVICT] cap reached, evicting PID:%u", evictPid);
                 LOG_DEBUG(logBuf);
             }
         }
@@ -3066,7 +3237,7 @@ bool EngineCore::ApplyOptimizationWithHandle(DWORD pid, const std::wstring& name
             }
         }
         if (wasEmpty) {
-            SetEvent(hWakeupEvent_);
+            os_.events.SetEvent(hWakeupEvent_);
         }
     }
 
@@ -3081,26 +3252,27 @@ bool EngineCore::ApplyOptimizationWithHandle(DWORD pid, const std::wstring& name
 // Priority 1: invalid processHandle (zombie/terminated).
 // Priority 2: oldest phaseStartTime (longest-resident process).
 DWORD EngineCore::SelectEvictionCandidate() const {
-#ifdef _DEBUG
+#if defined(_DEBUG) && defined(_WIN32)
     assert(IsCSHeldByCurrent(trackedCs_) &&
            "SelectEvictionCandidate() must be called with trackedCs_ held");
 #endif
     if (trackedProcesses_.empty()) return 0;
 
     // Priority 1: zombie (handle already closed)
-    for (const auto& [pid, tp] : trackedProcesses_) {
+    for (const auto& [pid, hot, tp] : trackedProcesses_) {
         if (!tp->processHandle.get()) return pid;
     }
 
-    // Priority 2: oldest phaseStartTime
-    auto it = std::min_element(
-        trackedProcesses_.begin(),
-        trackedProcesses_.end(),
-        [](const auto& a, const auto& b) {
-            return a.second->phaseStartTime < b.second->phaseStartTime;
-        });
-
-    return (it != trackedProcesses_.end()) ? it->first : 0;
+    // Priority 2: oldest phaseStartTime (hot array only)
+    DWORD oldestPid = 0;
+    ULONGLONG oldestStart = ~0ULL;
+    for (const auto& [pid, hot, tp] : trackedProcesses_) {
+        if (hot.phaseStartTime < oldestStart) {
+            oldestStart = hot.phaseStartTime;
+            oldestPid = pid;
+        }
+    }
+    return oldestPid;
 }
 
 void CALLBACK EngineCore::OnProcessExit(PVOID lpParameter, BOOLEAN timerOrWaitFired) {
@@ -3121,41 +3293,49 @@ void CALLBACK EngineCore::OnProcessExit(PVOID lpParameter, BOOLEAN timerOrWaitFi
         ~ConcurrentGuard() { c.fetch_sub(1, std::memory_order_relaxed); }
     } guard(engine->callbackConcurrent_);
 
-    // QPC start — engine->qpcFreq_ を参照: callback内ロックゼロ
-    LARGE_INTEGER qpcStart;
-    QueryPerformanceCounter(&qpcStart);
+    // QPC start — engine->os_.clock 経由: callback内ロックゼロ
+    const ULONGLONG usStart = engine->os_.clock.NowUs();
 
     // 本体 — 例外安全性は設計で保証 (CSLockGuard は RAII, queue::push は noexcept 相当)
+    engine->ForgetProcess(pid);   // §9.37
+    engine->QueueProcessRemoval(pid);
+
+    // 閾値超過時のみログ — 正常パスはゼロコスト
+    const uint64_t elapsedUs = engine->os_.clock.NowUs() - usStart;
+    if (elapsedUs > CALLBACK_LATENCY_WARN_US) {
+        wchar_t buf[128];
+        swprintf_s(buf,
+            L"[CB_SLOW] pid=%u elapsed=%lluus concurrent=%u",
+            pid, static_cast<unsigned long long>(elapsedUs), guard.entered);
+        LOG_DEBUG(buf);
+    }
+}
+
+void EngineCore::QueueProcessRemoval(DWORD pid) {
     bool wasEmpty;
     {
-        CSLockGuard lock(engine->pendingRemovalCs_);
-        wasEmpty = engine->pendingRemovalPids_.empty();
-        engine->pendingRemovalPids_.push(pid);
+        CSLockGuard lock(pendingRemovalCs_);
+        wasEmpty = pendingRemovalPids_.empty();
+        pendingRemovalPids_.push(pid);
     }
-    if (wasEmpty && !engine->stopRequested_.load(std::memory_order_acquire)) {
-        HANDLE h = engine->hWakeupEvent_;
-        if (h) SetEvent(h);
+    if (wasEmpty && !stopRequested_.load(std::memory_order_acquire)) {
+        platform::NativeHandle h = hWakeupEvent_;
+        if (h) os_.events.SetEvent(h);
     }
+}
 
-    // 閾値超過時のみログ — 正常パスはゼロコスト
-    if (engine->qpcFreq_.QuadPart > 0) {
-        LARGE_INTEGER qpcEnd;
-        QueryPerformanceCounter(&qpcEnd);
-        const uint64_t elapsedUs = static_cast<uint64_t>(
-            (qpcEnd.QuadPart - qpcStart.QuadPart) * 1000000LL / engine->qpcFreq_.QuadPart);
-        if (elapsedUs > CALLBACK_LATENCY_WARN_US) {
-            wchar_t buf[128];
-            swprintf_s(buf,
-                L"[CB_SLOW] pid=%lu elapsed=%lluus concurrent=%u",
-                pid, elapsedUs, guard.entered);
-            LOG_DEBUG(buf);
-        }
-    }
+// §9.32: event-source exit (netlink PROC_EVENT_EXIT). Untracked PIDs — nearly every exit on
+// the system — stop at the bitmap; tracked ones take the same removal path as OnProcessExit.
+void EngineCore::OnMonitorProcessExit(DWORD pid) {
+    ForgetProcess(pid);   // §9.37: every exit, before the tracked filter
+    if (!trackedPidFilter_.Test(pid)) return;
+    monitorExitCount_.fetch_add(1, std::memory_order_relaxed);
+    QueueProcessRemoval(pid);
 }
 
 // Safely remove tracked process with proper wait handle cleanup
 void EngineCore::RemoveTrackedProcess(DWORD pid) {
-#ifdef _DEBUG
+#if defined(_DEBUG) && defined(_WIN32)
     {
         DWORD tid = engineControlThreadId_.load(std::memory_order_relaxed);
         assert(tid != 0 &&
@@ -3163,12 +3343,12 @@ void EngineCore::RemoveTrackedProcess(DWORD pid) {
                "Must be called from EngineControlLoop thread");
     }
 #endif
-    HANDLE waitHandleToUnregister  = nullptr;
+    platform::NativeHandle waitHandleToUnregister  = nullptr;
     WaitCallbackContext* contextToDelete   = nullptr;
     DeferredVerifyContext* timerCtxToDelete    = nullptr;
     DeferredVerifyContext* deferredCtxToDelete = nullptr;
-    HANDLE deferredTimerToDelete   = nullptr;
-    HANDLE persistentTimerToDelete = nullptr;
+    platform::NativeHandle deferredTimerToDelete   = nullptr;
+    platform::NativeHandle persistentTimerToDelete = nullptr;
 
     {
         CSLockGuard lock(trackedCs_);
@@ -3176,22 +3356,26 @@ void EngineCore::RemoveTrackedProcess(DWORD pid) {
         auto it = trackedProcesses_.find(pid);
         if (it != trackedProcesses_.end()) {
             // Extract timer handles for deletion outside lock
-            if (it->second->deferredTimer && timerQueue_) {
-                deferredTimerToDelete            = it->second->deferredTimer;
-                deferredCtxToDelete              = it->second->deferredTimerContext;
-                it->second->deferredTimerContext = nullptr;
-                it->second->deferredTimer        = nullptr;
+            if (it.cold()->deferredTimer && timerQueue_) {
+                deferredTimerToDelete            = it.cold()->deferredTimer;
+                deferredCtxToDelete              = it.cold()->deferredTimerContext;
+                it.cold()->deferredTimerContext = nullptr;
+                it.cold()->deferredTimer        = nullptr;
             }
-            if (it->second->persistentTimer && timerQueue_) {
-                persistentTimerToDelete             = it->second->persistentTimer;
-                timerCtxToDelete                    = it->second->persistentTimerContext;
-                it->second->persistentTimerContext  = nullptr;
-                it->second->persistentTimer         = nullptr;
+            if (it.cold()->persistentTimer && timerQueue_) {
+                persistentTimerToDelete             = it.cold()->persistentTimer;
+                timerCtxToDelete                    = it.cold()->persistentTimerContext;
+                it.cold()->persistentTimerContext  = nullptr;
+                it.cold()->persistentTimer         = nullptr;
             }
 
-            waitHandleToUnregister = it->second->waitHandle;
-            it->second->waitHandle = nullptr;
+            waitHandleToUnregister = it.cold()->waitHandle;
+            it.cold()->waitHandle = nullptr;
+            if (AcceptsThreadEvents(it.hot().phase)) {
+                threadEventTargetsDirty_.store(true, std::memory_order_relaxed);
+            }
             trackedProcesses_.erase(it);
+            trackedPidFilter_.Clear(pid);
         }
 
         auto ctxIt = waitContexts_.find(pid);
@@ -3204,21 +3388,21 @@ void EngineCore::RemoveTrackedProcess(DWORD pid) {
     // Delete timers outside lock: INVALID_HANDLE_VALUE blocks until in-flight
     // callback completes, then context is freed — must not hold trackedCs_ here.
     if (deferredTimerToDelete) {
-        if (!DeleteTimerQueueTimer(timerQueue_, deferredTimerToDelete, INVALID_HANDLE_VALUE)) {
-            DWORD err = GetLastError();
+        if (!os_.timers.DeleteTimer(timerQueue_, deferredTimerToDelete, true)) {
+            DWORD err = os_.timers.LastError();
             if (err != ERROR_IO_PENDING) { shutdownWarnings_.fetch_add(1); }
         }
     }
     if (persistentTimerToDelete) {
-        if (!DeleteTimerQueueTimer(timerQueue_, persistentTimerToDelete, INVALID_HANDLE_VALUE)) {
-            DWORD err = GetLastError();
+        if (!os_.timers.DeleteTimer(timerQueue_, persistentTimerToDelete, true)) {
+            DWORD err = os_.timers.LastError();
             if (err != ERROR_IO_PENDING) { shutdownWarnings_.fetch_add(1); }
         }
     }
 
     // Unregister outside lock with INVALID_HANDLE_VALUE to wait for callback completion
     if (waitHandleToUnregister) {
-        if (!UnregisterWaitEx(waitHandleToUnregister, INVALID_HANDLE_VALUE)) {
+        if (!os_.process.UnregisterExitWait(waitHandleToUnregister)) {
             shutdownWarnings_.fetch_add(1);
             waitUnregisterFailures_.fetch_add(1, std::memory_order_relaxed);
         } else {
@@ -3260,14 +3444,19 @@ bool EngineCore::IsTracked(DWORD pid) const {
     return trackedProcesses_.find(pid) != trackedProcesses_.end();
 }
 
-bool EngineCore::IsTargetName(const std::wstring& name) const {
+bool EngineCore::IsTargetName(std::wstring_view name) const {
+    CSLockGuard lock(targetCs_);
+    return targetTables_->names.Contains(name);
+}
+
+bool EngineCore::IsTargetPath(std::wstring_view fullPath) const {
     CSLockGuard lock(targetCs_);
-    return engine_logic::IsTargetProcess(ToLower(name), targetNameSet_);
+    return engine_logic::IsTargetByPath(fullPath, targetTables_->paths, targetTables_->names);
 }
 
-bool EngineCore::IsTargetPath(const std::wstring& fullPathLower) const {
+std::shared_ptr<const TargetTables> EngineCore::SnapshotTargets() const {
     CSLockGuard lock(targetCs_);
-    return engine_logic::IsTargetByPath(fullPathLower, targetPathSet_, targetNameSet_);
+    return targetTables_;
 }
 
 bool EngineCore::HasPathTargets() const {
@@ -3279,86 +3468,25 @@ std::wstring EngineCore::CanonicalizePath(const std::wstring& rawPath) {
     return unleaf::CanonicalizePath(rawPath);
 }
 
-// static
-bool EngineCore::FileExistsW(const std::wstring& path) {
-    DWORD attrs = GetFileAttributesW(path.c_str());
-    return (attrs != INVALID_FILE_ATTRIBUTES);
+bool EngineCore::FileExistsW(const std::wstring& path) const {
+    return os_.process.FileExists(path);
 }
 
-std::wstring EngineCore::ResolveProcessPath(HANDLE hProcess) const {
-    wchar_t rawBuf[MAX_PATH + 1] = {};
-    DWORD rawSize = MAX_PATH;
-    if (!QueryFullProcessImageNameW(hProcess, 0, rawBuf, &rawSize)) {
-        DWORD err = GetLastError();
-        // error=31 (ERROR_GEN_FAILURE): 毎 SafetyNet tick で発生する定常ノイズ — 抑制
-        // error=87 (ERROR_INVALID_PARAMETER): PID 無効化済み (プロセス終了) — 期待値
-        if (err != ERROR_GEN_FAILURE && err != ERROR_INVALID_PARAMETER) {
-            LOG_DEBUG(L"[DIAG] ResolveProcessPath: QueryFullProcessImageNameW failed, error="
-                      + std::to_wstring(err));
-        }
-        return L"";
-    }
-
-    std::wstring rawPath(rawBuf, rawSize);
-
-    // For running processes, use GetFinalPathNameByHandleW for symlink resolution
-    HANDLE hFile = CreateFileW(
-        rawPath.c_str(), 0,
-        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
-        nullptr, OPEN_EXISTING,
-        FILE_FLAG_BACKUP_SEMANTICS, nullptr);
-
-    if (hFile == INVALID_HANDLE_VALUE) {
-        // Process file inaccessible — fall back to CanonicalizePath
-        return CanonicalizePath(rawPath);
-    }
-
-    wchar_t buf[MAX_PATH + 4] = {};
-    DWORD len = GetFinalPathNameByHandleW(
-        hFile, buf, MAX_PATH + 4,
-        FILE_NAME_NORMALIZED | VOLUME_NAME_DOS);
-    CloseHandle(hFile);
-
-    if (len == 0 || len > MAX_PATH) {
-        return CanonicalizePath(rawPath);
-    }
-
-    std::wstring result(buf, len);
-
-    // \\?\UNC\server\share -> \\server\share
-    if (result.size() >= 8 &&
-        result[0] == L'\\' && result[1] == L'\\' &&
-        result[2] == L'?'  && result[3] == L'\\' &&
-        (result[4] == L'U' || result[4] == L'u') &&
-        (result[5] == L'N' || result[5] == L'n') &&
-        (result[6] == L'C' || result[6] == L'c') &&
-        result[7] == L'\\') {
-        result = L"\\\\" + result.substr(8);
-    }
-    // \\?\ -> remove prefix
-    else if (result.size() >= 4 &&
-             result[0] == L'\\' && result[1] == L'\\' &&
-             result[2] == L'?'  && result[3] == L'\\') {
-        result = result.substr(4);
-    }
-
-    // Lowercase
-    for (auto& ch : result) ch = towlower(ch);
-
-    return result;
+// QueryFullProcessImageNameW + GetFinalPathNameByHandleW (symlink resolution),
+// \\?\ prefix stripped, lowercase — implemented by the platform layer
+std::wstring EngineCore::ResolveProcessPath(platform::NativeHandle hProcess) const {
+    return os_.process.ResolveImagePath(hProcess);
 }
 
 void EngineCore::TryApplyByPath(DWORD pid, const std::wstring& name) {
     if (IsTracked(pid)) return;
-    if (IsCriticalProcess(name)) return;
+    if (IsCriticalImage(name)) return;
 
-    DWORD access = PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_SET_INFORMATION;
-    HANDLE hProc = OpenProcess(access, FALSE, pid);
-    if (!hProc) {
+    platform::OwnedHandle scoped(os_.process, os_.process.OpenControl(pid));
+    if (!scoped) {
         LOG_DEBUG(L"[PATH] TryApplyByPath: OpenProcess failed for " + name);
         return;
     }
-    ScopedHandle scoped = MakeScopedHandle(hProc);
 
     std::wstring resolvedPath = ResolveProcessPath(scoped.get());
     if (!resolvedPath.empty()) {
@@ -3372,13 +3500,12 @@ void EngineCore::TryApplyByPath(DWORD pid, const std::wstring& name) {
     if (!IsTargetPath(resolvedPath)) {
         // Symlink/junction で CanonicalizePath と GetFinalPathNameByHandleW が
         // 異なるパスを返す場合のフォールバック。
-        // ファイル名が pathTargetFileNames_ に含まれていれば続行。
+        // ファイル名が pathFileNames テーブルに含まれていれば続行。
         // HasPolicy fallback in ApplyOptimizationWithHandle が正しいパスで PT を作成する。
-        std::wstring lowerName = ToLower(name);
         bool fileNameMatch = false;
         {
             CSLockGuard lock(targetCs_);
-            fileNameMatch = (pathTargetFileNames_.count(lowerName) > 0);
+            fileNameMatch = targetTables_->pathFileNames.Contains(name);
         }
         if (!fileNameMatch) return;
         LOG_DEBUG(L"[PATH] TryApplyByPath: exact path mismatch, filename fallback: " + resolvedPath);
@@ -3395,6 +3522,38 @@ bool EngineCore::IsTrackedParent(DWORD parentPid) const {
     return it != trackedProcesses_.end();
 }
 
+DWORD EngineCore::FindTrackedAncestor(DWORD pid, DWORD parentPid) const {
+    DWORD chain[PROCESS_TREE_ANCESTOR_DEPTH];
+    size_t depth;
+    {
+        CSLockGuard lock(treeCs_);
+        depth = CollectAncestorsLocked(pid, chain);
+    }
+    CSLockGuard lock(trackedCs_);
+    if (trackedProcesses_.find(parentPid) != trackedProcesses_.end()) return parentPid;
+    for (size_t k = 0; k < depth; ++k) {
+        if (trackedProcesses_.find(chain[k]) != trackedProcesses_.end()) return chain[k];
+    }
+    return 0;
+}
+
+size_t EngineCore::CollectAncestorsLocked(DWORD pid, DWORD* out) const {
+    size_t depth = 0;
+    const engine_logic::ProcessTree::Node* node = processTree_.Find(pid);
+    while (node && node->linked && depth < PROCESS_TREE_ANCESTOR_DEPTH) {
+        const DWORD up = node->parentPid;
+        node = processTree_.Find(up);
+        if (!node || node->critical) break;
+        out[depth++] = up;
+    }
+    return depth;
+}
+
+void EngineCore::ForgetProcess(DWORD pid) {
+    CSLockGuard lock(treeCs_);
+    processTree_.Remove(pid);
+}
+
 void EngineCore::RefreshTargetSet() {
     // Collect path targets outside the lock
     struct ResolvedEntry {
@@ -3413,7 +3572,7 @@ void EngineCore::RefreshTargetSet() {
                 if (norm.empty()) {
                     wchar_t logBuf[512];
                     swprintf_s(logBuf,
-                               L"[REGISTRY] Target path canonicalization failed, skipping: %s",
+                               L"[REGISTRY] Target path canonicalization failed, skipping: %ls",
                                target.name.c_str());
                     LOG_ALERT(logBuf);
                 } else {
@@ -3428,21 +3587,31 @@ void EngineCore::RefreshTargetSet() {
         }
     }
 
-    // Update sets under lock
-    CSLockGuard lock(targetCs_);
-    targetNameSet_.clear();
-    targetPathSet_.clear();
-    pathTargetFileNames_.clear();
-
-    for (auto& name : nameEntries) {
-        targetNameSet_.insert(std::move(name));
-    }
+    // Compile the tables outside the lock, then swap the pointer
+    std::vector<std::wstring> paths;
+    std::vector<std::wstring> pathFileNames;
+    paths.reserve(pathEntries.size());
+    pathFileNames.reserve(pathEntries.size());
     for (auto& e : pathEntries) {
-        targetPathSet_.insert(e.normalized);
-        pathTargetFileNames_.insert(e.fileName);
+        paths.push_back(std::move(e.normalized));
+        pathFileNames.push_back(std::move(e.fileName));
     }
 
-    hasPathTargets_.store(!targetPathSet_.empty(), std::memory_order_release);
+    auto tables = std::make_shared<TargetTables>();
+    tables->names         = engine_logic::TargetMatcher(nameEntries);
+    tables->paths         = engine_logic::TargetMatcher(paths);
+    tables->pathFileNames = engine_logic::TargetMatcher(pathFileNames);
+    const bool hasPaths   = !tables->paths.empty();
+
+    std::shared_ptr<const TargetTables> old;
+    {
+        CSLockGuard lock(targetCs_);
+        tables->generation = targetTables_->generation + 1;   // §9.40: invalidates NonTargetCache
+        old = std::move(targetTables_);
+        targetTables_ = std::move(tables);
+    }
+    hasPathTargets_.store(hasPaths, std::memory_order_release);
+    // `old` released outside targetCs_
 }
 
 void EngineCore::ApplyProactivePolicies() {
@@ -3470,26 +3639,26 @@ void EngineCore::ApplyProactivePolicies() {
                 // NOTE: IFEO is exe-name-based and applies globally to ALL instances of this exe name,
                 // not just the specific path. This is by design — IFEO operates at the OS level
                 // per executable name. Path-specific differentiation is handled by PowerThrottle only.
-                RegistryPolicyManager::Instance().ApplyPolicy(lowerName, resolved);
+                os_.policy.ApplyPolicy(lowerName, resolved);
                 desiredPaths.insert(resolved);
             } else {
                 // File does not exist (not yet installed, portable app not plugged in, etc.)
                 // Apply IFEO only — PowerThrottle requires a valid path in registry.
                 // Full policy will be applied via ETW fallback (修正③) when the process starts.
-                RegistryPolicyManager::Instance().ApplyIFEOOnly(lowerName);
+                os_.policy.ApplyIFEOOnly(lowerName);
                 LOG_ALERT(L"[REGISTRY] Proactive: file not found, IFEO only: " + resolved);
             }
             desiredNames.insert(lowerName);
         } else {
             // Name-only target: apply IFEO only (no path for PowerThrottle)
             std::wstring lowerName = ToLower(target.name);
-            RegistryPolicyManager::Instance().ApplyIFEOOnly(lowerName);
+            os_.policy.ApplyIFEOOnly(lowerName);
             desiredNames.insert(lowerName);
         }
     }
 
     // Reconcile: remove policies no longer in config
-    RegistryPolicyManager::Instance().ReconcileWithConfig(desiredNames, desiredPaths);
+    os_.policy.ReconcileWithConfig(desiredNames, desiredPaths);
 
     wchar_t buf[128];
     swprintf_s(buf, L"[REGISTRY] Proactive policies applied: %zu names + %zu paths",
@@ -3499,15 +3668,8 @@ void EngineCore::ApplyProactivePolicies() {
 
 void EngineCore::CleanupRemovedTargets() {
     // Get current valid targets
-    std::set<std::wstring> localNameTargets;
-    std::set<std::wstring> localPathTargets;
-    bool pathTargetsActive = false;
-    {
-        CSLockGuard lock(targetCs_);
-        localNameTargets  = targetNameSet_;
-        localPathTargets  = targetPathSet_;
-        pathTargetsActive = !localPathTargets.empty();
-    }
+    std::shared_ptr<const TargetTables> targets = SnapshotTargets();
+    const bool pathTargetsActive = !targets->paths.empty();
 
     // Collect PIDs of root targets that are no longer in the target list
     std::vector<DWORD> toRemove;
@@ -3516,14 +3678,14 @@ void EngineCore::CleanupRemovedTargets() {
         CSLockGuard lock(trackedCs_);
 
         // Collect processes to remove
-        for (const auto& [pid, tp] : trackedProcesses_) {
+        for (const auto& [pid, hot, tp] : trackedProcesses_) {
             bool shouldRemove = false;
 
             if (tp->isChild) {
                 // Parent still alive -> do not remove
                 bool parentAlive = trackedProcesses_.find(tp->parentPid) != trackedProcesses_.end();
                 // Process itself is a target name -> never remove
-                bool selfIsTarget = IsTargetName(tp->name);
+                bool selfIsTarget = targets->names.Contains(tp->name);
 
                 if (!parentAlive && !selfIsTarget) {
                     shouldRemove = true;
@@ -3532,12 +3694,11 @@ void EngineCore::CleanupRemovedTargets() {
                 // Root process validity check
                 if (!tp->fullPath.empty() && pathTargetsActive) {
                     // Path-resolved process: path match is the sole criterion (path-absolute priority)
-                    bool pathMatch = (localPathTargets.count(tp->fullPath) > 0);
+                    bool pathMatch = targets->paths.Contains(tp->fullPath);
                     if (!pathMatch) shouldRemove = true;
                 } else {
                     // No resolved path or no path targets: fall back to name match
-                    std::wstring lowerName = ToLower(tp->name);
-                    if (localNameTargets.find(lowerName) == localNameTargets.end()) {
+                    if (!targets->names.Contains(tp->name)) {
                         shouldRemove = true;
                     }
                 }
@@ -3566,6 +3727,58 @@ size_t EngineCore::GetActiveProcessCount() const {
     return trackedProcesses_.size();
 }
 
+engine_logic::EnginePolicy EngineCore::DefaultPolicy() {
+    return engine_logic::EnginePolicy{
+        VIOLATION_THRESHOLD,
+        static_cast<uint64_t>(ECOQOS_CACHE_DURATION),
+        static_cast<uint32_t>(DEFERRED_VERIFY_1),
+        static_cast<uint32_t>(DEFERRED_VERIFY_2),
+        static_cast<uint32_t>(DEFERRED_VERIFY_FINAL)
+    };
+}
+
+void EngineCore::SetPolicy(const engine_logic::EnginePolicy& policy) {
+    policy_ = policy;
+}
+
+size_t EngineCore::GetQueueDepth() const {
+    return requestQueue_.Size();
+}
+
+// §9.35: CMD_GET_STATS telemetry block
+StatsTelemetry EngineCore::GetStatsTelemetry() const {
+    static_assert(STATS_RATE_BINS == engine_logic::RateHistogram::BINS, "wire bins must match RateHistogram");
+    static_assert(STATS_REQUEST_TYPES == static_cast<size_t>(EnforcementRequestType::SAFETY_NET) + 1,
+                  "one enqueue histogram per EnforcementRequestType");
+
+    const ULONGLONG now = os_.clock.NowMs();
+    auto copy = [now](const engine_logic::RateHistogram& rate, StatsRateHistogram& out) {
+        const engine_logic::RateHistogram::Snapshot snap = rate.Read(now);
+        out.total = snap.total;
+        out.lastSecond = snap.lastSecond;
+        out.peakPerSecond = snap.peakPerSecond;
+        for (uint32_t i = 0; i < STATS_RATE_BINS; ++i) out.seconds[i] = snap.seconds[i];
+    };
+
+    StatsTelemetry t = {};
+    t.version = STATS_TELEMETRY_VERSION;
+    t.size = static_cast<uint32_t>(sizeof(StatsTelemetry));
+    t.uptimeMs = (startTime_ > 0) ? (now - startTime_) : 0;
+    copy(processStartRate_, t.processStarts);
+    copy(threadStartRate_, t.threadStarts);
+    for (uint32_t i = 0; i < STATS_REQUEST_TYPES; ++i) copy(enqueueRate_[i], t.enqueued[i]);
+    copy(dropRate_, t.dropped);
+    copy(evictRate_, t.evicted);
+    t.criticalQueue = {static_cast<uint32_t>(requestQueue_.CriticalSize()),
+                       static_cast<uint32_t>(requestQueue_.CriticalHighWater()),
+                       static_cast<uint32_t>(ENFORCEMENT_QUEUE_HARD_LIMIT)};
+    t.nonCriticalQueue = {static_cast<uint32_t>(requestQueue_.NonCriticalSize()),
+                          static_cast<uint32_t>(requestQueue_.NonCriticalHighWater()),
+                          static_cast<uint32_t>(ENFORCEMENT_QUEUE_SOFT_LIMIT)};
+    t.totalLimit = static_cast<uint32_t>(ENFORCEMENT_QUEUE_TOTAL_LIMIT);
+    return t;
+}
+
 // Health check info
 HealthInfo EngineCore::GetHealthInfo() const {
     HealthInfo info = {};  // zero-initialize all fields
@@ -3575,13 +3788,13 @@ HealthInfo EngineCore::GetHealthInfo() const {
     info.totalViolations = totalViolations_.load();
     info.etwHealthy = processMonitor_.IsHealthy();
     info.etwEventCount = processMonitor_.GetEventCount();
-    info.uptimeMs = (startTime_ > 0) ? (GetTickCount64() - startTime_) : 0;
+    info.uptimeMs = (startTime_ > 0) ? (os_.clock.NowMs() - startTime_) : 0;
 
     // Phase breakdown + active process details
     {
         CSLockGuard lock(trackedCs_);
-        for (const auto& [pid, tp] : trackedProcesses_) {
-            switch (tp->phase) {
+        for (const auto& [pid, hot, tp] : trackedProcesses_) {
+            switch (hot.phase) {
                 case ProcessPhase::AGGRESSIVE: info.aggressiveCount++; break;
                 case ProcessPhase::STABLE:     info.stableCount++; break;
                 case ProcessPhase::PERSISTENT: info.persistentCount++; break;
@@ -3590,12 +3803,12 @@ HealthInfo EngineCore::GetHealthInfo() const {
             ActiveProcessDetail detail;
             detail.pid = tp->pid;
             detail.name = tp->name;
-            switch (tp->phase) {
+            switch (hot.phase) {
                 case ProcessPhase::AGGRESSIVE: detail.phase = "AGGRESSIVE"; break;
                 case ProcessPhase::STABLE:     detail.phase = "STABLE"; break;
                 case ProcessPhase::PERSISTENT: detail.phase = "PERSISTENT"; break;
             }
-            detail.violations = tp->violationCount;
+            detail.violations = hot.violationCount;
             detail.isChild = tp->isChild;
             info.activeProcessDetails.push_back(std::move(detail));
         }
@@ -3633,9 +3846,42 @@ HealthInfo EngineCore::GetHealthInfo() const {
     // Config monitoring
     info.configChangeDetected = configChangeDetected_.load();
     info.configReloadCount = configReloadCount_.load();
+    info.configReloadSkipped = configReloadSkipped_.load();
 
     // Queue optimization
     info.etwThreadDeduped = etwThreadDeduped_.load(std::memory_order_relaxed);
+    info.etwProcessBatches = processStartBatches_.load(std::memory_order_relaxed);
+    info.dispatchCommitConflicts = dispatchCommitConflicts_.load(std::memory_order_relaxed);
+
+    // Queue saturation (§9.14-A)
+    info.enforcementDropCount = enforcementDropCount_.load(std::memory_order_relaxed);
+    info.criticalDropCount = criticalDropCount_.load(std::memory_order_relaxed);
+    info.criticalEvictCount = criticalEvictCount_.load(std::memory_order_relaxed);
+
+    // Thread-start prefilter (§9.28)
+    const platform::ThreadEventFilterStats filter = processMonitor_.GetThreadEventFilterStats();
+    info.etwThreadFiltered = filter.filtered;
+    info.etwThreadForwarded = filter.forwarded;
+    info.etwThreadFilteredPerSec = filter.filteredPerSec;
+    info.etwThreadForwardedPerSec = filter.forwardedPerSec;
+    info.lossRescans = lossRescanCount_.load(std::memory_order_relaxed);
+    info.lossRescanEntries = lossRescanEntries_.load(std::memory_order_relaxed);
+    {
+        CSLockGuard lock(treeCs_);
+        info.processTreeNodes = static_cast<uint32_t>(processTree_.Size());
+    }
+    info.processTreeRepairs = processTreeRepairs_.load(std::memory_order_relaxed);
+    info.ancestorAdmits = ancestorAdmitCount_.load(std::memory_order_relaxed);
+    info.snapshotCaptures = snapshotCaptures_.load(std::memory_order_relaxed);
+    info.snapshotReuses = snapshotReuses_.load(std::memory_order_relaxed);
+    info.threadWalkFallbacks = threadWalkFallbacks_.load(std::memory_order_relaxed);
+    info.etwThreadScoped = etwThreadScoped_.load(std::memory_order_relaxed);
+    info.nonTargetCacheHits = nonTargetCacheHits_.load(std::memory_order_relaxed);
+    info.nonTargetCacheEntries = nonTargetCacheEntries_.load(std::memory_order_relaxed);
+
+    // Interned strings (§9.30)
+    info.internedStrings = static_cast<uint32_t>(engine_logic::StringInternTable::Instance().LiveCount());
+    info.internedBytes = engine_logic::StringInternTable::Instance().LiveBytes();
 
     // Last enforcement timestamp
     info.lastEnforceTimeMs = lastEnforceTimeMs_.load(std::memory_order_relaxed);
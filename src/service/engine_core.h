@@ -5,10 +5,16 @@
 #include "../common/scoped_handle.h"
 #include "../common/config.h"
 #include "../common/logger.h"
-#include "process_monitor.h"
-#include "../common/registry_manager.h"
 #include "../engine/engine_logic.h"
-#include <tlhelp32.h>
+#include "../engine/non_target_cache.h"
+#include "../engine/pid_bitmap.h"
+#include "../engine/pid_table.h"
+#include "../engine/process_tree.h"
+#include "../engine/rate_histogram.h"
+#include "../engine/rcu_snapshot.h"
+#include "../engine/string_intern.h"
+#include "../platform/platform.h"
+#include "enforcement_queue.h"
 #include <map>
 #include <set>
 #include <list>
@@ -22,46 +28,25 @@
 #include <utility>
 #include <chrono>
 #include <string>
+#include <string_view>
 
 // Linker-level guard against accidental timeBeginPeriod usage
+#ifdef _MSC_VER
 #pragma detect_mismatch("UnLeaf_NoHighResTimer", "enforced")
+#endif
+
+class EngineCoreTest;
+class UnLeafBenchAccess;
 
 namespace unleaf {
 
 // Process monitoring phase — imported from engine_logic (pure C++ module)
 using ProcessPhase = engine_logic::ProcessPhase;
 
-// Enforcement request type (queued from ETW callbacks and timers)
-enum class EnforcementRequestType : uint8_t {
-    ETW_PROCESS_START,       // New target process detected via ETW
-    ETW_THREAD_START,        // Thread created in tracked process (EcoQoS trigger)
-    DEFERRED_VERIFICATION,   // Timer-based verification during AGGRESSIVE phase
-    PERSISTENT_ENFORCE,      // Periodic enforcement for PERSISTENT phase
-    SAFETY_NET               // Insurance consistency check (not monitoring)
-};
-
-// Enforcement request structure (queued for processing by EngineControlLoop)
-struct EnforcementRequest {
-    DWORD pid;
-    EnforcementRequestType type;
-    uint8_t verifyStep;      // For DEFERRED_VERIFICATION: 1=200ms, 2=1s, 3=3s
-    DWORD parentPid;         // ETW_PROCESS_START: parent PID (0 if none)
-    std::wstring imageName;  // ETW_PROCESS_START: process image name
-    std::wstring imagePath;  // ETW_PROCESS_START: full image path
-
-    EnforcementRequest() : pid(0), type(EnforcementRequestType::ETW_PROCESS_START),
-                           verifyStep(0), parentPid(0) {}
-    EnforcementRequest(DWORD p, EnforcementRequestType t, uint8_t step = 0)
-        : pid(p), type(t), verifyStep(step), parentPid(0) {}
-    EnforcementRequest(DWORD p, DWORD parent, const std::wstring& name, const std::wstring& path)
-        : pid(p), type(EnforcementRequestType::ETW_PROCESS_START),
-          verifyStep(0), parentPid(parent), imageName(name), imagePath(path) {}
-};
-
 // Wait handle indices for WaitForMultipleObjects
 enum WaitIndex : DWORD {
     WAIT_STOP = 0,               // stopEvent_ - service stop signal
-    WAIT_CONFIG_CHANGE = 1,      // configChangeHandle_ - FindFirstChangeNotification
+    WAIT_CONFIG_CHANGE = 1,      // configChangeHandle_ - UnLeaf.ini change (§9.34)
     WAIT_SAFETY_NET = 2,         // safetyNetTimer_ - Waitable Timer (10s)
     WAIT_ENFORCEMENT_REQUEST = 3, // enforcementRequestEvent_ - queue has items
     WAIT_PROCESS_EXIT = 4,       // hWakeupEvent_ - process exit pending removal
@@ -129,9 +114,38 @@ struct HealthInfo {
     // Config monitoring
     uint32_t configChangeDetected;
     uint32_t configReloadCount;
+    uint32_t configReloadSkipped;        // §9.34: same content hash as the loaded file
 
     // Queue optimization
     uint32_t etwThreadDeduped;
+    uint32_t etwProcessBatches;          // §9.29: ProcessStart batches delivered by the monitor
+    uint32_t dispatchCommitConflicts;    // §9.21: stale plans dropped at commit
+
+    // Queue saturation (§9.14-A)
+    uint32_t enforcementDropCount;       // NON-CRITICAL dropped / evicted
+    uint32_t criticalDropCount;          // CRITICAL dropped at HARD_LIMIT
+    uint32_t criticalEvictCount;         // oldest CRITICAL evicted at TOTAL_LIMIT
+
+    // Thread-start PID prefilter (§9.28): events rejected / forwarded by the monitor
+    uint64_t etwThreadFiltered;
+    uint64_t etwThreadForwarded;
+    uint32_t etwThreadFilteredPerSec;    // last completed second
+    uint32_t etwThreadForwardedPerSec;
+    uint32_t lossRescans;                // §9.36: rescans run on loss evidence
+    uint32_t lossRescanEntries;          // processes they examined
+    uint32_t processTreeNodes;           // §9.37: processes in the tree
+    uint32_t processTreeRepairs;         // nodes inserted / removed by reconciliation
+    uint32_t ancestorAdmits;             // starts admitted through a tracked non-parent ancestor
+    uint32_t snapshotCaptures;           // §9.38: process + thread snapshots taken (one per tick at most)
+    uint32_t snapshotReuses;             // later consumers in the same tick served without a capture
+    uint32_t threadWalkFallbacks;        // thread throttling outside any snapshot (per-process walk)
+    uint32_t etwThreadScoped;            // §9.39: thread-event enforcements applied to the new thread only
+    uint32_t nonTargetCacheHits;         // §9.40: SafetyNet scan entries skipped as known non-targets
+    uint32_t nonTargetCacheEntries;      // cache size after the last scan
+
+    // Interned image names / paths (§9.30, process-wide)
+    uint32_t internedStrings;
+    uint64_t internedBytes;
 
     // Last enforcement timestamp (Unix Epoch milliseconds, system_clock based)
     uint64_t lastEnforceTimeMs;
@@ -140,53 +154,59 @@ struct HealthInfo {
     std::vector<ActiveProcessDetail> activeProcessDetails;
 };
 
-// Windows version information for compatibility
-struct WindowsVersionInfo {
-    DWORD major;
-    DWORD minor;
-    DWORD build;
-    bool isWindows11OrLater;  // Build >= 22000
-
-    WindowsVersionInfo() : major(0), minor(0), build(0), isWindows11OrLater(false) {}
-};
-
 // Forward declaration for wait callback context
 struct WaitCallbackContext;
 
-// NtSetInformationProcess function pointer type
-typedef NTSTATUS(NTAPI* PFN_NtSetInformationProcess)(
-    HANDLE ProcessHandle,
-    ULONG ProcessInformationClass,
-    PVOID ProcessInformation,
-    ULONG ProcessInformationLength
-);
-
-// NtQueryInformationProcess function pointer type (for diagnostics)
-typedef NTSTATUS(NTAPI* PFN_NtQueryInformationProcess)(
-    HANDLE ProcessHandle,
-    ULONG ProcessInformationClass,
-    PVOID ProcessInformation,
-    ULONG ProcessInformationLength,
-    PULONG ReturnLength
-);
-
-// Tracked process information
-struct TrackedProcess {
-    DWORD pid;
-    DWORD parentPid;
-    std::wstring name;
-    std::wstring fullPath;            // Normalized absolute path (GetFinalPathNameByHandleW); empty if unresolved
-    ScopedHandle processHandle;       // Control handle (0x1200)
-    ScopedHandle waitProcessHandle;   // Exit detection handle (SYNCHRONIZE)
-    HANDLE waitHandle;                // RegisterWaitForSingleObject handle
-    bool isChild;
+// Job Object tracking (job handle owned through the platform layer)
+struct JobObjectInfo {
+    platform::OwnedHandle jobHandle;
+    DWORD rootPid = 0;
+    bool isOwnJob = false;    // true if we created it
+};
 
+// §9.24: Hot per-process state, stored contiguously in trackedProcesses_ (PidTable SoA).
+// Lookup / sweep paths (SafetyNet, eviction) read only this array.
+// Guarded by trackedCs_; slots move on insert/erase — never keep a pointer across unlock.
+struct TrackedHot {
     // Phase-based enforcement
-    ProcessPhase phase;           // Current monitoring phase
     ULONGLONG phaseStartTime;     // When current phase started
     ULONGLONG lastCheckTime;      // Last EcoQoS check time
     ULONGLONG lastPriorityCheck;  // Last priority check time
+    ULONGLONG lastViolationTime;  // Last violation timestamp (0 = never)
+
+    // ETW boost for PERSISTENT phase (rate-limited instant response)
+    ULONGLONG lastEtwEnforceTime; // Last ETW-triggered enforce time (for rate limiting)
+
+    // EcoQoS state micro-cache (reduces NtQueryInformationProcess calls during burst)
+    ULONGLONG ecoQosCacheTime;    // Cache timestamp
+
+    // §9.21: Bumped on every committed dispatch / external phase change.
+    // DispatchEnforcementRequest drops its commit when this moved while kernel I/O ran unlocked.
+    uint64_t stateVersion;
+
     uint32_t violationCount;      // EcoQoS re-enablement count
+    ProcessPhase phase;           // Current monitoring phase
+    bool ecoQosCached;            // Cache valid flag
+    bool ecoQosCachedValue;       // Cached EcoQoS state
+    bool needsPolicyRetry;        // true = fullPath unresolved at tracking time, SafetyNet will retry
+
+    TrackedHot()
+        : phaseStartTime(0), lastCheckTime(0), lastPriorityCheck(0), lastViolationTime(0)
+        , lastEtwEnforceTime(0), ecoQosCacheTime(0), stateVersion(0), violationCount(0)
+        , phase(ProcessPhase::AGGRESSIVE)
+        , ecoQosCached(false), ecoQosCachedValue(false), needsPolicyRetry(false) {}
+};
+
+// Tracked process information (cold: names, paths, handles, timers — out of line)
+struct TrackedProcess {
+    DWORD pid;
+    DWORD parentPid;
+    engine_logic::InternedString name;       // §9.30: shared by every process with the same image
+    engine_logic::InternedString fullPath;   // Normalized absolute path (GetFinalPathNameByHandleW); empty if unresolved
+    platform::OwnedHandle processHandle;       // Control handle (0x1200)
+    platform::OwnedHandle waitProcessHandle;   // Exit detection handle (SYNCHRONIZE)
+    HANDLE waitHandle;                // RegisterWaitForSingleObject handle
+    bool isChild;
 
     // Self-healing
     uint8_t consecutiveFailures;
@@ -198,39 +218,24 @@ struct TrackedProcess {
     bool inJobObject;
     bool jobAssignmentFailed;
 
-    ULONGLONG lastViolationTime;     // Last violation timestamp (0 = never)
-
-    // ETW boost for PERSISTENT phase (rate-limited instant response)
-    ULONGLONG lastEtwEnforceTime;    // Last ETW-triggered enforce time (for rate limiting)
-
-    // EcoQoS state micro-cache (reduces NtQueryInformationProcess calls during burst)
-    bool ecoQosCached;               // Cache valid flag
-    bool ecoQosCachedValue;          // Cached EcoQoS state
-    ULONGLONG ecoQosCacheTime;       // Cache timestamp
-
     // Timer handles for deferred verification and persistent enforcement
     HANDLE deferredTimer;            // AGGRESSIVE phase deferred verification timer
     HANDLE persistentTimer;          // PERSISTENT phase periodic enforcement timer
     DeferredVerifyContext* persistentTimerContext;  // Recurring timer context (owned pointer)
     DeferredVerifyContext* deferredTimerContext;    // One-shot timer context (owned pointer)
 
-    bool needsPolicyRetry;               // true = fullPath unresolved at tracking time, SafetyNet will retry
-
     TrackedProcess()
         : pid(0), parentPid(0), fullPath(), waitHandle(nullptr), isChild(false)
-        , phase(ProcessPhase::AGGRESSIVE), phaseStartTime(0)
-        , lastCheckTime(0), lastPriorityCheck(0), violationCount(0)
         , consecutiveFailures(0), lastErrorCode(0), nextRetryTime(0)
         , rootTargetPid(0), inJobObject(false), jobAssignmentFailed(false)
-        , lastViolationTime(0)
-        , lastEtwEnforceTime(0)
-        , ecoQosCached(false), ecoQosCachedValue(false), ecoQosCacheTime(0)
         , deferredTimer(nullptr), persistentTimer(nullptr)
         , persistentTimerContext(nullptr)
-        , deferredTimerContext(nullptr)
-        , needsPolicyRetry(false) {}
+        , deferredTimerContext(nullptr) {}
 };
 
+// §9.24: PID -> (TrackedHot, TrackedProcess). Protected by EngineCore::trackedCs_.
+using TrackedTable = engine_logic::PidTable<TrackedHot, std::shared_ptr<TrackedProcess>>;
+
 // Deferred verification timer context (defined after TrackedProcess for shared_ptr)
 struct DeferredVerifyContext {
     class EngineCore* engine;
@@ -239,16 +244,42 @@ struct DeferredVerifyContext {
     std::shared_ptr<TrackedProcess> process;  // prevent premature destruction
 };
 
+// Compiled target lists (immutable once built; RefreshTargetSet swaps the whole table).
+// Lookups are case-folding and allocation-free on std::wstring_view.
+struct TargetTables {
+    engine_logic::TargetMatcher names;          // exe names (name-only targets)
+    engine_logic::TargetMatcher paths;          // CanonicalizePath-normalized full paths
+    engine_logic::TargetMatcher pathFileNames;  // exe name part of each path target (pre-filter)
+    uint32_t generation = 0;                    // §9.40: +1 per RefreshTargetSet
+};
+
+// How EngineControlLoop is driven
+enum class ControlLoopMode : uint8_t {
+    OWN_THREAD,      // Start() spawns the control thread (service)
+    CALLER_PUMPED    // caller drives RunControlLoopOnce() (tests / simulator)
+};
+
 class EngineCore {
 public:
-    // Singleton access
+#ifdef _WIN32
+    // Singleton access (service process, bound to NativePlatform())
     static EngineCore& Instance();
+#endif
+
+    // All OS access goes through os (Win32 in the service, FakePlatform in tests)
+    explicit EngineCore(platform::Platform& os);
+    ~EngineCore();
 
     // Initialize engine with base directory
     bool Initialize(const std::wstring& baseDir);
 
     // Start all monitoring threads
-    void Start();
+    void Start(ControlLoopMode mode = ControlLoopMode::OWN_THREAD);
+
+    // One control-loop iteration: wait (up to timeoutMs) for one event and handle it.
+    // Returns false when stop was signaled or the wait failed.
+    // CALLER_PUMPED mode only; WAIT_TIMEOUT still runs debounce + periodic maintenance.
+    bool RunControlLoopOnce(DWORD timeoutMs);
 
     // Stop all monitoring
     void Stop();
@@ -262,18 +293,29 @@ public:
     // Get health check info
     HealthInfo GetHealthInfo() const;
 
+    // Override phase/verification timings (simulator / tests). Call before Start().
+    void SetPolicy(const engine_logic::EnginePolicy& policy);
+    // Production timings (the constants below)
+    static engine_logic::EnginePolicy DefaultPolicy();
+
+    // Current enforcement queue depth (CRITICAL + NON-CRITICAL)
+    size_t GetQueueDepth() const;
+
+    // §9.35: event / enqueue / drop rate histograms and queue high-water marks (CMD_GET_STATS)
+    StatsTelemetry GetStatsTelemetry() const;
+
 private:
-    EngineCore();
-    ~EngineCore();
+    friend class ::EngineCoreTest;
+    friend class ::UnLeafBenchAccess;
+
     EngineCore(const EngineCore&) = delete;
     EngineCore& operator=(const EngineCore&) = delete;
 
     // === Event-Driven Architecture ===
 
-    // ETW callback: called immediately when a process starts (~1ms)
-    // imagePath: full path hint from ETW (may be empty/8.3/device-format — hint only)
-    void OnProcessStart(DWORD pid, DWORD parentPid,
-                        const std::wstring& imageName, const std::wstring& imagePath);
+    // ETW callback: process starts, one batch per delivered ETW buffer (§9.29)
+    // ImagePath(i): full path hint from ETW (may be empty/8.3/device-format — hint only)
+    void OnProcessStartBatch(const engine_logic::ProcessStartBatch& batch);
 
     // ETW callback for thread creation events (triggers for tracked processes)
     void OnThreadStart(DWORD threadId, DWORD ownerPid);
@@ -282,8 +324,15 @@ private:
     // Waits on: stopEvent, configChangeHandle, safetyNetTimer, enforcementRequestEvent
     void EngineControlLoop();
 
+    // Final drain of pendingRemovalPids_ at loop exit (no cap — service stopping)
+    void DrainPendingRemovalsFinal();
+
     // Enqueue an enforcement request (called from ETW callbacks and timers)
-    void EnqueueRequest(const EnforcementRequest& req);
+    // Returns false when the request was dropped (queue limits)
+    bool EnqueueRequest(const EnforcementRequest& req);
+    // Admission + drop/evict accounting without the consumer wakeup (batch producers
+    // signal once when any push reported wasEmpty)
+    bool AdmitRequest(const EnforcementRequest& req, bool& wasEmpty);
 
     // Process all queued enforcement requests
     void ProcessEnforcementQueue();
@@ -291,6 +340,33 @@ private:
     // Dispatch a single enforcement request
     void DispatchEnforcementRequest(const EnforcementRequest& req);
 
+    // §9.21: Dispatch phases — Plan/Commit hold trackedCs_, Execute/Effects never do
+    struct DispatchPlan {
+        std::shared_ptr<TrackedProcess> process;   // keeps processHandle open while unlocked
+        platform::NativeHandle hProcess = nullptr;
+        uint64_t version = 0;                      // TrackedHot::stateVersion at plan time
+        DeferredVerifyContext* firedContext = nullptr;  // fired one-shot timer context (freed unlocked)
+        bool useCache = false;       // ETW_THREAD_START: consult/refresh EcoQoS micro-cache
+        DWORD threadId = 0;          // ETW_THREAD_START: enforce on this thread only (0 = sweep)
+        bool needsQuery = false;     // Execute: IsEcoQoSEnabled
+        bool enforceIfOn = false;    // Execute: PulseEnforceV6 when EcoQoS is ON
+        bool ecoQoSOn = false;       // cached value, or query result after Execute
+        bool enforced = false;
+    };
+    struct DispatchEffects {
+        std::vector<platform::NativeHandle> timersToDelete;
+        std::vector<DeferredVerifyContext*> ctxToDelete;
+        uint8_t verifyStep = 0;            // ScheduleDeferredVerification step (0 = none)
+        bool startPersistentTimer = false;
+        bool hasLog = false;
+        wchar_t logBuf[256] = {};
+    };
+    bool PlanDispatch(const EnforcementRequest& req, ULONGLONG now, DispatchPlan& plan);
+    void ExecuteDispatch(const EnforcementRequest& req, DispatchPlan& plan);
+    void CommitDispatch(const EnforcementRequest& req, ULONGLONG now,
+                        const DispatchPlan& plan, DispatchEffects& fx);
+    void ApplyDispatchEffects(DWORD pid, DispatchEffects& fx);
+
     // Handle config file change notification
     void HandleConfigChange();
 
@@ -307,7 +383,7 @@ private:
     // Cancel all timers for a process (cleanup)
     // timersToDelete / ctxToDelete are accumulator vectors; deletion happens outside lock
     void CancelProcessTimers(TrackedProcess& tp,
-                             std::vector<HANDLE>& timersToDelete,
+                             std::vector<platform::NativeHandle>& timersToDelete,
                              std::vector<DeferredVerifyContext*>& ctxToDelete);
 
     // Start persistent enforcement timer
@@ -330,7 +406,7 @@ private:
 
     // Inner implementation: receives an already-opened process handle + resolved path
     bool ApplyOptimizationWithHandle(DWORD pid, const std::wstring& name, bool isChild,
-                                     DWORD parentPid, ScopedHandle&& scopedHandle,
+                                     DWORD parentPid, platform::OwnedHandle&& scopedHandle,
                                      const std::wstring& resolvedPath);
 
     // Update phase for a tracked process
@@ -338,91 +414,117 @@ private:
 
     // Callback when a tracked process exits
     static void CALLBACK OnProcessExit(PVOID lpParameter, BOOLEAN timerOrWaitFired);
+    // §9.32: exit reported by the event source (any thread, every process on the system)
+    void OnMonitorProcessExit(DWORD pid);
+    // pendingRemovalPids_ push + wakeup (OnProcessExit / OnMonitorProcessExit)
+    void QueueProcessRemoval(DWORD pid);
+    // processMonitor_.Start with the engine callbacks; updates monitorExitEvents_
+    bool StartProcessMonitor();
 
     // Remove tracking for a process
     void RemoveTrackedProcess(DWORD pid);
 
     // Stateless pulse enforcement (Set-only, no Get)
-    bool PulseEnforce(HANDLE hProcess, DWORD pid, bool isIntensive);
+    bool PulseEnforce(platform::NativeHandle hProcess, DWORD pid, bool isIntensive);
 
     // Enhanced pulse enforcement with NtSetInformationProcess
-    bool PulseEnforceV6(HANDLE hProcess, DWORD pid, bool isIntensive);
+    // §9.39: threadId != 0 limits the thread step to that thread (ETW_THREAD_START);
+    // 0 sweeps every thread of the process
+    bool PulseEnforceV6(platform::NativeHandle hProcess, DWORD pid, bool isIntensive, DWORD threadId = 0);
 
     // Apply registry policy for a target process
     bool ApplyRegistryPolicy(const std::wstring& exePath, const std::wstring& exeName);
 
     // Consolidated thread throttling
     // @param aggressive: true for aggressive boost, false for conservative
+    // §9.38: threads come from the tick snapshot; a process that started after the capture
+    // falls back to the platform's own thread walk
     int DisableThreadThrottling(DWORD pid, bool aggressive);
 
     // Centralized state update after enforcement
     void UpdateEnforceState(DWORD pid, ULONGLONG now, bool success);
 
     // Self-healing error handling
-    void HandleEnforceError(HANDLE hProcess, DWORD pid, DWORD error);
+    void HandleEnforceError(platform::NativeHandle hProcess, DWORD pid, DWORD error);
     bool ReopenProcessHandle(DWORD pid);
 
     // Job Object management
-    bool CreateAndAssignJobObject(DWORD rootPid, HANDLE hProcess);
+    bool CreateAndAssignJobObject(DWORD rootPid, platform::NativeHandle hProcess);
     void RefreshJobObjectPids();
     void CleanupJobObjects();
 
     // Set process phase externally
     void SetProcessPhase(DWORD pid, ProcessPhase phase);
 
+    // §9.25: Thread-event target snapshot (PIDs in STABLE / PERSISTENT)
+    static bool AcceptsThreadEvents(ProcessPhase phase) {
+        return phase == ProcessPhase::STABLE || phase == ProcessPhase::PERSISTENT;
+    }
+    // Control thread: rebuild + publish when the membership changed (threadEventTargetsDirty_)
+    void PublishThreadEventTargets(bool force = false);
+    // §9.23 coalescing slot values. §9.39: QUEUED = the queued request's thread is the only
+    // one seen so far; COALESCED = more threads started behind it (dispatch sweeps them all)
+    static constexpr uint8_t THREAD_EVENT_IDLE = 0;
+    static constexpr uint8_t THREAD_EVENT_QUEUED = 1;
+    static constexpr uint8_t THREAD_EVENT_COALESCED = 2;
+    // Control thread: release the §9.23 coalescing slot of pid. Returns the previous value.
+    uint8_t ClearThreadEventPending(DWORD pid);
+
     // === State checks ===
 
     // Check if EcoQoS (Efficiency Mode) is currently enabled
-    bool IsEcoQoSEnabled(HANDLE hProcess) const;
-
-    // Cached version: avoids repeated NtQueryInformationProcess during burst
-    bool IsEcoQoSEnabledCached(TrackedProcess& tp, ULONGLONG now);
+    bool IsEcoQoSEnabled(platform::NativeHandle hProcess) const;
 
     // Phase-based enforcement handler
-    void ProcessPhaseEnforcement(DWORD pid, HANDLE hProcess, ProcessPhase phase, ULONGLONG now);
+    void ProcessPhaseEnforcement(DWORD pid, platform::NativeHandle hProcess, ProcessPhase phase, ULONGLONG now);
 
     // Phase-specific enforcement handlers
-    void HandleAggressivePhase(TrackedProcess& tp, DWORD pid, HANDLE hProcess, ULONGLONG now);
-    void HandleStablePhase(TrackedProcess& tp, DWORD pid, HANDLE hProcess, ULONGLONG now);
-    void HandlePersistentPhase(TrackedProcess& tp, DWORD pid, HANDLE hProcess, ULONGLONG now);
+    void HandleAggressivePhase(TrackedProcess& tp, DWORD pid, platform::NativeHandle hProcess, ULONGLONG now);
+    void HandleStablePhase(TrackedProcess& tp, DWORD pid, platform::NativeHandle hProcess, ULONGLONG now);
+    void HandlePersistentPhase(TrackedProcess& tp, DWORD pid, platform::NativeHandle hProcess, ULONGLONG now);
 
     // Check if PID is being tracked
     bool IsTracked(DWORD pid) const;
 
-    // Check if this is a target process name (name-only set)
-    bool IsTargetName(const std::wstring& name) const;
+    // Check if this is a target process name (name-only set). Any case, no allocation.
+    bool IsTargetName(std::wstring_view name) const;
+
+    // Check if fullPath matches any path target (with name fallback)
+    bool IsTargetPath(std::wstring_view fullPath) const;
 
-    // Check if fullPathLower matches any path target (with name fallback)
-    bool IsTargetPath(const std::wstring& fullPathLower) const;
+    // Current compiled target tables (pointer copy under targetCs_; never null after Initialize)
+    std::shared_ptr<const TargetTables> SnapshotTargets() const;
 
     // lock-free check: true when any path-based targets are configured
     bool HasPathTargets() const;
 
     // Resolve process image path via QueryFullProcessImageNameW + GetFinalPathNameByHandleW
     // Returns normalized lowercase absolute path, or empty string on failure (no fallback)
-    std::wstring ResolveProcessPath(HANDLE hProcess) const;
+    std::wstring ResolveProcessPath(platform::NativeHandle hProcess) const;
 
     // Normalize a file path via GetFullPathNameW (no file handle needed — works for non-existent files)
     // Returns lowercase absolute path with prefixes stripped, or empty string on failure
     static std::wstring CanonicalizePath(const std::wstring& rawPath);
 
     // Check if a file exists on disk (GetFileAttributesW)
-    static bool FileExistsW(const std::wstring& path);
+    bool FileExistsW(const std::wstring& path) const;
 
     // Try to apply optimization by resolving and matching full path (path-target branch)
-    // Opens handle, resolves path, checks targetPathSet_, delegates to ApplyOptimizationWithHandle
+    // Opens handle, resolves path, checks target paths, delegates to ApplyOptimizationWithHandle
     void TryApplyByPath(DWORD pid, const std::wstring& name);
 
     // §9.14-E: SafetyNet 2-pass round-robin scan for missed targets
     void ScanRunningProcessesForMissedTargets(int maxScan);
-    // Try to apply optimization for a single process if it matches a target (SafetyNet recovery)
+    // §9.40: name-only part of the missed-target check (false results go to nonTargetCache_)
+    static bool IsMissedTargetCandidate(const TargetTables& targets, std::wstring_view exeName);
+    // Try to apply optimization for a candidate process (SafetyNet recovery)
     // Returns true if optimization was applied (new tracking started)
     bool TryApplyIfMissedTarget(DWORD pid, const wchar_t* exeName);
 
-    // §9.18: Lightweight Toolhelp32 probe used by ETW stall detection.
-    // Returns true if at least one running process matches targetNameSet_ /
-    // pathTargetFileNames_. No descendant collection, no policy work.
-    bool HasAnyTargetRunning() const;
+    // §9.18: Lightweight snapshot probe used by ETW stall detection (§9.38: tick snapshot).
+    // Returns true if at least one running process matches the name /
+    // path-file-name target tables. No descendant collection, no policy work.
+    bool HasAnyTargetRunning();
 
     // §9.18: ETW restart helper — Stop / Sleep(50ms) / Start / state update.
     // Sets etwState_ = VERIFYING_RECOVERY (Start success) or DEGRADED (Start failure).
@@ -432,6 +534,19 @@ private:
     // Check if parent is being tracked
     bool IsTrackedParent(DWORD parentPid) const;
 
+    // §9.37: parentPid if tracked, else the nearest tracked ancestor of pid in the process
+    // tree (stops at critical images, PROCESS_TREE_ANCESTOR_DEPTH levels). 0 = none.
+    DWORD FindTrackedAncestor(DWORD pid, DWORD parentPid) const;
+    // Caller holds treeCs_. Linked ancestors of pid (parent first), stopping before a
+    // critical image. out: PROCESS_TREE_ANCESTOR_DEPTH entries.
+    size_t CollectAncestorsLocked(DWORD pid, DWORD* out) const;
+    // §9.37: brings processTree_ in line with a snapshot the caller took anyway
+    // (capturedAt: clock read before the capture). Returns nodes inserted / removed.
+    size_t ReconcileProcessTree(const engine_logic::SystemSnapshot& snapshot, ULONGLONG capturedAt);
+    // §9.37: (pid, image name) of pid's descendants in the tree, critical subtrees excluded
+    std::vector<std::pair<DWORD, std::wstring>> CollectDescendants(DWORD pid) const;
+    void ForgetProcess(DWORD pid);      // exit seen (monitor / exit wait)
+
     // === Configuration ===
 
     // Release all kernel handles (idempotent - safe for multiple calls)
@@ -446,30 +561,49 @@ private:
     // Remove tracked processes that are no longer targets
     void CleanupRemovedTargets();
 
-    // Initial scan for existing target processes
+    // Initial scan for existing target processes (also records the rescan baseline, §9.36,
+    // and seeds the process tree, §9.37)
     void InitialScan();
 
+    // §9.36: NORMAL-mode rescan driven by evidence of lost process starts (monitor lost-event
+    // delta, CRITICAL drop/evict delta, monitor restart). Examines only processes absent from
+    // the previous scan's baseline. No evidence = no snapshot.
+    void RescanOnEventLoss();
+    void RecordScanBaseline(const engine_logic::SystemSnapshot& snapshot);
+
+    // §9.38: this tick's process + thread snapshot, captured by the first consumer and shared
+    // by the rest. nullptr when the capture failed (not retried before the next tick).
+    // capturedAt: clock read before the capture. Control thread only (and Start before it).
+    const engine_logic::SystemSnapshot* AcquireTickSnapshot(ULONGLONG* capturedAt = nullptr);
+
     // Initial scan for existing target processes (startup only)
     // Also used as fallback in DEGRADED_ETW mode
     void InitialScanForDegradedMode();
 
     // === Members ===
 
+    // OS abstraction (process control, timers, events, ETW, registry policy)
+    platform::Platform& os_;
+
     std::wstring baseDir_;
     std::atomic<bool> running_;
     std::atomic<bool> stopRequested_;
 
     // Event-driven thread management
-    ProcessMonitor processMonitor_;       // ETW-based process monitor
+    platform::IProcessEventSource& processMonitor_;  // ETW-based process monitor (os_.monitor)
     std::thread engineControlThread_;     // Single control thread
-    HANDLE stopEvent_;                    // Service stop signal (manual reset)
+    ControlLoopMode loopMode_ = ControlLoopMode::OWN_THREAD;
+    platform::NativeHandle stopEvent_;    // Service stop signal (manual reset)
 
     // Event-driven synchronization handles
-    HANDLE timerQueue_;                   // Timer Queue for deferred verification and persistent timers
-    HANDLE configChangeHandle_;           // FindFirstChangeNotification handle
-    HANDLE safetyNetTimer_;               // Waitable Timer for safety net (10s)
-    HANDLE enforcementRequestEvent_;      // Auto-reset event to signal queue has items
-    HANDLE hWakeupEvent_;                 // Auto-reset event for process exit wakeup
+    platform::NativeHandle timerQueue_;               // Timer Queue for deferred verification and persistent timers
+    platform::NativeHandle configChangeHandle_;       // UnLeaf.ini watch (§9.34: file-scoped)
+    platform::NativeHandle safetyNetTimer_;           // Waitable Timer for safety net (10s)
+    platform::NativeHandle enforcementRequestEvent_;  // Auto-reset event to signal queue has items
+    platform::NativeHandle hWakeupEvent_;             // Auto-reset event for process exit wakeup
+
+    // Control loop state (EngineControlLoop / RunControlLoopOnce)
+    uint32_t spinCount_ = 0;              // consecutive hWakeupEvent_ fires (spin detection)
 
     // Pending process removal queue (populated by OnProcessExit callback, drained by EngineControlLoop)
     std::queue<DWORD> pendingRemovalPids_;
@@ -478,25 +612,80 @@ private:
     // Enforcement request queue (thread-safe) — 2-queue CRITICAL/NON-CRITICAL split (§9.14-A)
     // CRITICAL: ETW_PROCESS_START, DEFERRED_VERIFICATION, PERSISTENT_ENFORCE, SAFETY_NET
     // NON-CRITICAL: ETW_THREAD_START (high-frequency, droppable at SOFT_LIMIT)
-    std::deque<EnforcementRequest> criticalQueue_;
-    std::deque<EnforcementRequest> nonCriticalQueue_;
-    mutable CriticalSection queueCs_;   // ZERO-I/O, no blocking — deque ops only
+    // §9.22: lock-free bounded MPSC rings (POD slots) — replaces queueCs_ + 2 deques
+    EnforcementQueue requestQueue_{ENFORCEMENT_QUEUE_SOFT_LIMIT,
+                                   ENFORCEMENT_QUEUE_HARD_LIMIT,
+                                   ENFORCEMENT_QUEUE_TOTAL_LIMIT};
     std::atomic<uint32_t> enforcementDropCount_{0};
     std::atomic<uint32_t> criticalDropCount_{0};    // §9.14-A: HARD_LIMIT 超過によるドロップ数
     std::atomic<uint32_t> criticalEvictCount_{0};   // §9.14-A: TOTAL_LIMIT eviction（rotation）数（drop とは区別）
 
-    // Tracked processes (PID -> TrackedProcess)
-    std::map<DWORD, std::shared_ptr<TrackedProcess>> trackedProcesses_;
+    // §9.35: per-second rate histograms (any thread, lock-free). Reset at Start.
+    // processStart / threadStart: arrivals at the engine callbacks, before target filtering.
+    engine_logic::RateHistogram processStartRate_;
+    engine_logic::RateHistogram threadStartRate_;
+    engine_logic::RateHistogram enqueueRate_[STATS_REQUEST_TYPES];   // by EnforcementRequestType
+    engine_logic::RateHistogram dropRate_;
+    engine_logic::RateHistogram evictRate_;
+
+    // Tracked processes (PID -> hot state + TrackedProcess)
+    // §9.24: open-addressing PID table — keys / TrackedHot / shared_ptr in separate arrays
+    TrackedTable trackedProcesses_;                 // grows on demand (load <= 50%)
     mutable CriticalSection trackedCs_;
 
+    // §9.25: Read-mostly snapshot of PIDs whose thread events are enqueued (STABLE / PERSISTENT).
+    // OnThreadStart reads it lock-free; the control thread republishes it after membership
+    // changes. Each member carries the §9.23 "ETW_THREAD_START pending" slot (THREAD_EVENT_*).
+    engine_logic::RcuCell<engine_logic::PidSignalSet> threadEventTargets_;
+    std::atomic<bool> threadEventTargetsDirty_{false};  // set under trackedCs_ with the phase change
+
+    // §9.28: Same membership as threadEventTargets_, as a PID-space bitmap the monitor tests
+    // before invoking the thread callback. Bits are set before a snapshot is published and
+    // cleared after it, so the bitmap never rejects a PID the snapshot accepts.
+    engine_logic::PidBitmap threadEventFilter_;
+    std::vector<uint32_t> threadEventFilterPids_;       // sorted; bits currently set (publisher only)
+
+    // §9.32: exits from the event source instead of per-process waits (netlink proc connector).
+    // monitorReportsExits_: the source accepted the exit callback (fixed per Start()).
+    // monitorExitEvents_: ...and it is running — new entries skip RegisterExitWait.
+    // trackedPidFilter_: every tracked PID (set on insert under trackedCs_, cleared on erase).
+    // An exit racing the insert is missed here and found by the liveness check (no waitHandle).
+    // Also the lock-free tracked test of OnProcessStartBatch (§9.37) and the SafetyNet scan (§9.40).
+    bool monitorReportsExits_ = false;
+    std::atomic<bool> monitorExitEvents_{false};
+    engine_logic::PidBitmap trackedPidFilter_;
+
+    // §9.36: ETW_PROCESS_START admitted but not dispatched yet (set by the monitor thread before
+    // Push, cleared after dispatch or on drop). A child whose parent is still queued is admitted
+    // too and resolved at dispatch (FIFO: the parent is handled first) instead of being skipped
+    // — the periodic full scan no longer papers over that race.
+    engine_logic::PidBitmap pendingStartFilter_;
+
+    // §9.37: persistent process tree. Seeded by the InitialScan snapshot, then kept current by
+    // the monitor (every start, every exit the source reports, exit waits of tracked PIDs) and
+    // reconciled by the snapshots the loss rescan / SafetyNet take anyway. treeCs_ is never
+    // held together with trackedCs_.
+    engine_logic::ProcessTree processTree_;
+    mutable CriticalSection treeCs_;
+    std::atomic<uint32_t> processTreeRepairs_{0};   // nodes fixed by reconciliation
+    std::atomic<uint32_t> ancestorAdmitCount_{0};
+
+    // §9.38: per-tick snapshot (AcquireTickSnapshot). The arena keeps its capacity across
+    // ticks; RunControlLoopOnce marks it stale on every wakeup. Control thread only.
+    enum class TickSnapshotState : uint8_t { STALE, READY, FAILED };
+    engine_logic::SystemSnapshot tickSnapshot_;
+    TickSnapshotState tickSnapshotState_ = TickSnapshotState::STALE;
+    ULONGLONG tickSnapshotAt_ = 0;
+    std::atomic<uint32_t> snapshotCaptures_{0};
+    std::atomic<uint32_t> snapshotReuses_{0};
+    std::atomic<uint32_t> threadWalkFallbacks_{0};
+
     // Wait callback context tracking for safe cleanup
     std::map<DWORD, WaitCallbackContext*> waitContexts_;
 
-    // Target process sets (all protected by targetCs_)
-    std::set<std::wstring> targetNameSet_;       // lowercase exe names (name-only targets)
-    std::set<std::wstring> targetPathSet_;       // GetFinalPathNameByHandleW-normalized full paths
-    std::set<std::wstring> pathTargetFileNames_; // exe name part of each targetPathSet_ entry (pre-filter)
-    std::atomic<bool>      hasPathTargets_;      // lock-free: true when targetPathSet_ non-empty
+    // Target tables (pointer protected by targetCs_; the tables themselves are immutable)
+    std::shared_ptr<const TargetTables> targetTables_;
+    std::atomic<bool>      hasPathTargets_;      // lock-free: true when targetTables_->paths non-empty
     mutable CriticalSection targetCs_;
 
     // Enforcement statistics
@@ -504,12 +693,11 @@ private:
     ULONGLONG lastStatsLogTime_;
     ULONGLONG lastDiagLogTime_;   // tracks DIAG_LOG_INTERVAL_MS cadence (independent of stats)
     uint32_t  lastDiagLostCount_; // lostEventCount_ snapshot at previous DIAG tick (for delta)
-    LARGE_INTEGER qpcFreq_;       // QueryPerformanceFrequency cache (initialized in Start())
 
     // Job Objects (rootPid -> JobObjectInfo)
     // THREAD SAFETY: jobObjects_ is accessed from both the EngineControlLoop thread
     // (RemoveTrackedProcess, RefreshJobObjectPids) and the ETW ConsumerThread
-    // (CreateAndAssignJobObject via OnProcessStart -> ApplyOptimizationWithHandle).
+    // (CreateAndAssignJobObject via OnProcessStartBatch -> ApplyOptimizationWithHandle).
     // All accesses MUST hold jobCs_. Safety is guaranteed by jobCs_ exclusion,
     // NOT by single-thread ownership.
     // FUTURE: If jobObjects_ access patterns change, ensure strict lock ordering
@@ -537,6 +725,11 @@ private:
     DWORD     lastScannedPid_{0};          // round-robin cursor (monotonically increasing via std::max)
     uint32_t  lastCheckedDropCount_{0};    // differential drop detection baseline
     std::atomic<uint32_t> safetyRecoveredCount_{0};  // missed-target recovery counter
+    // §9.40: PIDs classified as non-targets under the current TargetTables generation.
+    // Control thread only; the atomics mirror it for GetHealthInfo.
+    engine_logic::NonTargetCache nonTargetCache_;
+    std::atomic<uint32_t> nonTargetCacheHits_{0};
+    std::atomic<uint32_t> nonTargetCacheEntries_{0};
 
     // Last process liveness check time (zombie cleanup)
     ULONGLONG lastProcessLivenessCheck_;
@@ -547,7 +740,7 @@ private:
     // Last [MEM] memory diagnostics log time
     ULONGLONG lastMemLogTime_;
 
-    // Config change debounce (FindFirstChangeNotification fires for all directory writes)
+    // Config change debounce (editor saves arrive as several writes / a rename)
     ULONGLONG lastConfigCheckTime_;
     bool configChangePending_;
 
@@ -556,7 +749,21 @@ private:
     ULONGLONG lastEtwHealthCheck_;
 
     // §9.18: periodic InitialScan + ETW stall detection state
-    ULONGLONG lastFullScanTime_       = 0;
+    ULONGLONG lastFullScanTime_       = 0;      // §9.36: last loss-evidence check
+
+    // §9.36: loss evidence baselines + processes seen by the last scan (sorted by pid).
+    // Control thread only.
+    struct ScanBaselineEntry {
+        DWORD pid;
+        DWORD parentPid;
+        size_t nameHash;     // PID reuse with a different image counts as a new process
+    };
+    std::vector<ScanBaselineEntry> scanBaseline_;
+    uint32_t  rescanLostBase_         = 0;
+    uint32_t  rescanDropBase_         = 0;      // criticalDropCount_ + criticalEvictCount_
+    ULONGLONG rescanRestartBase_      = 0;      // lastEtwRestartTime_
+    std::atomic<uint32_t> lossRescanCount_{0};
+    std::atomic<uint32_t> lossRescanEntries_{0};   // entries examined (absent from the baseline)
     ULONGLONG lastEtwStallCheckTime_  = 0;
     ULONGLONG lastEtwRestartTime_     = 0;
     uint32_t  lastEtwEventCount_      = 0;
@@ -575,15 +782,6 @@ private:
     // Service start time for uptime calculation
     ULONGLONG startTime_;
 
-    // NT API function pointers
-    HMODULE ntdllHandle_;
-    PFN_NtSetInformationProcess pfnNtSetInformationProcess_;
-    PFN_NtQueryInformationProcess pfnNtQueryInformationProcess_;
-    bool ntApiAvailable_;
-
-    // Windows version for compatibility checks
-    WindowsVersionInfo winVersion_;
-
     // Registry policy LRU cache (canonPath-based)
     std::list<std::wstring> policyCacheLru_;
     std::unordered_map<std::wstring, std::list<std::wstring>::iterator> policyCacheMap_;
@@ -612,6 +810,7 @@ private:
     // waitDelta = reg - unreg は累計差分。実際のアクティブ待機数は watchMap + deferCtxCnt で読む。
     // ウェイトリーク確定: delta 単調増加 AND watchMap 横ばい AND deferCtx 横ばい AND handles 比例増加 — 全条件同時。
     std::atomic<uint64_t> waitRegisterCount_{0};      // cumulative RegisterWaitForSingleObject successes
+    std::atomic<uint64_t> monitorExitCount_{0};       // §9.32: tracked exits delivered by the event source
     std::atomic<uint64_t> waitUnregisterCount_{0};    // cumulative UnregisterWaitEx calls that returned TRUE
     std::atomic<uint64_t> waitUnregisterFailures_{0}; // cumulative UnregisterWaitEx calls that returned FALSE
     std::atomic<uint32_t> callbackConcurrent_{0};     // OnProcessExit 同時実行数 (RAII管理)
@@ -622,6 +821,11 @@ private:
 
     // Queue deduplication counter
     std::atomic<uint32_t> etwThreadDeduped_{0};
+    std::atomic<uint32_t> etwThreadScoped_{0};       // §9.39
+    std::atomic<uint32_t> processStartBatches_{0};   // §9.29: OnProcessStartBatch calls
+
+    // §9.21: Dispatch commits dropped by the stateVersion check
+    std::atomic<uint32_t> dispatchCommitConflicts_{0};
 
     // Enforcement telemetry counters
     std::atomic<uint32_t> enforceCount_{0};
@@ -643,15 +847,10 @@ private:
     // Config monitoring counters
     std::atomic<uint32_t> configChangeDetected_{0};
     std::atomic<uint32_t> configReloadCount_{0};
+    std::atomic<uint32_t> configReloadSkipped_{0};   // §9.34: notification, content unchanged
 
     // Engine policy (aggregates timing constants for engine_logic pure functions)
-    engine_logic::EnginePolicy policy_{
-        VIOLATION_THRESHOLD,
-        static_cast<uint64_t>(ECOQOS_CACHE_DURATION),
-        static_cast<uint32_t>(DEFERRED_VERIFY_1),
-        static_cast<uint32_t>(DEFERRED_VERIFY_2),
-        static_cast<uint32_t>(DEFERRED_VERIFY_FINAL)
-    };
+    engine_logic::EnginePolicy policy_{DefaultPolicy()};
 
     // === Event-Driven Timing Constants ===
 
@@ -692,7 +891,7 @@ private:
     // Process liveness check interval (zombie TrackedProcess cleanup)
     static constexpr ULONGLONG LIVENESS_CHECK_INTERVAL = 60000;  // 60s
 
-    // Config change debounce (directory-level notification includes log writes)
+    // Config change debounce (coalesces one editor save into one reload)
     static constexpr ULONGLONG CONFIG_DEBOUNCE_MS = 2000;        // 2s debounce
 
     // Error log suppression window (same PID × error code)
@@ -711,8 +910,8 @@ private:
     static constexpr ULONGLONG MEM_LOG_INTERVAL_LONG  = 60000;    // 30 分経過後: 60 秒
     static constexpr ULONGLONG MEM_LOG_WARMUP_MS      = 1800000ULL; // 30 分
 
-    // trackedProcesses_ hard cap (§9.00 Eviction)
-    static constexpr size_t MAX_TRACKED_PROCESSES = 2000;
+    // trackedProcesses_ hard cap (§9.00 Eviction; §9.24: 2000 → 32768 with the flat PID table)
+    static constexpr size_t MAX_TRACKED_PROCESSES = 32768;
 
     // pendingRemovalPids_ saturation guard (§9.01)
     static constexpr size_t MAX_PENDING_REMOVALS = 4096;
@@ -742,8 +941,14 @@ private:
     // hasCriticalDrop が不発の場合でも最大 30 秒以内に ScanRunningProcessesForMissedTargets を発火。
     static constexpr ULONGLONG SAFETY_SCAN_BACKSTOP_MS = 30ULL * 1000;
 
+    // §9.37: 追跡済み祖先を探す深さ (直接の親を含む)。起動直後に終了するランチャー
+    // (target → launcher → worker) を 1〜2 段飛ばせれば十分で、システム全体へは遡らない。
+    static constexpr size_t PROCESS_TREE_ANCESTOR_DEPTH = 4;
+
     // §9.18: 周期 InitialScan + ETW stall 検知パラメータ
-    // PERIODIC_FULL_SCAN_INTERVAL: NORMAL モードで 20 秒毎に InitialScan を発火し ETW silent drop を補正。EcoQoS 検知遅延上限を 20s に抑制する。
+    // PERIODIC_FULL_SCAN_INTERVAL: NORMAL モードで 20 秒毎にイベントロスの証拠を確認し、証拠があれば
+    //   ベースライン外のプロセスだけを再走査する (§9.36)。証拠なしならスナップショットも取らない。
+    //   検知されないロス (silent drop) は SafetyNet バックストップ (§9.14-E、30 秒) が補正する。
     // ETW_STALL_CHECK_INTERVAL: 30 秒間隔で ETW total event count delta を監視。
     // ETW_RESTART_COOLDOWN_MS: stall 検知 → restart の最短間隔（無限ループ防止）。
     // ETW_MIN_EVENTS_FOR_CHECK: hot stall パス専用の誤検知防止閾値（cold dead パスには不要）。
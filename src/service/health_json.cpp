@@ -0,0 +1,131 @@
+// UnLeaf - Health check JSON serialization
+
+#include "health_json.h"
+#include "../common/logger.h"
+#include "../common/win_string_utils.h"
+#include <nlohmann/json.hpp>
+
+namespace unleaf {
+
+static const char* GetModeString(OperationMode mode) {
+    switch (mode) {
+        case OperationMode::NORMAL: return "NORMAL";
+        case OperationMode::DEGRADED_ETW: return "DEGRADED_ETW";
+        default: return "UNKNOWN";
+    }
+}
+
+std::string SerializeHealthJson(const HealthInfo& health) {
+    // Determine overall status
+    const char* status = "healthy";
+    if (!health.engineRunning) {
+        status = "unhealthy";
+    } else if (!health.etwHealthy || health.mode != OperationMode::NORMAL) {
+        status = "degraded";
+    }
+
+    // Build active_processes JSON array
+    nlohmann::json activeProcs = nlohmann::json::array();
+    for (const auto& p : health.activeProcessDetails) {
+        activeProcs.push_back({
+            {"pid", p.pid},
+            {"name", unleaf::WideToUtf8(p.name.c_str())},
+            {"phase", p.phase},
+            {"violations", p.violations},
+            {"is_child", p.isChild}
+        });
+    }
+
+    nlohmann::json j;
+    j["schema_version"] = 1;
+    j["status"] = status;
+    j["uptime_seconds"] = health.uptimeMs / 1000;
+
+    j["engine"] = {
+        {"running", health.engineRunning},
+        {"mode", GetModeString(health.mode)},
+        {"active_processes", activeProcs},
+        {"total_violations", health.totalViolations},
+        {"interned_strings", health.internedStrings},
+        {"interned_bytes", health.internedBytes},
+        {"snapshot_captures", health.snapshotCaptures},
+        {"snapshot_reuses", health.snapshotReuses},
+        {"thread_walk_fallbacks", health.threadWalkFallbacks},
+        {"phases", {
+            {"aggressive", health.aggressiveCount},
+            {"stable", health.stableCount},
+            {"persistent", health.persistentCount}
+        }}
+    };
+
+    j["etw"] = {
+        {"healthy", health.etwHealthy},
+        {"event_count", health.etwEventCount},
+        {"thread_filtered", health.etwThreadFiltered},
+        {"thread_forwarded", health.etwThreadForwarded},
+        {"thread_filtered_per_sec", health.etwThreadFilteredPerSec},
+        {"thread_forwarded_per_sec", health.etwThreadForwardedPerSec},
+        {"loss_rescans", health.lossRescans},
+        {"loss_rescan_entries", health.lossRescanEntries},
+        {"process_tree_nodes", health.processTreeNodes},
+        {"process_tree_repairs", health.processTreeRepairs},
+        {"ancestor_admits", health.ancestorAdmits},
+        {"non_target_cache_hits", health.nonTargetCacheHits},
+        {"non_target_cache_entries", health.nonTargetCacheEntries}
+    };
+
+    j["wakeups"] = {
+        {"config_change", health.wakeupConfigChange},
+        {"safety_net", health.wakeupSafetyNet},
+        {"enforcement_request", health.wakeupEnforcementRequest},
+        {"process_exit", health.wakeupProcessExit}
+    };
+
+    j["enforcement"] = {
+        {"persistent_applied", health.persistentEnforceApplied},
+        {"persistent_skipped", health.persistentEnforceSkipped},
+        {"total", health.totalEnforcements},
+        {"success", health.enforceSuccessCount},
+        {"fail", health.enforceFailCount},
+        {"avg_latency_us", health.enforceLatencyAvgUs},
+        {"max_latency_us", health.enforceLatencyMaxUs},
+        {"etw_thread_deduped", health.etwThreadDeduped},
+        {"etw_thread_scoped", health.etwThreadScoped},
+        {"etw_process_batches", health.etwProcessBatches},
+        {"dispatch_commit_conflicts", health.dispatchCommitConflicts},
+        {"last_enforce_time_ms", health.lastEnforceTimeMs}
+    };
+
+    j["queue"] = {
+        {"drops", health.enforcementDropCount},
+        {"critical_drops", health.criticalDropCount},
+        {"critical_evicts", health.criticalEvictCount}
+    };
+
+    j["errors"] = {
+        {"access_denied", health.error5Count},
+        {"invalid_parameter", health.error87Count},
+        {"shutdown_warnings", health.shutdownWarnings}
+    };
+
+    j["config"] = {
+        {"changes_detected", health.configChangeDetected},
+        {"reloads", health.configReloadCount},
+        {"unchanged_skips", health.configReloadSkipped}
+    };
+
+    j["ipc"] = {{"healthy", true}};
+
+    try {
+        return j.dump();
+    } catch (const std::exception& e) {
+        LOG_ERROR(std::wstring(L"[EXC] CMD_HEALTH_CHECK JSON: ") +
+                  unleaf::Utf8ToWide(e.what()));
+        return R"({"schema_version":1,"status":"error","error":"JSON serialization failed"})";
+    } catch (...) {
+        LOG_ERROR(L"[EXC] CMD_HEALTH_CHECK JSON: unknown exception");
+        return R"({"schema_version":1,"status":"error","error":"JSON serialization failed"})";
+    }
+}
+
+} // namespace unleaf
@@ -0,0 +1,14 @@
+#pragma once
+// UnLeaf - Health check JSON serialization (CMD_HEALTH_CHECK response)
+// IPC 依存なし: IPCServer とベンチマークの双方から利用する。
+
+#include "engine_core.h"
+#include <string>
+
+namespace unleaf {
+
+// Serialize HealthInfo as schema_version 1 JSON.
+// Never throws: on serialization failure returns a {"status":"error"} document.
+std::string SerializeHealthJson(const HealthInfo& health);
+
+} // namespace unleaf
@@ -2,11 +2,11 @@
 
 #include "ipc_server.h"
 #include "engine_core.h"
+#include "health_json.h"
 #include "../common/logger.h"
 #include "../common/win_string_utils.h"
 #include <algorithm>
 #include <sstream>
-#include <nlohmann/json.hpp>
 
 namespace unleaf {
 
@@ -311,14 +311,6 @@ AuthResult IPCServer::AuthorizeClient(HANDLE pipeHandle, IPCCommand cmd) {
     return authorized ? AuthResult::AUTHORIZED : AuthResult::UNAUTHORIZED;
 }
 
-static const char* GetModeString(OperationMode mode) {
-    switch (mode) {
-        case OperationMode::NORMAL: return "NORMAL";
-        case OperationMode::DEGRADED_ETW: return "DEGRADED_ETW";
-        default: return "UNKNOWN";
-    }
-}
-
 std::string IPCServer::ProcessCommand(IPCCommand cmd, const std::string& data) {
     CSLockGuard lock(handlerCs_);
 
@@ -396,96 +388,20 @@ std::string IPCServer::ProcessCommand(IPCCommand cmd, const std::string& data) {
         case IPCCommand::CMD_GET_STATS: {
             // Return the current number of tracked processes as a 4-byte binary
             uint32_t count = static_cast<uint32_t>(EngineCore::Instance().GetActiveProcessCount());
-            return std::string(reinterpret_cast<const char*>(&count), sizeof(uint32_t));
+            std::string response(reinterpret_cast<const char*>(&count), sizeof(uint32_t));
+            // §9.35: clients that send StatsRequest also get the rate / queue telemetry
+            if (data.size() >= sizeof(StatsRequest)) {
+                const StatsRequest* req = reinterpret_cast<const StatsRequest*>(data.data());
+                if (req->version >= 1) {
+                    const StatsTelemetry t = EngineCore::Instance().GetStatsTelemetry();
+                    response.append(reinterpret_cast<const char*>(&t), sizeof(t));
+                }
+            }
+            return response;
         }
         case IPCCommand::CMD_HEALTH_CHECK: {
-            // Health check API (nlohmann/json)
-            auto health = EngineCore::Instance().GetHealthInfo();
-
-            // Determine overall status
-            const char* status = "healthy";
-            if (!health.engineRunning) {
-                status = "unhealthy";
-            } else if (!health.etwHealthy || health.mode != OperationMode::NORMAL) {
-                status = "degraded";
-            }
-
-            // Build active_processes JSON array
-            nlohmann::json activeProcs = nlohmann::json::array();
-            for (const auto& p : health.activeProcessDetails) {
-                activeProcs.push_back({
-                    {"pid", p.pid},
-                    {"name", unleaf::WideToUtf8(p.name.c_str())},
-                    {"phase", p.phase},
-                    {"violations", p.violations},
-                    {"is_child", p.isChild}
-                });
-            }
-
-            nlohmann::json j;
-            j["schema_version"] = 1;
-            j["status"] = status;
-            j["uptime_seconds"] = health.uptimeMs / 1000;
-
-            j["engine"] = {
-                {"running", health.engineRunning},
-                {"mode", GetModeString(health.mode)},
-                {"active_processes", activeProcs},
-                {"total_violations", health.totalViolations},
-                {"phases", {
-                    {"aggressive", health.aggressiveCount},
-                    {"stable", health.stableCount},
-                    {"persistent", health.persistentCount}
-                }}
-            };
-
-            j["etw"] = {
-                {"healthy", health.etwHealthy},
-                {"event_count", health.etwEventCount}
-            };
-
-            j["wakeups"] = {
-                {"config_change", health.wakeupConfigChange},
-                {"safety_net", health.wakeupSafetyNet},
-                {"enforcement_request", health.wakeupEnforcementRequest},
-                {"process_exit", health.wakeupProcessExit}
-            };
-
-            j["enforcement"] = {
-                {"persistent_applied", health.persistentEnforceApplied},
-                {"persistent_skipped", health.persistentEnforceSkipped},
-                {"total", health.totalEnforcements},
-                {"success", health.enforceSuccessCount},
-                {"fail", health.enforceFailCount},
-                {"avg_latency_us", health.enforceLatencyAvgUs},
-                {"max_latency_us", health.enforceLatencyMaxUs},
-                {"etw_thread_deduped", health.etwThreadDeduped},
-                {"last_enforce_time_ms", health.lastEnforceTimeMs}
-            };
-
-            j["errors"] = {
-                {"access_denied", health.error5Count},
-                {"invalid_parameter", health.error87Count},
-                {"shutdown_warnings", health.shutdownWarnings}
-            };
-
-            j["config"] = {
-                {"changes_detected", health.configChangeDetected},
-                {"reloads", health.configReloadCount}
-            };
-
-            j["ipc"] = {{"healthy", true}};
-
-            try {
-                return j.dump();
-            } catch (const std::exception& e) {
-                LOG_ERROR(std::wstring(L"[EXC] CMD_HEALTH_CHECK JSON: ") +
-                          unleaf::Utf8ToWide(e.what()));
-                return R"({"schema_version":1,"status":"error","error":"JSON serialization failed"})";
-            } catch (...) {
-                LOG_ERROR(L"[EXC] CMD_HEALTH_CHECK JSON: unknown exception");
-                return R"({"schema_version":1,"status":"error","error":"JSON serialization failed"})";
-            }
+            // Health check API (schema_version 1, see health_json.h)
+            return SerializeHealthJson(EngineCore::Instance().GetHealthInfo());
         }
         case IPCCommand::CMD_SET_LOG_ENABLED: {
             if (data.empty()) {
@@ -3,6 +3,8 @@
 #include "process_monitor.h"
 #include "../common/logger.h"
 #include <tdh.h>
+#include <cstring>
+#include <filesystem>
 
 // Fallback: EVENT_TRACE_TYPE_LOST_EVENT may not be defined in all SDK versions
 #ifndef EVENT_TRACE_TYPE_LOST_EVENT
@@ -28,6 +30,11 @@ static constexpr USHORT EVENT_ID_PROCESS_START = 1;
 static constexpr USHORT EVENT_ID_PROCESS_STOP = 2;
 static constexpr USHORT EVENT_ID_THREAD_START = 3;
 
+// §9.27: EVENT_HEADER.TimeStamp is FILETIME (100 ns) without PROCESS_TRACE_MODE_RAW_TIMESTAMP
+static uint64_t EventTimestampUs(PEVENT_RECORD pEvent) {
+    return static_cast<uint64_t>(pEvent->EventHeader.TimeStamp.QuadPart) / 10;
+}
+
 ProcessMonitor::ProcessMonitor()
     : sessionHandle_(0)
     , traceHandle_(INVALID_PROCESSTRACE_HANDLE)
@@ -60,12 +67,15 @@ bool ProcessMonitor::Start(ProcessStartCallback processCallback, ThreadStartCall
     threadCallback_ = threadCallback;
     instance_.store(this, std::memory_order_release);
     stopRequested_ = false;
+    pendingStarts_.Clear();
 
     // Reset session state for clean start (prevents false starvation after restart)
     eventCount_ = 0;
     lostEventCount_ = 0;
     lastLostLogTime_ = 0;
     lastEventTime_ = 0;
+    threadFiltered_.Reset();
+    threadForwarded_.Reset();
     startTime_ = GetTickCount64();
     lastCheckedLost_ = 0;
     lastTraceCheckTime_ = 0;
@@ -222,6 +232,7 @@ void ProcessMonitor::ConsumerThread() {
     logfile.LoggerName = const_cast<LPWSTR>(sessionName_.c_str());
     logfile.ProcessTraceMode = PROCESS_TRACE_MODE_REAL_TIME | PROCESS_TRACE_MODE_EVENT_RECORD;
     logfile.EventRecordCallback = EventRecordCallback;
+    logfile.BufferCallback = BufferCallback;
 
     // Open trace
     traceHandle_ = OpenTraceW(&logfile);
@@ -249,10 +260,70 @@ void ProcessMonitor::ConsumerThread() {
     if (status != ERROR_SUCCESS && status != ERROR_CANCELLED && !stopRequested_.load()) {
         sessionHealthy_ = false;
     }
+    if (!stopRequested_.load()) FlushProcessStarts();   // session ended on its own
+    pendingStarts_.Clear();
 
     running_ = false;
 }
 
+// §9.27: Event capture. Start() が再度呼ばれても (RestartETW) 同じファイルへ追記を続ける。
+bool ProcessMonitor::SetEventTraceFile(const std::wstring& path) {
+    std::lock_guard<std::mutex> lock(stopMtx_);
+    if (running_.load()) {
+        LOG_ERROR(L"[ETW] Event trace can only be changed while the monitor is stopped");
+        return false;
+    }
+    if (traceWriter_.IsOpen()) {
+        traceWriter_.Close();
+        wchar_t buf[128];
+        swprintf_s(buf, L"[ETW] Event trace closed: %llu records, %llu bytes%ls",
+                   traceWriter_.RecordCount(), traceWriter_.BytesWritten(),
+                   traceWriter_.HasFailed() ? L" (write error)" : L"");
+        LOG_INFO(buf);
+    }
+    if (path.empty()) return true;
+    if (!traceWriter_.Open(std::filesystem::path(path))) {
+        LOG_ERROR(L"[ETW] Cannot open event trace: " + path);
+        return false;
+    }
+    LOG_INFO(L"[ETW] Recording process/thread events to " + path);
+    return true;
+}
+
+// §9.28: Thread-start prefilter. ポインタは停止中にのみ差し替える (ConsumerThread 生成前)。
+void ProcessMonitor::SetThreadEventFilter(const engine_logic::PidBitmap* filter) {
+    std::lock_guard<std::mutex> lock(stopMtx_);
+    if (running_.load()) {
+        LOG_ERROR(L"[ETW] Thread event filter can only be changed while the monitor is stopped");
+        return;
+    }
+    threadFilter_ = filter;
+}
+
+platform::ThreadEventFilterStats ProcessMonitor::GetThreadEventFilterStats() const {
+    const ULONGLONG now = GetTickCount64();
+    platform::ThreadEventFilterStats stats;
+    stats.filtered = threadFiltered_.Total();
+    stats.forwarded = threadForwarded_.Total();
+    stats.filteredPerSec = threadFiltered_.LastSecond(now);
+    stats.forwardedPerSec = threadForwarded_.LastSecond(now);
+    return stats;
+}
+
+ULONG WINAPI ProcessMonitor::BufferCallback(PEVENT_TRACE_LOGFILEW /*logfile*/) {
+    ProcessMonitor* self = instance_.load(std::memory_order_acquire);
+    if (self && !self->stopRequested_.load(std::memory_order_acquire)) {
+        self->FlushProcessStarts();
+    }
+    return TRUE;   // keep processing
+}
+
+void ProcessMonitor::FlushProcessStarts() {
+    if (pendingStarts_.Empty()) return;
+    if (processCallback_) processCallback_(pendingStarts_);
+    pendingStarts_.Clear();
+}
+
 void WINAPI ProcessMonitor::EventRecordCallback(PEVENT_RECORD pEvent) {
     // Load instance_ once into a local to avoid repeated atomic reads and to
     // prevent a theoretical TOCTOU where instance_ could be re-checked at
@@ -314,15 +385,16 @@ void WINAPI ProcessMonitor::EventRecordCallback(PEVENT_RECORD pEvent) {
     const USHORT eventId = pEvent->EventHeader.EventDescriptor.Id;
 
     // Handle process start event
+    // §9.29: decoded into a POD record and staged; delivered per ETW buffer (BufferCallback)
     if (eventId == EVENT_ID_PROCESS_START) {
-        DWORD pid = 0;
-        DWORD parentPid = 0;
-        std::wstring imageName;
-        std::wstring imagePath;
-
-        if (ParseProcessStartEvent(pEvent, pid, parentPid, imageName, imagePath)) {
-            if (self->processCallback_) {
-                self->processCallback_(pid, parentPid, imageName, imagePath);
+        engine_logic::ProcessStartBatch& batch = self->pendingStarts_;
+        if (batch.Full()) self->FlushProcessStarts();
+        if (self->ParseProcessStartEvent(pEvent, batch)) {
+            if (self->traceWriter_.IsOpen()) {
+                const size_t last = batch.Size() - 1;
+                self->traceWriter_.AppendProcessStart(EventTimestampUs(pEvent), batch[last].pid,
+                                                      batch[last].parentPid,
+                                                      batch.ImageName(last), batch.ImagePath(last));
             }
         }
         return;
@@ -331,22 +403,195 @@ void WINAPI ProcessMonitor::EventRecordCallback(PEVENT_RECORD pEvent) {
     // Handle thread start event
     // Thread creation is a trigger point where OS may re-apply EcoQoS
     if (eventId == EVENT_ID_THREAD_START) {
+        // §9.39: the new thread's owner PID and ID are in the payload. EventHeader carries the
+        // *creator* (ProcessId differs for cross-process CreateRemoteThread).
+        // Short payload: header PID and TID 0 (the engine falls back to a whole-process thread sweep).
+        uint32_t payloadPid = 0, newThreadId = 0;
+        const DWORD ownerPid =
+            engine_logic::DecodeThreadStartIds(static_cast<const uint8_t*>(pEvent->UserData),
+                                               pEvent->UserDataLength, payloadPid, newThreadId)
+                ? static_cast<DWORD>(payloadPid)
+                : pEvent->EventHeader.ProcessId;
+        if (self->traceWriter_.IsOpen()) {
+            // Same (threadId, ownerPid) pair the engine receives: replay reproduces its input
+            self->traceWriter_.AppendThreadStart(EventTimestampUs(pEvent), ownerPid, newThreadId);
+        }
         if (self->threadCallback_) {
-            // The owner PID is in the event header (the process that owns the new thread)
-            DWORD ownerPid = pEvent->EventHeader.ProcessId;
-            // Thread ID can be extracted from user data, but we don't need it for our use case
-            // We only care about which process is creating threads
-            DWORD threadId = pEvent->EventHeader.ThreadId;
-            self->threadCallback_(threadId, ownerPid);
+            // §9.28: untracked owners (typically >99% of system-wide thread starts) stop here,
+            // before the std::function indirection and the engine's snapshot lookup
+            const ULONGLONG now = self->lastEventTime_.load(std::memory_order_relaxed);
+            if (self->threadFilter_ && !self->threadFilter_->Test(ownerPid)) {
+                self->threadFiltered_.Add(now);
+                return;
+            }
+            self->threadForwarded_.Add(now);
+            self->threadCallback_(static_cast<DWORD>(newThreadId), ownerPid);
         }
         return;
     }
 }
 
+// §9.26: Schema-cached decode.
+// 初回の (provider, id, version) だけ TDH でスキーマを取得してレイアウトをコンパイルし、
+// 以降は UserData から ProcessID / ParentProcessID / ImageName を直接読む。
+// コンパイルできないスキーマ (IsValid() == false) は従来の TDH 逐次パースで処理する。
 bool ProcessMonitor::ParseProcessStartEvent(PEVENT_RECORD pEvent,
-                                             DWORD& pid, DWORD& parentPid,
-                                             std::wstring& imageName,
-                                             std::wstring& imagePath) {
+                                             engine_logic::ProcessStartBatch& batch) {
+    // TDH fallback: per-property parse into strings, then one record
+    auto appendTdh = [pEvent, &batch]() {
+        DWORD pid = 0;
+        DWORD parentPid = 0;
+        std::wstring imageName;
+        std::wstring imagePath;
+        if (!ParseProcessStartEventTdh(pEvent, pid, parentPid, imageName, imagePath)) return false;
+        batch.Append(pid, parentPid, imagePath.empty() ? imageName : imagePath);
+        return true;
+    };
+
+    const EVENT_DESCRIPTOR& desc = pEvent->EventHeader.EventDescriptor;
+    engine_logic::EtwLayoutCache::Key key{};
+    static_assert(sizeof(key.provider) == sizeof(GUID), "provider key must hold a GUID");
+    memcpy(key.provider, &pEvent->EventHeader.ProviderId, sizeof(GUID));
+    key.eventId = desc.Id;
+    key.version = desc.Version;
+
+    const engine_logic::ProcessStartLayout* layout = layoutCache_.Find(key);
+    if (!layout) {
+        std::vector<engine_logic::EtwFieldSchema> fields;
+        if (!QueryEventSchema(pEvent, fields)) {
+            // Transient TDH failure: do not cache, retry the schema on the next event
+            tdhDecodeCount_.fetch_add(1, std::memory_order_relaxed);
+            return appendTdh();
+        }
+        layout = &layoutCache_.Insert(key, engine_logic::ProcessStartLayout::Compile(fields));
+        wchar_t buf[128];
+        swprintf_s(buf, L"[ETW] ProcessStart schema v%u: %zu properties, %ls",
+                   static_cast<unsigned>(desc.Version), fields.size(),
+                   layout->IsValid() ? L"layout decode" : L"TDH fallback");
+        LOG_DEBUG(buf);
+    }
+
+    if (!layout->IsValid()) {
+        tdhDecodeCount_.fetch_add(1, std::memory_order_relaxed);
+        return appendTdh();
+    }
+
+    engine_logic::ProcessStartFields fields;
+    layout->Decode(static_cast<const uint8_t*>(pEvent->UserData), pEvent->UserDataLength, fields);
+    layoutDecodeCount_.fetch_add(1, std::memory_order_relaxed);
+
+    // The process ID is in the event header; the payload value wins when present
+    const DWORD pid = fields.hasPid ? fields.pid : pEvent->EventHeader.ProcessId;
+    const DWORD parentPid = fields.hasParentPid ? fields.parentPid : 0;
+    if (pid == 0) return false;
+
+    if (!fields.hasImage || fields.imageBytes == 0) {
+        batch.Append(pid, parentPid, std::wstring_view());
+    } else if (!fields.imageIsAnsi) {
+        // Common case: UTF-16 payload copied straight into the record (no allocation)
+        batch.AppendUtf16Le(pid, parentPid, fields.image, fields.imageBytes);
+    } else {
+        std::wstring image;
+        const char* cp = reinterpret_cast<const char*>(fields.image);
+        const int alen = static_cast<int>(fields.imageBytes);
+        int wideLen = MultiByteToWideChar(CP_ACP, 0, cp, alen, nullptr, 0);
+        if (wideLen > 0) {
+            image.resize(wideLen);
+            if (MultiByteToWideChar(CP_ACP, 0, cp, alen, &image[0], wideLen) == 0) {
+                image.clear();
+            }
+        }
+        batch.Append(pid, parentPid, image);
+    }
+    return true;
+}
+
+// Map TDH top-level property metadata to the layout compiler's field kinds.
+// Anything whose size depends on data or on another property is UNSUPPORTED.
+bool ProcessMonitor::QueryEventSchema(PEVENT_RECORD pEvent,
+                                      std::vector<engine_logic::EtwFieldSchema>& fields) {
+    static constexpr DWORD MAX_TDH_BUFFER = 512 * 1024;
+    DWORD bufferSize = 0;
+    TDHSTATUS status = TdhGetEventInformation(pEvent, 0, nullptr, nullptr, &bufferSize);
+    if (status != ERROR_INSUFFICIENT_BUFFER || bufferSize == 0 || bufferSize > MAX_TDH_BUFFER) {
+        return false;
+    }
+    std::vector<BYTE> buffer(bufferSize);
+    auto* eventInfo = reinterpret_cast<TRACE_EVENT_INFO*>(buffer.data());
+    if (TdhGetEventInformation(pEvent, 0, nullptr, eventInfo, &bufferSize) != ERROR_SUCCESS) {
+        return false;
+    }
+
+    const uint16_t pointerSize =
+        (pEvent->EventHeader.Flags & EVENT_HEADER_FLAG_32_BIT_HEADER) ? 4 : 8;
+    constexpr ULONG VARIABLE_FLAGS = PropertyStruct | PropertyParamLength | PropertyParamCount;
+
+    fields.clear();
+    fields.reserve(eventInfo->TopLevelPropertyCount);
+    for (DWORD i = 0; i < eventInfo->TopLevelPropertyCount; i++) {
+        const EVENT_PROPERTY_INFO& propInfo = eventInfo->EventPropertyInfoArray[i];
+        std::wstring name(reinterpret_cast<LPCWSTR>(
+            reinterpret_cast<BYTE*>(eventInfo) + propInfo.NameOffset));
+
+        if ((propInfo.Flags & VARIABLE_FLAGS) != 0 || propInfo.count != 1) {
+            fields.emplace_back(std::move(name), engine_logic::EtwFieldKind::UNSUPPORTED);
+            continue;
+        }
+
+        using engine_logic::EtwFieldKind;
+        switch (propInfo.nonStructType.InType) {
+            case TDH_INTYPE_INT8: case TDH_INTYPE_UINT8: case TDH_INTYPE_ANSICHAR:
+                fields.emplace_back(std::move(name), EtwFieldKind::FIXED, 1);
+                break;
+            case TDH_INTYPE_INT16: case TDH_INTYPE_UINT16: case TDH_INTYPE_UNICODECHAR:
+                fields.emplace_back(std::move(name), EtwFieldKind::FIXED, 2);
+                break;
+            case TDH_INTYPE_INT32: case TDH_INTYPE_UINT32: case TDH_INTYPE_HEXINT32:
+            case TDH_INTYPE_BOOLEAN: case TDH_INTYPE_FLOAT:
+                fields.emplace_back(std::move(name), EtwFieldKind::FIXED, 4);
+                break;
+            case TDH_INTYPE_INT64: case TDH_INTYPE_UINT64: case TDH_INTYPE_HEXINT64:
+            case TDH_INTYPE_DOUBLE: case TDH_INTYPE_FILETIME:
+                fields.emplace_back(std::move(name), EtwFieldKind::FIXED, 8);
+                break;
+            case TDH_INTYPE_GUID: case TDH_INTYPE_SYSTEMTIME:
+                fields.emplace_back(std::move(name), EtwFieldKind::FIXED, 16);
+                break;
+            case TDH_INTYPE_POINTER: case TDH_INTYPE_SIZET:
+                fields.emplace_back(std::move(name), EtwFieldKind::FIXED, pointerSize);
+                break;
+            case TDH_INTYPE_UNICODESTRING:
+                if (propInfo.length > 0) {   // fixed-length (characters)
+                    fields.emplace_back(std::move(name), EtwFieldKind::FIXED,
+                                        static_cast<uint16_t>(propInfo.length * sizeof(wchar_t)));
+                } else {
+                    fields.emplace_back(std::move(name), EtwFieldKind::UTF16_STRING);
+                }
+                break;
+            case TDH_INTYPE_ANSISTRING:
+                if (propInfo.length > 0) {   // fixed-length (bytes)
+                    fields.emplace_back(std::move(name), EtwFieldKind::FIXED_ANSI,
+                                        static_cast<uint16_t>(propInfo.length));
+                } else {
+                    fields.emplace_back(std::move(name), EtwFieldKind::ANSI_STRING);
+                }
+                break;
+            case TDH_INTYPE_SID:
+                fields.emplace_back(std::move(name), EtwFieldKind::SID);
+                break;
+            default:
+                // WBEMSID / BINARY / counted strings: size depends on another property
+                fields.emplace_back(std::move(name), EtwFieldKind::UNSUPPORTED);
+                break;
+        }
+    }
+    return true;
+}
+
+bool ProcessMonitor::ParseProcessStartEventTdh(PEVENT_RECORD pEvent,
+                                                DWORD& pid, DWORD& parentPid,
+                                                std::wstring& imageName,
+                                                std::wstring& imagePath) {
     // The process ID is in the event header
     pid = pEvent->EventHeader.ProcessId;
 
@@ -458,12 +703,8 @@ bool ProcessMonitor::ParseProcessStartEvent(PEVENT_RECORD pEvent,
                 }
 
                 // Preserve full path before extracting filename
-                size_t lastSlash = imageName.find_last_of(L"\\/");
-                if (lastSlash != std::wstring::npos) {
-                    imagePath = imageName;  // full path hint (may be 8.3/device format)
-                    imageName = imageName.substr(lastSlash + 1);
-                }
                 // If no separator found, imagePath stays empty (filename only from ETW)
+                engine_logic::SplitImagePath(imageName, imagePath);
             }
         }
     }
@@ -3,6 +3,11 @@
 // Event-driven process creation and thread detection using Event Tracing for Windows
 
 #include "../common/types.h"
+#include "../platform/platform.h"
+#include "../engine/etw_event_layout.h"
+#include "../engine/event_batch.h"
+#include "../engine/event_trace.h"
+#include "../engine/pid_bitmap.h"
 #include <evntrace.h>
 #include <evntcons.h>
 #include <functional>
@@ -10,64 +15,87 @@
 #include <atomic>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #pragma comment(lib, "advapi32.lib")
 
 namespace unleaf {
 
-// Callback type for process start events
-// imageName: filename only (e.g. "chrome.exe")
-// imagePath: full image path from ETW, hint only — may be empty, 8.3, or device-format
-using ProcessStartCallback = std::function<void(DWORD pid, DWORD parentPid,
-                                                 const std::wstring& imageName,
-                                                 const std::wstring& imagePath)>;
-
-// Callback type for thread start events (used to detect EcoQoS re-enablement triggers)
-using ThreadStartCallback = std::function<void(DWORD threadId, DWORD ownerPid)>;
+// ProcessStartCallback / ThreadStartCallback: see platform/platform.h
 
 // ETW-based process creation monitor
-class ProcessMonitor {
+class ProcessMonitor : public platform::IProcessEventSource {
 public:
     ProcessMonitor();
-    ~ProcessMonitor();
+    ~ProcessMonitor() override;
 
     // Start monitoring with callbacks
     // processCallback: Called on process creation events
     // threadCallback: Optional, called on thread creation events for tracked processes
-    bool Start(ProcessStartCallback processCallback, ThreadStartCallback threadCallback = nullptr);
+    bool Start(ProcessStartCallback processCallback, ThreadStartCallback threadCallback = nullptr) override;
 
     // Stop monitoring
-    void Stop();
+    void Stop() override;
 
     // Is monitoring active?
     bool IsRunning() const { return running_.load(); }
 
     // Health check - returns true if ETW session is healthy
-    bool IsHealthy() const;
+    bool IsHealthy() const override;
 
     // Get last event timestamp (for diagnostics)
-    ULONGLONG GetLastEventTime() const { return lastEventTime_.load(); }
+    ULONGLONG GetLastEventTime() const override { return lastEventTime_.load(); }
 
     // Get total event count (for diagnostics)
-    uint32_t GetEventCount() const { return eventCount_.load(); }
+    uint32_t GetEventCount() const override { return eventCount_.load(); }
 
     // Get lost event count (non-zero indicates ETW buffer pressure)
-    uint32_t GetLostEventCount() const { return lostEventCount_.load(); }
+    uint32_t GetLostEventCount() const override { return lostEventCount_.load(); }
 
     bool IsSessionHealthy() const { return sessionHealthy_.load(); }
 
+    // §9.26: ProcessStart decode path counters (diagnostics)
+    uint32_t GetLayoutDecodeCount() const { return layoutDecodeCount_.load(); }
+    uint32_t GetTdhDecodeCount() const { return tdhDecodeCount_.load(); }
+
+    // §9.27: binary capture of decoded events (replayed offline by UnLeaf_Replay)
+    bool SetEventTraceFile(const std::wstring& path) override;
+
+    // §9.28: thread-start PID prefilter (tested inline on the ConsumerThread)
+    void SetThreadEventFilter(const engine_logic::PidBitmap* filter) override;
+    platform::ThreadEventFilterStats GetThreadEventFilterStats() const override;
+
+    // §9.32: the kernel process provider is subscribed for starts only: exits stay on
+    // per-process waits (RegisterWaitForSingleObject)
+    bool SetProcessExitCallback(ProcessExitCallback callback) override {
+        (void)callback;
+        return false;
+    }
+
 private:
     // ETW event callback (static for C API compatibility)
     static void WINAPI EventRecordCallback(PEVENT_RECORD pEvent);
 
+    // §9.29: called after every delivered ETW buffer — hands the staged ProcessStart batch over
+    static ULONG WINAPI BufferCallback(PEVENT_TRACE_LOGFILEW logfile);
+    void FlushProcessStarts();
+
     // Process the ETW consumer loop
     void ConsumerThread();
 
-    // Parse process start event data
-    static bool ParseProcessStartEvent(PEVENT_RECORD pEvent,
-                                        DWORD& pid, DWORD& parentPid,
-                                        std::wstring& imageName,
-                                        std::wstring& imagePath);
+    // Parse process start event data into one pendingStarts_ record (false = nothing appended)
+    // §9.26: schema-cached layout decode; falls back to ParseProcessStartEventTdh
+    bool ParseProcessStartEvent(PEVENT_RECORD pEvent, engine_logic::ProcessStartBatch& batch);
+
+    // Per-property TDH parse (schemas the layout compiler cannot handle)
+    static bool ParseProcessStartEventTdh(PEVENT_RECORD pEvent,
+                                          DWORD& pid, DWORD& parentPid,
+                                          std::wstring& imageName,
+                                          std::wstring& imagePath);
+
+    // One TdhGetEventInformation per (provider, id, version): top-level property schema
+    static bool QueryEventSchema(PEVENT_RECORD pEvent,
+                                 std::vector<engine_logic::EtwFieldSchema>& fields);
 
     // ETW handles
     // Protected by stopMtx_ for writes. Reads on the Consumer thread are safe
@@ -102,6 +130,24 @@ private:
     mutable ULONGLONG lastTraceCheckTime_;    // Last IsTraceSessionAliveLocked() call timestamp
     mutable bool      cachedTraceAlive_;      // Cached result of IsTraceSessionAliveLocked()
 
+    // §9.26: compiled ProcessStart layouts. ConsumerThread only (no lock).
+    engine_logic::EtwLayoutCache layoutCache_;
+    std::atomic<uint32_t> layoutDecodeCount_{0};   // decoded straight from UserData
+    std::atomic<uint32_t> tdhDecodeCount_{0};      // fell back to per-property TDH
+
+    // §9.27: event capture. Opened/closed only while stopped; written by the ConsumerThread.
+    // Buffered (64 KB blocks): file I/O on the ETW thread is rare and capture is diagnostic-only.
+    engine_logic::EventTraceWriter traceWriter_;
+
+    // §9.29: decoded ProcessStart records awaiting delivery. ConsumerThread only (no lock).
+    engine_logic::ProcessStartBatch pendingStarts_;
+
+    // §9.28: set only while stopped (published to the ConsumerThread by its creation).
+    // The bitmap itself is updated concurrently by the engine (relaxed atomics).
+    const engine_logic::PidBitmap* threadFilter_ = nullptr;
+    engine_logic::PerSecondCounter threadFiltered_;    // written by the ConsumerThread
+    engine_logic::PerSecondCounter threadForwarded_;
+
     // Callbacks
     ProcessStartCallback processCallback_;
     ThreadStartCallback threadCallback_;
@@ -0,0 +1,120 @@
+// UnLeaf - Event trace replay entry point (§9.27)
+// Feeds a captured process/thread start trace ([Logging] EventTrace=1 or
+// UnLeaf_Sim --record) through the real EngineCore and prints queue saturation
+// counters (text or JSON).
+//
+//   UnLeaf_Replay UnLeaf_events.ultrace --config UnLeaf.ini --max --pump 64
+
+#include "trace_replay.h"
+#include "../common/win_string_utils.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace unleaf;
+
+namespace {
+
+void PrintUsage() {
+    std::printf(
+        "UnLeaf_Replay - replay a captured event trace through the enforcement engine\n"
+        "\n"
+        "Usage: UnLeaf_Replay TRACE [options]\n"
+        "\n"
+        "Targets:\n"
+        "  --config FILE           UnLeaf.ini to replay against (copied)\n"
+        "  --target NAME           [Targets] entry (repeatable; ignored with --config)\n"
+        "\n"
+        "Timing:\n"
+        "  --max                   inject back to back (default: recorded inter-arrival gaps)\n"
+        "  --pump N                with --max: drain the control loop every N events\n"
+        "                          (default 256, 0 = only after the last event)\n"
+        "  --settle-ms N           virtual time to run after the last event (default 30000)\n"
+        "  --batch N               deliver process starts N per monitor batch, like one\n"
+        "                          ETW buffer (default 1)\n"
+        "\n"
+        "Output:\n"
+        "  --json                  machine-readable report\n");
+}
+
+bool ParseU64(const char* s, uint64_t& out) {
+    char* end = nullptr;
+    unsigned long long v = std::strtoull(s, &end, 10);
+    if (end == s || *end != '\0') return false;
+    out = v;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    sim::ReplayOptions options;
+    std::string tracePath;
+    bool json = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            PrintUsage();
+            return 0;
+        }
+        if (std::strcmp(arg, "--json") == 0) { json = true; continue; }
+        if (std::strcmp(arg, "--max") == 0) { options.speed = sim::ReplaySpeed::MAX; continue; }
+        if (arg[0] != '-') {
+            if (!tracePath.empty()) {
+                std::fprintf(stderr, "only one trace file can be replayed\n\n");
+                PrintUsage();
+                return 2;
+            }
+            tracePath = arg;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "missing value for %s\n\n", arg);
+            PrintUsage();
+            return 2;
+        }
+        const char* value = argv[++i];
+        uint64_t v = 0;
+        if (std::strcmp(arg, "--config") == 0) {
+            options.configPath = Utf8ToWide(value);
+        } else if (std::strcmp(arg, "--target") == 0) {
+            options.targets.push_back(Utf8ToWide(value));
+        } else if (std::strcmp(arg, "--pump") == 0 && ParseU64(value, v)) {
+            options.eventsPerPump = static_cast<uint32_t>(v);
+        } else if (std::strcmp(arg, "--settle-ms") == 0 && ParseU64(value, v)) {
+            options.settleMs = v;
+        } else if (std::strcmp(arg, "--batch") == 0 && ParseU64(value, v) && v > 0) {
+            options.eventsPerBatch = static_cast<uint32_t>(v);
+        } else {
+            std::fprintf(stderr, "unknown option or invalid value: %s %s\n\n", arg, value);
+            PrintUsage();
+            return 2;
+        }
+    }
+    if (tracePath.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    engine_logic::EventTraceReader trace;
+    if (!trace.Open(tracePath)) {
+        std::fprintf(stderr, "cannot read %s: missing file or not an UnLeaf event trace\n",
+                     tracePath.c_str());
+        return 1;
+    }
+
+    sim::TraceReplayer replayer(options);
+    sim::ReplayReport report;
+    std::string error;
+    if (!replayer.Run(trace, report, error)) {
+        std::fprintf(stderr, "replay failed: %s\n", error.c_str());
+        return 1;
+    }
+
+    const std::string out = json ? sim::FormatReplayJson(options, report)
+                                 : sim::FormatReplayText(options, report);
+    std::fputs(out.c_str(), stdout);
+    return 0;
+}
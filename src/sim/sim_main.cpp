@@ -0,0 +1,127 @@
+// UnLeaf - Simulator entry point
+// Runs a synthetic workload against the real EngineCore on a virtual clock and
+// prints kernel-call / latency / wakeup statistics (text or JSON).
+//
+//   UnLeaf_Sim --hours 8 --procs 40 --reapply-sec 30 --locked 2 --json
+
+#include "simulator.h"
+#include "../common/win_string_utils.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace unleaf;
+
+namespace {
+
+void PrintUsage() {
+    std::printf(
+        "UnLeaf_Sim - discrete-event simulation of the enforcement engine\n"
+        "\n"
+        "Workload:\n"
+        "  --hours N               simulated duration in hours (default 1)\n"
+        "  --minutes N             simulated duration in minutes\n"
+        "  --seed N                RNG seed (default 1)\n"
+        "  --procs N               target processes running at start (default 20)\n"
+        "  --arrivals-per-hour N   new target launches per hour (default 30)\n"
+        "  --lifetime-min N        mean lifetime of launched processes, minutes (default 30)\n"
+        "  --reapply-sec N         mean interval of OS EcoQoS re-application, seconds (default 60)\n"
+        "  --threads N             thread-start events per re-application (default 1)\n"
+        "  --children N            child processes per target (default 0)\n"
+        "  --locked N              additional always-EcoQoS-locked targets (default 0)\n"
+        "\n"
+        "Policy:\n"
+        "  --violation-threshold N violations before PERSISTENT (default 3)\n"
+        "  --verify1 MS --verify2 MS --verify-final MS   deferred verification delays\n"
+        "  --cache-ttl MS          EcoQoS state cache TTL\n"
+        "\n"
+        "Output:\n"
+        "  --json                  machine-readable report\n"
+        "  --record FILE           capture the generated event stream (UnLeaf_Replay input)\n");
+}
+
+bool ParseU64(const char* s, uint64_t& out) {
+    char* end = nullptr;
+    unsigned long long v = std::strtoull(s, &end, 10);
+    if (end == s || *end != '\0') return false;
+    out = v;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    sim::SimScenario scenario;
+    sim::SimProfile normal;
+    normal.exeName = L"app.exe";
+    normal.initialCount = 20;
+    normal.arrivalsPerHour = 30.0;
+    normal.meanLifetimeMs = 30ULL * 60 * 1000;
+    normal.meanReapplyMs = 60ULL * 1000;
+    uint64_t locked = 0;
+    bool json = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--json") == 0) { json = true; continue; }
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            PrintUsage();
+            return 0;
+        }
+        if (std::strcmp(arg, "--record") == 0 && i + 1 < argc) {
+            scenario.eventTracePath = Utf8ToWide(argv[++i]);
+            continue;
+        }
+        uint64_t v = 0;
+        if (i + 1 >= argc || !ParseU64(argv[i + 1], v)) {
+            std::fprintf(stderr, "invalid or missing value for %s\n\n", arg);
+            PrintUsage();
+            return 2;
+        }
+        ++i;
+        if      (std::strcmp(arg, "--hours") == 0)               scenario.durationMs = v * 3600000ULL;
+        else if (std::strcmp(arg, "--minutes") == 0)             scenario.durationMs = v * 60000ULL;
+        else if (std::strcmp(arg, "--seed") == 0)                scenario.seed = v;
+        else if (std::strcmp(arg, "--procs") == 0)               normal.initialCount = static_cast<uint32_t>(v);
+        else if (std::strcmp(arg, "--arrivals-per-hour") == 0)   normal.arrivalsPerHour = static_cast<double>(v);
+        else if (std::strcmp(arg, "--lifetime-min") == 0)        normal.meanLifetimeMs = v * 60000ULL;
+        else if (std::strcmp(arg, "--reapply-sec") == 0)         normal.meanReapplyMs = v * 1000ULL;
+        else if (std::strcmp(arg, "--threads") == 0)             normal.threadsPerReapply = static_cast<uint32_t>(v);
+        else if (std::strcmp(arg, "--children") == 0)            normal.childrenPerProcess = static_cast<uint32_t>(v);
+        else if (std::strcmp(arg, "--locked") == 0)              locked = v;
+        else if (std::strcmp(arg, "--violation-threshold") == 0) scenario.policy.violationThreshold = static_cast<uint32_t>(v);
+        else if (std::strcmp(arg, "--verify1") == 0)             scenario.policy.verifyDelay1Ms = static_cast<uint32_t>(v);
+        else if (std::strcmp(arg, "--verify2") == 0)             scenario.policy.verifyDelay2Ms = static_cast<uint32_t>(v);
+        else if (std::strcmp(arg, "--verify-final") == 0)        scenario.policy.verifyDelayFinalMs = static_cast<uint32_t>(v);
+        else if (std::strcmp(arg, "--cache-ttl") == 0)           scenario.policy.cacheDurationMs = v;
+        else {
+            std::fprintf(stderr, "unknown option %s\n\n", arg);
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    scenario.profiles.push_back(normal);
+    if (locked > 0) {
+        // Sandboxed processes whose EcoQoS cannot be cleared: long-lived, re-applied often
+        sim::SimProfile stubborn;
+        stubborn.exeName = L"locked.exe";
+        stubborn.initialCount = static_cast<uint32_t>(locked);
+        stubborn.meanReapplyMs = normal.meanReapplyMs;
+        stubborn.ecoLocked = true;
+        scenario.profiles.push_back(stubborn);
+    }
+
+    sim::Simulator simulator(scenario);
+    sim::SimReport report;
+    if (!simulator.Run(report)) {
+        std::fprintf(stderr, "simulation failed: engine initialization error\n");
+        return 1;
+    }
+
+    const std::string out = json ? sim::FormatReportJson(scenario, report)
+                                 : sim::FormatReportText(scenario, report);
+    std::fputs(out.c_str(), stdout);
+    return 0;
+}
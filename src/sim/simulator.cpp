@@ -0,0 +1,496 @@
+// UnLeaf - Deterministic discrete-event simulator
+// イベント駆動: 次の時刻 = min(シナリオイベント, FakePlatform タイマー期限)。
+// その時刻まで仮想時計を進め、イベントを注入し、制御ループを idle まで回す。
+
+#include "simulator.h"
+#include "../service/engine_core.h"
+#include "../common/logger.h"
+#include "../common/win_string_utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <queue>
+#include <random>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace unleaf {
+namespace sim {
+
+const uint64_t LatencyStats::BUCKET_UPPER_MS[LatencyStats::BUCKET_COUNT] = {
+    1, 10, 100, 1000, 5000, 10000, 30000, UINT64_MAX
+};
+
+namespace {
+
+enum class SimEventType : uint8_t {
+    LAUNCH,     // new process of profile `profile`
+    REAPPLY,    // OS re-enables EcoQoS on `pid`
+    EXIT        // `pid` terminates
+};
+
+struct SimEvent {
+    uint64_t timeMs;
+    uint64_t seq;          // FIFO tie-break for identical timestamps (determinism)
+    SimEventType type;
+    DWORD pid;
+    size_t profile;
+
+    bool operator>(const SimEvent& other) const {
+        return timeMs != other.timeMs ? timeMs > other.timeMs : seq > other.seq;
+    }
+};
+
+struct SimProcess {
+    size_t profile;
+    DWORD parentPid;
+    uint64_t ecoOnSince;   // 0 = EcoQoS currently OFF (no pending detection)
+};
+
+constexpr wchar_t CHILD_EXE_NAME[] = L"sim_child.exe";
+
+class Run {
+public:
+    Run(const SimScenario& scenario, platform::FakePlatform& fake, EngineCore& engine)
+        : scenario_(scenario), fake_(fake), engine_(engine), rng_(scenario.seed) {}
+
+    void Populate() {
+        for (size_t i = 0; i < scenario_.profiles.size(); ++i) {
+            const SimProfile& prof = scenario_.profiles[i];
+            for (uint32_t n = 0; n < prof.initialCount; ++n) {
+                SpawnTarget(i, 0, false);
+            }
+            ScheduleArrival(i, Now());
+        }
+    }
+
+    void Execute(SimReport& report) {
+        // Fake clock does not start at 0: all event times are absolute virtual ms
+        const uint64_t endMs = Now() + scenario_.durationMs;
+        DrainEngine(report);
+
+        for (;;) {
+            uint64_t next = endMs;
+            if (!events_.empty()) next = std::min(next, events_.top().timeMs);
+            const ULONGLONG timerDue = fake_.NextDueTime();
+            if (timerDue != 0) next = std::min<uint64_t>(next, timerDue);
+            if (next >= endMs) {
+                fake_.AdvanceTimeTo(endMs);
+                DrainEngine(report);
+                break;
+            }
+
+            // Timers due at `next` fire inside AdvanceTimeTo (callbacks enqueue requests)
+            fake_.AdvanceTimeTo(next);
+            while (!events_.empty() && events_.top().timeMs <= next) {
+                SimEvent ev = events_.top();
+                events_.pop();
+                Apply(ev, report);
+            }
+            DrainEngine(report);
+        }
+
+        // EcoQoS still ON at the end of the run was never detected
+        for (const auto& [pid, proc] : procs_) {
+            if (proc.ecoOnSince != 0) latency_.undetected++;
+        }
+        Finalize(report);
+    }
+
+private:
+    uint64_t Now() { return fake_.AsPlatform().clock.NowMs(); }
+
+    uint64_t Exponential(uint64_t meanMs) {
+        std::exponential_distribution<double> dist(1.0 / static_cast<double>(meanMs));
+        return std::max<uint64_t>(1, static_cast<uint64_t>(dist(rng_)));
+    }
+
+    void Push(uint64_t timeMs, SimEventType type, DWORD pid, size_t profile) {
+        events_.push(SimEvent{timeMs, seq_++, type, pid, profile});
+    }
+
+    void ScheduleArrival(size_t profile, uint64_t fromMs) {
+        const double perHour = scenario_.profiles[profile].arrivalsPerHour;
+        if (perHour <= 0.0) return;
+        const uint64_t meanMs = static_cast<uint64_t>(3600000.0 / perHour);
+        Push(fromMs + Exponential(std::max<uint64_t>(1, meanMs)), SimEventType::LAUNCH, 0, profile);
+    }
+
+    void ScheduleReapply(DWORD pid, size_t profile, uint64_t fromMs) {
+        const uint64_t mean = scenario_.profiles[profile].meanReapplyMs;
+        if (mean == 0) return;
+        Push(fromMs + Exponential(mean), SimEventType::REAPPLY, pid, profile);
+    }
+
+    // Spawns one target process (+ children). viaEtw: LaunchProcess (ETW start event)
+    // instead of a silent SpawnProcess picked up by InitialScan.
+    void SpawnTarget(size_t profile, uint64_t nowMs, bool viaEtw) {
+        const SimProfile& prof = scenario_.profiles[profile];
+        const DWORD pid = AllocPid();
+        SpawnOne(pid, SYSTEM_PID, prof.exeName, profile, viaEtw);
+
+        uint64_t exitAt = 0;
+        if (prof.meanLifetimeMs > 0) {
+            exitAt = nowMs + Exponential(prof.meanLifetimeMs);
+            Push(exitAt, SimEventType::EXIT, pid, profile);
+        }
+        for (uint32_t c = 0; c < prof.childrenPerProcess; ++c) {
+            const DWORD childPid = AllocPid();
+            SpawnOne(childPid, pid, CHILD_EXE_NAME, profile, viaEtw);
+            if (exitAt != 0) Push(exitAt, SimEventType::EXIT, childPid, profile);
+        }
+    }
+
+    void SpawnOne(DWORD pid, DWORD parentPid, const std::wstring& name,
+                  size_t profile, bool viaEtw) {
+        const SimProfile& prof = scenario_.profiles[profile];
+        if (viaEtw) {
+            fake_.LaunchProcess(pid, parentPid, name);
+        } else {
+            fake_.SpawnProcess(pid, parentPid, name);
+        }
+        fake_.SetThreadCount(pid, 4);
+        if (prof.ecoLocked) fake_.SetEcoLocked(pid, true);
+
+        // Windows starts background-launched processes with EcoQoS applied
+        fake_.SetEcoQoS(pid, true);
+        procs_[pid] = SimProcess{profile, parentPid, Now() + 1};  // +1: 0 means OFF
+        report_launched_++;
+        ScheduleReapply(pid, profile, Now());
+    }
+
+    DWORD AllocPid() {
+        const DWORD pid = nextPid_;
+        nextPid_ += 4;
+        return pid;
+    }
+
+    void Apply(const SimEvent& ev, SimReport& report) {
+        switch (ev.type) {
+            case SimEventType::LAUNCH:
+                SpawnTarget(ev.profile, ev.timeMs, true);
+                ScheduleArrival(ev.profile, ev.timeMs);
+                break;
+
+            case SimEventType::REAPPLY: {
+                auto it = procs_.find(ev.pid);
+                if (it == procs_.end()) break;   // exited
+                const SimProfile& prof = scenario_.profiles[ev.profile];
+                fake_.SetEcoQoS(ev.pid, true);
+                report.reapplications++;
+                if (it->second.ecoOnSince == 0) it->second.ecoOnSince = ev.timeMs + 1;
+                for (uint32_t t = 0; t < prof.threadsPerReapply; ++t) {
+                    fake_.EmitThreadStart(nextTid_, ev.pid);
+                    nextTid_ += 4;
+                }
+                ScheduleReapply(ev.pid, ev.profile, ev.timeMs);
+                break;
+            }
+
+            case SimEventType::EXIT: {
+                auto it = procs_.find(ev.pid);
+                if (it == procs_.end()) break;
+                if (it->second.ecoOnSince != 0) latency_.undetected++;
+                procs_.erase(it);
+                fake_.TerminateProcess(ev.pid);
+                report.processesExited++;
+                break;
+            }
+        }
+    }
+
+    // Run the control loop until no handle is signaled, then resolve detections
+    void DrainEngine(SimReport& report) {
+        for (;;) {
+            const size_t depth = engine_.GetQueueDepth();
+            depthSum_ += depth;
+            depthSamples_++;
+            report.maxQueueDepth = std::max(report.maxQueueDepth, depth);
+
+            const uint64_t before = fake_.Counters().wakeups;
+            engine_.RunControlLoopOnce(0);
+            if (fake_.Counters().wakeups == before) break;
+        }
+
+        const uint64_t now = Now();
+        for (auto& [pid, proc] : procs_) {
+            if (proc.ecoOnSince == 0) continue;
+            platform::FakeProcess fp;
+            if (!fake_.GetProcess(pid, fp) || fp.ecoQoS) continue;
+            latencies_.push_back(now - (proc.ecoOnSince - 1));
+            proc.ecoOnSince = 0;
+        }
+    }
+
+    void Finalize(SimReport& report) {
+        report.processesLaunched = report_launched_;
+        report.meanQueueDepth = depthSamples_ ? static_cast<double>(depthSum_) / depthSamples_ : 0.0;
+
+        LatencyStats& l = latency_;
+        l.samples = latencies_.size();
+        if (!latencies_.empty()) {
+            std::sort(latencies_.begin(), latencies_.end());
+            uint64_t sum = 0;
+            for (uint64_t v : latencies_) {
+                sum += v;
+                size_t b = 0;
+                while (v > LatencyStats::BUCKET_UPPER_MS[b]) ++b;
+                l.buckets[b]++;
+            }
+            auto pct = [this](double p) {
+                size_t idx = static_cast<size_t>(p * static_cast<double>(latencies_.size() - 1));
+                return latencies_[idx];
+            };
+            l.meanMs = sum / latencies_.size();
+            l.p50Ms = pct(0.50);
+            l.p90Ms = pct(0.90);
+            l.p99Ms = pct(0.99);
+            l.maxMs = latencies_.back();
+        }
+        report.latency = l;
+    }
+
+    static constexpr DWORD SYSTEM_PID = 4;
+
+    const SimScenario& scenario_;
+    platform::FakePlatform& fake_;
+    EngineCore& engine_;
+    std::mt19937_64 rng_;
+
+    std::priority_queue<SimEvent, std::vector<SimEvent>, std::greater<SimEvent>> events_;
+    uint64_t seq_ = 0;
+    std::map<DWORD, SimProcess> procs_;   // ordered: deterministic detection scan
+    DWORD nextPid_ = 1000;
+    DWORD nextTid_ = 2;
+    uint64_t report_launched_ = 0;
+
+    std::vector<uint64_t> latencies_;
+    LatencyStats latency_;
+    uint64_t depthSum_ = 0;
+    uint64_t depthSamples_ = 0;
+};
+
+bool WriteScenarioConfig(const fs::path& dir, const SimScenario& scenario) {
+    std::ofstream ini(dir / "UnLeaf.ini", std::ios::binary | std::ios::trunc);
+    if (!ini) return false;
+    ini << "[Logging]\nLogLevel=ERROR\nLogEnabled=0\n\n[Targets]\n";
+    for (const auto& prof : scenario.profiles) {
+        ini << WideToUtf8(prof.exeName.c_str()) << "=1\n";
+    }
+    return static_cast<bool>(ini);
+}
+
+} // namespace
+
+Simulator::Simulator(const SimScenario& scenario)
+    : scenario_(scenario) {}
+
+bool Simulator::Run(SimReport& report) {
+    report = SimReport{};
+    const auto wallStart = std::chrono::steady_clock::now();
+
+    fs::path dir = scenario_.workDir.empty()
+        ? fs::temp_directory_path() / ("unleaf_sim_" + std::to_string(scenario_.seed))
+        : fs::path(scenario_.workDir);
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if (!WriteScenarioConfig(dir, scenario_)) {
+        std::fprintf(stderr, "simulator: cannot write %s\n", (dir / "UnLeaf.ini").string().c_str());
+        return false;
+    }
+
+    platform::FakePlatform fake;
+    if (!scenario_.eventTracePath.empty() && !fake.SetEventTraceFile(scenario_.eventTracePath)) {
+        std::fprintf(stderr, "simulator: cannot create event trace\n");
+        return false;
+    }
+    {
+        EngineCore engine(fake.AsPlatform());
+        engine.SetPolicy(scenario_.policy);
+        if (!engine.Initialize(dir.wstring())) {
+            return false;
+        }
+
+        class Run run(scenario_, fake, engine);
+        run.Populate();
+        engine.Start(ControlLoopMode::CALLER_PUMPED);
+        run.Execute(report);
+
+        HealthInfo health = engine.GetHealthInfo();
+        report.wakeupEnforcementRequest = health.wakeupEnforcementRequest;
+        report.wakeupSafetyNet = health.wakeupSafetyNet;
+        report.wakeupProcessExit = health.wakeupProcessExit;
+        report.wakeupConfigChange = health.wakeupConfigChange;
+        report.totalViolations = health.totalViolations;
+        report.totalEnforcements = health.totalEnforcements;
+        report.persistentEnforceApplied = health.persistentEnforceApplied;
+        report.aggressiveAtEnd = health.aggressiveCount;
+        report.stableAtEnd = health.stableCount;
+        report.persistentAtEnd = health.persistentCount;
+
+        // Counters are taken before Stop(): shutdown cleanup is not steady-state cost
+        report.calls = fake.Counters();
+        engine.Stop();
+    }
+
+    report.simulatedMs = scenario_.durationMs;
+    const double minutes = static_cast<double>(scenario_.durationMs) / 60000.0;
+    report.wakeups = report.calls.wakeups;
+    if (minutes > 0.0) {
+        report.wakeupsPerMinute = static_cast<double>(report.calls.wakeups) / minutes;
+        report.kernelCallsPerMinute = static_cast<double>(report.calls.KernelCalls()) / minutes;
+    }
+    report.wallSeconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - wallStart).count();
+
+    if (scenario_.workDir.empty()) fs::remove_all(dir, ec);
+    return true;
+}
+
+// === Report formatting ===
+
+std::string FormatReportText(const SimScenario& scenario, const SimReport& r) {
+    std::ostringstream os;
+    char line[256];
+    auto emit = [&](const char* fmt, auto... args) {
+        std::snprintf(line, sizeof(line), fmt, args...);
+        os << line << '\n';
+    };
+
+    emit("=== UnLeaf simulation: %.2f h simulated in %.2f s wall (seed=%llu) ===",
+         static_cast<double>(r.simulatedMs) / 3600000.0, r.wallSeconds,
+         static_cast<unsigned long long>(scenario.seed));
+    emit("policy: violationThreshold=%u verify=%u/%u/%u ms cacheTtl=%llu ms",
+         scenario.policy.violationThreshold, scenario.policy.verifyDelay1Ms,
+         scenario.policy.verifyDelay2Ms, scenario.policy.verifyDelayFinalMs,
+         static_cast<unsigned long long>(scenario.policy.cacheDurationMs));
+    emit("processes: launched=%llu exited=%llu reapplications=%llu",
+         static_cast<unsigned long long>(r.processesLaunched),
+         static_cast<unsigned long long>(r.processesExited),
+         static_cast<unsigned long long>(r.reapplications));
+    emit("");
+    emit("kernel calls: total=%llu (%.1f/min)",
+         static_cast<unsigned long long>(r.calls.KernelCalls()), r.kernelCallsPerMinute);
+    emit("  openProcess=%llu closeHandle=%llu queryExitCode=%llu queryImage=%llu",
+         static_cast<unsigned long long>(r.calls.openProcess),
+         static_cast<unsigned long long>(r.calls.closeHandle),
+         static_cast<unsigned long long>(r.calls.queryExitCode),
+         static_cast<unsigned long long>(r.calls.queryImage));
+    emit("  setPriority=%llu setEcoQoS=%llu queryEcoQoS=%llu threadWalks=%llu threadsTouched=%llu",
+         static_cast<unsigned long long>(r.calls.setPriority),
+         static_cast<unsigned long long>(r.calls.setEcoQoS),
+         static_cast<unsigned long long>(r.calls.queryEcoQoS),
+         static_cast<unsigned long long>(r.calls.threadWalks),
+         static_cast<unsigned long long>(r.calls.threadsTouched));
+    emit("  registerWait=%llu unregisterWait=%llu jobAssign=%llu jobQuery=%llu snapshots=%llu",
+         static_cast<unsigned long long>(r.calls.registerWait),
+         static_cast<unsigned long long>(r.calls.unregisterWait),
+         static_cast<unsigned long long>(r.calls.jobAssign),
+         static_cast<unsigned long long>(r.calls.jobQuery),
+         static_cast<unsigned long long>(r.calls.snapshots));
+    emit("  createTimer=%llu deleteTimer=%llu timerFired=%llu setEvent=%llu",
+         static_cast<unsigned long long>(r.calls.createTimer),
+         static_cast<unsigned long long>(r.calls.deleteTimer),
+         static_cast<unsigned long long>(r.calls.timerFired),
+         static_cast<unsigned long long>(r.calls.setEvent));
+    emit("");
+    emit("wakeups: total=%llu (%.2f/min) enforce=%u safetyNet=%u exit=%u config=%u",
+         static_cast<unsigned long long>(r.wakeups), r.wakeupsPerMinute,
+         r.wakeupEnforcementRequest, r.wakeupSafetyNet, r.wakeupProcessExit, r.wakeupConfigChange);
+    emit("queue depth: max=%zu mean=%.3f", r.maxQueueDepth, r.meanQueueDepth);
+    emit("engine: violations=%u enforcements=%u persistentApplied=%u phases(end) A/S/P=%u/%u/%u",
+         r.totalViolations, r.totalEnforcements, r.persistentEnforceApplied,
+         r.aggressiveAtEnd, r.stableAtEnd, r.persistentAtEnd);
+    emit("");
+    const LatencyStats& l = r.latency;
+    emit("detection latency: samples=%llu undetected=%llu mean=%llu p50=%llu p90=%llu p99=%llu max=%llu ms",
+         static_cast<unsigned long long>(l.samples), static_cast<unsigned long long>(l.undetected),
+         static_cast<unsigned long long>(l.meanMs), static_cast<unsigned long long>(l.p50Ms),
+         static_cast<unsigned long long>(l.p90Ms), static_cast<unsigned long long>(l.p99Ms),
+         static_cast<unsigned long long>(l.maxMs));
+    uint64_t lower = 0;
+    for (size_t b = 0; b < LatencyStats::BUCKET_COUNT; ++b) {
+        const uint64_t upper = LatencyStats::BUCKET_UPPER_MS[b];
+        if (upper == UINT64_MAX) {
+            emit("  > %6llu ms : %llu", static_cast<unsigned long long>(lower),
+                 static_cast<unsigned long long>(l.buckets[b]));
+        } else {
+            emit("  <=%6llu ms : %llu", static_cast<unsigned long long>(upper),
+                 static_cast<unsigned long long>(l.buckets[b]));
+        }
+        lower = upper;
+    }
+    return os.str();
+}
+
+std::string FormatReportJson(const SimScenario& scenario, const SimReport& r) {
+    std::ostringstream os;
+    auto u = [](uint64_t v) { return std::to_string(v); };
+    os << "{\n";
+    os << "  \"seed\": " << u(scenario.seed) << ",\n";
+    os << "  \"simulatedMs\": " << u(r.simulatedMs) << ",\n";
+    os << "  \"wallSeconds\": " << r.wallSeconds << ",\n";
+    os << "  \"policy\": {\"violationThreshold\": " << scenario.policy.violationThreshold
+       << ", \"cacheDurationMs\": " << u(scenario.policy.cacheDurationMs)
+       << ", \"verifyDelay1Ms\": " << scenario.policy.verifyDelay1Ms
+       << ", \"verifyDelay2Ms\": " << scenario.policy.verifyDelay2Ms
+       << ", \"verifyDelayFinalMs\": " << scenario.policy.verifyDelayFinalMs << "},\n";
+    os << "  \"processes\": {\"launched\": " << u(r.processesLaunched)
+       << ", \"exited\": " << u(r.processesExited)
+       << ", \"reapplications\": " << u(r.reapplications) << "},\n";
+    os << "  \"kernelCalls\": {\"total\": " << u(r.calls.KernelCalls())
+       << ", \"perMinute\": " << r.kernelCallsPerMinute
+       << ", \"openProcess\": " << u(r.calls.openProcess)
+       << ", \"closeHandle\": " << u(r.calls.closeHandle)
+       << ", \"queryExitCode\": " << u(r.calls.queryExitCode)
+       << ", \"queryImage\": " << u(r.calls.queryImage)
+       << ", \"setPriority\": " << u(r.calls.setPriority)
+       << ", \"setEcoQoS\": " << u(r.calls.setEcoQoS)
+       << ", \"queryEcoQoS\": " << u(r.calls.queryEcoQoS)
+       << ", \"threadWalks\": " << u(r.calls.threadWalks)
+       << ", \"registerWait\": " << u(r.calls.registerWait)
+       << ", \"unregisterWait\": " << u(r.calls.unregisterWait)
+       << ", \"jobAssign\": " << u(r.calls.jobAssign)
+       << ", \"jobQuery\": " << u(r.calls.jobQuery)
+       << ", \"createTimer\": " << u(r.calls.createTimer)
+       << ", \"deleteTimer\": " << u(r.calls.deleteTimer)
+       << ", \"snapshots\": " << u(r.calls.snapshots)
+       << ", \"setEvent\": " << u(r.calls.setEvent) << "},\n";
+    os << "  \"wakeups\": {\"total\": " << u(r.wakeups)
+       << ", \"perMinute\": " << r.wakeupsPerMinute
+       << ", \"enforcementRequest\": " << r.wakeupEnforcementRequest
+       << ", \"safetyNet\": " << r.wakeupSafetyNet
+       << ", \"processExit\": " << r.wakeupProcessExit
+       << ", \"configChange\": " << r.wakeupConfigChange << "},\n";
+    os << "  \"queueDepth\": {\"max\": " << r.maxQueueDepth
+       << ", \"mean\": " << r.meanQueueDepth << "},\n";
+    os << "  \"engine\": {\"violations\": " << r.totalViolations
+       << ", \"enforcements\": " << r.totalEnforcements
+       << ", \"persistentApplied\": " << r.persistentEnforceApplied
+       << ", \"aggressive\": " << r.aggressiveAtEnd
+       << ", \"stable\": " << r.stableAtEnd
+       << ", \"persistent\": " << r.persistentAtEnd << "},\n";
+    const LatencyStats& l = r.latency;
+    os << "  \"latencyMs\": {\"samples\": " << u(l.samples)
+       << ", \"undetected\": " << u(l.undetected)
+       << ", \"mean\": " << u(l.meanMs) << ", \"p50\": " << u(l.p50Ms)
+       << ", \"p90\": " << u(l.p90Ms) << ", \"p99\": " << u(l.p99Ms)
+       << ", \"max\": " << u(l.maxMs) << ", \"buckets\": [";
+    for (size_t b = 0; b < LatencyStats::BUCKET_COUNT; ++b) {
+        if (b) os << ", ";
+        os << "{\"le\": ";
+        if (LatencyStats::BUCKET_UPPER_MS[b] == UINT64_MAX) os << "null";
+        else os << u(LatencyStats::BUCKET_UPPER_MS[b]);
+        os << ", \"count\": " << u(l.buckets[b]) << "}";
+    }
+    os << "]}\n}\n";
+    return os.str();
+}
+
+} // namespace sim
+} // namespace unleaf
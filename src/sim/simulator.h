@@ -0,0 +1,104 @@
+#pragma once
+// UnLeaf - Deterministic discrete-event simulator
+// 実際の EngineCore (DispatchEnforcementRequest / ScheduleDeferredVerification /
+// StartPersistentTimer) を FakePlatform の仮想時計上で駆動し、合成プロセス集団に
+// 対するカーネル呼び出し数・検出レイテンシ・wakeup 頻度・キュー深度を計測する。
+// 同一 SimScenario (seed 含む) からは常に同一の SimReport が得られる。
+
+#include "../service/engine_core.h"
+#include "../platform/fake/fake_platform.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace unleaf {
+namespace sim {
+
+// Synthetic process class (one [Targets] entry)
+struct SimProfile {
+    std::wstring exeName = L"app.exe";
+    uint32_t initialCount = 1;          // running before Start() (InitialScan path)
+    double   arrivalsPerHour = 0.0;     // Poisson launches during the run (ETW path)
+    uint64_t meanLifetimeMs = 0;        // exponential lifetime; 0 = lives for the whole run
+    uint64_t meanReapplyMs = 60000;     // OS re-enables EcoQoS (exponential); 0 = never
+    uint32_t threadsPerReapply = 1;     // ETW thread-start events emitted with each re-application
+    uint32_t childrenPerProcess = 0;    // child processes spawned right after launch
+    bool     ecoLocked = false;         // SetEcoQoSOff always fails (sandboxed process)
+};
+
+struct SimScenario {
+    uint64_t durationMs = 60ULL * 60 * 1000;   // simulated time
+    uint64_t seed = 1;
+    engine_logic::EnginePolicy policy = EngineCore::DefaultPolicy();
+    std::vector<SimProfile> profiles;
+    std::wstring workDir;                       // UnLeaf.ini / log directory; empty = temp dir
+    std::wstring eventTracePath;                // §9.27: capture delivered events (UnLeaf_Replay input)
+};
+
+// Detection latency: EcoQoS re-application -> engine turned it OFF again
+struct LatencyStats {
+    static constexpr size_t BUCKET_COUNT = 8;
+    static const uint64_t BUCKET_UPPER_MS[BUCKET_COUNT];   // last bucket = overflow
+
+    uint64_t samples = 0;
+    uint64_t undetected = 0;     // still ON at process exit / end of run
+    uint64_t meanMs = 0;
+    uint64_t p50Ms = 0;
+    uint64_t p90Ms = 0;
+    uint64_t p99Ms = 0;
+    uint64_t maxMs = 0;
+    uint64_t buckets[BUCKET_COUNT] = {};
+};
+
+struct SimReport {
+    uint64_t simulatedMs = 0;
+    double   wallSeconds = 0.0;
+
+    // Population
+    uint64_t processesLaunched = 0;
+    uint64_t processesExited = 0;
+    uint64_t reapplications = 0;
+
+    // Kernel calls (FakePlatform counters)
+    platform::FakeCallCounters calls;
+    double kernelCallsPerMinute = 0.0;
+
+    // Control loop wakeups
+    uint64_t wakeups = 0;
+    double   wakeupsPerMinute = 0.0;
+    uint32_t wakeupEnforcementRequest = 0;
+    uint32_t wakeupSafetyNet = 0;
+    uint32_t wakeupProcessExit = 0;
+    uint32_t wakeupConfigChange = 0;
+
+    // Enforcement queue depth (sampled before each control-loop drain)
+    size_t   maxQueueDepth = 0;
+    double   meanQueueDepth = 0.0;
+
+    // Engine outcome
+    uint32_t totalViolations = 0;
+    uint32_t totalEnforcements = 0;
+    uint32_t persistentEnforceApplied = 0;
+    uint32_t aggressiveAtEnd = 0;
+    uint32_t stableAtEnd = 0;
+    uint32_t persistentAtEnd = 0;
+
+    LatencyStats latency;
+};
+
+class Simulator {
+public:
+    explicit Simulator(const SimScenario& scenario);
+
+    // Runs the whole scenario; false if the engine failed to initialize
+    bool Run(SimReport& report);
+
+private:
+    SimScenario scenario_;
+};
+
+std::string FormatReportText(const SimScenario& scenario, const SimReport& report);
+std::string FormatReportJson(const SimScenario& scenario, const SimReport& report);
+
+} // namespace sim
+} // namespace unleaf
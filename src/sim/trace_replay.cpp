@@ -0,0 +1,274 @@
+// UnLeaf - Event trace replay (§9.27)
+// トレースの各イベントを FakePlatform のプロセス表へ反映してから監視コールバックとして
+// 発火させる (EngineCore から見ると ETW 経由の検出と同一)。キュー・ディスパッチ・
+// タイマーはすべて実装そのもの。
+
+#include "trace_replay.h"
+#include "../common/win_string_utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace unleaf {
+namespace sim {
+
+namespace {
+
+using engine_logic::EventTraceReader;
+using engine_logic::TraceEvent;
+using engine_logic::TraceEventType;
+
+class Replay {
+public:
+    Replay(platform::FakePlatform& fake, EngineCore& engine, uint32_t eventsPerBatch)
+        : fake_(fake), engine_(engine), eventsPerBatch_(eventsPerBatch) {}
+
+    void Inject(const TraceEvent& ev, ReplayReport& report) {
+        report.events++;
+        if (ev.type == TraceEventType::PROCESS_START) {
+            report.processStarts++;
+            if (eventsPerBatch_ > 1 && inBatch_ == 0) fake_.BeginEventBatch();
+            // The trace has no exit events: a reused PID means the previous owner is gone
+            platform::FakeProcess prev;
+            if (fake_.GetProcess(ev.pid, prev) && prev.alive) fake_.TerminateProcess(ev.pid);
+            fake_.SpawnProcess(ev.pid, ev.parentPid, ev.imageName, ev.imagePath);
+            // Windows starts background-launched processes with EcoQoS applied
+            fake_.SetEcoQoS(ev.pid, true);
+            threads_[ev.pid] = 1;
+            fake_.EmitProcessStart(ev.pid, ev.parentPid, ev.imageName, ev.imagePath);
+            if (eventsPerBatch_ > 1 && ++inBatch_ >= eventsPerBatch_) CloseBatch();
+        } else {
+            report.threadStarts++;
+            // Thread walks touch as many threads as the trace has started so far
+            auto it = threads_.find(ev.pid);
+            if (it != threads_.end()) fake_.SetThreadCount(ev.pid, ++it->second);
+            fake_.EmitThreadStart(ev.tid, ev.pid);
+        }
+    }
+
+    // Delivers a partially filled batch (before time moves or the control loop runs)
+    void CloseBatch() {
+        if (inBatch_ == 0) return;
+        fake_.EndEventBatch();
+        inBatch_ = 0;
+    }
+
+    // Virtual time up to targetMs, draining the control loop after every timer expiry
+    void AdvanceTo(uint64_t targetMs, ReplayReport& report) {
+        CloseBatch();
+        for (;;) {
+            const ULONGLONG due = fake_.NextDueTime();
+            if (due == 0 || due <= Now() || due > targetMs) break;
+            fake_.AdvanceTimeTo(due);
+            Drain(report);
+        }
+        fake_.AdvanceTimeTo(targetMs);
+        Drain(report);
+    }
+
+    // Run the control loop until no handle is signaled
+    void Drain(ReplayReport& report) {
+        CloseBatch();
+        for (;;) {
+            report.maxQueueDepth = std::max(report.maxQueueDepth, engine_.GetQueueDepth());
+            const uint64_t before = fake_.Counters().wakeups;
+            engine_.RunControlLoopOnce(0);
+            if (fake_.Counters().wakeups == before) break;
+        }
+    }
+
+    uint64_t Now() { return fake_.AsPlatform().clock.NowMs(); }
+
+private:
+    platform::FakePlatform& fake_;
+    EngineCore& engine_;
+    const uint32_t eventsPerBatch_;
+    uint32_t inBatch_ = 0;
+    std::unordered_map<uint32_t, int> threads_;
+};
+
+bool WriteReplayConfig(const fs::path& dir, const ReplayOptions& options, std::string& error) {
+    const fs::path ini = dir / "UnLeaf.ini";
+    if (!options.configPath.empty()) {
+        std::error_code ec;
+        fs::copy_file(fs::path(options.configPath), ini, fs::copy_options::overwrite_existing, ec);
+        if (ec) error = "cannot copy " + fs::path(options.configPath).string() + ": " + ec.message();
+        return !ec;
+    }
+    std::ofstream out(ini, std::ios::binary | std::ios::trunc);
+    out << "[Logging]\nLogLevel=ERROR\nLogEnabled=0\n\n[Targets]\n";
+    for (const auto& name : options.targets) {
+        out << WideToUtf8(name.c_str()) << "=1\n";
+    }
+    if (!out) error = "cannot write " + ini.string();
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+TraceReplayer::TraceReplayer(const ReplayOptions& options)
+    : options_(options) {}
+
+bool TraceReplayer::Run(EventTraceReader& trace, ReplayReport& report, std::string& error) {
+    report = ReplayReport{};
+    if (trace.GetStatus() != EventTraceReader::Status::OK) {
+        error = "not an UnLeaf event trace (bad header)";
+        return false;
+    }
+
+    static uint32_t runCounter = 0;
+    fs::path dir = options_.workDir.empty()
+        ? fs::temp_directory_path() / ("unleaf_replay_" + std::to_string(
+              std::chrono::steady_clock::now().time_since_epoch().count()) +
+              "_" + std::to_string(++runCounter))
+        : fs::path(options_.workDir);
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if (!WriteReplayConfig(dir, options_, error)) return false;
+
+    platform::FakePlatform fake;
+    bool ok = true;
+    {
+        EngineCore engine(fake.AsPlatform());
+        engine.SetPolicy(options_.policy);
+        if (!engine.Initialize(dir.wstring())) {
+            error = "engine initialization failed";
+            ok = false;
+        } else {
+            Replay replay(fake, engine, options_.eventsPerBatch);
+            engine.Start(ControlLoopMode::CALLER_PUMPED);
+            replay.Drain(report);
+
+            const auto wallStart = std::chrono::steady_clock::now();
+            const uint64_t baseMs = replay.Now();
+            uint64_t firstTs = 0;
+            uint64_t lastTs = 0;
+            uint32_t sincePump = 0;
+            TraceEvent ev;
+            while (trace.Next(ev)) {
+                if (report.events == 0) firstTs = ev.timestampUs;
+                lastTs = std::max(lastTs, ev.timestampUs);
+                if (options_.speed == ReplaySpeed::RECORDED) {
+                    // ETW timestamps may step back slightly across CPUs: never rewind the clock
+                    const uint64_t offsetMs = ev.timestampUs > firstTs ? (ev.timestampUs - firstTs) / 1000 : 0;
+                    if (baseMs + offsetMs > replay.Now()) replay.AdvanceTo(baseMs + offsetMs, report);
+                }
+                replay.Inject(ev, report);
+                if (options_.speed == ReplaySpeed::MAX && options_.eventsPerPump != 0 &&
+                    ++sincePump >= options_.eventsPerPump) {
+                    replay.Drain(report);
+                    sincePump = 0;
+                }
+            }
+            replay.Drain(report);
+            report.wallSeconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - wallStart).count();
+
+            if (trace.GetStatus() == EventTraceReader::Status::BAD_FORMAT) {
+                error = "malformed record after " + std::to_string(report.events) + " events";
+                ok = false;
+            }
+            report.truncated = (trace.GetStatus() == EventTraceReader::Status::TRUNCATED);
+            report.tracedSpanUs = report.events ? lastTs - firstTs : 0;
+            if (report.wallSeconds > 0.0) {
+                report.eventsPerSecond = static_cast<double>(report.events) / report.wallSeconds;
+            }
+
+            replay.AdvanceTo(replay.Now() + options_.settleMs, report);
+
+            HealthInfo health = engine.GetHealthInfo();
+            report.enforcementDrops = health.enforcementDropCount;
+            report.criticalDrops = health.criticalDropCount;
+            report.criticalEvicts = health.criticalEvictCount;
+            report.threadDeduped = health.etwThreadDeduped;
+            report.totalEnforcements = health.totalEnforcements;
+            report.wakeupEnforcementRequest = health.wakeupEnforcementRequest;
+            report.processBatches = health.etwProcessBatches;
+            report.trackedAtEnd = health.activeProcesses;
+            report.calls = fake.Counters();
+            engine.Stop();
+        }
+    }
+
+    if (options_.workDir.empty()) fs::remove_all(dir, ec);
+    return ok;
+}
+
+// === Report formatting ===
+
+std::string FormatReplayText(const ReplayOptions& options, const ReplayReport& r) {
+    std::ostringstream os;
+    char line[256];
+    auto emit = [&](const char* fmt, auto... args) {
+        std::snprintf(line, sizeof(line), fmt, args...);
+        os << line << '\n';
+    };
+
+    emit("=== UnLeaf replay: %llu events (%.3f s traced) in %.3f s wall, %.0f events/s ===",
+         static_cast<unsigned long long>(r.events),
+         static_cast<double>(r.tracedSpanUs) / 1e6, r.wallSeconds, r.eventsPerSecond);
+    if (options.speed == ReplaySpeed::MAX) {
+        emit("speed: max (drain every %u events)", options.eventsPerPump);
+    } else {
+        emit("speed: recorded");
+    }
+    if (options.eventsPerBatch > 1) emit("batch: %u process starts per monitor batch", options.eventsPerBatch);
+    emit("trace: processStarts=%llu threadStarts=%llu%s",
+         static_cast<unsigned long long>(r.processStarts),
+         static_cast<unsigned long long>(r.threadStarts),
+         r.truncated ? " (truncated)" : "");
+    emit("");
+    emit("queue: maxDepth=%zu drops=%u criticalDrops=%u criticalEvicts=%u threadDeduped=%u",
+         r.maxQueueDepth, r.enforcementDrops, r.criticalDrops, r.criticalEvicts, r.threadDeduped);
+    emit("engine: enforcements=%u enforceWakeups=%u processBatches=%u tracked(end)=%zu",
+         r.totalEnforcements, r.wakeupEnforcementRequest, r.processBatches, r.trackedAtEnd);
+    emit("kernel calls: total=%llu openProcess=%llu setEcoQoS=%llu threadWalks=%llu threadsTouched=%llu",
+         static_cast<unsigned long long>(r.calls.KernelCalls()),
+         static_cast<unsigned long long>(r.calls.openProcess),
+         static_cast<unsigned long long>(r.calls.setEcoQoS),
+         static_cast<unsigned long long>(r.calls.threadWalks),
+         static_cast<unsigned long long>(r.calls.threadsTouched));
+    return os.str();
+}
+
+std::string FormatReplayJson(const ReplayOptions& options, const ReplayReport& r) {
+    std::ostringstream os;
+    auto u = [](uint64_t v) { return std::to_string(v); };
+    os << "{\n";
+    os << "  \"speed\": \"" << (options.speed == ReplaySpeed::MAX ? "max" : "recorded") << "\",\n";
+    os << "  \"eventsPerPump\": " << options.eventsPerPump << ",\n";
+    os << "  \"eventsPerBatch\": " << options.eventsPerBatch << ",\n";
+    os << "  \"trace\": {\"events\": " << u(r.events)
+       << ", \"processStarts\": " << u(r.processStarts)
+       << ", \"threadStarts\": " << u(r.threadStarts)
+       << ", \"spanUs\": " << u(r.tracedSpanUs)
+       << ", \"truncated\": " << (r.truncated ? "true" : "false") << "},\n";
+    os << "  \"wallSeconds\": " << r.wallSeconds << ",\n";
+    os << "  \"eventsPerSecond\": " << r.eventsPerSecond << ",\n";
+    os << "  \"queue\": {\"maxDepth\": " << r.maxQueueDepth
+       << ", \"drops\": " << r.enforcementDrops
+       << ", \"criticalDrops\": " << r.criticalDrops
+       << ", \"criticalEvicts\": " << r.criticalEvicts
+       << ", \"threadDeduped\": " << r.threadDeduped << "},\n";
+    os << "  \"engine\": {\"enforcements\": " << r.totalEnforcements
+       << ", \"enforceWakeups\": " << r.wakeupEnforcementRequest
+       << ", \"processBatches\": " << r.processBatches
+       << ", \"trackedAtEnd\": " << r.trackedAtEnd << "},\n";
+    os << "  \"kernelCalls\": {\"total\": " << u(r.calls.KernelCalls())
+       << ", \"openProcess\": " << u(r.calls.openProcess)
+       << ", \"setEcoQoS\": " << u(r.calls.setEcoQoS)
+       << ", \"threadWalks\": " << u(r.calls.threadWalks)
+       << ", \"threadsTouched\": " << u(r.calls.threadsTouched) << "}\n";
+    os << "}\n";
+    return os.str();
+}
+
+} // namespace sim
+} // namespace unleaf
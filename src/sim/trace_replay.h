@@ -0,0 +1,87 @@
+#pragma once
+// UnLeaf - Event trace replay (§9.27)
+// [Logging] EventTrace=1 (ProcessMonitor) または UnLeaf_Sim --record で記録した
+// プロセス/スレッド開始イベント列を、実 EngineCore (FakePlatform) の OnProcessStartBatch /
+// OnThreadStart へ再投入する。本番ビルドエージェントのイベントストームに対する
+// キュー飽和 (enforcementDropCount_ / criticalDropCount_ / criticalEvictCount_) を
+// ラボで決定的に再現するためのもの。同一トレース + 同一 ReplayOptions からは
+// 常に同一の ReplayReport (wallSeconds / eventsPerSecond を除く) が得られる。
+//
+// 制御ループのモデル:
+//   RECORDED: 仮想時計をトレースのタイムスタンプに追従させ、時計が進むたびに
+//             制御ループを idle まで回す (同一ミリ秒内のイベントはまとめてキューに積まれる)
+//   MAX     : タイムスタンプを無視して連続投入し、eventsPerPump 件ごとに 1 回だけ
+//             制御ループを回す (ETW スレッドが制御スレッドを追い越すストームの上限)
+// eventsPerBatch: ProcessStart を N 件ずつ 1 バッチ (ETW バッファ 1 つ) として配信する (§9.29)。
+//             時計を進める前・制御ループを回す前には開いているバッチを必ず閉じる。
+
+#include "../service/engine_core.h"
+#include "../platform/fake/fake_platform.h"
+#include "../engine/event_trace.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace unleaf {
+namespace sim {
+
+enum class ReplaySpeed : uint8_t {
+    RECORDED,   // honor recorded inter-arrival gaps (virtual time)
+    MAX         // back-to-back injection
+};
+
+struct ReplayOptions {
+    ReplaySpeed speed = ReplaySpeed::RECORDED;
+    uint32_t eventsPerPump = 256;     // MAX only: control-loop drain every N events (0 = after the last event)
+    uint32_t eventsPerBatch = 1;      // process starts per monitor batch (§9.29; 1 = one callback per event)
+    uint64_t settleMs = 30000;        // virtual time run after the last event (deferred verification)
+    std::vector<std::wstring> targets;   // [Targets] names (ignored when configPath is set)
+    std::wstring configPath;             // production UnLeaf.ini to replay against (copied)
+    engine_logic::EnginePolicy policy = EngineCore::DefaultPolicy();
+    std::wstring workDir;                // UnLeaf.ini / log directory; empty = temp dir
+};
+
+struct ReplayReport {
+    // Trace
+    uint64_t events = 0;
+    uint64_t processStarts = 0;
+    uint64_t threadStarts = 0;
+    uint64_t tracedSpanUs = 0;       // last - first timestamp
+    bool     truncated = false;      // capture was cut mid-record (earlier records replayed)
+
+    // Throughput (wall clock; injection + drains, settle excluded)
+    double   wallSeconds = 0.0;
+    double   eventsPerSecond = 0.0;
+
+    // Queue saturation (§9.14-A)
+    size_t   maxQueueDepth = 0;
+    uint32_t enforcementDrops = 0;
+    uint32_t criticalDrops = 0;
+    uint32_t criticalEvicts = 0;
+    uint32_t threadDeduped = 0;      // §9.23 enqueue-time coalescing
+
+    // Engine outcome
+    uint32_t totalEnforcements = 0;
+    uint32_t wakeupEnforcementRequest = 0;
+    uint32_t processBatches = 0;     // OnProcessStartBatch calls
+    size_t   trackedAtEnd = 0;
+    platform::FakeCallCounters calls;
+};
+
+class TraceReplayer {
+public:
+    explicit TraceReplayer(const ReplayOptions& options);
+
+    // Replays the trace from its current position. false = engine init failure or
+    // unreadable trace (error describes it).
+    bool Run(engine_logic::EventTraceReader& trace, ReplayReport& report, std::string& error);
+
+private:
+    ReplayOptions options_;
+};
+
+std::string FormatReplayText(const ReplayOptions& options, const ReplayReport& report);
+std::string FormatReplayJson(const ReplayOptions& options, const ReplayReport& report);
+
+} // namespace sim
+} // namespace unleaf
@@ -1,9 +1,14 @@
 // UnLeaf Unit Tests - Config parser/serializer/target management
-// Tests: ParseIni, SerializeIni, AddTarget, RemoveTarget, IsTargetEnabled, SetTargetEnabled
+// Tests: ParseIni, SerializeIni, AddTarget, RemoveTarget, IsTargetEnabled, SetTargetEnabled,
+//        content-hash change detection
 
 #include <gtest/gtest.h>
 #include "common/config.h"
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
 using namespace unleaf;
 
 // ============================================================
@@ -76,6 +81,17 @@ TEST_F(ConfigParserTest, LogEnabledFalse) {
     EXPECT_FALSE(config().IsLogEnabled());
 }
 
+TEST_F(ConfigParserTest, EventTraceOptIn) {
+    EXPECT_TRUE(callParseIni("[Logging]\nLogEnabled=1\n"));
+    EXPECT_FALSE(config().IsEventTraceEnabled());
+    EXPECT_EQ(callSerializeIni().find("EventTrace"), std::string::npos);
+
+    EXPECT_TRUE(callParseIni("[Logging]\nEventTrace=1\n"));
+    EXPECT_TRUE(config().IsEventTraceEnabled());
+    EXPECT_TRUE(callParseIni(callSerializeIni()));
+    EXPECT_TRUE(config().IsEventTraceEnabled());
+}
+
 TEST_F(ConfigParserTest, InvalidTargetIgnored) {
     EXPECT_TRUE(callParseIni("[Targets]\n..\\evil.exe=1\n"));
     EXPECT_TRUE(config().GetTargets().empty());
@@ -171,6 +187,42 @@ TEST_F(ConfigParserTest, RoundTrip) {
     EXPECT_FALSE(targets[1].enabled);
 }
 
+// --- HasContentChanged (§9.34) ---
+
+TEST_F(ConfigParserTest, ContentHashIgnoresTouchAndIdenticalSave) {
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "unleaf_config_hash";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const fs::path ini = dir / "UnLeaf.ini";
+    std::ofstream(ini, std::ios::binary) << "[Targets]\nnotepad.exe=1\n";
+    ASSERT_TRUE(config().Initialize(dir.wstring()));
+    EXPECT_FALSE(config().HasContentChanged());
+
+    // Same bytes, newer time stamp (touch / editor save without edits)
+    auto bump = [&] { fs::last_write_time(ini, fs::last_write_time(ini) + std::chrono::seconds(2)); };
+    std::ofstream(ini, std::ios::binary | std::ios::trunc) << "[Targets]\nnotepad.exe=1\n";
+    bump();
+    EXPECT_TRUE(config().HasFileChanged());
+    EXPECT_FALSE(config().HasContentChanged());
+    EXPECT_FALSE(config().HasFileChanged());   // adopted: next check stops at the time stamp
+
+    // Our own Save() is not an external edit
+    config().Save();
+    bump();
+    EXPECT_FALSE(config().HasContentChanged());
+
+    std::ofstream(ini, std::ios::binary | std::ios::app) << "calc.exe=1\n";
+    bump();
+    EXPECT_TRUE(config().HasContentChanged());
+    EXPECT_TRUE(config().HasContentChanged());   // stays changed until Reload()
+    ASSERT_TRUE(config().Reload());
+    EXPECT_FALSE(config().HasContentChanged());
+    EXPECT_EQ(config().GetTargets().size(), 2u);
+
+    fs::remove_all(dir);
+}
+
 // ============================================================
 // ConfigTargetTest - target management via public API
 // (inherits ConfigParserTest for SetUp cleanup via friend access)
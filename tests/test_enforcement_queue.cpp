@@ -0,0 +1,375 @@
+// UnLeaf Unit Tests - Lock-free enforcement queue (§9.22)
+// Tests: MpscRing FIFO / capacity, SOFT/HARD/TOTAL admission and eviction, high-water marks,
+//        ETW_PROCESS_START interned image round trip / reference ownership,
+//        ETW_THREAD_START thread ID round trip, evicted ETW_PROCESS_START PID reporting,
+//        multi-producer stress
+
+#include <gtest/gtest.h>
+#include "engine/mpsc_ring.h"
+#include "engine/pid_bitmap.h"
+#include "service/enforcement_queue.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace unleaf;
+using engine_logic::MpscRing;
+using engine_logic::StringInternTable;
+using PushResult = EnforcementQueue::PushResult;
+
+namespace {
+
+EnforcementRequest ThreadStart(DWORD pid) {
+    return EnforcementRequest(pid, EnforcementRequestType::ETW_THREAD_START);
+}
+
+EnforcementRequest SafetyNet(DWORD pid) {
+    return EnforcementRequest(pid, EnforcementRequestType::SAFETY_NET);
+}
+
+EnforcementRequest ProcessStart(DWORD pid, DWORD parentPid, const wchar_t* image) {
+    return EnforcementRequest(pid, parentPid, StringInternTable::Instance().Intern(image));
+}
+
+void ReleaseAll(const std::vector<EnforcementRequest>& reqs) {
+    for (const auto& r : reqs) StringInternTable::Instance().Release(r.imageId);
+}
+
+PushResult Push(EnforcementQueue& q, const EnforcementRequest& req) {
+    bool wasEmpty = false;
+    return q.Push(req, wasEmpty);
+}
+
+std::vector<DWORD> Pids(const std::vector<EnforcementRequest>& reqs) {
+    std::vector<DWORD> out;
+    for (const auto& r : reqs) out.push_back(r.pid);
+    return out;
+}
+
+} // namespace
+
+// ============================================================
+// MpscRing
+// ============================================================
+
+TEST(MpscRingTest, FifoAndCapacity) {
+    MpscRing<uint32_t> ring(5);
+    EXPECT_EQ(ring.capacity(), 8u);
+    for (uint32_t i = 0; i < 8; ++i) EXPECT_TRUE(ring.TryPush(i));
+    EXPECT_FALSE(ring.TryPush(99));
+
+    uint32_t v = 0;
+    for (uint32_t i = 0; i < 8; ++i) {
+        ASSERT_TRUE(ring.TryPop(v));
+        EXPECT_EQ(v, i);
+    }
+    EXPECT_FALSE(ring.TryPop(v));
+}
+
+TEST(MpscRingTest, WrapsAround) {
+    MpscRing<uint32_t> ring(4);
+    uint32_t v = 0;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(ring.TryPush(i));
+        ASSERT_TRUE(ring.TryPop(v));
+        EXPECT_EQ(v, i);
+    }
+}
+
+TEST(MpscRingTest, MultiProducerStressPreservesPerProducerOrder) {
+    constexpr uint32_t kProducers = 4;
+    constexpr uint32_t kPerProducer = 200000;
+    MpscRing<uint32_t> ring(1024);
+
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (uint32_t i = 0; i < kPerProducer; ++i) {
+                const uint32_t value = (p << 24) | i;
+                while (!ring.TryPush(value)) std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<uint32_t> next(kProducers, 0);
+    uint64_t received = 0;
+    uint64_t outOfOrder = 0;
+    uint32_t v = 0;
+    while (received < uint64_t{kProducers} * kPerProducer) {
+        if (!ring.TryPop(v)) { std::this_thread::yield(); continue; }
+        const uint32_t p = v >> 24;
+        const uint32_t i = v & 0xFFFFFF;
+        if (p >= kProducers || i != next[p]) ++outOfOrder;
+        else ++next[p];
+        ++received;
+    }
+    for (auto& t : producers) t.join();
+
+    EXPECT_EQ(outOfOrder, 0u);
+    for (uint32_t p = 0; p < kProducers; ++p) EXPECT_EQ(next[p], kPerProducer);
+    EXPECT_FALSE(ring.TryPop(v));
+}
+
+// ============================================================
+// EnforcementQueue admission (§9.14-A semantics)
+// ============================================================
+
+TEST(EnforcementQueueTest, WasEmptyOnlyOnFirstPush) {
+    EnforcementQueue q(8, 8, 8);
+    bool wasEmpty = false;
+    EXPECT_EQ(q.Push(ThreadStart(1), wasEmpty), PushResult::ACCEPTED);
+    EXPECT_TRUE(wasEmpty);
+    EXPECT_EQ(q.Push(SafetyNet(2), wasEmpty), PushResult::ACCEPTED);
+    EXPECT_FALSE(wasEmpty);
+
+    std::vector<EnforcementRequest> out;
+    q.PopCritical(out, 8);
+    q.PopNonCritical(out);
+    EXPECT_TRUE(q.Empty());
+    EXPECT_EQ(q.Push(ThreadStart(3), wasEmpty), PushResult::ACCEPTED);
+    EXPECT_TRUE(wasEmpty);
+}
+
+TEST(EnforcementQueueTest, NonCriticalDropsAtSoftLimit) {
+    EnforcementQueue q(4, 8, 16);
+    for (DWORD i = 0; i < 4; ++i) EXPECT_EQ(Push(q, ThreadStart(i)), PushResult::ACCEPTED);
+    EXPECT_EQ(Push(q, ThreadStart(99)), PushResult::DROPPED_NONCRITICAL);
+    EXPECT_EQ(q.NonCriticalSize(), 4u);
+}
+
+TEST(EnforcementQueueTest, NonCriticalDropsAtTotalLimit) {
+    EnforcementQueue q(8, 8, 8);
+    for (DWORD i = 0; i < 6; ++i) Push(q, SafetyNet(i));
+    EXPECT_EQ(Push(q, ThreadStart(100)), PushResult::ACCEPTED);
+    EXPECT_EQ(Push(q, ThreadStart(101)), PushResult::ACCEPTED);
+    EXPECT_EQ(Push(q, ThreadStart(102)), PushResult::DROPPED_NONCRITICAL);
+}
+
+TEST(EnforcementQueueTest, CriticalDropsAtHardLimit) {
+    EnforcementQueue q(4, 4, 8);
+    for (DWORD i = 0; i < 4; ++i) EXPECT_EQ(Push(q, SafetyNet(i)), PushResult::ACCEPTED);
+    EXPECT_EQ(Push(q, SafetyNet(99)), PushResult::DROPPED_CRITICAL);
+    EXPECT_EQ(q.CriticalSize(), 4u);
+}
+
+TEST(EnforcementQueueTest, CriticalAtTotalEvictsOldestNonCritical) {
+    EnforcementQueue q(4, 8, 4);
+    for (DWORD i = 1; i <= 4; ++i) Push(q, ThreadStart(i));
+    EXPECT_EQ(Push(q, SafetyNet(50)), PushResult::ACCEPTED_EVICTED_NONCRITICAL);
+    EXPECT_EQ(Push(q, SafetyNet(51)), PushResult::ACCEPTED_EVICTED_NONCRITICAL);
+    EXPECT_EQ(q.NonCriticalSize(), 2u);
+    EXPECT_EQ(q.CriticalSize(), 2u);
+
+    std::vector<EnforcementRequest> nc, crit;
+    q.PopNonCritical(nc);
+    q.PopCritical(crit, 16);
+    EXPECT_EQ(Pids(nc), (std::vector<DWORD>{3, 4}));
+    EXPECT_EQ(Pids(crit), (std::vector<DWORD>{50, 51}));
+    EXPECT_TRUE(q.Empty());
+}
+
+// TOTAL < HARD (rejected by EngineCore's static_assert) is the only way to reach this branch
+TEST(EnforcementQueueTest, CriticalAtTotalEvictsOldestCriticalWhenNoNonCritical) {
+    EnforcementQueue q(4, 8, 4);
+    for (DWORD i = 1; i <= 4; ++i) Push(q, SafetyNet(i));
+    EXPECT_EQ(Push(q, SafetyNet(5)), PushResult::ACCEPTED_EVICTED_CRITICAL);
+    EXPECT_EQ(q.CriticalSize(), 4u);
+
+    std::vector<EnforcementRequest> crit;
+    q.PopCritical(crit, 16);
+    EXPECT_EQ(Pids(crit), (std::vector<DWORD>{2, 3, 4, 5}));
+}
+
+TEST(EnforcementQueueTest, PopCriticalHonorsBurstLimit) {
+    EnforcementQueue q(8, 16, 16);
+    for (DWORD i = 0; i < 10; ++i) Push(q, SafetyNet(i));
+    std::vector<EnforcementRequest> out;
+    EXPECT_EQ(q.PopCritical(out, 4), 4u);
+    EXPECT_EQ(q.CriticalSize(), 6u);
+    EXPECT_EQ(out.front().pid, 0u);
+    EXPECT_EQ(out.back().pid, 3u);
+}
+
+// §9.35: logical length peaks (eviction does not raise the NON-CRITICAL mark)
+TEST(EnforcementQueueTest, HighWaterMarksTrackPeakLength) {
+    EnforcementQueue q(4, 8, 4);
+    for (DWORD i = 1; i <= 3; ++i) Push(q, ThreadStart(i));
+    Push(q, SafetyNet(50));
+    Push(q, SafetyNet(51));   // evicts one NON-CRITICAL
+    EXPECT_EQ(q.NonCriticalHighWater(), 3u);
+    EXPECT_EQ(q.CriticalHighWater(), 2u);
+
+    std::vector<EnforcementRequest> out;
+    q.PopCritical(out, 16);
+    q.PopNonCritical(out);
+    EXPECT_TRUE(q.Empty());
+    EXPECT_EQ(q.CriticalHighWater(), 2u);   // survives the drain
+
+    Push(q, SafetyNet(52));
+    q.ResetHighWater();                      // restarts from the current length
+    EXPECT_EQ(q.CriticalHighWater(), 1u);
+    EXPECT_EQ(q.NonCriticalHighWater(), 0u);
+}
+
+TEST(EnforcementQueueTest, ProcessStartImageRoundTrip) {
+    StringInternTable& strings = StringInternTable::Instance();
+    EnforcementQueue q(8, 8, 8);
+    Push(q, ProcessStart(1234, 4, L"C:\\Windows\\queue_roundtrip.exe"));
+    Push(q, EnforcementRequest(77, EnforcementRequestType::DEFERRED_VERIFICATION, 2));
+
+    std::vector<EnforcementRequest> out;
+    ASSERT_EQ(q.PopCritical(out, 8), 2u);
+    EXPECT_EQ(out[0].type, EnforcementRequestType::ETW_PROCESS_START);
+    EXPECT_EQ(out[0].parentPid, 4u);
+    EXPECT_EQ(strings.View(out[0].imageId), L"C:\\Windows\\queue_roundtrip.exe");
+    EXPECT_EQ(strings.RefCount(out[0].imageId), 1u);   // owned by the delivered request
+    EXPECT_EQ(out[1].type, EnforcementRequestType::DEFERRED_VERIFICATION);
+    EXPECT_EQ(out[1].verifyStep, 2u);
+    EXPECT_EQ(out[1].imageId, StringInternTable::EMPTY);
+
+    const size_t live = strings.LiveCount();
+    ReleaseAll(out);
+    EXPECT_EQ(strings.LiveCount(), live - 1);
+}
+
+// §9.39: the new thread's ID survives the NON-CRITICAL slot
+TEST(EnforcementQueueTest, ThreadStartCarriesThreadId) {
+    EnforcementQueue q(8, 8, 8);
+    EnforcementRequest req = ThreadStart(500);
+    req.threadId = 5012;
+    Push(q, req);
+    Push(q, ThreadStart(600));   // TID unknown
+
+    std::vector<EnforcementRequest> out;
+    ASSERT_EQ(q.PopNonCritical(out), 2u);
+    EXPECT_EQ(out[0].pid, 500u);
+    EXPECT_EQ(out[0].threadId, 5012u);
+    EXPECT_EQ(out[1].threadId, 0u);
+}
+
+// Push consumes the reference on every outcome; eviction releases it in the queue
+TEST(EnforcementQueueTest, DroppedAndEvictedProcessStartsReleaseImage) {
+    StringInternTable& strings = StringInternTable::Instance();
+    const size_t live = strings.LiveCount();
+    {
+        EnforcementQueue q(8, 2, 8);   // HARD = 2
+        EXPECT_EQ(Push(q, ProcessStart(1, 4, L"queue_drop.exe")), PushResult::ACCEPTED);
+        EXPECT_EQ(Push(q, ProcessStart(2, 4, L"queue_drop.exe")), PushResult::ACCEPTED);
+        EXPECT_EQ(Push(q, ProcessStart(3, 4, L"queue_drop.exe")), PushResult::DROPPED_CRITICAL);
+        std::vector<EnforcementRequest> out;
+        ASSERT_EQ(q.PopCritical(out, 8), 2u);
+        EXPECT_EQ(strings.RefCount(out[0].imageId), 2u);
+        ReleaseAll(out);
+    }
+    {
+        EnforcementQueue q(8, 8, 2);   // TOTAL = 2
+        Push(q, ProcessStart(1, 4, L"queue_evict.exe"));
+        Push(q, ProcessStart(2, 4, L"queue_evict.exe"));
+        EXPECT_EQ(Push(q, ProcessStart(3, 4, L"queue_evict.exe")), PushResult::ACCEPTED_EVICTED_CRITICAL);
+        std::vector<EnforcementRequest> out;
+        ASSERT_EQ(q.PopCritical(out, 8), 2u);
+        EXPECT_EQ(Pids(out), (std::vector<DWORD>{2, 3}));
+        EXPECT_EQ(strings.RefCount(out[0].imageId), 2u);
+        ReleaseAll(out);
+    }
+    {
+        EnforcementQueue q(8, 8, 0);   // TOTAL = 0: nothing to evict, dropped
+        EXPECT_EQ(Push(q, ProcessStart(1, 4, L"queue_no_total.exe")), PushResult::DROPPED_CRITICAL);
+        EXPECT_TRUE(q.Empty());
+    }
+    {
+        EnforcementQueue q(8, 8, 8);   // destroyed with requests still queued
+        Push(q, ProcessStart(1, 4, L"queue_abandon.exe"));
+    }
+    EXPECT_EQ(strings.LiveCount(), live);
+}
+
+// §9.36: evicted ETW_PROCESS_START PIDs are reported so the engine can drop their pending-start bits
+TEST(EnforcementQueueTest, EvictedProcessStartPidsAreReported) {
+    EnforcementQueue q(8, 8, 3);   // TOTAL = 3
+    engine_logic::PidBitmap pendingStart;   // mirrors EngineCore::pendingStartFilter_
+    auto pushStart = [&](DWORD pid) {
+        pendingStart.Set(pid);
+        return Push(q, ProcessStart(pid, 4, L"queue_pending.exe"));
+    };
+    pushStart(10);
+    Push(q, SafetyNet(11));
+    pushStart(12);
+    EXPECT_EQ(pushStart(13), PushResult::ACCEPTED_EVICTED_CRITICAL);   // evicts 10
+    EXPECT_EQ(pushStart(14), PushResult::ACCEPTED_EVICTED_CRITICAL);   // evicts SafetyNet(11)
+    EXPECT_EQ(pushStart(15), PushResult::ACCEPTED_EVICTED_CRITICAL);   // evicts 12
+
+    std::vector<EnforcementRequest> out;
+    std::vector<DWORD> evicted;
+    ASSERT_EQ(q.PopCritical(out, 8, &evicted), 3u);
+    EXPECT_EQ(Pids(out), (std::vector<DWORD>{13, 14, 15}));
+    EXPECT_EQ(evicted, (std::vector<DWORD>{10, 12}));   // SafetyNet never set a bit
+
+    for (DWORD pid : evicted) pendingStart.Clear(pid);
+    for (const auto& req : out) pendingStart.Clear(req.pid);   // Dispatch clears delivered starts
+    for (DWORD pid : {10u, 12u, 13u, 14u, 15u}) EXPECT_FALSE(pendingStart.Test(pid)) << pid;
+    ReleaseAll(out);
+}
+
+// Producers race the consumer through SOFT/HARD/TOTAL pressure; every accepted
+// request is either delivered once or accounted for as an eviction.
+TEST(EnforcementQueueTest, MultiProducerStressAccountsForEveryRequest) {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 50000;
+    EnforcementQueue q(64, 128, 128);
+
+    std::atomic<uint64_t> accepted{0}, dropped{0}, evicted{0};
+    std::atomic<int> running{kProducers};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                const DWORD pid = static_cast<DWORD>(p * kPerProducer + i);
+                EnforcementRequest req = (i % 3 == 0) ? SafetyNet(pid) : ThreadStart(pid);
+                if (i % 97 == 0) req = ProcessStart(pid, 4, L"c:\\queue_stress.exe");
+                bool wasEmpty = false;
+                switch (q.Push(req, wasEmpty)) {
+                    case PushResult::ACCEPTED:
+                        accepted++; break;
+                    case PushResult::ACCEPTED_EVICTED_NONCRITICAL:
+                    case PushResult::ACCEPTED_EVICTED_CRITICAL:
+                        accepted++; evicted++; break;
+                    default:
+                        dropped++; break;
+                }
+            }
+            running--;
+        });
+    }
+
+    uint64_t delivered = 0;
+    std::vector<EnforcementRequest> out;
+    while (running.load() > 0 || !q.Empty()) {
+        out.clear();
+        q.PopCritical(out, 32);
+        q.PopNonCritical(out);
+        for (const auto& r : out) {
+            if (r.type == EnforcementRequestType::ETW_PROCESS_START) {
+                EXPECT_EQ(StringInternTable::Instance().View(r.imageId), L"c:\\queue_stress.exe");
+            }
+        }
+        ReleaseAll(out);
+        delivered += out.size();
+        if (out.empty()) std::this_thread::yield();
+    }
+    for (auto& t : producers) t.join();
+    out.clear();
+    q.PopCritical(out, 1u << 20);
+    q.PopNonCritical(out);
+    ReleaseAll(out);
+    delivered += out.size();
+
+    EXPECT_EQ(accepted + dropped, uint64_t{kProducers} * kPerProducer);
+    EXPECT_EQ(delivered, accepted - evicted);
+    EXPECT_TRUE(q.Empty());
+    // every reference was dropped, evicted or delivered exactly once
+    const StringInternTable::Id probe = StringInternTable::Instance().Intern(L"c:\\queue_stress.exe");
+    EXPECT_EQ(StringInternTable::Instance().RefCount(probe), 1u);
+    StringInternTable::Instance().Release(probe);
+}
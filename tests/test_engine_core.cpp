@@ -0,0 +1,953 @@
+// UnLeaf Unit Tests - EngineCore control loop against the in-memory FakePlatform
+// Tests: target launch tracking, exit cleanup (handles/waits/timers), SafetyNet
+//        violation phase transitions, child tracking, Stop() resource release,
+//        dispatch kernel I/O outside trackedCs_, stale-commit detection,
+//        enqueue-time ETW_THREAD_START coalescing, lock-free thread-event filter,
+//        event-source exits replacing per-process exit waits,
+//        file-scoped config watch + content-hash reload skip,
+//        per-tick system snapshot shared by scans and thread throttling,
+//        thread events enforced on the new thread only,
+//        SafetyNet negative classification cache,
+//        path-target start prefilter by image file name
+
+#include <gtest/gtest.h>
+#include "service/engine_core.h"
+#include "platform/fake/fake_platform.h"
+#include "common/config.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace unleaf;
+using unleaf::platform::FakePlatform;
+using unleaf::platform::FakeProcess;
+
+namespace fs = std::filesystem;
+
+// ============================================================
+// EngineCoreTest - friend access to EngineCore private state.
+// The control loop is CALLER_PUMPED: each test drives it
+// deterministically on the test thread via Pump().
+// ============================================================
+
+class EngineCoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        dir_ = fs::temp_directory_path() /
+               (std::string("unleaf_engine_") + info->name());
+        fs::remove_all(dir_);
+        fs::create_directories(dir_);
+        std::ofstream(dir_ / "UnLeaf.ini") << "[Targets]\nnotepad.exe=1\n";
+
+        engine_ = std::make_unique<EngineCore>(fake_.AsPlatform());
+        ASSERT_TRUE(engine_->Initialize(dir_.wstring()));
+    }
+
+    void TearDown() override {
+        engine_.reset();
+        std::error_code ec;
+        fs::remove_all(dir_, ec);
+    }
+
+    void Start() { engine_->Start(ControlLoopMode::CALLER_PUMPED); }
+
+    // Run the control loop until no handle is signaled
+    void Pump(int iterations = 16) {
+        for (int i = 0; i < iterations; ++i) {
+            engine_->RunControlLoopOnce(0);
+        }
+    }
+
+    // Advance virtual time in 100ms slices, pumping between slices
+    void AdvanceAndPump(ULONGLONG ms) {
+        for (ULONGLONG t = 0; t < ms; t += 100) {
+            fake_.AdvanceTime(100);
+            Pump();
+        }
+    }
+
+    bool IsTracked(DWORD pid) { return engine_->IsTracked(pid); }
+
+    ProcessPhase PhaseOf(DWORD pid) {
+        CSLockGuard lock(engine_->trackedCs_);
+        auto it = engine_->trackedProcesses_.find(pid);
+        if (it == engine_->trackedProcesses_.end()) {
+            ADD_FAILURE() << "PID " << pid << " not tracked";
+            return ProcessPhase::AGGRESSIVE;
+        }
+        return it.hot().phase;
+    }
+
+    bool IsChildOf(DWORD pid, DWORD rootPid) {
+        CSLockGuard lock(engine_->trackedCs_);
+        auto it = engine_->trackedProcesses_.find(pid);
+        if (it == engine_->trackedProcesses_.end()) return false;
+        return it.cold()->isChild && it.cold()->rootTargetPid == rootPid;
+    }
+
+    uint32_t TotalViolations() { return engine_->totalViolations_.load(); }
+
+    // Probes trackedCs_ from another thread (the CS is recursive on the owner)
+    bool TrackedLockFreeElsewhere() {
+        bool acquired = false;
+        std::thread probe([&] {
+            acquired = engine_->trackedCs_.try_lock();
+            if (acquired) engine_->trackedCs_.unlock();
+        });
+        probe.join();
+        return acquired;
+    }
+
+    void BumpStateVersion(DWORD pid) {
+        CSLockGuard lock(engine_->trackedCs_);
+        engine_->trackedProcesses_.find(pid).hot().stateVersion++;
+    }
+
+    CriticalSection& TrackedCs() { return engine_->trackedCs_; }
+    void SetPhase(DWORD pid, ProcessPhase phase) { engine_->SetProcessPhase(pid, phase); }
+    void Dispatch(const EnforcementRequest& req) { engine_->DispatchEnforcementRequest(req); }
+    uint32_t CommitConflicts() { return engine_->dispatchCommitConflicts_.load(); }
+    uint32_t ThreadDeduped() { return engine_->etwThreadDeduped_.load(); }
+    bool ThreadFilterBit(DWORD pid) { return engine_->threadEventFilter_.Test(pid); }
+    engine_logic::StringInternTable::Id TrackedNameId(DWORD pid) {
+        CSLockGuard lock(engine_->trackedCs_);
+        auto it = engine_->trackedProcesses_.find(pid);
+        return it == engine_->trackedProcesses_.end() ? 0 : it.cold()->name.id();
+    }
+    uint32_t EnforcementDrops() { return engine_->enforcementDropCount_.load(); }
+    uint64_t MonitorExits() { return engine_->monitorExitCount_.load(); }
+    size_t QueueDepth() { return engine_->GetQueueDepth(); }
+    bool HasPathTargets() { return engine_->HasPathTargets(); }
+    bool Enqueue(const EnforcementRequest& req) { return engine_->EnqueueRequest(req); }
+    void DrainQueue() { engine_->ProcessEnforcementQueue(); }
+
+    static constexpr size_t kQueueTotalLimit = EngineCore::ENFORCEMENT_QUEUE_TOTAL_LIMIT;
+    static constexpr size_t kQueueHardLimit  = EngineCore::ENFORCEMENT_QUEUE_HARD_LIMIT;
+
+    static constexpr ULONGLONG kDeferredVerifyFinal = EngineCore::DEFERRED_VERIFY_FINAL;
+    static constexpr ULONGLONG kSafetyNetInterval   = EngineCore::SAFETY_NET_INTERVAL;
+    static constexpr ULONGLONG kSafetyScanBackstop  = EngineCore::SAFETY_SCAN_BACKSTOP_MS;
+    static constexpr uint32_t  kViolationThreshold  = EngineCore::VIOLATION_THRESHOLD;
+    static constexpr uint32_t  kSafetyScanPerTick   = EngineCore::MAX_SAFETY_SCAN_PER_TICK;
+
+    FakeProcess Proc(DWORD pid) {
+        FakeProcess p;
+        EXPECT_TRUE(fake_.GetProcess(pid, p));
+        return p;
+    }
+
+    FakePlatform fake_;
+    std::unique_ptr<EngineCore> engine_;
+    fs::path dir_;
+};
+
+TEST_F(EngineCoreTest, TargetLaunchIsTrackedAndEnforced) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    fake_.SetEcoQoS(1000, true);
+    Pump();
+
+    ASSERT_TRUE(IsTracked(1000));
+    EXPECT_EQ(PhaseOf(1000), ProcessPhase::AGGRESSIVE);
+    FakeProcess p = Proc(1000);
+    EXPECT_FALSE(p.ecoQoS);
+    EXPECT_EQ(p.priorityClass, static_cast<DWORD>(UNLEAF_TARGET_PRIORITY));
+    EXPECT_NE(p.job, 0u);
+    EXPECT_EQ(fake_.ActiveWaitCount(), 1u);
+}
+
+TEST_F(EngineCoreTest, NonTargetLaunchIsIgnored) {
+    Start();
+    fake_.LaunchProcess(1001, 4, L"calc.exe");
+    Pump();
+
+    EXPECT_FALSE(IsTracked(1001));
+    EXPECT_EQ(fake_.OpenProcessHandleCount(), 0u);
+}
+
+TEST_F(EngineCoreTest, InitialScanTracksRunningTarget) {
+    fake_.SpawnProcess(1002, 4, L"notepad.exe");
+    Start();
+    Pump();
+
+    EXPECT_TRUE(IsTracked(1002));
+}
+
+TEST_F(EngineCoreTest, AggressivePhaseSettlesToStable) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    Pump();
+    ASSERT_TRUE(IsTracked(1000));
+
+    AdvanceAndPump(kDeferredVerifyFinal + 500);
+    EXPECT_EQ(PhaseOf(1000), ProcessPhase::STABLE);
+}
+
+TEST_F(EngineCoreTest, ExitRemovesProcessWithoutLeaks) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    Pump();
+    ASSERT_TRUE(IsTracked(1000));
+    ASSERT_GT(fake_.OpenProcessHandleCount(), 0u);
+
+    fake_.TerminateProcess(1000);
+    Pump();
+
+    EXPECT_FALSE(IsTracked(1000));
+    EXPECT_EQ(fake_.OpenProcessHandleCount(), 0u);
+    EXPECT_EQ(fake_.ActiveWaitCount(), 0u);
+    EXPECT_EQ(fake_.ActiveTimerCount(), 0u);
+    EXPECT_EQ(fake_.JobCount(), 0u);
+}
+
+TEST_F(EngineCoreTest, SafetyNetViolationEscalatesToPersistent) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    Pump();
+    AdvanceAndPump(kDeferredVerifyFinal + 500);
+    ASSERT_EQ(PhaseOf(1000), ProcessPhase::STABLE);
+
+    // Each SafetyNet tick that finds EcoQoS re-enabled on a STABLE process is a violation
+    for (uint32_t i = 0; i < kViolationThreshold; ++i) {
+        while (PhaseOf(1000) != ProcessPhase::STABLE) {
+            AdvanceAndPump(1000);
+        }
+        fake_.SetEcoQoS(1000, true);
+        AdvanceAndPump(kSafetyNetInterval);
+    }
+
+    EXPECT_EQ(PhaseOf(1000), ProcessPhase::PERSISTENT);
+    EXPECT_FALSE(Proc(1000).ecoQoS);
+    EXPECT_GE(TotalViolations(), kViolationThreshold);
+}
+
+TEST_F(EngineCoreTest, ChildOfTrackedParentIsTracked) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    Pump();
+    fake_.LaunchProcess(1100, 1000, L"helper.exe");
+    Pump();
+
+    ASSERT_TRUE(IsTracked(1100));
+    EXPECT_TRUE(IsChildOf(1100, 1000));
+}
+
+TEST_F(EngineCoreTest, StopReleasesAllResources) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    fake_.LaunchProcess(1100, 1000, L"helper.exe");
+    Pump();
+    ASSERT_TRUE(IsTracked(1000));
+
+    engine_->Stop();
+
+    EXPECT_FALSE(fake_.IsMonitorRunning());
+    EXPECT_EQ(fake_.OpenProcessHandleCount(), 0u);
+    EXPECT_EQ(fake_.ActiveWaitCount(), 0u);
+    EXPECT_EQ(fake_.ActiveTimerCount(), 0u);
+}
+
+TEST_F(EngineCoreTest, DispatchKernelCallsRunWithoutTrackedLock) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    Pump();
+    AdvanceAndPump(kDeferredVerifyFinal + 500);
+    ASSERT_EQ(PhaseOf(1000), ProcessPhase::STABLE);
+    const uint32_t violationsBefore = TotalViolations();
+
+    int calls = 0;
+    int blocked = 0;
+    fake_.SetProcessCallHook([&] {
+        ++calls;
+        if (!TrackedLockFreeElsewhere()) ++blocked;
+    });
+
+    // SafetyNet violation: query + PulseEnforce + timer scheduling
+    fake_.SetEcoQoS(1000, true);
+    AdvanceAndPump(kSafetyNetInterval);
+    fake_.SetProcessCallHook(nullptr);
+
+    EXPECT_GT(calls, 0);
+    EXPECT_EQ(blocked, 0);
+    EXPECT_EQ(TotalViolations(), violationsBefore + 1);
+    EXPECT_FALSE(Proc(1000).ecoQoS);
+}
+
+TEST_F(EngineCoreTest, StaleDispatchCommitIsDropped) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    Pump();
+    AdvanceAndPump(kDeferredVerifyFinal + 500);
+    ASSERT_EQ(PhaseOf(1000), ProcessPhase::STABLE);
+    const uint32_t violationsBefore = TotalViolations();
+
+    // State changes while the kernel call runs unlocked: the plan is stale
+    bool bumped = false;
+    fake_.SetProcessCallHook([&] {
+        if (!bumped) { bumped = true; BumpStateVersion(1000); }
+    });
+    fake_.SetEcoQoS(1000, true);
+    Dispatch(EnforcementRequest(1000, EnforcementRequestType::SAFETY_NET));
+    fake_.SetProcessCallHook(nullptr);
+
+    EXPECT_EQ(CommitConflicts(), 1u);
+    EXPECT_EQ(TotalViolations(), violationsBefore);
+    EXPECT_EQ(PhaseOf(1000), ProcessPhase::STABLE);
+    // The kernel side effect (EcoQoS cleared) still happened
+    EXPECT_FALSE(Proc(1000).ecoQoS);
+}
+
+TEST_F(EngineCoreTest, ThreadStormCoalescesToOneRequestPerPid) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    fake_.LaunchProcess(1001, 4, L"notepad.exe");
+    Pump();
+    AdvanceAndPump(kDeferredVerifyFinal + 500);
+    ASSERT_EQ(PhaseOf(1000), ProcessPhase::STABLE);
+    ASSERT_EQ(PhaseOf(1001), ProcessPhase::STABLE);
+    ASSERT_EQ(QueueDepth(), 0u);
+    const uint32_t dropsBefore = EnforcementDrops();
+    const uint32_t dedupedBefore = ThreadDeduped();
+
+    // Storm far beyond SOFT_LIMIT: occupancy stays at one slot per tracked PID
+    for (DWORD tid = 1; tid <= 5000; ++tid) {
+        fake_.EmitThreadStart(tid, (tid & 1) ? 1000 : 1001);
+    }
+    EXPECT_EQ(QueueDepth(), 2u);
+    EXPECT_EQ(EnforcementDrops(), dropsBefore);
+    EXPECT_EQ(ThreadDeduped(), dedupedBefore + 4998);
+
+    // Drained: the next thread event enqueues again
+    Pump();
+    EXPECT_EQ(QueueDepth(), 0u);
+    fake_.EmitThreadStart(9000, 1000);
+    EXPECT_EQ(QueueDepth(), 1u);
+    EXPECT_EQ(ThreadDeduped(), dedupedBefore + 4998);
+}
+
+TEST_F(EngineCoreTest, EvictedThreadRequestReleasesCoalescingSlot) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    Pump();
+    AdvanceAndPump(kDeferredVerifyFinal + 500);
+    ASSERT_EQ(PhaseOf(1000), ProcessPhase::STABLE);
+
+    fake_.EmitThreadStart(1, 1000);
+    ASSERT_EQ(QueueDepth(), 1u);
+
+    // CRITICAL pressure at TOTAL_LIMIT evicts the pending ETW_THREAD_START
+    for (size_t i = 0; i < kQueueTotalLimit; ++i) {
+        Enqueue(EnforcementRequest(50000, EnforcementRequestType::SAFETY_NET));
+    }
+    while (QueueDepth() > 0) DrainQueue();
+
+    const uint32_t dedupedBefore = ThreadDeduped();
+    fake_.EmitThreadStart(2, 1000);
+    EXPECT_EQ(QueueDepth(), 1u);
+    EXPECT_EQ(ThreadDeduped(), dedupedBefore);
+}
+
+TEST_F(EngineCoreTest, ThreadStartNeverTakesTrackedLock) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    Pump();
+    AdvanceAndPump(kDeferredVerifyFinal + 500);
+    ASSERT_EQ(PhaseOf(1000), ProcessPhase::STABLE);
+
+    // Another thread holds trackedCs_ for the whole callback (a regression deadlocks here)
+    std::atomic<bool> held{false}, release{false};
+    std::thread holder([&] {
+        CSLockGuard lock(TrackedCs());
+        held = true;
+        while (!release) std::this_thread::yield();
+    });
+    while (!held) std::this_thread::yield();
+    fake_.EmitThreadStart(1, 1000);
+    fake_.EmitThreadStart(2, 1000);
+    fake_.EmitThreadStart(3, 1002);   // untracked
+    const size_t depth = QueueDepth();
+    release = true;
+    holder.join();
+    EXPECT_EQ(depth, 1u);
+}
+
+TEST_F(EngineCoreTest, ThreadEventTargetsFollowPhaseAndRemoval) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    Pump();
+    ASSERT_EQ(PhaseOf(1000), ProcessPhase::AGGRESSIVE);
+
+    // AGGRESSIVE: deferred verification owns the process, thread events are filtered
+    fake_.EmitThreadStart(1, 1000);
+    EXPECT_EQ(QueueDepth(), 0u);
+
+    // STABLE (committed by the control loop): published before the loop iteration returns
+    AdvanceAndPump(kDeferredVerifyFinal + 500);
+    ASSERT_EQ(PhaseOf(1000), ProcessPhase::STABLE);
+    fake_.EmitThreadStart(2, 1000);
+    EXPECT_EQ(QueueDepth(), 1u);
+    Pump();
+
+    // External phase change republishes immediately
+    SetPhase(1000, ProcessPhase::AGGRESSIVE);
+    fake_.EmitThreadStart(3, 1000);
+    EXPECT_EQ(QueueDepth(), 0u);
+    SetPhase(1000, ProcessPhase::PERSISTENT);
+    fake_.EmitThreadStart(4, 1000);
+    EXPECT_EQ(QueueDepth(), 1u);
+    Pump();
+
+    // Exit: removed from the snapshot with the tracked entry
+    fake_.TerminateProcess(1000);
+    Pump();
+    ASSERT_FALSE(IsTracked(1000));
+    fake_.EmitThreadStart(5, 1000);
+    EXPECT_EQ(QueueDepth(), 0u);
+}
+
+TEST_F(EngineCoreTest, ThreadStartPrefilterRejectsUntrackedInMonitor) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    Pump();
+    EXPECT_FALSE(ThreadFilterBit(1000));   // AGGRESSIVE: not a thread-event target yet
+    AdvanceAndPump(kDeferredVerifyFinal + 500);
+    ASSERT_EQ(PhaseOf(1000), ProcessPhase::STABLE);
+    EXPECT_TRUE(ThreadFilterBit(1000));
+
+    const ULONGLONG second = (fake_.AsPlatform().clock.NowMs() / 1000 + 1) * 1000;
+    fake_.AdvanceTimeTo(second);
+    for (DWORD i = 0; i < 200; ++i) fake_.EmitThreadStart(50000 + i, 2000 + 4 * (i % 50));
+    fake_.EmitThreadStart(1, 1000);
+    fake_.EmitThreadStart(2, 1000);
+
+    HealthInfo h = engine_->GetHealthInfo();
+    EXPECT_EQ(h.etwThreadFiltered, 200u);
+    EXPECT_EQ(h.etwThreadForwarded, 2u);
+    EXPECT_EQ(h.etwThreadFilteredPerSec, 0u);   // the second is still open
+    EXPECT_EQ(ThreadDeduped(), 1u);             // only forwarded events reach the engine
+    EXPECT_EQ(QueueDepth(), 1u);
+
+    fake_.AdvanceTimeTo(second + 1000);
+    h = engine_->GetHealthInfo();
+    EXPECT_EQ(h.etwThreadFilteredPerSec, 200u);
+    EXPECT_EQ(h.etwThreadForwardedPerSec, 2u);
+    Pump();
+
+    // Exit clears the bit once the snapshot has dropped the PID
+    fake_.TerminateProcess(1000);
+    Pump();
+    ASSERT_FALSE(IsTracked(1000));
+    EXPECT_FALSE(ThreadFilterBit(1000));
+    fake_.EmitThreadStart(3, 1000);
+    EXPECT_EQ(engine_->GetHealthInfo().etwThreadFiltered, 201u);
+
+    engine_->Stop();
+    EXPECT_FALSE(ThreadFilterBit(1000));
+}
+
+// §9.39: a single thread event boosts that thread alone (no snapshot, no walk); threads
+// coalesced behind a queued request are covered by one sweep of the whole process.
+TEST_F(EngineCoreTest, ThreadEventEnforcesOnlyTheNewThread) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    fake_.SetThreadCount(1000, 300);
+    Pump();
+    AdvanceAndPump(kDeferredVerifyFinal + 500);
+    ASSERT_EQ(PhaseOf(1000), ProcessPhase::STABLE);
+
+    fake_.SetEcoQoS(1000, true);
+    fake_.ResetCounters();
+    fake_.EmitThreadStart(platform::FakePlatform::ThreadIdOf(1000, 7), 1000);
+    Pump();
+    platform::FakeCallCounters calls = fake_.Counters();
+    EXPECT_FALSE(Proc(1000).ecoQoS);
+    EXPECT_EQ(calls.threadsTouched, 1u);
+    EXPECT_EQ(calls.threadWalks, 0u);
+    EXPECT_EQ(calls.snapshots, 0u);
+    EXPECT_EQ(engine_->GetHealthInfo().etwThreadScoped, 1u);
+    EXPECT_NE(PhaseOf(1000), ProcessPhase::STABLE);   // the phase machinery takes over
+
+    // Storm: three threads, one request, one sweep (from the tick snapshot)
+    while (PhaseOf(1000) != ProcessPhase::STABLE) AdvanceAndPump(1000);
+    fake_.SetEcoQoS(1000, true);
+    fake_.ResetCounters();
+    for (int i = 0; i < 3; ++i) fake_.EmitThreadStart(platform::FakePlatform::ThreadIdOf(1000, i), 1000);
+    EXPECT_EQ(QueueDepth(), 1u);
+    Pump();
+    calls = fake_.Counters();
+    EXPECT_EQ(calls.threadsTouched, 300u);
+    EXPECT_EQ(calls.threadWalks, 0u);
+    EXPECT_EQ(engine_->GetHealthInfo().etwThreadScoped, 1u);
+}
+
+// §9.39: a TID the scoped call cannot touch (exited / not in the owner) falls back to the sweep
+TEST_F(EngineCoreTest, UnknownThreadEventFallsBackToProcessSweep) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    fake_.SetThreadCount(1000, 300);
+    Pump();
+    AdvanceAndPump(kDeferredVerifyFinal + 500);
+    ASSERT_EQ(PhaseOf(1000), ProcessPhase::STABLE);
+
+    fake_.SetEcoQoS(1000, true);
+    fake_.ResetCounters();
+    fake_.EmitThreadStart(platform::FakePlatform::ThreadIdOf(1000, 400), 1000);   // already exited
+    Pump();
+    const platform::FakeCallCounters calls = fake_.Counters();
+    EXPECT_FALSE(Proc(1000).ecoQoS);
+    EXPECT_EQ(calls.threadsTouched, 300u);   // whole process, from the tick snapshot
+    EXPECT_EQ(engine_->GetHealthInfo().etwThreadScoped, 0u);
+}
+
+TEST_F(EngineCoreTest, ProcessStartBatchWakesControlLoopOnce) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    Pump();
+    const HealthInfo before = engine_->GetHealthInfo();
+
+    // One ETW buffer: targets, a child of a tracked parent, a critical image, a non-target
+    fake_.BeginEventBatch();
+    for (DWORD i = 0; i < 50; ++i) fake_.LaunchProcess(2000 + 4 * i, 4, L"notepad.exe");
+    fake_.LaunchProcess(3000, 1000, L"helper.exe");
+    fake_.LaunchProcess(3004, 4, L"csrss.exe");
+    fake_.LaunchProcess(3008, 4, L"other.exe");
+    EXPECT_EQ(QueueDepth(), 0u);   // nothing delivered until the buffer ends
+    fake_.EndEventBatch();
+    EXPECT_EQ(QueueDepth(), 51u);
+    Pump();
+
+    const HealthInfo after = engine_->GetHealthInfo();
+    EXPECT_EQ(after.etwProcessBatches - before.etwProcessBatches, 1u);
+    EXPECT_EQ(after.wakeupEnforcementRequest - before.wakeupEnforcementRequest, 1u);
+    EXPECT_TRUE(IsTracked(2000));
+    EXPECT_TRUE(IsTracked(2196));
+    EXPECT_TRUE(IsChildOf(3000, 1000));
+    EXPECT_FALSE(IsTracked(3004));
+    EXPECT_FALSE(IsTracked(3008));
+}
+
+TEST_F(EngineCoreTest, StatsTelemetryReportsRatesAndQueueHighWater) {
+    Start();
+    fake_.BeginEventBatch();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    fake_.LaunchProcess(1004, 4, L"notepad.exe");
+    fake_.LaunchProcess(1008, 4, L"other.exe");
+    fake_.EndEventBatch();
+    Pump();
+
+    // CRITICAL burst within the same second: HARD_LIMIT admitted, the rest dropped
+    for (size_t i = 0; i < kQueueHardLimit + 10; ++i) {
+        Enqueue(EnforcementRequest(50000, EnforcementRequestType::SAFETY_NET));
+    }
+    StatsTelemetry t = engine_->GetStatsTelemetry();
+    EXPECT_EQ(t.version, STATS_TELEMETRY_VERSION);
+    EXPECT_EQ(t.size, sizeof(StatsTelemetry));
+    EXPECT_EQ(t.criticalQueue.current, kQueueHardLimit);
+    EXPECT_EQ(t.criticalQueue.highWater, kQueueHardLimit);
+    EXPECT_EQ(t.criticalQueue.limit, kQueueHardLimit);
+    while (QueueDepth() > 0) DrainQueue();
+    EXPECT_EQ(engine_->GetStatsTelemetry().criticalQueue.current, 0u);
+
+    // The burst second closes once the clock moves on
+    fake_.AdvanceTime(1000);
+    t = engine_->GetStatsTelemetry();
+    EXPECT_EQ(t.processStarts.total, 3u);
+    EXPECT_EQ(t.processStarts.lastSecond, 3u);
+    EXPECT_EQ(t.enqueued[static_cast<size_t>(EnforcementRequestType::ETW_PROCESS_START)].total, 2u);
+    const StatsRateHistogram& safetyNet = t.enqueued[static_cast<size_t>(EnforcementRequestType::SAFETY_NET)];
+    EXPECT_EQ(safetyNet.total, kQueueHardLimit);
+    EXPECT_EQ(safetyNet.peakPerSecond, kQueueHardLimit);
+    EXPECT_EQ(safetyNet.seconds[engine_logic::RateHistogram::BinOf(kQueueHardLimit)], 1u);
+    EXPECT_EQ(t.dropped.total, 10u);
+    EXPECT_EQ(t.dropped.lastSecond, 10u);
+    EXPECT_EQ(t.evicted.total, 0u);
+    EXPECT_EQ(t.criticalQueue.highWater, kQueueHardLimit);   // high-water survives the drain
+
+    // Idle seconds land in bin 0
+    fake_.AdvanceTime(3000);
+    t = engine_->GetStatsTelemetry();
+    EXPECT_EQ(t.dropped.lastSecond, 0u);
+    EXPECT_GE(t.dropped.seconds[0], 3u);
+    EXPECT_EQ(t.dropped.peakPerSecond, 10u);
+}
+
+// §9.41: with a path target configured, only starts whose image file name matches a path
+// target (or a name target / tracked ancestor) are enqueued — same rate as name-only.
+TEST_F(EngineCoreTest, PathTargetsEnqueueOnlyMatchingFileNames) {
+    std::ofstream(dir_ / "UnLeaf.ini") << "[Targets]\nnotepad.exe=1\nC:\\Tools\\tool.exe=1\n";
+    engine_ = std::make_unique<EngineCore>(fake_.AsPlatform());
+    ASSERT_TRUE(engine_->Initialize(dir_.wstring()));
+    Start();
+    ASSERT_TRUE(HasPathTargets());
+    constexpr DWORD kOthers = 50;
+    fake_.BeginEventBatch();
+    for (DWORD i = 0; i < kOthers; ++i) {
+        fake_.LaunchProcess(3000 + 4 * i, 4, L"other.exe", L"C:\\Other\\other.exe");
+    }
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    fake_.LaunchProcess(2000, 4, L"tool.exe", L"C:\\Tools\\tool.exe");
+    fake_.EndEventBatch();
+    Pump();
+    fake_.LaunchProcess(3400, 1000, L"other.exe");   // child of a tracked target
+    Pump();
+
+    const StatsTelemetry t = engine_->GetStatsTelemetry();
+    EXPECT_EQ(t.processStarts.total, kOthers + 3);
+    EXPECT_EQ(t.enqueued[static_cast<size_t>(EnforcementRequestType::ETW_PROCESS_START)].total, 3u);
+    EXPECT_TRUE(IsTracked(1000));
+    EXPECT_TRUE(IsTracked(2000));
+    EXPECT_TRUE(IsChildOf(3400, 1000));
+    EXPECT_FALSE(IsTracked(3000));
+}
+
+// §9.36: no loss evidence, no rescan — a silently spawned child stays untracked.
+// Lost events trigger one rescan of the processes that appeared since the last scan.
+TEST_F(EngineCoreTest, RescanRunsOnlyOnEventLossAndCoversNewProcesses) {
+    Start();
+    fake_.SpawnProcess(1000, 4, L"notepad.exe");
+    fake_.SetForeignJob(1000, true);                 // children not found through our job
+    fake_.EmitProcessStart(1000, 4, L"notepad.exe");
+    Pump();
+    ASSERT_TRUE(IsTracked(1000));
+
+    fake_.SpawnProcess(2000, 1000, L"helper.exe");   // start events never delivered
+    fake_.SpawnProcess(2004, 2000, L"other.exe");
+    fake_.SpawnProcess(3000, 4, L"other.exe");
+    AdvanceAndPump(60000);
+    EXPECT_FALSE(IsTracked(2000));
+    EXPECT_EQ(engine_->GetHealthInfo().lossRescans, 0u);
+
+    fake_.AddLostEvents(2);
+    AdvanceAndPump(20000);
+    HealthInfo info = engine_->GetHealthInfo();
+    EXPECT_EQ(info.lossRescans, 1u);
+    EXPECT_EQ(info.lossRescanEntries, 4u);   // 1000, 2000, 2004, 3000 (not in the Start baseline)
+    EXPECT_TRUE(IsChildOf(2000, 1000));
+    EXPECT_TRUE(IsTracked(2004));
+    EXPECT_FALSE(IsTracked(3000));
+
+    // Evidence consumed: the next windows stay quiet
+    AdvanceAndPump(40000);
+    EXPECT_EQ(engine_->GetHealthInfo().lossRescans, 1u);
+}
+
+// §9.36: a child whose parent's ETW_PROCESS_START is still queued is admitted, not skipped
+TEST_F(EngineCoreTest, ChildOfQueuedParentIsTrackedWithoutRescan) {
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    fake_.LaunchProcess(2000, 1000, L"helper.exe");   // parent not dispatched yet
+    fake_.LaunchProcess(3000, 4, L"helper.exe");      // unrelated
+    EXPECT_EQ(QueueDepth(), 2u);
+    Pump();
+
+    EXPECT_TRUE(IsChildOf(2000, 1000));
+    EXPECT_FALSE(IsTracked(3000));
+    EXPECT_EQ(engine_->GetHealthInfo().lossRescans, 0u);
+}
+
+// §9.37: a start whose direct parent is not tracked still joins a tracked ancestor found
+// through the process tree (untrackable or already-exited launcher); critical images stop it.
+TEST_F(EngineCoreTest, TrackedAncestorAdoptsGrandchildren) {
+    Start();
+    fake_.SpawnProcess(1000, 4, L"notepad.exe");
+    fake_.SetForeignJob(1000, true);                 // children not found through our job
+    fake_.EmitProcessStart(1000, 4, L"notepad.exe");
+    Pump();
+    ASSERT_TRUE(IsTracked(1000));
+
+    // Launcher tracking fails (access denied); its worker is adopted by 1000
+    fake_.SpawnProcess(2000, 1000, L"elevated_helper.exe");
+    fake_.SetAccessDenied(2000, true);
+    fake_.EmitProcessStart(2000, 1000, L"elevated_helper.exe");
+    Pump();
+    ASSERT_FALSE(IsTracked(2000));
+    fake_.LaunchProcess(2004, 2000, L"worker.exe");
+    Pump();
+    EXPECT_TRUE(IsChildOf(2004, 1000));
+    EXPECT_EQ(engine_->GetHealthInfo().ancestorAdmits, 1u);
+
+    // Launcher exits before its request is dispatched (no exit event: untracked)
+    fake_.LaunchProcess(3000, 1000, L"launcher.exe");
+    fake_.LaunchProcess(3004, 3000, L"app.exe");
+    fake_.TerminateProcess(3000);
+    Pump();
+    EXPECT_FALSE(IsTracked(3000));
+    EXPECT_TRUE(IsChildOf(3004, 1000));
+
+    // A critical image between them is a boundary (same as the InitialScan descendant walk)
+    fake_.LaunchProcess(4000, 1000, L"conhost.exe");
+    fake_.LaunchProcess(4004, 4000, L"console_app.exe");
+    Pump();
+    EXPECT_FALSE(IsTracked(4000));
+    EXPECT_FALSE(IsTracked(4004));
+}
+
+// §9.37: the tree is seeded at Start, follows every start / reported exit, and the SafetyNet
+// backstop snapshot removes exits the source never reported.
+TEST_F(EngineCoreTest, ProcessTreeFollowsEventsAndIsRepairedBySnapshots) {
+    fake_.SpawnProcess(1000, 4, L"notepad.exe");
+    fake_.SpawnProcess(1100, 1000, L"helper.exe");
+    fake_.SpawnProcess(1200, 1100, L"helper.exe");
+    fake_.SpawnProcess(3000, 4, L"other.exe");
+    Start();
+    const uint32_t seeded = engine_->GetHealthInfo().processTreeNodes;
+    EXPECT_GE(seeded, 4u);
+    EXPECT_TRUE(IsChildOf(1100, 1000));
+    EXPECT_TRUE(IsChildOf(1200, 1000));              // grandchild from the tree walk
+
+    fake_.LaunchProcess(3100, 3000, L"other.exe");
+    Pump();
+    EXPECT_EQ(engine_->GetHealthInfo().processTreeNodes, seeded + 1);
+
+    // Untracked exit, no exit events: the node stays until a snapshot shows it gone
+    fake_.TerminateProcess(3100);
+    Pump();
+    EXPECT_EQ(engine_->GetHealthInfo().processTreeNodes, seeded + 1);
+    AdvanceAndPump(kSafetyScanBackstop + kSafetyNetInterval);
+    HealthInfo info = engine_->GetHealthInfo();
+    EXPECT_EQ(info.processTreeNodes, seeded);
+    EXPECT_EQ(info.processTreeRepairs, 1u);
+
+    // Tracked exit (exit wait) leaves the tree immediately
+    fake_.TerminateProcess(1200);
+    Pump();
+    EXPECT_EQ(engine_->GetHealthInfo().processTreeNodes, seeded - 1);
+}
+
+// §9.38: one process + thread snapshot per control-loop tick. InitialScan and the pulses it
+// triggers share the Start capture; a burst of starts is enforced from one capture with no
+// per-process thread walk; a failed capture falls back to the walk.
+TEST_F(EngineCoreTest, TickSnapshotIsSharedByScansAndThreadThrottling) {
+    fake_.SpawnProcess(1000, 4, L"notepad.exe");
+    fake_.SpawnProcess(1004, 4, L"notepad.exe");
+    fake_.SetThreadCount(1000, 8);
+    fake_.SetThreadCount(1004, 3);
+    Start();
+    ASSERT_TRUE(IsTracked(1000));
+    ASSERT_TRUE(IsTracked(1004));
+    platform::FakeCallCounters calls = fake_.Counters();
+    EXPECT_EQ(calls.snapshots, 1u);
+    EXPECT_EQ(calls.threadWalks, 0u);
+    EXPECT_EQ(calls.threadsTouched, 11u);
+    HealthInfo info = engine_->GetHealthInfo();
+    EXPECT_EQ(info.snapshotCaptures, 1u);
+    EXPECT_GE(info.snapshotReuses, 2u);
+    EXPECT_EQ(info.threadWalkFallbacks, 0u);
+
+    // One ETW buffer of starts, enforced in one tick
+    Pump();
+    fake_.ResetCounters();
+    constexpr DWORD kBurst = 20;
+    fake_.BeginEventBatch();
+    for (DWORD i = 0; i < kBurst; ++i) {
+        fake_.SpawnProcess(2000 + 4 * i, 4, L"notepad.exe");
+        fake_.SetThreadCount(2000 + 4 * i, 4);
+        fake_.EmitProcessStart(2000 + 4 * i, 4, L"notepad.exe");
+    }
+    fake_.EndEventBatch();
+    engine_->RunControlLoopOnce(0);
+    for (DWORD i = 0; i < kBurst; ++i) ASSERT_TRUE(IsTracked(2000 + 4 * i));
+    calls = fake_.Counters();
+    EXPECT_EQ(calls.snapshots, 1u);
+    EXPECT_EQ(calls.threadWalks, 0u);
+    EXPECT_EQ(calls.threadsTouched, 4u * kBurst);
+
+    // The next tick captures afresh; without a snapshot the platform walks the threads
+    fake_.SetSnapshotFails(true);
+    fake_.LaunchProcess(3000, 4, L"notepad.exe");
+    engine_->RunControlLoopOnce(0);
+    ASSERT_TRUE(IsTracked(3000));
+    calls = fake_.Counters();
+    EXPECT_EQ(calls.snapshots, 2u);
+    EXPECT_EQ(calls.threadWalks, 1u);
+    EXPECT_EQ(engine_->GetHealthInfo().threadWalkFallbacks, 1u);
+}
+
+// §9.40: the SafetyNet scan remembers non-targets. Once the system is classified, a pass costs
+// no budget for known processes and reaches a missed target anywhere in the list; exits are
+// pruned and a config reload starts over.
+TEST_F(EngineCoreTest, SafetyNetScanCachesNonTargets) {
+    constexpr DWORD kOthers = 300;
+    // SafetyNet only runs with something tracked (tracked PIDs cost no budget)
+    fake_.SpawnProcess(100, 4, L"notepad.exe");
+    for (DWORD i = 0; i < kOthers; ++i) {
+        fake_.SpawnProcess(5000 + 4 * i, 4, L"svc_" + std::to_wstring(i) + L".exe");
+    }
+    Start();
+    Pump();
+    ASSERT_TRUE(IsTracked(100));
+    // Cold cache: each backstop pass classifies up to MAX_SAFETY_SCAN_PER_TICK processes
+    AdvanceAndPump(kSafetyScanBackstop);
+    HealthInfo info = engine_->GetHealthInfo();
+    EXPECT_EQ(info.nonTargetCacheEntries, kSafetyScanPerTick);
+    EXPECT_EQ(info.nonTargetCacheHits, 0u);
+    for (int pass = 0; pass < 5; ++pass) AdvanceAndPump(kSafetyScanBackstop);
+    info = engine_->GetHealthInfo();
+    EXPECT_EQ(info.nonTargetCacheEntries, kOthers);
+    const uint32_t hits = info.nonTargetCacheHits;
+
+    // Missed start at the end of the list: found by the very next pass
+    fake_.SpawnProcess(9000, 4, L"notepad.exe");
+    AdvanceAndPump(kSafetyScanBackstop);
+    EXPECT_TRUE(IsTracked(9000));
+    info = engine_->GetHealthInfo();
+    EXPECT_EQ(info.nonTargetCacheHits, hits + kOthers);
+
+    // Exits leave the cache; a reused PID is classified again
+    for (DWORD i = 0; i < 10; ++i) fake_.TerminateProcess(5000 + 4 * i);
+    AdvanceAndPump(kSafetyScanBackstop);
+    EXPECT_EQ(engine_->GetHealthInfo().nonTargetCacheEntries, kOthers - 10);
+    fake_.SpawnProcess(5000, 4, L"notepad.exe");
+    AdvanceAndPump(kSafetyScanBackstop);
+    EXPECT_TRUE(IsTracked(5000));
+
+    // Config reload: new target generation, cache rebuilt from scratch
+    const fs::path ini = dir_ / "UnLeaf.ini";
+    std::ofstream(ini, std::ios::app) << "calc.exe=1\n";
+    fs::last_write_time(ini, fs::last_write_time(ini) + std::chrono::seconds(2));
+    fake_.TouchFile(dir_.wstring(), L"UnLeaf.ini");
+    AdvanceAndPump(kSafetyScanBackstop);
+    ASSERT_EQ(engine_->GetHealthInfo().configReloadCount, 1u);
+    EXPECT_LE(engine_->GetHealthInfo().nonTargetCacheEntries,
+              kSafetyScanPerTick);
+}
+
+// §9.40: tracked targets are skipped without budget — a missed target behind more tracked
+// targets than one pass can examine is still found by the next pass
+TEST_F(EngineCoreTest, SafetyNetScanSkipsTrackedTargetsWithoutBudget) {
+    constexpr DWORD kTracked = kSafetyScanPerTick + 36;
+    for (DWORD i = 0; i < kTracked; ++i) fake_.SpawnProcess(100 + 4 * i, 4, L"notepad.exe");
+    Start();
+    Pump();
+    ASSERT_TRUE(IsTracked(100 + 4 * (kTracked - 1)));
+
+    fake_.SpawnProcess(9000, 4, L"notepad.exe");   // start event lost
+    AdvanceAndPump(kSafetyScanBackstop);
+    EXPECT_TRUE(IsTracked(9000));
+}
+
+TEST_F(EngineCoreTest, ChildProcessesShareInternedImageName) {
+    engine_logic::StringInternTable& strings = engine_logic::StringInternTable::Instance();
+    const size_t liveBefore = strings.LiveCount();
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    Pump();
+    constexpr DWORD kChildren = 200;
+    fake_.BeginEventBatch();
+    for (DWORD i = 0; i < kChildren; ++i) fake_.LaunchProcess(2000 + 4 * i, 1000, L"intern_child.exe");
+    fake_.EndEventBatch();
+    Pump();
+
+    const engine_logic::StringInternTable::Id id = TrackedNameId(2000);
+    ASSERT_NE(id, engine_logic::StringInternTable::EMPTY);
+    EXPECT_EQ(strings.View(id), L"intern_child.exe");
+    for (DWORD i = 0; i < kChildren; ++i) EXPECT_EQ(TrackedNameId(2000 + 4 * i), id);
+    // Tracked entries only: queue references already released, tree nodes inserted from
+    // events are unnamed until the next snapshot (§9.37)
+    EXPECT_EQ(strings.RefCount(id), kChildren);
+
+    for (DWORD i = 0; i < kChildren; ++i) fake_.TerminateProcess(2000 + 4 * i);
+    Pump();
+    EXPECT_FALSE(IsTracked(2000));
+    const HealthInfo health = engine_->GetHealthInfo();
+    EXPECT_GE(health.internedStrings, 1u);   // notepad.exe and its paths remain
+    engine_.reset();
+    EXPECT_EQ(strings.LiveCount(), liveBefore);
+}
+
+// §9.30 / §9.37: starts that are not admitted never touch the intern table
+TEST_F(EngineCoreTest, NonTargetStartsDoNotIntern) {
+    engine_logic::StringInternTable& strings = engine_logic::StringInternTable::Instance();
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    Pump();
+    const size_t liveBefore = strings.LiveCount();
+    fake_.BeginEventBatch();
+    for (DWORD i = 0; i < 50; ++i) {
+        fake_.LaunchProcess(2000 + 4 * i, 4, L"nontarget_" + std::to_wstring(i) + L".exe");
+    }
+    fake_.EndEventBatch();
+    Pump();
+    EXPECT_EQ(QueueDepth(), 0u);
+    EXPECT_EQ(strings.LiveCount(), liveBefore);
+    EXPECT_EQ(engine_->GetHealthInfo().processTreeNodes, 51u);   // every start still enters the tree
+}
+
+TEST_F(EngineCoreTest, MonitorExitEventsReplaceExitWaits) {
+    fake_.SetMonitorReportsExits(true);
+    Start();
+    fake_.LaunchProcess(1000, 4, L"notepad.exe");
+    fake_.LaunchProcess(2000, 1000, L"helper.exe");
+    fake_.SpawnProcess(3000, 4, L"other.exe");   // untracked
+    Pump();
+    ASSERT_TRUE(IsTracked(1000));
+    ASSERT_TRUE(IsChildOf(2000, 1000));
+    EXPECT_EQ(fake_.Counters().registerWait, 0u);
+    EXPECT_EQ(fake_.ActiveWaitCount(), 0u);
+
+    // Untracked exits stop at the tracked-PID bitmap
+    fake_.TerminateProcess(3000);
+    fake_.TerminateProcess(2000);
+    fake_.TerminateProcess(1000);
+    Pump();
+
+    EXPECT_FALSE(IsTracked(1000));
+    EXPECT_FALSE(IsTracked(2000));
+    EXPECT_EQ(MonitorExits(), 2u);
+    EXPECT_EQ(fake_.OpenProcessHandleCount(), 0u);
+    EXPECT_EQ(fake_.ActiveTimerCount(), 0u);
+    EXPECT_EQ(fake_.JobCount(), 0u);
+}
+
+TEST_F(EngineCoreTest, MonitorExitEventsFallBackToWaitsWhenMonitorDown) {
+    fake_.SetMonitorReportsExits(true);
+    fake_.SetMonitorStartResult(false);
+    fake_.SpawnProcess(1000, 4, L"notepad.exe");
+    Start();   // DEGRADED_ETW: InitialScan finds the target
+    Pump();
+    ASSERT_TRUE(IsTracked(1000));
+    EXPECT_EQ(fake_.ActiveWaitCount(), 1u);
+
+    fake_.TerminateProcess(1000);
+    Pump();
+    EXPECT_FALSE(IsTracked(1000));
+    EXPECT_EQ(MonitorExits(), 0u);
+}
+
+TEST_F(EngineCoreTest, ConfigWatchIgnoresOtherFilesAndUnchangedContent) {
+    Start();
+    Pump();
+    const fs::path ini = dir_ / "UnLeaf.ini";
+    auto bump = [&] { fs::last_write_time(ini, fs::last_write_time(ini) + std::chrono::seconds(2)); };
+
+    // Log writes in the same directory never wake the loop
+    fake_.TouchFile(dir_.wstring(), L"UnLeaf.log");
+    AdvanceAndPump(3000);
+    EXPECT_EQ(engine_->GetHealthInfo().wakeupConfigChange, 0u);
+
+    // Save without edits: not a config wakeup, no reload
+    std::ofstream(ini, std::ios::trunc) << "[Targets]\nnotepad.exe=1\n";
+    bump();
+    fake_.TouchFile(dir_.wstring(), L"UnLeaf.ini");
+    AdvanceAndPump(3000);
+    HealthInfo info = engine_->GetHealthInfo();
+    EXPECT_EQ(info.wakeupConfigChange, 0u);
+    EXPECT_EQ(info.configReloadSkipped, 1u);
+    EXPECT_EQ(info.configReloadCount, 0u);
+
+    // Real edit: reloaded, new target picked up
+    std::ofstream(ini, std::ios::app) << "calc.exe=1\n";
+    bump();
+    fake_.TouchFile(dir_.wstring(), L"unleaf.ini");   // names compare case-insensitively
+    AdvanceAndPump(3000);
+    info = engine_->GetHealthInfo();
+    EXPECT_EQ(info.wakeupConfigChange, 1u);
+    EXPECT_EQ(info.configReloadCount, 1u);
+    fake_.LaunchProcess(1000, 4, L"calc.exe");
+    Pump();
+    EXPECT_TRUE(IsTracked(1000));
+}
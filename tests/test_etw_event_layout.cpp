@@ -0,0 +1,325 @@
+// UnLeaf Unit Tests - Schema-compiled ETW ProcessStart decoding (§9.26)
+// Tests: Kernel-Process ProcessStart v0 / v3 payload fixtures, SID and ANSI fields
+//        (NUL-terminated and fixed-length),
+//        TDH fallback for uncompilable schemas, truncated payloads, layout cache keying,
+//        ThreadStart new-thread ID (§9.39)
+
+#include <gtest/gtest.h>
+#include "engine/etw_event_layout.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace engine_logic;
+
+namespace {
+
+// Little-endian payload builder: lays out fields the way the kernel provider writes UserData
+class Payload {
+public:
+    Payload& U32(uint32_t v) { for (int i = 0; i < 4; ++i) bytes_.push_back(uint8_t(v >> (8 * i))); return *this; }
+    Payload& U64(uint64_t v) { for (int i = 0; i < 8; ++i) bytes_.push_back(uint8_t(v >> (8 * i))); return *this; }
+    Payload& Utf16(const std::u16string& s) {
+        for (char16_t c : s) { bytes_.push_back(uint8_t(c)); bytes_.push_back(uint8_t(c >> 8)); }
+        bytes_.push_back(0); bytes_.push_back(0);
+        return *this;
+    }
+    Payload& Ansi(const std::string& s) {
+        bytes_.insert(bytes_.end(), s.begin(), s.end());
+        bytes_.push_back(0);
+        return *this;
+    }
+    // S-1-16-8192 style SID (Revision 1, subAuthorities)
+    Payload& Sid(const std::vector<uint32_t>& subAuthorities) {
+        bytes_.push_back(1);
+        bytes_.push_back(uint8_t(subAuthorities.size()));
+        for (int i = 0; i < 5; ++i) bytes_.push_back(0);
+        bytes_.push_back(16);
+        for (uint32_t sa : subAuthorities) U32(sa);
+        return *this;
+    }
+    const std::vector<uint8_t>& bytes() const { return bytes_; }
+
+private:
+    std::vector<uint8_t> bytes_;
+};
+
+const std::u16string kImage = u"\\Device\\HarddiskVolume3\\Windows\\System32\\notepad.exe";
+
+// Microsoft-Windows-Kernel-Process ProcessStart (event 1) top-level properties
+std::vector<EtwFieldSchema> SchemaV0() {
+    return {
+        {L"ProcessID",       EtwFieldKind::FIXED, 4},
+        {L"CreateTime",      EtwFieldKind::FIXED, 8},
+        {L"ParentProcessID", EtwFieldKind::FIXED, 4},
+        {L"SessionID",       EtwFieldKind::FIXED, 4},
+        {L"ImageName",       EtwFieldKind::UTF16_STRING},
+    };
+}
+
+std::vector<EtwFieldSchema> SchemaV3() {
+    return {
+        {L"ProcessID",                   EtwFieldKind::FIXED, 4},
+        {L"ProcessSequenceNumber",       EtwFieldKind::FIXED, 8},
+        {L"CreateTime",                  EtwFieldKind::FIXED, 8},
+        {L"ParentProcessID",             EtwFieldKind::FIXED, 4},
+        {L"ParentProcessSequenceNumber", EtwFieldKind::FIXED, 8},
+        {L"SessionID",                   EtwFieldKind::FIXED, 4},
+        {L"Flags",                       EtwFieldKind::FIXED, 4},
+        {L"ProcessTokenElevationType",   EtwFieldKind::FIXED, 4},
+        {L"ProcessTokenIsElevated",      EtwFieldKind::FIXED, 4},
+        {L"MandatoryLabel",              EtwFieldKind::SID},
+        {L"ImageName",                   EtwFieldKind::UTF16_STRING},
+        {L"ImageChecksum",               EtwFieldKind::FIXED, 4},
+        {L"TimeDateStamp",               EtwFieldKind::FIXED, 4},
+        {L"PackageFullName",             EtwFieldKind::UTF16_STRING},
+        {L"PackageRelativeAppId",        EtwFieldKind::UTF16_STRING},
+    };
+}
+
+std::vector<uint8_t> FixtureV0() {
+    Payload p;
+    p.U32(6952).U64(0x01DA1234ABCD0000ull).U32(4120).U32(1).Utf16(kImage);
+    return p.bytes();
+}
+
+std::vector<uint8_t> FixtureV3() {
+    Payload p;
+    p.U32(6952).U64(77).U64(0x01DA1234ABCD0000ull).U32(4120).U64(42).U32(1)
+     .U32(0).U32(3).U32(0).Sid({8192}).Utf16(kImage)
+     .U32(0x1C2D3).U32(0x5F000000).Utf16(u"").Utf16(u"");
+    return p.bytes();
+}
+
+std::wstring Image(const ProcessStartFields& f) {
+    if (f.imageIsAnsi) return std::wstring(f.image, f.image + f.imageBytes);
+    return Utf16LeToWide(f.image, f.imageBytes);
+}
+
+} // namespace
+
+// ============================================================
+// ProcessStartLayout
+// ============================================================
+
+TEST(EtwEventLayoutTest, DecodesProcessStartV0Fixture) {
+    auto layout = ProcessStartLayout::Compile(SchemaV0());
+    ASSERT_TRUE(layout.IsValid());
+    const auto data = FixtureV0();
+
+    ProcessStartFields f;
+    ASSERT_TRUE(layout.Decode(data.data(), data.size(), f));
+    EXPECT_TRUE(f.hasPid);
+    EXPECT_EQ(f.pid, 6952u);
+    EXPECT_TRUE(f.hasParentPid);
+    EXPECT_EQ(f.parentPid, 4120u);
+    ASSERT_TRUE(f.hasImage);
+    EXPECT_FALSE(f.imageIsAnsi);
+    EXPECT_EQ(Image(f), L"\\Device\\HarddiskVolume3\\Windows\\System32\\notepad.exe");
+}
+
+TEST(EtwEventLayoutTest, DecodesProcessStartV3FixtureAcrossSid) {
+    auto layout = ProcessStartLayout::Compile(SchemaV3());
+    ASSERT_TRUE(layout.IsValid());
+    const auto data = FixtureV3();
+
+    ProcessStartFields f;
+    ASSERT_TRUE(layout.Decode(data.data(), data.size(), f));
+    EXPECT_EQ(f.pid, 6952u);
+    EXPECT_EQ(f.parentPid, 4120u);
+    ASSERT_TRUE(f.hasImage);
+    EXPECT_EQ(Image(f), L"\\Device\\HarddiskVolume3\\Windows\\System32\\notepad.exe");
+}
+
+TEST(EtwEventLayoutTest, NamesMatchCaseInsensitivelyAndImageFileNameAlias) {
+    std::vector<EtwFieldSchema> schema = {
+        {L"PROCESSID",       EtwFieldKind::FIXED, 4},
+        {L"parentprocessid", EtwFieldKind::FIXED, 4},
+        {L"ImageFileName",   EtwFieldKind::ANSI_STRING},
+    };
+    auto layout = ProcessStartLayout::Compile(schema);
+    ASSERT_TRUE(layout.IsValid());
+    Payload p;
+    p.U32(100).U32(4).Ansi("C:\\tools\\cl.exe");
+
+    ProcessStartFields f;
+    ASSERT_TRUE(layout.Decode(p.bytes().data(), p.bytes().size(), f));
+    EXPECT_EQ(f.pid, 100u);
+    EXPECT_EQ(f.parentPid, 4u);
+    EXPECT_TRUE(f.imageIsAnsi);
+    EXPECT_EQ(Image(f), L"C:\\tools\\cl.exe");
+}
+
+// Fixed-length ANSI image: decoded as 8-bit up to the first NUL inside the declared size.
+// A fixed-length ANSI field that is not the image is a plain skip.
+TEST(EtwEventLayoutTest, FixedLengthAnsiImageDecodesAsAnsi) {
+    std::vector<EtwFieldSchema> schema = {
+        {L"ProcessID",       EtwFieldKind::FIXED, 4},
+        {L"Tag",             EtwFieldKind::FIXED_ANSI, 4},
+        {L"ParentProcessID", EtwFieldKind::FIXED, 4},
+        {L"ImageFileName",   EtwFieldKind::FIXED_ANSI, 16},
+        {L"Tail",            EtwFieldKind::FIXED, 4},
+    };
+    auto layout = ProcessStartLayout::Compile(schema);
+    ASSERT_TRUE(layout.IsValid());
+    Payload p;
+    p.U32(100).Ansi("abc").U32(4).Ansi("notepad.exe");
+    p.Ansi("").Ansi("").Ansi("").Ansi("");   // pad the image to its 16 bytes
+    p.U32(0xDEADBEEF);
+
+    ProcessStartFields f;
+    ASSERT_TRUE(layout.Decode(p.bytes().data(), p.bytes().size(), f));
+    EXPECT_EQ(f.pid, 100u);
+    EXPECT_EQ(f.parentPid, 4u);
+    ASSERT_TRUE(f.hasImage);
+    EXPECT_TRUE(f.imageIsAnsi);
+    EXPECT_EQ(Image(f), L"notepad.exe");
+
+    // No NUL inside the declared size: bounded by it
+    Payload unterminated;
+    unterminated.U32(100).Ansi("abc").U32(4).Ansi("abcdefghijklmnopxyz");
+    f = ProcessStartFields();
+    ASSERT_TRUE(layout.Decode(unterminated.bytes().data(), unterminated.bytes().size(), f));
+    EXPECT_EQ(Image(f), L"abcdefghijklmnop");
+}
+
+TEST(EtwEventLayoutTest, UnsupportedFieldBeforeTargetFallsBack) {
+    auto schema = SchemaV0();
+    schema.insert(schema.begin() + 1, EtwFieldSchema(L"Counted", EtwFieldKind::UNSUPPORTED));
+    EXPECT_FALSE(ProcessStartLayout::Compile(schema).IsValid());
+
+    ProcessStartFields f;
+    const auto data = FixtureV0();
+    EXPECT_FALSE(ProcessStartLayout::Compile(schema).Decode(data.data(), data.size(), f));
+}
+
+TEST(EtwEventLayoutTest, UnsupportedFieldAfterLastTargetIsIgnored) {
+    auto schema = SchemaV0();
+    schema.emplace_back(L"Blob", EtwFieldKind::UNSUPPORTED);
+    schema.emplace_back(L"Tail", EtwFieldKind::FIXED, 4);
+    auto layout = ProcessStartLayout::Compile(schema);
+    ASSERT_TRUE(layout.IsValid());
+
+    const auto data = FixtureV0();
+    ProcessStartFields f;
+    ASSERT_TRUE(layout.Decode(data.data(), data.size(), f));
+    EXPECT_EQ(f.parentPid, 4120u);
+    EXPECT_TRUE(f.hasImage);
+}
+
+TEST(EtwEventLayoutTest, SchemaWithoutTargetsIsInvalid) {
+    std::vector<EtwFieldSchema> schema = {{L"TimeStamp", EtwFieldKind::FIXED, 8}};
+    EXPECT_FALSE(ProcessStartLayout::Compile(schema).IsValid());
+    EXPECT_FALSE(ProcessStartLayout().IsValid());
+}
+
+TEST(EtwEventLayoutTest, TruncatedPayloadStaysInBounds) {
+    auto layout = ProcessStartLayout::Compile(SchemaV0());
+    const auto full = FixtureV0();
+
+    // Cut inside ParentProcessID: only ProcessID decodes
+    {
+        std::vector<uint8_t> cut(full.begin(), full.begin() + 14);
+        ProcessStartFields f;
+        ASSERT_TRUE(layout.Decode(cut.data(), cut.size(), f));
+        EXPECT_TRUE(f.hasPid);
+        EXPECT_FALSE(f.hasParentPid);
+        EXPECT_FALSE(f.hasImage);
+    }
+    // Cut inside ImageName (no terminator, odd length): bounded by the payload
+    {
+        std::vector<uint8_t> cut(full.begin(), full.begin() + 20 + 9);
+        ProcessStartFields f;
+        ASSERT_TRUE(layout.Decode(cut.data(), cut.size(), f));
+        ASSERT_TRUE(f.hasImage);
+        EXPECT_EQ(f.imageBytes, 8u);
+        EXPECT_EQ(Image(f), L"\\Dev");
+    }
+    // SID count pointing past the end
+    {
+        auto v3 = ProcessStartLayout::Compile(SchemaV3());
+        std::vector<uint8_t> data = FixtureV3();
+        data[49] = 0xFF;   // MandatoryLabel SubAuthorityCount (offset 48 + 1)
+        ProcessStartFields f;
+        ASSERT_TRUE(v3.Decode(data.data(), data.size(), f));
+        EXPECT_EQ(f.pid, 6952u);
+        EXPECT_FALSE(f.hasImage);
+    }
+}
+
+TEST(EtwEventLayoutTest, EmptyImageName) {
+    auto layout = ProcessStartLayout::Compile(SchemaV0());
+    Payload p;
+    p.U32(8).U64(0).U32(4).U32(0).Utf16(u"");
+    ProcessStartFields f;
+    ASSERT_TRUE(layout.Decode(p.bytes().data(), p.bytes().size(), f));
+    EXPECT_TRUE(f.hasImage);
+    EXPECT_EQ(f.imageBytes, 0u);
+}
+
+TEST(EtwEventLayoutTest, ThreadStartCarriesNewThreadId) {
+    // ProcessID, ThreadID, StackBase, StackLimit, ... (pointer-sized tail ignored)
+    Payload p;
+    p.U32(6952).U32(11840).U64(0x7FF000000000ull).U64(0x7FEFFFFF0000ull);
+    uint32_t pid = 0, tid = 0;
+    ASSERT_TRUE(DecodeThreadStartIds(p.bytes().data(), p.bytes().size(), pid, tid));
+    EXPECT_EQ(pid, 6952u);
+    EXPECT_EQ(tid, 11840u);
+    EXPECT_FALSE(DecodeThreadStartIds(p.bytes().data(), 7, pid, tid));
+    EXPECT_FALSE(DecodeThreadStartIds(nullptr, 0, pid, tid));
+}
+
+// ============================================================
+// EtwLayoutCache
+// ============================================================
+
+TEST(EtwLayoutCacheTest, KeyedByProviderIdAndVersion) {
+    EtwLayoutCache cache;
+    EtwLayoutCache::Key v0{};
+    std::memset(v0.provider, 0x22, sizeof(v0.provider));
+    v0.eventId = 1;
+    v0.version = 0;
+    EtwLayoutCache::Key v3 = v0;
+    v3.version = 3;
+    EtwLayoutCache::Key other = v0;
+    other.provider[15] = 0x17;
+
+    EXPECT_EQ(cache.Find(v0), nullptr);
+    cache.Insert(v0, ProcessStartLayout::Compile(SchemaV0()));
+    cache.Insert(v3, ProcessStartLayout());   // uncompilable: cached as fallback-only
+    ASSERT_NE(cache.Find(v0), nullptr);
+    EXPECT_TRUE(cache.Find(v0)->IsValid());
+    ASSERT_NE(cache.Find(v3), nullptr);
+    EXPECT_FALSE(cache.Find(v3)->IsValid());
+    EXPECT_EQ(cache.Find(other), nullptr);
+    EXPECT_EQ(cache.size(), 2u);
+}
+
+// ============================================================
+// String helpers
+// ============================================================
+
+TEST(EtwEventLayoutTest, Utf16LeToWideHandlesSurrogatePairs) {
+    Payload p;
+    p.Utf16(u"a\U0001F600b");
+    const auto& b = p.bytes();
+    const std::wstring w = Utf16LeToWide(b.data(), b.size() - 2);
+    if (sizeof(wchar_t) == 4) {
+        EXPECT_EQ(w, std::wstring(L"a\U0001F600b"));
+    } else {
+        EXPECT_EQ(w.size(), 4u);
+    }
+}
+
+TEST(EtwEventLayoutTest, SplitImagePath) {
+    std::wstring name = L"\\Device\\HarddiskVolume3\\Tools\\app.exe", path;
+    SplitImagePath(name, path);
+    EXPECT_EQ(name, L"app.exe");
+    EXPECT_EQ(path, L"\\Device\\HarddiskVolume3\\Tools\\app.exe");
+
+    std::wstring bare = L"app.exe", barePath;
+    SplitImagePath(bare, barePath);
+    EXPECT_EQ(bare, L"app.exe");
+    EXPECT_TRUE(barePath.empty());
+}
@@ -0,0 +1,93 @@
+// UnLeaf Unit Tests - ProcessStart POD batch (§9.29)
+// Tests: name/path split matches SplitImagePath, UTF-16LE decode into the record,
+//        over-long image strings spill, Clear() reuses the records
+
+#include <gtest/gtest.h>
+#include "engine/event_batch.h"
+#include "engine/etw_event_layout.h"
+
+#include <string>
+#include <vector>
+
+using engine_logic::ProcessStartBatch;
+using engine_logic::ProcessStartRecord;
+
+namespace {
+
+std::vector<uint8_t> Utf16Le(const std::wstring& s) {
+    std::vector<uint8_t> out;
+    for (wchar_t c : s) {
+        out.push_back(static_cast<uint8_t>(c));
+        out.push_back(static_cast<uint8_t>(static_cast<uint32_t>(c) >> 8));
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(EventBatchTest, SplitMatchesSplitImagePath) {
+    ProcessStartBatch batch;
+    const std::wstring device = L"\\Device\\HarddiskVolume3\\Windows\\System32\\notepad.exe";
+    batch.Append(1000, 4, device);
+    batch.Append(1004, 1000, L"bare.exe");
+    batch.Append(1008, 1000, L"C:/tools/");   // trailing separator: empty name, path kept
+    batch.Append(1012, 0, L"");
+    ASSERT_EQ(batch.Size(), 4u);
+
+    for (size_t i = 0; i < batch.Size(); ++i) {
+        std::wstring name(i == 0 ? device : i == 1 ? L"bare.exe" : i == 2 ? L"C:/tools/" : L"");
+        std::wstring path;
+        engine_logic::SplitImagePath(name, path);
+        EXPECT_EQ(batch.ImageName(i), name) << i;
+        EXPECT_EQ(batch.ImagePath(i), path) << i;
+    }
+    EXPECT_EQ(batch[0].pid, 1000u);
+    EXPECT_EQ(batch[0].parentPid, 4u);
+    EXPECT_EQ(batch[1].parentPid, 1000u);
+}
+
+TEST(EventBatchTest, Utf16PayloadDecodedInPlace) {
+    const std::wstring image = L"C:\\\u30c4\u30fc\u30eb\\\u30a2\u30d7\u30ea.exe";   // katakana
+    const std::vector<uint8_t> bytes = Utf16Le(image);
+    ProcessStartBatch batch;
+    batch.AppendUtf16Le(2000, 8, bytes.data(), bytes.size());
+    EXPECT_EQ(batch.ImagePath(0), image);
+    EXPECT_EQ(batch.ImageName(0), L"\u30a2\u30d7\u30ea.exe");
+    EXPECT_EQ(batch[0].spill, ProcessStartRecord::NO_SPILL);
+    EXPECT_EQ(batch[0].textLength, image.size());
+}
+
+TEST(EventBatchTest, LongImagePathsSpill) {
+    const std::wstring longPath = L"\\\\?\\C:\\" + std::wstring(400, L'd') + L"\\deep.exe";
+    ProcessStartBatch batch;
+    batch.Append(3000, 4, longPath);
+    const std::vector<uint8_t> bytes = Utf16Le(longPath);
+    batch.AppendUtf16Le(3004, 4, bytes.data(), bytes.size());
+    batch.Append(3008, 4, L"C:\\short.exe");
+
+    for (size_t i = 0; i < 2; ++i) {
+        EXPECT_NE(batch[i].spill, ProcessStartRecord::NO_SPILL);
+        EXPECT_EQ(batch.ImagePath(i), longPath);
+        EXPECT_EQ(batch.ImageName(i), L"deep.exe");
+    }
+    EXPECT_EQ(batch[2].spill, ProcessStartRecord::NO_SPILL);
+    EXPECT_EQ(batch.ImageName(2), L"short.exe");
+}
+
+TEST(EventBatchTest, FillClearRefill) {
+    ProcessStartBatch batch;
+    EXPECT_TRUE(batch.Empty());
+    for (uint32_t i = 0; i < ProcessStartBatch::CAPACITY; ++i) {
+        ASSERT_FALSE(batch.Full());
+        batch.Append(4 * i, 4, L"C:\\apps\\app" + std::to_wstring(i) + L".exe");
+    }
+    EXPECT_TRUE(batch.Full());
+    EXPECT_EQ(batch.ImageName(ProcessStartBatch::CAPACITY - 1), L"app127.exe");
+
+    batch.Clear();
+    EXPECT_TRUE(batch.Empty());
+    batch.Append(8, 4, L"again.exe");
+    EXPECT_EQ(batch.Size(), 1u);
+    EXPECT_EQ(batch.ImageName(0), L"again.exe");
+    EXPECT_TRUE(batch.ImagePath(0).empty());
+}
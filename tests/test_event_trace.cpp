@@ -0,0 +1,179 @@
+// UnLeaf Unit Tests - Binary event trace format (§9.27)
+// Tests: writer/reader round trip, name-from-path compaction, non-monotonic
+//        timestamps, truncated / foreign files, block flushing
+
+#include <gtest/gtest.h>
+#include "engine/event_trace.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using engine_logic::EventTraceReader;
+using engine_logic::EventTraceWriter;
+using engine_logic::TraceEvent;
+using engine_logic::TraceEventType;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+class EventTraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = fs::temp_directory_path() /
+                ("unleaf_trace_" + std::string(::testing::UnitTest::GetInstance()
+                                                   ->current_test_info()->name()) + ".ultrace");
+    }
+    void TearDown() override {
+        std::error_code ec;
+        fs::remove(path_, ec);
+    }
+
+    std::vector<uint8_t> FileBytes() const {
+        std::ifstream in(path_, std::ios::binary);
+        return std::vector<uint8_t>((std::istreambuf_iterator<char>(in)),
+                                    std::istreambuf_iterator<char>());
+    }
+
+    fs::path path_;
+};
+
+} // namespace
+
+TEST_F(EventTraceTest, RoundTripProcessAndThreadStarts) {
+    {
+        EventTraceWriter w;
+        ASSERT_TRUE(w.Open(path_));
+        w.AppendProcessStart(133000000000000000ull, 1000, 4, L"app.exe",
+                             L"\\Device\\HarddiskVolume3\\apps\\app.exe");
+        w.AppendThreadStart(133000000000000250ull, 1000, 1004);
+        w.AppendProcessStart(133000000000000100ull, 1008, 1000, L"child.exe", L"");  // earlier: ETW CPU skew
+        w.AppendThreadStart(133000000000000100ull, 1008, 0xFFFFFFF0u);
+        EXPECT_EQ(w.RecordCount(), 4u);
+    }
+
+    EventTraceReader r;
+    ASSERT_TRUE(r.Open(path_));
+    TraceEvent ev;
+    ASSERT_TRUE(r.Next(ev));
+    EXPECT_EQ(ev.type, TraceEventType::PROCESS_START);
+    EXPECT_EQ(ev.timestampUs, 133000000000000000ull);
+    EXPECT_EQ(ev.pid, 1000u);
+    EXPECT_EQ(ev.parentPid, 4u);
+    EXPECT_EQ(ev.imageName, L"app.exe");
+    EXPECT_EQ(ev.imagePath, L"\\Device\\HarddiskVolume3\\apps\\app.exe");
+
+    ASSERT_TRUE(r.Next(ev));
+    EXPECT_EQ(ev.type, TraceEventType::THREAD_START);
+    EXPECT_EQ(ev.timestampUs, 133000000000000250ull);
+    EXPECT_EQ(ev.pid, 1000u);
+    EXPECT_EQ(ev.tid, 1004u);
+
+    ASSERT_TRUE(r.Next(ev));
+    EXPECT_EQ(ev.timestampUs, 133000000000000100ull);
+    EXPECT_EQ(ev.imageName, L"child.exe");
+    EXPECT_TRUE(ev.imagePath.empty());
+
+    ASSERT_TRUE(r.Next(ev));
+    EXPECT_EQ(ev.tid, 0xFFFFFFF0u);
+
+    EXPECT_FALSE(r.Next(ev));
+    EXPECT_EQ(r.GetStatus(), EventTraceReader::Status::END);
+
+    r.Rewind();
+    ASSERT_TRUE(r.Next(ev));
+    EXPECT_EQ(ev.pid, 1000u);
+}
+
+TEST_F(EventTraceTest, NonAsciiNamesSurvive) {
+    const std::wstring name = L"\u30a2\u30d7\u30ea.exe";   // katakana
+    const std::wstring path = L"C:\\\u30c4\u30fc\u30eb\\" + name;
+    {
+        EventTraceWriter w;
+        ASSERT_TRUE(w.Open(path_));
+        w.AppendProcessStart(1, 42, 4, name, path);
+    }
+    EventTraceReader r;
+    ASSERT_TRUE(r.Open(path_));
+    TraceEvent ev;
+    ASSERT_TRUE(r.Next(ev));
+    EXPECT_EQ(ev.imageName, name);
+    EXPECT_EQ(ev.imagePath, path);
+}
+
+TEST_F(EventTraceTest, ThreadStormRecordsStayCompact) {
+    {
+        EventTraceWriter w;
+        ASSERT_TRUE(w.Open(path_));
+        w.AppendProcessStart(133000000000000000ull, 5000, 4, L"build.exe", L"C:\\ci\\build.exe");
+        for (uint32_t i = 0; i < 1000; ++i) {
+            w.AppendThreadStart(133000000000000000ull + 20 * (i + 1), 5000, 8000 + 4 * i);
+        }
+    }
+    const std::vector<uint8_t> bytes = FileBytes();
+    // tag + 1-byte delta + 2-byte pid + 2-byte tid (name stored once, in the path)
+    EXPECT_LE(bytes.size(), 8u + 64u + 1000u * 6u);
+}
+
+TEST_F(EventTraceTest, RecordsSpanFlushBlocks) {
+    constexpr uint32_t kRecords = 50000;   // several FLUSH_THRESHOLD blocks
+    uint64_t written = 0;
+    {
+        EventTraceWriter w;
+        ASSERT_TRUE(w.Open(path_));
+        for (uint32_t i = 0; i < kRecords; ++i) w.AppendThreadStart(i * 7ull, 100 + (i % 13) * 4, i);
+        EXPECT_GT(w.BytesWritten(), 0u);   // at least one block already on disk
+        w.Close();
+        written = w.BytesWritten();
+        EXPECT_FALSE(w.HasFailed());
+    }
+    EXPECT_EQ(FileBytes().size(), written);
+
+    EventTraceReader r;
+    ASSERT_TRUE(r.Open(path_));
+    TraceEvent ev;
+    uint32_t n = 0;
+    while (r.Next(ev)) {
+        ASSERT_EQ(ev.tid, n);
+        ASSERT_EQ(ev.timestampUs, n * 7ull);
+        ++n;
+    }
+    EXPECT_EQ(n, kRecords);
+    EXPECT_EQ(r.GetStatus(), EventTraceReader::Status::END);
+}
+
+TEST_F(EventTraceTest, TruncatedTailKeepsEarlierRecords) {
+    {
+        EventTraceWriter w;
+        ASSERT_TRUE(w.Open(path_));
+        w.AppendThreadStart(10, 1000, 1);
+        w.AppendProcessStart(20, 1004, 1000, L"app.exe", L"C:\\apps\\app.exe");
+    }
+    std::vector<uint8_t> bytes = FileBytes();
+    bytes.resize(bytes.size() - 3);   // capture interrupted mid-record
+
+    EventTraceReader r;
+    ASSERT_TRUE(r.Attach(bytes));
+    TraceEvent ev;
+    ASSERT_TRUE(r.Next(ev));
+    EXPECT_EQ(ev.tid, 1u);
+    EXPECT_FALSE(r.Next(ev));
+    EXPECT_EQ(r.GetStatus(), EventTraceReader::Status::TRUNCATED);
+}
+
+TEST_F(EventTraceTest, ForeignOrMalformedDataRejected) {
+    EventTraceReader r;
+    EXPECT_FALSE(r.Attach({}));
+    EXPECT_FALSE(r.Attach({'M', 'Z', 0x90, 0, 3, 0, 0, 0}));
+    EXPECT_FALSE(r.Attach({'U', 'L', 'T', 'R', 2, 0, 0, 0}));   // future version
+    EXPECT_EQ(r.GetStatus(), EventTraceReader::Status::BAD_FORMAT);
+    EXPECT_FALSE(r.Open(path_));                                // missing file
+
+    ASSERT_TRUE(r.Attach({'U', 'L', 'T', 'R', 1, 0, 0, 0, 0x07, 0, 0}));   // unknown record type
+    TraceEvent ev;
+    EXPECT_FALSE(r.Next(ev));
+    EXPECT_EQ(r.GetStatus(), EventTraceReader::Status::BAD_FORMAT);
+}
@@ -0,0 +1,211 @@
+// UnLeaf Unit Tests - Linux IEventService reactor (§9.33)
+// Tests: auto/manual-reset event semantics, lowest-index-wins, timerfd coalescing,
+//        file-scoped inotify watch signaled until re-armed, argument errors, epoll set reuse,
+//        EngineCore control loop wakeup counters on the real reactor
+
+#ifdef __linux__
+
+#include <gtest/gtest.h>
+#include "platform/linux/linux_event_service.h"
+#include "platform/fake/fake_platform.h"
+#include "service/engine_core.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace unleaf;
+using unleaf::platform::FakePlatform;
+using unleaf::platform::LinuxEventService;
+using unleaf::platform::NativeHandle;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+fs::path ScratchDir() {
+    const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+    fs::path dir = fs::temp_directory_path() / (std::string("unleaf_events_") + info->name());
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    return dir;
+}
+
+} // namespace
+
+TEST(LinuxEventServiceTest, AutoResetEventWakesOnce) {
+    LinuxEventService events;
+    NativeHandle ev = events.CreateEventObject(false);
+    ASSERT_NE(ev, nullptr);
+
+    EXPECT_EQ(events.WaitAny(&ev, 1, 0), WAIT_TIMEOUT);
+    // Several SetEvent before the wait collapse into one wakeup
+    EXPECT_TRUE(events.SetEvent(ev));
+    EXPECT_TRUE(events.SetEvent(ev));
+    EXPECT_EQ(events.WaitAny(&ev, 1, 0), WAIT_OBJECT_0);
+    EXPECT_EQ(events.WaitAny(&ev, 1, 0), WAIT_TIMEOUT);
+
+    // Signaled from another thread while blocked
+    std::thread setter([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        events.SetEvent(ev);
+    });
+    EXPECT_EQ(events.WaitAny(&ev, 1, INFINITE), WAIT_OBJECT_0);
+    setter.join();
+
+    events.CloseHandle(ev);
+}
+
+TEST(LinuxEventServiceTest, ManualResetStaysSignaledAndLowestIndexWins) {
+    LinuxEventService events;
+    NativeHandle stop = events.CreateEventObject(true);
+    NativeHandle work = events.CreateEventObject(false);
+    ASSERT_NE(stop, nullptr);
+    ASSERT_NE(work, nullptr);
+    NativeHandle handles[] = {stop, work};
+
+    events.SetEvent(work);
+    events.SetEvent(stop);
+    EXPECT_EQ(events.WaitAny(handles, 2, 0), WAIT_OBJECT_0 + 0);
+    EXPECT_EQ(events.WaitAny(handles, 2, 0), WAIT_OBJECT_0 + 0);   // manual: not consumed
+
+    EXPECT_TRUE(events.ResetEvent(stop));
+    EXPECT_EQ(events.WaitAny(handles, 2, 0), WAIT_OBJECT_0 + 1);
+    EXPECT_EQ(events.WaitAny(handles, 2, 0), WAIT_TIMEOUT);
+
+    events.CloseHandle(stop);
+    events.CloseHandle(work);
+}
+
+TEST(LinuxEventServiceTest, PeriodicTimerCoalescesMissedPeriods) {
+    LinuxEventService events;
+    NativeHandle timer = events.CreatePeriodicTimer();
+    ASSERT_NE(timer, nullptr);
+    ASSERT_TRUE(events.ArmPeriodicTimer(timer, 0, 5));
+
+    // Several periods elapse unobserved: one wakeup, like an auto-reset waitable timer
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_EQ(events.WaitAny(&timer, 1, 0), WAIT_OBJECT_0);
+
+    // Re-arming to a long period clears the pending expirations
+    ASSERT_TRUE(events.ArmPeriodicTimer(timer, 60000, 60000));
+    EXPECT_EQ(events.WaitAny(&timer, 1, 20), WAIT_TIMEOUT);
+
+    events.CloseHandle(timer);
+}
+
+TEST(LinuxEventServiceTest, FileWatchSignaledUntilRearmed) {
+    const fs::path dir = ScratchDir();
+    LinuxEventService events;
+    NativeHandle watch = events.WatchDirectory(dir.wstring(), L"UnLeaf.ini");
+    ASSERT_NE(watch, INVALID_HANDLE_VALUE);
+    EXPECT_EQ(events.WaitAny(&watch, 1, 0), WAIT_TIMEOUT);
+
+    // Other files: appends to an open log queue nothing, a closed write is filtered out
+    {
+        std::ofstream log(dir / "UnLeaf.log", std::ios::app);
+        for (int i = 0; i < 100; ++i) log << "line\n" << std::flush;
+        EXPECT_EQ(events.WaitAny(&watch, 1, 20), WAIT_TIMEOUT);
+    }
+    EXPECT_EQ(events.WaitAny(&watch, 1, 20), WAIT_TIMEOUT);
+
+    std::ofstream(dir / "UnLeaf.ini") << "[Targets]\n";
+    EXPECT_EQ(events.WaitAny(&watch, 1, 1000), WAIT_OBJECT_0);
+    EXPECT_EQ(events.WaitAny(&watch, 1, 0), WAIT_OBJECT_0);   // FindNextChangeNotification not called yet
+
+    EXPECT_TRUE(events.RearmDirectoryWatch(watch));
+    EXPECT_EQ(events.WaitAny(&watch, 1, 0), WAIT_TIMEOUT);
+
+    // Atomic replace (write temp + rename onto the file), name matched case-insensitively
+    std::ofstream(dir / "UnLeaf.ini.tmp") << "[Targets]\ncalc.exe=1\n";
+    fs::rename(dir / "UnLeaf.ini.tmp", dir / "unleaf.INI");
+    EXPECT_EQ(events.WaitAny(&watch, 1, 1000), WAIT_OBJECT_0);
+    EXPECT_TRUE(events.RearmDirectoryWatch(watch));
+
+    // Directory removed: the re-arm reports the dead watch
+    fs::remove_all(dir);
+    EXPECT_EQ(events.WaitAny(&watch, 1, 1000), WAIT_OBJECT_0);
+    EXPECT_FALSE(events.RearmDirectoryWatch(watch));
+
+    events.CloseDirectoryWatch(watch);
+    EXPECT_EQ(events.WatchDirectory((dir / "missing").wstring(), L"UnLeaf.ini"), INVALID_HANDLE_VALUE);
+}
+
+TEST(LinuxEventServiceTest, InvalidArgumentsAndInterestReuse) {
+    LinuxEventService events;
+    NativeHandle a = events.CreateEventObject(false);
+    NativeHandle b = events.CreateEventObject(false);
+    NativeHandle none[] = {a, nullptr};
+
+    EXPECT_EQ(events.WaitAny(none, 0, 0), WAIT_FAILED);
+    EXPECT_EQ(events.LastError(), ERROR_INVALID_PARAMETER);
+    EXPECT_EQ(events.WaitAny(none, 2, 0), WAIT_FAILED);
+    EXPECT_EQ(events.LastError(), ERROR_INVALID_HANDLE);
+    EXPECT_FALSE(events.ArmPeriodicTimer(a, 1, 1));
+    EXPECT_EQ(events.LastError(), ERROR_INVALID_HANDLE);
+
+    // Same list every call: the epoll set is built once. Duplicates are allowed.
+    NativeHandle handles[] = {a, b, a};
+    const uint64_t rebuilds = events.GetStats().rebuilds;
+    for (int i = 0; i < 10; ++i) {
+        events.SetEvent(b);
+        EXPECT_EQ(events.WaitAny(handles, 3, 0), WAIT_OBJECT_0 + 1);
+    }
+    EXPECT_EQ(events.GetStats().rebuilds, rebuilds + 1);
+    EXPECT_EQ(events.GetStats().signaled, 10u);
+
+    // Closing a registered handle removes it from the set in place: {b} needs no rebuild
+    events.CloseHandle(a);
+    EXPECT_EQ(events.WaitAny(&b, 1, 0), WAIT_TIMEOUT);
+    EXPECT_EQ(events.GetStats().rebuilds, rebuilds + 1);
+    EXPECT_EQ(events.GetStats().spurious, 0u);
+    events.CloseHandle(b);
+}
+
+// EngineCore on the Linux reactor (everything else in-memory): each wake reason lands
+// in the same wakeup* counter as under WaitForMultipleObjects.
+TEST(LinuxEventServiceTest, EngineControlLoopWakeupCounters) {
+    const fs::path dir = ScratchDir();
+    std::ofstream(dir / "UnLeaf.ini") << "[Targets]\nnotepad.exe=1\n";
+
+    FakePlatform fake;
+    LinuxEventService events;
+    platform::Platform& base = fake.AsPlatform();
+    platform::Platform os{base.process, base.snapshot, base.timers, base.clock,
+                          events, base.monitor, base.policy};
+    {
+        EngineCore engine(os);
+        ASSERT_TRUE(engine.Initialize(dir.wstring()));
+        engine.Start(ControlLoopMode::CALLER_PUMPED);
+
+        // Enforcement request: one wakeup for the launch
+        fake.LaunchProcess(1000, 4, L"notepad.exe");
+        for (int i = 0; i < 20 && engine.GetHealthInfo().wakeupEnforcementRequest == 0; ++i) {
+            engine.RunControlLoopOnce(100);
+        }
+        EXPECT_EQ(engine.GetHealthInfo().wakeupEnforcementRequest, 1u);
+
+        // Config edit: one wakeup per save; the engine's own log writes never count (§9.34)
+        EXPECT_EQ(engine.GetHealthInfo().wakeupConfigChange, 0u);
+        std::ofstream(dir / "UnLeaf.ini", std::ios::app) << "calc.exe=1\n";
+        for (int i = 0; i < 20 && engine.GetHealthInfo().wakeupConfigChange == 0; ++i) {
+            engine.RunControlLoopOnce(100);
+        }
+        EXPECT_EQ(engine.GetHealthInfo().wakeupConfigChange, 1u);
+
+        // Idle: the auto-reset request event was consumed, the 10s timer has not fired
+        for (int i = 0; i < 20 && events.GetStats().timeouts == 0; ++i) {
+            engine.RunControlLoopOnce(0);
+        }
+        EXPECT_GT(events.GetStats().timeouts, 0u);
+        EXPECT_EQ(engine.GetHealthInfo().wakeupEnforcementRequest, 1u);
+        EXPECT_EQ(engine.GetHealthInfo().wakeupSafetyNet, 0u);
+        EXPECT_EQ(events.GetStats().spurious, 0u);
+
+        engine.Stop();
+    }
+    fs::remove_all(dir);
+}
+
+#endif // __linux__
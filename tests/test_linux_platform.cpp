@@ -0,0 +1,265 @@
+// UnLeaf Unit Tests - Linux timer queue / clock / policy store / NativePlatform()
+// Tests: one-shot and periodic timerfd timers, DeleteTimer waiting for an in-flight callback,
+//        deletion from inside a callback, DeleteQueue freeing pending timers, monotonic clock,
+//        in-memory policy bookkeeping, NativePlatform wiring, EngineCore on the real timer queue
+
+#ifdef __linux__
+
+#include <gtest/gtest.h>
+#include "platform/linux/linux_platform.h"
+#include "platform/linux/linux_event_service.h"
+#include "platform/linux/netlink_process_monitor.h"
+#include "platform/fake/fake_platform.h"
+#include "service/engine_core.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace unleaf;
+using unleaf::platform::FakePlatform;
+using unleaf::platform::LinuxClock;
+using unleaf::platform::LinuxPolicyStore;
+using unleaf::platform::LinuxTimerService;
+using unleaf::platform::NativeHandle;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct FireCounter {
+    std::atomic<int> fired{0};
+};
+
+void CALLBACK CountFire(PVOID context, BOOLEAN) {
+    static_cast<FireCounter*>(context)->fired.fetch_add(1);
+}
+
+struct SlowCallback {
+    std::atomic<bool> entered{false};
+    std::atomic<bool> finished{false};
+};
+
+void CALLBACK SlowFire(PVOID context, BOOLEAN) {
+    auto* slow = static_cast<SlowCallback*>(context);
+    slow->entered = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    slow->finished = true;
+}
+
+struct SelfDelete {
+    LinuxTimerService* timers = nullptr;
+    NativeHandle queue = nullptr;
+    NativeHandle timer = nullptr;
+    std::atomic<int> fired{0};
+};
+
+void CALLBACK DeleteSelf(PVOID context, BOOLEAN) {
+    auto* self = static_cast<SelfDelete*>(context);
+    self->fired.fetch_add(1);
+    // waitForCallbacks=true from the worker itself must not deadlock
+    self->timers->DeleteTimer(self->queue, self->timer, true);
+}
+
+template <typename Pred>
+bool WaitFor(Pred pred, int timeoutMs = 2000) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(LinuxTimerServiceTest, OneShotFiresOnceAfterDueTime) {
+    LinuxTimerService timers;
+    LinuxClock clock;
+    NativeHandle queue = timers.CreateQueue();
+    ASSERT_NE(queue, nullptr);
+
+    FireCounter counter;
+    NativeHandle timer = nullptr;
+    ULONGLONG start = clock.NowMs();
+    ASSERT_TRUE(timers.CreateTimer(&timer, queue, CountFire, &counter, 30, 0));
+    ASSERT_NE(timer, nullptr);
+
+    ASSERT_TRUE(WaitFor([&] { return counter.fired.load() == 1; }));
+    EXPECT_GE(clock.NowMs() - start, 30u);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(counter.fired.load(), 1);
+
+    // The spent one-shot handle stays valid until deleted (DeleteTimerQueueTimer contract)
+    EXPECT_TRUE(timers.DeleteTimer(queue, timer, true));
+    EXPECT_TRUE(timers.DeleteQueue(queue, true));
+}
+
+TEST(LinuxTimerServiceTest, PeriodicFiresUntilDeleted) {
+    LinuxTimerService timers;
+    NativeHandle queue = timers.CreateQueue();
+    ASSERT_NE(queue, nullptr);
+
+    FireCounter counter;
+    NativeHandle timer = nullptr;
+    ASSERT_TRUE(timers.CreateTimer(&timer, queue, CountFire, &counter, 5, 5));
+    ASSERT_TRUE(WaitFor([&] { return counter.fired.load() >= 3; }));
+
+    EXPECT_TRUE(timers.DeleteTimer(queue, timer, true));
+    int afterDelete = counter.fired.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_EQ(counter.fired.load(), afterDelete);
+
+    EXPECT_TRUE(timers.DeleteQueue(queue, true));
+}
+
+TEST(LinuxTimerServiceTest, EarlierTimerAddedLaterFiresFirst) {
+    LinuxTimerService timers;
+    NativeHandle queue = timers.CreateQueue();
+    ASSERT_NE(queue, nullptr);
+
+    // The worker is already parked on the 10s deadline; the new 10ms timer must re-arm it
+    FireCounter slow, fast;
+    NativeHandle slowTimer = nullptr, fastTimer = nullptr;
+    ASSERT_TRUE(timers.CreateTimer(&slowTimer, queue, CountFire, &slow, 10000, 0));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_TRUE(timers.CreateTimer(&fastTimer, queue, CountFire, &fast, 10, 0));
+
+    ASSERT_TRUE(WaitFor([&] { return fast.fired.load() == 1; }));
+    EXPECT_EQ(slow.fired.load(), 0);
+
+    // DeleteQueue releases the pending timer without firing it
+    EXPECT_TRUE(timers.DeleteQueue(queue, true));
+    EXPECT_EQ(slow.fired.load(), 0);
+}
+
+TEST(LinuxTimerServiceTest, DeleteTimerWaitsForInFlightCallback) {
+    LinuxTimerService timers;
+    NativeHandle queue = timers.CreateQueue();
+    ASSERT_NE(queue, nullptr);
+
+    SlowCallback slow;
+    NativeHandle timer = nullptr;
+    ASSERT_TRUE(timers.CreateTimer(&timer, queue, SlowFire, &slow, 0, 0));
+    ASSERT_TRUE(WaitFor([&] { return slow.entered.load(); }));
+
+    EXPECT_TRUE(timers.DeleteTimer(queue, timer, true));
+    EXPECT_TRUE(slow.finished.load());
+
+    EXPECT_TRUE(timers.DeleteQueue(queue, true));
+}
+
+TEST(LinuxTimerServiceTest, CallbackCanDeleteItsOwnTimer) {
+    LinuxTimerService timers;
+    NativeHandle queue = timers.CreateQueue();
+    ASSERT_NE(queue, nullptr);
+
+    SelfDelete self;
+    self.timers = &timers;
+    self.queue = queue;
+    ASSERT_TRUE(timers.CreateTimer(&self.timer, queue, DeleteSelf, &self, 5, 5));
+    ASSERT_TRUE(WaitFor([&] { return self.fired.load() == 1; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_EQ(self.fired.load(), 1);
+
+    EXPECT_TRUE(timers.DeleteQueue(queue, true));
+}
+
+TEST(LinuxTimerServiceTest, ArgumentErrors) {
+    LinuxTimerService timers;
+    NativeHandle queue = timers.CreateQueue();
+    ASSERT_NE(queue, nullptr);
+
+    FireCounter counter;
+    NativeHandle timer = nullptr;
+    EXPECT_FALSE(timers.CreateTimer(&timer, nullptr, CountFire, &counter, 0, 0));
+    EXPECT_EQ(timers.LastError(), ERROR_INVALID_PARAMETER);
+    EXPECT_FALSE(timers.CreateTimer(nullptr, queue, CountFire, &counter, 0, 0));
+    EXPECT_FALSE(timers.DeleteQueue(nullptr, true));
+    EXPECT_EQ(timers.LastError(), ERROR_INVALID_HANDLE);
+
+    // A timer that never fired is released by DeleteTimer alone
+    ASSERT_TRUE(timers.CreateTimer(&timer, queue, CountFire, &counter, 10000, 0));
+    EXPECT_TRUE(timers.DeleteTimer(queue, timer, true));
+
+    // Non-waiting queue delete returns at once; the worker frees itself
+    EXPECT_TRUE(timers.DeleteQueue(queue, false));
+}
+
+TEST(LinuxClockTest, MonotonicAndSleeps) {
+    LinuxClock clock;
+    ULONGLONG us0 = clock.NowUs();
+    ULONGLONG ms0 = clock.NowMs();
+    clock.SleepMs(20);
+    EXPECT_GE(clock.NowUs() - us0, 20000u);
+    EXPECT_GE(clock.NowMs() - ms0, 20u);
+}
+
+TEST(LinuxPolicyStoreTest, TracksAppliedPathsAcrossReconcile) {
+    LinuxPolicyStore policy;
+    EXPECT_TRUE(policy.Initialize(L"/tmp"));
+    EXPECT_FALSE(policy.HasPolicy(L"/usr/bin/foo"));
+
+    EXPECT_TRUE(policy.ApplyPolicy(L"foo", L"/usr/bin/foo"));
+    EXPECT_TRUE(policy.ApplyPolicy(L"bar", L"/opt/bar"));
+    EXPECT_TRUE(policy.ApplyIFEOOnly(L"baz"));
+    EXPECT_TRUE(policy.HasPolicy(L"/usr/bin/foo"));
+    EXPECT_TRUE(policy.IsPolicyValid(L"/opt/bar"));
+
+    // foo stays by name, bar has neither its path nor its name configured
+    policy.ReconcileWithConfig({ L"foo" }, {});
+    EXPECT_TRUE(policy.HasPolicy(L"/usr/bin/foo"));
+    EXPECT_FALSE(policy.HasPolicy(L"/opt/bar"));
+
+    policy.VerifyAndRepair();
+    EXPECT_EQ(policy.GetPendingQueueSize(), 0);
+    EXPECT_FALSE(policy.ConsumePendingOverflowFlag());
+
+    policy.CleanupAllPolicies();
+    EXPECT_FALSE(policy.HasPolicy(L"/usr/bin/foo"));
+}
+
+TEST(LinuxNativePlatformTest, WiresTheLinuxBackends) {
+    platform::Platform& os = platform::NativePlatform();
+    EXPECT_EQ(&os, &platform::NativePlatform());
+    EXPECT_NE(dynamic_cast<LinuxTimerService*>(&os.timers), nullptr);
+    EXPECT_NE(dynamic_cast<LinuxClock*>(&os.clock), nullptr);
+    EXPECT_NE(dynamic_cast<LinuxPolicyStore*>(&os.policy), nullptr);
+    EXPECT_NE(dynamic_cast<platform::LinuxEventService*>(&os.events), nullptr);
+    EXPECT_NE(dynamic_cast<platform::NetlinkProcessMonitor*>(&os.monitor), nullptr);
+    EXPECT_GT(os.clock.NowUs(), 0u);
+}
+
+TEST(LinuxNativePlatformTest, EngineRunsOnRealTimerQueueAndClock) {
+    const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+    fs::path dir = fs::temp_directory_path() / (std::string("unleaf_platform_") + info->name());
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    { std::ofstream(dir / "UnLeaf.ini") << "[Targets]\nnotepad.exe=1\n"; }
+
+    FakePlatform fake;
+    LinuxTimerService timers;
+    LinuxClock clock;
+    platform::Platform& base = fake.AsPlatform();
+    platform::Platform os{base.process, base.snapshot, timers, clock,
+                          base.events, base.monitor, base.policy};
+    {
+        EngineCore engine(os);
+        ASSERT_TRUE(engine.Initialize(dir.wstring()));
+        engine.Start(ControlLoopMode::CALLER_PUMPED);
+
+        fake.LaunchProcess(1000, 4, L"notepad.exe");
+        for (int i = 0; i < 20 && engine.GetHealthInfo().activeProcesses == 0; ++i) {
+            engine.RunControlLoopOnce(10);
+        }
+        EXPECT_EQ(engine.GetHealthInfo().activeProcesses, 1u);
+
+        // Stop deletes the per-process timers and the queue on the real worker thread
+        engine.Stop();
+    }
+    fs::remove_all(dir);
+}
+
+#endif // __linux__
@@ -0,0 +1,234 @@
+// UnLeaf Unit Tests - Linux IProcessControl (§9.31)
+// Tests: errno / priority-class mappings, per-thread nice, thread throttling count,
+//        EcoQoS OFF result shape, pidfd exit wait, job cgroup under a scratch mount
+// 対象は fork した子プロセス (pause 待ち)。権限 / カーネル機能に依存する部分は結果の形のみ検証する。
+
+#ifdef __linux__
+
+#include <gtest/gtest.h>
+#include "platform/linux/linux_process_control.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using unleaf::platform::JobAssignResult;
+using unleaf::platform::LinuxEnforcementOptions;
+using unleaf::platform::LinuxErrorToWin32;
+using unleaf::platform::LinuxProcessControl;
+using unleaf::platform::NativeHandle;
+using unleaf::platform::PriorityClassToNice;
+
+namespace {
+
+// Child that sleeps until killed; reaped in the destructor
+class ChildProcess {
+public:
+    ChildProcess() {
+        pid_ = ::fork();
+        if (pid_ == 0) {
+            for (;;) ::pause();
+        }
+    }
+    ~ChildProcess() { Kill(); }
+
+    DWORD pid() const { return static_cast<DWORD>(pid_); }
+
+    void Kill() {
+        if (pid_ <= 0) return;
+        ::kill(pid_, SIGKILL);
+        ::waitpid(pid_, nullptr, 0);
+        pid_ = -1;
+    }
+
+private:
+    pid_t pid_ = -1;
+};
+
+std::string ReadAll(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+} // namespace
+
+TEST(LinuxProcessControlTest, ErrnoMapsToWin32Vocabulary) {
+    EXPECT_EQ(LinuxErrorToWin32(0), ERROR_SUCCESS);
+    EXPECT_EQ(LinuxErrorToWin32(EPERM), ERROR_ACCESS_DENIED);
+    EXPECT_EQ(LinuxErrorToWin32(EACCES), ERROR_ACCESS_DENIED);
+    EXPECT_EQ(LinuxErrorToWin32(ESRCH), ERROR_INVALID_PARAMETER);
+    EXPECT_EQ(LinuxErrorToWin32(EINVAL), ERROR_INVALID_PARAMETER);
+    EXPECT_EQ(LinuxErrorToWin32(EBADF), ERROR_INVALID_HANDLE);
+    EXPECT_EQ(LinuxErrorToWin32(ENOSYS), ERROR_NOT_SUPPORTED);
+    EXPECT_EQ(LinuxErrorToWin32(EIO), ERROR_GEN_FAILURE);
+}
+
+TEST(LinuxProcessControlTest, PriorityClassMapsToNice) {
+    int nice = 99;
+    ASSERT_TRUE(PriorityClassToNice(IDLE_PRIORITY_CLASS, nice));
+    EXPECT_EQ(nice, 19);
+    ASSERT_TRUE(PriorityClassToNice(BELOW_NORMAL_PRIORITY_CLASS, nice));
+    EXPECT_EQ(nice, 10);
+    ASSERT_TRUE(PriorityClassToNice(NORMAL_PRIORITY_CLASS, nice));
+    EXPECT_EQ(nice, 0);
+    ASSERT_TRUE(PriorityClassToNice(HIGH_PRIORITY_CLASS, nice));
+    EXPECT_EQ(nice, -10);
+    EXPECT_FALSE(PriorityClassToNice(0x12345u, nice));
+}
+
+TEST(LinuxProcessControlTest, OpenQueryAndPriorityOnChild) {
+    ChildProcess child;
+    LinuxProcessControl control;
+    control.Initialize();
+
+    NativeHandle h = control.OpenControl(child.pid());
+    ASSERT_NE(h, nullptr);
+
+    DWORD exitCode = 0;
+    ASSERT_TRUE(control.QueryExitCode(h, exitCode));
+    EXPECT_EQ(exitCode, STILL_ACTIVE);
+
+    // fork without exec: the child's image is this test binary
+    std::wstring image = control.QueryImageName(h);
+    EXPECT_NE(image.find(L"UnLeaf_Tests"), std::wstring::npos) << std::string(image.begin(), image.end());
+    EXPECT_EQ(control.ResolveImagePath(h), unleaf::CanonicalizePath(image));
+    EXPECT_TRUE(control.FileExists(control.ResolveImagePath(h)));
+
+    // Lowering priority needs no privilege
+    ASSERT_TRUE(control.SetPriorityClass(h, BELOW_NORMAL_PRIORITY_CLASS));
+    errno = 0;
+    EXPECT_EQ(::getpriority(PRIO_PROCESS, static_cast<id_t>(child.pid())), 10);
+    EXPECT_TRUE(control.SetPriorityClass(h, PROCESS_MODE_BACKGROUND_END));
+    EXPECT_FALSE(control.SetPriorityClass(h, 0x12345u));
+    EXPECT_EQ(control.LastError(), ERROR_INVALID_PARAMETER);
+
+    // Without uclamp, a positive nice is the throttled state
+    if (!control.SupportsFullEcoQoS()) {
+        EXPECT_TRUE(control.IsEcoQoSEnabled(h));
+    }
+
+    // One thread visited; conservative mode boosts nice 10 when permitted
+    EXPECT_EQ(control.DisableThreadThrottling(child.pid(), false), 1);
+    if (::geteuid() == 0) {
+        EXPECT_EQ(::getpriority(PRIO_PROCESS, static_cast<id_t>(child.pid())),
+                  control.Options().boostNice);
+    }
+
+    control.CloseHandle(h);
+    EXPECT_EQ(control.OpenControl(0), nullptr);
+}
+
+TEST(LinuxProcessControlTest, EcoQoSOffWithoutJobSkipsGroupLayer) {
+    ChildProcess child;
+    LinuxProcessControl control;
+    control.Initialize();
+
+    NativeHandle h = control.OpenControl(child.pid());
+    ASSERT_NE(h, nullptr);
+    auto eco = control.SetEcoQoSOff(h, 0x5, control.SupportsFullEcoQoS());
+    EXPECT_FALSE(eco.usedNtApi);   // no cgroupParent configured
+    EXPECT_FALSE(eco.ntFallback);
+    EXPECT_TRUE(eco.success || eco.error == ERROR_ACCESS_DENIED);
+    if (eco.success) {
+        EXPECT_FALSE(control.IsEcoQoSEnabled(h));
+    }
+    control.CloseHandle(h);
+}
+
+TEST(LinuxProcessControlTest, ExitWaitFiresOnKill) {
+    ChildProcess child;
+    LinuxProcessControl control;
+    control.Initialize();
+
+    NativeHandle h = control.OpenSynchronize(child.pid());
+    ASSERT_NE(h, nullptr);
+
+    std::atomic<int> fired{0};
+    NativeHandle wait = nullptr;
+    if (!control.RegisterExitWait(&wait, h, [](PVOID ctx, BOOLEAN) {
+            static_cast<std::atomic<int>*>(ctx)->fetch_add(1);
+        }, &fired)) {
+        control.CloseHandle(h);
+        GTEST_SKIP() << "pidfd not supported";
+    }
+    // Waits stay valid after the process handle is closed
+    control.CloseHandle(h);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(fired.load(), 0);
+
+    child.Kill();
+    for (int i = 0; i < 500 && fired.load() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(fired.load(), 1);
+    EXPECT_TRUE(control.UnregisterExitWait(wait));
+}
+
+TEST(LinuxProcessControlTest, JobCgroupUnderScratchMount) {
+    char scratch[] = "/tmp/unleaf_cgroup_XXXXXX";
+    ASSERT_NE(::mkdtemp(scratch), nullptr);
+
+    ChildProcess child;
+    LinuxEnforcementOptions options;
+    options.cgroupMount = scratch;
+    options.cgroupParent = "unleaf";
+    options.cgroupWeight = 777;
+    LinuxProcessControl control(options);
+    control.Initialize();
+
+    NativeHandle h = control.OpenControl(child.pid());
+    ASSERT_NE(h, nullptr);
+
+    NativeHandle job = nullptr;
+    ASSERT_EQ(control.AssignToNewJob(h, &job), JobAssignResult::ASSIGNED);
+    ASSERT_NE(job, nullptr);
+
+    const std::string dir = std::string(scratch) + "/unleaf/job-" + std::to_string(child.pid());
+    EXPECT_EQ(std::stoul(ReadAll(dir + "/cgroup.procs")), child.pid());
+    EXPECT_EQ(ReadAll(dir + "/cpu.weight"), "777");
+    EXPECT_EQ(ReadAll(dir + "/cpu.uclamp.min"), "50.00");
+
+    DWORD pids[8] = {};
+    DWORD count = 0;
+    ASSERT_TRUE(control.QueryJobProcessIds(job, pids, 8, &count));
+    ASSERT_EQ(count, 1u);
+    EXPECT_EQ(pids[0], child.pid());
+
+    // Second assignment through the same handle: already grouped
+    NativeHandle job2 = nullptr;
+    EXPECT_EQ(control.AssignToNewJob(h, &job2), JobAssignResult::ALREADY_IN_JOB);
+    EXPECT_EQ(job2, nullptr);
+
+    // Group layer now active for EcoQoS OFF
+    auto eco = control.SetEcoQoSOff(h, 0x5, true);
+    EXPECT_TRUE(eco.usedNtApi);
+    EXPECT_FALSE(eco.ntFallback);
+
+    control.CloseHandle(job);
+    control.CloseHandle(h);
+    std::system((std::string("rm -rf ") + scratch).c_str());
+}
+
+TEST(LinuxProcessControlTest, JobWithoutCgroupParentFails) {
+    ChildProcess child;
+    LinuxProcessControl control;
+    NativeHandle h = control.OpenControl(child.pid());
+    ASSERT_NE(h, nullptr);
+    NativeHandle job = nullptr;
+    EXPECT_EQ(control.AssignToNewJob(h, &job), JobAssignResult::CREATE_FAILED);
+    EXPECT_EQ(control.LastError(), ERROR_NOT_SUPPORTED);
+    control.CloseHandle(h);
+}
+
+#endif // __linux__
@@ -0,0 +1,79 @@
+// UnLeaf Unit Tests - Linux ISystemSnapshot (/proc, §9.38)
+// Tests: own process with its threads, forked child with parent and image name,
+//        exited child absent from the next capture, self usage counters
+
+#ifdef __linux__
+
+#include <gtest/gtest.h>
+#include "platform/linux/linux_system_snapshot.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using engine_logic::SystemSnapshot;
+using unleaf::platform::LinuxSystemSnapshot;
+using unleaf::platform::SelfUsage;
+
+TEST(LinuxSystemSnapshotTest, CapturesProcessesWithThreads) {
+    std::atomic<bool> stop{false};
+    std::atomic<uint32_t> workerTid{0};
+    std::thread worker([&] {
+        workerTid = static_cast<uint32_t>(::syscall(SYS_gettid));
+        while (!stop) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+    while (workerTid == 0) std::this_thread::yield();
+
+    const pid_t child = ::fork();
+    if (child == 0) {
+        for (;;) ::pause();
+    }
+    ASSERT_GT(child, 0);
+
+    LinuxSystemSnapshot source;
+    SystemSnapshot snap;
+    ASSERT_TRUE(source.Capture(snap));
+    EXPECT_GT(snap.Size(), 2u);
+
+    const uint32_t self = static_cast<uint32_t>(::getpid());
+    const SystemSnapshot::Process* me = snap.Find(self);
+    ASSERT_NE(me, nullptr);
+    EXPECT_EQ(me->parentPid, static_cast<uint32_t>(::getppid()));
+    EXPECT_EQ(snap.Name(*me), L"UnLeaf_Tests");
+    const SystemSnapshot::ThreadSpan threads = snap.Threads(*me);
+    EXPECT_NE(std::find(threads.begin(), threads.end(), self), threads.end());
+    EXPECT_NE(std::find(threads.begin(), threads.end(), workerTid.load()), threads.end());
+
+    // fork without exec: same image, one thread
+    const SystemSnapshot::Process* kid = snap.Find(static_cast<uint32_t>(child));
+    ASSERT_NE(kid, nullptr);
+    EXPECT_EQ(kid->parentPid, self);
+    EXPECT_EQ(snap.Name(*kid), L"UnLeaf_Tests");
+    EXPECT_EQ(kid->threadCount, 1u);
+
+    ::kill(child, SIGKILL);
+    ::waitpid(child, nullptr, 0);
+    ASSERT_TRUE(source.Capture(snap));
+    EXPECT_EQ(snap.Find(static_cast<uint32_t>(child)), nullptr);
+    EXPECT_NE(snap.Find(self), nullptr);
+
+    stop = true;
+    worker.join();
+}
+
+TEST(LinuxSystemSnapshotTest, SelfUsageFromProc) {
+    LinuxSystemSnapshot source;
+    SelfUsage usage;
+    source.QuerySelfUsage(usage);
+    EXPECT_EQ(usage.pid, static_cast<DWORD>(::getpid()));
+    EXPECT_GE(usage.handleCount, 3u);   // stdin / stdout / stderr
+    ASSERT_TRUE(usage.memoryValid);
+    EXPECT_GT(usage.workingSetBytes, 0u);
+    EXPECT_LE(usage.privateBytes, usage.workingSetBytes);
+}
+
+#endif // __linux__
@@ -0,0 +1,54 @@
+// UnLeaf Unit Tests - SafetyNet negative classification cache (§9.40)
+// Tests: hit only for the same PID + creation time + image, PID reuse / exec miss,
+//        generation change drops everything, Prune removes exited PIDs
+
+#include <gtest/gtest.h>
+#include "engine/non_target_cache.h"
+
+#include <set>
+
+using engine_logic::NonTargetCache;
+
+TEST(NonTargetCacheTest, HitRequiresSameProcessIdentity) {
+    NonTargetCache cache;
+    cache.SetGeneration(1);
+    cache.Insert(1000, 111, 0xA);
+    cache.Insert(1004, 222, 0xB);
+
+    EXPECT_TRUE(cache.Contains(1000, 111, 0xA));
+    EXPECT_FALSE(cache.Contains(1000, 112, 0xA));   // PID reused by a newer process
+    EXPECT_FALSE(cache.Contains(1000, 111, 0xC));   // exec: same PID and start time, new image
+    EXPECT_FALSE(cache.Contains(1008, 111, 0xA));
+
+    // Reuse overwrites the old entry
+    cache.Insert(1000, 333, 0xD);
+    EXPECT_EQ(cache.Size(), 2u);
+    EXPECT_FALSE(cache.Contains(1000, 111, 0xA));
+    EXPECT_TRUE(cache.Contains(1000, 333, 0xD));
+
+    EXPECT_TRUE(cache.Erase(1004));
+    EXPECT_FALSE(cache.Erase(1004));
+    EXPECT_FALSE(cache.Contains(1004, 222, 0xB));
+}
+
+TEST(NonTargetCacheTest, GenerationChangeDropsEntries) {
+    NonTargetCache cache;
+    cache.SetGeneration(3);
+    for (uint32_t pid = 4; pid < 400; pid += 4) cache.Insert(pid, pid, pid);
+    cache.SetGeneration(3);   // same generation: kept
+    EXPECT_EQ(cache.Size(), 99u);
+    cache.SetGeneration(4);   // config reloaded
+    EXPECT_EQ(cache.Size(), 0u);
+    EXPECT_EQ(cache.Generation(), 4u);
+    EXPECT_FALSE(cache.Contains(4, 4, 4));
+}
+
+TEST(NonTargetCacheTest, PruneRemovesExitedProcesses) {
+    NonTargetCache cache;
+    for (uint32_t pid = 4; pid <= 200; pid += 4) cache.Insert(pid, 1, 1);
+    const std::set<uint32_t> alive = {8, 100, 200};
+    EXPECT_EQ(cache.Prune([&](uint32_t pid) { return alive.count(pid) > 0; }), 47u);
+    EXPECT_EQ(cache.Size(), 3u);
+    for (uint32_t pid : alive) EXPECT_TRUE(cache.Contains(pid, 1, 1));
+    EXPECT_EQ(cache.Prune([](uint32_t) { return true; }), 0u);
+}
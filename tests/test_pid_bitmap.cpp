@@ -0,0 +1,88 @@
+// UnLeaf Unit Tests - PID bitmap prefilter + per-second counter (§9.28)
+// Tests: set/clear/test across word boundaries, out-of-range PIDs pass,
+//        concurrent writers on one word, per-second buckets roll and expire
+
+#include <gtest/gtest.h>
+#include "engine/pid_bitmap.h"
+
+#include <thread>
+#include <vector>
+
+using engine_logic::PerSecondCounter;
+using engine_logic::PidBitmap;
+
+TEST(PidBitmapTest, SetClearTest) {
+    PidBitmap bits;
+    EXPECT_FALSE(bits.Test(0));
+    EXPECT_FALSE(bits.Test(1000));
+
+    for (uint32_t pid : {0u, 4u, 63u, 64u, 1000u, PidBitmap::PID_SPACE - 1}) {
+        bits.Set(pid);
+        EXPECT_TRUE(bits.Test(pid)) << pid;
+    }
+    EXPECT_FALSE(bits.Test(8));
+    EXPECT_FALSE(bits.Test(62));
+    EXPECT_FALSE(bits.Test(65));
+
+    bits.Clear(63);
+    EXPECT_FALSE(bits.Test(63));
+    EXPECT_TRUE(bits.Test(64));   // neighbour in the next word untouched
+    EXPECT_TRUE(bits.Test(4));    // same word untouched
+
+    bits.Reset();
+    EXPECT_FALSE(bits.Test(4));
+    EXPECT_FALSE(bits.Test(PidBitmap::PID_SPACE - 1));
+}
+
+TEST(PidBitmapTest, OutOfRangePidsPassThrough) {
+    PidBitmap bits;
+    EXPECT_TRUE(bits.Test(PidBitmap::PID_SPACE));
+    EXPECT_TRUE(bits.Test(0xFFFFFFFFu));
+    bits.Set(PidBitmap::PID_SPACE + 4);    // ignored
+    bits.Clear(PidBitmap::PID_SPACE + 4);  // ignored
+    EXPECT_TRUE(bits.Test(PidBitmap::PID_SPACE + 4));
+}
+
+TEST(PidBitmapTest, ConcurrentSetsInOneWordAreNotLost) {
+    PidBitmap bits;
+    std::vector<std::thread> writers;
+    for (uint32_t t = 0; t < 4; ++t) {
+        writers.emplace_back([&bits, t] {
+            for (uint32_t i = t; i < 64; i += 4) bits.Set(128 + i);
+        });
+    }
+    for (auto& w : writers) w.join();
+    for (uint32_t i = 0; i < 64; ++i) EXPECT_TRUE(bits.Test(128 + i)) << i;
+}
+
+TEST(PerSecondCounterTest, ReportsLastCompletedSecond) {
+    PerSecondCounter c;
+    EXPECT_EQ(c.LastSecond(5000), 0u);
+
+    c.Add(5000);
+    c.Add(5999, 2);
+    EXPECT_EQ(c.LastSecond(5999), 0u);   // second 5 still open
+    EXPECT_EQ(c.LastSecond(6000), 3u);
+    EXPECT_EQ(c.LastSecond(6999), 3u);
+
+    c.Add(6500);                         // second 6 opens; 5 becomes previous
+    EXPECT_EQ(c.LastSecond(6600), 3u);
+    EXPECT_EQ(c.LastSecond(7000), 1u);
+    EXPECT_EQ(c.Total(), 4u);
+}
+
+TEST(PerSecondCounterTest, IdleSecondsReadAsZero) {
+    PerSecondCounter c;
+    c.Add(10000, 50);
+    EXPECT_EQ(c.LastSecond(11000), 50u);
+    EXPECT_EQ(c.LastSecond(12000), 0u);   // nothing during second 11
+
+    c.Add(20000);                         // gap: second 10 is not "previous" of 20
+    EXPECT_EQ(c.LastSecond(20100), 0u);
+    EXPECT_EQ(c.LastSecond(21000), 1u);
+    EXPECT_EQ(c.Total(), 51u);
+
+    c.Reset();
+    EXPECT_EQ(c.Total(), 0u);
+    EXPECT_EQ(c.LastSecond(21000), 0u);
+}
@@ -0,0 +1,146 @@
+// tests/test_pid_table.cpp
+// Unit tests for engine_logic::PidTable (open-addressing PID table, SoA storage).
+// NO Windows headers. NO Win32 APIs.
+
+#include <gtest/gtest.h>
+#include "engine/pid_table.h"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+
+using Table = engine_logic::PidTable<uint64_t, std::shared_ptr<std::string>>;
+
+namespace {
+
+std::shared_ptr<std::string> Name(uint32_t pid) {
+    return std::make_shared<std::string>("p" + std::to_string(pid));
+}
+
+} // namespace
+
+// ============================================================
+// PidTable
+// ============================================================
+
+TEST(PidTableTest, EmptyFindsNothing) {
+    Table t;
+    EXPECT_TRUE(t.empty());
+    EXPECT_TRUE(t.find(4) == t.end());
+    EXPECT_FALSE(t.contains(0));
+    EXPECT_FALSE(t.contains(Table::EMPTY_KEY));
+    EXPECT_TRUE(t.begin() == t.end());
+}
+
+TEST(PidTableTest, InsertFindOverwrite) {
+    Table t;
+    t.insert_or_assign(1000, 7, Name(1000));
+    t.insert_or_assign(0, 1, Name(0));   // PID 0 (Idle) is a valid key
+    EXPECT_EQ(t.size(), 2u);
+
+    auto it = t.find(1000);
+    ASSERT_TRUE(it != t.end());
+    EXPECT_EQ(it.key(), 1000u);
+    EXPECT_EQ(it.hot(), 7u);
+    EXPECT_EQ(*it.cold(), "p1000");
+    EXPECT_TRUE(t.contains(0));
+
+    t.insert_or_assign(1000, 9, Name(1001));
+    EXPECT_EQ(t.size(), 2u);
+    EXPECT_EQ(t.find(1000).hot(), 9u);
+    EXPECT_EQ(*t.find(1000).cold(), "p1001");
+
+    // Hot data is mutable in place through the iterator
+    t.find(0).hot() = 42;
+    EXPECT_EQ(t.find(0).hot(), 42u);
+}
+
+TEST(PidTableTest, IterationVisitsEveryEntryOnce) {
+    Table t;
+    for (uint32_t pid = 4; pid <= 400; pid += 4) t.insert_or_assign(pid, pid * 2, Name(pid));
+
+    std::map<uint32_t, uint64_t> seen;
+    for (const auto& [pid, hot, cold] : t) {
+        EXPECT_TRUE(seen.emplace(pid, hot).second);
+        EXPECT_EQ(*cold, "p" + std::to_string(pid));
+    }
+    ASSERT_EQ(seen.size(), 100u);
+    for (const auto& [pid, hot] : seen) EXPECT_EQ(hot, uint64_t{pid} * 2);
+}
+
+TEST(PidTableTest, GrowsAndKeepsLoadAtMostHalf) {
+    Table t;
+    for (uint32_t pid = 0; pid < 40000; ++pid) t.insert_or_assign(pid * 4, pid, Name(pid));
+    EXPECT_EQ(t.size(), 40000u);
+    EXPECT_GE(t.Capacity(), 80000u);
+    for (uint32_t pid = 0; pid < 40000; ++pid) {
+        auto it = t.find(pid * 4);
+        ASSERT_TRUE(it != t.end());
+        EXPECT_EQ(it.hot(), pid);
+    }
+    EXPECT_FALSE(t.contains(2));
+}
+
+TEST(PidTableTest, EraseReleasesColdAndKeepsChainsReachable) {
+    Table t(64);
+    auto keep = Name(8);
+    std::weak_ptr<std::string> watch = keep;
+    t.insert_or_assign(8, 0, std::move(keep));
+    EXPECT_EQ(t.erase(8), 1u);
+    EXPECT_TRUE(watch.expired());
+    EXPECT_EQ(t.erase(8), 0u);
+    EXPECT_TRUE(t.empty());
+}
+
+// Randomized insert/erase against std::map: backward-shift deletion must never
+// strand an entry behind an emptied slot.
+TEST(PidTableTest, RandomOpsMatchStdMap) {
+    Table t;
+    std::map<uint32_t, uint64_t> ref;
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<uint32_t> pidDist(0, 2047);
+    for (int i = 0; i < 200000; ++i) {
+        const uint32_t pid = pidDist(rng) * 4;
+        if (rng() % 3 == 0) {
+            EXPECT_EQ(t.erase(pid), ref.erase(pid));
+        } else {
+            t.insert_or_assign(pid, i, Name(pid));
+            ref[pid] = i;
+        }
+        if (i % 997 == 0) {
+            ASSERT_EQ(t.size(), ref.size());
+            for (const auto& [p, v] : ref) {
+                auto it = t.find(p);
+                ASSERT_TRUE(it != t.end());
+                EXPECT_EQ(it.hot(), v);
+            }
+        }
+    }
+    size_t visited = 0;
+    for (const auto& [pid, hot, cold] : t) {
+        ASSERT_TRUE(ref.count(pid));
+        EXPECT_EQ(ref[pid], hot);
+        ++visited;
+    }
+    EXPECT_EQ(visited, ref.size());
+}
+
+TEST(PidTableTest, ClearAndReserve) {
+    Table t;
+    for (uint32_t pid = 4; pid <= 4000; pid += 4) t.insert_or_assign(pid, 1, Name(pid));
+    const uint32_t cap = t.Capacity();
+    t.clear();
+    EXPECT_TRUE(t.empty());
+    EXPECT_EQ(t.Capacity(), cap);
+    EXPECT_FALSE(t.contains(4));
+
+    t.reserve(100000);
+    EXPECT_GE(t.Capacity(), 200000u);
+}
+
+TEST(PidTableTest, SequentialWindowsPidsProbeShort) {
+    Table t;
+    for (uint32_t pid = 4; pid <= 4 * 32768; pid += 4) t.insert_or_assign(pid, 0, nullptr);
+    EXPECT_LE(t.MaxProbeLength(), 64u);
+}
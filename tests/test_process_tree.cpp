@@ -0,0 +1,221 @@
+// UnLeaf Unit Tests - persistent process tree (§9.37)
+// Tests: seed in any order, O(subtree) descendant walk with pruning, exit orphans children,
+//        PID reuse never adopts older children, cycle guard, reconcile against a snapshot,
+//        event inserts named by reconcile, image references released
+
+#include <gtest/gtest.h>
+#include "engine/process_tree.h"
+
+#include <algorithm>
+#include <vector>
+
+using engine_logic::ProcessTree;
+using engine_logic::StringInternTable;
+
+namespace {
+
+std::vector<uint32_t> Descendants(const ProcessTree& tree, uint32_t pid) {
+    std::vector<uint32_t> out;
+    tree.ForEachDescendant(pid, [&](uint32_t p, const ProcessTree::Node&) {
+        out.push_back(p);
+        return true;
+    });
+    return out;
+}
+
+std::vector<uint32_t> Sorted(std::vector<uint32_t> v) {
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+} // namespace
+
+TEST(ProcessTreeTest, SeedLinksChildrenListedBeforeParents) {
+    ProcessTree tree;
+    // Toolhelp order is not parent-first
+    tree.Seed({{300, 200, L"grandchild.exe"},
+               {200, 100, L"child.exe"},
+               {100, 4, L"root.exe"},
+               {4, 0, L"System"},
+               {0, 0, L"[System Process]"},
+               {500, 999, L"orphan.exe"}},
+              1000);
+
+    EXPECT_EQ(tree.Size(), 6u);
+    EXPECT_EQ(Descendants(tree, 100), (std::vector<uint32_t>{200, 300}));
+    EXPECT_EQ(Sorted(Descendants(tree, 0)), (std::vector<uint32_t>{4, 100, 200, 300}));
+    EXPECT_TRUE(Descendants(tree, 500).empty());
+    EXPECT_FALSE(tree.Find(500)->linked);   // parent 999 unknown
+    EXPECT_FALSE(tree.Find(0)->linked);     // Idle reports itself as parent
+
+    uint32_t chain[8];
+    ASSERT_EQ(tree.Ancestors(300, chain, 8), 4u);
+    EXPECT_EQ(chain[0], 200u);
+    EXPECT_EQ(chain[1], 100u);
+    EXPECT_EQ(chain[2], 4u);
+    EXPECT_EQ(chain[3], 0u);
+    EXPECT_EQ(tree.Ancestors(300, chain, 2), 2u);
+    EXPECT_EQ(StringInternTable::Instance().View(tree.Find(200)->imageId), L"child.exe");
+}
+
+TEST(ProcessTreeTest, DescendantWalkPrunesAndResumesAtSiblings) {
+    ProcessTree tree;
+    tree.Insert(10, 1, 0, L"root.exe");
+    tree.Insert(20, 10, 1, L"a.exe");
+    tree.Insert(21, 20, 2, L"a1.exe");
+    tree.Insert(22, 21, 3, L"a2.exe");
+    tree.Insert(30, 10, 4, L"conhost.exe", true);
+    tree.Insert(31, 30, 5, L"hidden.exe");
+    tree.Insert(40, 10, 6, L"b.exe");
+
+    EXPECT_EQ(Sorted(Descendants(tree, 10)), (std::vector<uint32_t>{20, 21, 22, 30, 31, 40}));
+
+    // Pruned node is reported, its subtree is not (InitialScan skips critical images so)
+    std::vector<uint32_t> seen;
+    tree.ForEachDescendant(10, [&](uint32_t pid, const ProcessTree::Node& node) {
+        seen.push_back(pid);
+        return !node.critical;
+    });
+    EXPECT_EQ(Sorted(seen), (std::vector<uint32_t>{20, 21, 22, 30, 40}));
+
+    // Parents before children
+    const std::vector<uint32_t> order = Descendants(tree, 10);
+    auto pos = [&](uint32_t pid) { return std::find(order.begin(), order.end(), pid) - order.begin(); };
+    EXPECT_LT(pos(20), pos(21));
+    EXPECT_LT(pos(21), pos(22));
+
+    // A walk from an inner node stays inside its subtree
+    EXPECT_EQ(Descendants(tree, 20), (std::vector<uint32_t>{21, 22}));
+    EXPECT_TRUE(Descendants(tree, 22).empty());
+    EXPECT_TRUE(Descendants(tree, 12345).empty());
+}
+
+TEST(ProcessTreeTest, ExitOrphansChildrenAndReusedPidDoesNotAdoptThem) {
+    ProcessTree tree;
+    tree.Insert(10, 1, 0, L"launcher.exe");
+    tree.Insert(20, 10, 1, L"app.exe");
+    tree.Insert(21, 10, 2, L"app.exe");
+    tree.Insert(22, 10, 3, L"app.exe");
+
+    // Middle of the sibling list
+    EXPECT_TRUE(tree.Remove(21));
+    EXPECT_FALSE(tree.Remove(21));
+    EXPECT_EQ(Sorted(tree.Children(10)), (std::vector<uint32_t>{20, 22}));
+
+    EXPECT_TRUE(tree.Remove(10));
+    EXPECT_FALSE(tree.Find(20)->linked);
+    EXPECT_EQ(tree.Find(20)->parentPid, 10u);
+    uint32_t chain[4];
+    EXPECT_EQ(tree.Ancestors(20, chain, 4), 0u);
+
+    // PID 10 reused by an unrelated process: old children stay roots, new ones link
+    tree.Insert(10, 1, 50, L"other.exe");
+    EXPECT_TRUE(tree.Children(10).empty());
+    tree.Insert(60, 10, 51, L"new.exe");
+    EXPECT_EQ(tree.Children(10), (std::vector<uint32_t>{60}));
+
+    // Start event for a live PID = reuse without an exit event: the node is replaced
+    tree.Insert(10, 1, 70, L"third.exe");
+    EXPECT_TRUE(tree.Children(10).empty());
+    EXPECT_FALSE(tree.Find(60)->linked);
+    EXPECT_EQ(tree.Size(), 4u);   // 10, 20, 22, 60
+}
+
+TEST(ProcessTreeTest, StaleParentIdsNeverFormCycles) {
+    ProcessTree tree;
+    // Snapshot with reused PIDs: 100 -> 200 -> 100
+    tree.Seed({{100, 200, L"a.exe"}, {200, 100, L"b.exe"}, {300, 100, L"c.exe"}}, 0);
+
+    const bool linked100 = tree.Find(100)->linked;
+    const bool linked200 = tree.Find(200)->linked;
+    EXPECT_NE(linked100, linked200);
+    // Every walk terminates
+    EXPECT_LE(Descendants(tree, 100).size(), 2u);
+    EXPECT_LE(Descendants(tree, 200).size(), 2u);
+    uint32_t chain[ProcessTree::MAX_DEPTH];
+    EXPECT_LE(tree.Ancestors(300, chain, ProcessTree::MAX_DEPTH), 2u);
+
+    // Self parent
+    tree.Insert(400, 400, 1, L"self.exe");
+    EXPECT_FALSE(tree.Find(400)->linked);
+}
+
+TEST(ProcessTreeTest, ReconcileKeepsMatchesAndRepairsTheRest) {
+    ProcessTree tree;
+    tree.Seed({{10, 1, L"root.exe"}, {20, 10, L"child.exe"}, {30, 10, L"gone.exe"}}, 100);
+    tree.Insert(40, 20, 150, L"seen.exe");     // from an event
+
+    // 30 exited unseen, 20 was reused by another image, 50 started unseen (child of 40)
+    const size_t changes = tree.Reconcile({{10, 1, L"ROOT.EXE"},          // case-insensitive match
+                                           {20, 10, L"reused.exe"},
+                                           {40, 20, L"seen.exe"},
+                                           {50, 40, L"missed.exe"}},
+                                          200);
+    EXPECT_EQ(changes, 4u);   // -30, 20 replaced (-1 +1), +50
+    EXPECT_EQ(tree.Size(), 4u);
+    EXPECT_EQ(tree.Find(10)->startMs, 100u);          // kept
+    EXPECT_EQ(tree.Find(20)->startMs, 200u);          // replaced
+    EXPECT_EQ(tree.Find(40)->startMs, 150u);
+
+    // 40 predates the new 20: not its child any more. 50 links under 40.
+    EXPECT_FALSE(tree.Find(40)->linked);
+    EXPECT_EQ(tree.Children(40), (std::vector<uint32_t>{50}));
+    EXPECT_EQ(tree.Children(10), (std::vector<uint32_t>{20}));
+
+    // A start recorded after the capture is not undone by it
+    tree.Insert(70, 10, 400, L"racing.exe");
+    EXPECT_EQ(tree.Reconcile({{10, 1, L"root.exe"}, {20, 10, L"reused.exe"}, {40, 20, L"seen.exe"},
+                              {50, 40, L"missed.exe"}, {70, 99, L"older.exe"}}, 300), 0u);
+    EXPECT_EQ(tree.Find(70)->parentPid, 10u);
+
+    // Nothing changed: no work
+    EXPECT_EQ(tree.Reconcile({{10, 1, L"root.exe"}, {20, 10, L"reused.exe"}, {40, 20, L"seen.exe"},
+                              {50, 40, L"missed.exe"}, {70, 10, L"racing.exe"}}, 500), 0u);
+}
+
+// Event inserts never intern; the next snapshot names them without counting a change
+TEST(ProcessTreeTest, EventInsertsAreNamedByReconcile) {
+    StringInternTable& strings = StringInternTable::Instance();
+    const StringInternTable::Id probe = strings.Intern(L"tree_refcount_probe.exe");
+    const uint32_t base = strings.RefCount(probe);
+    {
+        ProcessTree tree;
+        tree.Seed({{10, 1, L"root.exe"}}, 0);
+        tree.Insert(20, 10, 5, L"Tree_Refcount_Probe.exe");
+        EXPECT_EQ(tree.Find(20)->imageId, StringInternTable::EMPTY);
+        EXPECT_EQ(tree.Find(20)->nameHash, ProcessTree::NameHash(L"tree_refcount_probe.exe"));
+        EXPECT_EQ(strings.RefCount(probe), base);
+        EXPECT_EQ(tree.Children(10), (std::vector<uint32_t>{20}));
+
+        EXPECT_EQ(tree.Reconcile({{10, 1, L"root.exe"}, {20, 10, L"tree_refcount_probe.exe"}}, 10), 0u);
+        EXPECT_EQ(tree.Find(20)->imageId, probe);
+        EXPECT_EQ(tree.Find(20)->startMs, 5u);   // same node, now named
+        EXPECT_EQ(strings.RefCount(probe), base + 1);
+
+        // A different image under the same PID is still a replacement
+        tree.Insert(30, 10, 20, L"first.exe");
+        EXPECT_EQ(tree.Reconcile({{10, 1, L"root.exe"}, {20, 10, L"tree_refcount_probe.exe"},
+                                  {30, 10, L"second.exe", true}}, 30), 2u);
+        EXPECT_TRUE(tree.Find(30)->critical);
+    }
+    EXPECT_EQ(strings.RefCount(probe), base);
+    strings.Release(probe);
+}
+
+TEST(ProcessTreeTest, ReleasesImageReferences) {
+    StringInternTable& strings = StringInternTable::Instance();
+    const StringInternTable::Id probe = strings.Intern(L"tree_refcount_probe.exe");
+    const uint32_t base = strings.RefCount(probe);
+    {
+        ProcessTree tree;
+        tree.Seed({{10, 1, L"tree_refcount_probe.exe"}, {20, 1, L"tree_refcount_probe.exe"}}, 0);
+        EXPECT_EQ(strings.RefCount(probe), base + 2);
+        tree.Seed({{30, 1, L"tree_refcount_probe.exe"}}, 0);   // Clear releases 10 and 20
+        EXPECT_EQ(strings.RefCount(probe), base + 1);
+        tree.Insert(30, 1, 1, L"tree_refcount_probe.exe");     // replaced by an unnamed node
+        EXPECT_EQ(strings.RefCount(probe), base);
+        tree.Remove(30);
+    }
+    EXPECT_EQ(strings.RefCount(probe), base);
+    strings.Release(probe);
+}
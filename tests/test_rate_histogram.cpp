@@ -0,0 +1,112 @@
+// UnLeaf Unit Tests - per-second rate histogram (§9.35)
+// Tests: log2 bin boundaries, seconds closed on rollover and on read (idle gaps),
+//        last-second / peak reporting, concurrent writers close every second exactly once
+
+#include <gtest/gtest.h>
+#include "engine/rate_histogram.h"
+
+#include <thread>
+#include <vector>
+
+using engine_logic::RateHistogram;
+
+namespace {
+
+uint64_t SumSeconds(const RateHistogram::Snapshot& s) {
+    uint64_t sum = 0;
+    for (uint32_t v : s.seconds) sum += v;
+    return sum;
+}
+
+} // namespace
+
+TEST(RateHistogramTest, BinBoundaries) {
+    EXPECT_EQ(RateHistogram::BinOf(0), 0u);
+    EXPECT_EQ(RateHistogram::BinOf(1), 1u);
+    EXPECT_EQ(RateHistogram::BinOf(2), 2u);
+    EXPECT_EQ(RateHistogram::BinOf(3), 2u);
+    EXPECT_EQ(RateHistogram::BinOf(4), 3u);
+    EXPECT_EQ(RateHistogram::BinOf(4095), 12u);
+    EXPECT_EQ(RateHistogram::BinOf(4096), 13u);
+    EXPECT_EQ(RateHistogram::BinOf(1u << 14), RateHistogram::BINS - 1);
+    EXPECT_EQ(RateHistogram::BinOf(0xFFFFFFFFu), RateHistogram::BINS - 1);
+}
+
+TEST(RateHistogramTest, ClosesSecondsOnRolloverAndRead) {
+    RateHistogram h;
+    h.Reset(10000);
+
+    h.Add(10000, 3);
+    h.Add(10999, 2);
+    RateHistogram::Snapshot s = h.Read(10999);   // second 10 still open
+    EXPECT_EQ(s.total, 5u);
+    EXPECT_EQ(SumSeconds(s), 0u);
+    EXPECT_EQ(s.lastSecond, 0u);
+
+    s = h.Read(11500);                           // closed by the reader
+    EXPECT_EQ(s.seconds[RateHistogram::BinOf(5)], 1u);
+    EXPECT_EQ(s.lastSecond, 5u);
+    EXPECT_EQ(s.peakPerSecond, 5u);
+
+    h.Add(11200, 100);                           // closed by the writer: same picture
+    s = h.Read(11500);
+    EXPECT_EQ(SumSeconds(s), 1u);
+    EXPECT_EQ(s.lastSecond, 5u);
+
+    // Seconds 12..14 idle, 15 busy
+    h.Add(15000, 1);
+    s = h.Read(16000);
+    EXPECT_EQ(s.seconds[0], 3u);
+    EXPECT_EQ(s.seconds[RateHistogram::BinOf(100)], 1u);
+    EXPECT_EQ(s.seconds[1], 1u);
+    EXPECT_EQ(SumSeconds(s), 6u);                // seconds 10..15
+    EXPECT_EQ(s.lastSecond, 1u);
+    EXPECT_EQ(s.peakPerSecond, 100u);
+    EXPECT_EQ(s.total, 106u);
+
+    // Idle read: the open second and the gap after it are both reported
+    s = h.Read(20000);
+    EXPECT_EQ(s.seconds[0], 7u);
+    EXPECT_EQ(s.lastSecond, 0u);
+}
+
+TEST(RateHistogramTest, ResetStartsFromGivenSecond) {
+    RateHistogram h;
+    EXPECT_EQ(SumSeconds(h.Read(5000)), 0u);   // never started
+
+    h.Reset(0);                                // virtual clocks start at second 0
+    h.Add(500, 7);
+    RateHistogram::Snapshot s = h.Read(3000);
+    EXPECT_EQ(s.seconds[RateHistogram::BinOf(7)], 1u);
+    EXPECT_EQ(s.seconds[0], 2u);
+
+    h.Reset(3000);
+    s = h.Read(3000);
+    EXPECT_EQ(s.total, 0u);
+    EXPECT_EQ(s.peakPerSecond, 0u);
+    EXPECT_EQ(SumSeconds(s), 0u);
+}
+
+TEST(RateHistogramTest, ConcurrentWritersCloseEachSecondOnce) {
+    RateHistogram h;
+    h.Reset(0);
+    constexpr int kThreads = 4;
+    constexpr uint32_t kSeconds = 50;
+    constexpr uint32_t kPerSecond = 2000;
+
+    // Writers drift apart: lagging clock reads land in the current second
+    std::vector<std::thread> writers;
+    for (int t = 0; t < kThreads; ++t) {
+        writers.emplace_back([&h] {
+            for (uint32_t sec = 0; sec < kSeconds; ++sec) {
+                for (uint32_t i = 0; i < kPerSecond; ++i) h.Add(uint64_t{sec} * 1000 + i % 1000);
+            }
+        });
+    }
+    for (auto& w : writers) w.join();
+
+    const RateHistogram::Snapshot s = h.Read(uint64_t{kSeconds} * 1000);
+    EXPECT_EQ(s.total, uint64_t{kThreads} * kSeconds * kPerSecond);
+    EXPECT_EQ(SumSeconds(s), kSeconds);
+    EXPECT_GE(s.peakPerSecond, kPerSecond);
+}
@@ -0,0 +1,146 @@
+// UnLeaf Unit Tests - Read-mostly snapshot publication (§9.25)
+// Tests: PidSignalSet membership / flags, RcuCell publish + read,
+//        reclamation never frees a snapshot under a live reader (stress)
+
+#include <gtest/gtest.h>
+#include "engine/rcu_snapshot.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using engine_logic::PidSignalSet;
+using engine_logic::RcuCell;
+
+namespace {
+
+// Snapshot that poisons itself on destruction and counts live instances
+struct Canary {
+    static std::atomic<int> live;
+    explicit Canary(uint32_t v) : value(v), magic(kAlive) { live++; }
+    ~Canary() { magic = 0xDEADDEADu; live--; }
+    static constexpr uint32_t kAlive = 0xC0FFEE00u;
+    uint32_t value;
+    volatile uint32_t magic;
+};
+std::atomic<int> Canary::live{0};
+
+} // namespace
+
+// ============================================================
+// PidSignalSet
+// ============================================================
+
+TEST(PidSignalSetTest, MembershipAndFlags) {
+    PidSignalSet set({4, 8, 0, 4000, 8});
+    EXPECT_EQ(set.size(), 4u);
+    EXPECT_TRUE(set.Contains(0));
+    EXPECT_TRUE(set.Contains(4000));
+    EXPECT_FALSE(set.Contains(12));
+    EXPECT_FALSE(set.Contains(PidSignalSet::EMPTY_KEY));
+
+    auto* f = set.Find(8);
+    ASSERT_NE(f, nullptr);
+    EXPECT_EQ(f->exchange(1), 0u);
+    EXPECT_EQ(f->exchange(1), 1u);
+    EXPECT_EQ(set.Find(4)->load(), 0u);
+}
+
+TEST(PidSignalSetTest, EmptyAndLarge) {
+    PidSignalSet empty({});
+    EXPECT_EQ(empty.size(), 0u);
+    EXPECT_EQ(empty.Find(4), nullptr);
+
+    std::vector<uint32_t> pids;
+    for (uint32_t p = 4; p <= 4 * 32768; p += 4) pids.push_back(p);
+    PidSignalSet large(pids);
+    EXPECT_EQ(large.size(), pids.size());
+    for (uint32_t p : pids) ASSERT_TRUE(large.Contains(p));
+    EXPECT_FALSE(large.Contains(2));
+}
+
+// ============================================================
+// RcuCell
+// ============================================================
+
+TEST(RcuCellTest, ReadSeesLatestPublish) {
+    RcuCell<Canary> cell;
+    EXPECT_FALSE(cell.Read());
+
+    cell.Publish(std::make_unique<Canary>(1));
+    EXPECT_EQ(cell.Read()->value, 1u);
+    cell.Publish(std::make_unique<Canary>(2));
+    EXPECT_EQ(cell.Read()->value, 2u);
+    EXPECT_EQ(cell.WriterPeek()->value, 2u);
+    EXPECT_EQ(cell.PublishCount(), 2u);
+    EXPECT_EQ(Canary::live.load(), 1);   // previous snapshot reclaimed on Publish
+}
+
+TEST(RcuCellTest, PublishWaitsForReaderInsideGuard) {
+    RcuCell<Canary> cell;
+    cell.Publish(std::make_unique<Canary>(1));
+
+    std::atomic<bool> entered{false}, leave{false};
+    std::atomic<uint32_t> seenAfterPublish{0};
+    std::thread reader([&] {
+        auto guard = cell.Read();
+        entered = true;
+        while (!leave) std::this_thread::yield();
+        seenAfterPublish = guard->magic;   // still the old, live snapshot
+    });
+    while (!entered) std::this_thread::yield();
+
+    std::atomic<bool> published{false};
+    std::thread writer([&] {
+        cell.Publish(std::make_unique<Canary>(2));
+        published = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(published.load());   // grace period pending on the reader
+
+    leave = true;
+    reader.join();
+    writer.join();
+    EXPECT_TRUE(published.load());
+    EXPECT_EQ(seenAfterPublish.load(), Canary::kAlive);
+    EXPECT_EQ(cell.Read()->value, 2u);
+}
+
+TEST(RcuCellTest, ReadersNeverObserveReclaimedSnapshot) {
+    constexpr int kReaders = 3;
+    constexpr uint32_t kPublishes = 5000;
+    {
+        RcuCell<Canary> cell;
+        cell.Publish(std::make_unique<Canary>(0));
+
+        std::atomic<bool> stop{false};
+        std::atomic<uint64_t> poisoned{0}, regressed{0}, reads{0};
+        std::vector<std::thread> readers;
+        for (int r = 0; r < kReaders; ++r) {
+            readers.emplace_back([&] {
+                uint32_t last = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    auto guard = cell.Read();
+                    if (guard->magic != Canary::kAlive) poisoned++;
+                    if (guard->value < last) regressed++;
+                    last = guard->value;
+                    reads++;
+                }
+            });
+        }
+        while (reads.load() == 0) std::this_thread::yield();
+        for (uint32_t v = 1; v <= kPublishes; ++v) {
+            cell.Publish(std::make_unique<Canary>(v));
+        }
+        stop = true;
+        for (auto& t : readers) t.join();
+
+        EXPECT_EQ(poisoned.load(), 0u);
+        EXPECT_EQ(regressed.load(), 0u);
+        EXPECT_GT(reads.load(), 0u);
+        EXPECT_EQ(Canary::live.load(), 1);
+    }
+    EXPECT_EQ(Canary::live.load(), 0);
+}
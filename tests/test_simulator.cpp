@@ -0,0 +1,106 @@
+// UnLeaf Unit Tests - Discrete-event simulator
+// Tests: seed determinism, detection latency accounting, PERSISTENT escalation
+//        of EcoQoS-locked processes, exit/teardown bookkeeping
+
+#include <gtest/gtest.h>
+#include "sim/simulator.h"
+
+using namespace unleaf;
+using namespace unleaf::sim;
+
+namespace {
+
+SimScenario SmallScenario(uint64_t seed) {
+    SimScenario s;
+    s.seed = seed;
+    s.durationMs = 10ULL * 60 * 1000;   // 10 simulated minutes
+
+    SimProfile app;
+    app.exeName = L"simapp.exe";
+    app.initialCount = 4;
+    app.arrivalsPerHour = 60.0;
+    app.meanLifetimeMs = 5ULL * 60 * 1000;
+    app.meanReapplyMs = 20ULL * 1000;
+    app.childrenPerProcess = 1;
+    s.profiles.push_back(app);
+    return s;
+}
+
+} // namespace
+
+TEST(SimulatorTest, SameSeedProducesIdenticalReport) {
+    SimScenario scenario = SmallScenario(42);
+    SimReport a, b;
+    ASSERT_TRUE(Simulator(scenario).Run(a));
+    ASSERT_TRUE(Simulator(scenario).Run(b));
+
+    EXPECT_EQ(a.processesLaunched, b.processesLaunched);
+    EXPECT_EQ(a.reapplications, b.reapplications);
+    EXPECT_EQ(a.calls.KernelCalls(), b.calls.KernelCalls());
+    EXPECT_EQ(a.wakeups, b.wakeups);
+    EXPECT_EQ(a.totalViolations, b.totalViolations);
+    EXPECT_EQ(a.latency.samples, b.latency.samples);
+    EXPECT_EQ(a.latency.p99Ms, b.latency.p99Ms);
+    // Wall time is the only non-deterministic field
+    a.wallSeconds = b.wallSeconds = 0.0;
+    EXPECT_EQ(FormatReportJson(scenario, a), FormatReportJson(scenario, b));
+}
+
+TEST(SimulatorTest, DifferentSeedChangesWorkload) {
+    SimReport a, b;
+    ASSERT_TRUE(Simulator(SmallScenario(1)).Run(a));
+    ASSERT_TRUE(Simulator(SmallScenario(2)).Run(b));
+    EXPECT_NE(a.reapplications, b.reapplications);
+}
+
+TEST(SimulatorTest, ReappliedEcoQoSIsDetected) {
+    SimScenario scenario = SmallScenario(7);
+    SimReport r;
+    ASSERT_TRUE(Simulator(scenario).Run(r));
+
+    EXPECT_GT(r.processesLaunched, 4u);
+    EXPECT_GT(r.reapplications, 0u);
+    EXPECT_GT(r.latency.samples, 0u);
+    EXPECT_LE(r.latency.p50Ms, r.latency.p99Ms);
+    EXPECT_LE(r.latency.p99Ms, r.latency.maxMs);
+
+    uint64_t bucketed = 0;
+    for (uint64_t c : r.latency.buckets) bucketed += c;
+    EXPECT_EQ(bucketed, r.latency.samples);
+    EXPECT_GT(r.calls.KernelCalls(), 0u);
+    EXPECT_GT(r.wakeupsPerMinute, 0.0);
+}
+
+TEST(SimulatorTest, LockedProcessEscalatesToPersistent) {
+    SimScenario s;
+    s.seed = 3;
+    s.durationMs = 15ULL * 60 * 1000;
+    SimProfile locked;
+    locked.exeName = L"locked.exe";
+    locked.initialCount = 1;
+    locked.meanReapplyMs = 10ULL * 1000;
+    locked.ecoLocked = true;
+    s.profiles.push_back(locked);
+
+    SimReport r;
+    ASSERT_TRUE(Simulator(s).Run(r));
+
+    EXPECT_GE(r.totalViolations, s.policy.violationThreshold);
+    EXPECT_EQ(r.persistentAtEnd, 1u);
+    EXPECT_GT(r.persistentEnforceApplied, 0u);
+}
+
+TEST(SimulatorTest, ShortVerificationPolicyIsHonored) {
+    SimScenario fast = SmallScenario(11);
+    fast.policy.verifyDelayFinalMs = 500;
+    SimScenario slow = SmallScenario(11);
+    slow.policy.verifyDelayFinalMs = 10000;
+
+    SimReport rf, rs;
+    ASSERT_TRUE(Simulator(fast).Run(rf));
+    ASSERT_TRUE(Simulator(slow).Run(rs));
+
+    // Same workload, different engine timings
+    EXPECT_EQ(rf.reapplications, rs.reapplications);
+    EXPECT_NE(rf.calls.KernelCalls(), rs.calls.KernelCalls());
+}
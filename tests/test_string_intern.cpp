@@ -0,0 +1,111 @@
+// UnLeaf Unit Tests - String interning table (§9.30)
+// Tests: ID stability / sharing, refcount release and ID reuse, InternedString
+//        RAII copy / move / Adopt, concurrent intern + lock-free reads
+
+#include <gtest/gtest.h>
+#include "engine/string_intern.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using engine_logic::InternedString;
+using engine_logic::StringInternTable;
+
+TEST(StringInternTest, EqualStringsShareOneId) {
+    StringInternTable t;
+    const StringInternTable::Id a = t.Intern(L"chrome.exe");
+    const StringInternTable::Id b = t.Intern(std::wstring(L"chrome.exe"));
+    const StringInternTable::Id c = t.Intern(L"Chrome.exe");   // case-sensitive
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_EQ(t.RefCount(a), 2u);
+    EXPECT_EQ(t.View(a), L"chrome.exe");
+    EXPECT_STREQ(t.CStr(c), L"Chrome.exe");
+    EXPECT_EQ(t.LiveCount(), 2u);
+    EXPECT_EQ(t.LiveBytes(), 20 * sizeof(wchar_t));
+}
+
+TEST(StringInternTest, EmptyStringIsUncounted) {
+    StringInternTable t;
+    EXPECT_EQ(t.Intern(L""), StringInternTable::EMPTY);
+    EXPECT_TRUE(t.View(StringInternTable::EMPTY).empty());
+    EXPECT_STREQ(t.CStr(StringInternTable::EMPTY), L"");
+    t.AddRef(StringInternTable::EMPTY);
+    t.Release(StringInternTable::EMPTY);
+    EXPECT_EQ(t.LiveCount(), 0u);
+}
+
+TEST(StringInternTest, LastReleaseFreesAndReusesId) {
+    StringInternTable t;
+    const StringInternTable::Id a = t.Intern(L"a.exe");
+    t.AddRef(a);
+    t.Release(a);
+    EXPECT_EQ(t.View(a), L"a.exe");   // one reference left
+    t.Release(a);
+    EXPECT_EQ(t.LiveCount(), 0u);
+    EXPECT_EQ(t.LiveBytes(), 0u);
+
+    const StringInternTable::Id b = t.Intern(L"b.exe");
+    EXPECT_EQ(b, a);                    // free list
+    EXPECT_EQ(t.View(b), L"b.exe");
+    EXPECT_NE(t.Intern(L"a.exe"), b);
+}
+
+TEST(StringInternTest, InternedStringOwnsOneReference) {
+    StringInternTable& t = StringInternTable::Instance();
+    StringInternTable::Id id;
+    {
+        InternedString a(L"intern_raii.exe");
+        id = a.id();
+        EXPECT_EQ(t.RefCount(id), 1u);
+        InternedString b = a;
+        EXPECT_EQ(t.RefCount(id), 2u);
+        InternedString c = std::move(b);
+        EXPECT_TRUE(b.empty());
+        EXPECT_EQ(t.RefCount(id), 2u);
+        c = InternedString::Adopt(t.Intern(L"intern_raii.exe"));   // old c released
+        EXPECT_EQ(t.RefCount(id), 2u);
+        EXPECT_EQ(std::wstring_view(c), L"intern_raii.exe");
+        EXPECT_STREQ(a.c_str(), L"intern_raii.exe");
+        EXPECT_EQ(a.str(), L"intern_raii.exe");
+    }
+    const StringInternTable::Id probe = t.Intern(L"intern_raii.exe");
+    EXPECT_EQ(t.RefCount(probe), 1u);
+    t.Release(probe);
+}
+
+// Producers intern / release a small working set while readers view held IDs
+TEST(StringInternTest, ConcurrentInternReleaseKeepsHeldStringsStable) {
+    StringInternTable t;
+    const StringInternTable::Id held = t.Intern(L"held.exe");
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> mismatches{0};
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < 4; ++w) {
+        threads.emplace_back([&, w] {
+            for (int i = 0; i < 20000; ++i) {
+                const std::wstring s = L"worker" + std::to_wstring((w + i) % 16) + L".exe";
+                const StringInternTable::Id id = t.Intern(s);
+                if (t.View(id) != s) mismatches++;
+                if (i % 3 == 0) t.Intern(L"held.exe");   // revive / share
+                t.Release(id);
+                if (i % 3 == 0) t.Release(held);
+            }
+        });
+    }
+    threads.emplace_back([&] {
+        while (!stop.load()) {
+            if (t.View(held) != L"held.exe") mismatches++;
+        }
+    });
+    for (int w = 0; w < 4; ++w) threads[w].join();
+    stop.store(true);
+    threads.back().join();
+
+    EXPECT_EQ(mismatches.load(), 0u);
+    EXPECT_EQ(t.RefCount(held), 1u);
+    EXPECT_EQ(t.LiveCount(), 1u);
+}
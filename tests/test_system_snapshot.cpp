@@ -0,0 +1,78 @@
+// UnLeaf Unit Tests - process + thread snapshot arena (§9.38)
+// Tests: OS order kept, Find by pid, NUL-terminated name views, per-process thread spans,
+//        Clear keeps capacity (steady-state capture allocates nothing)
+
+#include <gtest/gtest.h>
+#include "engine/system_snapshot.h"
+
+#include <cwchar>
+#include <vector>
+
+using engine_logic::SystemSnapshot;
+
+namespace {
+
+void Fill(SystemSnapshot& snap, uint32_t processes, uint32_t threadsEach) {
+    snap.Clear();
+    for (uint32_t p = 0; p < processes; ++p) {
+        snap.AddProcess(1000 + p * 4, 4, p % 2 ? L"worker.exe" : L"browser.exe");
+        for (uint32_t t = 0; t < threadsEach; ++t) snap.AddThread((1000 + p * 4) * 16 + t);
+    }
+    snap.Finish();
+}
+
+} // namespace
+
+TEST(SystemSnapshotTest, RowsKeepOrderAndResolveByPid) {
+    SystemSnapshot snap;
+    // Descending, like some Toolhelp / NtQuerySystemInformation walks
+    snap.AddProcess(300, 4, L"c.exe");
+    snap.AddThread(301);
+    snap.AddProcess(0, 0, L"[System Process]");
+    snap.AddProcess(200, 300, L"b.exe");
+    snap.AddThread(201);
+    snap.AddThread(202);
+    snap.AddThread(203);
+    snap.AddProcess(100, 200, L"");
+    snap.Finish();
+
+    ASSERT_EQ(snap.Size(), 4u);
+    EXPECT_EQ(snap.ThreadTotal(), 4u);
+    std::vector<uint32_t> order;
+    for (const auto& p : snap) order.push_back(p.pid);
+    EXPECT_EQ(order, (std::vector<uint32_t>{300, 0, 200, 100}));
+
+    const SystemSnapshot::Process* b = snap.Find(200);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(b->parentPid, 300u);
+    EXPECT_EQ(snap.Name(*b), L"b.exe");
+    EXPECT_EQ(std::wcslen(snap.Name(*b).data()), 5u);   // NUL-terminated in the pool
+    std::vector<uint32_t> threads(snap.Threads(*b).begin(), snap.Threads(*b).end());
+    EXPECT_EQ(threads, (std::vector<uint32_t>{201, 202, 203}));
+
+    EXPECT_TRUE(snap.Threads(*snap.Find(0)).empty());
+    EXPECT_TRUE(snap.Name(*snap.Find(100)).empty());
+    EXPECT_EQ(snap.Name(snap[0]), L"c.exe");
+    EXPECT_EQ(snap.Find(12345), nullptr);
+}
+
+TEST(SystemSnapshotTest, ClearKeepsArenaCapacity) {
+    SystemSnapshot snap;
+    Fill(snap, 500, 12);
+    const size_t bytes = snap.CapacityBytes();
+    ASSERT_GT(bytes, 0u);
+
+    // Same-sized and smaller systems are captured into the same arena
+    for (int i = 0; i < 5; ++i) {
+        Fill(snap, 500 - i * 50, 12);
+        EXPECT_EQ(snap.CapacityBytes(), bytes);
+    }
+    EXPECT_EQ(snap.Size(), 300u);
+    EXPECT_EQ(snap.ThreadTotal(), 300u * 12);
+    ASSERT_NE(snap.Find(1000 + 299 * 4), nullptr);
+    EXPECT_EQ(snap.Find(1000 + 300 * 4), nullptr);   // from the larger capture, gone now
+
+    snap.Clear();
+    EXPECT_TRUE(snap.Empty());
+    EXPECT_EQ(snap.Find(1000), nullptr);
+}
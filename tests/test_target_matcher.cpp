@@ -0,0 +1,136 @@
+// tests/test_target_matcher.cpp
+// Unit tests for engine_logic::TargetMatcher (compiled target tables).
+// NO Windows headers. NO Win32 APIs.
+
+#include <gtest/gtest.h>
+#include "engine/engine_logic.h"
+#include "engine/target_matcher.h"
+
+#include <set>
+#include <string>
+
+using engine_logic::TargetMatcher;
+using engine_logic::IsTargetByPath;
+using engine_logic::FileNameOf;
+
+// ============================================================
+// TargetMatcher
+// ============================================================
+
+TEST(TargetMatcherTest, EmptyMatchesNothing) {
+    TargetMatcher m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_FALSE(m.Contains(L"notepad.exe"));
+    EXPECT_FALSE(m.Contains(L""));
+}
+
+TEST(TargetMatcherTest, ExactMatch) {
+    TargetMatcher m({L"notepad.exe", L"chrome.exe"});
+    EXPECT_EQ(m.size(), 2u);
+    EXPECT_TRUE(m.Contains(L"notepad.exe"));
+    EXPECT_TRUE(m.Contains(L"chrome.exe"));
+    EXPECT_FALSE(m.Contains(L"calc.exe"));
+}
+
+TEST(TargetMatcherTest, CaseFoldingBothSides) {
+    TargetMatcher m({L"Chrome.EXE"});
+    EXPECT_TRUE(m.Contains(L"chrome.exe"));
+    EXPECT_TRUE(m.Contains(L"CHROME.EXE"));
+    EXPECT_TRUE(m.Contains(L"cHrOmE.ExE"));
+}
+
+TEST(TargetMatcherTest, PrefixAndSuffixDoNotMatch) {
+    TargetMatcher m({L"chrome.exe"});
+    EXPECT_FALSE(m.Contains(L"chrome.ex"));
+    EXPECT_FALSE(m.Contains(L"chrome.exe2"));
+    EXPECT_FALSE(m.Contains(L"xchrome.exe"));
+}
+
+TEST(TargetMatcherTest, DuplicatesAfterFoldingCollapse) {
+    TargetMatcher m({L"a.exe", L"A.EXE", L"a.exe"});
+    EXPECT_EQ(m.size(), 1u);
+    EXPECT_TRUE(m.Contains(L"a.exe"));
+}
+
+TEST(TargetMatcherTest, ViewIntoLargerBuffer) {
+    TargetMatcher m({L"notepad.exe"});
+    std::wstring path = L"c:\\windows\\notepad.exe";
+    std::wstring_view view(path);
+    EXPECT_TRUE(m.Contains(view.substr(11)));
+    EXPECT_FALSE(m.Contains(view.substr(10)));
+}
+
+TEST(TargetMatcherTest, NonAsciiFoldsLikeToLower) {
+    EXPECT_EQ(TargetMatcher::Fold(L'A'), L'a');
+    EXPECT_EQ(TargetMatcher::Fold(L'\\'), L'\\');
+    EXPECT_EQ(TargetMatcher::Fold(L'z'), L'z');
+    // Non-ASCII goes through towlower (same rule as types.h ToLower)
+    EXPECT_EQ(TargetMatcher::Fold(L'\u00C9'), static_cast<wchar_t>(towlower(L'\u00C9')));
+}
+
+TEST(TargetMatcherTest, SmallListsArePerfect) {
+    TargetMatcher m({L"ntoskrnl.exe", L"smss.exe", L"csrss.exe", L"wininit.exe",
+                     L"services.exe", L"lsass.exe", L"winlogon.exe", L"svchost.exe",
+                     L"explorer.exe", L"dwm.exe", L"ctfmon.exe", L"unleaf_service.exe",
+                     L"unleaf_manager.exe", L"fontdrvhost.exe", L"audiodg.exe",
+                     L"conhost.exe", L"securityhealthservice.exe", L"msmpeng.exe"});
+    EXPECT_EQ(m.size(), 18u);
+    EXPECT_TRUE(m.IsPerfect());
+    EXPECT_TRUE(m.Contains(L"SvcHost.exe"));
+    EXPECT_FALSE(m.Contains(L"notepad.exe"));
+}
+
+// Large lists may fall back to probing; membership must agree with std::set either way
+TEST(TargetMatcherTest, AgreesWithStdSetOnLargeList) {
+    std::vector<std::wstring> keys;
+    std::set<std::wstring> reference;
+    for (int i = 0; i < 2000; ++i) {
+        std::wstring k = L"proc" + std::to_wstring(i * 7) + L".exe";
+        keys.push_back(k);
+        reference.insert(k);
+    }
+    TargetMatcher m(keys);
+    EXPECT_EQ(m.size(), reference.size());
+    for (int i = 0; i < 14000; ++i) {
+        std::wstring probe = L"PROC" + std::to_wstring(i) + L".EXE";
+        std::wstring lower = L"proc" + std::to_wstring(i) + L".exe";
+        EXPECT_EQ(m.Contains(probe), reference.count(lower) > 0) << i;
+    }
+}
+
+TEST(TargetMatcherTest, KeysReturnsFoldedEntries) {
+    TargetMatcher m({L"B.exe", L"a.exe"});
+    std::vector<std::wstring> keys = m.Keys();
+    ASSERT_EQ(keys.size(), 2u);
+    EXPECT_EQ(keys[0], L"b.exe");
+    EXPECT_EQ(keys[1], L"a.exe");
+}
+
+// ============================================================
+// IsTargetByPath (TargetMatcher overload)
+// ============================================================
+
+TEST(TargetMatcherPathTest, FileNameOf) {
+    EXPECT_EQ(FileNameOf(L"c:\\a\\b\\chrome.exe"), L"chrome.exe");
+    EXPECT_EQ(FileNameOf(L"c:/a/b/chrome.exe"), L"chrome.exe");
+    EXPECT_EQ(FileNameOf(L"chrome.exe"), L"chrome.exe");
+    EXPECT_EQ(FileNameOf(L"c:\\dir\\"), L"");
+}
+
+TEST(TargetMatcherPathTest, ExactPathMatch) {
+    TargetMatcher paths({L"c:\\program files\\google\\chrome\\application\\chrome.exe"});
+    TargetMatcher names;
+    EXPECT_TRUE(IsTargetByPath(
+        std::wstring_view(L"C:\\Program Files\\Google\\Chrome\\Application\\chrome.exe"), paths, names));
+    EXPECT_FALSE(IsTargetByPath(
+        std::wstring_view(L"c:\\users\\me\\chrome sxs\\application\\chrome.exe"), paths, names));
+}
+
+TEST(TargetMatcherPathTest, NameFallback) {
+    TargetMatcher paths;
+    TargetMatcher names({L"chrome.exe"});
+    EXPECT_TRUE(IsTargetByPath(
+        std::wstring_view(L"c:\\program files\\google\\chrome\\application\\Chrome.exe"), paths, names));
+    EXPECT_FALSE(IsTargetByPath(
+        std::wstring_view(L"c:\\program files\\mozilla firefox\\firefox.exe"), paths, names));
+}
@@ -0,0 +1,221 @@
+// UnLeaf Unit Tests - Event capture + offline replay (§9.27)
+// Tests: [Logging] EventTrace=1 capture through the monitor, simulator capture
+//        replays deterministically, start storms reproduce CRITICAL eviction,
+//        batched delivery wakes once per batch, recorded vs max speed,
+//        thread storms are coalesced
+
+#include <gtest/gtest.h>
+#include "sim/simulator.h"
+#include "sim/trace_replay.h"
+#include "engine/event_trace.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace unleaf;
+using namespace unleaf::sim;
+using engine_logic::EventTraceReader;
+using engine_logic::EventTraceWriter;
+using engine_logic::TraceEvent;
+using engine_logic::TraceEventType;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+class TraceReplayTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = fs::temp_directory_path() /
+               ("unleaf_replay_test_" + std::string(::testing::UnitTest::GetInstance()
+                                                        ->current_test_info()->name()));
+        fs::create_directories(dir_);
+        tracePath_ = dir_ / "events.ultrace";
+    }
+    void TearDown() override {
+        std::error_code ec;
+        fs::remove_all(dir_, ec);
+    }
+
+    ReplayReport Replay(const ReplayOptions& options) {
+        EventTraceReader trace;
+        EXPECT_TRUE(trace.Open(tracePath_));
+        ReplayReport report;
+        std::string error;
+        EXPECT_TRUE(TraceReplayer(options).Run(trace, report, error)) << error;
+        return report;
+    }
+
+    static std::string Deterministic(const ReplayOptions& options, ReplayReport r) {
+        r.wallSeconds = 0.0;
+        r.eventsPerSecond = 0.0;
+        return FormatReplayJson(options, r);
+    }
+
+    // count target starts (cl.exe), spacingUs apart
+    void WriteStartBurst(uint32_t count, uint64_t spacingUs) {
+        EventTraceWriter w;
+        ASSERT_TRUE(w.Open(tracePath_));
+        for (uint32_t i = 0; i < count; ++i) {
+            w.AppendProcessStart(T0_US + i * spacingUs, 10000 + 4 * i, 4, L"cl.exe", L"C:\\vs\\cl.exe");
+        }
+    }
+
+    static constexpr uint64_t T0_US = 133000000000000000ull;   // FILETIME / 10 scale
+
+    fs::path dir_;
+    fs::path tracePath_;
+};
+
+} // namespace
+
+TEST_F(TraceReplayTest, EngineCapturesWhenEventTraceEnabled) {
+    const fs::path baseDir = dir_ / "svc";
+    fs::create_directories(baseDir);
+    std::ofstream(baseDir / "UnLeaf.ini")
+        << "[Logging]\nLogEnabled=0\nEventTrace=1\n\n[Targets]\nnotepad.exe=1\n";
+
+    platform::FakePlatform fake;
+    {
+        EngineCore engine(fake.AsPlatform());
+        ASSERT_TRUE(engine.Initialize(baseDir.wstring()));
+        engine.Start(ControlLoopMode::CALLER_PUMPED);
+        fake.LaunchProcess(1000, 4, L"notepad.exe");
+        fake.EmitThreadStart(2000, 1000);
+        engine.Stop();   // flushes and closes the capture
+        fake.LaunchProcess(1004, 4, L"notepad.exe");   // monitor stopped: not captured
+    }
+
+    EventTraceReader trace;
+    ASSERT_TRUE(trace.Open(baseDir / EVENT_TRACE_FILENAME));
+    TraceEvent ev;
+    ASSERT_TRUE(trace.Next(ev));
+    EXPECT_EQ(ev.type, TraceEventType::PROCESS_START);
+    EXPECT_EQ(ev.pid, 1000u);
+    EXPECT_EQ(ev.parentPid, 4u);
+    EXPECT_EQ(ev.imageName, L"notepad.exe");
+    ASSERT_TRUE(trace.Next(ev));
+    EXPECT_EQ(ev.type, TraceEventType::THREAD_START);
+    EXPECT_EQ(ev.pid, 1000u);
+    EXPECT_EQ(ev.tid, 2000u);
+    EXPECT_FALSE(trace.Next(ev));
+    EXPECT_EQ(trace.GetStatus(), EventTraceReader::Status::END);
+}
+
+TEST_F(TraceReplayTest, SimulatorCaptureReplaysDeterministically) {
+    SimScenario s;
+    s.seed = 11;
+    s.durationMs = 5ULL * 60 * 1000;
+    s.eventTracePath = tracePath_.wstring();
+    SimProfile app;
+    app.exeName = L"simapp.exe";
+    app.initialCount = 2;
+    app.arrivalsPerHour = 120.0;
+    app.meanLifetimeMs = 2ULL * 60 * 1000;
+    app.meanReapplyMs = 10ULL * 1000;
+    app.threadsPerReapply = 4;
+    app.childrenPerProcess = 1;
+    s.profiles.push_back(app);
+    SimReport sim;
+    ASSERT_TRUE(Simulator(s).Run(sim));
+
+    ReplayOptions options;
+    options.targets = {L"simapp.exe"};
+    const ReplayReport a = Replay(options);
+    const ReplayReport b = Replay(options);
+
+    EXPECT_GT(a.processStarts, 0u);
+    EXPECT_GT(a.threadStarts, 0u);
+    EXPECT_EQ(a.events, a.processStarts + a.threadStarts);
+    EXPECT_FALSE(a.truncated);
+    EXPECT_GT(a.totalEnforcements, 0u);
+    EXPECT_EQ(Deterministic(options, a), Deterministic(options, b));
+
+    options.speed = ReplaySpeed::MAX;
+    EXPECT_EQ(Deterministic(options, Replay(options)), Deterministic(options, Replay(options)));
+}
+
+TEST_F(TraceReplayTest, StartStormAtMaxSpeedEvictsOldestCritical) {
+    constexpr uint32_t kStarts = 10000;   // > ENFORCEMENT_QUEUE_TOTAL_LIMIT (8192)
+    WriteStartBurst(kStarts, 1000);
+
+    ReplayOptions options;
+    options.targets = {L"cl.exe"};
+    options.speed = ReplaySpeed::MAX;
+    options.eventsPerPump = 0;   // control thread never gets in during the storm
+    options.settleMs = 0;
+    const ReplayReport storm = Replay(options);
+    EXPECT_EQ(storm.processStarts, kStarts);
+    EXPECT_EQ(storm.criticalEvicts + storm.criticalDrops, kStarts - 8192u);
+    EXPECT_EQ(storm.maxQueueDepth, 8192u);
+    EXPECT_EQ(storm.totalEnforcements, 8192u);
+    EXPECT_EQ(Deterministic(options, storm), Deterministic(options, Replay(options)));
+
+    // Draining every 512 events (one CRITICAL burst per tick) keeps up
+    options.eventsPerPump = 512;
+    const ReplayReport pumped = Replay(options);
+    EXPECT_EQ(pumped.criticalEvicts + pumped.criticalDrops, 0u);
+    EXPECT_EQ(pumped.totalEnforcements, kStarts);
+}
+
+TEST_F(TraceReplayTest, BatchedStartBurstWakesOncePerBatch) {
+    constexpr uint32_t kStarts = 2000;
+    WriteStartBurst(kStarts, 100);
+
+    ReplayOptions options;
+    options.targets = {L"cl.exe"};
+    options.speed = ReplaySpeed::MAX;
+    options.settleMs = 0;
+    options.eventsPerPump = 1;   // control thread keeps up: every event finds the queue empty
+    const ReplayReport single = Replay(options);
+    EXPECT_EQ(single.processBatches, kStarts);
+    EXPECT_EQ(single.wakeupEnforcementRequest, kStarts);
+
+    options.eventsPerBatch = 100;
+    options.eventsPerPump = 100;
+    const ReplayReport batched = Replay(options);
+    EXPECT_EQ(batched.processBatches, kStarts / 100);
+    EXPECT_EQ(batched.wakeupEnforcementRequest, kStarts / 100);
+    EXPECT_EQ(batched.totalEnforcements, single.totalEnforcements);
+    EXPECT_EQ(batched.trackedAtEnd, single.trackedAtEnd);
+}
+
+TEST_F(TraceReplayTest, RecordedSpeedFollowsInterArrivalGaps) {
+    WriteStartBurst(300, 1000);   // one start per millisecond
+
+    ReplayOptions options;
+    options.targets = {L"cl.exe"};
+    options.settleMs = 0;
+    const ReplayReport paced = Replay(options);
+    EXPECT_EQ(paced.tracedSpanUs, 299000u);
+    EXPECT_LE(paced.maxQueueDepth, 4u);   // the new start + verifications falling due in the same ms
+    EXPECT_EQ(paced.wakeupEnforcementRequest, 300u);   // one control-loop pass per start
+
+    options.speed = ReplaySpeed::MAX;
+    options.eventsPerPump = 0;
+    const ReplayReport burst = Replay(options);
+    EXPECT_EQ(burst.maxQueueDepth, 300u);
+    EXPECT_LT(burst.wakeupEnforcementRequest, 300u);
+}
+
+TEST_F(TraceReplayTest, ThreadStormIsCoalescedPerPid) {
+    constexpr uint32_t kThreads = 5000;
+    {
+        EventTraceWriter w;
+        ASSERT_TRUE(w.Open(tracePath_));
+        w.AppendProcessStart(T0_US, 7000, 4, L"msbuild.exe", L"C:\\vs\\msbuild.exe");
+        // A minute later (STABLE): a burst within one millisecond
+        for (uint32_t i = 0; i < kThreads; ++i) {
+            w.AppendThreadStart(T0_US + 60000000ull + i / 10, 7000, 9000 + 4 * i);
+        }
+    }
+
+    ReplayOptions options;
+    options.targets = {L"msbuild.exe"};
+    const ReplayReport r = Replay(options);
+    EXPECT_EQ(r.threadStarts, kThreads);
+    EXPECT_EQ(r.threadDeduped, kThreads - 1);   // one ETW_THREAD_START per PID until drained
+    EXPECT_EQ(r.enforcementDrops, 0u);
+    EXPECT_EQ(r.trackedAtEnd, 1u);
+}